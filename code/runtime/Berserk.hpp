@@ -43,10 +43,15 @@
 #include <core/Data.hpp>
 #include <core/Engine.hpp>
 #include <core/EventDispatcher.hpp>
+#include <core/Hash64.hpp>
+#include <core/JobSystem.hpp>
 #include <core/Scheduler.hpp>
+#include <core/Sha256.hpp>
 #include <core/Thread.hpp>
 #include <core/Typedefs.hpp>
 #include <core/UUID.hpp>
+#include <core/compression/CompressedStream.hpp>
+#include <core/compression/Lz4.hpp>
 #include <core/event/Event.hpp>
 #include <core/event/EventDropInput.hpp>
 #include <core/event/EventJoystick.hpp>
@@ -54,16 +59,26 @@
 #include <core/event/EventMouse.hpp>
 #include <core/event/EventWindow.hpp>
 #include <core/image/Image.hpp>
+#include <core/image/ImageConvert.hpp>
+#include <core/image/ImageDecoder.hpp>
 #include <core/image/ImageUtil.hpp>
 #include <core/io/Config.hpp>
 #include <core/io/Logger.hpp>
+#include <core/math/Frustumf.hpp>
+#include <core/math/MathSimd.hpp>
 #include <core/math/MathUtils.hpp>
 #include <core/math/MathUtils2d.hpp>
 #include <core/math/MathUtils3d.hpp>
+#include <core/math/Rayf.hpp>
+#include <core/math/TAabb.hpp>
 #include <core/math/TMatMxN.hpp>
 #include <core/math/TQuat.hpp>
 #include <core/math/TVecN.hpp>
 #include <core/math/Transformf.hpp>
+#include <core/profiler/Counters.hpp>
+#include <core/profiler/Profiler.hpp>
+#include <core/spatial/AabbTree.hpp>
+#include <core/spatial/LooseOctree.hpp>
 #include <core/string/String.hpp>
 #include <core/string/String16u.hpp>
 #include <core/string/StringName.hpp>
@@ -82,11 +97,14 @@
  */
 
 #include <platform/Application.hpp>
+#include <platform/AsyncIO.hpp>
 #include <platform/FileSystem.hpp>
+#include <platform/FileWatcher.hpp>
 #include <platform/Input.hpp>
 #include <platform/InputDefs.hpp>
 #include <platform/InputDevices.hpp>
 #include <platform/Output.hpp>
+#include <platform/PakArchive.hpp>
 #include <platform/Window.hpp>
 #include <platform/WindowManager.hpp>
 
@@ -110,6 +128,7 @@
 #include <rhi/RHIDevice.hpp>
 #include <rhi/RHIFramebuffer.hpp>
 #include <rhi/RHIGraphicsPipeline.hpp>
+#include <rhi/RHIQuery.hpp>
 #include <rhi/RHIRenderPass.hpp>
 #include <rhi/RHIResource.hpp>
 #include <rhi/RHIResourceSet.hpp>
@@ -134,15 +153,22 @@
  * meshes, post effects, high-level graphics pipelines.
  */
 
+#include <render/GpuProfiler.hpp>
 #include <render/RenderEngine.hpp>
+#include <render/RenderQueue.hpp>
+#include <render/culling/FrustumCuller.hpp>
 #include <render/material/Material.hpp>
+#include <render/material/MaterialInstance.hpp>
+#include <render/material/MaterialInstancePool.hpp>
 #include <render/material/MaterialParams.hpp>
 #include <render/mesh/Mesh.hpp>
 #include <render/mesh/MeshFormats.hpp>
 #include <render/shader/Shader.hpp>
+#include <render/shader/ShaderCooker.hpp>
 #include <render/shader/ShaderManager.hpp>
 #include <render/shader/ShaderPass.hpp>
 #include <render/shader/ShaderTechnique.hpp>
+#include <render/shader/ShaderVariantPack.hpp>
 
 /**
  * @defgroup resource
@@ -160,12 +186,33 @@
  * uses special `Res` prefix, to distinguish them from other classes.
  */
 
+#include <resource/DerivedDataCache.hpp>
 #include <resource/ResMaterial.hpp>
 #include <resource/ResMesh.hpp>
 #include <resource/ResShader.hpp>
 #include <resource/ResTexture.hpp>
 #include <resource/Resource.hpp>
+#include <resource/ResourceDependencyGraph.hpp>
 #include <resource/ResourceImporter.hpp>
 #include <resource/ResourceManager.hpp>
 
+/**
+ * @defgroup scene
+ * @brief Scene representation module
+ *
+ * Module provides data-oriented scene hierarchy, which stores
+ * local transforms of nodes and propagates them into world
+ * matrices and bounds, ready for culling and instanced rendering,
+ * and archetype-based entity component system with chunked
+ * component storage and parallel systems.
+ */
+
+#include <scene/SceneHierarchy.hpp>
+#include <scene/ecs/Archetype.hpp>
+#include <scene/ecs/Component.hpp>
+#include <scene/ecs/Entity.hpp>
+#include <scene/ecs/EntityCommandBuffer.hpp>
+#include <scene/ecs/EntitySystem.hpp>
+#include <scene/ecs/EntityWorld.hpp>
+
 #endif//BERSERK_BERSERK_HPP
@@ -47,6 +47,10 @@ using Crc32Hash = uint32;
 /**
  * @class Crc32
  * @brief Crc32 hashing utility
+ *
+ * Standard CRC-32 (IEEE 802.3, same as zlib), computed with slicing-by-8
+ * tables. Use it for checksums stored in files; use Crc32C if value is not
+ * persisted or format can be changed, it is computed by hardware when available.
  */
 class Crc32 final {
 public:
@@ -59,11 +63,45 @@ public:
      * @return CRC hash value of the buffer
      */
     BRK_API static Crc32Hash Hash(const void *buffer, size_t size);
+
+    /**
+     * Continue hash with next buffer; `Update(Hash(a), b)` is equal to hash of `a` followed by `b`
+     *
+     * @param hash Hash of previous buffers (0 for empty input)
+     * @param buffer Pointer to memory with buffer
+     * @param size Num of bytes to hash
+     *
+     * @return CRC hash value of all buffers
+     */
+    BRK_API static Crc32Hash Update(Crc32Hash hash, const void *buffer, size_t size);
+};
+
+/**
+ * @class Crc32C
+ * @brief Crc32C (Castagnoli) hashing utility
+ *
+ * Uses SSE4.2 instruction on x64 (selected at runtime) and ARMv8 crc
+ * extension on arm64 (if enabled by compiler); otherwise falls back
+ * to slicing-by-8 tables.
+ */
+class Crc32C final {
+public:
+    /** @return CRC32C value of buffer */
+    BRK_API static Crc32Hash Hash(const void *buffer, size_t size);
+
+    /** @return CRC32C value of previous buffers with hash followed by buffer */
+    BRK_API static Crc32Hash Update(Crc32Hash hash, const void *buffer, size_t size);
+
+    /** @return True if computed by hardware instruction */
+    BRK_API static bool IsHardwareAccelerated();
 };
 
 /**
  * @class Crc32Builder
  * @brief Crc32 hash builder
+ *
+ * Hash of appended buffers is equal to hash of their concatenation,
+ * so order of buffers is significant.
  */
 class Crc32Builder final {
 public:
@@ -76,8 +114,7 @@ public:
      * @return This builder to chain the hash
      */
     Crc32Builder &Hash(const void *buffer, size_t size) {
-        Crc32Hash hash = Crc32::Hash(buffer, size);
-        mHash ^= hash;
+        mHash = Crc32::Update(mHash, buffer, size);
 
         return *this;
     }
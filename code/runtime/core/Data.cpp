@@ -73,4 +73,26 @@ Ref<Data> Data::Make(size_t sizeInBytes) {
             sizeInBytes, buffer, [](void *p) { Memory::Deallocate(p); }, true));
 }
 
+Ref<Data> Data::MakeWithProc(const void *data, size_t sizeInBytes, ReleaseProc releaseProc) {
+    assert(data);
+    assert(releaseProc);
+
+    return Ref<Data>(new Data(sizeInBytes, const_cast<void *>(data), std::move(releaseProc), false));
+}
+
+Ref<Data> Data::MakeOwned(void *data, size_t sizeInBytes, ReleaseProc releaseProc) {
+    assert(data);
+    assert(releaseProc);
+
+    return Ref<Data>(new Data(sizeInBytes, data, std::move(releaseProc), true));
+}
+
+Ref<Data> Data::MakeSubset(const Ref<Data> &data, size_t offset, size_t sizeInBytes) {
+    assert(data.IsNotNull());
+    assert(offset + sizeInBytes <= data->GetSize());
+
+    auto ptr = reinterpret_cast<const uint8 *>(data->GetData()) + offset;
+    return MakeWithProc(ptr, sizeInBytes, [data](void *) {});
+}
+
 BRK_NS_END
\ No newline at end of file
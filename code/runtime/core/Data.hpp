@@ -94,6 +94,42 @@ public:
      */
     BRK_API static Ref<Data> Make(size_t sizeInBytes);
 
+    /**
+     * Makes immutable data referencing external memory.
+     * Release proc is called with data pointer when data is destroyed.
+     *
+     * @param data Pointer to external memory
+     * @param sizeInBytes Size in bytes of the memory
+     * @param releaseProc Function to release memory
+     *
+     * @return Created data instance
+     */
+    BRK_API static Ref<Data> MakeWithProc(const void *data, size_t sizeInBytes, ReleaseProc releaseProc);
+
+    /**
+     * Makes mutable data taking ownership of memory without copy.
+     * Release proc is called with data pointer when data is destroyed.
+     *
+     * @param data Pointer to memory to own
+     * @param sizeInBytes Size in bytes of the memory
+     * @param releaseProc Function to release memory
+     *
+     * @return Created data instance
+     */
+    BRK_API static Ref<Data> MakeOwned(void *data, size_t sizeInBytes, ReleaseProc releaseProc);
+
+    /**
+     * Makes immutable data referencing range of other data without copy.
+     * Keeps source data alive while subset is alive.
+     *
+     * @param data Source data
+     * @param offset Offset in bytes of the range
+     * @param sizeInBytes Size in bytes of the range
+     *
+     * @return Created data instance
+     */
+    BRK_API static Ref<Data> MakeSubset(const Ref<Data> &data, size_t offset, size_t sizeInBytes);
+
 protected:
     /** [Internal Usage] Creates data instance */
     Data(size_t size, void *ptr, ReleaseProc releaseProc, bool isMutable);
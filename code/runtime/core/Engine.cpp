@@ -28,20 +28,36 @@
 #include <core/Engine.hpp>
 #include <core/io/Logger.hpp>
 #include <core/io/LoggerListenerOutput.hpp>
+#include <core/profiler/Profiler.hpp>
 
 BRK_NS_BEGIN
 
 Engine::~Engine() {
+    if (!mProfilerTracePath.empty() && !Profiler::Instance().SaveChromeTrace(mProfilerTracePath)) {
+        BRK_ERROR("Failed to save profiler trace path=" << mProfilerTracePath);
+    }
+
+    // Reload jobs access engine systems (including resource manager), so finish them first
+    if (mResourceManager)
+        mResourceManager->Shutdown();
+
     // Release in reverse order
     mResourceManager.reset();
     mRenderEngine.reset();
+    mAsyncIO.reset();
     mEventDispatcher.reset();
     mScheduler.reset();
+    if (mFileSystem)
+        mFileSystem->SetJobSystem(nullptr);
+    mJobSystem.reset();
     mRHIDevice.reset();
     mRHIThread.reset();
     mInput.reset();
     mWindowManager.reset();
     mFileSystem.reset();
+
+    // Listeners write to engine output, so dispatch pending messages while it is alive
+    Logger::Instance().Shutdown();
     mOutput.reset();
 
     // Remove global instance
@@ -76,6 +92,14 @@ EventDispatcher &Engine::GetEventDispatcher() {
     return *mEventDispatcher;
 }
 
+JobSystem &Engine::GetJobSystem() {
+    return *mJobSystem;
+}
+
+AsyncIO &Engine::GetAsyncIO() {
+    return *mAsyncIO;
+}
+
 WindowManager &Engine::GetWindowManager() {
     return *mWindowManager;
 }
@@ -128,6 +152,7 @@ void Engine::InitCore() {
 
     // Logger setup first
     Logger::Instance().AddListener([=](const Logger::Entry &entry) { listener.OnEntry(entry); });
+    Logger::Instance().InstallCrashHandler();
 
     // In order from lower level foundation to high-level system
     mGameThreadID = std::this_thread::get_id();
@@ -135,8 +160,11 @@ void Engine::InitCore() {
     mFileSystem = std::unique_ptr<FileSystem>(new FileSystem());
     mScheduler = std::unique_ptr<Scheduler>(new Scheduler());
     mEventDispatcher = std::unique_ptr<EventDispatcher>(new EventDispatcher());
+    mJobSystem = std::unique_ptr<JobSystem>(new JobSystem());
+    mFileSystem->SetJobSystem(mJobSystem.get());
+    mAsyncIO = std::unique_ptr<AsyncIO>(new AsyncIO(mScheduler.get(), mJobSystem.get()));
     mRenderEngine = std::unique_ptr<RenderEngine>(new RenderEngine());
-    mResourceManager = std::unique_ptr<ResourceManager>(new ResourceManager());
+    mResourceManager = std::unique_ptr<ResourceManager>(new ResourceManager(mFileSystem.get(), mScheduler.get(), mJobSystem.get()));
 
     // Provide singleton
     gEngine = this;
@@ -146,11 +174,19 @@ void Engine::InitCore() {
 
     // Create config file
     mConfig.Open("config/engine.config.xml");
+
+    // Profiler recording and optional trace dump on exit
+    StringName sectionProfiler("profiler");
+    auto &profiler = Profiler::Instance();
+    profiler.SetEnabled(mConfig.GetProperty(sectionProfiler, StringName("enabled"), 1u) != 0);
+    profiler.SetThreadName("Game");
+    mProfilerTracePath = mConfig.GetProperty(sectionProfiler, StringName("trace.path"), String());
 }
 
 void Engine::InitEngine() {
     // Init call
     mRenderEngine->Init();
+    mResourceManager->Init();
 }
 
 void Engine::ConfigureWindow() {
@@ -182,6 +218,8 @@ void Engine::SetRHIThread(std::shared_ptr<Thread> thread) {
 }
 
 void Engine::Update(float t, float dt) {
+    BRK_PROFILE_SCOPE("Engine::Update");
+
     mT = t;
     mDt = dt;
     mScheduler->Update(dt);
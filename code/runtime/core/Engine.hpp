@@ -30,9 +30,11 @@
 
 #include <core/Config.hpp>
 #include <core/EventDispatcher.hpp>
+#include <core/JobSystem.hpp>
 #include <core/Scheduler.hpp>
 #include <core/Thread.hpp>
 #include <core/io/Config.hpp>
+#include <platform/AsyncIO.hpp>
 #include <platform/FileSystem.hpp>
 #include <platform/Input.hpp>
 #include <platform/Output.hpp>
@@ -101,6 +103,12 @@ public:
     /** @return Engine event dispatch instance for events management */
     BRK_API EventDispatcher &GetEventDispatcher();
 
+    /** @return Engine job system for parallel tasks */
+    BRK_API JobSystem &GetJobSystem();
+
+    /** @return Engine asynchronous file io service */
+    BRK_API AsyncIO &GetAsyncIO();
+
     /** @return Engine windows manager class */
     BRK_API WindowManager &GetWindowManager();
 
@@ -144,12 +152,15 @@ private:
     void Update(float t, float dt);
 
 private:
-    Config mConfig; /** Engine config file */
+    Config mConfig;            /** Engine config file */
+    String mProfilerTracePath; /** Path to save profiler trace on exit (if not empty) */
 
     std::unique_ptr<Output> mOutput;                   /** Engine standard output */
     std::unique_ptr<FileSystem> mFileSystem;           /** Engine file system utils */
     std::unique_ptr<Scheduler> mScheduler;             /** Engine scheduler for frame/timer events */
     std::unique_ptr<EventDispatcher> mEventDispatcher; /** Engine event dispatch instance for events management */
+    std::unique_ptr<JobSystem> mJobSystem;             /** Engine job system for parallel tasks */
+    std::unique_ptr<AsyncIO> mAsyncIO;                 /** Engine asynchronous file io service */
 
     std::shared_ptr<WindowManager> mWindowManager; /** Engine windows manager class */
     std::shared_ptr<Input> mInput;                 /** Engine input manager */
@@ -27,6 +27,7 @@
 
 #include <core/EventDispatcher.hpp>
 #include <core/io/Logger.hpp>
+#include <core/profiler/Profiler.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -86,6 +87,8 @@ void EventDispatcher::Resume(EventDispatcher::Handle handle) {
 }
 
 void EventDispatcher::Update() {
+    BRK_PROFILE_SCOPE("EventDispatcher::Update");
+
     // Add pending listeners
     for (auto &listener : mPendingAdd) {
         auto query = mListenersTypes.find(listener.handle);
@@ -0,0 +1,241 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/Hash64.hpp>
+
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+    #include <intrin.h>
+#endif
+
+BRK_NS_BEGIN
+
+namespace {
+
+    const uint64 SECRET[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+#if defined(__SIZEOF_INT128__)
+    // Compiler extension, marked to keep pedantic builds quiet
+    __extension__ typedef unsigned __int128 uint128;
+#endif
+
+    /** Full 64x64->128 multiplication; low and high halves are returned in a and b */
+    inline void Mum(uint64 &a, uint64 &b) {
+#if defined(__SIZEOF_INT128__)
+        auto r = static_cast<uint128>(a) * b;
+        a = static_cast<uint64>(r);
+        b = static_cast<uint64>(r >> 64u);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        a = _umul128(a, b, &b);
+#else
+        uint64 ha = a >> 32u, hb = b >> 32u, la = a & 0xffffffffu, lb = b & 0xffffffffu;
+        uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        uint64 t = rl + (rm0 << 32u), c = t < rl;
+        uint64 lo = t + (rm1 << 32u);
+        c += lo < t;
+        uint64 hi = rh + (rm0 >> 32u) + (rm1 >> 32u) + c;
+        a = lo;
+        b = hi;
+#endif
+    }
+
+    inline uint64 MixMum(uint64 a, uint64 b) {
+        Mum(a, b);
+        return a ^ b;
+    }
+
+    inline uint64 Read8(const uint8 *p) {
+        uint64 v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    inline uint64 Read4(const uint8 *p) {
+        uint32 v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    inline uint64 Read3(const uint8 *p, size_t k) {
+        return (static_cast<uint64>(p[0]) << 16u) | (static_cast<uint64>(p[k >> 1u]) << 8u) | p[k - 1];
+    }
+
+    inline uint64 InitSeed(uint64 seed) {
+        return seed ^ MixMum(seed ^ SECRET[0], SECRET[1]);
+    }
+
+    /** Inputs up to 16 bytes */
+    inline void ReadSmall(const uint8 *p, size_t size, uint64 &a, uint64 &b) {
+        if (size >= 4) {
+            a = (Read4(p) << 32u) | Read4(p + ((size >> 3u) << 2u));
+            b = (Read4(p + size - 4) << 32u) | Read4(p + size - 4 - ((size >> 3u) << 2u));
+        } else if (size > 0) {
+            a = Read3(p, size);
+            b = 0;
+        } else {
+            a = 0;
+            b = 0;
+        }
+    }
+
+    /** Last bytes of input longer than 16 bytes; p[-16..-1] must be valid */
+    inline void ReadTail(const uint8 *p, size_t size, uint64 &seed, uint64 &a, uint64 &b) {
+        while (size > 16) {
+            seed = MixMum(Read8(p) ^ SECRET[1], Read8(p + 8) ^ seed);
+            p += 16;
+            size -= 16;
+        }
+
+        a = Read8(p + size - 16);
+        b = Read8(p + size - 8);
+    }
+
+    inline uint64 Finalize(uint64 seed, uint64 a, uint64 b, uint64 length) {
+        a ^= SECRET[1];
+        b ^= seed;
+        Mum(a, b);
+        return MixMum(a ^ SECRET[0] ^ length, b ^ SECRET[1]);
+    }
+
+    inline void ConsumeStripe(const uint8 *p, uint64 &seed, uint64 &see1, uint64 &see2) {
+        seed = MixMum(Read8(p) ^ SECRET[1], Read8(p + 8) ^ seed);
+        see1 = MixMum(Read8(p + 16) ^ SECRET[2], Read8(p + 24) ^ see1);
+        see2 = MixMum(Read8(p + 32) ^ SECRET[3], Read8(p + 40) ^ see2);
+    }
+
+}// namespace
+
+uint64 Hash64::Hash(const void *buffer, size_t size, uint64 seed) {
+    auto p = reinterpret_cast<const uint8 *>(buffer);
+    uint64 a;
+    uint64 b;
+
+    seed = InitSeed(seed);
+
+    if (size <= 16) {
+        ReadSmall(p, size, a, b);
+    } else {
+        size_t i = size;
+
+        if (i > 48) {
+            uint64 see1 = seed;
+            uint64 see2 = seed;
+
+            do {
+                ConsumeStripe(p, seed, see1, see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+
+            seed ^= see1 ^ see2;
+        }
+
+        ReadTail(p, i, seed, a, b);
+    }
+
+    return Finalize(seed, a, b, size);
+}
+
+uint64 Hash64::Combine(uint64 seed, uint64 value) {
+    // Different secrets for operands make combination order-sensitive
+    return MixMum(seed ^ SECRET[0], value ^ SECRET[1]);
+}
+
+uint64 Hash64::Mix(uint64 value) {
+    // Finalizer of splitmix64
+    value = (value ^ (value >> 30u)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27u)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31u);
+}
+
+Hash64Builder::Hash64Builder(uint64 seed) {
+    mSeed = InitSeed(seed);
+    mSee1 = mSeed;
+    mSee2 = mSeed;
+}
+
+Hash64Builder &Hash64Builder::Update(const void *buffer, size_t size) {
+    auto p = reinterpret_cast<const uint8 *>(buffer);
+
+    mLength += size;
+
+    // Stripe is consumed only if more bytes follow it
+    if (mPending + size <= STRIPE) {
+        std::memcpy(mBuffer + mPending, p, size);
+        mPending += size;
+        return *this;
+    }
+
+    if (mPending > 0) {
+        auto fill = STRIPE - mPending;
+        std::memcpy(mBuffer + mPending, p, fill);
+        p += fill;
+        size -= fill;
+        Consume(mBuffer);
+    }
+
+    while (size > STRIPE) {
+        Consume(p);
+        p += STRIPE;
+        size -= STRIPE;
+    }
+
+    std::memcpy(mBuffer, p, size);
+    mPending = size;
+
+    return *this;
+}
+
+uint64 Hash64Builder::GetHash() const {
+    uint64 a;
+    uint64 b;
+
+    if (mLength <= 16) {
+        ReadSmall(mBuffer, mPending, a, b);
+        return Finalize(mSeed, a, b, mLength);
+    }
+
+    uint64 seed = mSeed;
+    if (mLength > mPending)
+        seed ^= mSee1 ^ mSee2;
+
+    // Tail may read up to 16 bytes before pending ones
+    uint8 tail[TAIL + STRIPE];
+    std::memcpy(tail, mLastBytes, TAIL);
+    std::memcpy(tail + TAIL, mBuffer, mPending);
+
+    ReadTail(tail + TAIL, mPending, seed, a, b);
+    return Finalize(seed, a, b, mLength);
+}
+
+void Hash64Builder::Consume(const uint8 *stripe) {
+    ConsumeStripe(stripe, mSeed, mSee1, mSee2);
+    std::memcpy(mLastBytes, stripe + STRIPE - TAIL, TAIL);
+}
+
+BRK_NS_END
@@ -0,0 +1,132 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_HASH64_HPP
+#define BERSERK_HASH64_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <core/string/String.hpp>
+
+#include <type_traits>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * @class Hash64
+ * @brief Fast non-cryptographic 64-bit hash
+ *
+ * Hash of wyhash family: input is consumed in 48 byte stripes with
+ * 64x64->128 bit multiplications, inputs up to 16 bytes are processed
+ * without loops. Use for hash tables and in-memory caches; value is
+ * stable between runs and platforms, but must not be used against
+ * malicious input or as cryptographic hash (see Sha256).
+ */
+class Hash64 final {
+public:
+    /**
+     * @brief Hash buffer
+     *
+     * @param buffer Pointer to memory with buffer
+     * @param size Num of bytes to hash
+     * @param seed Seed to get independent hash function
+     *
+     * @return Hash value of the buffer
+     */
+    BRK_API static uint64 Hash(const void *buffer, size_t size, uint64 seed = 0);
+
+    /** @return Hash value of string content */
+    BRK_API static uint64 Hash(const String &string, uint64 seed = 0) {
+        return Hash(string.data(), string.size(), seed);
+    }
+
+    /**
+     * @brief Combine hash values
+     *
+     * Order-sensitive: `Combine(Combine(s, a), b)` differs from `Combine(Combine(s, b), a)`.
+     *
+     * @param seed Hash value combined so far
+     * @param value Hash value to add
+     *
+     * @return Combined hash value
+     */
+    BRK_API static uint64 Combine(uint64 seed, uint64 value);
+
+    /** @return Hash of 64-bit value (bijective mix) */
+    BRK_API static uint64 Mix(uint64 value);
+};
+
+/**
+ * @class Hash64Builder
+ * @brief Streaming version of Hash64
+ *
+ * Hash of appended buffers is equal to Hash64 of their concatenation.
+ */
+class Hash64Builder final {
+public:
+    BRK_API explicit Hash64Builder(uint64 seed = 0);
+
+    /** Append bytes */
+    BRK_API Hash64Builder &Update(const void *buffer, size_t size);
+
+    /** Append value bytes */
+    template<typename T>
+    Hash64Builder &Update(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Expected trivially copyable value");
+        return Update(&value, sizeof(T));
+    }
+
+    /** @return Hash of appended bytes; builder can be updated further */
+    BRK_API uint64 GetHash() const;
+
+private:
+    static const size_t STRIPE = 48;
+    static const size_t TAIL = 16;
+
+    void Consume(const uint8 *stripe);
+
+    uint64 mSeed;           /** Main lane */
+    uint64 mSee1;           /** Second lane of stripes */
+    uint64 mSee2;           /** Third lane of stripes */
+    uint64 mLength = 0;     /** Total appended bytes */
+    size_t mPending = 0;    /** Bytes in buffer */
+    uint8 mBuffer[STRIPE];  /** Not consumed bytes */
+    uint8 mLastBytes[TAIL]; /** Last bytes of consumed stripe */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_HASH64_HPP
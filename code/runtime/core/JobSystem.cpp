@@ -0,0 +1,137 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/JobSystem.hpp>
+#include <core/profiler/Profiler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+
+BRK_NS_BEGIN
+
+JobSystem::JobSystem(uint32 workersCount) {
+    if (workersCount == 0) {
+        auto hardware = std::thread::hardware_concurrency();
+        workersCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    mWorkers.reserve(workersCount);
+
+    for (uint32 i = 0; i < workersCount; i++)
+        mWorkers.emplace_back([this]() { WorkerMain(); });
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mFinished = true;
+    }
+
+    mCvar.notify_all();
+
+    for (auto &worker : mWorkers)
+        worker.join();
+
+    assert(mJobs.empty());
+}
+
+void JobSystem::Submit(Job job) {
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mJobs.push(std::move(job));
+    }
+
+    mCvar.notify_one();
+}
+
+void JobSystem::ParallelFor(uint32 count, uint32 grain, const RangeFunc &func) {
+    if (count == 0)
+        return;
+
+    grain = std::max(grain, 1u);
+
+    const uint32 chunks = (count + grain - 1) / grain;
+
+    // Too small to split, process in place
+    if (chunks == 1 || mWorkers.empty()) {
+        func(0, count);
+        return;
+    }
+
+    // Shared between helpers, which may start after the caller finished all chunks
+    struct Context {
+        std::atomic<uint32> next{0};
+        std::atomic<uint32> done{0};
+    };
+
+    auto context = std::make_shared<Context>();
+    const RangeFunc *funcPtr = &func;
+
+    auto process = [context, funcPtr, count, grain, chunks]() {
+        uint32 chunk;
+        while ((chunk = context->next.fetch_add(1)) < chunks) {
+            uint32 begin = chunk * grain;
+            uint32 end = std::min(begin + grain, count);
+            (*funcPtr)(begin, end);
+            context->done.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    auto helpers = std::min(static_cast<uint32>(mWorkers.size()), chunks - 1);
+    for (uint32 i = 0; i < helpers; i++)
+        Submit(process);
+
+    // Calling thread participates, so nested calls never dead-lock
+    process();
+
+    while (context->done.load(std::memory_order_acquire) < chunks)
+        std::this_thread::yield();
+}
+
+void JobSystem::WorkerMain() {
+    while (true) {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCvar.wait(lock, [this]() { return mFinished || !mJobs.empty(); });
+
+            if (mJobs.empty())
+                return;
+
+            job = std::move(mJobs.front());
+            mJobs.pop();
+        }
+
+        BRK_PROFILE_SCOPE("JobSystem::Job");
+        job();
+    }
+}
+
+BRK_NS_END
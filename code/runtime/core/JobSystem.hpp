@@ -0,0 +1,109 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_JOBSYSTEM_HPP
+#define BERSERK_JOBSYSTEM_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * @class JobSystem
+ * @brief Pool of worker threads for data-parallel engine tasks
+ *
+ * Job system owns fixed number of worker threads, which execute
+ * submitted jobs in the FIFO order. Use `ParallelFor` to split
+ * large uniform work (sorting, culling, transforms update) into
+ * chunks, processed by the workers and the calling thread.
+ *
+ * @note Thread-safe
+ */
+class JobSystem final {
+public:
+    /** Job function type */
+    using Job = std::function<void()>;
+    /** Parallel for function type, processes items range [begin, end) */
+    using RangeFunc = std::function<void(uint32 begin, uint32 end)>;
+
+    /**
+     * @brief Creates job system
+     * @param workersCount Number of workers; pass 0 to use hardware concurrency - 1
+     */
+    BRK_API explicit JobSystem(uint32 workersCount = 0);
+    BRK_API ~JobSystem();
+
+    /** Submit job for async execution on some worker */
+    BRK_API void Submit(Job job);
+
+    /**
+     * @brief Process range of items in parallel
+     *
+     * Splits range [0, count) into chunks of at most `grain` items and
+     * processes them on the workers and calling thread. Blocks until all
+     * chunks are processed. Safe to call from within a job.
+     *
+     * @param count Total number of items to process
+     * @param grain Max number of items in a single chunk
+     * @param func Function to process single chunk
+     */
+    BRK_API void ParallelFor(uint32 count, uint32 grain, const RangeFunc &func);
+
+    /** @return Number of worker threads */
+    BRK_API uint32 GetWorkersCount() const { return static_cast<uint32>(mWorkers.size()); }
+
+private:
+    void WorkerMain();
+
+private:
+    std::vector<std::thread> mWorkers; /** Worker threads */
+    std::queue<Job> mJobs;             /** Pending jobs */
+    std::condition_variable mCvar;     /** To notify workers */
+    std::mutex mMutex;                 /** Guard jobs queue */
+    bool mFinished = false;            /** Set on shut down */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_JOBSYSTEM_HPP
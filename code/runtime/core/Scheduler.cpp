@@ -27,6 +27,8 @@
 
 #include <core/Scheduler.hpp>
 #include <core/io/Logger.hpp>
+#include <core/profiler/Counters.hpp>
+#include <core/profiler/Profiler.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -103,6 +105,8 @@ void Scheduler::Resume(Scheduler::Handle handle) {
 }
 
 void Scheduler::Update(float dt) {
+    BRK_PROFILE_SCOPE("Scheduler::Update");
+
     // Add pending add scheduled functions
     for (auto &entry : mPendingAdd)
         mScheduled.emplace(entry.first, std::move(entry.second));
@@ -146,6 +150,7 @@ void Scheduler::Update(float dt) {
             scheduled.elapsed -= scheduled.delay;
             scheduled.delayed = false;
             scheduled.callback(scheduled.delay);
+            BRK_COUNTER_ADD("scheduler.callbacks", 1);
 
             if (Exhausted(scheduled)) {
                 mPendingRemove.push_back(entry.first);
@@ -159,6 +164,7 @@ void Scheduler::Update(float dt) {
             scheduled.executed += 1;
             scheduled.elapsed -= interval;
             scheduled.callback(interval);
+            BRK_COUNTER_ADD("scheduler.callbacks", 1);
 
             if (Exhausted(scheduled)) {
                 mPendingRemove.push_back(entry.first);
@@ -173,6 +179,8 @@ void Scheduler::Update(float dt) {
         std::swap(mToPerform, mToPerformExec);
     }
     std::for_each(mToPerformExec.begin(), mToPerformExec.end(), [](PerformFunc &func) { func(); });
+    BRK_COUNTER_ADD("scheduler.performed", mToPerformExec.size());
+    BRK_GAUGE_SET("scheduler.scheduled", mScheduled.size());
     mToPerformExec.clear();
 }
 
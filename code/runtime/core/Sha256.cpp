@@ -0,0 +1,172 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/Sha256.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+BRK_NS_BEGIN
+
+namespace {
+    const uint32 K[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    inline uint32 Rotr(uint32 x, uint32 n) {
+        return (x >> n) | (x << (32 - n));
+    }
+}// namespace
+
+Sha256::Sha256() {
+    mState = {{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}};
+}
+
+Sha256 &Sha256::Update(const void *buffer, size_t size) {
+    auto *p = reinterpret_cast<const uint8 *>(buffer);
+    auto used = static_cast<size_t>(mLength % 64);
+    mLength += size;
+
+    if (used > 0) {
+        auto toCopy = std::min(size, 64 - used);
+        std::memcpy(mBlock.data() + used, p, toCopy);
+        p += toCopy;
+        size -= toCopy;
+
+        if (used + toCopy < 64)
+            return *this;
+
+        ProcessBlock(mBlock.data());
+    }
+
+    for (; size >= 64; p += 64, size -= 64)
+        ProcessBlock(p);
+
+    if (size > 0)
+        std::memcpy(mBlock.data(), p, size);
+
+    return *this;
+}
+
+Sha256 &Sha256::Update(const String &string) {
+    Update(static_cast<uint64>(string.size()));
+    return Update(string.data(), string.size());
+}
+
+Sha256Digest Sha256::Finish() {
+    uint64 bits = mLength * 8;
+    uint8 padding[72] = {0x80};
+    auto used = static_cast<size_t>(mLength % 64);
+    auto paddingSize = (used < 56 ? 56 : 120) - used;
+
+    uint8 length[8];
+    for (uint32 i = 0; i < 8; i++)
+        length[i] = static_cast<uint8>(bits >> (56 - 8 * i));
+
+    Update(padding, paddingSize);
+    Update(length, sizeof(length));
+
+    Sha256Digest digest;
+    for (uint32 i = 0; i < 8; i++) {
+        digest[4 * i + 0] = static_cast<uint8>(mState[i] >> 24);
+        digest[4 * i + 1] = static_cast<uint8>(mState[i] >> 16);
+        digest[4 * i + 2] = static_cast<uint8>(mState[i] >> 8);
+        digest[4 * i + 3] = static_cast<uint8>(mState[i]);
+    }
+
+    return digest;
+}
+
+Sha256Digest Sha256::Hash(const void *buffer, size_t size) {
+    return Sha256().Update(buffer, size).Finish();
+}
+
+String Sha256::ToHex(const Sha256Digest &digest) {
+    static const char *DIGITS = "0123456789abcdef";
+
+    String hex;
+    hex.reserve(2 * digest.size());
+
+    for (auto byte : digest) {
+        hex += DIGITS[byte >> 4];
+        hex += DIGITS[byte & 0xf];
+    }
+
+    return hex;
+}
+
+void Sha256::ProcessBlock(const uint8 *block) {
+    uint32 w[64];
+
+    for (uint32 i = 0; i < 16; i++)
+        w[i] = (static_cast<uint32>(block[4 * i]) << 24) | (static_cast<uint32>(block[4 * i + 1]) << 16) |
+               (static_cast<uint32>(block[4 * i + 2]) << 8) | static_cast<uint32>(block[4 * i + 3]);
+
+    for (uint32 i = 16; i < 64; i++) {
+        uint32 s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32 s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32 a = mState[0], b = mState[1], c = mState[2], d = mState[3];
+    uint32 e = mState[4], f = mState[5], g = mState[6], h = mState[7];
+
+    for (uint32 i = 0; i < 64; i++) {
+        uint32 s1 = Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25);
+        uint32 ch = (e & f) ^ (~e & g);
+        uint32 t1 = h + s1 + ch + K[i] + w[i];
+        uint32 s0 = Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22);
+        uint32 maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32 t2 = s0 + maj;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    mState[0] += a;
+    mState[1] += b;
+    mState[2] += c;
+    mState[3] += d;
+    mState[4] += e;
+    mState[5] += f;
+    mState[6] += g;
+    mState[7] += h;
+}
+
+BRK_NS_END
@@ -0,0 +1,111 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_SHA256_HPP
+#define BERSERK_SHA256_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <core/string/String.hpp>
+
+#include <array>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * @class Sha256Digest
+ * @brief Sha256 hash value type
+ */
+using Sha256Digest = std::array<uint8, 32>;
+
+/**
+ * @class Sha256
+ * @brief Sha256 hashing utility
+ *
+ * Cryptographic hash, used where collisions of content keys must
+ * be practically impossible (for instance, keys of cached data
+ * shared between machines). Use Crc32 for fast checksums.
+ */
+class Sha256 final {
+public:
+    BRK_API Sha256();
+
+    /**
+     * Appends buffer to hashed content
+     *
+     * @param buffer Pointer to memory with buffer
+     * @param size Num of bytes to hash
+     *
+     * @return This builder to chain the hash
+     */
+    BRK_API Sha256 &Update(const void *buffer, size_t size);
+
+    /** Appends value bytes to hashed content */
+    template<typename T>
+    Sha256 &Update(const T &value) {
+        return Update(&value, sizeof(T));
+    }
+
+    /** Appends string with its length to hashed content */
+    BRK_API Sha256 &Update(const String &string);
+
+    /** @return Hash of appended content; builder must not be used after */
+    BRK_API Sha256Digest Finish();
+
+    /**
+     * Hash buffer of len size in bytes
+     *
+     * @param buffer Pointer to memory with buffer
+     * @param size Num of bytes to hash
+     *
+     * @return Hash value of the buffer
+     */
+    BRK_API static Sha256Digest Hash(const void *buffer, size_t size);
+
+    /** @return Lower case hex string of the hash */
+    BRK_API static String ToHex(const Sha256Digest &digest);
+
+private:
+    void ProcessBlock(const uint8 *block);
+
+    std::array<uint32, 8> mState;
+    std::array<uint8, 64> mBlock;
+    uint64 mLength = 0;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_SHA256_HPP
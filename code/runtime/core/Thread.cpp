@@ -27,6 +27,7 @@
 
 #include <core/Thread.hpp>
 #include <core/io/Logger.hpp>
+#include <core/profiler/Profiler.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -66,18 +67,21 @@ void Thread::Update() {
 }
 
 void Thread::ExecuteBefore() {
+    BRK_PROFILE_SCOPE("Thread::ExecuteBefore");
     assert(OnThread());
     std::for_each(mExecuteBefore.begin(), mExecuteBefore.end(), [](Callable &callable) { callable(); });
     mExecuteBefore.clear();
 }
 
 void Thread::ExecuteUpdate() {
+    BRK_PROFILE_SCOPE("Thread::ExecuteUpdate");
     assert(OnThread());
     std::for_each(mExecuteUpdate.begin(), mExecuteUpdate.end(), [](Callable &callable) { callable(); });
     mExecuteUpdate.clear();
 }
 
 void Thread::ExecuteAfter() {
+    BRK_PROFILE_SCOPE("Thread::ExecuteAfter");
     assert(OnThread());
     std::for_each(mExecuteAfter.begin(), mExecuteAfter.end(), [](Callable &callable) { callable(); });
     mExecuteAfter.clear();
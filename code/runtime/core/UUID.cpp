@@ -25,7 +25,7 @@
 /* SOFTWARE.                                                                      */
 /**********************************************************************************/
 
-#include <core/Crc32.hpp>
+#include <core/Hash64.hpp>
 #include <core/UUID.hpp>
 
 #include <chrono>
@@ -139,10 +139,8 @@ String UUID::ToString() const {
     return String(buffer, 36);
 }
 
-uint32 UUID::Hash() const {
-    Crc32Builder builder;
-    builder.Hash(mWords, sizeof(uint32) * 4);
-    return builder.GetHash();
+uint64 UUID::Hash() const {
+    return Hash64::Hash(mWords, sizeof(uint32) * 4);
 }
 
 UUID UUID::Empty() {
@@ -53,7 +53,7 @@ public:
 
     BRK_API const uint32 *Words() const { return mWords; }
     BRK_API String ToString() const;
-    BRK_API uint32 Hash() const;
+    BRK_API uint64 Hash() const;
 
     static BRK_API UUID Empty();
     static BRK_API UUID Generate();
@@ -74,15 +74,19 @@ namespace std {
     struct hash<BRK_NS::UUID> {
     public:
         size_t operator()(const BRK_NS::UUID &uuid) const {
-            return uuid.Hash();
+            return static_cast<size_t>(uuid.Hash());
         }
     };
 
 }// namespace std
 
-inline std::ostream &operator<<(std::ostream &stream, const BRK_NS::UUID &name) {
+BRK_NS_BEGIN
+
+inline std::ostream &operator<<(std::ostream &stream, const UUID &name) {
     stream << name.ToString();
     return stream;
 }
 
+BRK_NS_END
+
 #endif//BERSERK_UUID_HPP
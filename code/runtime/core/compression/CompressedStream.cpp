@@ -0,0 +1,246 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/Memory.hpp>
+#include <core/compression/CompressedStream.hpp>
+#include <core/compression/Lz4.hpp>
+#include <core/profiler/Counters.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+BRK_NS_BEGIN
+
+static_assert(sizeof(CompressedStream::Header) == 32, "Compressed stream header layout changed");
+
+namespace {
+    /** Validates stream header and blocks table, computes offsets of blocks */
+    bool ParseStream(const Ref<Data> &stream, CompressedStream::Header &header, std::vector<uint32> &sizes, std::vector<uint64> &offsets) {
+        auto base = reinterpret_cast<const uint8 *>(stream->GetData());
+        auto size = static_cast<uint64>(stream->GetSize());
+
+        if (size < sizeof(header))
+            return false;
+
+        std::memcpy(&header, base, sizeof(header));
+
+        if (header.magic != CompressedStream::MAGIC || header.version != CompressedStream::VERSION ||
+            header.codec > CompressionCodec::Lz4 || header.blockSize == 0 || header.blockSize >= CompressedStream::BLOCK_STORED ||
+            header.rawSize == 0 || header.blocksCount != (header.rawSize + header.blockSize - 1) / header.blockSize)
+            return false;
+
+        uint64 offset = sizeof(header) + static_cast<uint64>(header.blocksCount) * sizeof(uint32);
+        if (offset > size)
+            return false;
+
+        // Stream may be not aligned (e.g. file in pak)
+        sizes.resize(header.blocksCount);
+        std::memcpy(sizes.data(), base + sizeof(header), sizes.size() * sizeof(uint32));
+        offsets.resize(header.blocksCount + 1);
+
+        for (uint32 i = 0; i < header.blocksCount; i++) {
+            uint64 rawSize = i + 1 < header.blocksCount ? header.blockSize : header.rawSize - static_cast<uint64>(i) * header.blockSize;
+            uint32 blockSize = sizes[i] & ~CompressedStream::BLOCK_STORED;
+
+            if ((sizes[i] & CompressedStream::BLOCK_STORED) && blockSize != rawSize)
+                return false;
+
+            offsets[i] = offset;
+            offset += blockSize;
+        }
+
+        offsets[header.blocksCount] = offset;
+        return offset <= size;
+    }
+
+    bool DecompressBlock(const uint8 *source, uint32 sourceSize, uint8 *destination, size_t size) {
+        if (sourceSize & CompressedStream::BLOCK_STORED) {
+            std::memcpy(destination, source, size);
+            return true;
+        }
+
+        return Lz4::Decompress(source, sourceSize, destination, size);
+    }
+}// namespace
+
+Ref<Data> CompressedStream::Compress(const Ref<Data> &data, CompressionCodec codec, uint32 blockSize, JobSystem *jobSystem) {
+    assert(data.IsNotNull());
+    assert(data->GetSize() > 0);
+    assert(blockSize > 0 && blockSize < BLOCK_STORED);
+
+    auto source = reinterpret_cast<const uint8 *>(data->GetData());
+    auto rawSize = static_cast<uint64>(data->GetSize());
+    auto blocksCount = static_cast<uint32>((rawSize + blockSize - 1) / blockSize);
+
+    std::vector<std::vector<uint8>> blocks(blocksCount);
+    std::vector<uint32> sizes(blocksCount);
+
+    auto compress = [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; i++) {
+            auto offset = static_cast<uint64>(i) * blockSize;
+            auto size = static_cast<size_t>(std::min<uint64>(blockSize, rawSize - offset));
+            size_t compressed = 0;
+
+            if (codec == CompressionCodec::Lz4) {
+                blocks[i].resize(Lz4::GetMaxCompressedSize(size));
+                compressed = Lz4::Compress(source + offset, size, blocks[i].data(), blocks[i].size());
+            }
+
+            // Store blocks which do not compress
+            if (compressed == 0 || compressed >= size) {
+                blocks[i].assign(source + offset, source + offset + size);
+                sizes[i] = static_cast<uint32>(size) | BLOCK_STORED;
+            } else {
+                blocks[i].resize(compressed);
+                sizes[i] = static_cast<uint32>(compressed);
+            }
+        }
+    };
+
+    if (jobSystem)
+        jobSystem->ParallelFor(blocksCount, 1, compress);
+    else
+        compress(0, blocksCount);
+
+    Header header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.codec = codec;
+    header.blockSize = blockSize;
+    header.rawSize = rawSize;
+    header.blocksCount = blocksCount;
+
+    size_t streamSize = sizeof(header) + sizes.size() * sizeof(uint32);
+    for (auto &block : blocks)
+        streamSize += block.size();
+
+    auto stream = Data::Make(streamSize);
+    auto op = reinterpret_cast<uint8 *>(stream->GetDataWrite());
+
+    Memory::Copy(op, &header, sizeof(header));
+    op += sizeof(header);
+    Memory::Copy(op, sizes.data(), sizes.size() * sizeof(uint32));
+    op += sizes.size() * sizeof(uint32);
+
+    for (auto &block : blocks) {
+        Memory::Copy(op, block.data(), block.size());
+        op += block.size();
+    }
+
+    return stream;
+}
+
+Ref<Data> CompressedStream::Decompress(const Ref<Data> &stream, JobSystem *jobSystem) {
+    assert(stream.IsNotNull());
+
+    Header header;
+    std::vector<uint32> sizes;
+    std::vector<uint64> offsets;
+
+    if (!ParseStream(stream, header, sizes, offsets))
+        return Ref<Data>();
+
+    auto source = reinterpret_cast<const uint8 *>(stream->GetData());
+    auto data = Data::Make(static_cast<size_t>(header.rawSize));
+    auto destination = reinterpret_cast<uint8 *>(data->GetDataWrite());
+    std::atomic<bool> valid(true);
+
+    auto decompress = [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; i++) {
+            auto offset = static_cast<uint64>(i) * header.blockSize;
+            auto size = static_cast<size_t>(std::min<uint64>(header.blockSize, header.rawSize - offset));
+
+            if (!DecompressBlock(source + offsets[i], sizes[i], destination + offset, size))
+                valid.store(false, std::memory_order_relaxed);
+        }
+    };
+
+    if (jobSystem && header.blocksCount > 1)
+        jobSystem->ParallelFor(header.blocksCount, 1, decompress);
+    else
+        decompress(0, header.blocksCount);
+
+    if (!valid.load())
+        return Ref<Data>();
+
+    BRK_COUNTER_ADD("io.decompressed_bytes", header.rawSize);
+
+    return data;
+}
+
+bool CompressedStream::IsCompressed(const Ref<Data> &data) {
+    uint32 magic;
+
+    if (data.IsNull() || data->GetSize() < sizeof(Header))
+        return false;
+
+    std::memcpy(&magic, data->GetData(), sizeof(magic));
+    return magic == MAGIC;
+}
+
+CompressedStreamReader::CompressedStreamReader(Ref<Data> stream) : mStream(std::move(stream)) {
+    mValid = mStream.IsNotNull() && ParseStream(mStream, mHeader, mSizes, mOffsets);
+}
+
+size_t CompressedStreamReader::Read(void *destination, size_t size) {
+    auto op = reinterpret_cast<uint8 *>(destination);
+    size_t read = 0;
+
+    while (mValid && read < size && mPosition < mHeader.rawSize) {
+        auto block = static_cast<uint32>(mPosition / mHeader.blockSize);
+
+        if (block != mCurrentBlock && !LoadBlock(block))
+            break;
+
+        auto offset = static_cast<size_t>(mPosition - static_cast<uint64>(block) * mHeader.blockSize);
+        auto count = std::min(size - read, mBlock.size() - offset);
+
+        Memory::Copy(op + read, mBlock.data() + offset, count);
+        read += count;
+        mPosition += count;
+    }
+
+    return read;
+}
+
+bool CompressedStreamReader::LoadBlock(uint32 block) {
+    auto offset = static_cast<uint64>(block) * mHeader.blockSize;
+    auto size = static_cast<size_t>(std::min<uint64>(mHeader.blockSize, mHeader.rawSize - offset));
+    auto source = reinterpret_cast<const uint8 *>(mStream->GetData());
+
+    mBlock.resize(size);
+    mValid = DecompressBlock(source + mOffsets[block], mSizes[block], mBlock.data(), size);
+    mCurrentBlock = block;
+
+    BRK_COUNTER_ADD("io.decompressed_bytes", size);
+
+    return mValid;
+}
+
+BRK_NS_END
@@ -0,0 +1,170 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_COMPRESSEDSTREAM_HPP
+#define BERSERK_COMPRESSEDSTREAM_HPP
+
+#include <core/Config.hpp>
+#include <core/Data.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+#include <core/templates/Ref.hpp>
+
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/** @brief Compression codec */
+enum class CompressionCodec : uint32 {
+    /** Not compressed */
+    None = 0,
+    /** LZ4 block format */
+    Lz4 = 1
+};
+
+/**
+ * @class CompressedStream
+ * @brief Block-based compressed data format
+ *
+ * Data is split into blocks of fixed size, compressed independently
+ * (each block is a separate frame without references to other blocks),
+ * so blocks can be decompressed in parallel or streamed one by one.
+ * Blocks which do not compress are stored as is.
+ *
+ * Layout: header, table of blocks compressed sizes, blocks.
+ *
+ * @note Thread-safe
+ */
+class CompressedStream final {
+public:
+    /** Identifies compressed stream: 'BRKZ' */
+    static const uint32 MAGIC = 0x5a4b5242;
+    /** Increment on any change of the layout */
+    static const uint32 VERSION = 1;
+    /** Default size of the block */
+    static const uint32 DEFAULT_BLOCK_SIZE = 64 * 1024;
+    /** Flag of block size for blocks stored as is */
+    static const uint32 BLOCK_STORED = 0x80000000u;
+
+    /** @brief Stream header */
+    struct Header {
+        uint32 magic;
+        uint32 version;
+        CompressionCodec codec;
+        uint32 blockSize;   /** Size of decompressed block (except last one) */
+        uint64 rawSize;     /** Size of decompressed data */
+        uint32 blocksCount; /** Number of blocks */
+        uint32 reserved;
+    };
+
+    /**
+     * @brief Compress data
+     *
+     * @param data Data to compress
+     * @param codec Codec of blocks
+     * @param blockSize Size of block
+     * @param jobSystem Optional job system to compress blocks in parallel
+     *
+     * @return Compressed stream
+     */
+    BRK_API static Ref<Data> Compress(const Ref<Data> &data, CompressionCodec codec = CompressionCodec::Lz4,
+                                      uint32 blockSize = DEFAULT_BLOCK_SIZE, JobSystem *jobSystem = nullptr);
+
+    /**
+     * @brief Decompress data
+     *
+     * @param stream Compressed stream
+     * @param jobSystem Optional job system to decompress blocks in parallel
+     *
+     * @return Decompressed data or null if stream is invalid
+     */
+    BRK_API static Ref<Data> Decompress(const Ref<Data> &stream, JobSystem *jobSystem = nullptr);
+
+    /** @return True if data starts with compressed stream header */
+    BRK_API static bool IsCompressed(const Ref<Data> &data);
+};
+
+/**
+ * @class CompressedStreamReader
+ * @brief Sequential reader of compressed stream
+ *
+ * Decompresses blocks on demand into internal block buffer, so
+ * memory use is bounded by block size regardless of data size.
+ *
+ * @note Not thread-safe
+ */
+class CompressedStreamReader final : public RefCnt {
+public:
+    /** @param stream Compressed stream; check IsValid() after creation */
+    BRK_API explicit CompressedStreamReader(Ref<Data> stream);
+    BRK_API ~CompressedStreamReader() override = default;
+
+    /**
+     * @brief Read next bytes of decompressed data
+     *
+     * @param destination Buffer to read into
+     * @param size Number of bytes to read
+     *
+     * @return Number of bytes read; less than size at the end of data or on error
+     */
+    BRK_API size_t Read(void *destination, size_t size);
+
+    /** @return True if stream header is valid and no corrupted block found */
+    BRK_API bool IsValid() const { return mValid; }
+    /** @return True if all data read */
+    BRK_API bool IsEnd() const { return mPosition == GetSize(); }
+    /** @return Size of decompressed data */
+    BRK_API uint64 GetSize() const { return mValid ? mHeader.rawSize : 0; }
+    /** @return Number of bytes read */
+    BRK_API uint64 GetPosition() const { return mPosition; }
+
+private:
+    bool LoadBlock(uint32 block);
+
+private:
+    Ref<Data> mStream;
+    CompressedStream::Header mHeader{};
+    std::vector<uint32> mSizes;   /** Stored sizes of blocks */
+    std::vector<uint64> mOffsets; /** Offsets of blocks in stream */
+    std::vector<uint8> mBlock;    /** Decompressed current block */
+    uint32 mCurrentBlock = 0xffffffff;
+    uint64 mPosition = 0;
+    bool mValid = false;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_COMPRESSEDSTREAM_HPP
@@ -0,0 +1,318 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/compression/Lz4.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+BRK_NS_BEGIN
+
+namespace {
+    /** Min match length of format */
+    const size_t MIN_MATCH = 4;
+    /** Last literals of block (format requirement) */
+    const size_t LAST_LITERALS = 5;
+    /** Last match must start before this distance to the end (format requirement) */
+    const size_t MF_LIMIT = 12;
+    /** Max match offset */
+    const size_t MAX_OFFSET = 65535;
+    /** Hash table size log2 */
+    const uint32 HASH_LOG = 14;
+    /** Search step grows each 2^SKIP_TRIGGER bytes without match */
+    const uint32 SKIP_TRIGGER = 6;
+
+    uint32 Read32(const uint8 *p) {
+        uint32 value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    uint64 Read64(const uint8 *p) {
+        uint64 value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    void Copy8(uint8 *destination, const uint8 *source) {
+        std::memcpy(destination, source, 8);
+    }
+
+    void Copy16(uint8 *destination, const uint8 *source) {
+        std::memcpy(destination, source, 16);
+    }
+
+    /** @return Number of equal bytes of a and b, not going beyond limit */
+    size_t CountEqual(const uint8 *a, const uint8 *b, const uint8 *limit) {
+        const uint8 *start = a;
+        while (a + 8 <= limit && Read64(a) == Read64(b)) {
+            a += 8;
+            b += 8;
+        }
+        while (a < limit && *a == *b) {
+            a += 1;
+            b += 1;
+        }
+        return static_cast<size_t>(a - start);
+    }
+
+    uint32 Hash(uint32 sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_LOG);
+    }
+
+    /** Writes length extension bytes; @return Output pointer or null if out of space */
+    uint8 *WriteLength(uint8 *op, const uint8 *oend, size_t length) {
+        while (length >= 255) {
+            if (op >= oend)
+                return nullptr;
+            *op++ = 255;
+            length -= 255;
+        }
+        if (op >= oend)
+            return nullptr;
+        *op++ = static_cast<uint8>(length);
+        return op;
+    }
+
+    uint8 *WriteSequence(uint8 *op, const uint8 *oend, const uint8 *literals, size_t literalsCount, size_t offset, size_t matchLength) {
+        if (op >= oend)
+            return nullptr;
+
+        uint8 *token = op++;
+        *token = 0;
+
+        if (literalsCount >= 15) {
+            *token = 15 << 4;
+            if (!(op = WriteLength(op, oend, literalsCount - 15)))
+                return nullptr;
+        } else {
+            *token = static_cast<uint8>(literalsCount << 4);
+        }
+
+        if (static_cast<size_t>(oend - op) < literalsCount)
+            return nullptr;
+        std::memcpy(op, literals, literalsCount);
+        op += literalsCount;
+
+        // Last sequence has only literals
+        if (matchLength == 0)
+            return op;
+
+        if (oend - op < 2)
+            return nullptr;
+        *op++ = static_cast<uint8>(offset);
+        *op++ = static_cast<uint8>(offset >> 8);
+
+        size_t length = matchLength - MIN_MATCH;
+        if (length >= 15) {
+            *token |= 15;
+            return WriteLength(op, oend, length - 15);
+        }
+
+        *token |= static_cast<uint8>(length);
+        return op;
+    }
+
+    /** Reads length extension bytes; @return False if input ended */
+    bool ReadLength(const uint8 *&ip, const uint8 *iend, size_t &length) {
+        uint8 value;
+        do {
+            if (ip >= iend)
+                return false;
+            value = *ip++;
+            length += value;
+        } while (value == 255);
+        return true;
+    }
+}// namespace
+
+size_t Lz4::Compress(const void *source, size_t sourceSize, void *destination, size_t capacity) {
+    auto src = reinterpret_cast<const uint8 *>(source);
+    auto ip = src;
+    auto anchor = src;
+    auto iend = src + sourceSize;
+    auto op = reinterpret_cast<uint8 *>(destination);
+    auto oend = op + capacity;
+
+    if (sourceSize > MF_LIMIT) {
+        // Positions + 1 of last sequences with hash, 0 is empty
+        uint32 table[1u << HASH_LOG];
+        std::memset(table, 0, sizeof(table));
+
+        auto mflimit = iend - MF_LIMIT;
+        auto matchlimit = iend - LAST_LITERALS;
+
+        while (ip < mflimit) {
+            uint32 sequence = Read32(ip);
+            uint32 hash = Hash(sequence);
+            uint32 candidate = table[hash];
+            table[hash] = static_cast<uint32>(ip - src) + 1;
+
+            if (candidate == 0 || static_cast<size_t>(ip - src) + 1 - candidate > MAX_OFFSET || Read32(src + candidate - 1) != sequence) {
+                ip += 1 + ((ip - anchor) >> SKIP_TRIGGER);
+                continue;
+            }
+
+            auto match = src + candidate - 1;
+
+            // Extend match backward into pending literals
+            while (ip > anchor && match > src && ip[-1] == match[-1]) {
+                ip -= 1;
+                match -= 1;
+            }
+
+            size_t length = MIN_MATCH + CountEqual(ip + MIN_MATCH, match + MIN_MATCH, matchlimit);
+
+            op = WriteSequence(op, oend, anchor, static_cast<size_t>(ip - anchor), static_cast<size_t>(ip - match), length);
+            if (!op)
+                return 0;
+
+            ip += length;
+            anchor = ip;
+
+            // Index position inside match to find following repetitions
+            if (ip - 2 > src && ip < mflimit)
+                table[Hash(Read32(ip - 2))] = static_cast<uint32>(ip - 2 - src) + 1;
+        }
+    }
+
+    op = WriteSequence(op, oend, anchor, static_cast<size_t>(iend - anchor), 0, 0);
+    if (!op)
+        return 0;
+
+    return static_cast<size_t>(op - reinterpret_cast<uint8 *>(destination));
+}
+
+bool Lz4::Decompress(const void *source, size_t sourceSize, void *destination, size_t size) {
+    auto ip = reinterpret_cast<const uint8 *>(source);
+    auto iend = ip + sourceSize;
+    auto dst = reinterpret_cast<uint8 *>(destination);
+    auto op = dst;
+    auto oend = dst + size;
+
+    while (ip < iend) {
+        uint32 token = *ip++;
+        size_t literals = token >> 4;
+        size_t length = token & 15;
+
+        // Fast path for most common short sequence: fixed size copies of 16 literals and 24 match bytes
+        if (literals < 15 && length < 15 && iend - ip >= 18 && oend - op >= 40) {
+            Copy16(op, ip);
+            ip += literals;
+            op += literals;
+
+            size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+
+            if (offset >= 8 && offset <= static_cast<size_t>(op - dst)) {
+                const uint8 *match = op - offset;
+                Copy8(op, match);
+                Copy8(op + 8, match + 8);
+                Copy8(op + 16, match + 16);
+                op += length + MIN_MATCH;
+                continue;
+            }
+
+            // Short offset, handled by generic match copy
+            ip -= 2;
+        } else {
+            if (literals == 15 && !ReadLength(ip, iend, literals))
+                return false;
+
+            if (literals <= 16 && iend - ip >= 16 && oend - op >= 16) {
+                Copy16(op, ip);
+            } else {
+                if (static_cast<size_t>(iend - ip) < literals || static_cast<size_t>(oend - op) < literals)
+                    return false;
+                std::memcpy(op, ip, literals);
+            }
+
+            ip += literals;
+            op += literals;
+
+            // Last sequence
+            if (ip == iend)
+                break;
+        }
+
+        if (iend - ip < 2)
+            return false;
+
+        size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+
+        if (offset == 0 || offset > static_cast<size_t>(op - dst))
+            return false;
+
+        if (length == 15 && !ReadLength(ip, iend, length))
+            return false;
+        length += MIN_MATCH;
+
+        if (static_cast<size_t>(oend - op) < length)
+            return false;
+
+        const uint8 *match = op - offset;
+
+        if (static_cast<size_t>(oend - op) >= length + 8) {
+            // Copy by 8 bytes with over-copy, which is rewritten by following data
+            uint8 *end = op + length;
+
+            if (offset < 8) {
+                // Spread pattern of short offset, so following blocks of 8 bytes do not overlap
+                static const uint32 INC[] = {0, 1, 2, 1, 0, 4, 4, 4};
+                static const int32 DEC[] = {0, 0, 0, -1, -4, 1, 2, 3};
+
+                op[0] = match[0];
+                op[1] = match[1];
+                op[2] = match[2];
+                op[3] = match[3];
+                match += INC[offset];
+                std::memcpy(op + 4, match, 4);
+                match -= DEC[offset];
+            } else {
+                Copy8(op, match);
+                match += 8;
+            }
+
+            for (op += 8; op < end; op += 8, match += 8)
+                Copy8(op, match);
+
+            op = end;
+            continue;
+        }
+
+        // Near the end of output copy byte by byte
+        for (size_t i = 0; i < length; i++)
+            op[i] = match[i];
+
+        op += length;
+    }
+
+    return op == oend;
+}
+
+BRK_NS_END
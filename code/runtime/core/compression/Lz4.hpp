@@ -0,0 +1,89 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_LZ4_HPP
+#define BERSERK_LZ4_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+
+#include <cstddef>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * @class Lz4
+ * @brief LZ4 block format codec
+ *
+ * Compressor is greedy single-pass matcher with 4-byte hash table (fast
+ * mode, compatible with LZ4 block format). Decompressor validates all
+ * lengths and offsets, so corrupted input never reads or writes out of bounds.
+ *
+ * @note Thread-safe
+ */
+class Lz4 final {
+public:
+    /** @return Max size of compressed block for input of size */
+    static size_t GetMaxCompressedSize(size_t size) { return size + size / 255 + 16; }
+
+    /**
+     * @brief Compress block
+     *
+     * @param source Input data
+     * @param sourceSize Input data size
+     * @param destination Output buffer
+     * @param capacity Size of output buffer
+     *
+     * @return Size of compressed block or 0 if output buffer is too small
+     */
+    BRK_API static size_t Compress(const void *source, size_t sourceSize, void *destination, size_t capacity);
+
+    /**
+     * @brief Decompress block
+     *
+     * @param source Compressed block
+     * @param sourceSize Compressed block size
+     * @param destination Output buffer
+     * @param size Size of decompressed data (must be exact)
+     *
+     * @return True if block is valid and decompressed size matches
+     */
+    BRK_API static bool Decompress(const void *source, size_t sourceSize, void *destination, size_t size);
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_LZ4_HPP
@@ -27,14 +27,26 @@
 
 #include <core/image/Image.hpp>
 #include <core/image/ImageUtil.hpp>
+#include <core/Memory.hpp>
 #include <core/io/Logger.hpp>
 
+#include <climits>
+
 #define STBI_WINDOWS_UTF8
 #define STBIW_WINDOWS_UTF8
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 
+// Decoded pixels are allocated by engine allocator, so data can take them without copy
+#define STBI_MALLOC(size) BRK_NS ::Memory::Allocate(size)
+#define STBI_REALLOC(p, size) BRK_NS ::Memory::Reallocate(p, size)
+#define STBI_FREE(p) BRK_NS ::Memory::Deallocate(p)
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define STBI_NEON
+#endif
+
 #include <stbimage/stb_image.hpp>
 #include <stbimage/stb_image_resize.hpp>
 #include <stbimage/stb_image_write.hpp>
@@ -125,47 +137,80 @@ bool Image::SaveRgba(const String &filepath, FileFormat fileFormat, int quality)
     }
 }
 
-Image Image::LoadRgba(const String &path, uint32 channels) {
-    assert(1 <= channels && channels <= 4);
+namespace {
 
-    if (channels < 1 || channels > 4) {
-        BRK_ERROR("Invalid channels count provided " << channels);
-        return Image();
+    bool CheckChannels(uint32 channels) {
+        assert(1 <= channels && channels <= 4);
+
+        if (channels < 1 || channels > 4) {
+            BRK_ERROR("Invalid channels count provided " << channels);
+            return false;
+        }
+
+        return true;
+    }
+
+    Image MakeDecoded(stbi_uc *data, int width, int height, uint32 channels) {
+        Image::Format format = Image::Format::Unknown;
+        switch (channels) {
+            case 1:
+                format = Image::Format::R8;
+                break;
+            case 2:
+                format = Image::Format::RG8;
+                break;
+            case 3:
+                format = Image::Format::RGB8;
+                break;
+            case 4:
+                format = Image::Format::RGBA8;
+                break;
+            default:
+                break;
+        }
+
+        auto pixelSize = ImageUtil::GetPixelSize(format);
+        auto stride = static_cast<uint32>(width) * pixelSize;
+        auto pixelData = Data::MakeOwned(data, static_cast<size_t>(stride) * height, [](void *p) { stbi_image_free(p); });
+
+        return Image(static_cast<uint32>(width), static_cast<uint32>(height), stride, pixelSize, format, std::move(pixelData));
     }
 
+}// namespace
+
+Image Image::LoadRgba(const String &path, uint32 channels) {
+    if (!CheckChannels(channels))
+        return Image();
+
     int width, height, chInFile;
     stbi_uc *data = stbi_load(path.c_str(), &width, &height, &chInFile, static_cast<int>(channels));
 
     if (!data) {
-        BRK_ERROR("Failed to load image " << path);
+        BRK_ERROR("Failed to load image " << path << " (" << stbi_failure_reason() << ")");
         return Image();
     }
 
-    Format format = Format::Unknown;
-    switch (channels) {
-        case 1:
-            format = Format::R8;
-            break;
-        case 2:
-            format = Format::RG8;
-            break;
-        case 3:
-            format = Format::RGB8;
-            break;
-        case 4:
-            format = Format::RGBA8;
-            break;
-        default:
-            break;
+    return MakeDecoded(data, width, height, channels);
+}
+
+Image Image::DecodeRgba(const void *encoded, size_t size, uint32 channels) {
+    if (!CheckChannels(channels))
+        return Image();
+
+    if (!encoded || size == 0 || size > static_cast<size_t>(INT_MAX)) {
+        BRK_ERROR("Invalid encoded image buffer of size " << size);
+        return Image();
     }
 
-    auto pixelSize = ImageUtil::GetPixelSize(format);
-    auto stride = width * pixelSize;
-    auto pixelData = Data::Make(data, stride * width);
+    int width, height, chInFile;
+    stbi_uc *data = stbi_load_from_memory(static_cast<const stbi_uc *>(encoded), static_cast<int>(size), &width, &height, &chInFile, static_cast<int>(channels));
 
-    stbi_image_free(data);
+    if (!data) {
+        BRK_ERROR("Failed to decode image (" << stbi_failure_reason() << ")");
+        return Image();
+    }
 
-    return Image(width, height, stride, pixelSize, format, std::move(pixelData));
+    return MakeDecoded(data, width, height, channels);
 }
 
 #undef STBI_WINDOWS_UTF8
@@ -111,6 +111,19 @@ public:
      */
     BRK_API static Image LoadRgba(const String &path, uint32 channels = 4);
 
+    /**
+     * @brief Decode rgba image from encoded file data in memory
+     *
+     * @note Pixels are decoded into image data without extra copy.
+     *
+     * @param encoded Encoded file data (png, jpg, bmp, tga, etc.)
+     * @param size Size in bytes of encoded data
+     * @param channels Number of channels to load; must be within {1,2,3,4}
+     *
+     * @return Decoded image; empty if failed
+     */
+    BRK_API static Image DecodeRgba(const void *encoded, size_t size, uint32 channels = 4);
+
 private:
     uint32 mWidth = 0;
     uint32 mHeight = 0;
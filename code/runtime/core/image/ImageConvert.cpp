@@ -0,0 +1,829 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/image/ImageConvert.hpp>
+#include <core/io/Logger.hpp>
+#include <core/math/Simd.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define BERSERK_IMAGE_X64
+    #include <immintrin.h>
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && defined(BRK_SIMD_NEON)
+    #define BERSERK_IMAGE_NEON
+#endif
+
+#if defined(BERSERK_IMAGE_X64) && (defined(__GNUC__) || defined(__clang__))
+    #define BRK_TARGET_F16C __attribute__((target("avx,f16c")))
+    #define BRK_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+    #define BRK_TARGET_F16C
+    #define BRK_TARGET_SSSE3
+#endif
+
+BRK_NS_BEGIN
+
+namespace {
+
+    /** Pixels converted at once through intermediate float rows */
+    const uint32 CHUNK_PIXELS = 256;
+    /** Approximate size of rows processed by single job */
+    const uint32 JOB_BYTES = 64 * 1024;
+    /** Entries in linear to sRGB table, indexed by linear value in 16-bit fixed point */
+    const uint32 LINEAR_TO_SRGB_SIZE = 65536;
+
+    enum class ChannelType {
+        Unorm8,
+        Snorm8,
+        Unorm16,
+        Snorm16,
+        Srgb8,
+        Half,
+        Float,
+        Unknown
+    };
+
+    struct FormatInfo {
+        ChannelType type;
+        uint32 channels;
+    };
+
+    FormatInfo GetInfo(Image::Format format) {
+        switch (format) {
+            case Image::Format::R8:
+                return {ChannelType::Unorm8, 1};
+            case Image::Format::R8_SNORM:
+                return {ChannelType::Snorm8, 1};
+            case Image::Format::R16:
+                return {ChannelType::Unorm16, 1};
+            case Image::Format::R16_SNORM:
+                return {ChannelType::Snorm16, 1};
+            case Image::Format::RG8:
+                return {ChannelType::Unorm8, 2};
+            case Image::Format::RG8_SNORM:
+                return {ChannelType::Snorm8, 2};
+            case Image::Format::RG16:
+                return {ChannelType::Unorm16, 2};
+            case Image::Format::RG16_SNORM:
+                return {ChannelType::Snorm16, 2};
+            case Image::Format::RGB8:
+                return {ChannelType::Unorm8, 3};
+            case Image::Format::RGB8_SNORM:
+                return {ChannelType::Snorm8, 3};
+            case Image::Format::RGB16_SNORM:
+                return {ChannelType::Snorm16, 3};
+            case Image::Format::RGBA8:
+                return {ChannelType::Unorm8, 4};
+            case Image::Format::RGBA8_SNORM:
+                return {ChannelType::Snorm8, 4};
+            case Image::Format::RGBA16:
+                return {ChannelType::Unorm16, 4};
+            case Image::Format::SRGB8:
+                return {ChannelType::Srgb8, 3};
+            case Image::Format::SRGB8_ALPHA8:
+                return {ChannelType::Srgb8, 4};
+            case Image::Format::R16F:
+                return {ChannelType::Half, 1};
+            case Image::Format::RG16F:
+                return {ChannelType::Half, 2};
+            case Image::Format::RGB16F:
+                return {ChannelType::Half, 3};
+            case Image::Format::RGBA16F:
+                return {ChannelType::Half, 4};
+            case Image::Format::R32F:
+                return {ChannelType::Float, 1};
+            case Image::Format::RG32F:
+                return {ChannelType::Float, 2};
+            case Image::Format::RGB32F:
+                return {ChannelType::Float, 3};
+            case Image::Format::RGBA32F:
+                return {ChannelType::Float, 4};
+            default:
+                return {ChannelType::Unknown, 0};
+        }
+    }
+
+    uint32 GetElementSize(ChannelType type) {
+        switch (type) {
+            case ChannelType::Unorm8:
+            case ChannelType::Snorm8:
+            case ChannelType::Srgb8:
+                return 1;
+            case ChannelType::Unorm16:
+            case ChannelType::Snorm16:
+            case ChannelType::Half:
+                return 2;
+            case ChannelType::Float:
+                return 4;
+            default:
+                return 0;
+        }
+    }
+
+    /** Clamp, which maps NaN to min */
+    inline float Clamp(float x, float min, float max) {
+        return x > min ? (x < max ? x : max) : min;
+    }
+
+    inline uint16 FloatToHalfValue(float value) {
+        uint32 f;
+        std::memcpy(&f, &value, sizeof(f));
+
+        uint32 sign = (f >> 16u) & 0x8000u;
+        uint32 h;
+        f &= 0x7fffffffu;
+
+        if (f >= 0x47800000u) {
+            // Too large for half, infinity or NaN
+            h = f > 0x7f800000u ? 0x7e00u : 0x7c00u;
+        } else if (f < 0x38800000u) {
+            // Subnormal half or zero; addition of magic value rounds to nearest even
+            const uint32 magicBits = 126u << 23u;
+            float magic;
+            float v;
+            std::memcpy(&magic, &magicBits, sizeof(magic));
+            std::memcpy(&v, &f, sizeof(v));
+            v += magic;
+            std::memcpy(&f, &v, sizeof(f));
+            h = f - magicBits;
+        } else {
+            // Rebias exponent and round mantissa to nearest even
+            uint32 mantissaOdd = (f >> 13u) & 1u;
+            f += ((15u - 127u) << 23u) + 0xfffu + mantissaOdd;
+            h = f >> 13u;
+        }
+
+        return static_cast<uint16>(h | sign);
+    }
+
+    inline float HalfToFloatValue(uint16 h) {
+        const uint32 shiftedExp = 0x7c00u << 13u;
+
+        uint32 f = (h & 0x7fffu) << 13u;
+        uint32 exp = f & shiftedExp;
+        f += (127u - 15u) << 23u;
+
+        if (exp == shiftedExp) {
+            // Infinity or NaN
+            f += (128u - 16u) << 23u;
+        } else if (exp == 0) {
+            // Zero or subnormal, renormalize
+            const uint32 magicBits = 113u << 23u;
+            float magic;
+            float v;
+            f += 1u << 23u;
+            std::memcpy(&magic, &magicBits, sizeof(magic));
+            std::memcpy(&v, &f, sizeof(v));
+            v -= magic;
+            std::memcpy(&f, &v, sizeof(f));
+        }
+
+        f |= static_cast<uint32>(h & 0x8000u) << 16u;
+
+        float value;
+        std::memcpy(&value, &f, sizeof(value));
+        return value;
+    }
+
+    void FloatToHalfScalar(const float *src, uint16 *dst, size_t count) {
+        for (size_t i = 0; i < count; i++)
+            dst[i] = FloatToHalfValue(src[i]);
+    }
+
+    void HalfToFloatScalar(const uint16 *src, float *dst, size_t count) {
+        for (size_t i = 0; i < count; i++)
+            dst[i] = HalfToFloatValue(src[i]);
+    }
+
+    void Expand3To4Scalar(const uint8 *src, uint8 *dst, size_t count, uint8 alpha) {
+        for (size_t i = 0; i < count; i++) {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            dst[3] = alpha;
+            src += 3;
+            dst += 4;
+        }
+    }
+
+    void Reduce4To3Scalar(const uint8 *src, uint8 *dst, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            src += 4;
+            dst += 3;
+        }
+    }
+
+#if defined(BERSERK_IMAGE_X64)
+
+    BRK_TARGET_F16C void FloatToHalfHardware(const float *src, uint16 *dst, size_t count) {
+        size_t i = 0;
+
+        for (; i + 8 <= count; i += 8) {
+            __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+        }
+
+        FloatToHalfScalar(src + i, dst + i, count - i);
+    }
+
+    BRK_TARGET_F16C void HalfToFloatHardware(const uint16 *src, float *dst, size_t count) {
+        size_t i = 0;
+
+        for (; i + 8 <= count; i += 8) {
+            __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+        }
+
+        HalfToFloatScalar(src + i, dst + i, count - i);
+    }
+
+    bool HasHardwareHalf() {
+        return CpuFeatures::Get().f16c;
+    }
+
+    BRK_TARGET_SSSE3 void Expand3To4Simd(const uint8 *src, uint8 *dst, size_t count, uint8 alpha) {
+        const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(static_cast<uint32>(alpha) << 24u));
+        size_t i = 0;
+
+        // Each step loads 16 bytes, but uses only 12 of them
+        for (; i + 6 <= count; i += 4) {
+            __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alphaMask));
+        }
+
+        Expand3To4Scalar(src + i * 3, dst + i * 4, count - i, alpha);
+    }
+
+    BRK_TARGET_SSSE3 void Reduce4To3Simd(const uint8 *src, uint8 *dst, size_t count) {
+        const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        size_t i = 0;
+
+        // Each step stores 16 bytes, last 4 are overwritten by the next step
+        for (; i + 6 <= count; i += 4) {
+            __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 3), _mm_shuffle_epi8(rgba, shuffle));
+        }
+
+        Reduce4To3Scalar(src + i * 4, dst + i * 3, count - i);
+    }
+
+    bool HasSimdShuffle() {
+        return CpuFeatures::Get().ssse3;
+    }
+
+#elif defined(BERSERK_IMAGE_NEON)
+
+    void FloatToHalfHardware(const float *src, uint16 *dst, size_t count) {
+        size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+            vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+
+        FloatToHalfScalar(src + i, dst + i, count - i);
+    }
+
+    void HalfToFloatHardware(const uint16 *src, float *dst, size_t count) {
+        size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+
+        HalfToFloatScalar(src + i, dst + i, count - i);
+    }
+
+    bool HasHardwareHalf() {
+        return true;
+    }
+
+    void Expand3To4Simd(const uint8 *src, uint8 *dst, size_t count, uint8 alpha) {
+        size_t i = 0;
+
+        for (; i + 16 <= count; i += 16) {
+            uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+            uint8x16x4_t rgba;
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = vdupq_n_u8(alpha);
+            vst4q_u8(dst + i * 4, rgba);
+        }
+
+        Expand3To4Scalar(src + i * 3, dst + i * 4, count - i, alpha);
+    }
+
+    void Reduce4To3Simd(const uint8 *src, uint8 *dst, size_t count) {
+        size_t i = 0;
+
+        for (; i + 16 <= count; i += 16) {
+            uint8x16x4_t rgba = vld4q_u8(src + i * 4);
+            uint8x16x3_t rgb;
+            rgb.val[0] = rgba.val[0];
+            rgb.val[1] = rgba.val[1];
+            rgb.val[2] = rgba.val[2];
+            vst3q_u8(dst + i * 3, rgb);
+        }
+
+        Reduce4To3Scalar(src + i * 4, dst + i * 3, count - i);
+    }
+
+    bool HasSimdShuffle() {
+        return true;
+    }
+
+#else
+
+    void FloatToHalfHardware(const float *src, uint16 *dst, size_t count) {
+        FloatToHalfScalar(src, dst, count);
+    }
+
+    void HalfToFloatHardware(const uint16 *src, float *dst, size_t count) {
+        HalfToFloatScalar(src, dst, count);
+    }
+
+    bool HasHardwareHalf() {
+        return false;
+    }
+
+    void Expand3To4Simd(const uint8 *src, uint8 *dst, size_t count, uint8 alpha) {
+        Expand3To4Scalar(src, dst, count, alpha);
+    }
+
+    void Reduce4To3Simd(const uint8 *src, uint8 *dst, size_t count) {
+        Reduce4To3Scalar(src, dst, count);
+    }
+
+    bool HasSimdShuffle() {
+        return false;
+    }
+
+#endif
+
+    using FloatToHalfFunc = void (*)(const float *src, uint16 *dst, size_t count);
+    using HalfToFloatFunc = void (*)(const uint16 *src, float *dst, size_t count);
+    using Expand3To4Func = void (*)(const uint8 *src, uint8 *dst, size_t count, uint8 alpha);
+    using Reduce4To3Func = void (*)(const uint8 *src, uint8 *dst, size_t count);
+
+    FloatToHalfFunc GetFloatToHalfFunc() {
+        static const FloatToHalfFunc func = HasHardwareHalf() ? FloatToHalfHardware : FloatToHalfScalar;
+        return func;
+    }
+
+    HalfToFloatFunc GetHalfToFloatFunc() {
+        static const HalfToFloatFunc func = HasHardwareHalf() ? HalfToFloatHardware : HalfToFloatScalar;
+        return func;
+    }
+
+    Expand3To4Func GetExpand3To4Func() {
+        static const Expand3To4Func func = HasSimdShuffle() ? Expand3To4Simd : Expand3To4Scalar;
+        return func;
+    }
+
+    Reduce4To3Func GetReduce4To3Func() {
+        static const Reduce4To3Func func = HasSimdShuffle() ? Reduce4To3Simd : Reduce4To3Scalar;
+        return func;
+    }
+
+    struct SrgbTables {
+        float toLinear[256];
+        std::vector<uint8> toSrgb;
+
+        SrgbTables() : toSrgb(LINEAR_TO_SRGB_SIZE) {
+            for (uint32 i = 0; i < 256; i++) {
+                double c = i / 255.0;
+                toLinear[i] = static_cast<float>(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+            }
+
+            for (uint32 i = 0; i < LINEAR_TO_SRGB_SIZE; i++) {
+                double l = i / static_cast<double>(LINEAR_TO_SRGB_SIZE - 1);
+                double c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+                toSrgb[i] = static_cast<uint8>(c * 255.0 + 0.5);
+            }
+        }
+    };
+
+    const SrgbTables &GetSrgbTables() {
+        static const SrgbTables tables;
+        return tables;
+    }
+
+    /** Convert count elements of type to float */
+    void DecodeElements(const void *src, ChannelType type, float *dst, size_t count) {
+        switch (type) {
+            case ChannelType::Unorm8: {
+                auto p = static_cast<const uint8 *>(src);
+                for (size_t i = 0; i < count; i++)
+                    dst[i] = static_cast<float>(p[i]) * (1.0f / 255.0f);
+                break;
+            }
+            case ChannelType::Snorm8: {
+                auto p = static_cast<const int8 *>(src);
+                for (size_t i = 0; i < count; i++)
+                    dst[i] = std::max(static_cast<float>(p[i]) * (1.0f / 127.0f), -1.0f);
+                break;
+            }
+            case ChannelType::Unorm16: {
+                auto p = static_cast<const uint16 *>(src);
+                for (size_t i = 0; i < count; i++)
+                    dst[i] = static_cast<float>(p[i]) * (1.0f / 65535.0f);
+                break;
+            }
+            case ChannelType::Snorm16: {
+                auto p = static_cast<const int16 *>(src);
+                for (size_t i = 0; i < count; i++)
+                    dst[i] = std::max(static_cast<float>(p[i]) * (1.0f / 32767.0f), -1.0f);
+                break;
+            }
+            case ChannelType::Srgb8:
+                ImageConvert::SrgbToLinear(static_cast<const uint8 *>(src), dst, count);
+                break;
+            case ChannelType::Half:
+                ImageConvert::HalfToFloat(static_cast<const uint16 *>(src), dst, count);
+                break;
+            case ChannelType::Float:
+                std::memcpy(dst, src, count * sizeof(float));
+                break;
+            default:
+                break;
+        }
+    }
+
+    /** Convert count floats to elements of type */
+    void EncodeElements(const float *src, ChannelType type, void *dst, size_t count) {
+        switch (type) {
+            case ChannelType::Unorm8: {
+                auto p = static_cast<uint8 *>(dst);
+                for (size_t i = 0; i < count; i++)
+                    p[i] = static_cast<uint8>(Clamp(src[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+                break;
+            }
+            case ChannelType::Snorm8: {
+                auto p = static_cast<int8 *>(dst);
+                for (size_t i = 0; i < count; i++)
+                    p[i] = static_cast<int8>(std::lround(Clamp(src[i], -1.0f, 1.0f) * 127.0f));
+                break;
+            }
+            case ChannelType::Unorm16: {
+                auto p = static_cast<uint16 *>(dst);
+                for (size_t i = 0; i < count; i++)
+                    p[i] = static_cast<uint16>(Clamp(src[i], 0.0f, 1.0f) * 65535.0f + 0.5f);
+                break;
+            }
+            case ChannelType::Snorm16: {
+                auto p = static_cast<int16 *>(dst);
+                for (size_t i = 0; i < count; i++)
+                    p[i] = static_cast<int16>(std::lround(Clamp(src[i], -1.0f, 1.0f) * 32767.0f));
+                break;
+            }
+            case ChannelType::Srgb8:
+                ImageConvert::LinearToSrgb(src, static_cast<uint8 *>(dst), count);
+                break;
+            case ChannelType::Half:
+                ImageConvert::FloatToHalf(src, static_cast<uint16 *>(dst), count);
+                break;
+            case ChannelType::Float:
+                std::memcpy(dst, src, count * sizeof(float));
+                break;
+            default:
+                break;
+        }
+    }
+
+    /** Decode count pixels; alpha of sRGB formats is linear */
+    void DecodePixels(const void *src, const FormatInfo &info, float *dst, uint32 count) {
+        DecodeElements(src, info.type, dst, static_cast<size_t>(count) * info.channels);
+
+        if (info.type == ChannelType::Srgb8 && info.channels == 4) {
+            auto p = static_cast<const uint8 *>(src);
+            for (uint32 i = 0; i < count; i++)
+                dst[i * 4 + 3] = static_cast<float>(p[i * 4 + 3]) * (1.0f / 255.0f);
+        }
+    }
+
+    /** Encode count pixels; alpha of sRGB formats is linear */
+    void EncodePixels(const float *src, const FormatInfo &info, void *dst, uint32 count) {
+        EncodeElements(src, info.type, dst, static_cast<size_t>(count) * info.channels);
+
+        if (info.type == ChannelType::Srgb8 && info.channels == 4) {
+            auto p = static_cast<uint8 *>(dst);
+            for (uint32 i = 0; i < count; i++)
+                p[i * 4 + 3] = static_cast<uint8>(Clamp(src[i * 4 + 3], 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+
+    /** Change channels count of 8-bit pixels of the same type */
+    void RepackBytes(const uint8 *src, uint32 srcChannels, uint8 *dst, uint32 dstChannels, uint32 count, uint8 alpha) {
+        if (srcChannels == 3 && dstChannels == 4) {
+            ImageConvert::Expand3To4(src, dst, count, alpha);
+            return;
+        }
+        if (srcChannels == 4 && dstChannels == 3) {
+            ImageConvert::Reduce4To3(src, dst, count);
+            return;
+        }
+
+        const uint8 defaults[4] = {0, 0, 0, alpha};
+
+        for (uint32 i = 0; i < count; i++) {
+            for (uint32 c = 0; c < dstChannels; c++)
+                dst[c] = c < srcChannels ? src[c] : defaults[c];
+            src += srcChannels;
+            dst += dstChannels;
+        }
+    }
+
+    /** Change channels count of float pixels */
+    void RepackFloats(const float *src, uint32 srcChannels, float *dst, uint32 dstChannels, uint32 count) {
+        if (srcChannels == 3 && dstChannels == 4) {
+            for (uint32 i = 0; i < count; i++) {
+                dst[i * 4 + 0] = src[i * 3 + 0];
+                dst[i * 4 + 1] = src[i * 3 + 1];
+                dst[i * 4 + 2] = src[i * 3 + 2];
+                dst[i * 4 + 3] = 1.0f;
+            }
+            return;
+        }
+
+        const float defaults[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+
+        for (uint32 i = 0; i < count; i++) {
+            for (uint32 c = 0; c < dstChannels; c++)
+                dst[c] = c < srcChannels ? src[c] : defaults[c];
+            src += srcChannels;
+            dst += dstChannels;
+        }
+    }
+
+    template<typename T>
+    void SwizzleRow(const uint8 *src, uint8 *dst, uint32 channels, const std::array<uint32, 4> &order, uint32 count) {
+        auto s = reinterpret_cast<const T *>(src);
+        auto d = reinterpret_cast<T *>(dst);
+
+        for (uint32 i = 0; i < count; i++) {
+            for (uint32 c = 0; c < channels; c++)
+                d[c] = s[order[c]];
+            s += channels;
+            d += channels;
+        }
+    }
+
+    /** Process rows of image, in parallel if job system provided */
+    void ProcessRows(uint32 height, uint32 rowBytes, JobSystem *jobSystem, const JobSystem::RangeFunc &func) {
+        if (jobSystem) {
+            auto grain = std::max(1u, JOB_BYTES / std::max(1u, rowBytes));
+            jobSystem->ParallelFor(height, grain, func);
+        } else {
+            func(0, height);
+        }
+    }
+
+}// namespace
+
+bool ImageConvert::CanConvert(Image::Format src, Image::Format dst) {
+    return GetInfo(src).type != ChannelType::Unknown && GetInfo(dst).type != ChannelType::Unknown;
+}
+
+Image ImageConvert::Convert(const Image &image, Image::Format format, JobSystem *jobSystem) {
+    if (!CanConvert(image.GetFormat(), format)) {
+        BRK_ERROR("Cannot convert image of format " << static_cast<int>(image.GetFormat()) << " to " << static_cast<int>(format));
+        return Image();
+    }
+    if (image.Empty()) {
+        BRK_ERROR("Cannot convert empty image");
+        return Image();
+    }
+
+    auto info = GetInfo(format);
+    auto width = image.GetWidth();
+    auto height = image.GetHeight();
+    auto pixelSize = info.channels * GetElementSize(info.type);
+    auto stride = width * pixelSize;
+    auto pixelData = Data::Make(static_cast<size_t>(stride) * height);
+
+    auto srcFormat = image.GetFormat();
+    auto srcStride = image.GetStride();
+    auto src = static_cast<const uint8 *>(image.GetPixelData()->GetData());
+    auto dst = static_cast<uint8 *>(pixelData->GetDataWrite());
+
+    ProcessRows(height, stride, jobSystem, [&](uint32 begin, uint32 end) {
+        for (uint32 row = begin; row < end; row++)
+            ConvertRow(src + static_cast<size_t>(row) * srcStride, srcFormat, dst + static_cast<size_t>(row) * stride, format, width);
+    });
+
+    return Image(width, height, stride, pixelSize, format, std::move(pixelData));
+}
+
+bool ImageConvert::ConvertRow(const void *src, Image::Format srcFormat, void *dst, Image::Format dstFormat, uint32 count) {
+    auto s = GetInfo(srcFormat);
+    auto d = GetInfo(dstFormat);
+
+    if (s.type == ChannelType::Unknown || d.type == ChannelType::Unknown)
+        return false;
+
+    auto srcPixelSize = s.channels * GetElementSize(s.type);
+    auto dstPixelSize = d.channels * GetElementSize(d.type);
+
+    if (srcFormat == dstFormat) {
+        std::memcpy(dst, src, static_cast<size_t>(count) * srcPixelSize);
+        return true;
+    }
+
+    // Only channels count differs, values are copied as is
+    if (s.type == d.type && GetElementSize(s.type) == 1) {
+        auto alpha = static_cast<uint8>(s.type == ChannelType::Snorm8 ? 0x7f : 0xff);
+        RepackBytes(static_cast<const uint8 *>(src), s.channels, static_cast<uint8 *>(dst), d.channels, count, alpha);
+        return true;
+    }
+
+    // No need for intermediate rows
+    if (s.channels == d.channels) {
+        if (s.type == ChannelType::Float) {
+            EncodePixels(static_cast<const float *>(src), d, dst, count);
+            return true;
+        }
+        if (d.type == ChannelType::Float) {
+            DecodePixels(src, s, static_cast<float *>(dst), count);
+            return true;
+        }
+    }
+
+    float decoded[CHUNK_PIXELS * 4];
+    float repacked[CHUNK_PIXELS * 4];
+
+    auto srcBytes = static_cast<const uint8 *>(src);
+    auto dstBytes = static_cast<uint8 *>(dst);
+
+    for (uint32 i = 0; i < count; i += CHUNK_PIXELS) {
+        auto chunk = std::min(CHUNK_PIXELS, count - i);
+        const float *pixels = decoded;
+
+        DecodePixels(srcBytes + static_cast<size_t>(i) * srcPixelSize, s, decoded, chunk);
+
+        if (s.channels != d.channels) {
+            RepackFloats(decoded, s.channels, repacked, d.channels, chunk);
+            pixels = repacked;
+        }
+
+        EncodePixels(pixels, d, dstBytes + static_cast<size_t>(i) * dstPixelSize, chunk);
+    }
+
+    return true;
+}
+
+Image ImageConvert::Swizzle(const Image &image, const std::array<uint32, 4> &order, JobSystem *jobSystem) {
+    auto info = GetInfo(image.GetFormat());
+
+    if (info.type == ChannelType::Unknown || image.Empty()) {
+        BRK_ERROR("Cannot swizzle image of format " << static_cast<int>(image.GetFormat()));
+        return Image();
+    }
+
+    for (uint32 c = 0; c < info.channels; c++) {
+        if (order[c] >= info.channels) {
+            BRK_ERROR("Invalid swizzle channel " << order[c] << " for image with " << info.channels << " channels");
+            return Image();
+        }
+    }
+
+    auto width = image.GetWidth();
+    auto height = image.GetHeight();
+    auto elementSize = GetElementSize(info.type);
+    auto stride = width * info.channels * elementSize;
+    auto pixelData = Data::Make(static_cast<size_t>(stride) * height);
+
+    auto srcStride = image.GetStride();
+    auto src = static_cast<const uint8 *>(image.GetPixelData()->GetData());
+    auto dst = static_cast<uint8 *>(pixelData->GetDataWrite());
+
+    ProcessRows(height, stride, jobSystem, [&](uint32 begin, uint32 end) {
+        for (uint32 row = begin; row < end; row++) {
+            auto s = src + static_cast<size_t>(row) * srcStride;
+            auto d = dst + static_cast<size_t>(row) * stride;
+
+            if (elementSize == 1)
+                SwizzleRow<uint8>(s, d, info.channels, order, width);
+            else if (elementSize == 2)
+                SwizzleRow<uint16>(s, d, info.channels, order, width);
+            else
+                SwizzleRow<uint32>(s, d, info.channels, order, width);
+        }
+    });
+
+    return Image(width, height, stride, info.channels * elementSize, image.GetFormat(), std::move(pixelData));
+}
+
+Image::Format ImageConvert::GetUploadFormat(Image::Format format) {
+    switch (format) {
+        case Image::Format::RGB8:
+            return Image::Format::RGBA8;
+        case Image::Format::RGB8_SNORM:
+            return Image::Format::RGBA8_SNORM;
+        case Image::Format::SRGB8:
+            return Image::Format::SRGB8_ALPHA8;
+        case Image::Format::RGB16F:
+            return Image::Format::RGBA16F;
+        case Image::Format::RGB32F:
+            return Image::Format::RGBA32F;
+        default:
+            return format;
+    }
+}
+
+void ImageConvert::FloatToHalf(const float *src, uint16 *dst, size_t count) {
+    GetFloatToHalfFunc()(src, dst, count);
+}
+
+void ImageConvert::HalfToFloat(const uint16 *src, float *dst, size_t count) {
+    GetHalfToFloatFunc()(src, dst, count);
+}
+
+void ImageConvert::SrgbToLinear(const uint8 *src, float *dst, size_t count) {
+    auto &table = GetSrgbTables().toLinear;
+
+    for (size_t i = 0; i < count; i++)
+        dst[i] = table[src[i]];
+}
+
+void ImageConvert::LinearToSrgb(const float *src, uint8 *dst, size_t count) {
+    auto table = GetSrgbTables().toSrgb.data();
+    auto scale = static_cast<float>(LINEAR_TO_SRGB_SIZE - 1);
+    size_t i = 0;
+
+#if defined(BRK_SIMD_SSE)
+    // Table indices are computed 4 at once, max with NaN selects zero
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale4 = _mm_set1_ps(scale);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), zero), one);
+        __m128i index = _mm_cvtps_epi32(_mm_mul_ps(v, scale4));
+
+        dst[i + 0] = table[_mm_cvtsi128_si32(index)];
+        dst[i + 1] = table[_mm_cvtsi128_si32(_mm_srli_si128(index, 4))];
+        dst[i + 2] = table[_mm_cvtsi128_si32(_mm_srli_si128(index, 8))];
+        dst[i + 3] = table[_mm_cvtsi128_si32(_mm_srli_si128(index, 12))];
+    }
+#elif defined(BERSERK_IMAGE_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t v = vminq_f32(vmaxq_f32(vld1q_f32(src + i), zero), one);
+        uint32x4_t index = vcvtnq_u32_f32(vmulq_n_f32(v, scale));
+
+        dst[i + 0] = table[vgetq_lane_u32(index, 0)];
+        dst[i + 1] = table[vgetq_lane_u32(index, 1)];
+        dst[i + 2] = table[vgetq_lane_u32(index, 2)];
+        dst[i + 3] = table[vgetq_lane_u32(index, 3)];
+    }
+#endif
+
+    for (; i < count; i++)
+        dst[i] = table[static_cast<uint32>(Clamp(src[i], 0.0f, 1.0f) * scale + 0.5f)];
+}
+
+void ImageConvert::Expand3To4(const uint8 *src, uint8 *dst, size_t count, uint8 alpha) {
+    GetExpand3To4Func()(src, dst, count, alpha);
+}
+
+void ImageConvert::Reduce4To3(const uint8 *src, uint8 *dst, size_t count) {
+    GetReduce4To3Func()(src, dst, count);
+}
+
+bool ImageConvert::IsHalfHardwareAccelerated() {
+    return GetFloatToHalfFunc() != FloatToHalfScalar;
+}
+
+BRK_NS_END
@@ -0,0 +1,127 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_IMAGECONVERT_HPP
+#define BERSERK_IMAGECONVERT_HPP
+
+#include <core/Config.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+#include <core/image/Image.hpp>
+
+#include <array>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * @class ImageConvert
+ * @brief Pixel format conversion
+ *
+ * Converts between all color formats (8 and 16 bit normalized, sRGB,
+ * half and single float) preserving represented values: sRGB channels
+ * are decoded to linear, missing channels are filled with (0, 0, 0, 1).
+ * Common pairs use dedicated kernels: 3 to 4 channels expansion, half
+ * conversion (F16C on x64 selected at runtime, NEON on arm64) and sRGB
+ * lookup tables; other pairs are converted through float rgba rows.
+ */
+class ImageConvert {
+public:
+    /** @return True if image of src format can be converted to dst format */
+    BRK_API static bool CanConvert(Image::Format src, Image::Format dst);
+
+    /**
+     * @brief Convert image to other format
+     *
+     * @param image Image to convert
+     * @param format Format of the result
+     * @param jobSystem Optional job system to convert rows in parallel
+     *
+     * @return Converted image; empty if conversion is not supported
+     */
+    BRK_API static Image Convert(const Image &image, Image::Format format, JobSystem *jobSystem = nullptr);
+
+    /**
+     * @brief Convert count pixels of src format to dst format
+     * @return True if converted
+     */
+    BRK_API static bool ConvertRow(const void *src, Image::Format srcFormat, void *dst, Image::Format dstFormat, uint32 count);
+
+    /**
+     * @brief Reorder channels of the image
+     *
+     * @param image Image to swizzle
+     * @param order Index of source channel for each channel of result (for instance {2, 1, 0, 3} swaps red and blue)
+     * @param jobSystem Optional job system to process rows in parallel
+     *
+     * @return Swizzled image; empty if order is invalid for the image format
+     */
+    BRK_API static Image Swizzle(const Image &image, const std::array<uint32, 4> &order, JobSystem *jobSystem = nullptr);
+
+    /**
+     * @brief Format to upload without conversion by the driver
+     *
+     * Three channel formats are expanded to four channels, since
+     * drivers store them as four channel textures anyway.
+     *
+     * @return Upload format; same format if no conversion is required
+     */
+    BRK_API static Image::Format GetUploadFormat(Image::Format format);
+
+    /** Convert floats to half floats (round to nearest even) */
+    BRK_API static void FloatToHalf(const float *src, uint16 *dst, size_t count);
+
+    /** Convert half floats to floats */
+    BRK_API static void HalfToFloat(const uint16 *src, float *dst, size_t count);
+
+    /** Decode sRGB encoded values to linear */
+    BRK_API static void SrgbToLinear(const uint8 *src, float *dst, size_t count);
+
+    /** Encode linear values to sRGB (values are clamped to [0, 1]) */
+    BRK_API static void LinearToSrgb(const float *src, uint8 *dst, size_t count);
+
+    /** Expand 3 channel 8-bit pixels to 4 channels with alpha value */
+    BRK_API static void Expand3To4(const uint8 *src, uint8 *dst, size_t count, uint8 alpha = 0xff);
+
+    /** Drop alpha channel of 4 channel 8-bit pixels */
+    BRK_API static void Reduce4To3(const uint8 *src, uint8 *dst, size_t count);
+
+    /** @return True if half conversion uses hardware instructions */
+    BRK_API static bool IsHalfHardwareAccelerated();
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_IMAGECONVERT_HPP
@@ -0,0 +1,146 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/image/ImageDecoder.hpp>
+#include <core/io/Logger.hpp>
+#include <core/profiler/Profiler.hpp>
+
+BRK_NS_BEGIN
+
+ImageDecoder::ImageDecoder(JobSystem &jobSystem) : mJobSystem(jobSystem) {
+}
+
+ImageDecoder::~ImageDecoder() {
+    WaitIdle();
+}
+
+ImageDecoder::Handle ImageDecoder::Submit(Request request) {
+    if (request.filepath.empty() && request.encoded.IsNull()) {
+        BRK_ERROR("No file or encoded data to decode");
+        return INVALID_HANDLE;
+    }
+
+    auto op = std::make_shared<Op>();
+    op->request = std::move(request);
+
+    Handle handle;
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        handle = mNextHandle++;
+        op->result.handle = handle;
+        mPending += 1;
+        mJobs += 1;
+
+        // Results of requests with callback are consumed by the callback
+        if (!op->request.callback)
+            mOps.emplace(handle, op);
+    }
+
+    mJobSystem.Submit([this, op]() {
+        Run(op);
+
+        // Decoder may be destroyed right after the last job is finished
+        std::lock_guard<std::mutex> guard(mMutex);
+        mJobs -= 1;
+        mCvar.notify_all();
+    });
+    return handle;
+}
+
+void ImageDecoder::SubmitBatch(std::vector<Request> &requests, std::vector<Handle> &handles) {
+    handles.clear();
+    handles.reserve(requests.size());
+
+    for (auto &request : requests)
+        handles.push_back(Submit(std::move(request)));
+
+    requests.clear();
+}
+
+bool ImageDecoder::Wait(Handle handle, Result &result) {
+    std::shared_ptr<Op> op;
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        auto query = mOps.find(handle);
+
+        if (query == mOps.end())
+            return false;
+
+        op = query->second;
+        mOps.erase(query);
+    }
+
+    // Not started yet, so decode here instead of waiting for worker
+    if (!Run(op)) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCvar.wait(lock, [&]() { return op->finished; });
+    }
+
+    result = std::move(op->result);
+    return true;
+}
+
+void ImageDecoder::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCvar.wait(lock, [&]() { return mPending == 0 && mJobs == 0; });
+}
+
+uint32 ImageDecoder::GetPendingCount() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mPending;
+}
+
+Image ImageDecoder::Decode(const Request &request) {
+    BRK_PROFILE_SCOPE("ImageDecoder::Decode");
+
+    if (request.encoded.IsNotNull())
+        return Image::DecodeRgba(request.encoded->GetData(), request.encoded->GetSize(), request.channels);
+
+    return Image::LoadRgba(request.filepath, request.channels);
+}
+
+bool ImageDecoder::Run(const std::shared_ptr<Op> &op) {
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        if (op->started)
+            return false;
+        op->started = true;
+    }
+
+    op->result.image = Decode(op->request);
+
+    if (op->request.callback)
+        op->request.callback(op->result);
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    op->finished = true;
+    mPending -= 1;
+    mCvar.notify_all();
+    return true;
+}
+
+BRK_NS_END
@@ -0,0 +1,163 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_IMAGEDECODER_HPP
+#define BERSERK_IMAGEDECODER_HPP
+
+#include <core/Config.hpp>
+#include <core/Data.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+#include <core/image/Image.hpp>
+#include <core/string/String.hpp>
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * @class ImageDecoder
+ * @brief Concurrent image decode service
+ *
+ * Decodes submitted images as jobs of the job system, so many
+ * images (for instance, textures of the level) are decoded at once
+ * on all workers instead of one by one on the loading thread.
+ * Pixels are decoded directly into the image data without copy.
+ *
+ * Waiting for a request, which is not started yet, decodes it on
+ * the waiting thread, so waiting never depends on free workers
+ * and is safe within jobs.
+ *
+ * @note Thread-safe
+ */
+class ImageDecoder final {
+public:
+    /** Handle to identify submitted request */
+    using Handle = uint64;
+
+    /** Invalid request handle */
+    static const Handle INVALID_HANDLE = 0;
+
+    /** @brief Result of decode request */
+    struct Result {
+        Handle handle = INVALID_HANDLE; /** Handle of the request */
+        Image image;                    /** Decoded image; empty if failed */
+    };
+
+    /** Completion callback type */
+    using Callback = std::function<void(Result &result)>;
+
+    /** @brief Decode request */
+    struct Request {
+        String filepath;     /** Path of the file to decode; used if no encoded data provided */
+        Ref<Data> encoded;   /** Encoded file data (optional) */
+        uint32 channels = 4; /** Number of channels to decode; must be within {1,2,3,4} */
+        Callback callback;   /** Called on decoding thread; result is consumed by callback and cannot be waited (optional) */
+    };
+
+    /** @param jobSystem Job system to run decode jobs */
+    BRK_API explicit ImageDecoder(JobSystem &jobSystem);
+
+    /** Waits for submitted requests */
+    BRK_API ~ImageDecoder();
+
+    /**
+     * @brief Submit decode request
+     *
+     * @param request Request to submit
+     * @return Handle of request or invalid handle if request is invalid
+     */
+    BRK_API Handle Submit(Request request);
+
+    /**
+     * @brief Submit batch of requests
+     *
+     * @param requests Requests to submit (moved out)
+     * @param[out] handles Handles of requests in the same order
+     */
+    BRK_API void SubmitBatch(std::vector<Request> &requests, std::vector<Handle> &handles);
+
+    /**
+     * @brief Block until request is decoded and take its result
+     *
+     * Request without callback must be waited once to release its result.
+     *
+     * @param handle Handle of request without callback
+     * @param[out] result Result of the request
+     * @return True if request found
+     */
+    BRK_API bool Wait(Handle handle, Result &result);
+
+    /** Block until all submitted requests are decoded */
+    BRK_API void WaitIdle();
+
+    /** @return Number of not decoded requests */
+    BRK_API uint32 GetPendingCount() const;
+
+    /** Decode request on the calling thread */
+    BRK_API static Image Decode(const Request &request);
+
+private:
+    /** State of submitted request */
+    struct Op {
+        Request request;
+        Result result;
+        bool started = false;  /** Taken by job or waiting thread */
+        bool finished = false; /** Result is ready */
+    };
+
+    /** Decode op if it is not taken yet; @return True if decoded by this call */
+    bool Run(const std::shared_ptr<Op> &op);
+
+private:
+    std::unordered_map<Handle, std::shared_ptr<Op>> mOps; /** Not taken requests */
+    JobSystem &mJobSystem;
+    Handle mNextHandle = INVALID_HANDLE + 1;
+    uint32 mPending = 0; /** Number of not decoded requests */
+    uint32 mJobs = 0;    /** Number of not finished jobs */
+
+    mutable std::mutex mMutex;
+    std::condition_variable mCvar;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_IMAGEDECODER_HPP
@@ -76,10 +76,13 @@ uint32 ImageUtil::GetPixelSize(Image::Format format) {
         case Image::Format::SRGB8_ALPHA8:
             return 4;
         case Image::Format::R16F:
+            return 2;
         case Image::Format::RG16F:
+            return 4;
         case Image::Format::RGB16F:
+            return 6;
         case Image::Format::RGBA16F:
-            return 0;
+            return 8;
         case Image::Format::R32F:
             return 4;
         case Image::Format::RG32F:
@@ -165,12 +168,10 @@ bool ImageUtil::CanAccept(Image::Format format) {
         case Image::Format::RGBA16:
         case Image::Format::SRGB8:
         case Image::Format::SRGB8_ALPHA8:
-            return true;
         case Image::Format::R16F:
         case Image::Format::RG16F:
         case Image::Format::RGB16F:
         case Image::Format::RGBA16F:
-            return false;
         case Image::Format::R32F:
         case Image::Format::RG32F:
         case Image::Format::RGB32F:
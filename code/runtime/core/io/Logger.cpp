@@ -29,9 +29,225 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <csignal>
+#include <cstring>
 
 BRK_NS_BEGIN
 
+/**
+ * @class LoggerThreadBuffer
+ * @brief Single-producer single-consumer ring of encoded records
+ *
+ * Buffer is shared by owner thread and logger. Owner thread releases it on exit,
+ * then logger drops it after remaining records are read. Logger detaches it on
+ * destruction, then owner thread drops it on next look-up.
+ */
+class LoggerThreadBuffer final {
+public:
+    static const uint64 CAPACITY = Logger::BUFFER_CAPACITY;
+    static const uint64 MASK = CAPACITY - 1;
+
+    LoggerThreadBuffer() : mData(static_cast<uint32>(CAPACITY)) {}
+
+    /** Called only by owner thread; @return False if not enough space */
+    bool TryWrite(const uint8 *data, uint32 size) {
+        auto tail = mTail.load(std::memory_order_relaxed);
+        auto head = mHead.load(std::memory_order_acquire);
+
+        if (CAPACITY - (tail - head) < sizeof(uint32) + size)
+            return false;
+
+        Copy(tail, reinterpret_cast<const uint8 *>(&size), sizeof(uint32));
+        Copy(tail + sizeof(uint32), data, size);
+        mTail.store(tail + sizeof(uint32) + size, std::memory_order_release);
+        return true;
+    }
+
+    /** Called only by logger thread; appends records to batch */
+    template<typename Func>
+    void Read(std::vector<uint8> &batch, Func &&onRecord) {
+        auto head = mHead.load(std::memory_order_relaxed);
+        auto tail = mTail.load(std::memory_order_acquire);
+
+        while (head < tail) {
+            uint32 size;
+            Read(head, reinterpret_cast<uint8 *>(&size), sizeof(uint32));
+
+            auto offset = batch.size();
+            batch.resize(offset + size);
+            Read(head + sizeof(uint32), batch.data() + offset, size);
+            onRecord(offset, static_cast<size_t>(size));
+
+            head += sizeof(uint32) + size;
+        }
+
+        mHead.store(head, std::memory_order_release);
+    }
+
+    /** Called by owner thread on exit */
+    void Release() { mReleased.store(true, std::memory_order_release); }
+    /** Called by logger on destruction */
+    void Detach() { mDetached.store(true, std::memory_order_release); }
+
+    bool IsReleased() const { return mReleased.load(std::memory_order_acquire); }
+    bool IsDetached() const { return mDetached.load(std::memory_order_acquire); }
+    bool IsEmpty() const { return mHead.load(std::memory_order_relaxed) == mTail.load(std::memory_order_acquire); }
+
+private:
+    void Copy(uint64 position, const uint8 *data, size_t size) {
+        auto offset = static_cast<size_t>(position & MASK);
+        auto first = std::min(size, static_cast<size_t>(CAPACITY) - offset);
+        std::memcpy(mData.data() + offset, data, first);
+        std::memcpy(mData.data(), data + first, size - first);
+    }
+
+    void Read(uint64 position, uint8 *data, size_t size) const {
+        auto offset = static_cast<size_t>(position & MASK);
+        auto first = std::min(size, static_cast<size_t>(CAPACITY) - offset);
+        std::memcpy(data, mData.data() + offset, first);
+        std::memcpy(data + first, mData.data(), size - first);
+    }
+
+    std::vector<uint8> mData;
+    std::atomic<uint64> mHead{0};      /** Bytes consumed by logger thread */
+    std::atomic<uint64> mTail{0};      /** Bytes written by owner thread */
+    std::atomic_bool mReleased{false}; /** Owner thread exited */
+    std::atomic_bool mDetached{false}; /** Logger destroyed */
+};
+
+namespace {
+    /** Type tags of encoded arguments */
+    enum ArgType : uint8 {
+        ArgBool = 0,
+        ArgChar = 1,
+        ArgInt = 2,
+        ArgUInt = 3,
+        ArgFloat = 4,
+        ArgString = 5,
+        ArgPointer = 6
+    };
+
+    /** Record header, followed by encoded arguments */
+    struct RecordHeader {
+        uint64 time;
+        const LogSite *site; /** Null for messages logged with dynamic site */
+        Logger::Level level;
+    };
+
+    /** Max size of single record, longer strings are truncated */
+    const size_t MAX_RECORD_SIZE = Logger::BUFFER_CAPACITY / 4;
+
+    std::atomic<uint32> gLoggerIds{0};
+
+    struct ThreadBufferRef {
+        uint32 loggerId;
+        std::shared_ptr<LoggerThreadBuffer> buffer;
+    };
+
+    struct ThreadLogState {
+        uint32 loggerId = 0xffffffff;         /** Logger of the cached buffer */
+        LoggerThreadBuffer *buffer = nullptr; /** Buffer of the last used logger */
+        std::vector<ThreadBufferRef> buffers; /** Buffers of the thread per logger */
+        std::vector<uint8> scratch;
+        bool scratchInUse = false;
+
+        ~ThreadLogState() {
+            for (auto &ref : buffers)
+                ref.buffer->Release();
+        }
+    };
+
+    thread_local ThreadLogState gThreadLog;
+
+    /** Logger which thread is the calling thread */
+    thread_local const Logger *gThreadOwner = nullptr;
+
+    Logger *gCrashLogger = nullptr;
+
+    uint64 GetLogTime() {
+        using namespace std::chrono;
+        return static_cast<uint64>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    template<typename T>
+    void Put(std::vector<uint8> &data, const T &value) {
+        auto offset = data.size();
+        data.resize(offset + sizeof(T));
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+    }
+
+    template<typename T>
+    T Get(const uint8 *&data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        data += sizeof(T);
+        return value;
+    }
+
+    String GetString(const uint8 *&data) {
+        auto length = Get<uint32>(data);
+        String value(reinterpret_cast<const char *>(data), length);
+        data += length;
+        return value;
+    }
+
+    /** Format encoded arguments in range */
+    void FormatArgs(std::ostream &stream, const uint8 *data, const uint8 *end) {
+        while (data < end) {
+            switch (Get<uint8>(data)) {
+                case ArgBool:
+                    stream << Get<bool>(data);
+                    break;
+                case ArgChar:
+                    stream << Get<char>(data);
+                    break;
+                case ArgInt:
+                    stream << Get<int64>(data);
+                    break;
+                case ArgUInt:
+                    stream << Get<uint64>(data);
+                    break;
+                case ArgFloat:
+                    stream << Get<double>(data);
+                    break;
+                case ArgString:
+                    stream << GetString(data);
+                    break;
+                case ArgPointer:
+                    stream << Get<const void *>(data);
+                    break;
+                default:
+                    assert(false && "Corrupted log record");
+                    return;
+            }
+        }
+    }
+}// namespace
+
+Logger::Logger() {
+    mLoggerId = gLoggerIds.fetch_add(1);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> guard(mStateMutex);
+        mDestroyed.store(true);
+    }
+
+    Shutdown();
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        for (auto &buffer : mBuffers)
+            buffer->Detach();
+        mBuffers.clear();
+    }
+
+    if (gCrashLogger == this)
+        gCrashLogger = nullptr;
+}
+
 void Logger::SetLevel(berserk::Logger::Level level) {
     mLevel.store(level);
 }
@@ -48,47 +264,76 @@ void Logger::SetActive(bool active) {
 
 void Logger::AddListener(Logger::Listener listener) {
     std::lock_guard<std::mutex> guard(mMutex);
-    mListeners.push_back(std::move(listener));
+
+    // Listeners are called without lock on snapshot, so list is replaced instead of changed
+    auto listeners = std::make_shared<std::vector<Listener>>(mListeners ? *mListeners : std::vector<Listener>());
+    listeners->push_back(std::move(listener));
+    mListeners = std::move(listeners);
 }
 
 void Logger::Log(Logger::Level level, String message, String function, String file, size_t line) {
-    Entry entry{std::move(message), std::move(function), std::move(file), line, level};
-    AddEntry(std::move(entry));
+    if (ShouldLog(level)) {
+        LogRecord record(*this, level, nullptr);
+        record << function << file << static_cast<uint64>(line) << message;
+    }
 }
 
 void Logger::LogInfo(String message, String function, String file, size_t line) {
-    Entry entry{std::move(message), std::move(function), std::move(file), line, Level::Info};
-    AddEntry(std::move(entry));
+    Log(Level::Info, std::move(message), std::move(function), std::move(file), line);
 }
 
 void Logger::LogWarning(String message, String function, String file, size_t line) {
-    Entry entry{std::move(message), std::move(function), std::move(file), line, Level::Warning};
-    AddEntry(std::move(entry));
+    Log(Level::Warning, std::move(message), std::move(function), std::move(file), line);
 }
 
 void Logger::LogError(String message, String function, String file, size_t line) {
-    Entry entry{std::move(message), std::move(function), std::move(file), line, Level::Error};
-    AddEntry(std::move(entry));
+    Log(Level::Error, std::move(message), std::move(function), std::move(file), line);
 }
 
-void Logger::Shrink() {
-    while (mEntries.size() >= mSize)
-        mEntries.pop();
+void Logger::Flush() {
+    if (OnLoggerThread() || !mRunning.load())
+        return;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    auto request = mFlushRequests.fetch_add(1) + 1;
+    mWakeUp.notify_one();
+    mFlushed.wait(lock, [&]() { return mFlushServed.load() >= request || !mRunning.load(); });
 }
 
-void Logger::AddEntry(Logger::Entry &&entry) {
-    std::lock_guard<std::mutex> guard(mMutex);
+void Logger::InstallCrashHandler() {
+    gCrashLogger = this;
 
-    if (ShouldLog(entry.level)) {
-        // Remove old entries
-        Shrink();
+    std::signal(SIGSEGV, &Logger::OnCrashSignal);
+    std::signal(SIGABRT, &Logger::OnCrashSignal);
+    std::signal(SIGFPE, &Logger::OnCrashSignal);
+    std::signal(SIGILL, &Logger::OnCrashSignal);
+}
 
-        // Notify listeners
-        std::for_each(mListeners.begin(), mListeners.end(), [&](Listener &listener) { listener(entry); });
+void Logger::Shutdown() {
+    if (OnLoggerThread())
+        return;
 
-        // Store new entry
-        mEntries.push(std::move(entry));
+    std::lock_guard<std::mutex> stateGuard(mStateMutex);
+
+    if (mRunning.load()) {
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            mRunning.store(false);
+            mWakeUp.notify_one();
+        }
+
+        mThread.join();
     }
+
+    // Records committed while thread was stopping, thread can not start until state lock is released.
+    // This thread acts as logger thread meanwhile, so records of listeners are dispatched in place.
+    auto owner = gThreadOwner;
+    gThreadOwner = this;
+    Drain();
+    gThreadOwner = owner;
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    mFlushed.notify_all();
 }
 
 Logger::Level Logger::GetLevel() const {
@@ -103,10 +348,318 @@ bool Logger::ShouldLog(Level level) const {
     return IsActive() && static_cast<uint32>(GetLevel()) <= static_cast<uint32>(level);
 }
 
+uint32 Logger::GetBuffersCount() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return static_cast<uint32>(mBuffers.size());
+}
+
 Logger &Logger::Instance() {
     return gLogger;
 }
 
+LoggerThreadBuffer *Logger::GetThreadBuffer() {
+    auto &state = gThreadLog;
+
+    if (state.loggerId == mLoggerId)
+        return state.buffer;
+
+    // Drop buffers of destroyed loggers, so thread keeps memory only for alive ones
+    auto &buffers = state.buffers;
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(), [](const ThreadBufferRef &ref) { return ref.buffer->IsDetached(); }), buffers.end());
+
+    auto query = std::find_if(buffers.begin(), buffers.end(), [&](const ThreadBufferRef &ref) { return ref.loggerId == mLoggerId; });
+
+    if (query == buffers.end()) {
+        ThreadBufferRef ref;
+        ref.loggerId = mLoggerId;
+        ref.buffer = std::make_shared<LoggerThreadBuffer>();
+
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            mBuffers.push_back(ref.buffer);
+        }
+
+        buffers.push_back(std::move(ref));
+        query = buffers.end() - 1;
+    }
+
+    state.loggerId = mLoggerId;
+    state.buffer = query->buffer.get();
+
+    return state.buffer;
+}
+
+bool Logger::Start() {
+    std::lock_guard<std::mutex> guard(mStateMutex);
+
+    if (mDestroyed.load())
+        return false;
+
+    if (!mRunning.load()) {
+        mRunning.store(true);
+        mThread = std::thread([this]() { Run(); });
+    }
+
+    return true;
+}
+
+void Logger::Commit(const std::vector<uint8> &record, bool wakeUp) {
+    // Logger thread (listeners logging) can not wait for itself, so its records are dispatched in place.
+    // Thread is started by first message, destroyed logger (static destruction) dispatches in place.
+    if (OnLoggerThread() || (!mRunning.load(std::memory_order_relaxed) && !Start())) {
+        Dispatch(record.data(), record.size());
+        return;
+    }
+
+    auto buffer = GetThreadBuffer();
+    auto size = static_cast<uint32>(record.size());
+
+    while (!buffer->TryWrite(record.data(), size)) {
+        mStalls.fetch_add(1, std::memory_order_relaxed);
+        mWakeUp.notify_one();
+        std::this_thread::yield();
+    }
+
+    if (wakeUp)
+        mWakeUp.notify_one();
+}
+
+void Logger::Run() {
+    gThreadOwner = this;
+
+    while (true) {
+        auto running = mRunning.load();
+        auto flushRequest = mFlushRequests.load();
+
+        Drain();
+
+        if (flushRequest != mFlushServed.load()) {
+            std::lock_guard<std::mutex> guard(mMutex);
+            mFlushServed.store(flushRequest);
+            mFlushed.notify_all();
+        }
+
+        if (!running)
+            break;
+
+        // Call sites do not notify on each message, so the thread also wakes up by timeout
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWakeUp.wait_for(lock, std::chrono::milliseconds(2), [&]() { return !mRunning.load() || mFlushRequests.load() != mFlushServed.load(); });
+    }
+}
+
+bool Logger::Drain() {
+    std::vector<LoggerThreadBuffer *> buffers;
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        for (auto &buffer : mBuffers)
+            buffers.push_back(buffer.get());
+    }
+
+    mBatch.clear();
+    mMessages.clear();
+
+    bool released = false;
+
+    for (auto buffer : buffers) {
+        released = released || buffer->IsReleased();
+        buffer->Read(mBatch, [&](size_t offset, size_t size) {
+            Message message{};
+            message.offset = offset;
+            message.size = size;
+            mMessages.push_back(message);
+        });
+    }
+
+    // Owner threads exited, so nothing is written to their buffers after they are read
+    if (released) {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mBuffers.erase(std::remove_if(mBuffers.begin(), mBuffers.end(), [](const std::shared_ptr<LoggerThreadBuffer> &buffer) {
+                           return buffer->IsReleased() && buffer->IsEmpty();
+                       }),
+                       mBuffers.end());
+    }
+
+    if (mMessages.empty())
+        return false;
+
+    // Restore global order of messages from different threads
+    for (auto &message : mMessages)
+        std::memcpy(&message.time, mBatch.data() + message.offset, sizeof(uint64));
+
+    std::stable_sort(mMessages.begin(), mMessages.end(), [](const Message &a, const Message &b) { return a.time < b.time; });
+
+    for (auto &message : mMessages)
+        Dispatch(mBatch.data() + message.offset, message.size);
+
+    return true;
+}
+
+void Logger::Dispatch(const uint8 *record, size_t size) {
+    auto end = record + size;
+    auto header = Get<RecordHeader>(record);
+
+    Entry entry;
+    entry.level = header.level;
+
+    if (header.site) {
+        entry.function = header.site->function;
+        entry.file = header.site->file;
+        entry.line = header.site->line;
+    } else {
+        // Dynamic site is encoded as first arguments
+        record += sizeof(uint8);
+        entry.function = GetString(record);
+        record += sizeof(uint8);
+        entry.file = GetString(record);
+        record += sizeof(uint8);
+        entry.line = static_cast<size_t>(Get<uint64>(record));
+    }
+
+    // Stream of logger thread is reused, since construction of stream costs more than formatting
+    std::stringstream localStream;
+    auto &stream = OnLoggerThread() ? mFormatStream : localStream;
+    stream.str(String());
+    stream.clear();
+    FormatArgs(stream, record, end);
+    entry.message = stream.str();
+
+    AddEntry(std::move(entry));
+}
+
+bool Logger::OnLoggerThread() const {
+    return gThreadOwner == this;
+}
+
+void Logger::Shrink() {
+    while (mEntries.size() >= mSize)
+        mEntries.pop();
+}
+
+void Logger::AddEntry(Logger::Entry &&entry) {
+    std::shared_ptr<const std::vector<Listener>> listeners;
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+
+        // Remove old entries
+        Shrink();
+
+        // Store new entry
+        mEntries.push(entry);
+        listeners = mListeners;
+    }
+
+    // Notify listeners without lock, so they can log too
+    if (listeners) {
+        for (auto &listener : *listeners)
+            listener(entry);
+    }
+}
+
+void Logger::FlushFromSignal() {
+    if (OnLoggerThread() || !mRunning.load())
+        return;
+
+    // Locks may be held by crashed thread, so wait for logger thread with bounded spin
+    auto request = mFlushRequests.fetch_add(1) + 1;
+
+    for (int i = 0; i < 500 && mFlushServed.load() < request; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void Logger::OnCrashSignal(int signal) {
+    if (gCrashLogger)
+        gCrashLogger->FlushFromSignal();
+
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
+
 Logger Logger::gLogger;
 
-BRK_NS_END
\ No newline at end of file
+LogRecord::LogRecord(Logger &logger, Logger::Level level, const LogSite *site) : mLogger(logger) {
+    auto &state = gThreadLog;
+
+    // Argument formatting may log itself, then nested record uses own buffer
+    mScratch = !state.scratchInUse;
+    mData = mScratch ? &state.scratch : &mNested;
+    state.scratchInUse = true;
+    mWakeUp = level == Logger::Level::Error;
+
+    RecordHeader header{};
+    header.time = GetLogTime();
+    header.site = site;
+    header.level = level;
+
+    mData->clear();
+    Put(*mData, header);
+}
+
+LogRecord::~LogRecord() {
+    mLogger.Commit(*mData, mWakeUp);
+
+    if (mScratch)
+        gThreadLog.scratchInUse = false;
+}
+
+#define BRK_LOG_RECORD_PUT(type, tag, stored)      \
+    LogRecord &LogRecord::operator<<(type value) { \
+        Put(*mData, static_cast<uint8>(tag));      \
+        Put(*mData, static_cast<stored>(value));   \
+        return *this;                              \
+    }
+
+BRK_LOG_RECORD_PUT(bool, ArgBool, bool)
+BRK_LOG_RECORD_PUT(char, ArgChar, char)
+BRK_LOG_RECORD_PUT(signed char, ArgChar, char)
+BRK_LOG_RECORD_PUT(unsigned char, ArgChar, char)
+BRK_LOG_RECORD_PUT(short, ArgInt, int64)
+BRK_LOG_RECORD_PUT(unsigned short, ArgUInt, uint64)
+BRK_LOG_RECORD_PUT(int, ArgInt, int64)
+BRK_LOG_RECORD_PUT(unsigned int, ArgUInt, uint64)
+BRK_LOG_RECORD_PUT(long, ArgInt, int64)
+BRK_LOG_RECORD_PUT(unsigned long, ArgUInt, uint64)
+BRK_LOG_RECORD_PUT(long long, ArgInt, int64)
+BRK_LOG_RECORD_PUT(unsigned long long, ArgUInt, uint64)
+BRK_LOG_RECORD_PUT(float, ArgFloat, double)
+BRK_LOG_RECORD_PUT(double, ArgFloat, double)
+BRK_LOG_RECORD_PUT(long double, ArgFloat, double)
+BRK_LOG_RECORD_PUT(const void *, ArgPointer, const void *)
+
+#undef BRK_LOG_RECORD_PUT
+
+LogRecord &LogRecord::operator<<(const char *value) {
+    if (value)
+        WriteString(value, std::strlen(value));
+    else
+        WriteString("(null)", 6);
+    return *this;
+}
+
+LogRecord &LogRecord::operator<<(const String &value) {
+    WriteString(value.data(), value.size());
+    return *this;
+}
+
+LogRecord &LogRecord::operator<<(std::ostream &(*manipulator)(std::ostream &)) {
+    // Stream state is not kept between arguments, so only output of manipulator is stored
+    std::stringstream stream;
+    stream << manipulator;
+    return *this << stream.str();
+}
+
+void LogRecord::WriteString(const char *value, size_t length) {
+    auto header = sizeof(uint8) + sizeof(uint32);
+    auto available = MAX_RECORD_SIZE > mData->size() + header ? MAX_RECORD_SIZE - mData->size() - header : 0;
+    auto size = static_cast<uint32>(std::min(length, available));
+
+    Put(*mData, static_cast<uint8>(ArgString));
+    Put(*mData, size);
+
+    auto offset = mData->size();
+    mData->resize(offset + size);
+    std::memcpy(mData->data() + offset, value, size);
+}
+
+BRK_NS_END
@@ -33,10 +33,14 @@
 #include <core/string/String.hpp>
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <ostream>
 #include <queue>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 BRK_NS_BEGIN
@@ -46,9 +50,31 @@ BRK_NS_BEGIN
  * @{
  */
 
+class LoggerThreadBuffer;
+
+/** @brief Static description of log call site */
+struct LogSite {
+    const char *function; /** Function name */
+    const char *file;     /** Source file */
+    size_t line;          /** Source line */
+};
+
 /**
  * @class Logger
  * @brief Simpler engine logger class to maintain text log
+ *
+ * Logging is asynchronous: call site writes static site descriptor and
+ * raw argument bytes into ring buffer of the calling thread without locks.
+ * Background thread formats messages and notifies listeners, so listeners
+ * are called on logger thread. Use `Flush` to wait until all messages
+ * logged before the call are dispatched (before exit, on fatal error).
+ *
+ * When thread buffer is full, call site waits for the logger thread,
+ * so messages are never dropped.
+ *
+ * Logger thread is started by the first logged message and stopped by
+ * `Shutdown` (engine shutdown) or destructor. Thread buffers are created per
+ * logger and released after the owner thread exits and its messages are dispatched.
  */
 class Logger final {
 public:
@@ -73,8 +99,11 @@ public:
 
     using Listener = std::function<void(const Entry &)>;
     static const size_t DEFAULT_SIZE = 100;
+    /** Size in bytes of each thread ring buffer */
+    static const uint32 BUFFER_CAPACITY = 1u << 16u;
 
-    BRK_API Logger() = default;
+    BRK_API Logger();
+    BRK_API ~Logger();
 
     BRK_API void SetLevel(Level level);
     BRK_API void SetSize(size_t size = DEFAULT_SIZE);
@@ -86,27 +115,129 @@ public:
     BRK_API void LogWarning(String message, String function = "", String file = "", size_t line = 0);
     BRK_API void LogError(String message, String function = "", String file = "", size_t line = 0);
 
+    /** Wait until all messages logged before this call are dispatched to listeners */
+    BRK_API void Flush();
+
+    /** Flush logger on crash signals (segfault, abort, etc.) before default handling */
+    BRK_API void InstallCrashHandler();
+
+    /** Dispatch pending messages and stop logger thread; it is started again by next message */
+    BRK_API void Shutdown();
+
     BRK_API Level GetLevel() const;
     BRK_API bool IsActive() const;
     BRK_API bool ShouldLog(Level level) const;
 
+    /** @return Number of times call sites waited for free space in buffers */
+    BRK_API uint64 GetStallsCount() const { return mStalls.load(std::memory_order_relaxed); }
+    /** @return True if logger thread is running */
+    BRK_API bool IsRunning() const { return mRunning.load(); }
+    /** @return Number of thread buffers not yet released */
+    BRK_API uint32 GetBuffersCount() const;
+
     BRK_API static Logger &Instance();
 
 private:
+    friend class LogRecord;
+
+    struct Message {
+        uint64 time;   /** Time of log call */
+        size_t offset; /** Offset of record bytes in batch */
+        size_t size;   /** Size of record bytes */
+    };
+
+    LoggerThreadBuffer *GetThreadBuffer();
+    bool Start();
+    void Commit(const std::vector<uint8> &record, bool wakeUp);
+    void Run();
+    bool Drain();
+    void Dispatch(const uint8 *record, size_t size);
+    bool OnLoggerThread() const;
     void Shrink();
     void AddEntry(Entry &&entry);
+    void FlushFromSignal();
+
+    static void OnCrashSignal(int signal);
 
 private:
     std::queue<Entry> mEntries;
-    std::vector<Listener> mListeners;
+    std::shared_ptr<const std::vector<Listener>> mListeners;   /** Replaced on change, so listeners are called without lock */
+    std::vector<std::shared_ptr<LoggerThreadBuffer>> mBuffers; /** Buffers of threads (shared with owner threads) */
+    std::vector<uint8> mBatch;                                 /** Records read by logger thread */
+    std::vector<Message> mMessages;                            /** Messages of the batch to sort */
+    std::stringstream mFormatStream;                           /** Stream to format messages */
     std::atomic<Level> mLevel{Level::Info};
     std::atomic_bool mActive{true};
+    std::atomic_bool mRunning{false};
+    std::atomic_bool mDestroyed{false};
+    std::atomic<uint64> mStalls{0};
+    std::atomic<uint64> mFlushRequests{0};
+    std::atomic<uint64> mFlushServed{0};
+    uint32 mLoggerId = 0;
     size_t mSize = DEFAULT_SIZE;
+    std::thread mThread;
 
     mutable std::mutex mMutex;
+    std::mutex mStateMutex; /** Serializes start and stop of logger thread */
+    std::condition_variable mWakeUp;
+    std::condition_variable mFlushed;
     static Logger gLogger;
 };
 
+/**
+ * @class LogRecord
+ * @brief Encodes arguments of single log message
+ *
+ * Arguments are stored as raw bytes and formatted later on logger thread.
+ * Types without dedicated encoding are formatted at call site with
+ * their `std::ostream` operator and stored as strings.
+ */
+class LogRecord final {
+public:
+    BRK_API LogRecord(Logger &logger, Logger::Level level, const LogSite *site);
+    BRK_API ~LogRecord();
+
+    LogRecord(const LogRecord &) = delete;
+    LogRecord &operator=(const LogRecord &) = delete;
+
+    BRK_API LogRecord &operator<<(bool value);
+    BRK_API LogRecord &operator<<(char value);
+    BRK_API LogRecord &operator<<(signed char value);
+    BRK_API LogRecord &operator<<(unsigned char value);
+    BRK_API LogRecord &operator<<(short value);
+    BRK_API LogRecord &operator<<(unsigned short value);
+    BRK_API LogRecord &operator<<(int value);
+    BRK_API LogRecord &operator<<(unsigned int value);
+    BRK_API LogRecord &operator<<(long value);
+    BRK_API LogRecord &operator<<(unsigned long value);
+    BRK_API LogRecord &operator<<(long long value);
+    BRK_API LogRecord &operator<<(unsigned long long value);
+    BRK_API LogRecord &operator<<(float value);
+    BRK_API LogRecord &operator<<(double value);
+    BRK_API LogRecord &operator<<(long double value);
+    BRK_API LogRecord &operator<<(const char *value);
+    BRK_API LogRecord &operator<<(const String &value);
+    BRK_API LogRecord &operator<<(const void *value);
+    BRK_API LogRecord &operator<<(std::ostream &(*manipulator)(std::ostream &));
+
+    /** Other types are formatted at call site */
+    template<typename T>
+    LogRecord &operator<<(const T &value) {
+        std::stringstream stream;
+        stream << value;
+        return *this << stream.str();
+    }
+
+private:
+    void WriteString(const char *value, size_t length);
+
+    Logger &mLogger;
+    std::vector<uint8> *mData;  /** Thread scratch buffer or own buffer if nested */
+    std::vector<uint8> mNested; /** Buffer of record created while formatting other record */
+    bool mScratch;
+    bool mWakeUp;
+};
+
 namespace {
     /** @return Logger level to str */
     inline const char *LoggerLevelToStr(Logger::Level level) {
@@ -128,12 +259,12 @@ namespace {
         (log).Log(level, message, __FUNCTION__, __FILE__, static_cast<BRK_NS ::size_t>(__LINE__)); \
     } while (false);
 
-#define BRK_LOG_MESSAGE(log, level, message) \
-    if ((log).ShouldLog(level)) {            \
-        std::stringstream ss;                \
-        ss << message;                       \
-        BRK_LOG(log, level, ss.str());       \
-    } else {                                 \
+#define BRK_LOG_MESSAGE(log, level, message)                                                                      \
+    if ((log).ShouldLog(level)) {                                                                                 \
+        static const BRK_NS ::LogSite brkLogSite{__FUNCTION__, __FILE__, static_cast<BRK_NS ::size_t>(__LINE__)}; \
+        BRK_NS ::LogRecord brkLogRecord(log, level, &brkLogSite);                                                 \
+        brkLogRecord << message;                                                                                  \
+    } else {                                                                                                      \
     }
 
 /** Log info message to the default logger */
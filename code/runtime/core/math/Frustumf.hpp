@@ -0,0 +1,131 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_FRUSTUMF_HPP
+#define BERSERK_FRUSTUMF_HPP
+
+#include <core/Config.hpp>
+#include <core/math/TAabb.hpp>
+#include <core/math/TMatMxN.hpp>
+#include <core/math/TVecN.hpp>
+
+#include <array>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * @class Frustumf
+ * @brief View frustum defined by 6 clip planes
+ *
+ * Each plane is stored as (nx, ny, nz, d), so that point p
+ * is inside half-space if dot(n, p) + d >= 0. Planes are
+ * extracted from (projection * view) matrix with clip space
+ * z in range [-1..1] as produced by MathUtils3d.
+ */
+class Frustumf {
+public:
+    /** Frustum planes indices */
+    enum Plane {
+        Left = 0,
+        Right = 1,
+        Bottom = 2,
+        Top = 3,
+        Near = 4,
+        Far = 5,
+        PlanesCount = 6
+    };
+
+    Frustumf() = default;
+
+    /** Extract normalized frustum planes from view-projection matrix */
+    explicit Frustumf(const Mat4x4f &viewProj) {
+        auto r0 = viewProj.GetRow(0);
+        auto r1 = viewProj.GetRow(1);
+        auto r2 = viewProj.GetRow(2);
+        auto r3 = viewProj.GetRow(3);
+
+        mPlanes[Left] = r3 + r0;
+        mPlanes[Right] = r3 - r0;
+        mPlanes[Bottom] = r3 + r1;
+        mPlanes[Top] = r3 - r1;
+        mPlanes[Near] = r3 + r2;
+        mPlanes[Far] = r3 - r2;
+
+        for (auto &plane : mPlanes) {
+            float length = Vec3f(plane[0], plane[1], plane[2]).Length();
+            plane = length > 0.0f ? plane / length : plane;
+        }
+    }
+
+    /** @return True if point is inside frustum */
+    bool Contains(const Vec3f &p) const {
+        for (auto &plane : mPlanes) {
+            if (plane[0] * p[0] + plane[1] * p[1] + plane[2] * p[2] + plane[3] < 0.0f)
+                return false;
+        }
+
+        return true;
+    }
+
+    /** @return True if box is inside or intersects frustum (conservative) */
+    bool Intersects(const Aabbf &aabb) const {
+        auto c = aabb.GetCenter();
+        auto e = aabb.GetExtent();
+
+        for (auto &plane : mPlanes) {
+            float distance = plane[0] * c[0] + plane[1] * c[1] + plane[2] * c[2] + plane[3];
+            float radius = MathUtils::Abs(plane[0]) * e[0] + MathUtils::Abs(plane[1]) * e[1] + MathUtils::Abs(plane[2]) * e[2];
+
+            if (distance + radius < 0.0f)
+                return false;
+        }
+
+        return true;
+    }
+
+    /** @return Frustum plane by index */
+    const Vec4f &GetPlane(uint32 index) const { return mPlanes[index]; }
+
+    /** @return Frustum planes */
+    const std::array<Vec4f, PlanesCount> &GetPlanes() const { return mPlanes; }
+
+private:
+    std::array<Vec4f, PlanesCount> mPlanes;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_FRUSTUMF_HPP
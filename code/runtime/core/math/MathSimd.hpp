@@ -0,0 +1,473 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_MATHSIMD_HPP
+#define BERSERK_MATHSIMD_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <core/math/Simd.hpp>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * @class MathSimd
+ * @brief Vectorized kernels for hot fixed size float math types
+ *
+ * Kernels operate on raw float storage of Vec3f, Vec4f, Quatf and Mat4x4f,
+ * so math classes keep their tight layout (Vec3f is still 12 bytes and can
+ * be used in vertex data). Vec3f is loaded into padded 4-lane register with
+ * zero w component. Data is not required to be aligned: on targets supported
+ * by the engine unaligned loads of aligned data have no extra cost.
+ *
+ * Implementation is selected at compile time (see Simd.hpp), scalar code is
+ * used if no instruction set is available.
+ *
+ * @note Matrices are row-major (as TMatMxN); quaternions are (w, x, y, z) as TQuat.
+ */
+class MathSimd {
+public:
+    /** r = a * b; r may alias a or b */
+    static void MultiplyMat4(const float *a, const float *b, float *r) {
+#if defined(BRK_SIMD_AVX2)
+        __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 0));
+        __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 4));
+        __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 8));
+        __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 12));
+
+        // Two rows of result per iteration
+        for (uint32 i = 0; i < 16; i += 8) {
+            __m256 rows = _mm256_loadu_ps(a + i);
+            __m256 v = _mm256_mul_ps(_mm256_permute_ps(rows, 0x00), b0);
+            v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_permute_ps(rows, 0x55), b1));
+            v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_permute_ps(rows, 0xaa), b2));
+            v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_permute_ps(rows, 0xff), b3));
+            _mm256_storeu_ps(r + i, v);
+        }
+#elif defined(BRK_SIMD_SSE)
+        __m128 b0 = _mm_loadu_ps(b + 0);
+        __m128 b1 = _mm_loadu_ps(b + 4);
+        __m128 b2 = _mm_loadu_ps(b + 8);
+        __m128 b3 = _mm_loadu_ps(b + 12);
+
+        for (uint32 i = 0; i < 16; i += 4) {
+            __m128 row = _mm_loadu_ps(a + i);
+            __m128 v = _mm_mul_ps(Splat<0>(row), b0);
+            v = _mm_add_ps(v, _mm_mul_ps(Splat<1>(row), b1));
+            v = _mm_add_ps(v, _mm_mul_ps(Splat<2>(row), b2));
+            v = _mm_add_ps(v, _mm_mul_ps(Splat<3>(row), b3));
+            _mm_storeu_ps(r + i, v);
+        }
+#elif defined(BRK_SIMD_NEON)
+        float32x4_t b0 = vld1q_f32(b + 0);
+        float32x4_t b1 = vld1q_f32(b + 4);
+        float32x4_t b2 = vld1q_f32(b + 8);
+        float32x4_t b3 = vld1q_f32(b + 12);
+
+        for (uint32 i = 0; i < 16; i += 4) {
+            float32x4_t row = vld1q_f32(a + i);
+            float32x4_t v = vmulq_n_f32(b0, vgetq_lane_f32(row, 0));
+            v = vmlaq_n_f32(v, b1, vgetq_lane_f32(row, 1));
+            v = vmlaq_n_f32(v, b2, vgetq_lane_f32(row, 2));
+            v = vmlaq_n_f32(v, b3, vgetq_lane_f32(row, 3));
+            vst1q_f32(r + i, v);
+        }
+#else
+        float t[16];
+        for (uint32 i = 0; i < 4; i++) {
+            for (uint32 j = 0; j < 4; j++) {
+                float v = 0.0f;
+                for (uint32 f = 0; f < 4; f++)
+                    v += a[i * 4 + f] * b[f * 4 + j];
+                t[i * 4 + j] = v;
+            }
+        }
+        for (uint32 i = 0; i < 16; i++)
+            r[i] = t[i];
+#endif
+    }
+
+    /** r = transpose(m); r may alias m */
+    static void TransposeMat4(const float *m, float *r) {
+#if defined(BRK_SIMD_SSE)
+        __m128 r0 = _mm_loadu_ps(m + 0);
+        __m128 r1 = _mm_loadu_ps(m + 4);
+        __m128 r2 = _mm_loadu_ps(m + 8);
+        __m128 r3 = _mm_loadu_ps(m + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(r + 0, r0);
+        _mm_storeu_ps(r + 4, r1);
+        _mm_storeu_ps(r + 8, r2);
+        _mm_storeu_ps(r + 12, r3);
+#elif defined(BRK_SIMD_NEON)
+        // De-interleaving load gives columns of the matrix
+        float32x4x4_t c = vld4q_f32(m);
+        vst1q_f32(r + 0, c.val[0]);
+        vst1q_f32(r + 4, c.val[1]);
+        vst1q_f32(r + 8, c.val[2]);
+        vst1q_f32(r + 12, c.val[3]);
+#else
+        float t[16];
+        for (uint32 i = 0; i < 4; i++)
+            for (uint32 j = 0; j < 4; j++)
+                t[j * 4 + i] = m[i * 4 + j];
+        for (uint32 i = 0; i < 16; i++)
+            r[i] = t[i];
+#endif
+    }
+
+    /**
+     * @brief r = inverse(m); r may alias m
+     * @return False if matrix is singular (r is not modified)
+     */
+    static bool InverseMat4(const float *m, float *r) {
+#if defined(BRK_SIMD_SSE)
+        // Block-wise inversion with 2x2 sub-matrices A B / C D stored in registers
+        __m128 r0 = _mm_loadu_ps(m + 0);
+        __m128 r1 = _mm_loadu_ps(m + 4);
+        __m128 r2 = _mm_loadu_ps(m + 8);
+        __m128 r3 = _mm_loadu_ps(m + 12);
+
+        __m128 A = _mm_movelh_ps(r0, r1);
+        __m128 B = _mm_movehl_ps(r1, r0);
+        __m128 C = _mm_movelh_ps(r2, r3);
+        __m128 D = _mm_movehl_ps(r3, r2);
+
+        // (|A| |B| |C| |D|)
+        __m128 detSub = _mm_sub_ps(_mm_mul_ps(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+                                   _mm_mul_ps(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3)));
+        __m128 detA = Splat<0>(detSub);
+        __m128 detB = Splat<1>(detSub);
+        __m128 detC = Splat<2>(detSub);
+        __m128 detD = Splat<3>(detSub);
+
+        __m128 dc = Mat2AdjMul(D, C);
+        __m128 ab = Mat2AdjMul(A, B);
+
+        __m128 x = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, dc));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, ab));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, ab));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, dc));
+
+        // |M| = |A| |D| + |B| |C| - tr((A#B)(D#C))
+        __m128 tr = _mm_mul_ps(ab, Swizzle<0, 2, 1, 3>(dc));
+        tr = _mm_add_ps(tr, _mm_movehl_ps(tr, tr));
+        tr = _mm_add_ps(tr, Splat<1>(tr));
+        __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), Splat<0>(tr));
+
+        if (_mm_cvtss_f32(detM) == 0.0f)
+            return false;
+
+        __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+        x = _mm_mul_ps(x, rDetM);
+        y = _mm_mul_ps(y, rDetM);
+        z = _mm_mul_ps(z, rDetM);
+        w = _mm_mul_ps(w, rDetM);
+
+        // Apply adjugate and store
+        _mm_storeu_ps(r + 0, Shuffle<3, 1, 3, 1>(x, y));
+        _mm_storeu_ps(r + 4, Shuffle<2, 0, 2, 0>(x, y));
+        _mm_storeu_ps(r + 8, Shuffle<3, 1, 3, 1>(z, w));
+        _mm_storeu_ps(r + 12, Shuffle<2, 0, 2, 0>(z, w));
+        return true;
+#else
+        // Cofactors expansion
+        float t[16];
+
+        t[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+        t[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+        t[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+        t[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+        t[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+        t[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+        t[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+        t[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+        t[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+        t[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+        t[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+        t[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+        t[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+        t[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+        t[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+        t[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+        float det = m[0] * t[0] + m[1] * t[4] + m[2] * t[8] + m[3] * t[12];
+
+        if (det == 0.0f)
+            return false;
+
+        float invDet = 1.0f / det;
+        for (uint32 i = 0; i < 16; i++)
+            r[i] = t[i] * invDet;
+        return true;
+#endif
+    }
+
+    /** r = m * v; r may alias v */
+    static void MultiplyMat4Vec4(const float *m, const float *v, float *r) {
+#if defined(BRK_SIMD_SSE)
+        __m128 vec = _mm_loadu_ps(v);
+        __m128 r0 = _mm_mul_ps(_mm_loadu_ps(m + 0), vec);
+        __m128 r1 = _mm_mul_ps(_mm_loadu_ps(m + 4), vec);
+        __m128 r2 = _mm_mul_ps(_mm_loadu_ps(m + 8), vec);
+        __m128 r3 = _mm_mul_ps(_mm_loadu_ps(m + 12), vec);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(r, _mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3)));
+#elif defined(BRK_SIMD_NEON)
+        float32x4x4_t c = vld4q_f32(m);
+        float32x4_t vec = vld1q_f32(v);
+        float32x4_t res = vmulq_n_f32(c.val[0], vgetq_lane_f32(vec, 0));
+        res = vmlaq_n_f32(res, c.val[1], vgetq_lane_f32(vec, 1));
+        res = vmlaq_n_f32(res, c.val[2], vgetq_lane_f32(vec, 2));
+        res = vmlaq_n_f32(res, c.val[3], vgetq_lane_f32(vec, 3));
+        vst1q_f32(r, res);
+#else
+        float t[4];
+        for (uint32 i = 0; i < 4; i++)
+            t[i] = m[i * 4 + 0] * v[0] + m[i * 4 + 1] * v[1] + m[i * 4 + 2] * v[2] + m[i * 4 + 3] * v[3];
+        for (uint32 i = 0; i < 4; i++)
+            r[i] = t[i];
+#endif
+    }
+
+    /** r = a + b */
+    static void Add4(const float *a, const float *b, float *r) {
+#if defined(BRK_SIMD_SSE)
+        _mm_storeu_ps(r, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#elif defined(BRK_SIMD_NEON)
+        vst1q_f32(r, vaddq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+        for (uint32 i = 0; i < 4; i++)
+            r[i] = a[i] + b[i];
+#endif
+    }
+
+    /** r = a - b */
+    static void Sub4(const float *a, const float *b, float *r) {
+#if defined(BRK_SIMD_SSE)
+        _mm_storeu_ps(r, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#elif defined(BRK_SIMD_NEON)
+        vst1q_f32(r, vsubq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+        for (uint32 i = 0; i < 4; i++)
+            r[i] = a[i] - b[i];
+#endif
+    }
+
+    /** r = a * b (component-wise) */
+    static void Mul4(const float *a, const float *b, float *r) {
+#if defined(BRK_SIMD_SSE)
+        _mm_storeu_ps(r, _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#elif defined(BRK_SIMD_NEON)
+        vst1q_f32(r, vmulq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+        for (uint32 i = 0; i < 4; i++)
+            r[i] = a[i] * b[i];
+#endif
+    }
+
+    /** r = a * s */
+    static void Scale4(const float *a, float s, float *r) {
+#if defined(BRK_SIMD_SSE)
+        _mm_storeu_ps(r, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(s)));
+#elif defined(BRK_SIMD_NEON)
+        vst1q_f32(r, vmulq_n_f32(vld1q_f32(a), s));
+#else
+        for (uint32 i = 0; i < 4; i++)
+            r[i] = a[i] * s;
+#endif
+    }
+
+    /** @return Dot product of 4-component vectors */
+    static float Dot4(const float *a, const float *b) {
+#if defined(BRK_SIMD_SSE)
+        return HorizontalSum(_mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#elif defined(BRK_SIMD_NEON)
+        return HorizontalSum(vmulq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+#endif
+    }
+
+    /** @return Dot product of 3-component vectors */
+    static float Dot3(const float *a, const float *b) {
+#if defined(BRK_SIMD_SSE)
+        return HorizontalSum(_mm_mul_ps(Load3(a), Load3(b)));
+#elif defined(BRK_SIMD_NEON)
+        return HorizontalSum(vmulq_f32(Load3(a), Load3(b)));
+#else
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+#endif
+    }
+
+    /** r = cross(a, b) of 3-component vectors; r may alias a or b */
+    static void Cross3(const float *a, const float *b, float *r) {
+#if defined(BRK_SIMD_SSE)
+        __m128 va = Load3(a);
+        __m128 vb = Load3(b);
+        __m128 c = _mm_sub_ps(_mm_mul_ps(va, Swizzle<1, 2, 0, 3>(vb)),
+                              _mm_mul_ps(Swizzle<1, 2, 0, 3>(va), vb));
+        Store3(r, Swizzle<1, 2, 0, 3>(c));
+#else
+        float x = a[1] * b[2] - a[2] * b[1];
+        float y = a[2] * b[0] - a[0] * b[2];
+        float z = a[0] * b[1] - a[1] * b[0];
+        r[0] = x;
+        r[1] = y;
+        r[2] = z;
+#endif
+    }
+
+    /** r = a * b for quaternions stored as (w, x, y, z); r may alias a or b */
+    static void MultiplyQuat(const float *a, const float *b, float *r) {
+#if defined(BRK_SIMD_SSE)
+        __m128 vb = _mm_loadu_ps(b);
+        __m128 v = _mm_mul_ps(_mm_set1_ps(a[0]), vb);
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(a[1]), Swizzle<1, 0, 3, 2>(vb)), _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f)));
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(a[2]), Swizzle<2, 3, 0, 1>(vb)), _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f)));
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(a[3]), Swizzle<3, 2, 1, 0>(vb)), _mm_setr_ps(-1.0f, -1.0f, 1.0f, 1.0f)));
+        _mm_storeu_ps(r, v);
+#elif defined(BRK_SIMD_NEON)
+        static const float SIGN1[4] = {-1.0f, 1.0f, -1.0f, 1.0f};
+        static const float SIGN2[4] = {-1.0f, 1.0f, 1.0f, -1.0f};
+        static const float SIGN3[4] = {-1.0f, -1.0f, 1.0f, 1.0f};
+
+        float32x4_t vb = vld1q_f32(b);
+        float32x4_t b1 = vrev64q_f32(vb);
+        float32x4_t b2 = vextq_f32(vb, vb, 2);
+        float32x4_t b3 = vrev64q_f32(b2);
+
+        float32x4_t v = vmulq_n_f32(vb, a[0]);
+        v = vmlaq_f32(v, vmulq_n_f32(b1, a[1]), vld1q_f32(SIGN1));
+        v = vmlaq_f32(v, vmulq_n_f32(b2, a[2]), vld1q_f32(SIGN2));
+        v = vmlaq_f32(v, vmulq_n_f32(b3, a[3]), vld1q_f32(SIGN3));
+        vst1q_f32(r, v);
+#else
+        float w = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+        float x = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+        float y = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+        float z = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+        r[0] = w;
+        r[1] = x;
+        r[2] = y;
+        r[3] = z;
+#endif
+    }
+
+#if defined(BRK_SIMD_SSE)
+    /** @return Register with lanes (v[X], v[Y], v[Z], v[W]) */
+    template<int X, int Y, int Z, int W>
+    static __m128 Swizzle(__m128 v) {
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+    }
+
+    /** @return Register with lanes (a[X], a[Y], b[Z], b[W]) */
+    template<int X, int Y, int Z, int W>
+    static __m128 Shuffle(__m128 a, __m128 b) {
+        return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+    }
+
+    /** @return Register with all lanes set to v[I] */
+    template<int I>
+    static __m128 Splat(__m128 v) {
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I));
+    }
+
+    /** @return Sum of all lanes */
+    static float HorizontalSum(__m128 v) {
+        __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(_mm_add_ss(s, Splat<1>(s)));
+    }
+
+    /** @return Padded (x, y, z, 0) register loaded from 3 floats */
+    static __m128 Load3(const float *p) {
+        __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double *>(p)));
+        return _mm_movelh_ps(xy, _mm_load_ss(p + 2));
+    }
+
+    /** Store (x, y, z) lanes of register to 3 floats */
+    static void Store3(float *p, __m128 v) {
+        _mm_store_sd(reinterpret_cast<double *>(p), _mm_castps_pd(v));
+        _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+    }
+
+private:
+    // Operations on 2x2 row-major matrices packed into single register
+
+    /** @return a * b */
+    static __m128 Mat2Mul(__m128 a, __m128 b) {
+        return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)),
+                          _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+    }
+
+    /** @return adj(a) * b */
+    static __m128 Mat2AdjMul(__m128 a, __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b),
+                          _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+    }
+
+    /** @return a * adj(b) */
+    static __m128 Mat2MulAdj(__m128 a, __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)),
+                          _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+    }
+#elif defined(BRK_SIMD_NEON)
+    /** @return Sum of all lanes */
+    static float HorizontalSum(float32x4_t v) {
+    #if defined(__aarch64__)
+        return vaddvq_f32(v);
+    #else
+        float32x2_t s = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+        return vget_lane_f32(vpadd_f32(s, s), 0);
+    #endif
+    }
+
+    /** @return Padded (x, y, z, 0) register loaded from 3 floats */
+    static float32x4_t Load3(const float *p) {
+        return vcombine_f32(vld1_f32(p), vld1_lane_f32(p + 2, vdup_n_f32(0.0f), 0));
+    }
+
+    /** Store (x, y, z) lanes of register to 3 floats */
+    static void Store3(float *p, float32x4_t v) {
+        vst1_f32(p, vget_low_f32(v));
+        vst1q_lane_f32(p + 2, v, 2);
+    }
+#endif
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_MATHSIMD_HPP
@@ -0,0 +1,120 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/math/MathUtils3d.hpp>
+
+BRK_NS_BEGIN
+
+namespace {
+    // Columns of matrix are loaded once per batch, so transform of
+    // a vector is a sum of columns scaled by vector components
+
+    template<bool Translate>
+    void Transform3(const Mat4x4f &m, const Vec3f *in, Vec3f *out, uint32 count) {
+#if defined(BRK_SIMD_SSE)
+        __m128 c0 = _mm_loadu_ps(m.values + 0);
+        __m128 c1 = _mm_loadu_ps(m.values + 4);
+        __m128 c2 = _mm_loadu_ps(m.values + 8);
+        __m128 c3 = _mm_loadu_ps(m.values + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        for (uint32 i = 0; i < count; i++) {
+            const float *p = in[i].values;
+            __m128 v = _mm_mul_ps(c0, _mm_set1_ps(p[0]));
+            v = _mm_add_ps(v, _mm_mul_ps(c1, _mm_set1_ps(p[1])));
+            v = _mm_add_ps(v, _mm_mul_ps(c2, _mm_set1_ps(p[2])));
+            if (Translate) v = _mm_add_ps(v, c3);
+            MathSimd::Store3(out[i].values, v);
+        }
+#elif defined(BRK_SIMD_NEON)
+        float32x4x4_t c = vld4q_f32(m.values);
+
+        for (uint32 i = 0; i < count; i++) {
+            const float *p = in[i].values;
+            float32x4_t v = vmulq_n_f32(c.val[0], p[0]);
+            v = vmlaq_n_f32(v, c.val[1], p[1]);
+            v = vmlaq_n_f32(v, c.val[2], p[2]);
+            if (Translate) v = vaddq_f32(v, c.val[3]);
+            MathSimd::Store3(out[i].values, v);
+        }
+#else
+        const float *r = m.values;
+        const float w = Translate ? 1.0f : 0.0f;
+
+        for (uint32 i = 0; i < count; i++) {
+            float x = in[i].values[0];
+            float y = in[i].values[1];
+            float z = in[i].values[2];
+            out[i].values[0] = r[0] * x + r[1] * y + r[2] * z + r[3] * w;
+            out[i].values[1] = r[4] * x + r[5] * y + r[6] * z + r[7] * w;
+            out[i].values[2] = r[8] * x + r[9] * y + r[10] * z + r[11] * w;
+        }
+#endif
+    }
+}// namespace
+
+void MathUtils3d::TransformPoints(const Mat4x4f &m, const Vec3f *in, Vec3f *out, uint32 count) {
+    Transform3<true>(m, in, out, count);
+}
+
+void MathUtils3d::TransformDirections(const Mat4x4f &m, const Vec3f *in, Vec3f *out, uint32 count) {
+    Transform3<false>(m, in, out, count);
+}
+
+void MathUtils3d::TransformVectors(const Mat4x4f &m, const Vec4f *in, Vec4f *out, uint32 count) {
+#if defined(BRK_SIMD_SSE)
+    __m128 c0 = _mm_loadu_ps(m.values + 0);
+    __m128 c1 = _mm_loadu_ps(m.values + 4);
+    __m128 c2 = _mm_loadu_ps(m.values + 8);
+    __m128 c3 = _mm_loadu_ps(m.values + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    for (uint32 i = 0; i < count; i++) {
+        __m128 p = _mm_loadu_ps(in[i].values);
+        __m128 v = _mm_mul_ps(c0, MathSimd::Splat<0>(p));
+        v = _mm_add_ps(v, _mm_mul_ps(c1, MathSimd::Splat<1>(p)));
+        v = _mm_add_ps(v, _mm_mul_ps(c2, MathSimd::Splat<2>(p)));
+        v = _mm_add_ps(v, _mm_mul_ps(c3, MathSimd::Splat<3>(p)));
+        _mm_storeu_ps(out[i].values, v);
+    }
+#else
+    for (uint32 i = 0; i < count; i++)
+        MathSimd::MultiplyMat4Vec4(m.values, in[i].values, out[i].values);
+#endif
+}
+
+void MathUtils3d::Multiply(const Mat4x4f &left, const Mat4x4f *right, Mat4x4f *out, uint32 count) {
+    for (uint32 i = 0; i < count; i++)
+        MathSimd::MultiplyMat4(left.values, right[i].values, out[i].values);
+}
+
+void MathUtils3d::Multiply(const Mat4x4f *left, const Mat4x4f *right, Mat4x4f *out, uint32 count) {
+    for (uint32 i = 0; i < count; i++)
+        MathSimd::MultiplyMat4(left[i].values, right[i].values, out[i].values);
+}
+
+BRK_NS_END
@@ -28,6 +28,7 @@
 #ifndef BERSERK_UTILS3d_H
 #define BERSERK_UTILS3d_H
 
+#include <core/math/MathSimd.hpp>
 #include <core/math/TMatMxN.hpp>
 
 BRK_NS_BEGIN
@@ -53,6 +54,32 @@ public:
         return TVecN<float, 3>(m * t);
     }
 
+    /**
+     * @brief Inverse of the matrix
+     *
+     * @param m Matrix to inverse
+     * @param[out] result Inverse matrix; not modified if m is singular
+     * @return False if matrix is singular
+     */
+    static bool Inverse(const Mat4x4f &m, Mat4x4f &result) {
+        return MathSimd::InverseMat4(m.values, result.values);
+    }
+
+    /** @brief Transform array of points (w = 1) by matrix m; out may alias in */
+    BRK_API static void TransformPoints(const Mat4x4f &m, const Vec3f *in, Vec3f *out, uint32 count);
+
+    /** @brief Transform array of directions (w = 0) by matrix m; out may alias in */
+    BRK_API static void TransformDirections(const Mat4x4f &m, const Vec3f *in, Vec3f *out, uint32 count);
+
+    /** @brief Transform array of 4-component vectors by matrix m; out may alias in */
+    BRK_API static void TransformVectors(const Mat4x4f &m, const Vec4f *in, Vec4f *out, uint32 count);
+
+    /** @brief Multiply array of matrices: out[i] = left * right[i]; out may alias right */
+    BRK_API static void Multiply(const Mat4x4f &left, const Mat4x4f *right, Mat4x4f *out, uint32 count);
+
+    /** @brief Multiply arrays of matrices: out[i] = left[i] * right[i]; out may alias left or right */
+    BRK_API static void Multiply(const Mat4x4f *left, const Mat4x4f *right, Mat4x4f *out, uint32 count);
+
     /** @brief Identity matrix e */
     static Mat4x4f IdentityMatrix() {
         return {1, 0, 0, 0,
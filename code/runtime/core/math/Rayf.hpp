@@ -0,0 +1,117 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_RAYF_HPP
+#define BERSERK_RAYF_HPP
+
+#include <core/Config.hpp>
+#include <core/math/TAabb.hpp>
+#include <core/math/TVecN.hpp>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * @class Rayf
+ * @brief 3d ray with origin and direction
+ *
+ * Stores inverted direction for fast slab tests against boxes.
+ */
+class Rayf {
+public:
+    Rayf() = default;
+
+    Rayf(const Vec3f &origin, const Vec3f &direction) {
+        mOrigin = origin;
+        mDirection = direction;
+        mInvDirection = Vec3f(1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2]);
+    }
+
+    /** @return Point on the ray at distance t (in direction length units) */
+    Vec3f GetPoint(float t) const {
+        return mOrigin + mDirection * t;
+    }
+
+    /**
+     * @brief Ray-box slab test
+     *
+     * @param aabb Box to test
+     * @param maxDistance Max distance along the ray
+     * @param[out] distance Distance to the entry point (0 if origin inside)
+     *
+     * @return True if ray hits the box within [0, maxDistance]
+     */
+    bool Intersects(const Aabbf &aabb, float maxDistance, float &distance) const {
+        float tmin = 0.0f;
+        float tmax = maxDistance;
+
+        for (uint32 i = 0; i < 3; i++) {
+            float t1 = (aabb.GetMin()[i] - mOrigin[i]) * mInvDirection[i];
+            float t2 = (aabb.GetMax()[i] - mOrigin[i]) * mInvDirection[i];
+
+            tmin = MathUtils::Max(tmin, MathUtils::Min(t1, t2));
+            tmax = MathUtils::Min(tmax, MathUtils::Max(t1, t2));
+        }
+
+        distance = tmin;
+        return tmin <= tmax;
+    }
+
+    const Vec3f &GetOrigin() const { return mOrigin; }
+    const Vec3f &GetDirection() const { return mDirection; }
+    const Vec3f &GetInvDirection() const { return mInvDirection; }
+
+private:
+    Vec3f mOrigin;
+    Vec3f mDirection;
+    Vec3f mInvDirection;
+};
+
+/**
+ * @class RayHit
+ * @brief Closest hit of the ray cast into spatial index
+ */
+struct RayHit {
+    static const uint32 NO_HIT = 0xffffffff;
+
+    uint32 proxy = NO_HIT; /** Id of hit proxy */
+    float distance = 0.0f; /** Distance along ray to the hit */
+
+    bool IsHit() const { return proxy != NO_HIT; }
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_RAYF_HPP
@@ -0,0 +1,98 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/Typedefs.hpp>
+#include <core/math/Simd.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define BERSERK_CPUID
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+BRK_NS_BEGIN
+
+namespace {
+
+#if defined(BERSERK_CPUID)
+
+    void CpuId(uint32 leaf, uint32 info[4]) {
+    #if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4];
+        __cpuid(regs, static_cast<int>(leaf));
+        for (uint32 i = 0; i < 4; i++)
+            info[i] = static_cast<uint32>(regs[i]);
+    #else
+        __cpuid(leaf, info[0], info[1], info[2], info[3]);
+    #endif
+    }
+
+    uint64 GetXcr0() {
+    #if defined(_MSC_VER) && !defined(__clang__)
+        return _xgetbv(0);
+    #else
+        uint32 eax;
+        uint32 edx;
+        __asm__ volatile("xgetbv"
+                         : "=a"(eax), "=d"(edx)
+                         : "c"(0));
+        return (static_cast<uint64>(edx) << 32u) | eax;
+    #endif
+    }
+
+#endif
+
+    CpuFeatures Detect() {
+        CpuFeatures features;
+
+#if defined(BERSERK_CPUID)
+        uint32 info[4];
+        CpuId(1, info);
+
+        features.ssse3 = (info[2] & (1u << 9u)) != 0;
+        features.sse42 = (info[2] & (1u << 20u)) != 0;
+
+        // Os must save ymm registers on context switch
+        bool osxsave = (info[2] & (1u << 27u)) != 0;
+        features.avx = osxsave && (info[2] & (1u << 28u)) != 0 && (GetXcr0() & 0x6u) == 0x6u;
+        features.f16c = features.avx && (info[2] & (1u << 29u)) != 0;
+#endif
+
+        return features;
+    }
+
+}// namespace
+
+const CpuFeatures &CpuFeatures::Get() {
+    static const CpuFeatures features = Detect();
+    return features;
+}
+
+BRK_NS_END
@@ -0,0 +1,93 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_SIMD_HPP
+#define BERSERK_SIMD_HPP
+
+#include <core/Config.hpp>
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * Instruction sets available for the target, selected at compile time:
+ *  - BRK_SIMD_AVX2 - 8-wide float ops (x64, enabled by BERSERK_WITH_AVX2 build option)
+ *  - BRK_SIMD_SSE  - 4-wide float ops (x64 baseline, SSE4.1 if compiler allows)
+ *  - BRK_SIMD_NEON - 4-wide float ops (arm64 baseline)
+ *
+ * If none is defined, code must fall back to scalar implementation.
+ */
+
+#if defined(__AVX2__)
+    #define BRK_SIMD_AVX2
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define BRK_SIMD_SSE
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define BRK_SIMD_NEON
+#endif
+
+#if defined(BRK_SIMD_AVX2) || defined(BRK_SIMD_SSE)
+    #include <immintrin.h>
+#endif
+
+#if defined(BRK_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+BRK_NS_BEGIN
+
+/**
+ * @class CpuFeatures
+ * @brief Instruction set extensions detected at runtime
+ *
+ * Allows to select code compiled with target attributes for extensions
+ * above compile-time baseline (see Crc32C for example). All flags are
+ * false on targets other than x64.
+ */
+struct CpuFeatures {
+    bool ssse3 = false; /** Byte shuffles */
+    bool sse42 = false; /** Crc32 and string instructions */
+    bool avx = false;   /** Avx supported by cpu and enabled by os */
+    bool f16c = false;  /** Half float conversions */
+
+    /** @return Features of the cpu (detected once) */
+    BRK_API static const CpuFeatures &Get();
+};
+
+BRK_NS_END
+
+/**
+ * @}
+ */
+
+#endif//BERSERK_SIMD_HPP
@@ -30,6 +30,7 @@
 
 #include <core/Config.hpp>
 #include <core/math/MathUtils.hpp>
+#include <core/math/TMatMxN.hpp>
 #include <core/math/TVecN.hpp>
 
 BRK_NS_BEGIN
@@ -79,6 +80,36 @@ public:
         return min <= aabb.min && aabb.max <= max;
     }
 
+    bool Intersects(const TAabb<T> &aabb) const {
+        return min <= aabb.max && aabb.min <= max;
+    }
+
+    /** @return Box expanded by margin in each direction */
+    TAabb Expanded(T margin) const {
+        TVecN<T, 3> offset = {margin, margin, margin};
+        return TAabb(min - offset, max + offset);
+    }
+
+    /** @return Smallest box containing both boxes */
+    static TAabb Combine(const TAabb &a, const TAabb &b) {
+        return TAabb(TVecN<T, 3>::Min(a.min, b.min), TVecN<T, 3>::Max(a.max, b.max));
+    }
+
+    /** @return Box enclosing this box transformed by affine matrix m */
+    TAabb Transformed(const TMatMxN<T, 4, 4> &m) const {
+        TVecN<T, 3> c = GetCenter();
+        TVecN<T, 3> e = GetExtent();
+        TVecN<T, 3> rc, re;
+
+        for (uint32 i = 0; i < 3; i++) {
+            const T *row = m[i];
+            rc[i] = row[0] * c[0] + row[1] * c[1] + row[2] * c[2] + row[3];
+            re[i] = MathUtils::Abs(row[0]) * e[0] + MathUtils::Abs(row[1]) * e[1] + MathUtils::Abs(row[2]) * e[2];
+        }
+
+        return TAabb(rc - re, rc + re);
+    }
+
     void GetPoints(T *points) const {
         points[0] = TVecN<T, 3>(min[0], min[1], min[2]);
         points[1] = TVecN<T, 3>(min[0], min[1], max[2]);
@@ -98,6 +129,12 @@ public:
         return (max - min) * static_cast<T>(0.5);
     }
 
+    /** @return Surface area of the box (used as SAH cost) */
+    T GetArea() const {
+        TVecN<T, 3> d = max - min;
+        return static_cast<T>(2) * (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
+    }
+
     const TVecN<T, 3> &GetMin() const {
         return min;
     }
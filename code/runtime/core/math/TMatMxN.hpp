@@ -30,6 +30,7 @@
 
 #include <core/Config.hpp>
 #include <core/Typedefs.hpp>
+#include <core/math/MathSimd.hpp>
 #include <core/math/MathUtils.hpp>
 #include <core/math/TVecN.hpp>
 
@@ -381,6 +382,30 @@ using Mat2x2f = TMatMxN<float, 2, 2>;
 using Mat3x3f = TMatMxN<float, 3, 3>;
 using Mat4x4f = TMatMxN<float, 4, 4>;
 
+// Vectorized specializations for hot float types (see MathSimd)
+
+template<>
+template<>
+inline Mat4x4f Mat4x4f::operator*<4>(const Mat4x4f &other) const {
+    Mat4x4f r;
+    MathSimd::MultiplyMat4(values, other.values, r.values);
+    return r;
+}
+
+template<>
+inline Vec4f Mat4x4f::operator*(const Vec4f &v) const {
+    Vec4f r;
+    MathSimd::MultiplyMat4Vec4(values, v.values, r.values);
+    return r;
+}
+
+template<>
+inline Mat4x4f Mat4x4f::Transpose() const {
+    Mat4x4f r;
+    MathSimd::TransposeMat4(values, r.values);
+    return r;
+}
+
 /**
  * @class TDetMxN
  * @brief Matrix det evaluation helper
@@ -422,6 +422,15 @@ public:
 
 using Quatf = TQuat<float>;
 
+static_assert(sizeof(Quatf) == 4 * sizeof(float), "Quatf must be packed as (w, x, y, z)");
+
+template<>
+inline Quatf Quatf::operator*(const Quatf &other) const {
+    Quatf r;
+    MathSimd::MultiplyQuat(&scalar, &other.scalar, &r.scalar);
+    return r;
+}
+
 /**
  * @}
  */
@@ -440,10 +449,14 @@ namespace std {
 
 }// namespace std
 
+BRK_NS_BEGIN
+
 template<typename T>
-inline std::ostream &operator<<(std::ostream &ostream, const BRK_NS::TQuat<T> &quat) {
+inline std::ostream &operator<<(std::ostream &ostream, const TQuat<T> &quat) {
     ostream << "(" << quat.scalar << "," << quat.vec[0] << "," << quat.vec[1] << "," << quat.vec[2] << ")";
     return ostream;
 }
 
+BRK_NS_END
+
 #endif//BERSERK_TQUAT_H
\ No newline at end of file
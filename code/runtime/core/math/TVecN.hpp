@@ -32,6 +32,7 @@
 #include <core/Crc32.hpp>
 #include <core/Memory.hpp>
 #include <core/Typedefs.hpp>
+#include <core/math/MathSimd.hpp>
 #include <core/math/MathUtils.hpp>
 
 #include <initializer_list>
@@ -619,6 +620,53 @@ using Size2u = TVecN<uint32, 2>;
 using Rect2i = TVecN<int32, 4>;
 using Rect2u = TVecN<uint32, 4>;
 
+// Vectorized specializations for hot float types (see MathSimd)
+
+template<>
+inline Vec4f Vec4f::operator+(const Vec4f &other) const {
+    Vec4f r;
+    MathSimd::Add4(values, other.values, r.values);
+    return r;
+}
+
+template<>
+inline Vec4f Vec4f::operator-(const Vec4f &other) const {
+    Vec4f r;
+    MathSimd::Sub4(values, other.values, r.values);
+    return r;
+}
+
+template<>
+inline Vec4f Vec4f::operator*(const Vec4f &other) const {
+    Vec4f r;
+    MathSimd::Mul4(values, other.values, r.values);
+    return r;
+}
+
+template<>
+inline Vec4f Vec4f::operator*(float a) const {
+    Vec4f r;
+    MathSimd::Scale4(values, a, r.values);
+    return r;
+}
+
+template<>
+inline float Vec4f::Dot(const Vec4f &a, const Vec4f &b) {
+    return MathSimd::Dot4(a.values, b.values);
+}
+
+template<>
+inline float Vec3f::Dot(const Vec3f &a, const Vec3f &b) {
+    return MathSimd::Dot3(a.values, b.values);
+}
+
+template<>
+inline Vec3f Vec3f::Cross(const Vec3f &a, const Vec3f &b) {
+    Vec3f r;
+    MathSimd::Cross3(a.values, b.values, r.values);
+    return r;
+}
+
 /**
  * @}
  */
@@ -637,15 +685,19 @@ namespace std {
 
 }// namespace std
 
-template<typename T, BRK_NS::uint32 N>
-inline std::ostream &operator<<(std::ostream &ostream, const BRK_NS::TVecN<T, N> &vec) {
+BRK_NS_BEGIN
+
+template<typename T, uint32 N>
+inline std::ostream &operator<<(std::ostream &ostream, const TVecN<T, N> &vec) {
     ostream << "(";
     ostream << vec[0];
-    for (BRK_NS::uint32 i = 1; i < N; i++) {
+    for (uint32 i = 1; i < N; i++) {
         ostream << "," << vec[i];
     }
     ostream << ")";
     return ostream;
 }
 
+BRK_NS_END
+
 #endif//BERSERK_TVECN_H
\ No newline at end of file
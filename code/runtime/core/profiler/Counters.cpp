@@ -0,0 +1,296 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/profiler/Counters.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+BRK_NS_BEGIN
+
+namespace {
+    /** Assigns shards to threads in round-robin */
+    std::atomic<uint32> gNextShard{0};
+
+    thread_local uint32 gThreadShard = gNextShard.fetch_add(1, std::memory_order_relaxed) % Counter::SHARDS;
+
+    bool EndsWith(const String &str, const char *suffix) {
+        String s(suffix);
+        return str.size() >= s.size() && str.compare(str.size() - s.size(), s.size(), s) == 0;
+    }
+}// namespace
+
+int64 Counter::Get() const {
+    int64 value = 0;
+    for (auto &shard : mShards)
+        value += shard.value.load(std::memory_order_relaxed);
+    return value;
+}
+
+int64 Counter::Reset() {
+    int64 value = 0;
+    for (auto &shard : mShards)
+        value += shard.value.exchange(0, std::memory_order_relaxed);
+    return value;
+}
+
+uint32 Counter::GetShard() {
+    return gThreadShard;
+}
+
+void Histogram::Record(uint64 value) {
+    mBuckets[GetBucket(value)].fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(value, std::memory_order_relaxed);
+
+    auto max = mMax.load(std::memory_order_relaxed);
+    while (value > max && !mMax.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint32 Histogram::GetBucket(uint64 value) {
+    uint32 bucket = 0;
+    while (value != 0 && bucket < BUCKETS - 1) {
+        value >>= 1u;
+        bucket += 1;
+    }
+    return bucket;
+}
+
+uint64 CounterValue::GetPercentile(float p) const {
+    uint64 count = 0;
+    for (auto c : buckets)
+        count += c;
+
+    if (count == 0)
+        return 0;
+
+    auto target = static_cast<uint64>(static_cast<double>(count) * std::min(std::max(p, 0.0f), 1.0f));
+    uint64 accumulated = 0;
+
+    for (size_t i = 0; i < buckets.size(); i++) {
+        accumulated += buckets[i];
+        if (accumulated >= target && accumulated > 0)
+            return i == 0 ? 0 : std::min(max, (static_cast<uint64>(1) << i) - 1);
+    }
+
+    return max;
+}
+
+const CounterValue *CounterFrame::Find(const String &name) const {
+    auto query = std::lower_bound(values.begin(), values.end(), name, [](const CounterValue &v, const String &n) { return v.name < n; });
+    return query != values.end() && query->name == name ? &(*query) : nullptr;
+}
+
+Counter &CounterRegistry::GetCounter(const String &name) {
+    return GetOrAdd(mCounters, name, CounterType::Counter);
+}
+
+Gauge &CounterRegistry::GetGauge(const String &name) {
+    return GetOrAdd(mGauges, name, CounterType::Gauge);
+}
+
+Histogram &CounterRegistry::GetHistogram(const String &name) {
+    return GetOrAdd(mHistograms, name, CounterType::Histogram);
+}
+
+void CounterRegistry::NextFrame() {
+    CounterFrame frame;
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    frame.index = mFrameIndex;
+    frame.values.reserve(mCounters.size() + mGauges.size() + mHistograms.size());
+
+    for (auto &entry : mCounters) {
+        CounterValue value;
+        value.name = entry.name;
+        value.type = CounterType::Counter;
+        value.value = entry.object->Reset();
+        frame.values.push_back(std::move(value));
+    }
+
+    for (auto &entry : mGauges) {
+        CounterValue value;
+        value.name = entry.name;
+        value.type = CounterType::Gauge;
+        value.value = entry.object->Get();
+        frame.values.push_back(std::move(value));
+    }
+
+    for (auto &entry : mHistograms) {
+        auto &histogram = *entry.object;
+
+        CounterValue value;
+        value.name = entry.name;
+        value.type = CounterType::Histogram;
+        value.buckets.resize(static_cast<uint32>(Histogram::BUCKETS));
+
+        for (uint32 i = 0; i < Histogram::BUCKETS; i++) {
+            value.buckets[i] = histogram.mBuckets[i].exchange(0, std::memory_order_relaxed);
+            value.value += static_cast<int64>(value.buckets[i]);
+        }
+
+        value.sum = histogram.mSum.exchange(0, std::memory_order_relaxed);
+        value.max = histogram.mMax.exchange(0, std::memory_order_relaxed);
+        frame.values.push_back(std::move(value));
+    }
+
+    std::sort(frame.values.begin(), frame.values.end(), [](const CounterValue &a, const CounterValue &b) { return a.name < b.name; });
+
+    if (mCapture)
+        mCaptured.push_back(frame);
+
+    mLastFrame = std::move(frame);
+    mFrameIndex += 1;
+}
+
+CounterFrame CounterRegistry::GetLastFrame() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mLastFrame;
+}
+
+void CounterRegistry::SetCapture(bool capture) {
+    std::lock_guard<std::mutex> guard(mMutex);
+    mCapture = capture;
+}
+
+uint32 CounterRegistry::GetCapturedFramesCount() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return static_cast<uint32>(mCaptured.size());
+}
+
+void CounterRegistry::WriteCsv(std::ostream &stream) const {
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    // Counters may be registered in the middle of capture, so columns are collected from all frames
+    auto columns = GetColumns();
+
+    stream << "frame";
+    for (auto &name : columns) {
+        if (mTypes.find(name)->second == CounterType::Histogram)
+            stream << ',' << name << ".count," << name << ".p50," << name << ".p95," << name << ".max";
+        else
+            stream << ',' << name;
+    }
+    stream << '\n';
+
+    for (auto &frame : mCaptured) {
+        stream << frame.index;
+
+        for (auto &name : columns) {
+            auto value = frame.Find(name);
+            auto histogram = mTypes.find(name)->second == CounterType::Histogram;
+
+            if (histogram && value)
+                stream << ',' << value->value << ',' << value->GetPercentile(0.5f) << ',' << value->GetPercentile(0.95f) << ',' << value->max;
+            else if (histogram)
+                stream << ",0,0,0,0";
+            else
+                stream << ',' << (value ? value->value : 0);
+        }
+
+        stream << '\n';
+    }
+}
+
+void CounterRegistry::WriteJson(std::ostream &stream) const {
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    stream << "[";
+
+    for (size_t f = 0; f < mCaptured.size(); f++) {
+        auto &frame = mCaptured[f];
+        stream << (f > 0 ? ",\n" : "\n") << R"({"frame":)" << frame.index << R"(,"counters":{)";
+
+        for (size_t i = 0; i < frame.values.size(); i++) {
+            auto &value = frame.values[i];
+            stream << (i > 0 ? "," : "") << '"' << value.name << "\":";
+
+            if (value.type == CounterType::Histogram)
+                stream << R"({"count":)" << value.value << R"(,"sum":)" << value.sum
+                       << R"(,"p50":)" << value.GetPercentile(0.5f) << R"(,"p95":)" << value.GetPercentile(0.95f)
+                       << R"(,"max":)" << value.max << "}";
+            else
+                stream << value.value;
+        }
+
+        stream << "}}";
+    }
+
+    stream << "\n]\n";
+}
+
+bool CounterRegistry::SaveCapture(const String &filepath) const {
+    std::ofstream file(filepath, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open())
+        return false;
+
+    if (EndsWith(filepath, ".json"))
+        WriteJson(file);
+    else
+        WriteCsv(file);
+
+    return file.good();
+}
+
+CounterRegistry &CounterRegistry::Instance() {
+    return gRegistry;
+}
+
+template<typename T>
+T &CounterRegistry::GetOrAdd(std::vector<Entry<T>> &entries, const String &name, CounterType type) {
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    for (auto &entry : entries) {
+        if (entry.name == name)
+            return *entry.object;
+    }
+
+    mTypes.emplace(name, type);
+
+    Entry<T> entry;
+    entry.name = name;
+    entry.object.reset(new T());
+    entries.push_back(std::move(entry));
+
+    return *entries.back().object;
+}
+
+std::vector<String> CounterRegistry::GetColumns() const {
+    std::vector<String> columns;
+    columns.reserve(mTypes.size());
+
+    for (auto &entry : mTypes)
+        columns.push_back(entry.first);
+
+    std::sort(columns.begin(), columns.end());
+    return columns;
+}
+
+CounterRegistry CounterRegistry::gRegistry;
+
+BRK_NS_END
@@ -0,0 +1,285 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_COUNTERS_HPP
+#define BERSERK_COUNTERS_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <core/string/String.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/** @brief Type of engine counter */
+enum class CounterType : uint8 {
+    /** Accumulated within frame and reset on next frame */
+    Counter = 0,
+    /** Current value, kept between frames */
+    Gauge = 1,
+    /** Distribution of samples within frame */
+    Histogram = 2
+};
+
+/**
+ * @class Counter
+ * @brief Per-frame accumulated counter
+ *
+ * Value is sharded between threads, so concurrent `Add` calls
+ * from different threads do not contend on the same cache line.
+ */
+class Counter final {
+public:
+    static const uint32 SHARDS = 8;
+
+    /** Add value to the counter (thread-safe) */
+    BRK_API void Add(int64 value = 1) {
+        mShards[GetShard()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /** @return Value accumulated since last reset */
+    BRK_API int64 Get() const;
+
+    /** Reset value; @return Value before reset */
+    BRK_API int64 Reset();
+
+    /** @return Index of shard of the calling thread */
+    BRK_API static uint32 GetShard();
+
+private:
+    struct Shard {
+        std::atomic<int64> value{0};
+        char padding[64 - sizeof(std::atomic<int64>)];
+    };
+
+    std::array<Shard, SHARDS> mShards;
+};
+
+/**
+ * @class Gauge
+ * @brief Counter of current value (resident resources, cache sizes, etc.)
+ */
+class Gauge final {
+public:
+    /** Set value (thread-safe) */
+    BRK_API void Set(int64 value) { mValue.store(value, std::memory_order_relaxed); }
+    /** Add value, may be negative (thread-safe) */
+    BRK_API void Add(int64 value) { mValue.fetch_add(value, std::memory_order_relaxed); }
+    /** @return Current value */
+    BRK_API int64 Get() const { return mValue.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64> mValue{0};
+};
+
+/**
+ * @class Histogram
+ * @brief Per-frame distribution of non-negative samples
+ *
+ * Samples are counted in power of two buckets: bucket 0 counts zeros,
+ * bucket i counts values in range [2^(i-1), 2^i).
+ */
+class Histogram final {
+public:
+    static const uint32 BUCKETS = 64;
+
+    /** Record sample (thread-safe) */
+    BRK_API void Record(uint64 value);
+
+    /** @return Bucket index of value */
+    BRK_API static uint32 GetBucket(uint64 value);
+
+private:
+    friend class CounterRegistry;
+
+    std::array<std::atomic<uint64>, BUCKETS> mBuckets{};
+    std::atomic<uint64> mSum{0};
+    std::atomic<uint64> mMax{0};
+};
+
+/** @brief Value of counter in the frame snapshot */
+struct CounterValue {
+    String name;                             /** Counter name */
+    CounterType type = CounterType::Counter; /** Counter type */
+    int64 value = 0;                         /** Frame sum, gauge value or samples count of histogram */
+    uint64 sum = 0;                          /** Sum of histogram samples */
+    uint64 max = 0;                          /** Max histogram sample */
+    std::vector<uint64> buckets;             /** Histogram buckets (empty for other types) */
+
+    /** @return Upper bound of histogram percentile in range [0, 1] */
+    BRK_API uint64 GetPercentile(float p) const;
+};
+
+/** @brief Snapshot of counters of single frame */
+struct CounterFrame {
+    uint64 index = 0;                 /** Index of the frame */
+    std::vector<CounterValue> values; /** Values sorted by name */
+
+    /** @return Value with name or null if not registered */
+    BRK_API const CounterValue *Find(const String &name) const;
+};
+
+/**
+ * @class CounterRegistry
+ * @brief Registry of named engine counters
+ *
+ * Counters are registered on first use and live until registry is
+ * destroyed, so call sites can cache references (see `BRK_COUNTER_ADD`).
+ * Names use `group.name` form, for instance `rhi.draw_calls`.
+ *
+ * `NextFrame` snapshots all counters and resets per-frame ones. Snapshots
+ * can be captured for the whole run and written as CSV or JSON to check
+ * performance budgets offline.
+ */
+class CounterRegistry final {
+public:
+    BRK_API CounterRegistry() = default;
+    BRK_API ~CounterRegistry() = default;
+
+    /** @return Counter with name (registered if not exists) */
+    BRK_API Counter &GetCounter(const String &name);
+    /** @return Gauge with name (registered if not exists) */
+    BRK_API Gauge &GetGauge(const String &name);
+    /** @return Histogram with name (registered if not exists) */
+    BRK_API Histogram &GetHistogram(const String &name);
+
+    /** Snapshot counters and start new frame; must be called from game thread */
+    BRK_API void NextFrame();
+
+    /** @return Snapshot of the last completed frame */
+    BRK_API CounterFrame GetLastFrame() const;
+
+    /** Start or stop keeping snapshots of all frames */
+    BRK_API void SetCapture(bool capture);
+    /** @return Number of captured frames */
+    BRK_API uint32 GetCapturedFramesCount() const;
+
+    /** Write captured frames as csv; histograms are written as count, p50, p95 and max columns */
+    BRK_API void WriteCsv(std::ostream &stream) const;
+    /** Write captured frames as json array */
+    BRK_API void WriteJson(std::ostream &stream) const;
+    /** Save captured frames to file; format selected by extension (.csv or .json); @return True if saved */
+    BRK_API bool SaveCapture(const String &filepath) const;
+
+    /** @return Global registry instance */
+    BRK_API static CounterRegistry &Instance();
+
+private:
+    template<typename T>
+    struct Entry {
+        String name;
+        std::unique_ptr<T> object;
+    };
+
+    template<typename T>
+    T &GetOrAdd(std::vector<Entry<T>> &entries, const String &name, CounterType type);
+
+    std::vector<String> GetColumns() const;
+
+private:
+    std::vector<Entry<Counter>> mCounters;
+    std::vector<Entry<Gauge>> mGauges;
+    std::vector<Entry<Histogram>> mHistograms;
+    std::unordered_map<String, CounterType> mTypes; /** Types of registered names */
+    std::vector<CounterFrame> mCaptured;            /** Captured frames */
+    CounterFrame mLastFrame;                        /** Snapshot of the last frame */
+    uint64 mFrameIndex = 0;                         /** Index of current frame */
+    bool mCapture = false;
+
+    mutable std::mutex mMutex;
+    static CounterRegistry gRegistry;
+};
+
+#ifdef BERSERK_WITH_PROFILER
+    /** Add value to counter with name (name must be the same on each call at this site) */
+    #define BRK_COUNTER_ADD(name, value)                                                                 \
+        do {                                                                                             \
+            static BRK_NS ::Counter &brkCounter = BRK_NS ::CounterRegistry::Instance().GetCounter(name); \
+            brkCounter.Add(static_cast<BRK_NS ::int64>(value));                                          \
+        } while (false)
+    /** Add value to gauge with name */
+    #define BRK_GAUGE_ADD(name, value)                                                             \
+        do {                                                                                       \
+            static BRK_NS ::Gauge &brkGauge = BRK_NS ::CounterRegistry::Instance().GetGauge(name); \
+            brkGauge.Add(static_cast<BRK_NS ::int64>(value));                                      \
+        } while (false)
+    /** Set value of gauge with name */
+    #define BRK_GAUGE_SET(name, value)                                                             \
+        do {                                                                                       \
+            static BRK_NS ::Gauge &brkGauge = BRK_NS ::CounterRegistry::Instance().GetGauge(name); \
+            brkGauge.Set(static_cast<BRK_NS ::int64>(value));                                      \
+        } while (false)
+    /** Record sample into histogram with name */
+    #define BRK_HISTOGRAM_RECORD(name, value)                                                                  \
+        do {                                                                                                   \
+            static BRK_NS ::Histogram &brkHistogram = BRK_NS ::CounterRegistry::Instance().GetHistogram(name); \
+            brkHistogram.Record(static_cast<BRK_NS ::uint64>(value));                                          \
+        } while (false)
+    /** Snapshot counters of the frame */
+    #define BRK_COUNTERS_FRAME() BRK_NS ::CounterRegistry::Instance().NextFrame()
+#else
+    // Value is not evaluated, but variables used only for counters do not cause warnings
+    #define BRK_COUNTER_ADD(name, value) \
+        do {                             \
+            (void) sizeof(value);        \
+        } while (false)
+    #define BRK_GAUGE_ADD(name, value) \
+        do {                           \
+            (void) sizeof(value);      \
+        } while (false)
+    #define BRK_GAUGE_SET(name, value) \
+        do {                           \
+            (void) sizeof(value);      \
+        } while (false)
+    #define BRK_HISTOGRAM_RECORD(name, value) \
+        do {                                  \
+            (void) sizeof(value);             \
+        } while (false)
+    #define BRK_COUNTERS_FRAME() \
+        do {                     \
+        } while (false)
+#endif
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_COUNTERS_HPP
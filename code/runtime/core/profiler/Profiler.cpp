@@ -0,0 +1,364 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/profiler/Profiler.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <unordered_map>
+
+BRK_NS_BEGIN
+
+/**
+ * @class ProfilerThreadBuffer
+ * @brief Single-writer ring buffer of thread events
+ *
+ * Each slot is tagged with the sequence number of the stored event. Writer clears
+ * the tag before overwriting the slot and publishes new tag after, so reader
+ * detects events overwritten during copy and drops them instead of tearing.
+ */
+class ProfilerThreadBuffer final {
+public:
+    ProfilerThreadBuffer(uint32 id, String name)
+        : mEvents(static_cast<uint32>(Profiler::BUFFER_CAPACITY)), mChildTime(static_cast<uint32>(Profiler::MAX_DEPTH) + 1, 0), mName(std::move(name)), mId(id) {
+    }
+
+    /** Called only by owner thread */
+    void Write(const ProfileEvent &event) {
+        auto head = mHead.load(std::memory_order_relaxed);
+        auto &slot = mEvents[head & MASK];
+
+        slot.seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(event.name, std::memory_order_relaxed);
+        slot.begin.store(event.begin, std::memory_order_relaxed);
+        slot.end.store(event.end, std::memory_order_relaxed);
+        slot.depth.store(event.depth, std::memory_order_relaxed);
+        slot.seq.store(head + 1, std::memory_order_release);
+
+        mHead.store(head + 1, std::memory_order_release);
+    }
+
+    /** Copy events with index starting from `from` which were not overwritten; @return Index after last read event */
+    uint64 Read(uint64 from, std::vector<ProfileEvent> &events) const {
+        auto head = mHead.load(std::memory_order_acquire);
+        auto first = std::max(from, head > CAPACITY ? head - CAPACITY : 0);
+
+        for (auto i = first; i < head; i++) {
+            const auto &slot = mEvents[i & MASK];
+
+            // Writer may overwrite the oldest events while copying, such events are dropped
+            if (slot.seq.load(std::memory_order_acquire) != i + 1)
+                continue;
+
+            ProfileEvent event;
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.begin = slot.begin.load(std::memory_order_relaxed);
+            event.end = slot.end.load(std::memory_order_relaxed);
+            event.depth = slot.depth.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.seq.load(std::memory_order_relaxed) != i + 1)
+                continue;
+
+            events.push_back(event);
+        }
+
+        return head;
+    }
+
+    static const uint64 CAPACITY = Profiler::BUFFER_CAPACITY;
+    static const uint64 MASK = CAPACITY - 1;
+
+    struct Slot {
+        std::atomic<uint64> seq{0};              /** Index of stored event + 1 (0 while slot is written) */
+        std::atomic<const char *> name{nullptr}; /** Scope name */
+        std::atomic<uint64> begin{0};            /** Begin time in ns */
+        std::atomic<uint64> end{0};              /** End time in ns */
+        std::atomic<uint32> depth{0};            /** Nesting depth */
+    };
+
+    std::vector<Slot> mEvents;         /** Ring buffer of events */
+    std::vector<uint64> mChildTime;    /** Time of completed children per depth (frame summary) */
+    std::atomic<uint64> mHead{0};      /** Total number of written events */
+    uint64 mFrameCursor = 0;           /** First event not yet included in frame summary */
+    String mName;                      /** Thread name */
+    uint32 mId;                        /** Thread id in profiler */
+    uint32 mDepth = 0;                 /** Current depth of nested scopes (owner thread only) */
+    bool mGpu = false;                 /** Buffer of gpu scopes */
+};
+
+namespace {
+    /** Unique ids of profiler instances to validate cached thread buffers */
+    std::atomic<uint32> gProfilerIds{0};
+
+    struct ThreadBufferCache {
+        uint32 profilerId = 0xffffffff;
+        ProfilerThreadBuffer *buffer = nullptr;
+    };
+
+    thread_local ThreadBufferCache gThreadBuffer;
+
+    void WriteJsonString(std::ostream &stream, const char *str) {
+        static const char *HEX = "0123456789abcdef";
+
+        stream << '"';
+        for (auto c = str; c && *c; c++) {
+            auto ch = static_cast<unsigned char>(*c);
+            if (ch == '"' || ch == '\\')
+                stream << '\\' << *c;
+            else if (ch < 0x20)
+                stream << "\\u00" << HEX[ch >> 4u] << HEX[ch & 0xfu];
+            else
+                stream << *c;
+        }
+        stream << '"';
+    }
+
+    /** Accumulate events completed after `minEnd` into stats */
+    void AggregateEvents(const std::vector<ProfileEvent> &events, std::vector<uint64> &childTime, uint32 threadId, uint64 minEnd, std::vector<ProfileStat> &stats) {
+        std::unordered_map<const char *, size_t> statsIds;
+
+        // Children complete before parents, so child time is accumulated one level deeper
+        for (const auto &event : events) {
+            auto depth = std::min(event.depth, static_cast<uint32>(Profiler::MAX_DEPTH) - 1);
+            auto duration = event.end - event.begin;
+            auto self = duration - std::min(duration, childTime[depth + 1]);
+            childTime[depth + 1] = 0;
+            childTime[depth] += duration;
+
+            if (event.end < minEnd)
+                continue;
+
+            auto query = statsIds.find(event.name);
+            if (query == statsIds.end()) {
+                ProfileStat stat;
+                stat.name = event.name;
+                stat.threadId = threadId;
+                query = statsIds.emplace(event.name, stats.size()).first;
+                stats.push_back(stat);
+            }
+
+            auto durationMs = static_cast<double>(duration) / 1.0e6;
+            auto &stat = stats[query->second];
+            stat.calls += 1;
+            stat.totalMs += durationMs;
+            stat.selfMs += static_cast<double>(self) / 1.0e6;
+            stat.maxMs = std::max(stat.maxMs, durationMs);
+        }
+    }
+
+    void SortStats(std::vector<ProfileStat> &stats) {
+        std::sort(stats.begin(), stats.end(), [](const ProfileStat &a, const ProfileStat &b) { return a.totalMs > b.totalMs; });
+    }
+}// namespace
+
+Profiler::Profiler() {
+    mProfilerId = gProfilerIds.fetch_add(1);
+    mStartTime = GetTime();
+}
+
+Profiler::~Profiler() = default;
+
+void Profiler::SetEnabled(bool enabled) {
+    mEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const String &name) {
+    auto buffer = GetThreadBuffer();
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    buffer->mName = name;
+}
+
+void Profiler::NextFrame() {
+    auto now = GetTime();
+
+    std::vector<ProfileEvent> events;
+    ProfileFrame frame;
+    frame.index = mFrameIndex;
+    frame.durationMs = mFrameBegin > 0 ? static_cast<double>(now - mFrameBegin) / 1.0e6 : 0.0;
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+
+        for (auto &buffer : mBuffers) {
+            events.clear();
+            buffer->mFrameCursor = buffer->Read(buffer->mFrameCursor, events);
+
+            // Gpu scopes arrive with latency, so all submitted within frame are counted
+            if (buffer->mGpu)
+                AggregateEvents(events, buffer->mChildTime, buffer->mId, 0, frame.gpuStats);
+            else
+                AggregateEvents(events, buffer->mChildTime, buffer->mId, mFrameBegin, frame.stats);
+        }
+
+        SortStats(frame.stats);
+        SortStats(frame.gpuStats);
+
+        if (mFrameBegin > 0)
+            mLastFrame = std::move(frame);
+    }
+
+    mFrameBegin = now;
+    mFrameIndex += 1;
+}
+
+void Profiler::SubmitGpuEvents(const std::vector<ProfileEvent> &events) {
+    if (!IsEnabled() || events.empty())
+        return;
+
+    // Self time is computed in order of completion, children first
+    auto sorted = events;
+    std::sort(sorted.begin(), sorted.end(), [](const ProfileEvent &a, const ProfileEvent &b) {
+        return a.end != b.end ? a.end < b.end : a.depth > b.depth;
+    });
+
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    if (!mGpuBuffer) {
+        auto id = static_cast<uint32>(mBuffers.size());
+        mBuffers.emplace_back(new ProfilerThreadBuffer(id, "GPU"));
+        mGpuBuffer = mBuffers.back().get();
+        mGpuBuffer->mGpu = true;
+    }
+
+    // Writes are serialized by the lock, so buffer still has single writer
+    for (const auto &event : sorted)
+        mGpuBuffer->Write(event);
+}
+
+ProfileFrame Profiler::GetLastFrame() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mLastFrame;
+}
+
+std::vector<ProfileEvent> Profiler::GetEvents(uint32 threadId) const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    std::vector<ProfileEvent> events;
+
+    if (threadId < mBuffers.size())
+        mBuffers[threadId]->Read(0, events);
+
+    return events;
+}
+
+uint32 Profiler::GetThreadsCount() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return static_cast<uint32>(mBuffers.size());
+}
+
+void Profiler::WriteChromeTrace(std::ostream &stream) const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    std::vector<ProfileEvent> events;
+    bool first = true;
+
+    auto separator = [&]() {
+        stream << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for (auto &buffer : mBuffers) {
+        separator();
+        stream << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->mId << R"(,"args":{"name":)";
+        WriteJsonString(stream, buffer->mName.c_str());
+        stream << "}}";
+
+        events.clear();
+        buffer->Read(0, events);
+
+        // Complete events with timestamps in microseconds relative to profiler start
+        for (const auto &event : events) {
+            separator();
+            stream << R"({"name":)";
+            WriteJsonString(stream, event.name);
+            stream << R"(,"ph":"X","pid":1,"tid":)" << buffer->mId
+                   << R"(,"ts":)" << static_cast<double>(event.begin - std::min(event.begin, mStartTime)) / 1.0e3
+                   << R"(,"dur":)" << static_cast<double>(event.end - event.begin) / 1.0e3 << "}";
+        }
+    }
+
+    stream << "\n]}\n";
+}
+
+bool Profiler::SaveChromeTrace(const String &filepath) const {
+    std::ofstream file(filepath, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open())
+        return false;
+
+    WriteChromeTrace(file);
+    return file.good();
+}
+
+ProfilerThreadBuffer *Profiler::BeginScope() {
+    if (!mEnabled.load(std::memory_order_relaxed))
+        return nullptr;
+
+    auto buffer = GetThreadBuffer();
+    buffer->mDepth += 1;
+    return buffer;
+}
+
+void Profiler::EndScope(ProfilerThreadBuffer *buffer, const char *name, uint64 begin) {
+    assert(buffer->mDepth > 0);
+
+    ProfileEvent event;
+    event.name = name;
+    event.begin = begin;
+    event.end = GetTime();
+    event.depth = --buffer->mDepth;
+
+    buffer->Write(event);
+}
+
+Profiler &Profiler::Instance() {
+    return gProfiler;
+}
+
+ProfilerThreadBuffer *Profiler::GetThreadBuffer() {
+    auto &cache = gThreadBuffer;
+
+    if (cache.profilerId == mProfilerId)
+        return cache.buffer;
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    auto id = static_cast<uint32>(mBuffers.size());
+    mBuffers.emplace_back(new ProfilerThreadBuffer(id, "Thread " + std::to_string(id)));
+
+    cache.profilerId = mProfilerId;
+    cache.buffer = mBuffers.back().get();
+
+    return cache.buffer;
+}
+
+Profiler Profiler::gProfiler;
+
+BRK_NS_END
@@ -0,0 +1,243 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_PROFILER_HPP
+#define BERSERK_PROFILER_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <core/string/String.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+class ProfilerThreadBuffer;
+
+/** @brief Recorded profile scope */
+struct ProfileEvent {
+    const char *name = nullptr; /** Scope name (string with static storage) */
+    uint64 begin = 0;           /** Begin time in ns */
+    uint64 end = 0;             /** End time in ns */
+    uint32 depth = 0;           /** Nesting depth of the scope in its thread */
+};
+
+/** @brief Aggregated stats of scope within single frame */
+struct ProfileStat {
+    const char *name = nullptr; /** Scope name */
+    uint32 threadId = 0;        /** Profiler id of the thread */
+    uint32 calls = 0;           /** Number of scope calls */
+    double totalMs = 0.0;       /** Total time of calls */
+    double selfMs = 0.0;        /** Total time excluding nested scopes */
+    double maxMs = 0.0;         /** Longest call */
+};
+
+/** @brief Summary of profiled frame */
+struct ProfileFrame {
+    uint64 index = 0;               /** Index of the frame */
+    double durationMs = 0.0;        /** Frame duration */
+    std::vector<ProfileStat> stats; /** Scopes stats sorted by total time */
+    std::vector<ProfileStat> gpuStats; /** Gpu scopes resolved within frame, sorted by total time */
+};
+
+/**
+ * @class Profiler
+ * @brief Hierarchical cpu profiler
+ *
+ * Scopes are instrumented with `BRK_PROFILE_SCOPE`. Each thread writes
+ * completed scopes into its own fixed-size ring buffer without locks
+ * (the oldest events are overwritten), so recording costs two clock
+ * reads and a store. Buffers are read on demand to build per-frame
+ * summary (`BRK_PROFILE_FRAME` marks frames) or to export the whole
+ * recorded history in Chrome trace event format (chrome://tracing).
+ *
+ * Gpu scopes are measured by timestamp queries and become available
+ * a few frames later; they are submitted already converted to cpu time
+ * and shown as separate "GPU" thread in trace and in frame gpu stats.
+ *
+ * Instrumentation is compiled only with BERSERK_WITH_PROFILER define,
+ * otherwise macros expand to nothing. Recording can also be disabled
+ * at runtime, then each scope costs single relaxed atomic load.
+ */
+class Profiler final {
+public:
+    /** Number of events in each thread ring buffer */
+    static const uint32 BUFFER_CAPACITY = 1u << 16u;
+    /** Max nesting depth tracked for self time */
+    static const uint32 MAX_DEPTH = 64;
+
+    BRK_API Profiler();
+    BRK_API ~Profiler();
+
+    /** Enable or disable recording of new scopes */
+    BRK_API void SetEnabled(bool enabled);
+    /** @return True if recording is enabled */
+    BRK_API bool IsEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+    /** Set name of the calling thread shown in trace */
+    BRK_API void SetThreadName(const String &name);
+
+    /**
+     * @brief Mark start of new frame
+     *
+     * Builds summary of the scopes completed since previous mark.
+     * Must be called from single thread (game thread).
+     */
+    BRK_API void NextFrame();
+
+    /**
+     * @brief Submit resolved gpu scopes
+     *
+     * Events time must be converted to the profiler time (see `GetTime`).
+     * Scopes are included into gpu stats of the frame they were submitted in.
+     *
+     * @param events Gpu scopes in any order
+     */
+    BRK_API void SubmitGpuEvents(const std::vector<ProfileEvent> &events);
+
+    /** @return Summary of the last completed frame */
+    BRK_API ProfileFrame GetLastFrame() const;
+
+    /** @return Copy of the recorded events of thread with id */
+    BRK_API std::vector<ProfileEvent> GetEvents(uint32 threadId) const;
+
+    /** @return Number of threads which recorded at least one scope */
+    BRK_API uint32 GetThreadsCount() const;
+
+    /** Write recorded events in Chrome trace event json format */
+    BRK_API void WriteChromeTrace(std::ostream &stream) const;
+
+    /** Save recorded events in Chrome trace event json file; @return True if saved */
+    BRK_API bool SaveChromeTrace(const String &filepath) const;
+
+    /** @return Current time in ns */
+    static uint64 GetTime() {
+        using namespace std::chrono;
+        return static_cast<uint64>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    /** @return Buffer of the calling thread to record scope (null if recording is disabled) */
+    BRK_API ProfilerThreadBuffer *BeginScope();
+
+    /** Record scope to the buffer returned by `BeginScope` */
+    BRK_API static void EndScope(ProfilerThreadBuffer *buffer, const char *name, uint64 begin);
+
+    /** @return Global profiler instance */
+    BRK_API static Profiler &Instance();
+
+private:
+    ProfilerThreadBuffer *GetThreadBuffer();
+
+private:
+    std::vector<std::unique_ptr<ProfilerThreadBuffer>> mBuffers; /** Buffers of all threads ever profiled */
+    ProfilerThreadBuffer *mGpuBuffer = nullptr;                  /** Buffer of gpu scopes (created on first submit) */
+    ProfileFrame mLastFrame;                                     /** Summary of the last frame */
+    uint64 mFrameBegin = 0;                                      /** Time of the current frame start */
+    uint64 mFrameIndex = 0;                                      /** Index of the current frame */
+    uint64 mStartTime = 0;                                       /** Profiler creation time (trace origin) */
+    uint32 mProfilerId = 0;                                      /** Unique id to find thread buffers */
+    std::atomic_bool mEnabled{true};
+
+    mutable std::mutex mMutex;
+    static Profiler gProfiler;
+};
+
+/**
+ * @class ProfileScope
+ * @brief Records time of the enclosing scope
+ */
+class ProfileScope final {
+public:
+    explicit ProfileScope(const char *name) {
+        mBuffer = Profiler::Instance().BeginScope();
+        if (mBuffer) {
+            mName = name;
+            mBegin = Profiler::GetTime();
+        }
+    }
+
+    ~ProfileScope() {
+        if (mBuffer)
+            Profiler::EndScope(mBuffer, mName, mBegin);
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    ProfilerThreadBuffer *mBuffer;
+    const char *mName = nullptr;
+    uint64 mBegin = 0;
+};
+
+#ifdef BERSERK_WITH_PROFILER
+    #define BRK_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define BRK_PROFILE_CONCAT(a, b) BRK_PROFILE_CONCAT_IMPL(a, b)
+
+    /** Profile enclosing scope; name must have static storage (string literal) */
+    #define BRK_PROFILE_SCOPE(name) BRK_NS ::ProfileScope BRK_PROFILE_CONCAT(brkProfileScope, __LINE__)(name)
+    /** Profile enclosing function */
+    #define BRK_PROFILE_FUNCTION() BRK_PROFILE_SCOPE(__FUNCTION__)
+    /** Mark start of the new frame */
+    #define BRK_PROFILE_FRAME() BRK_NS ::Profiler::Instance().NextFrame()
+    /** Set name of the calling thread */
+    #define BRK_PROFILE_THREAD(name) BRK_NS ::Profiler::Instance().SetThreadName(name)
+    /** Declare variable with current profiler time (zero if profiler is compiled out) */
+    #define BRK_PROFILE_TIME(var) const BRK_NS ::uint64 var = BRK_NS ::Profiler::GetTime()
+#else
+    #define BRK_PROFILE_SCOPE(name) \
+        do {                        \
+        } while (false)
+    #define BRK_PROFILE_FUNCTION() \
+        do {                       \
+        } while (false)
+    #define BRK_PROFILE_FRAME() \
+        do {                    \
+        } while (false)
+    #define BRK_PROFILE_THREAD(name) \
+        do {                         \
+        } while (false)
+    #define BRK_PROFILE_TIME(var) const BRK_NS ::uint64 var = 0
+#endif
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_PROFILER_HPP
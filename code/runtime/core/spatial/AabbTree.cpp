@@ -0,0 +1,393 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/spatial/AabbTree.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+BRK_NS_BEGIN
+
+AabbTree::AabbTree(float margin) : mMargin(margin) {
+}
+
+uint32 AabbTree::CreateProxy(const Aabbf &aabb, uint32 userData) {
+    uint32 leaf = AllocateNode();
+
+    Node &node = mNodes[leaf];
+    node.aabb = aabb.Expanded(mMargin);
+    node.object = aabb;
+    node.userData = userData;
+    node.height = 0;
+
+    InsertLeaf(leaf);
+    mProxiesCount += 1;
+
+    return leaf;
+}
+
+void AabbTree::DestroyProxy(uint32 proxy) {
+    assert(proxy < mNodes.size());
+    assert(mNodes[proxy].IsLeaf());
+
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    mProxiesCount -= 1;
+}
+
+bool AabbTree::MoveProxy(uint32 proxy, const Aabbf &aabb) {
+    assert(proxy < mNodes.size());
+    assert(mNodes[proxy].IsLeaf());
+
+    Node &node = mNodes[proxy];
+    node.object = aabb;
+
+    if (node.aabb.Contains(aabb))
+        return false;
+
+    RemoveLeaf(proxy);
+    mNodes[proxy].aabb = aabb.Expanded(mMargin);
+    InsertLeaf(proxy);
+
+    return true;
+}
+
+uint32 AabbTree::GetHeight() const {
+    return mRoot != NULL_NODE ? static_cast<uint32>(mNodes[mRoot].height) : 0;
+}
+
+float AabbTree::GetAreaRatio() const {
+    if (mRoot == NULL_NODE)
+        return 0.0f;
+
+    float totalArea = 0.0f;
+    for (auto &node : mNodes) {
+        if (node.height > 0)
+            totalArea += node.aabb.GetArea();
+    }
+
+    float rootArea = mNodes[mRoot].aabb.GetArea();
+    return rootArea > 0.0f ? totalArea / rootArea : 0.0f;
+}
+
+void AabbTree::Validate() const {
+#ifdef BERSERK_DEBUG
+    if (mRoot != NULL_NODE) {
+        assert(mNodes[mRoot].parent == NULL_NODE);
+        uint32 leaves = ValidateNode(mRoot);
+        assert(leaves == mProxiesCount);
+        (void) leaves;
+    }
+#endif
+}
+
+RayHit AabbTree::RayCastClosest(const Rayf &ray, float maxDistance) const {
+    RayHit hit;
+
+    RayCast(ray, maxDistance, [&](uint32 proxy, float distance) {
+        hit.proxy = proxy;
+        hit.distance = distance;
+        return distance;
+    });
+
+    return hit;
+}
+
+void AabbTree::RayCastBatch(const std::vector<Rayf> &rays, float maxDistance, std::vector<RayHit> &hits, JobSystem *jobSystem) const {
+    auto count = static_cast<uint32>(rays.size());
+    hits.resize(count);
+
+    auto process = [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; i++)
+            hits[i] = RayCastClosest(rays[i], maxDistance);
+    };
+
+    if (jobSystem)
+        jobSystem->ParallelFor(count, 64, process);
+    else
+        process(0, count);
+}
+
+uint32 AabbTree::AllocateNode() {
+    if (mFreeList == NULL_NODE) {
+        mNodes.emplace_back();
+        return static_cast<uint32>(mNodes.size() - 1);
+    }
+
+    uint32 index = mFreeList;
+    mFreeList = mNodes[index].parent;
+    mNodes[index] = Node();
+    return index;
+}
+
+void AabbTree::FreeNode(uint32 index) {
+    Node &node = mNodes[index];
+    node.parent = mFreeList;
+    node.child1 = NULL_NODE;
+    node.child2 = NULL_NODE;
+    node.height = -1;
+    mFreeList = index;
+}
+
+void AabbTree::InsertLeaf(uint32 leaf) {
+    if (mRoot == NULL_NODE) {
+        mRoot = leaf;
+        mNodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    uint32 sibling = FindBestSibling(mNodes[leaf].aabb);
+    uint32 oldParent = mNodes[sibling].parent;
+    uint32 newParent = AllocateNode();
+
+    Node &parent = mNodes[newParent];
+    parent.parent = oldParent;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+    parent.aabb = Aabbf::Combine(mNodes[sibling].aabb, mNodes[leaf].aabb);
+    parent.height = mNodes[sibling].height + 1;
+
+    if (oldParent != NULL_NODE) {
+        Node &old = mNodes[oldParent];
+        if (old.child1 == sibling)
+            old.child1 = newParent;
+        else
+            old.child2 = newParent;
+    } else {
+        mRoot = newParent;
+    }
+
+    mNodes[sibling].parent = newParent;
+    mNodes[leaf].parent = newParent;
+
+    RefitAndRotate(oldParent);
+}
+
+void AabbTree::RemoveLeaf(uint32 leaf) {
+    if (leaf == mRoot) {
+        mRoot = NULL_NODE;
+        return;
+    }
+
+    uint32 parent = mNodes[leaf].parent;
+    uint32 grandParent = mNodes[parent].parent;
+    uint32 sibling = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+    if (grandParent != NULL_NODE) {
+        Node &grand = mNodes[grandParent];
+        if (grand.child1 == parent)
+            grand.child1 = sibling;
+        else
+            grand.child2 = sibling;
+
+        mNodes[sibling].parent = grandParent;
+        FreeNode(parent);
+        RefitAndRotate(grandParent);
+    } else {
+        mRoot = sibling;
+        mNodes[sibling].parent = NULL_NODE;
+        FreeNode(parent);
+    }
+}
+
+uint32 AabbTree::FindBestSibling(const Aabbf &aabb) {
+    // Branch and bound: cost of sibling = area of new parent + area increase of ancestors
+    float area = aabb.GetArea();
+    uint32 best = mRoot;
+    float bestCost = Aabbf::Combine(mNodes[mRoot].aabb, aabb).GetArea();
+
+    auto &stack = mSearchStack;
+    stack.clear();
+    stack.push_back({mRoot, 0.0f});
+
+    while (!stack.empty()) {
+        Candidate candidate = stack.back();
+        stack.pop_back();
+
+        const Node &node = mNodes[candidate.index];
+        float combinedArea = Aabbf::Combine(node.aabb, aabb).GetArea();
+        float cost = combinedArea + candidate.inheritedCost;
+
+        if (cost < bestCost) {
+            best = candidate.index;
+            bestCost = cost;
+        }
+
+        if (node.IsLeaf())
+            continue;
+
+        float inheritedCost = candidate.inheritedCost + combinedArea - node.aabb.GetArea();
+        float lowerBound = area + inheritedCost;
+
+        if (lowerBound < bestCost) {
+            stack.push_back({node.child1, inheritedCost});
+            stack.push_back({node.child2, inheritedCost});
+        }
+    }
+
+    return best;
+}
+
+void AabbTree::RefitAndRotate(uint32 index) {
+    while (index != NULL_NODE) {
+        UpdateNode(index);
+        Rotate(index);
+        index = mNodes[index].parent;
+    }
+}
+
+void AabbTree::Rotate(uint32 index) {
+    Node &a = mNodes[index];
+
+    if (a.height < 2)
+        return;
+
+    uint32 b = a.child1;
+    uint32 c = a.child2;
+
+    // Candidate swaps: child of one side with grand-child of other side
+    enum class Swap { None, BF, BG, CD, CE };
+
+    Swap bestSwap = Swap::None;
+    float bestDiff = 0.0f;
+
+    const Node &nodeB = mNodes[b];
+    const Node &nodeC = mNodes[c];
+
+    if (!nodeC.IsLeaf()) {
+        float areaC = nodeC.aabb.GetArea();
+        const Node &f = mNodes[nodeC.child1];
+        const Node &g = mNodes[nodeC.child2];
+
+        // Swap B with F: C = B + G
+        float diffBF = Aabbf::Combine(nodeB.aabb, g.aabb).GetArea() - areaC;
+        // Swap B with G: C = B + F
+        float diffBG = Aabbf::Combine(nodeB.aabb, f.aabb).GetArea() - areaC;
+
+        if (diffBF < bestDiff) {
+            bestSwap = Swap::BF;
+            bestDiff = diffBF;
+        }
+        if (diffBG < bestDiff) {
+            bestSwap = Swap::BG;
+            bestDiff = diffBG;
+        }
+    }
+
+    if (!nodeB.IsLeaf()) {
+        float areaB = nodeB.aabb.GetArea();
+        const Node &d = mNodes[nodeB.child1];
+        const Node &e = mNodes[nodeB.child2];
+
+        // Swap C with D: B = C + E
+        float diffCD = Aabbf::Combine(nodeC.aabb, e.aabb).GetArea() - areaB;
+        // Swap C with E: B = C + D
+        float diffCE = Aabbf::Combine(nodeC.aabb, d.aabb).GetArea() - areaB;
+
+        if (diffCD < bestDiff) {
+            bestSwap = Swap::CD;
+            bestDiff = diffCD;
+        }
+        if (diffCE < bestDiff) {
+            bestSwap = Swap::CE;
+            bestDiff = diffCE;
+        }
+    }
+
+    // Swap child of `index` with grand-child of `index` via `other` child
+    auto swap = [&](uint32 child, uint32 other, bool first) {
+        Node &otherNode = mNodes[other];
+        uint32 grandChild = first ? otherNode.child1 : otherNode.child2;
+
+        if (a.child1 == child)
+            a.child1 = grandChild;
+        else
+            a.child2 = grandChild;
+
+        if (first)
+            otherNode.child1 = child;
+        else
+            otherNode.child2 = child;
+
+        mNodes[grandChild].parent = index;
+        mNodes[child].parent = other;
+
+        UpdateNode(other);
+        UpdateNode(index);
+    };
+
+    switch (bestSwap) {
+        case Swap::BF:
+            swap(b, c, true);
+            break;
+        case Swap::BG:
+            swap(b, c, false);
+            break;
+        case Swap::CD:
+            swap(c, b, true);
+            break;
+        case Swap::CE:
+            swap(c, b, false);
+            break;
+        default:
+            break;
+    }
+}
+
+void AabbTree::UpdateNode(uint32 index) {
+    Node &node = mNodes[index];
+    const Node &child1 = mNodes[node.child1];
+    const Node &child2 = mNodes[node.child2];
+
+    node.aabb = Aabbf::Combine(child1.aabb, child2.aabb);
+    node.height = 1 + std::max(child1.height, child2.height);
+}
+
+uint32 AabbTree::ValidateNode(uint32 index) const {
+    const Node &node = mNodes[index];
+
+    if (node.IsLeaf()) {
+        assert(node.height == 0);
+        assert(node.aabb.Contains(node.object));
+        return 1;
+    }
+
+    const Node &child1 = mNodes[node.child1];
+    const Node &child2 = mNodes[node.child2];
+
+    assert(child1.parent == index);
+    assert(child2.parent == index);
+    assert(node.height == 1 + std::max(child1.height, child2.height));
+    assert(node.aabb.Contains(child1.aabb));
+    assert(node.aabb.Contains(child2.aabb));
+    (void) child1;
+    (void) child2;
+
+    return ValidateNode(node.child1) + ValidateNode(node.child2);
+}
+
+BRK_NS_END
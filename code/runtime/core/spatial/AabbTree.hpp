@@ -0,0 +1,213 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_AABBTREE_HPP
+#define BERSERK_AABBTREE_HPP
+
+#include <core/Config.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+#include <core/math/Frustumf.hpp>
+#include <core/math/Rayf.hpp>
+#include <core/math/TAabb.hpp>
+
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * @class AabbTree
+ * @brief Dynamic bounding volume hierarchy of axis-aligned boxes
+ *
+ * Incrementally updated binary tree of proxies (object bounds). Leaves
+ * store boxes enlarged by margin, so small movements do not touch the tree.
+ * New leaves are inserted next to the sibling with the smallest surface area
+ * heuristic (SAH) cost, found with branch and bound search. Ancestors are refit
+ * on the way up and rotated when the rotation reduces the tree surface area.
+ *
+ * Query functions accept callback `bool(uint32 proxy)`; return false to stop.
+ *
+ * @note Not thread-safe for modification; queries can run concurrently.
+ */
+class AabbTree final {
+public:
+    static const uint32 NULL_NODE = 0xffffffff;
+
+    /** @param margin Enlargement of leaves boxes to avoid updates on small moves */
+    BRK_API explicit AabbTree(float margin = 0.1f);
+    BRK_API ~AabbTree() = default;
+
+    /** Create proxy with bounds and user data; @return Proxy id */
+    BRK_API uint32 CreateProxy(const Aabbf &aabb, uint32 userData);
+    /** Destroy proxy by id */
+    BRK_API void DestroyProxy(uint32 proxy);
+    /** Update proxy bounds; @return True if proxy was reinserted into the tree */
+    BRK_API bool MoveProxy(uint32 proxy, const Aabbf &aabb);
+
+    /** @return Proxy user data */
+    BRK_API uint32 GetUserData(uint32 proxy) const { return mNodes[proxy].userData; }
+    /** @return Proxy exact bounds */
+    BRK_API const Aabbf &GetAabb(uint32 proxy) const { return mNodes[proxy].object; }
+    /** @return Proxy enlarged bounds stored in the tree */
+    BRK_API const Aabbf &GetFatAabb(uint32 proxy) const { return mNodes[proxy].aabb; }
+    /** @return Number of proxies */
+    BRK_API uint32 GetProxiesCount() const { return mProxiesCount; }
+    /** @return Height of the tree (0 if empty or single leaf) */
+    BRK_API uint32 GetHeight() const;
+    /** @return Sum of inner nodes areas divided by root area (lower is better) */
+    BRK_API float GetAreaRatio() const;
+    /** Check tree structure in debug builds */
+    BRK_API void Validate() const;
+
+    /** Find proxies which exact bounds overlap the box */
+    template<typename Func>
+    void QueryAabb(const Aabbf &aabb, Func &&func) const {
+        Traverse([&](const Node &node) { return node.aabb.Intersects(aabb); },
+                 [&](uint32 proxy) { return !mNodes[proxy].object.Intersects(aabb) || func(proxy); });
+    }
+
+    /** Find proxies which exact bounds intersect frustum */
+    template<typename Func>
+    void QueryFrustum(const Frustumf &frustum, Func &&func) const {
+        Traverse([&](const Node &node) { return frustum.Intersects(node.aabb); },
+                 [&](uint32 proxy) { return !frustum.Intersects(mNodes[proxy].object) || func(proxy); });
+    }
+
+    /**
+     * @brief Cast ray against proxies
+     *
+     * Callback `float(uint32 proxy, float distance)` is called for proxies which exact bounds
+     * are hit by the ray; returned value clips max distance for the rest of traversal
+     * (return 0 to stop, `distance` to find closest, current max distance to find all).
+     */
+    template<typename Func>
+    void RayCast(const Rayf &ray, float maxDistance, Func &&func) const {
+        float distance;
+        Traverse([&](const Node &node) { return ray.Intersects(node.aabb, maxDistance, distance); },
+                 [&](uint32 proxy) {
+                     if (ray.Intersects(mNodes[proxy].object, maxDistance, distance))
+                         maxDistance = func(proxy, distance);
+                     return maxDistance > 0.0f;
+                 });
+    }
+
+    /** @return Closest proxy hit by the ray */
+    BRK_API RayHit RayCastClosest(const Rayf &ray, float maxDistance) const;
+
+    /** Find closest hits of rays; runs in parallel if job system provided */
+    BRK_API void RayCastBatch(const std::vector<Rayf> &rays, float maxDistance, std::vector<RayHit> &hits, JobSystem *jobSystem = nullptr) const;
+
+private:
+    struct Node {
+        Aabbf aabb;                  /** Fat box for leaves, union of children boxes otherwise */
+        Aabbf object;                /** Exact bounds of leaf proxy */
+        uint32 parent = NULL_NODE;   /** Parent node or next free node */
+        uint32 child1 = NULL_NODE;   /** First child (null for leaves) */
+        uint32 child2 = NULL_NODE;   /** Second child (null for leaves) */
+        int32 height = -1;           /** Height in tree (0 for leaves, -1 for free nodes) */
+        uint32 userData = 0;         /** Proxy user data */
+
+        bool IsLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    struct Candidate {
+        uint32 index;        /** Node to check as sibling */
+        float inheritedCost; /** Area increase of the node ancestors */
+    };
+
+    template<typename NodeTest, typename LeafFunc>
+    void Traverse(NodeTest &&nodeTest, LeafFunc &&leafFunc) const {
+        if (mRoot == NULL_NODE)
+            return;
+
+        // Small fixed stack covers balanced trees of any practical size
+        uint32 fixedStack[128];
+        std::vector<uint32> dynamicStack;
+        uint32 *stack = fixedStack;
+        uint32 capacity = 128;
+        uint32 size = 0;
+
+        stack[size++] = mRoot;
+
+        while (size > 0) {
+            uint32 index = stack[--size];
+            const Node &node = mNodes[index];
+
+            if (!nodeTest(node))
+                continue;
+
+            if (node.IsLeaf()) {
+                if (!leafFunc(index))
+                    return;
+                continue;
+            }
+
+            if (size + 2 > capacity) {
+                if (dynamicStack.empty())
+                    dynamicStack.assign(fixedStack, fixedStack + size);
+
+                capacity *= 2;
+                dynamicStack.resize(capacity);
+                stack = dynamicStack.data();
+            }
+
+            stack[size++] = node.child1;
+            stack[size++] = node.child2;
+        }
+    }
+
+    uint32 AllocateNode();
+    void FreeNode(uint32 index);
+    void InsertLeaf(uint32 leaf);
+    void RemoveLeaf(uint32 leaf);
+    uint32 FindBestSibling(const Aabbf &aabb);
+    void RefitAndRotate(uint32 index);
+    void Rotate(uint32 index);
+    void UpdateNode(uint32 index);
+    uint32 ValidateNode(uint32 index) const;
+
+private:
+    std::vector<Node> mNodes;     /** Nodes pool */
+    uint32 mRoot = NULL_NODE;     /** Root of the tree */
+    uint32 mFreeList = NULL_NODE; /** Head of the free nodes list */
+    uint32 mProxiesCount = 0;     /** Number of leaves */
+    float mMargin;                /** Leaves enlargement */
+    std::vector<Candidate> mSearchStack; /** Reused stack of sibling search */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_AABBTREE_HPP
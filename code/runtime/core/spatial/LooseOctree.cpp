@@ -0,0 +1,239 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/spatial/LooseOctree.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+BRK_NS_BEGIN
+
+/** Marker of proxies stored in outside list */
+static const uint32 OUTSIDE_NODE = LooseOctree::NULL_INDEX - 1;
+
+static float GetMaxExtent(const Aabbf &aabb) {
+    auto e = aabb.GetExtent();
+    return std::max(e[0], std::max(e[1], e[2]));
+}
+
+LooseOctree::LooseOctree(const Aabbf &bounds, uint32 maxDepth) {
+    mMaxDepth = maxDepth < MAX_DEPTH ? maxDepth : MAX_DEPTH;
+
+    auto extent = bounds.GetExtent();
+
+    Node root;
+    root.center = bounds.GetCenter();
+    root.halfSize = std::max(extent[0], std::max(extent[1], extent[2]));
+    root.looseBounds = Aabbf(root.center, root.halfSize * 2.0f);
+    root.children.fill(static_cast<uint32>(NULL_INDEX));
+
+    mNodes.push_back(std::move(root));
+}
+
+uint32 LooseOctree::CreateProxy(const Aabbf &aabb, uint32 userData) {
+    uint32 proxy;
+
+    if (mFreeList != NULL_INDEX) {
+        proxy = mFreeList;
+        mFreeList = mProxies[proxy].node;
+    } else {
+        proxy = static_cast<uint32>(mProxies.size());
+        mProxies.emplace_back();
+    }
+
+    mProxies[proxy].aabb = aabb;
+    mProxies[proxy].userData = userData;
+
+    Attach(proxy, FindNode(aabb));
+    mProxiesCount += 1;
+
+    return proxy;
+}
+
+void LooseOctree::DestroyProxy(uint32 proxy) {
+    assert(proxy < mProxies.size());
+
+    Detach(proxy);
+    mProxies[proxy].node = mFreeList;
+    mProxies[proxy].slot = NULL_INDEX;
+    mFreeList = proxy;
+    mProxiesCount -= 1;
+}
+
+bool LooseOctree::MoveProxy(uint32 proxy, const Aabbf &aabb) {
+    assert(proxy < mProxies.size());
+
+    Proxy &p = mProxies[proxy];
+    p.aabb = aabb;
+
+    // Fast path: still fits current node and would not go deeper
+    if (p.node != OUTSIDE_NODE) {
+        const Node &node = mNodes[p.node];
+        if (FitsNode(node, aabb) && (node.depth == mMaxDepth || GetMaxExtent(aabb) > node.halfSize * 0.5f))
+            return false;
+    }
+
+    uint32 target = FindNode(aabb);
+    if (target == mProxies[proxy].node)
+        return false;
+
+    Detach(proxy);
+    Attach(proxy, target);
+    return true;
+}
+
+RayHit LooseOctree::RayCastClosest(const Rayf &ray, float maxDistance) const {
+    RayHit hit;
+
+    RayCast(ray, maxDistance, [&](uint32 proxy, float distance) {
+        hit.proxy = proxy;
+        hit.distance = distance;
+        return distance;
+    });
+
+    return hit;
+}
+
+void LooseOctree::RayCastBatch(const std::vector<Rayf> &rays, float maxDistance, std::vector<RayHit> &hits, JobSystem *jobSystem) const {
+    auto count = static_cast<uint32>(rays.size());
+    hits.resize(count);
+
+    auto process = [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; i++)
+            hits[i] = RayCastClosest(rays[i], maxDistance);
+    };
+
+    if (jobSystem)
+        jobSystem->ParallelFor(count, 64, process);
+    else
+        process(0, count);
+}
+
+uint32 LooseOctree::FindNode(const Aabbf &aabb) {
+    auto c = aabb.GetCenter();
+    auto extent = GetMaxExtent(aabb);
+
+    {
+        const Node &root = mNodes[ROOT];
+        if (!FitsNode(root, aabb))
+            return OUTSIDE_NODE;
+    }
+
+    uint32 index = ROOT;
+
+    while (mNodes[index].depth < mMaxDepth) {
+        const Node &node = mNodes[index];
+        float childHalfSize = node.halfSize * 0.5f;
+
+        if (extent > childHalfSize)
+            break;
+
+        uint32 octant = (c[0] >= node.center[0] ? 1u : 0u) |
+                        (c[1] >= node.center[1] ? 2u : 0u) |
+                        (c[2] >= node.center[2] ? 4u : 0u);
+
+        uint32 child = node.children[octant];
+
+        if (child == NULL_INDEX) {
+            Vec3f offset((octant & 1u) ? childHalfSize : -childHalfSize,
+                         (octant & 2u) ? childHalfSize : -childHalfSize,
+                         (octant & 4u) ? childHalfSize : -childHalfSize);
+
+            Node childNode;
+            childNode.center = node.center + offset;
+            childNode.halfSize = childHalfSize;
+            childNode.looseBounds = Aabbf(childNode.center, childHalfSize * 2.0f);
+            childNode.parent = index;
+            childNode.depth = node.depth + 1;
+            childNode.children.fill(static_cast<uint32>(NULL_INDEX));
+
+            child = static_cast<uint32>(mNodes.size());
+            mNodes.push_back(std::move(childNode));
+            mNodes[index].children[octant] = child;
+        }
+
+        index = child;
+    }
+
+    return index;
+}
+
+bool LooseOctree::FitsNode(const Node &node, const Aabbf &aabb) const {
+    auto c = aabb.GetCenter();
+
+    for (uint32 i = 0; i < 3; i++) {
+        if (MathUtils::Abs(c[i] - node.center[i]) > node.halfSize)
+            return false;
+    }
+
+    return GetMaxExtent(aabb) <= node.halfSize;
+}
+
+void LooseOctree::Attach(uint32 proxy, uint32 node) {
+    Proxy &p = mProxies[proxy];
+    p.node = node;
+
+    if (node == OUTSIDE_NODE) {
+        p.slot = static_cast<uint32>(mOutside.size());
+        mOutside.push_back(proxy);
+        return;
+    }
+
+    p.slot = static_cast<uint32>(mNodes[node].proxies.size());
+    mNodes[node].proxies.push_back(proxy);
+
+    while (node != NULL_INDEX) {
+        mNodes[node].subtreeProxies += 1;
+        node = mNodes[node].parent;
+    }
+}
+
+void LooseOctree::Detach(uint32 proxy) {
+    Proxy &p = mProxies[proxy];
+    uint32 node = p.node;
+
+    auto &list = node == OUTSIDE_NODE ? mOutside : mNodes[node].proxies;
+    assert(list[p.slot] == proxy);
+
+    uint32 last = list.back();
+    list[p.slot] = last;
+    mProxies[last].slot = p.slot;
+    list.pop_back();
+
+    p.node = NULL_INDEX;
+    p.slot = NULL_INDEX;
+
+    if (node == OUTSIDE_NODE)
+        return;
+
+    while (node != NULL_INDEX) {
+        mNodes[node].subtreeProxies -= 1;
+        node = mNodes[node].parent;
+    }
+}
+
+BRK_NS_END
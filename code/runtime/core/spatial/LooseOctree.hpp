@@ -0,0 +1,207 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_LOOSEOCTREE_HPP
+#define BERSERK_LOOSEOCTREE_HPP
+
+#include <core/Config.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+#include <core/math/Frustumf.hpp>
+#include <core/math/Rayf.hpp>
+#include <core/math/TAabb.hpp>
+
+#include <array>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup core
+ * @{
+ */
+
+/**
+ * @class LooseOctree
+ * @brief Loose octree spatial index of axis-aligned boxes
+ *
+ * Octree over fixed world bounds, where bounds of each node are
+ * enlarged twice (looseness 2). Proxy is stored in the deepest node
+ * which cell contains the proxy center and which half size is not
+ * less than the largest proxy extent, so insert and move are O(depth)
+ * and do not depend on other proxies. Proxies with centers outside of
+ * the world bounds are kept in separate list, tested by each query.
+ *
+ * Compared to AabbTree, updates are cheaper and predictable, while
+ * queries visit more nodes for unevenly distributed objects.
+ *
+ * Query functions accept callback `bool(uint32 proxy)`; return false to stop.
+ *
+ * @note Not thread-safe for modification; queries can run concurrently.
+ */
+class LooseOctree final {
+public:
+    static const uint32 NULL_INDEX = 0xffffffff;
+    static const uint32 MAX_DEPTH = 12;
+
+    /**
+     * @brief Create octree
+     *
+     * @param bounds World bounds of the octree (must be cube for best results)
+     * @param maxDepth Max depth of the nodes (root has depth 0)
+     */
+    BRK_API explicit LooseOctree(const Aabbf &bounds, uint32 maxDepth = 8);
+    BRK_API ~LooseOctree() = default;
+
+    /** Create proxy with bounds and user data; @return Proxy id */
+    BRK_API uint32 CreateProxy(const Aabbf &aabb, uint32 userData);
+    /** Destroy proxy by id */
+    BRK_API void DestroyProxy(uint32 proxy);
+    /** Update proxy bounds; @return True if proxy was moved to other node */
+    BRK_API bool MoveProxy(uint32 proxy, const Aabbf &aabb);
+
+    /** @return Proxy user data */
+    BRK_API uint32 GetUserData(uint32 proxy) const { return mProxies[proxy].userData; }
+    /** @return Proxy bounds */
+    BRK_API const Aabbf &GetAabb(uint32 proxy) const { return mProxies[proxy].aabb; }
+    /** @return Number of proxies */
+    BRK_API uint32 GetProxiesCount() const { return mProxiesCount; }
+    /** @return Number of allocated nodes */
+    BRK_API uint32 GetNodesCount() const { return static_cast<uint32>(mNodes.size()); }
+
+    /** Find proxies which bounds overlap the box */
+    template<typename Func>
+    void QueryAabb(const Aabbf &aabb, Func &&func) const {
+        Traverse([&](const Aabbf &bounds) { return bounds.Intersects(aabb); },
+                 [&](uint32 proxy) { return !mProxies[proxy].aabb.Intersects(aabb) || func(proxy); });
+    }
+
+    /** Find proxies which bounds intersect frustum */
+    template<typename Func>
+    void QueryFrustum(const Frustumf &frustum, Func &&func) const {
+        Traverse([&](const Aabbf &bounds) { return frustum.Intersects(bounds); },
+                 [&](uint32 proxy) { return !frustum.Intersects(mProxies[proxy].aabb) || func(proxy); });
+    }
+
+    /**
+     * @brief Cast ray against proxies
+     *
+     * Callback `float(uint32 proxy, float distance)` is called for proxies which bounds
+     * are hit by the ray; returned value clips max distance for the rest of traversal.
+     *
+     * @see AabbTree::RayCast
+     */
+    template<typename Func>
+    void RayCast(const Rayf &ray, float maxDistance, Func &&func) const {
+        float distance;
+        Traverse([&](const Aabbf &bounds) { return ray.Intersects(bounds, maxDistance, distance); },
+                 [&](uint32 proxy) {
+                     if (ray.Intersects(mProxies[proxy].aabb, maxDistance, distance))
+                         maxDistance = func(proxy, distance);
+                     return maxDistance > 0.0f;
+                 });
+    }
+
+    /** @return Closest proxy hit by the ray */
+    BRK_API RayHit RayCastClosest(const Rayf &ray, float maxDistance) const;
+
+    /** Find closest hits of rays; runs in parallel if job system provided */
+    BRK_API void RayCastBatch(const std::vector<Rayf> &rays, float maxDistance, std::vector<RayHit> &hits, JobSystem *jobSystem = nullptr) const;
+
+private:
+    struct Node {
+        Aabbf looseBounds;                 /** Cell bounds enlarged by half size */
+        Vec3f center;                      /** Cell center */
+        float halfSize = 0.0f;             /** Cell half size */
+        uint32 parent = NULL_INDEX;        /** Parent node */
+        uint32 depth = 0;                  /** Depth of the node */
+        uint32 subtreeProxies = 0;         /** Proxies in node and all its children */
+        std::array<uint32, 8> children;    /** Child nodes (null if not allocated) */
+        std::vector<uint32> proxies;       /** Proxies stored in this node */
+    };
+
+    struct Proxy {
+        Aabbf aabb;                  /** Proxy bounds */
+        uint32 userData = 0;         /** Proxy user data */
+        uint32 node = NULL_INDEX;    /** Node of the proxy (or next free proxy) */
+        uint32 slot = NULL_INDEX;    /** Index in node proxies list */
+    };
+
+    template<typename NodeTest, typename ProxyFunc>
+    void Traverse(NodeTest &&nodeTest, ProxyFunc &&proxyFunc) const {
+        for (auto proxy : mOutside) {
+            if (!proxyFunc(proxy))
+                return;
+        }
+
+        // Each level pushes at most 8 nodes
+        uint32 stack[8 * MAX_DEPTH + 1];
+        uint32 size = 0;
+
+        stack[size++] = ROOT;
+
+        while (size > 0) {
+            const Node &node = mNodes[stack[--size]];
+
+            if (node.subtreeProxies == 0 || !nodeTest(node.looseBounds))
+                continue;
+
+            for (auto proxy : node.proxies) {
+                if (!proxyFunc(proxy))
+                    return;
+            }
+
+            for (auto child : node.children) {
+                if (child != NULL_INDEX)
+                    stack[size++] = child;
+            }
+        }
+    }
+
+    static const uint32 ROOT = 0;
+
+    uint32 FindNode(const Aabbf &aabb);
+    bool FitsNode(const Node &node, const Aabbf &aabb) const;
+    void Attach(uint32 proxy, uint32 node);
+    void Detach(uint32 proxy);
+
+private:
+    std::vector<Node> mNodes;     /** Nodes, root is first */
+    std::vector<Proxy> mProxies;  /** Proxies pool */
+    std::vector<uint32> mOutside; /** Proxies outside of the world bounds */
+    uint32 mFreeList = NULL_INDEX;
+    uint32 mProxiesCount = 0;
+    uint32 mMaxDepth;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_LOOSEOCTREE_HPP
@@ -94,7 +94,7 @@ const String &StringName::GetStr() const {
 }
 
 size_t StringName::GetHash() const {
-    return mNode.IsNotNull() ? mNode->GetHash() : std::hash<String>{}(GetStr());
+    return mNode.IsNotNull() ? mNode->GetHash() : static_cast<size_t>(Hash64::Hash(GetStr()));
 }
 
 void StringName::Release() {
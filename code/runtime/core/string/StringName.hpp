@@ -29,6 +29,7 @@
 #define BERSERK_STRINGNAME_HPP
 
 #include <core/Config.hpp>
+#include <core/Hash64.hpp>
 #include <core/Typedefs.hpp>
 #include <core/string/String.hpp>
 #include <core/templates/Ref.hpp>
@@ -94,7 +95,7 @@ private:
     /** Entry of id in the cache */
     class Node : public RefCnt {
     public:
-        explicit Node(String str) : mString(std::move(str)), mHash(std::hash<String>{}(mString)) {}
+        explicit Node(String str) : mString(std::move(str)), mHash(static_cast<size_t>(Hash64::Hash(mString))) {}
         const String &GetStr() const { return mString; }
         size_t GetHash() const { return mHash; }
 
@@ -132,9 +133,13 @@ namespace std {
 
 }// namespace std
 
-inline std::ostream &operator<<(std::ostream &stream, const BRK_NS::StringName &name) {
+BRK_NS_BEGIN
+
+inline std::ostream &operator<<(std::ostream &stream, const StringName &name) {
     stream << name.GetStr();
     return stream;
 }
 
+BRK_NS_END
+
 #endif//BERSERK_STRINGNAME_HPP
\ No newline at end of file
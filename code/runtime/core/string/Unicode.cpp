@@ -25,8 +25,27 @@
 /* SOFTWARE.                                                                      */
 /**********************************************************************************/
 
+#include <core/math/Simd.hpp>
 #include <core/string/Unicode.hpp>
 
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define BERSERK_UNICODE_SSSE3
+    #include <tmmintrin.h>
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && defined(BRK_SIMD_NEON)
+    #define BERSERK_UNICODE_NEON
+#endif
+
+#if defined(BERSERK_UNICODE_SSSE3) && (defined(__GNUC__) || defined(__clang__))
+    #define BRK_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+    #define BRK_TARGET_SSSE3
+#endif
+
 BRK_NS_BEGIN
 
 static const uint32 TO_UPPER_MAP_LEN = 666;
@@ -1370,32 +1389,549 @@ static const Unicode::Char32u TO_LOWER_MAP_TABLE[TO_LOWER_MAP_LEN][2] = {
         {0xFF3A, 0xFF5A},
 };
 
-template<uint32 Size>
-static Unicode::Char32u Search(Unicode::Char32u ch, const Unicode::Char32u table[Size][2]) {
-    int32 low = 0;
-    int32 high = Size - 1;
+namespace {
+
+    /**
+     * Two-level case mapping table, built from sorted pairs table.
+     * Delta of code point is stored in the block of its high byte;
+     * blocks without mappings share zero block. Only BMP has mappings.
+     */
+    struct CaseTable {
+        static const uint32 BLOCK_SIZE = 256;
+
+        std::array<uint32, 256> offsets{};
+        std::vector<int16> deltas;
+
+        template<uint32 Size>
+        explicit CaseTable(const Unicode::Char32u (&table)[Size][2]) {
+            deltas.resize(BLOCK_SIZE, 0);
+
+            for (uint32 i = 0; i < Size; i++) {
+                auto from = table[i][0];
+                auto block = from >> 8u;
+                assert(from <= 0xffff);
+
+                if (offsets[block] == 0) {
+                    offsets[block] = static_cast<uint32>(deltas.size());
+                    deltas.resize(deltas.size() + BLOCK_SIZE, 0);
+                }
+
+                deltas[offsets[block] + (from & 0xffu)] = static_cast<int16>(static_cast<int32>(table[i][1]) - static_cast<int32>(from));
+            }
+        }
 
-    while (low <= high) {
-        int32 middle = (low + high) / 2;
+        Unicode::Char32u Map(Unicode::Char32u ch) const {
+            if (ch > 0xffff)
+                return ch;
 
-        if (ch < table[middle][0]) {
-            high = middle - 1;//search low end of array
-        } else if (table[middle][0] < ch) {
-            low = middle + 1;//search high end of array
-        } else {
-            return table[middle][1];
+            return static_cast<Unicode::Char32u>(static_cast<int32>(ch) + deltas[offsets[ch >> 8u] + (ch & 0xffu)]);
         }
+    };
+
+    const CaseTable &GetLowerTable() {
+        static const CaseTable table(TO_LOWER_MAP_TABLE);
+        return table;
     }
 
-    return ch;
-}
+    const CaseTable &GetUpperTable() {
+        static const CaseTable table(TO_UPPER_MAP_TABLE);
+        return table;
+    }
+
+    /** Decode code point of validated utf-8 sequence and advance pointer */
+    inline uint32 DecodeValid(const uint8 *&p) {
+        uint32 c = p[0];
+
+        if (c < 0x80) {
+            p += 1;
+            return c;
+        }
+        if (c < 0xe0) {
+            c = ((c & 0x1fu) << 6u) | (p[1] & 0x3fu);
+            p += 2;
+            return c;
+        }
+        if (c < 0xf0) {
+            c = ((c & 0x0fu) << 12u) | ((p[1] & 0x3fu) << 6u) | (p[2] & 0x3fu);
+            p += 3;
+            return c;
+        }
+
+        c = ((c & 0x07u) << 18u) | ((p[1] & 0x3fu) << 12u) | ((p[2] & 0x3fu) << 6u) | (p[3] & 0x3fu);
+        p += 4;
+        return c;
+    }
+
+    /** Encode valid code point as utf-8; @return Pointer past written bytes */
+    inline Unicode::Char8u *Encode(uint32 c, Unicode::Char8u *out) {
+        if (c < 0x80) {
+            out[0] = static_cast<Unicode::Char8u>(c);
+            return out + 1;
+        }
+        if (c < 0x800) {
+            out[0] = static_cast<Unicode::Char8u>(0xc0u | (c >> 6u));
+            out[1] = static_cast<Unicode::Char8u>(0x80u | (c & 0x3fu));
+            return out + 2;
+        }
+        if (c < 0x10000) {
+            out[0] = static_cast<Unicode::Char8u>(0xe0u | (c >> 12u));
+            out[1] = static_cast<Unicode::Char8u>(0x80u | ((c >> 6u) & 0x3fu));
+            out[2] = static_cast<Unicode::Char8u>(0x80u | (c & 0x3fu));
+            return out + 3;
+        }
+
+        out[0] = static_cast<Unicode::Char8u>(0xf0u | (c >> 18u));
+        out[1] = static_cast<Unicode::Char8u>(0x80u | ((c >> 12u) & 0x3fu));
+        out[2] = static_cast<Unicode::Char8u>(0x80u | ((c >> 6u) & 0x3fu));
+        out[3] = static_cast<Unicode::Char8u>(0x80u | (c & 0x3fu));
+        return out + 4;
+    }
+
+    inline bool IsAsciiWord(const uint8 *p) {
+        uint64 word;
+        std::memcpy(&word, p, sizeof(word));
+        return (word & 0x8080808080808080ull) == 0;
+    }
+
+    bool ValidateUtf8Scalar(const uint8 *p, size_t size) {
+        size_t i = 0;
+
+        while (i < size) {
+            if (i + 8 <= size && IsAsciiWord(p + i)) {
+                i += 8;
+                continue;
+            }
+
+            uint32 c = p[i];
+
+            if (c < 0x80) {
+                i += 1;
+                continue;
+            }
+
+            size_t len;
+            uint32 min;
+
+            if ((c & 0xe0u) == 0xc0u) {
+                len = 2;
+                min = 0x80;
+                c &= 0x1fu;
+            } else if ((c & 0xf0u) == 0xe0u) {
+                len = 3;
+                min = 0x800;
+                c &= 0x0fu;
+            } else if ((c & 0xf8u) == 0xf0u) {
+                len = 4;
+                min = 0x10000;
+                c &= 0x07u;
+            } else {
+                return false;
+            }
+
+            if (size - i < len)
+                return false;
+
+            for (size_t k = 1; k < len; k++) {
+                if ((p[i + k] & 0xc0u) != 0x80u)
+                    return false;
+                c = (c << 6u) | (p[i + k] & 0x3fu);
+            }
+
+            // Overlong forms, surrogates and out of range points are not allowed
+            if (c < min || c > 0x10ffff || (c >= 0xd800 && c <= 0xdfff))
+                return false;
+
+            i += len;
+        }
+
+        return true;
+    }
+
+    /*
+     * Vectorized utf-8 validation by J. Keiser and D. Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte".
+     * Each pair of adjacent bytes is classified by three 16-entry lookups (high and low nibble of the first
+     * byte and high nibble of the second byte); error is reported if all three lookups share some error bit.
+     * Third and fourth bytes of long sequences are checked separately as expected continuations.
+     */
+
+    const uint8 TOO_SHORT = 1u << 0u;      /** 11______ 0_______ or 11______ 11______ */
+    const uint8 TOO_LONG = 1u << 1u;       /** 0_______ 10______ */
+    const uint8 OVERLONG_3 = 1u << 2u;     /** 11100000 100_____ */
+    const uint8 TOO_LARGE = 1u << 3u;      /** 11110100 1001____ or 11110100 101_____ or 11110101+ 1_______ */
+    const uint8 SURROGATE = 1u << 4u;      /** 11101101 101_____ */
+    const uint8 OVERLONG_2 = 1u << 5u;     /** 1100000_ 10______ */
+    const uint8 TOO_LARGE_1000 = 1u << 6u; /** 11110101+ 1000____ */
+    const uint8 OVERLONG_4 = 1u << 6u;     /** 11110000 1000____ */
+    const uint8 TWO_CONTS = 1u << 7u;      /** 10______ 10______ */
+    const uint8 CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+    /** Indexed by high nibble of the first byte */
+    const uint8 UTF8_BYTE_1_HIGH[16] = {
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+            TOO_SHORT | OVERLONG_2,
+            TOO_SHORT,
+            TOO_SHORT | OVERLONG_3 | SURROGATE,
+            TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4};
+
+    /** Indexed by low nibble of the first byte */
+    const uint8 UTF8_BYTE_1_LOW[16] = {
+            CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+            CARRY | OVERLONG_2,
+            CARRY,
+            CARRY,
+            CARRY | TOO_LARGE,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000};
+
+    /** Indexed by high nibble of the second byte */
+    const uint8 UTF8_BYTE_2_HIGH[16] = {
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT};
+
+    /** Block is incomplete if any of last three bytes exceeds these values */
+    const uint8 UTF8_INCOMPLETE_MAX[16] = {
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xf0 - 1, 0xe0 - 1, 0xc0 - 1};
+
+#if defined(BERSERK_UNICODE_SSSE3)
+
+    BRK_TARGET_SSSE3 inline __m128i Utf8BlockErrors(__m128i input, __m128i prev) {
+        const __m128i nibble = _mm_set1_epi8(0x0f);
+
+        __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+        __m128i byte1High = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(UTF8_BYTE_1_HIGH)), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+        __m128i byte1Low = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(UTF8_BYTE_1_LOW)), _mm_and_si128(prev1, nibble));
+        __m128i byte2High = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(UTF8_BYTE_2_HIGH)), _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+        __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+        __m128i prev2 = _mm_alignr_epi8(input, prev, 14);
+        __m128i prev3 = _mm_alignr_epi8(input, prev, 13);
+        __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+        __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+        __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+
+        return _mm_xor_si128(must23, special);
+    }
+
+    BRK_TARGET_SSSE3 bool ValidateUtf8Simd(const uint8 *p, size_t size) {
+        const __m128i incompleteMax = _mm_loadu_si128(reinterpret_cast<const __m128i *>(UTF8_INCOMPLETE_MAX));
+        __m128i prev = _mm_setzero_si128();
+        __m128i error = _mm_setzero_si128();
+        size_t i = 0;
+
+        for (; i + 16 <= size; i += 16) {
+            __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+
+            // Ascii block is valid, only previous block must not end with incomplete sequence
+            if (_mm_movemask_epi8(input) == 0)
+                error = _mm_or_si128(error, _mm_subs_epu8(prev, incompleteMax));
+            else
+                error = _mm_or_si128(error, Utf8BlockErrors(input, prev));
+
+            prev = input;
+        }
+
+        // Tail is padded with zeros, so trailing incomplete sequence is reported as too short
+        uint8 tail[16] = {};
+        std::memcpy(tail, p + i, size - i);
+        error = _mm_or_si128(error, Utf8BlockErrors(_mm_loadu_si128(reinterpret_cast<const __m128i *>(tail)), prev));
+
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xffff;
+    }
+
+    bool HasSimdUtf8() {
+        return CpuFeatures::Get().ssse3;
+    }
+
+#elif defined(BERSERK_UNICODE_NEON)
+
+    inline uint8x16_t Utf8BlockErrors(uint8x16_t input, uint8x16_t prev) {
+        uint8x16_t prev1 = vextq_u8(prev, input, 15);
+        uint8x16_t byte1High = vqtbl1q_u8(vld1q_u8(UTF8_BYTE_1_HIGH), vshrq_n_u8(prev1, 4));
+        uint8x16_t byte1Low = vqtbl1q_u8(vld1q_u8(UTF8_BYTE_1_LOW), vandq_u8(prev1, vdupq_n_u8(0x0f)));
+        uint8x16_t byte2High = vqtbl1q_u8(vld1q_u8(UTF8_BYTE_2_HIGH), vshrq_n_u8(input, 4));
+        uint8x16_t special = vandq_u8(vandq_u8(byte1High, byte1Low), byte2High);
+
+        uint8x16_t prev2 = vextq_u8(prev, input, 14);
+        uint8x16_t prev3 = vextq_u8(prev, input, 13);
+        uint8x16_t third = vqsubq_u8(prev2, vdupq_n_u8(0xe0 - 0x80));
+        uint8x16_t fourth = vqsubq_u8(prev3, vdupq_n_u8(0xf0 - 0x80));
+        uint8x16_t must23 = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+
+        return veorq_u8(must23, special);
+    }
+
+    bool ValidateUtf8Simd(const uint8 *p, size_t size) {
+        const uint8x16_t incompleteMax = vld1q_u8(UTF8_INCOMPLETE_MAX);
+        uint8x16_t prev = vdupq_n_u8(0);
+        uint8x16_t error = vdupq_n_u8(0);
+        size_t i = 0;
+
+        for (; i + 16 <= size; i += 16) {
+            uint8x16_t input = vld1q_u8(p + i);
+
+            if (vmaxvq_u8(input) < 0x80)
+                error = vorrq_u8(error, vqsubq_u8(prev, incompleteMax));
+            else
+                error = vorrq_u8(error, Utf8BlockErrors(input, prev));
+
+            prev = input;
+        }
+
+        uint8 tail[16] = {};
+        std::memcpy(tail, p + i, size - i);
+        error = vorrq_u8(error, Utf8BlockErrors(vld1q_u8(tail), prev));
+
+        return vmaxvq_u8(error) == 0;
+    }
+
+    bool HasSimdUtf8() {
+        return true;
+    }
+
+#else
+
+    bool ValidateUtf8Simd(const uint8 *p, size_t size) {
+        return ValidateUtf8Scalar(p, size);
+    }
+
+    bool HasSimdUtf8() {
+        return false;
+    }
+
+#endif
+
+    using ValidateFunc = bool (*)(const uint8 *p, size_t size);
+
+    ValidateFunc GetValidateUtf8Func() {
+        static const ValidateFunc func = HasSimdUtf8() ? ValidateUtf8Simd : ValidateUtf8Scalar;
+        return func;
+    }
+
+    inline bool IsValidUtf8(const Unicode::Char8u *in, size_t size) {
+        return GetValidateUtf8Func()(reinterpret_cast<const uint8 *>(in), size);
+    }
+
+    /** @return True if next 16 bytes are ascii (must be available) */
+    inline bool IsAsciiBlock(const uint8 *p) {
+#if defined(BRK_SIMD_SSE)
+        return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) == 0;
+#elif defined(BERSERK_UNICODE_NEON)
+        return vmaxvq_u8(vld1q_u8(p)) < 0x80;
+#else
+        return IsAsciiWord(p) && IsAsciiWord(p + 8);
+#endif
+    }
+
+    /** Decode validated utf-8 into utf-16; @return Pointer past written units */
+    Unicode::Char16u *DecodeUtf8(const uint8 *p, size_t size, Unicode::Char16u *out) {
+        const uint8 *end = p + size;
+
+        while (p < end) {
+            if (end - p >= 16 && IsAsciiBlock(p)) {
+#if defined(BRK_SIMD_SSE)
+                const __m128i zero = _mm_setzero_si128();
+                __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi8(input, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpackhi_epi8(input, zero));
+#elif defined(BERSERK_UNICODE_NEON)
+                uint8x16_t input = vld1q_u8(p);
+                vst1q_u16(reinterpret_cast<uint16 *>(out), vmovl_u8(vget_low_u8(input)));
+                vst1q_u16(reinterpret_cast<uint16 *>(out + 8), vmovl_high_u8(input));
+#else
+                for (uint32 k = 0; k < 16; k++)
+                    out[k] = p[k];
+#endif
+                p += 16;
+                out += 16;
+                continue;
+            }
+
+            // Decode points up to the end of block, which is not all ascii
+            const uint8 *blockEnd = end - p >= 16 ? p + 16 : end;
+
+            while (p < blockEnd) {
+                uint32 c = DecodeValid(p);
+
+                if (c < 0x10000) {
+                    *out++ = static_cast<Unicode::Char16u>(c);
+                } else {
+                    c -= 0x10000;
+                    out[0] = static_cast<Unicode::Char16u>(0xd800u + (c >> 10u));
+                    out[1] = static_cast<Unicode::Char16u>(0xdc00u + (c & 0x3ffu));
+                    out += 2;
+                }
+            }
+        }
+
+        return out;
+    }
+
+    /** @return True if next 16 units are ascii (must be available) */
+    inline bool IsAsciiBlock(const Unicode::Char16u *p) {
+#if defined(BRK_SIMD_SSE)
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 8));
+        __m128i high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(static_cast<short>(0xff80)));
+        return _mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xffff;
+#elif defined(BERSERK_UNICODE_NEON)
+        auto u = reinterpret_cast<const uint16 *>(p);
+        return vmaxvq_u16(vorrq_u16(vld1q_u16(u), vld1q_u16(u + 8))) < 0x80;
+#else
+        uint32 bits = 0;
+        for (uint32 k = 0; k < 16; k++)
+            bits |= p[k];
+        return bits < 0x80;
+#endif
+    }
+
+    /** Encode utf-16 as utf-8; @return Pointer past written bytes or null if input has unpaired surrogate */
+    Unicode::Char8u *EncodeUtf16(const Unicode::Char16u *p, size_t size, Unicode::Char8u *out) {
+        const Unicode::Char16u *end = p + size;
+
+        while (p < end) {
+            if (end - p >= 16 && IsAsciiBlock(p)) {
+#if defined(BRK_SIMD_SSE)
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 8));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(a, b));
+#elif defined(BERSERK_UNICODE_NEON)
+                auto u = reinterpret_cast<const uint16 *>(p);
+                vst1q_u8(reinterpret_cast<uint8 *>(out), vcombine_u8(vmovn_u16(vld1q_u16(u)), vmovn_u16(vld1q_u16(u + 8))));
+#else
+                for (uint32 k = 0; k < 16; k++)
+                    out[k] = static_cast<Unicode::Char8u>(p[k]);
+#endif
+                p += 16;
+                out += 16;
+                continue;
+            }
+
+            const Unicode::Char16u *blockEnd = end - p >= 16 ? p + 16 : end;
+
+            while (p < blockEnd) {
+                uint32 c = *p++;
+
+                if (c >= 0xd800 && c <= 0xdfff) {
+                    if (c > 0xdbff || p == end || *p < 0xdc00 || *p > 0xdfff)
+                        return nullptr;
+
+                    c = 0x10000 + ((c - 0xd800u) << 10u) + (*p++ - 0xdc00u);
+                }
+
+                out = Encode(c, out);
+            }
+        }
+
+        return out;
+    }
+
+    /** Apply case mapping to utf-8 string; @return Pointer past written bytes */
+    Unicode::Char8u *MapCaseUtf8(const uint8 *p, size_t size, Unicode::Char8u *out, const CaseTable &table, bool lower) {
+        const uint8 *end = p + size;
+
+#if defined(BRK_SIMD_SSE)
+        // Bytes in range [first, first + 26) are converted by +-0x20
+        const __m128i shift = _mm_set1_epi8(static_cast<char>(0x80 - (lower ? 'A' : 'a')));
+        const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+        const __m128i flip = _mm_set1_epi8(0x20);
+#elif defined(BERSERK_UNICODE_NEON)
+        const uint8x16_t first = vdupq_n_u8(lower ? 'A' : 'a');
+        const uint8x16_t count = vdupq_n_u8(26);
+        const uint8x16_t flip = vdupq_n_u8(0x20);
+#else
+        (void) lower;
+#endif
+
+        while (p < end) {
+            if (end - p >= 16 && IsAsciiBlock(p)) {
+#if defined(BRK_SIMD_SSE)
+                __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                __m128i letters = _mm_cmplt_epi8(_mm_add_epi8(input, shift), limit);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_xor_si128(input, _mm_and_si128(letters, flip)));
+#elif defined(BERSERK_UNICODE_NEON)
+                uint8x16_t input = vld1q_u8(p);
+                uint8x16_t letters = vcltq_u8(vsubq_u8(input, first), count);
+                vst1q_u8(reinterpret_cast<uint8 *>(out), veorq_u8(input, vandq_u8(letters, flip)));
+#else
+                for (uint32 k = 0; k < 16; k++)
+                    out[k] = static_cast<Unicode::Char8u>(table.Map(p[k]));
+#endif
+                p += 16;
+                out += 16;
+                continue;
+            }
+
+            const uint8 *blockEnd = end - p >= 16 ? p + 16 : end;
+
+            while (p < blockEnd)
+                out = Encode(table.Map(DecodeValid(p)), out);
+        }
+
+        return out;
+    }
+
+}// namespace
 
 Unicode::Char32u Unicode::ToLower(Unicode::Char32u ch) {
-    return Search<TO_LOWER_MAP_LEN>(ch, TO_LOWER_MAP_TABLE);
+    return GetLowerTable().Map(ch);
 }
 
 Unicode::Char32u Unicode::ToUpper(Unicode::Char32u ch) {
-    return Search<TO_UPPER_MAP_LEN>(ch, TO_UPPER_MAP_TABLE);
+    return GetUpperTable().Map(ch);
+}
+
+void Unicode::ToLower(const Char32u *in, Char32u *out, size_t count) {
+    auto &table = GetLowerTable();
+    for (size_t i = 0; i < count; i++)
+        out[i] = table.Map(in[i]);
+}
+
+void Unicode::ToUpper(const Char32u *in, Char32u *out, size_t count) {
+    auto &table = GetUpperTable();
+    for (size_t i = 0; i < count; i++)
+        out[i] = table.Map(in[i]);
+}
+
+bool Unicode::ToLower(const String8u &in, String8u &out) {
+    if (!IsValidUtf8(in.data(), in.size()))
+        return false;
+
+    // Mapping of 2-bytes point may take 3 bytes
+    auto offset = out.size();
+    out.resize(offset + in.size() + in.size() / 2);
+    auto last = MapCaseUtf8(reinterpret_cast<const uint8 *>(in.data()), in.size(), &out[0] + offset, GetLowerTable(), true);
+    out.resize(static_cast<size_t>(last - &out[0]));
+
+    return true;
+}
+
+bool Unicode::ToUpper(const String8u &in, String8u &out) {
+    if (!IsValidUtf8(in.data(), in.size()))
+        return false;
+
+    auto offset = out.size();
+    out.resize(offset + in.size() + in.size() / 2);
+    auto last = MapCaseUtf8(reinterpret_cast<const uint8 *>(in.data()), in.size(), &out[0] + offset, GetUpperTable(), false);
+    out.resize(static_cast<size_t>(last - &out[0]));
+
+    return true;
 }
 
 bool Unicode::Utf32toUtf8(Unicode::Char32u ch, Unicode::Char8u *out, uint32 &len) {
@@ -1484,66 +2020,87 @@ bool Unicode::Utf16ToUtf32(const Unicode::Char16u *in, uint32 &len, Unicode::Cha
             out += (in[1] - 0xdc00);
             out += 0x10000;
             len = 2;
-        } else {
-            len = 0;
-            out = 0;
             return true;
         }
-    } else {
+    } else if (in[0] < 0xdc00 || 0xdfff < in[0]) {
         len = 1;
         out = in[0];
         return true;
     }
 
+    // Unpaired surrogate
+    len = 0;
+    out = 0;
     return false;
 }
 
-bool Unicode::ConvertUtf8ToUtf16(const String8u &in, String16u &out) {
-    const auto *buffer = in.c_str();
-    auto len = static_cast<uint32>(in.length());
+bool Unicode::ValidateUtf8(const Char8u *in, size_t size) {
+    return IsValidUtf8(in, size);
+}
 
-    while (len > 0) {
-        uint32 parsed = len;
-        uint32 encodedLen;
-        Unicode::Char32u point;
-        Unicode::Char16u encoded[2];
+bool Unicode::ValidateUtf16(const Char16u *in, size_t size) {
+    const Char16u *end = in + size;
 
-        if (!Unicode::Utf8toUtf32(buffer, parsed, point))
-            return false;
+    while (in < end) {
+        if (end - in >= 8) {
+#if defined(BRK_SIMD_SSE)
+            __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+            __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xf800))), _mm_set1_epi16(static_cast<short>(0xd800)));
+            if (_mm_movemask_epi8(surrogates) == 0) {
+                in += 8;
+                continue;
+            }
+#elif defined(BERSERK_UNICODE_NEON)
+            uint16x8_t units = vld1q_u16(reinterpret_cast<const uint16 *>(in));
+            if (vmaxvq_u16(vceqq_u16(vandq_u16(units, vdupq_n_u16(0xf800)), vdupq_n_u16(0xd800))) == 0) {
+                in += 8;
+                continue;
+            }
+#endif
+        }
 
-        if (!Unicode::Utf32ToUtf16(point, encoded, encodedLen))
-            return false;
+        uint32 c = *in++;
 
-        out.append(encoded, encoded + encodedLen);
-        len -= parsed;
-        buffer += parsed;
+        if (c >= 0xd800 && c <= 0xdfff) {
+            if (c > 0xdbff || in == end || *in < 0xdc00 || *in > 0xdfff)
+                return false;
+            in += 1;
+        }
     }
 
     return true;
 }
 
-bool Unicode::ConvertUtf16ToUtf8(const String16u &in, String8u &out) {
-    const auto *buffer = in.c_str();
-    auto len = static_cast<uint32>(in.length());
+bool Unicode::ConvertUtf8ToUtf16(const String8u &in, String16u &out) {
+    if (!IsValidUtf8(in.data(), in.size()))
+        return false;
 
-    while (len > 0) {
-        uint32 parsed = len;
-        uint32 encodedLen;
-        Unicode::Char8u encoded[5];
-        Unicode::Char32u codepoint;
+    // Each utf-8 byte gives at most one utf-16 unit
+    auto offset = out.size();
+    out.resize(offset + in.size());
+    auto last = DecodeUtf8(reinterpret_cast<const uint8 *>(in.data()), in.size(), &out[0] + offset);
+    out.resize(static_cast<size_t>(last - &out[0]));
 
-        if (!Unicode::Utf16ToUtf32(buffer, parsed, codepoint))
-            return false;
+    return true;
+}
 
-        if (!Unicode::Utf32toUtf8(codepoint, encoded, encodedLen))
-            return false;
+bool Unicode::ConvertUtf16ToUtf8(const String16u &in, String8u &out) {
+    // Each utf-16 unit gives at most three utf-8 bytes
+    auto offset = out.size();
+    out.resize(offset + in.size() * 3);
+    auto last = EncodeUtf16(in.data(), in.size(), &out[0] + offset);
 
-        out.append(encoded, encoded + encodedLen);
-        len -= parsed;
-        buffer += parsed;
+    if (!last) {
+        out.resize(offset);
+        return false;
     }
 
+    out.resize(static_cast<size_t>(last - &out[0]));
     return true;
 }
 
+bool Unicode::IsSimdAccelerated() {
+    return GetValidateUtf8Func() != ValidateUtf8Scalar;
+}
+
 BRK_NS_END
@@ -43,6 +43,11 @@ BRK_NS_BEGIN
 /**
  * @class Unicode
  * @brief Unicode encoding utils
+ *
+ * String conversion and validation use vectorized ascii paths and
+ * vectorized utf-8 validation (SSSE3 selected at runtime on x64, NEON
+ * on arm64), falling back to scalar code otherwise. Case mapping uses
+ * two-level lookup tables.
  */
 class BRK_API Unicode {
 public:
@@ -53,9 +58,35 @@ public:
     /** Convert code point to lower case */
     static Char32u ToLower(Char32u ch);
 
-    /** Convert code point to lower case */
+    /** Convert code point to upper case */
     static Char32u ToUpper(Char32u ch);
 
+    /** Convert count code points to lower case (in and out may be the same) */
+    static void ToLower(const Char32u *in, Char32u *out, size_t count);
+
+    /** Convert count code points to upper case (in and out may be the same) */
+    static void ToUpper(const Char32u *in, Char32u *out, size_t count);
+
+    /**
+     * Convert utf-8 encoded string to lower case
+     *
+     * @param in String to convert
+     * @param[out] out String to append result
+     *
+     * @return True if successfully converted; false if input is not valid utf-8
+     */
+    static bool ToLower(const String8u &in, String8u &out);
+
+    /**
+     * Convert utf-8 encoded string to upper case
+     *
+     * @param in String to convert
+     * @param[out] out String to append result
+     *
+     * @return True if successfully converted; false if input is not valid utf-8
+     */
+    static bool ToUpper(const String8u &in, String8u &out);
+
     /** Convert utf-32 point to utf-8 */
     static bool Utf32toUtf8(Char32u ch, Char8u *out, uint32 &len);
 
@@ -68,13 +99,22 @@ public:
     /** Convert utf-16 point to utf-32 point */
     static bool Utf16ToUtf32(const Char16u *in, uint32 &len, Char32u &out);
 
+    /**
+     * Check that buffer is valid utf-8: no overlong forms, surrogates,
+     * points above U+10FFFF or truncated sequences
+     */
+    static bool ValidateUtf8(const Char8u *in, size_t size);
+
+    /** Check that buffer is valid utf-16: no unpaired surrogates */
+    static bool ValidateUtf16(const Char16u *in, size_t size);
+
     /**
      * Convert utf-8 encoded string to utf-16 encoded string
      *
      * @param in String to convert
-     * @param[out] out String to store result
+     * @param[out] out String to append result (unchanged on failure)
      *
-     * @return True if successfully converted
+     * @return True if successfully converted; false if input is not valid utf-8
      */
     static bool ConvertUtf8ToUtf16(const String8u &in, String16u &out);
 
@@ -82,11 +122,14 @@ public:
     * Convert utf-16 encoded string to utf-8 encoded string
     *
     * @param in String to convert
-    * @param[out] out String to store result
+    * @param[out] out String to append result (unchanged on failure)
     *
-    * @return True if successfully converted
+    * @return True if successfully converted; false if input is not valid utf-16
     */
     static bool ConvertUtf16ToUtf8(const String16u &in, String8u &out);
+
+    /** @return True if utf-8 validation uses vector instructions */
+    static bool IsSimdAccelerated();
 };
 
 /**
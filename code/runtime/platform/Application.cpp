@@ -25,6 +25,8 @@
 /* SOFTWARE.                                                                      */
 /**********************************************************************************/
 
+#include <core/profiler/Counters.hpp>
+#include <core/profiler/Profiler.hpp>
 #include <rhi/opengl/GLDevice.hpp>
 
 #include <platform/Application.hpp>
@@ -32,14 +34,28 @@
 #include <platform/glfw/GlfwWindowManager.hpp>
 
 #include <chrono>
+#include <cstdlib>
 
 BRK_NS_BEGIN
 
 int Application::Run(int argc, const char *const *argv) {
     // Parse args
     gArgs = std::make_shared<ArgumentParser>();
+    gArgs->AddArgument("--counters");
+    gArgs->AddArgument("--counters-frames", "0");
     gArgs->Parse(argc, argv);
 
+    // Capture per-frame counters into csv or json file (optionally for fixed number of frames)
+    String countersPath;
+    String countersFrames;
+    gArgs->Set("--counters", countersPath);
+    gArgs->Set("--counters-frames", countersFrames);
+    auto framesToCapture = static_cast<uint64>(std::strtoull(countersFrames.c_str(), nullptr, 10));
+    uint64 frameIndex = 0;
+
+    if (!countersPath.empty())
+        CounterRegistry::Instance().SetCapture(true);
+
     // Setup engine
     gEngine = std::unique_ptr<Engine>(new Engine());
     gEngine->InitCore();
@@ -77,6 +93,10 @@ int Application::Run(int argc, const char *const *argv) {
 
     // Main loop
     while (!gEngine->CloseRequested()) {
+        BRK_PROFILE_FRAME();
+        BRK_COUNTERS_FRAME();
+        BRK_PROFILE_SCOPE("Application::Frame");
+
         auto newTime = clock::now();
         auto dt = static_cast<double>(std::chrono::duration_cast<ns>(newTime - time).count()) / 1.0e9;
         auto t = static_cast<double>(std::chrono::duration_cast<ns>(newTime - start).count()) / 1.0e9;
@@ -105,6 +125,14 @@ int Application::Run(int argc, const char *const *argv) {
         gWindowManager->PollEvents();
 
         time = newTime;
+        frameIndex += 1;
+
+        if (framesToCapture > 0 && frameIndex >= framesToCapture)
+            gEngine->RequestClose();
+    }
+
+    if (!countersPath.empty() && !CounterRegistry::Instance().SaveCapture(countersPath)) {
+        BRK_ERROR("Failed to save counters path=" << countersPath);
     }
 
     // Pre-finalize call
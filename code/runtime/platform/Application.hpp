@@ -59,6 +59,10 @@ BRK_NS_BEGIN
  *   return app.Run(argc, argv);
  *  }
  * @endcode
+ *
+ * Engine counters of each frame can be saved for offline budget checks
+ * with `--counters=<file.csv|file.json>` argument; `--counters-frames=<N>`
+ * closes application after N frames.
  */
 class Application {
 public:
@@ -0,0 +1,410 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/Memory.hpp>
+#include <core/io/Logger.hpp>
+#include <core/profiler/Counters.hpp>
+#include <platform/AsyncIO.hpp>
+
+#include <algorithm>
+
+BRK_NS_BEGIN
+
+/**
+ * Pool of read buffers with power of two size classes.
+ * Kept alive by released data, so it can outlive the service.
+ */
+class AsyncIO::BufferPool {
+public:
+    static const uint32 MIN_CLASS = 16; /** 64 KiB */
+    static const uint32 MAX_CLASS = 26; /** 64 MiB */
+
+    explicit BufferPool(size_t maxPooled) : mMaxPooled(maxPooled) {}
+
+    ~BufferPool() {
+        for (auto &list : mFree) {
+            for (auto *p : list)
+                Memory::Deallocate(p);
+        }
+    }
+
+    void *Acquire(size_t size, size_t &capacity) {
+        uint32 sizeClass = GetClass(size);
+
+        if (sizeClass > MAX_CLASS) {
+            capacity = size;
+            return Memory::Allocate(size);
+        }
+
+        capacity = static_cast<size_t>(1) << sizeClass;
+
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            auto &list = mFree[sizeClass - MIN_CLASS];
+
+            if (!list.empty()) {
+                void *p = list.back();
+                list.pop_back();
+                mPooled -= capacity;
+                return p;
+            }
+        }
+
+        return Memory::Allocate(capacity);
+    }
+
+    void Release(void *p, size_t capacity) {
+        uint32 sizeClass = GetClass(capacity);
+
+        if (sizeClass <= MAX_CLASS && (static_cast<size_t>(1) << sizeClass) == capacity) {
+            std::lock_guard<std::mutex> guard(mMutex);
+
+            if (mPooled + capacity <= mMaxPooled) {
+                mFree[sizeClass - MIN_CLASS].push_back(p);
+                mPooled += capacity;
+                return;
+            }
+        }
+
+        Memory::Deallocate(p);
+    }
+
+    size_t GetPooledBytes() const {
+        std::lock_guard<std::mutex> guard(mMutex);
+        return mPooled;
+    }
+
+private:
+    static uint32 GetClass(size_t size) {
+        uint32 sizeClass = MIN_CLASS;
+        while (sizeClass <= MAX_CLASS && (static_cast<size_t>(1) << sizeClass) < size)
+            sizeClass += 1;
+        return sizeClass;
+    }
+
+    std::array<std::vector<void *>, MAX_CLASS - MIN_CLASS + 1> mFree;
+    size_t mMaxPooled;
+    size_t mPooled = 0;
+    mutable std::mutex mMutex;
+};
+
+AsyncIO::AsyncIO(Scheduler *scheduler, JobSystem *jobSystem, uint32 threadsCount, Backend backend, uint32 queueDepth)
+    : mScheduler(scheduler), mJobSystem(jobSystem), mThreadsCount(std::max(threadsCount, 1u)) {
+    mPool = std::make_shared<BufferPool>(static_cast<size_t>(DEFAULT_POOL_SIZE));
+
+    if (backend == Backend::IoUring && StartPlatformQueue(std::max(queueDepth, 1u))) {
+        mBackend.store(Backend::IoUring);
+        return;
+    }
+
+    mBackend.store(Backend::ThreadPool);
+    StartThreadPool();
+}
+
+AsyncIO::~AsyncIO() {
+    std::vector<Op *> pending;
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mFinished = true;
+
+        for (auto &queue : mQueues) {
+            pending.insert(pending.end(), queue.begin(), queue.end());
+            queue.clear();
+        }
+
+        for (auto *op : pending)
+            op->queued = false;
+    }
+
+    for (auto *op : pending)
+        FinishOp(op, Status::Cancelled);
+
+    // Threads finish reads in flight before exit
+    mCvar.notify_all();
+    for (auto &thread : mThreads)
+        thread.join();
+
+    StopPlatformQueue();
+}
+
+AsyncIO::Handle AsyncIO::Submit(Request request) {
+    Handle handle = Enqueue(std::move(request));
+
+    if (handle != INVALID_HANDLE) {
+        if (mBackend.load() == Backend::IoUring)
+            NotifyPlatformQueue();
+        else
+            mCvar.notify_one();
+    }
+
+    return handle;
+}
+
+void AsyncIO::SubmitBatch(std::vector<Request> &requests, std::vector<Handle> &handles) {
+    handles.clear();
+    handles.reserve(requests.size());
+
+    for (auto &request : requests)
+        handles.push_back(Enqueue(std::move(request)));
+
+    if (mBackend.load() == Backend::IoUring)
+        NotifyPlatformQueue();
+    else
+        mCvar.notify_all();
+}
+
+bool AsyncIO::Cancel(Handle handle) {
+    Op *op;
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        auto query = mOps.find(handle);
+
+        if (query == mOps.end() || query->second->finished)
+            return false;
+
+        op = query->second.get();
+
+        // In flight: finished by backend, result discarded
+        if (!op->queued) {
+            op->cancelled = true;
+            return true;
+        }
+
+        auto &queue = mQueues[static_cast<uint32>(op->request.priority)];
+        queue.erase(std::find(queue.begin(), queue.end(), op));
+        op->queued = false;
+    }
+
+    FinishOp(op, Status::Cancelled);
+    return true;
+}
+
+void AsyncIO::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIdleCvar.wait(lock, [this]() { return mOps.empty(); });
+}
+
+uint32 AsyncIO::GetPendingCount() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return static_cast<uint32>(mOps.size());
+}
+
+size_t AsyncIO::GetPooledBytes() const {
+    return mPool->GetPooledBytes();
+}
+
+AsyncIO::Handle AsyncIO::Enqueue(Request request) {
+    if (request.filepath.empty()) {
+        BRK_ERROR("Passed empty file path to async read");
+        return INVALID_HANDLE;
+    }
+    if (request.buffer && request.size == 0) {
+        BRK_ERROR("Size of caller buffer must be specified filepath=" << request.filepath);
+        return INVALID_HANDLE;
+    }
+
+    std::unique_ptr<Op> op(new Op());
+    op->request = std::move(request);
+    op->submitted = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    if (mFinished)
+        return INVALID_HANDLE;
+
+    op->handle = mNextHandle++;
+    mQueues[static_cast<uint32>(op->request.priority)].push_back(op.get());
+
+    auto handle = op->handle;
+    mOps.emplace(handle, std::move(op));
+
+    BRK_COUNTER_ADD("io.async_requests", 1);
+    return handle;
+}
+
+AsyncIO::Op *AsyncIO::PopLocked() {
+    for (auto &queue : mQueues) {
+        if (!queue.empty()) {
+            Op *op = queue.front();
+            queue.pop_front();
+            op->queued = false;
+            return op;
+        }
+    }
+
+    return nullptr;
+}
+
+bool AsyncIO::BeginOp(Op &op) {
+    auto &request = op.request;
+    uint64 fileSize = 0;
+
+    op.file = OpenFileForRead(request.filepath, fileSize);
+
+    if (op.file == -1) {
+        BRK_ERROR("Failed to open file for async read filepath=" << request.filepath);
+        return false;
+    }
+
+    if (request.size != 0)
+        op.size = request.size;
+    else
+        op.size = request.offset < fileSize ? static_cast<size_t>(fileSize - request.offset) : 0;
+
+    if (request.buffer)
+        op.buffer = request.buffer;
+    else if (op.size > 0)
+        op.buffer = mPool->Acquire(op.size, op.capacity);
+
+    return true;
+}
+
+void AsyncIO::FinishOp(Op *op, Status status) {
+    if (op->file != -1) {
+        CloseFileForRead(op->file);
+        op->file = -1;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+
+        if (op->cancelled)
+            status = Status::Cancelled;
+
+        op->finished = true;
+    }
+
+    Result result;
+    result.handle = op->handle;
+    result.status = status;
+
+    if (status == Status::Completed) {
+        result.buffer = op->buffer;
+        result.bytesRead = op->bytesRead;
+
+        if (op->capacity > 0) {
+            std::shared_ptr<BufferPool> pool = mPool;
+            size_t capacity = op->capacity;
+            result.data = Data::MakeWithProc(op->buffer, op->bytesRead, [pool, capacity](void *p) { pool->Release(p, capacity); });
+        }
+
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - op->submitted);
+        BRK_COUNTER_ADD("io.async_read_bytes", op->bytesRead);
+        BRK_HISTOGRAM_RECORD("io.async_latency_us", latency.count());
+    } else if (op->capacity > 0) {
+        mPool->Release(op->buffer, op->capacity);
+    }
+
+    auto &request = op->request;
+
+    if (request.callback) {
+        Callback callback = std::move(request.callback);
+
+        if (request.dispatch == Dispatch::GameThread && mScheduler)
+            mScheduler->ScheduleOnGameThread([callback, result]() { callback(result); });
+        else if (request.dispatch == Dispatch::JobSystem && mJobSystem)
+            mJobSystem->Submit([callback, result]() { callback(result); });
+        else
+            callback(result);
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    mOps.erase(op->handle);
+
+    if (mOps.empty())
+        mIdleCvar.notify_all();
+}
+
+void AsyncIO::StartThreadPool() {
+    for (uint32 i = 0; i < mThreadsCount; i++)
+        mThreads.emplace_back([this]() { ThreadPoolMain(); });
+}
+
+void AsyncIO::FallbackToThreadPool() {
+    {
+        // Destructor joins thread pool after it sets finished flag, so no threads are started after that
+        std::lock_guard<std::mutex> guard(mMutex);
+        mBackend.store(Backend::ThreadPool);
+
+        if (!mFinished)
+            StartThreadPool();
+    }
+
+    mCvar.notify_all();
+}
+
+void AsyncIO::ThreadPoolMain() {
+    // Read in chunks to check for cancellation between them
+    static const size_t CHUNK_SIZE = 8 * 1024 * 1024;
+
+    while (true) {
+        Op *op = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCvar.wait(lock, [this, &op]() { return mFinished || (op = PopLocked()) != nullptr; });
+
+            if (!op)
+                return;
+        }
+
+        if (!BeginOp(*op)) {
+            FinishOp(op, Status::Failed);
+            continue;
+        }
+
+        Status status = Status::Completed;
+
+        while (op->bytesRead < op->size) {
+            {
+                std::lock_guard<std::mutex> guard(mMutex);
+                if (op->cancelled)
+                    break;
+            }
+
+            auto *dst = reinterpret_cast<uint8 *>(op->buffer) + op->bytesRead;
+            auto toRead = std::min(op->size - op->bytesRead, CHUNK_SIZE);
+            auto read = ReadFileAt(op->file, op->request.offset + op->bytesRead, dst, toRead);
+
+            if (read < 0) {
+                BRK_ERROR("Failed to read file filepath=" << op->request.filepath);
+                status = Status::Failed;
+                break;
+            }
+            if (read == 0)
+                break;
+
+            op->bytesRead += static_cast<size_t>(read);
+        }
+
+        FinishOp(op, status);
+    }
+}
+
+BRK_NS_END
@@ -0,0 +1,275 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_ASYNCIO_HPP
+#define BERSERK_ASYNCIO_HPP
+
+#include <core/Config.hpp>
+#include <core/Data.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Scheduler.hpp>
+#include <core/Typedefs.hpp>
+#include <core/string/String.hpp>
+#include <core/templates/Ref.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * @class AsyncIO
+ * @brief Asynchronous file read service
+ *
+ * Reads files (or ranges of files) in background without blocking of
+ * the caller thread, keeping many reads in flight at once. On Linux
+ * requests are submitted in batches to io_uring from single IO thread;
+ * if io_uring is not available (old kernel, disabled by seccomp, other
+ * platform) reads are done by pool of threads with `pread`. If io_uring
+ * fails at runtime, reads in flight fail and service switches to thread pool.
+ *
+ * Requests are started in order of priority: all pending critical
+ * requests are started before normal ones, normal before prefetch.
+ * Data is read into caller buffer or into buffer from internal pool,
+ * which is returned to the pool when result data is released.
+ *
+ * Completion callback is called on game thread (by scheduler), on job
+ * system or directly on IO thread, as specified in request.
+ *
+ * @note Files are accessed by absolute paths; files of mounted pak
+ *       archives can be read as ranges of the archive file.
+ * @note Thread-safe
+ */
+class AsyncIO final {
+public:
+    /** Handle to identify submitted request */
+    using Handle = uint64;
+
+    /** Invalid request handle */
+    static const Handle INVALID_HANDLE = 0;
+    /** Default max number of reads in flight */
+    static const uint32 DEFAULT_QUEUE_DEPTH = 64;
+    /** Default max size of buffers kept in the pool */
+    static const size_t DEFAULT_POOL_SIZE = 64 * 1024 * 1024;
+
+    /** @brief Priority of request */
+    enum class Priority : uint8 {
+        /** Data required to continue (blocking load) */
+        Critical = 0,
+        /** Regular streaming */
+        Normal = 1,
+        /** Speculative read of data which may be required later */
+        Prefetch = 2
+    };
+
+    /** @brief Status of completed request */
+    enum class Status : uint8 {
+        /** All requested bytes are read (or file ended) */
+        Completed = 0,
+        /** Failed to open or read file */
+        Failed = 1,
+        /** Request was canceled */
+        Cancelled = 2
+    };
+
+    /** @brief Where to call completion callback */
+    enum class Dispatch : uint8 {
+        /** Directly on IO thread (callback must be short) */
+        IOThread = 0,
+        /** As job of job system */
+        JobSystem = 1,
+        /** On game thread at next scheduler update */
+        GameThread = 2
+    };
+
+    /** @brief Type of read backend */
+    enum class Backend : uint8 {
+        /** Pool of threads with blocking reads */
+        ThreadPool = 0,
+        /** Linux io_uring queue */
+        IoUring = 1
+    };
+
+    /** @brief Result of request */
+    struct Result {
+        Handle handle = INVALID_HANDLE; /** Handle of the request */
+        Status status = Status::Failed; /** Status of the request */
+        Ref<Data> data;                 /** Read bytes in pooled buffer (null if read into caller buffer or not completed) */
+        void *buffer = nullptr;         /** Memory with read bytes (caller or pooled buffer) */
+        size_t bytesRead = 0;           /** Number of read bytes */
+    };
+
+    /** Completion callback type */
+    using Callback = std::function<void(const Result &result)>;
+
+    /** @brief Read request */
+    struct Request {
+        String filepath;                          /** Absolute path of the file */
+        uint64 offset = 0;                        /** Offset in file of first byte to read */
+        size_t size = 0;                          /** Number of bytes to read; 0 to read to the end of file */
+        void *buffer = nullptr;                   /** Caller buffer of at least `size` bytes; null to use pooled buffer */
+        Priority priority = Priority::Normal;     /** Priority of the request */
+        Dispatch dispatch = Dispatch::GameThread; /** Where to call callback */
+        Callback callback;                        /** Completion callback (optional) */
+    };
+
+    /**
+     * @brief Create service and start its threads
+     *
+     * @param scheduler Scheduler for game thread callbacks (if null callbacks are called on IO thread)
+     * @param jobSystem Job system for job callbacks (if null callbacks are called on IO thread)
+     * @param threadsCount Number of threads of the thread pool backend
+     * @param backend Preferred backend; thread pool is used if io_uring is not available
+     * @param queueDepth Max number of reads in flight of io_uring backend
+     */
+    BRK_API AsyncIO(Scheduler *scheduler, JobSystem *jobSystem, uint32 threadsCount = 2,
+                    Backend backend = Backend::IoUring, uint32 queueDepth = DEFAULT_QUEUE_DEPTH);
+
+    /** Cancels pending requests and waits for requests in flight */
+    BRK_API ~AsyncIO();
+
+    /**
+     * @brief Submit read request
+     *
+     * @param request Request to submit
+     * @return Handle of request or invalid handle if request is invalid
+     */
+    BRK_API Handle Submit(Request request);
+
+    /**
+     * @brief Submit batch of requests at once
+     *
+     * Requests are queued under single lock and backend is woken up once,
+     * so io_uring backend submits them with single system call.
+     *
+     * @param requests Requests to submit (moved out)
+     * @param[out] handles Handles of requests in the same order
+     */
+    BRK_API void SubmitBatch(std::vector<Request> &requests, std::vector<Handle> &handles);
+
+    /**
+     * @brief Cancel request
+     *
+     * Pending request is removed from queue; read in flight is finished,
+     * but its result is discarded. In both cases callback is called
+     * with cancelled status.
+     *
+     * @param handle Handle of request
+     * @return True if request was not finished yet and is cancelled
+     */
+    BRK_API bool Cancel(Handle handle);
+
+    /** Block until all submitted requests are finished and their callbacks are dispatched */
+    BRK_API void WaitIdle();
+
+    /** @return Backend used for reads */
+    BRK_API Backend GetBackend() const { return mBackend.load(); }
+
+    /** @return Number of not finished requests */
+    BRK_API uint32 GetPendingCount() const;
+
+    /** @return Size of free buffers kept in the pool */
+    BRK_API size_t GetPooledBytes() const;
+
+private:
+    class BufferPool;
+    struct PlatformQueue;
+
+    /** State of submitted request */
+    struct Op {
+        Request request;
+        Handle handle = INVALID_HANDLE;
+        int64 file = -1;                                 /** Platform file handle */
+        void *buffer = nullptr;                          /** Destination of read */
+        size_t capacity = 0;                             /** Capacity of pooled buffer (0 for caller buffer) */
+        size_t size = 0;                                 /** Number of bytes to read */
+        size_t bytesRead = 0;                            /** Number of bytes already read */
+        bool queued = true;                              /** True while in pending queue */
+        bool cancelled = false;                          /** Cancel requested while in flight */
+        bool finished = false;                           /** Result is being dispatched */
+        std::chrono::steady_clock::time_point submitted; /** Time of submission */
+    };
+
+    Handle Enqueue(Request request);
+    Op *PopLocked();
+    bool BeginOp(Op &op);
+    void FinishOp(Op *op, Status status);
+    void StartThreadPool();
+    void FallbackToThreadPool();
+    void ThreadPoolMain();
+
+    /** Platform specific file access */
+    static int64 OpenFileForRead(const String &filepath, uint64 &fileSize);
+    static int64 ReadFileAt(int64 file, uint64 offset, void *buffer, size_t size);
+    static void CloseFileForRead(int64 file);
+
+    /** Platform specific queue backend (io_uring) */
+    bool StartPlatformQueue(uint32 queueDepth);
+    void StopPlatformQueue();
+    void NotifyPlatformQueue();
+
+private:
+    static const uint32 PRIORITIES_COUNT = 3;
+
+    std::array<std::deque<Op *>, PRIORITIES_COUNT> mQueues; /** Pending requests by priority */
+    std::unordered_map<Handle, std::unique_ptr<Op>> mOps;   /** Not finished requests */
+    std::vector<std::thread> mThreads;                      /** Threads of thread pool backend */
+    std::shared_ptr<BufferPool> mPool;                      /** Pool of read buffers */
+    PlatformQueue *mPlatformQueue = nullptr;                /** State of io_uring backend */
+    Scheduler *mScheduler;
+    JobSystem *mJobSystem;
+    std::atomic<Backend> mBackend{Backend::ThreadPool};
+    Handle mNextHandle = INVALID_HANDLE + 1;
+    uint32 mThreadsCount = 1; /** Number of threads of thread pool backend */
+    bool mFinished = false;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mCvar;     /** Notify thread pool about new requests */
+    std::condition_variable mIdleCvar; /** Notify about finished requests */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_ASYNCIO_HPP
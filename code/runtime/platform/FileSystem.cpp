@@ -42,6 +42,17 @@ void FileSystem::CloseFile(std::FILE *file) {
 }
 
 Ref<Data> FileSystem::ReadFile(const String &filepath) {
+    String name;
+    if (auto pak = FindPak(filepath, name)) {
+        auto data = pak->ReadFile(name, mJobSystem);
+
+        if (data.IsNull()) {
+            BRK_ERROR("Failed to find file in pak filepath=" << filepath);
+        }
+
+        return data;
+    }
+
     auto *file = OpenFile(filepath, "rb");
 
     if (!file) {
@@ -52,13 +63,16 @@ Ref<Data> FileSystem::ReadFile(const String &filepath) {
     struct stat statBuf {};
     if (stat(filepath.c_str(), &statBuf) == -1) {
         BRK_ERROR("Failed to get file stat filepath=" << filepath);
+        CloseFile(file);
         return Ref<Data>();
     }
 
     auto size = static_cast<size_t>(statBuf.st_size);
     auto data = Data::Make(size);
+    auto read = std::fread(data->GetDataWrite(), 1, size, file);
+    CloseFile(file);
 
-    if (std::fread(data->GetDataWrite(), 1, size, file) != size) {
+    if (read != size) {
         BRK_ERROR("Failed to read file filepath=" << filepath << " size=" << size);
         return Ref<Data>();
     }
@@ -66,6 +80,59 @@ Ref<Data> FileSystem::ReadFile(const String &filepath) {
     return data;
 }
 
+Ref<Data> FileSystem::ReadCompressedFile(const String &filepath) {
+    auto data = ReadFileNoCopy(filepath);
+
+    if (data.IsNull() || !CompressedStream::IsCompressed(data))
+        return data;
+
+    auto decompressed = CompressedStream::Decompress(data, mJobSystem);
+
+    if (decompressed.IsNull()) {
+        BRK_ERROR("Failed to decompress file filepath=" << filepath);
+    }
+
+    return decompressed;
+}
+
+Ref<CompressedStreamReader> FileSystem::OpenCompressedFile(const String &filepath) {
+    auto data = ReadFileNoCopy(filepath);
+
+    if (data.IsNull())
+        return Ref<CompressedStreamReader>();
+
+    Ref<CompressedStreamReader> reader(new CompressedStreamReader(std::move(data)));
+
+    if (!reader->IsValid()) {
+        BRK_ERROR("Invalid compressed file filepath=" << filepath);
+        return Ref<CompressedStreamReader>();
+    }
+
+    return reader;
+}
+
+bool FileSystem::WriteFile(const String &filepath, const Ref<Data> &data) {
+    assert(data.IsNotNull());
+
+    auto *file = OpenFile(filepath, "wb");
+
+    if (!file) {
+        BRK_ERROR("Failed to open file filepath=" << filepath);
+        return false;
+    }
+
+    auto size = data->GetSize();
+    auto written = std::fwrite(data->GetData(), 1, size, file);
+    CloseFile(file);
+
+    if (written != size) {
+        BRK_ERROR("Failed to write file filepath=" << filepath << " size=" << size);
+        return false;
+    }
+
+    return true;
+}
+
 void FileSystem::AddSearchPath(String path) {
     if (path.empty()) {
         BRK_ERROR("Passed empty path as search path");
@@ -93,7 +160,44 @@ void FileSystem::SetSearchPaths(std::vector<String> searchPaths) {
 
     std::lock_guard<std::recursive_mutex> guard(mMutex);
     mSearchPaths = std::move(searchPaths);
+
+    // Mounted archives stay with the lowest priority
+    for (auto &pak : mPaks)
+        mSearchPaths.push_back(pak.first);
+
+    ClearCache();
+}
+
+std::vector<String> FileSystem::GetSearchPaths() const {
+    std::lock_guard<std::recursive_mutex> guard(mMutex);
+    return mSearchPaths;
+}
+
+bool FileSystem::MountPak(const String &filepath) {
+    auto fullPath = GetFullFilePath(filepath);
+
+    if (fullPath.empty()) {
+        BRK_ERROR("Failed to find pak file=" << filepath);
+        return false;
+    }
+
+    auto pak = PakArchive::Open(*this, fullPath);
+
+    if (pak.IsNull())
+        return false;
+
+    auto prefix = fullPath + '/';
+
+    std::lock_guard<std::recursive_mutex> guard(mMutex);
+
+    if (mPaks.find(prefix) != mPaks.end())
+        return true;
+
+    mPaks.emplace(prefix, std::move(pak));
+    mSearchPaths.push_back(std::move(prefix));
     ClearCache();
+
+    return true;
 }
 
 String FileSystem::GetFullFilePath(const String &filename) {
@@ -112,7 +216,12 @@ String FileSystem::GetFullFilePath(const String &filename) {
     String resolvedPath;
 
     for (const auto &prefix : mSearchPaths) {
-        resolvedPath = ResolveFilePath(prefix, filename);
+        auto pak = mPaks.find(prefix);
+
+        if (pak == mPaks.end())
+            resolvedPath = ResolveFilePath(prefix, filename);
+        else if (pak->second->Contains(filename))
+            resolvedPath = prefix + PakArchive::NormalizeName(filename);
 
         if (!resolvedPath.empty()) {
             mCachedFullFilePath.emplace(filename, resolvedPath);
@@ -165,6 +274,11 @@ String FileSystem::GetFileExtension(const String &filename) {
 
 bool FileSystem::IsFileExists(const String &filename) {
     auto fullPath = GetFullFilePath(filename);
+
+    String name;
+    if (auto pak = FindPak(fullPath, name))
+        return pak->Contains(name);
+
     return !fullPath.empty() && IsFileExistsAbs(fullPath);
 }
 
@@ -178,6 +292,28 @@ void FileSystem::ClearCache() {
     mCachedFullDirPath.clear();
 }
 
+Ref<PakArchive> FileSystem::FindPak(const String &filepath, String &name) {
+    std::lock_guard<std::recursive_mutex> guard(mMutex);
+
+    for (auto &pak : mPaks) {
+        if (filepath.size() > pak.first.size() && filepath.compare(0, pak.first.size(), pak.first) == 0) {
+            name = filepath.substr(pak.first.size());
+            return pak.second;
+        }
+    }
+
+    return Ref<PakArchive>();
+}
+
+Ref<Data> FileSystem::ReadFileNoCopy(const String &filepath) {
+    // Content of files in pak is already mapped
+    String name;
+    if (FindPak(filepath, name).IsNotNull())
+        return ReadFile(filepath);
+
+    return MapFile(filepath);
+}
+
 String FileSystem::GetPathForFile(const String &path, const String &filename) {
     // Make path/filename
     String ret = path;
@@ -30,9 +30,12 @@
 
 #include <core/Config.hpp>
 #include <core/Data.hpp>
+#include <core/JobSystem.hpp>
 #include <core/Typedefs.hpp>
+#include <core/compression/CompressedStream.hpp>
 #include <core/string/String.hpp>
 #include <core/templates/Ref.hpp>
+#include <platform/PakArchive.hpp>
 
 #include <cstdio>
 #include <mutex>
@@ -106,6 +109,57 @@ public:
      */
     BRK_API Ref<Data> ReadFile(const String &filepath);
 
+    /**
+     * @brief Map file into memory for reading
+     *
+     * Maps content of the file into read-only memory without copy.
+     * File is unmapped when returned data is released.
+     *
+     * @param filepath Absolute (full) path to file
+     *
+     * @return Data or null if failed to map file (or file is empty)
+     */
+    BRK_API Ref<Data> MapFile(const String &filepath);
+
+    /**
+     * @brief Read file, compressed with CompressedStream format
+     *
+     * Maps file and decompresses its blocks in parallel on job system (if set).
+     * File which is not compressed is returned as is.
+     *
+     * @param filepath Absolute (full) path to file
+     *
+     * @return Decompressed data or null if failed read or decompress file
+     */
+    BRK_API Ref<Data> ReadCompressedFile(const String &filepath);
+
+    /**
+     * @brief Open file, compressed with CompressedStream format, for streaming read
+     *
+     * @param filepath Absolute (full) path to file
+     *
+     * @return Reader or null if failed read file or file is not compressed stream
+     */
+    BRK_API Ref<CompressedStreamReader> OpenCompressedFile(const String &filepath);
+
+    /**
+     * @brief Set job system used for parallel decompression
+     * @param jobSystem Job system or null to decompress on calling thread
+     */
+    BRK_API void SetJobSystem(JobSystem *jobSystem) { mJobSystem = jobSystem; }
+
+    /**
+     * @brief Write file by file path
+     *
+     * Creates new or truncates existing file and writes data into it.
+     *
+     * @param filepath Absolute (full) path to file
+     * @param data Data to write
+     *
+     * @return True if successfully written
+     */
+    BRK_API bool WriteFile(const String &filepath, const Ref<Data> &data);
+
     /**
      * @brief Add search path
      *
@@ -127,6 +181,28 @@ public:
      */
     BRK_API void SetSearchPaths(std::vector<String> searchPaths);
 
+    /**
+     * @brief Get search paths
+     *
+     * @return List of search paths in descending priority order (includes mounted pak archives)
+     */
+    BRK_API std::vector<String> GetSearchPaths() const;
+
+    /**
+     * @brief Mount pak archive as search path
+     *
+     * Archive is added as last search path (with lower priority).
+     * Files of archive are resolved to full paths `<archive path>/<file name>`,
+     * which can be passed to ReadFile and IsFileExists; such files are returned
+     * without copy from the memory mapping of the archive.
+     *
+     * @note Files of archive can not be opened with OpenFile or listed with ListDir
+     *
+     * @param filepath Relative or absolute path to archive
+     * @return True if mounted
+     */
+    BRK_API bool MountPak(const String &filepath);
+
     /**
      * @brief Get full path for specified file
      *
@@ -199,6 +275,23 @@ public:
      */
     BRK_API bool IsDirExists(const String &dirname);
 
+    /**
+     * @brief Create directory with all missing parent directories
+     *
+     * @param dirpath Absolute (full) path of the directory
+     * @return True if directory created or already exists
+     */
+    BRK_API bool MakeDir(const String &dirpath);
+
+    /**
+     * @brief Remove directory with all its content
+     * @note Links are removed, but not followed
+     *
+     * @param dirpath Absolute (full) path of the directory
+     * @return True if directory removed or does not exist
+     */
+    BRK_API bool RemoveDir(const String &dirpath);
+
     /**
      * @brief List entries of the specified directory
      * @note Uses search path to resolve relative path if passed
@@ -220,6 +313,12 @@ public:
      */
     BRK_API String GetExecutableDir() const;
 
+    /**
+     * @brief Directory for temporary files of the system
+     * @return Absolute path without trailing separator
+     */
+    BRK_API String GetTempDir() const;
+
 private:
     void Init();
     void ClearCache();
@@ -228,10 +327,15 @@ private:
     String ResolveFilePath(const String &prefix, const String &file);
     String ResolveDirPath(const String &prefix, const String &dir);
     String GetPathForFile(const String &path, const String &filename);
+    Ref<Data> ReadFileNoCopy(const String &filepath);
+    Ref<PakArchive> FindPak(const String &filepath, String &name);
 
     /** List of search paths for files; store in descending priority order */
     std::vector<String> mSearchPaths;
 
+    /** Mounted pak archives by search path */
+    std::unordered_map<String, Ref<PakArchive>> mPaks;
+
     /** Cached full file path look-ups */
     std::unordered_map<String, String> mCachedFullFilePath;
 
@@ -241,6 +345,9 @@ private:
     /** Path to the executable file of the application */
     String mExecutablePath;
 
+    /** Job system for decompression */
+    JobSystem *mJobSystem = nullptr;
+
     mutable std::recursive_mutex mMutex;
 };
 
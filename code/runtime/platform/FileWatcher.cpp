@@ -0,0 +1,117 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/io/Logger.hpp>
+#include <core/profiler/Counters.hpp>
+#include <core/profiler/Profiler.hpp>
+#include <platform/FileWatcher.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+BRK_NS_BEGIN
+
+FileWatcher::FileWatcher(Callback callback, uint32 debounceMs)
+    : mCallback(std::move(callback)), mDebounce(debounceMs) {
+    assert(mCallback);
+
+    if (!StartPlatformWatch()) {
+        BRK_WARNING("File watching is not supported");
+        return;
+    }
+
+    mThread = std::thread([this]() {
+        Profiler::Instance().SetThreadName("FileWatcher");
+        WatcherMain();
+    });
+}
+
+FileWatcher::~FileWatcher() {
+    if (!mPlatformWatch)
+        return;
+
+    mFinished.store(true);
+    WakePlatformWatch();
+    mThread.join();
+
+    StopPlatformWatch();
+}
+
+bool FileWatcher::AddDirectory(const String &dirpath) {
+    if (!mPlatformWatch)
+        return false;
+
+    // Reported paths are `<dir>/<name>`
+    String path = dirpath;
+    while (path.size() > 1 && path.back() == '/')
+        path.pop_back();
+
+    return AddPlatformWatch(path, nullptr);
+}
+
+uint32 FileWatcher::GetDirectoriesCount() const {
+    return mPlatformWatch ? GetPlatformWatchesCount() : 0;
+}
+
+void FileWatcher::WatcherMain() {
+    using clock = std::chrono::steady_clock;
+
+    std::vector<String> pending;
+    clock::time_point lastChange;
+
+    while (!mFinished.load()) {
+        int32 timeout = -1;
+
+        if (!pending.empty()) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - lastChange);
+            timeout = static_cast<int32>(std::max(mDebounce - elapsed, std::chrono::milliseconds(0)).count());
+        }
+
+        auto count = pending.size();
+        WaitPlatformEvents(timeout, pending);
+
+        if (mFinished.load())
+            break;
+
+        // Restart interval on each change, so burst of writes is delivered once
+        if (pending.size() != count) {
+            lastChange = clock::now();
+            continue;
+        }
+
+        if (!pending.empty() && clock::now() - lastChange >= mDebounce) {
+            std::sort(pending.begin(), pending.end());
+            pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+            BRK_COUNTER_ADD("platform.file_changes", pending.size());
+            mCallback(pending);
+            pending.clear();
+        }
+    }
+}
+
+BRK_NS_END
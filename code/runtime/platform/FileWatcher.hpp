@@ -0,0 +1,131 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_FILEWATCHER_HPP
+#define BERSERK_FILEWATCHER_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <core/string/String.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * @class FileWatcher
+ * @brief Watches directories for modified files
+ *
+ * Directories are watched recursively, including sub-directories created
+ * after the watch was added. Changes are collected on watcher thread and
+ * reported in batches: batch is delivered once no new changes arrived
+ * during debounce interval, so single save of the editor (truncate, several
+ * writes, rename) is reported once.
+ *
+ * File is reported when it is closed after writing or moved into watched
+ * directory. Removed files are not reported.
+ *
+ * On Linux watcher uses inotify; on other platforms it is not supported
+ * and `IsValid` returns false.
+ *
+ * @note Thread-safe
+ */
+class FileWatcher final {
+public:
+    /** Callback with sorted unique full paths of changed files; called on watcher thread */
+    using Callback = std::function<void(const std::vector<String> &files)>;
+
+    /** Default interval without changes before batch is delivered */
+    static const uint32 DEFAULT_DEBOUNCE_MS = 100;
+
+    /**
+     * @brief Create watcher and start its thread
+     *
+     * @param callback Function to call with batch of changed files
+     * @param debounceMs Interval in milliseconds without changes before batch is delivered
+     */
+    BRK_API explicit FileWatcher(Callback callback, uint32 debounceMs = DEFAULT_DEBOUNCE_MS);
+
+    /** Stops watcher thread; not delivered changes are discarded */
+    BRK_API ~FileWatcher();
+
+    /**
+     * @brief Watch directory and all its sub-directories
+     *
+     * @param dirpath Absolute path of the directory
+     * @return True if directory is watched
+     */
+    BRK_API bool AddDirectory(const String &dirpath);
+
+    /** @return True if watching is supported and watcher is started */
+    BRK_API bool IsValid() const { return mPlatformWatch != nullptr; }
+
+    /** @return Number of watched directories (including sub-directories) */
+    BRK_API uint32 GetDirectoriesCount() const;
+
+private:
+    struct PlatformWatch;
+
+    void WatcherMain();
+
+    /** Platform specific watch (inotify) */
+    bool StartPlatformWatch();
+    void StopPlatformWatch();
+    void WakePlatformWatch();
+    bool AddPlatformWatch(const String &dirpath, std::vector<String> *files);
+    uint32 GetPlatformWatchesCount() const;
+
+    /** Wait for events at most timeout (negative to block) and append changed files */
+    void WaitPlatformEvents(int32 timeoutMs, std::vector<String> &files);
+
+private:
+    Callback mCallback;
+    std::chrono::milliseconds mDebounce;
+    std::thread mThread;
+    std::atomic<bool> mFinished{false};
+    PlatformWatch *mPlatformWatch = nullptr; /** State of platform watch */
+
+    mutable std::mutex mMutex;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_FILEWATCHER_HPP
@@ -0,0 +1,294 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/io/Logger.hpp>
+#include <platform/FileSystem.hpp>
+#include <platform/PakArchive.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+BRK_NS_BEGIN
+
+static_assert(sizeof(PakArchive::Header) == 40, "Pak header layout changed");
+static_assert(sizeof(PakArchive::Entry) == 48, "Pak entry layout changed");
+
+namespace {
+    uint64 AlignUp(uint64 value, uint64 alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    bool IsInRange(uint64 offset, uint64 size, uint64 total) {
+        return offset <= total && size <= total - offset;
+    }
+}// namespace
+
+Ref<PakArchive> PakArchive::Open(FileSystem &fileSystem, const String &filepath) {
+    auto data = fileSystem.MapFile(filepath);
+
+    if (data.IsNull()) {
+        BRK_ERROR("Failed to map pak file=" << filepath);
+        return Ref<PakArchive>();
+    }
+
+    return Open(std::move(data), filepath);
+}
+
+Ref<PakArchive> PakArchive::Open(Ref<Data> data, const String &name) {
+    assert(data.IsNotNull());
+
+    auto base = reinterpret_cast<const uint8 *>(data->GetData());
+    auto size = static_cast<uint64>(data->GetSize());
+    auto header = reinterpret_cast<const Header *>(base);
+
+    if (size < sizeof(Header) || header->magic != MAGIC || header->version != VERSION) {
+        BRK_ERROR("Invalid pak file=" << name);
+        return Ref<PakArchive>();
+    }
+
+    uint64 count = header->entriesCount;
+
+    if (header->entriesOffset % alignof(Entry) != 0 ||
+        !IsInRange(header->entriesOffset, count * sizeof(Entry), size) ||
+        !IsInRange(header->namesOffset, header->namesSize, size)) {
+        BRK_ERROR("Corrupted pak directory file=" << name);
+        return Ref<PakArchive>();
+    }
+
+    auto entries = reinterpret_cast<const Entry *>(base + header->entriesOffset);
+
+    for (uint64 i = 0; i < count; i++) {
+        const Entry &entry = entries[i];
+
+        bool valid = IsInRange(entry.offset, entry.size, size) &&
+                     IsInRange(entry.nameOffset, entry.nameSize, header->namesSize) &&
+                     (entry.codec == CompressionCodec::Lz4 || (entry.codec == CompressionCodec::None && entry.size == entry.rawSize)) &&
+                     (i == 0 || entries[i - 1].nameHash <= entry.nameHash);
+
+        if (!valid) {
+            BRK_ERROR("Corrupted pak entry=" << i << " file=" << name);
+            return Ref<PakArchive>();
+        }
+    }
+
+    Ref<PakArchive> archive(new PakArchive());
+    archive->mData = std::move(data);
+    archive->mHeader = header;
+    archive->mEntries = entries;
+    archive->mNames = reinterpret_cast<const char *>(base + header->namesOffset);
+    archive->mName = name;
+
+    return archive;
+}
+
+const PakArchive::Entry *PakArchive::FindEntry(const String &name) const {
+    auto normalized = NormalizeName(name);
+    auto hash = HashName(normalized);
+    auto end = mEntries + mHeader->entriesCount;
+    auto entry = std::lower_bound(mEntries, end, hash, [](const Entry &e, uint64 h) { return e.nameHash < h; });
+
+    for (; entry != end && entry->nameHash == hash; ++entry) {
+        if (entry->nameSize == normalized.size() && std::memcmp(mNames + entry->nameOffset, normalized.data(), normalized.size()) == 0)
+            return entry;
+    }
+
+    return nullptr;
+}
+
+Ref<Data> PakArchive::ReadFile(const String &name, JobSystem *jobSystem) const {
+    auto entry = FindEntry(name);
+    return entry ? ReadEntry(*entry, jobSystem) : Ref<Data>();
+}
+
+Ref<Data> PakArchive::ReadEntry(const Entry &entry, JobSystem *jobSystem) const {
+    auto stored = ReadEntryStored(entry);
+
+    if (entry.codec == CompressionCodec::None)
+        return stored;
+
+    auto data = CompressedStream::Decompress(stored, jobSystem);
+
+    if (data.IsNull() || data->GetSize() != entry.rawSize) {
+        BRK_ERROR("Failed to decompress pak entry=" << GetEntryName(entry) << " file=" << mName);
+        return Ref<Data>();
+    }
+
+    return data;
+}
+
+Ref<Data> PakArchive::ReadEntryStored(const Entry &entry) const {
+    return Data::MakeSubset(mData, static_cast<size_t>(entry.offset), static_cast<size_t>(entry.size));
+}
+
+bool PakArchive::Verify(const Entry &entry) const {
+    auto base = reinterpret_cast<const uint8 *>(mData->GetData());
+    return Crc32::Hash(base + entry.offset, static_cast<size_t>(entry.size)) == entry.crc;
+}
+
+uint64 PakArchive::HashName(const String &name) {
+    // FNV-1a
+    uint64 hash = 0xcbf29ce484222325ull;
+    for (auto c : name) {
+        hash ^= static_cast<uint8>(c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+String PakArchive::NormalizeName(const String &name) {
+    String normalized = name;
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+
+    size_t start = 0;
+    while (normalized.compare(start, 2, "./") == 0)
+        start += 2;
+    while (start < normalized.size() && normalized[start] == '/')
+        start += 1;
+
+    return start > 0 ? normalized.substr(start) : normalized;
+}
+
+PakBuilder::PakBuilder(uint32 alignment) : mAlignment(alignment) {
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+}
+
+void PakBuilder::AddFile(const String &name, Ref<Data> data, CompressionCodec codec) {
+    assert(data.IsNotNull());
+
+    auto normalized = PakArchive::NormalizeName(name);
+    auto query = mFilesLookUp.find(normalized);
+
+    if (query != mFilesLookUp.end()) {
+        mFiles[query->second].data = std::move(data);
+        mFiles[query->second].codec = codec;
+        return;
+    }
+
+    mFilesLookUp.emplace(normalized, mFiles.size());
+    mFiles.push_back({std::move(normalized), std::move(data), codec});
+}
+
+bool PakBuilder::Save(FileSystem &fileSystem, const String &filepath, JobSystem *jobSystem) const {
+    std::vector<PakArchive::Entry> entries;
+    std::vector<Ref<Data>> stored(mFiles.size());
+    std::vector<char> names;
+
+    // Files are compressed one by one, while blocks of each file in parallel
+    for (size_t i = 0; i < mFiles.size(); i++) {
+        auto &file = mFiles[i];
+        stored[i] = file.data;
+
+        if (file.codec != CompressionCodec::None && file.data->GetSize() > 0) {
+            auto compressed = CompressedStream::Compress(file.data, file.codec, CompressedStream::DEFAULT_BLOCK_SIZE, jobSystem);
+
+            if (compressed->GetSize() < file.data->GetSize())
+                stored[i] = std::move(compressed);
+        }
+    }
+
+    entries.reserve(mFiles.size());
+
+    // Content is written in order of adding, so related files stay close
+    uint64 offset = AlignUp(sizeof(PakArchive::Header), mAlignment);
+
+    for (size_t i = 0; i < mFiles.size(); i++) {
+        auto &file = mFiles[i];
+        bool compressed = stored[i] != file.data;
+
+        PakArchive::Entry entry{};
+        entry.nameHash = PakArchive::HashName(file.name);
+        entry.offset = offset;
+        entry.size = stored[i]->GetSize();
+        entry.rawSize = file.data->GetSize();
+        entry.nameOffset = static_cast<uint32>(names.size());
+        entry.nameSize = static_cast<uint32>(file.name.size());
+        entry.codec = compressed ? file.codec : CompressionCodec::None;
+        entry.crc = Crc32::Hash(stored[i]->GetData(), stored[i]->GetSize());
+        entries.push_back(entry);
+
+        names.insert(names.end(), file.name.begin(), file.name.end());
+        offset = AlignUp(offset + entry.size, mAlignment);
+    }
+
+    std::sort(entries.begin(), entries.end(), [&](const PakArchive::Entry &a, const PakArchive::Entry &b) {
+        if (a.nameHash != b.nameHash)
+            return a.nameHash < b.nameHash;
+        return std::lexicographical_compare(names.begin() + a.nameOffset, names.begin() + a.nameOffset + a.nameSize,
+                                            names.begin() + b.nameOffset, names.begin() + b.nameOffset + b.nameSize);
+    });
+
+    PakArchive::Header header{};
+    header.magic = PakArchive::MAGIC;
+    header.version = PakArchive::VERSION;
+    header.entriesCount = static_cast<uint32>(entries.size());
+    header.alignment = mAlignment;
+    header.entriesOffset = AlignUp(offset, alignof(PakArchive::Entry));
+    header.namesOffset = header.entriesOffset + entries.size() * sizeof(PakArchive::Entry);
+    header.namesSize = names.size();
+
+    auto *out = fileSystem.OpenFile(filepath, "wb");
+
+    if (!out) {
+        BRK_ERROR("Failed to open pak file=" << filepath);
+        return false;
+    }
+
+    const uint8 zeros[256] = {};
+    uint64 written = 0;
+    bool success = true;
+
+    auto write = [&](const void *data, uint64 size) {
+        success = success && std::fwrite(data, 1, static_cast<size_t>(size), out) == size;
+        written += size;
+    };
+    auto pad = [&](uint64 target) {
+        while (written < target)
+            write(zeros, std::min<uint64>(sizeof(zeros), target - written));
+    };
+
+    write(&header, sizeof(header));
+
+    for (auto &data : stored) {
+        pad(AlignUp(written, mAlignment));
+        write(data->GetData(), data->GetSize());
+    }
+
+    pad(header.entriesOffset);
+    write(entries.data(), entries.size() * sizeof(PakArchive::Entry));
+    write(names.data(), names.size());
+
+    fileSystem.CloseFile(out);
+
+    if (!success) {
+        BRK_ERROR("Failed to write pak file=" << filepath);
+        return false;
+    }
+
+    return true;
+}
+
+BRK_NS_END
@@ -0,0 +1,216 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_PAKARCHIVE_HPP
+#define BERSERK_PAKARCHIVE_HPP
+
+#include <core/Config.hpp>
+#include <core/Crc32.hpp>
+#include <core/Data.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+#include <core/compression/CompressedStream.hpp>
+#include <core/string/String.hpp>
+#include <core/templates/Ref.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+class FileSystem;
+
+/**
+ * @class PakArchive
+ * @brief Read-only archive of packed game files (.brkpak)
+ *
+ * Archive layout: header, files content (each file aligned), directory
+ * of entries sorted by hash of file name, and names blob. Archive file
+ * is memory mapped as a whole; directory is used in-place and files are
+ * returned as data subsets of the mapping without copy.
+ *
+ * Each file has its own codec; compressed files are stored as
+ * CompressedStream and decompressed on read (in parallel if job system provided).
+ *
+ * File names are relative paths with '/' separator, as passed to
+ * FileSystem for resolution using search paths.
+ *
+ * @note Thread-safe (immutable after open)
+ */
+class PakArchive final : public RefCnt {
+public:
+    /** Identifies pak file: 'BRKP' */
+    static const uint32 MAGIC = 0x504b5242;
+    /** Increment on any change of the layout */
+    static const uint32 VERSION = 1;
+    /** Default alignment of files content */
+    static const uint32 DEFAULT_ALIGNMENT = 16;
+
+    /** @brief Archive header */
+    struct Header {
+        uint32 magic;
+        uint32 version;
+        uint32 entriesCount;
+        uint32 alignment;
+        uint64 entriesOffset; /** Offset of directory entries */
+        uint64 namesOffset;   /** Offset of names blob */
+        uint64 namesSize;     /** Size of names blob */
+    };
+
+    /** @brief Directory entry */
+    struct Entry {
+        uint64 nameHash;        /** Hash of the file name */
+        uint64 offset;          /** Offset of stored content */
+        uint64 size;            /** Size of stored content */
+        uint64 rawSize;         /** Size of file content after decoding */
+        uint32 nameOffset;      /** Offset of name in names blob */
+        uint32 nameSize;        /** Length of name */
+        CompressionCodec codec; /** Codec of stored content */
+        Crc32Hash crc;          /** Hash of stored content */
+    };
+
+    /**
+     * @brief Open archive file
+     *
+     * @param fileSystem File system to map file
+     * @param filepath Absolute (full) path to archive
+     *
+     * @return Archive or null if failed to open or archive is invalid
+     */
+    BRK_API static Ref<PakArchive> Open(FileSystem &fileSystem, const String &filepath);
+
+    /**
+     * @brief Open archive from data in memory
+     *
+     * @param data Archive content; kept alive by archive and returned files
+     * @param name Name of the archive for diagnostics
+     *
+     * @return Archive or null if archive is invalid
+     */
+    BRK_API static Ref<PakArchive> Open(Ref<Data> data, const String &name);
+
+    /** @return Entry of file or null if not found */
+    BRK_API const Entry *FindEntry(const String &name) const;
+
+    /** @return True if archive contains file */
+    BRK_API bool Contains(const String &name) const { return FindEntry(name) != nullptr; }
+
+    /** @return Content of file or null if not found or failed to decompress */
+    BRK_API Ref<Data> ReadFile(const String &name, JobSystem *jobSystem = nullptr) const;
+
+    /** @return Content of entry or null if failed to decompress */
+    BRK_API Ref<Data> ReadEntry(const Entry &entry, JobSystem *jobSystem = nullptr) const;
+
+    /** @return Stored (not decoded) content of entry */
+    BRK_API Ref<Data> ReadEntryStored(const Entry &entry) const;
+
+    /** @return True if stored content of entry matches its hash */
+    BRK_API bool Verify(const Entry &entry) const;
+
+    /** @return Name of entry */
+    BRK_API String GetEntryName(const Entry &entry) const { return String(mNames + entry.nameOffset, entry.nameSize); }
+
+    /** @return Directory entries sorted by name hash */
+    BRK_API const Entry *GetEntries() const { return mEntries; }
+    /** @return Number of files */
+    BRK_API uint32 GetEntriesCount() const { return mHeader->entriesCount; }
+    /** @return Name of the archive */
+    BRK_API const String &GetName() const { return mName; }
+
+    /** @return Hash of file name */
+    BRK_API static uint64 HashName(const String &name);
+
+    /** @return Name with '/' separators and without leading './' */
+    BRK_API static String NormalizeName(const String &name);
+
+private:
+    PakArchive() = default;
+
+    Ref<Data> mData;
+    const Header *mHeader = nullptr;
+    const Entry *mEntries = nullptr;
+    const char *mNames = nullptr;
+    String mName;
+};
+
+/**
+ * @class PakBuilder
+ * @brief Builds pak archive file from set of files
+ */
+class PakBuilder final {
+public:
+    /** @param alignment Alignment of files content in archive (power of two) */
+    BRK_API explicit PakBuilder(uint32 alignment = PakArchive::DEFAULT_ALIGNMENT);
+    BRK_API ~PakBuilder() = default;
+
+    /**
+     * @brief Add file to archive; file with the same name is replaced
+     *
+     * @param name Name of the file
+     * @param data Content of the file
+     * @param codec Codec to compress file; file is stored as is if it does not compress
+     */
+    BRK_API void AddFile(const String &name, Ref<Data> data, CompressionCodec codec = CompressionCodec::None);
+
+    /**
+     * @brief Save archive into file
+     *
+     * @param fileSystem File system to write file
+     * @param filepath Absolute (full) path of archive
+     * @param jobSystem Optional job system to compress files in parallel
+     *
+     * @return True if saved
+     */
+    BRK_API bool Save(FileSystem &fileSystem, const String &filepath, JobSystem *jobSystem = nullptr) const;
+
+    /** @return Number of added files */
+    BRK_API uint32 GetFilesCount() const { return static_cast<uint32>(mFiles.size()); }
+
+private:
+    struct File {
+        String name;
+        Ref<Data> data;
+        CompressionCodec codec;
+    };
+
+    std::vector<File> mFiles;
+    std::unordered_map<String, size_t> mFilesLookUp;
+    uint32 mAlignment;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_PAKARCHIVE_HPP
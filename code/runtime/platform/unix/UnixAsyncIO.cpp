@@ -0,0 +1,368 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/io/Logger.hpp>
+#include <platform/AsyncIO.hpp>
+
+#include <algorithm>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(BERSERK_TARGET_LINUX) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #define BERSERK_WITH_IO_URING
+    #endif
+#endif
+
+#ifdef BERSERK_WITH_IO_URING
+    #include <cstring>
+    #include <linux/io_uring.h>
+    #include <sys/eventfd.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+#endif
+
+BRK_NS_BEGIN
+
+int64 AsyncIO::OpenFileForRead(const String &filepath, uint64 &fileSize) {
+    int fd = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd == -1)
+        return -1;
+
+    struct stat statBuf {};
+    if (fstat(fd, &statBuf) == -1) {
+        close(fd);
+        return -1;
+    }
+
+    fileSize = static_cast<uint64>(statBuf.st_size);
+    return fd;
+}
+
+int64 AsyncIO::ReadFileAt(int64 file, uint64 offset, void *buffer, size_t size) {
+    while (true) {
+        auto read = pread(static_cast<int>(file), buffer, size, static_cast<off_t>(offset));
+
+        if (read >= 0 || errno != EINTR)
+            return static_cast<int64>(read);
+    }
+}
+
+void AsyncIO::CloseFileForRead(int64 file) {
+    close(static_cast<int>(file));
+}
+
+#ifdef BERSERK_WITH_IO_URING
+
+/**
+ * State of io_uring queue.
+ *
+ * Single IO thread owns the rings: it takes pending requests in order of
+ * priority, opens files, fills submission entries and submits the whole
+ * batch with one `io_uring_enter`, which also waits for completions.
+ * Read of eventfd is always in flight, so new requests wake the thread.
+ */
+struct AsyncIO::PlatformQueue {
+    static const uint64 WAKE_UP = 0; /** User data of eventfd read */
+
+    int ring = -1;
+    int event = -1;
+    uint32 depth = 0;
+    uint64 eventValue = 0;
+
+    void *sqRing = MAP_FAILED;
+    size_t sqRingSize = 0;
+    void *cqRing = MAP_FAILED;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqMask = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned *cqMask = nullptr;
+    io_uring_cqe *cqes = nullptr;
+
+    unsigned toSubmit = 0;
+
+    std::thread thread;
+
+    ~PlatformQueue() {
+        if (sqes)
+            munmap(sqes, sqesSize);
+        if (cqRing != MAP_FAILED && cqRing != sqRing)
+            munmap(cqRing, cqRingSize);
+        if (sqRing != MAP_FAILED)
+            munmap(sqRing, sqRingSize);
+        if (event != -1)
+            close(event);
+        if (ring != -1)
+            close(ring);
+    }
+
+    bool Init(uint32 queueDepth) {
+        depth = queueDepth;
+
+        io_uring_params params{};
+        ring = static_cast<int>(syscall(__NR_io_uring_setup, depth + 1, &params));
+
+        if (ring == -1)
+            return false;
+
+        // Reads with offset and eventfd wake up require 5.6+ kernel
+    #ifdef IORING_FEAT_CUR_PERSONALITY
+        if (!(params.features & IORING_FEAT_CUR_PERSONALITY))
+            return false;
+    #else
+        return false;
+    #endif
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+            sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED)
+            return false;
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+            cqRing = sqRing;
+        else
+            cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED)
+            return false;
+
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void *sqesMemory = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES);
+        if (sqesMemory == MAP_FAILED)
+            return false;
+        sqes = reinterpret_cast<io_uring_sqe *>(sqesMemory);
+
+        auto *sq = reinterpret_cast<uint8 *>(sqRing);
+        sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+
+        auto *cq = reinterpret_cast<uint8 *>(cqRing);
+        cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+        event = eventfd(0, EFD_CLOEXEC);
+        return event != -1;
+    }
+
+    void PushRead(int fd, void *buffer, size_t size, uint64 offset, uint64 userData) {
+        // Queue holds depth + 1 entries: at most one read per request and eventfd read
+        unsigned tail = *sqTail;
+        unsigned index = tail & *sqMask;
+
+        io_uring_sqe &sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<uint64>(buffer);
+        sqe.len = static_cast<uint32>(std::min<size_t>(size, 0x7ffff000));
+        sqe.off = offset;
+        sqe.user_data = userData;
+
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        toSubmit += 1;
+    }
+
+    /** Submit entries and wait for completion; @return False if ring failed */
+    bool Enter(bool wait) {
+        while (true) {
+            unsigned flags = wait ? IORING_ENTER_GETEVENTS : 0;
+            auto submitted = syscall(__NR_io_uring_enter, ring, toSubmit, wait ? 1u : 0u, flags, nullptr, 0);
+
+            if (submitted >= 0) {
+                toSubmit -= static_cast<unsigned>(submitted);
+                return true;
+            }
+            // Completion queue is full: reap completions and submit later
+            if (errno != EINTR)
+                return errno == EAGAIN || errno == EBUSY;
+        }
+    }
+};
+
+bool AsyncIO::StartPlatformQueue(uint32 queueDepth) {
+    auto *queue = new PlatformQueue();
+
+    if (!queue->Init(queueDepth)) {
+        BRK_INFO("io_uring is not available, use thread pool for async io");
+        delete queue;
+        return false;
+    }
+
+    mPlatformQueue = queue;
+    queue->thread = std::thread([this, queue]() {
+        std::vector<Op *> inFlight;
+        bool wakeUpArmed = false;
+        std::vector<Op *> batch;
+
+        auto finishInFlight = [&](Op *op, Status status) {
+            inFlight.erase(std::find(inFlight.begin(), inFlight.end(), op));
+            FinishOp(op, status);
+        };
+
+        while (true) {
+            if (!wakeUpArmed) {
+                queue->PushRead(queue->event, &queue->eventValue, sizeof(queue->eventValue), 0, PlatformQueue::WAKE_UP);
+                wakeUpArmed = true;
+            }
+
+            bool finished;
+            {
+                std::lock_guard<std::mutex> guard(mMutex);
+                finished = mFinished;
+
+                Op *op;
+                while (inFlight.size() + batch.size() < queue->depth && (op = PopLocked()) != nullptr)
+                    batch.push_back(op);
+            }
+
+            for (auto *op : batch) {
+                if (!BeginOp(*op)) {
+                    FinishOp(op, Status::Failed);
+                    continue;
+                }
+                if (op->size == 0) {
+                    FinishOp(op, Status::Completed);
+                    continue;
+                }
+
+                queue->PushRead(static_cast<int>(op->file), op->buffer, op->size, op->request.offset, reinterpret_cast<uint64>(op));
+                inFlight.push_back(op);
+            }
+            batch.clear();
+
+            if (finished && inFlight.empty())
+                break;
+
+            // Interrupted or busy enter is retried, other errors mean the ring is unusable
+            if (!queue->Enter(true)) {
+                auto error = errno;
+                BRK_ERROR("Failed to enter io_uring errno=" << error << ", use thread pool for async io");
+
+                // Results of reads in flight are lost with the ring; pending requests are served by thread pool
+                for (auto *op : inFlight)
+                    FinishOp(op, Status::Failed);
+                inFlight.clear();
+
+                FallbackToThreadPool();
+                break;
+            }
+
+            unsigned head = *queue->cqHead;
+            unsigned tail = __atomic_load_n(queue->cqTail, __ATOMIC_ACQUIRE);
+
+            for (; head != tail; head++) {
+                io_uring_cqe &cqe = queue->cqes[head & *queue->cqMask];
+
+                if (cqe.user_data == PlatformQueue::WAKE_UP) {
+                    wakeUpArmed = false;
+                    continue;
+                }
+
+                auto *op = reinterpret_cast<Op *>(cqe.user_data);
+                bool cancelled;
+                {
+                    std::lock_guard<std::mutex> guard(mMutex);
+                    cancelled = op->cancelled;
+                }
+
+                if (cqe.res < 0 && cqe.res != -EINTR && cqe.res != -EAGAIN) {
+                    BRK_ERROR("Failed to read file filepath=" << op->request.filepath << " error=" << -cqe.res);
+                    finishInFlight(op, Status::Failed);
+                    continue;
+                }
+
+                op->bytesRead += cqe.res > 0 ? static_cast<size_t>(cqe.res) : 0;
+
+                // Short read: continue from last byte unless file ended
+                if (!cancelled && op->bytesRead < op->size && cqe.res != 0) {
+                    queue->PushRead(static_cast<int>(op->file), reinterpret_cast<uint8 *>(op->buffer) + op->bytesRead,
+                                    op->size - op->bytesRead, op->request.offset + op->bytesRead, cqe.user_data);
+                    continue;
+                }
+
+                finishInFlight(op, Status::Completed);
+            }
+
+            __atomic_store_n(queue->cqHead, head, __ATOMIC_RELEASE);
+        }
+    });
+
+    return true;
+}
+
+void AsyncIO::StopPlatformQueue() {
+    if (!mPlatformQueue)
+        return;
+
+    NotifyPlatformQueue();
+    mPlatformQueue->thread.join();
+
+    delete mPlatformQueue;
+    mPlatformQueue = nullptr;
+}
+
+void AsyncIO::NotifyPlatformQueue() {
+    uint64 value = 1;
+    auto written = write(mPlatformQueue->event, &value, sizeof(value));
+    (void) written;
+}
+
+#else
+
+struct AsyncIO::PlatformQueue {};
+
+bool AsyncIO::StartPlatformQueue(uint32) {
+    return false;
+}
+
+void AsyncIO::StopPlatformQueue() {}
+
+void AsyncIO::NotifyPlatformQueue() {}
+
+#endif
+
+BRK_NS_END
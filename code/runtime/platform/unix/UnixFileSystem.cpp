@@ -30,12 +30,16 @@
 #include <core/string/Unicode.hpp>
 #include <platform/FileSystem.hpp>
 
+#include <cerrno>
 #include <climits>
 #include <cstdio>
 #include <cstdlib>
 #include <vector>
 
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <whereami.h>
 
@@ -45,6 +49,33 @@ std::FILE *FileSystem::OpenFile(const String &filepath, const String &mode) {
     return std::fopen(filepath.c_str(), mode.c_str());
 }
 
+Ref<Data> FileSystem::MapFile(const String &filepath) {
+    int fd = open(filepath.c_str(), O_RDONLY);
+
+    if (fd == -1) {
+        BRK_ERROR("Failed to open file filepath=" << filepath);
+        return Ref<Data>();
+    }
+
+    struct stat statBuf {};
+    if (fstat(fd, &statBuf) == -1 || statBuf.st_size == 0) {
+        BRK_ERROR("Failed to get file stat or file is empty filepath=" << filepath);
+        close(fd);
+        return Ref<Data>();
+    }
+
+    auto size = static_cast<size_t>(statBuf.st_size);
+    void *memory = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (memory == MAP_FAILED) {
+        BRK_ERROR("Failed to map file filepath=" << filepath << " size=" << size);
+        return Ref<Data>();
+    }
+
+    return Data::MakeWithProc(memory, size, [size](void *p) { munmap(p, size); });
+}
+
 String FileSystem::GetFileName(const String &file, bool withoutExtension) {
     auto pos = file.find_last_of('/');
     auto dest = String::npos;
@@ -114,6 +145,76 @@ std::vector<FileSystem::Entry> FileSystem::ListDir(const String &dir) {
     return std::move(entries);
 }
 
+bool FileSystem::MakeDir(const String &dirpath) {
+    if (dirpath.empty())
+        return false;
+
+    // Create each missing directory of the path starting from the root
+    auto pos = dirpath.find('/', 1);
+
+    while (true) {
+        auto current = dirpath.substr(0, pos);
+
+        if (mkdir(current.c_str(), 0755) != 0 && errno != EEXIST) {
+            BRK_ERROR("Failed to create dir=" << current);
+            return false;
+        }
+
+        if (pos == String::npos)
+            break;
+
+        pos = dirpath.find('/', pos + 1);
+    }
+
+    return true;
+}
+
+bool FileSystem::RemoveDir(const String &dirpath) {
+    DIR *directory = opendir(dirpath.c_str());
+
+    if (!directory)
+        return errno == ENOENT;
+
+    bool removed = true;
+    dirent *ent;
+
+    while ((ent = readdir(directory)) != nullptr) {
+        String name = ent->d_name;
+
+        if (name == "." || name == "..")
+            continue;
+
+        auto path = dirpath + "/" + name;
+
+        struct stat statBuf {};
+        if (lstat(path.c_str(), &statBuf) == 0 && S_ISDIR(statBuf.st_mode)) {
+            removed = RemoveDir(path) && removed;
+        } else if (unlink(path.c_str()) != 0) {
+            BRK_ERROR("Failed to remove file=" << path);
+            removed = false;
+        }
+    }
+
+    closedir(directory);
+
+    if (rmdir(dirpath.c_str()) != 0) {
+        BRK_ERROR("Failed to remove dir=" << dirpath);
+        return false;
+    }
+
+    return removed;
+}
+
+String FileSystem::GetTempDir() const {
+    auto dir = std::getenv("TMPDIR");
+    String path = dir && dir[0] ? dir : "/tmp";
+
+    while (path.size() > 1 && path.back() == '/')
+        path.pop_back();
+
+    return path;
+}
+
 void FileSystem::Init() {
     auto pathLength = wai_getExecutablePath(nullptr, 0, nullptr);
     std::vector<char> path(pathLength, ' ');
@@ -0,0 +1,243 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/io/Logger.hpp>
+#include <platform/FileWatcher.hpp>
+
+#ifdef BERSERK_TARGET_LINUX
+    #include <cerrno>
+    #include <cstring>
+    #include <unordered_map>
+
+    #include <dirent.h>
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/inotify.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+BRK_NS_BEGIN
+
+#ifdef BERSERK_TARGET_LINUX
+
+namespace {
+    const uint32 WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+}// namespace
+
+struct FileWatcher::PlatformWatch {
+    int inotify = -1;                        /** Inotify instance */
+    int wake = -1;                           /** Event to wake up watcher thread */
+    std::unordered_map<int, String> dirs;    /** Watched directories by watch descriptor */
+    std::unordered_map<String, int> watches; /** Watch descriptors by directory */
+};
+
+bool FileWatcher::StartPlatformWatch() {
+    int inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify == -1) {
+        BRK_WARNING("Failed to init inotify errno=" << errno);
+        return false;
+    }
+
+    int wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake == -1) {
+        close(inotify);
+        return false;
+    }
+
+    mPlatformWatch = new PlatformWatch();
+    mPlatformWatch->inotify = inotify;
+    mPlatformWatch->wake = wake;
+    return true;
+}
+
+void FileWatcher::StopPlatformWatch() {
+    close(mPlatformWatch->inotify);
+    close(mPlatformWatch->wake);
+    delete mPlatformWatch;
+    mPlatformWatch = nullptr;
+}
+
+void FileWatcher::WakePlatformWatch() {
+    uint64_t value = 1;
+    auto written = write(mPlatformWatch->wake, &value, sizeof(value));
+    (void) written;
+}
+
+bool FileWatcher::AddPlatformWatch(const String &dirpath, std::vector<String> *files) {
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+
+        if (mPlatformWatch->watches.find(dirpath) != mPlatformWatch->watches.end())
+            return true;
+
+        int wd = inotify_add_watch(mPlatformWatch->inotify, dirpath.c_str(), WATCH_MASK);
+        if (wd == -1) {
+            if (errno == ENOSPC) {
+                BRK_WARNING("Reached limit of inotify watches (see fs.inotify.max_user_watches), dir=" << dirpath);
+            }
+            return false;
+        }
+
+        mPlatformWatch->dirs[wd] = dirpath;
+        mPlatformWatch->watches[dirpath] = wd;
+    }
+
+    // Watch is added before listing, so files created in between are not missed
+    DIR *dir = opendir(dirpath.c_str());
+    if (!dir)
+        return true;
+
+    while (auto entry = readdir(dir)) {
+        if (std::strcmp(entry->d_name, ".") == 0 || std::strcmp(entry->d_name, "..") == 0)
+            continue;
+
+        String path = dirpath + "/" + entry->d_name;
+        bool isDir = entry->d_type == DT_DIR;
+        bool isFile = entry->d_type == DT_REG;
+
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat statBuf {};
+            if (stat(path.c_str(), &statBuf) == 0) {
+                isDir = S_ISDIR(statBuf.st_mode);
+                isFile = S_ISREG(statBuf.st_mode);
+            }
+        }
+
+        if (isDir)
+            AddPlatformWatch(path, files);
+        else if (files && isFile)
+            files->push_back(std::move(path));
+    }
+
+    closedir(dir);
+    return true;
+}
+
+uint32 FileWatcher::GetPlatformWatchesCount() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return static_cast<uint32>(mPlatformWatch->dirs.size());
+}
+
+void FileWatcher::WaitPlatformEvents(int32 timeoutMs, std::vector<String> &files) {
+    pollfd fds[2];
+    fds[0].fd = mPlatformWatch->inotify;
+    fds[0].events = POLLIN;
+    fds[0].revents = 0;
+    fds[1].fd = mPlatformWatch->wake;
+    fds[1].events = POLLIN;
+    fds[1].revents = 0;
+
+    if (poll(fds, 2, timeoutMs) <= 0)
+        return;
+
+    if (fds[1].revents & POLLIN) {
+        uint64_t value;
+        auto read = ::read(mPlatformWatch->wake, &value, sizeof(value));
+        (void) read;
+    }
+
+    if (!(fds[0].revents & POLLIN))
+        return;
+
+    alignas(inotify_event) char buffer[16 * 1024];
+
+    while (true) {
+        auto size = ::read(mPlatformWatch->inotify, buffer, sizeof(buffer));
+        if (size <= 0)
+            break;
+
+        for (char *p = buffer; p < buffer + size;) {
+            auto event = reinterpret_cast<const inotify_event *>(p);
+            p += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                BRK_WARNING("Inotify queue overflow, some file changes are lost");
+                continue;
+            }
+
+            String dirpath;
+            {
+                std::lock_guard<std::mutex> guard(mMutex);
+                auto query = mPlatformWatch->dirs.find(event->wd);
+                if (query == mPlatformWatch->dirs.end())
+                    continue;
+
+                // Directory is removed or moved out
+                if (event->mask & IN_IGNORED) {
+                    mPlatformWatch->watches.erase(query->second);
+                    mPlatformWatch->dirs.erase(query);
+                    continue;
+                }
+
+                dirpath = query->second;
+            }
+
+            if (event->len == 0)
+                continue;
+
+            String path = dirpath + "/" + event->name;
+
+            if (event->mask & IN_ISDIR) {
+                // Also reports files, which were written before watch is added
+                if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    AddPlatformWatch(path, &files);
+            } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                files.push_back(std::move(path));
+            }
+        }
+    }
+}
+
+#else
+
+struct FileWatcher::PlatformWatch {};
+
+bool FileWatcher::StartPlatformWatch() {
+    return false;
+}
+
+void FileWatcher::StopPlatformWatch() {
+}
+
+void FileWatcher::WakePlatformWatch() {
+}
+
+bool FileWatcher::AddPlatformWatch(const String &, std::vector<String> *) {
+    return false;
+}
+
+uint32 FileWatcher::GetPlatformWatchesCount() const {
+    return 0;
+}
+
+void FileWatcher::WaitPlatformEvents(int32, std::vector<String> &) {
+}
+
+#endif
+
+BRK_NS_END
@@ -0,0 +1,85 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/string/String16u.hpp>
+#include <core/string/Unicode.hpp>
+#include <platform/AsyncIO.hpp>
+
+#include <windows.h>
+
+BRK_NS_BEGIN
+
+int64 AsyncIO::OpenFileForRead(const String &filepath, uint64 &fileSize) {
+    String16u filepath16u;
+
+    if (!Unicode::ConvertUtf8ToUtf16(filepath, filepath16u))
+        return -1;
+
+    HANDLE file = CreateFileW(reinterpret_cast<LPCWSTR>(filepath16u.c_str()), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return -1;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return -1;
+    }
+
+    fileSize = static_cast<uint64>(size.QuadPart);
+    return static_cast<int64>(reinterpret_cast<intptr_t>(file));
+}
+
+int64 AsyncIO::ReadFileAt(int64 file, uint64 offset, void *buffer, size_t size) {
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(offset & 0xffffffff);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    DWORD read = 0;
+    auto toRead = static_cast<DWORD>(size < 0x7ffff000 ? size : 0x7ffff000);
+
+    if (!::ReadFile(reinterpret_cast<HANDLE>(static_cast<intptr_t>(file)), buffer, toRead, &read, &overlapped))
+        return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+
+    return static_cast<int64>(read);
+}
+
+void AsyncIO::CloseFileForRead(int64 file) {
+    CloseHandle(reinterpret_cast<HANDLE>(static_cast<intptr_t>(file)));
+}
+
+struct AsyncIO::PlatformQueue {};
+
+bool AsyncIO::StartPlatformQueue(uint32) {
+    return false;
+}
+
+void AsyncIO::StopPlatformQueue() {}
+
+void AsyncIO::NotifyPlatformQueue() {}
+
+BRK_NS_END
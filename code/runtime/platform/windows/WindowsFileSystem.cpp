@@ -56,6 +56,47 @@ std::FILE *FileSystem::OpenFile(const String &filepath, const String &mode) {
     return nullptr;
 }
 
+Ref<Data> FileSystem::MapFile(const String &filepath) {
+    String16u filepath16u;
+
+    if (filepath.empty() || !Unicode::ConvertUtf8ToUtf16(filepath, filepath16u)) {
+        BRK_ERROR("Invalid file path filepath=" << filepath);
+        return Ref<Data>();
+    }
+
+    HANDLE file = CreateFileW(reinterpret_cast<LPCWSTR>(filepath16u.c_str()), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        BRK_ERROR("Failed to open file filepath=" << filepath);
+        return Ref<Data>();
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        BRK_ERROR("Failed to get file size or file is empty filepath=" << filepath);
+        CloseHandle(file);
+        return Ref<Data>();
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (!mapping) {
+        BRK_ERROR("Failed to create file mapping filepath=" << filepath);
+        return Ref<Data>();
+    }
+
+    void *memory = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (!memory) {
+        BRK_ERROR("Failed to map file filepath=" << filepath);
+        return Ref<Data>();
+    }
+
+    return Data::MakeWithProc(memory, static_cast<size_t>(size.QuadPart), [](void *p) { UnmapViewOfFile(p); });
+}
+
 String FileSystem::GetFileName(const String &filename, bool withoutExtension) {
     auto file = PathToUnixStyle(filename);
     auto pos = file.find_last_of('/');
@@ -130,6 +171,104 @@ std::vector<FileSystem::Entry> FileSystem::ListDir(const String &dir) {
     return std::move(entries);
 }
 
+bool FileSystem::MakeDir(const String &dirpath) {
+    auto path = PathToUnixStyle(dirpath);
+
+    if (path.empty())
+        return false;
+
+    // Create each missing directory of the path starting from the drive
+    auto pos = path.find('/');
+
+    while (true) {
+        auto current = path.substr(0, pos);
+        String16u current16u;
+
+        if (!current.empty() && current.back() != ':' && Unicode::ConvertUtf8ToUtf16(current, current16u)) {
+            if (!CreateDirectoryW(reinterpret_cast<LPCWSTR>(current16u.c_str()), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS) {
+                BRK_ERROR("Failed to create dir=" << current);
+                return false;
+            }
+        }
+
+        if (pos == String::npos)
+            break;
+
+        pos = path.find('/', pos + 1);
+    }
+
+    return true;
+}
+
+bool FileSystem::RemoveDir(const String &dirpath) {
+    auto path = PathToUnixStyle(dirpath);
+    String16u path16u;
+
+    if (path.empty() || !Unicode::ConvertUtf8ToUtf16(path + "/*", path16u))
+        return false;
+
+    WIN32_FIND_DATAW fileData;
+    HANDLE hFind = FindFirstFileW(reinterpret_cast<LPCWSTR>(path16u.c_str()), &fileData);
+
+    if (hFind == INVALID_HANDLE_VALUE)
+        return GetLastError() == ERROR_FILE_NOT_FOUND || GetLastError() == ERROR_PATH_NOT_FOUND;
+
+    bool removed = true;
+
+    do {
+        String16u name16u(reinterpret_cast<const char16_t *>(fileData.cFileName));
+        String name;
+
+        if (!Unicode::ConvertUtf16ToUtf8(name16u, name) || name == "." || name == "..")
+            continue;
+
+        auto entryPath = path + "/" + name;
+        String16u entryPath16u;
+
+        if (!Unicode::ConvertUtf8ToUtf16(entryPath, entryPath16u)) {
+            removed = false;
+            continue;
+        }
+
+        auto entry = reinterpret_cast<LPCWSTR>(entryPath16u.c_str());
+        auto isDir = (fileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        auto isLink = (fileData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+
+        if (isDir && !isLink) {
+            removed = RemoveDir(entryPath) && removed;
+        } else if (!(isDir ? RemoveDirectoryW(entry) : DeleteFileW(entry))) {
+            BRK_ERROR("Failed to remove file=" << entryPath);
+            removed = false;
+        }
+    } while (FindNextFileW(hFind, &fileData));
+
+    FindClose(hFind);
+
+    String16u dir16u;
+    if (!Unicode::ConvertUtf8ToUtf16(path, dir16u) || !RemoveDirectoryW(reinterpret_cast<LPCWSTR>(dir16u.c_str()))) {
+        BRK_ERROR("Failed to remove dir=" << path);
+        return false;
+    }
+
+    return removed;
+}
+
+String FileSystem::GetTempDir() const {
+    wchar_t buffer[MAX_PATH + 1];
+    auto length = GetTempPathW(MAX_PATH + 1, buffer);
+    String path;
+
+    if (length == 0 || !Unicode::ConvertUtf16ToUtf8(String16u(reinterpret_cast<const char16_t *>(buffer), length), path))
+        return String();
+
+    path = PathToUnixStyle(path);
+
+    while (path.size() > 1 && path.back() == '/')
+        path.pop_back();
+
+    return path;
+}
+
 void FileSystem::Init() {
     auto pathLength = wai_getExecutablePath(nullptr, 0, nullptr);
     std::vector<char> path(pathLength, ' ');
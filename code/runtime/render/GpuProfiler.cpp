@@ -0,0 +1,188 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/Engine.hpp>
+#include <render/GpuProfiler.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+BRK_NS_BEGIN
+
+GpuProfiler::GpuProfiler(uint32 latency) {
+    mFrames.resize(std::max(latency, 2u));
+    mOcclusionResults.reserve(64);
+}
+
+void GpuProfiler::BeginScope(RHICommandList &commandList, const char *name) {
+    commandList.BeginMarker(name);
+
+    auto &device = Engine::Instance().GetRHIDevice();
+    if (!Profiler::Instance().IsEnabled() || !device.GetCaps().supportTimerQuery) {
+        mStack.push_back(static_cast<uint32>(INVALID_QUERY));
+        return;
+    }
+
+    auto &frame = mFrames[mCurrent];
+
+    Scope scope;
+    scope.name = name;
+    scope.begin = WriteTimestamp(commandList, frame);
+    scope.end = static_cast<uint32>(INVALID_QUERY);
+    scope.depth = static_cast<uint32>(mStack.size());
+
+    mStack.push_back(static_cast<uint32>(frame.scopes.size()));
+    frame.scopes.push_back(scope);
+}
+
+void GpuProfiler::EndScope(RHICommandList &commandList) {
+    assert(!mStack.empty());
+
+    auto id = mStack.back();
+    mStack.pop_back();
+
+    if (id != INVALID_QUERY) {
+        auto &frame = mFrames[mCurrent];
+        frame.scopes[id].end = WriteTimestamp(commandList, frame);
+    }
+
+    commandList.EndMarker();
+}
+
+uint32 GpuProfiler::BeginOcclusionQuery(RHICommandList &commandList) {
+    auto &frame = mFrames[mCurrent];
+
+    if (frame.occlusionUsed == frame.occlusion.size())
+        frame.occlusion.push_back(Engine::Instance().GetRHIDevice().CreateOcclusionQuery());
+
+    auto id = frame.occlusionUsed++;
+    commandList.BeginOcclusionQuery(frame.occlusion[id]);
+    frame.pending = true;
+
+    return id;
+}
+
+void GpuProfiler::EndOcclusionQuery(RHICommandList &commandList, uint32 id) {
+    auto &frame = mFrames[mCurrent];
+    assert(id < frame.occlusionUsed);
+
+    commandList.EndOcclusionQuery(frame.occlusion[id]);
+}
+
+void GpuProfiler::NextFrame_RT() {
+    BRK_PROFILE_SCOPE("GpuProfiler::NextFrame_RT");
+
+    if (!mStack.empty()) {
+        BRK_ERROR("Gpu profile scopes must be closed before next frame: " << mStack.size());
+        mStack.clear();
+    }
+
+    auto latency = GetLatency();
+    mFrames[mCurrent].index = mFrameIndex;
+    mCurrent = (mCurrent + 1) % latency;
+    mFrameIndex += 1;
+
+    // Resolve frames from the oldest while their results are ready
+    for (uint32 i = 0; i < latency; i++) {
+        if (!Resolve(mFrames[(mCurrent + i) % latency]))
+            break;
+    }
+
+    // Slot of the new frame is still in flight: drop its results instead of blocking
+    auto &frame = mFrames[mCurrent];
+    if (frame.pending) {
+        frame.pending = false;
+        mDroppedFrames += 1;
+    }
+
+    frame.scopes.clear();
+    frame.timersUsed = 0;
+    frame.occlusionUsed = 0;
+    frame.cpuAnchor = 0;
+}
+
+uint64 GpuProfiler::GetOcclusionResult(uint32 id) const {
+    return id < mOcclusionResults.size() ? mOcclusionResults[id] : static_cast<uint64>(NO_RESULT);
+}
+
+uint32 GpuProfiler::WriteTimestamp(RHICommandList &commandList, Frame &frame) {
+    if (frame.timersUsed == frame.timers.size())
+        frame.timers.push_back(Engine::Instance().GetRHIDevice().CreateTimerQuery());
+
+    auto id = frame.timersUsed++;
+    if (id == 0)
+        frame.cpuAnchor = Profiler::GetTime();
+
+    commandList.WriteTimestamp(frame.timers[id]);
+    frame.pending = true;
+
+    return id;
+}
+
+bool GpuProfiler::Resolve(Frame &frame) {
+    if (!frame.pending)
+        return true;
+
+    std::vector<uint64> timestamps(frame.timersUsed);
+    for (uint32 i = 0; i < frame.timersUsed; i++) {
+        if (!frame.timers[i]->GetResult_RT(timestamps[i]))
+            return false;
+    }
+
+    std::vector<uint64> samples(frame.occlusionUsed);
+    for (uint32 i = 0; i < frame.occlusionUsed; i++) {
+        if (!frame.occlusion[i]->GetResult_RT(samples[i]))
+            return false;
+    }
+
+    // Map gpu clock to cpu clock using the first timestamp of the frame
+    mEvents.clear();
+    for (const auto &scope : frame.scopes) {
+        if (scope.end == INVALID_QUERY)
+            continue;
+
+        auto begin = timestamps[scope.begin] - std::min(timestamps[scope.begin], timestamps[0]);
+        auto end = timestamps[scope.end] - std::min(timestamps[scope.end], timestamps[0]);
+
+        ProfileEvent event;
+        event.name = scope.name;
+        event.begin = frame.cpuAnchor + begin;
+        event.end = frame.cpuAnchor + std::max(begin, end);
+        event.depth = scope.depth;
+        mEvents.push_back(event);
+    }
+
+    Profiler::Instance().SubmitGpuEvents(mEvents);
+
+    mOcclusionResults = std::move(samples);
+    mResolvedFrameIndex = frame.index;
+    frame.pending = false;
+
+    return true;
+}
+
+BRK_NS_END
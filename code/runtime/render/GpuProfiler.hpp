@@ -0,0 +1,166 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_GPUPROFILER_HPP
+#define BERSERK_GPUPROFILER_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <core/profiler/Profiler.hpp>
+
+#include <rhi/RHICommandList.hpp>
+#include <rhi/RHIQuery.hpp>
+
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup render
+ * @{
+ */
+
+/**
+ * @class GpuProfiler
+ * @brief Gpu scopes timing and occlusion queries with deferred read back
+ *
+ * Scopes write timestamp queries and debug markers into command list.
+ * Queries of each frame are kept in one of `latency` frame slots and
+ * polled without blocking in `NextFrame_RT`, so results are read back
+ * `latency - 1` or more frames later. Frame which is still not complete
+ * when its slot must be reused is dropped instead of waiting for gpu.
+ *
+ * Resolved scopes are converted to cpu time (first timestamp of the frame
+ * is matched with cpu time when it was issued) and submitted to the Profiler.
+ *
+ * @warning Must be used on rhi thread only
+ */
+class GpuProfiler final {
+public:
+    static const uint32 DEFAULT_LATENCY = 3;
+    static const uint32 INVALID_QUERY = 0xffffffff;
+    static const uint64 NO_RESULT = 0xffffffffffffffff;
+
+    /** @param latency Number of frames in flight to keep queries for (at least 2) */
+    BRK_API explicit GpuProfiler(uint32 latency = DEFAULT_LATENCY);
+    BRK_API ~GpuProfiler() = default;
+
+    /** Begin named scope (name must have static storage) */
+    BRK_API void BeginScope(RHICommandList &commandList, const char *name);
+    /** End last begun scope */
+    BRK_API void EndScope(RHICommandList &commandList);
+
+    /** Begin occlusion query; @return Query id within current frame */
+    BRK_API uint32 BeginOcclusionQuery(RHICommandList &commandList);
+    /** End occlusion query with id */
+    BRK_API void EndOcclusionQuery(RHICommandList &commandList, uint32 id);
+
+    /** Close current frame, poll results of previous frames and start new one */
+    BRK_API void NextFrame_RT();
+
+    /** @return Samples passed of query with id of the last resolved frame (or NO_RESULT) */
+    BRK_API uint64 GetOcclusionResult(uint32 id) const;
+    /** @return Index of the last resolved frame */
+    BRK_API uint64 GetResolvedFrameIndex() const { return mResolvedFrameIndex; }
+    /** @return Number of frames dropped since results were not ready in time */
+    BRK_API uint64 GetDroppedFramesCount() const { return mDroppedFrames; }
+    /** @return Number of frames in flight */
+    BRK_API uint32 GetLatency() const { return static_cast<uint32>(mFrames.size()); }
+
+private:
+    struct Scope {
+        const char *name; /** Scope name */
+        uint32 begin;     /** Timer query of scope begin */
+        uint32 end;       /** Timer query of scope end */
+        uint32 depth;     /** Nesting depth */
+    };
+
+    struct Frame {
+        std::vector<Ref<RHITimerQuery>> timers;        /** Timer queries pool */
+        std::vector<Ref<RHIOcclusionQuery>> occlusion; /** Occlusion queries pool */
+        std::vector<Scope> scopes;                     /** Scopes of the frame */
+        uint32 timersUsed = 0;                         /** Timers used in frame */
+        uint32 occlusionUsed = 0;                      /** Occlusion queries used in frame */
+        uint64 cpuAnchor = 0;                          /** Cpu time when first timer was written */
+        uint64 index = 0;                              /** Index of the frame */
+        bool pending = false;                          /** Has unresolved queries */
+    };
+
+    uint32 WriteTimestamp(RHICommandList &commandList, Frame &frame);
+    bool Resolve(Frame &frame);
+
+private:
+    std::vector<Frame> mFrames;            /** Frames in flight slots */
+    std::vector<uint32> mStack;            /** Open scopes of current frame (INVALID_QUERY if not timed) */
+    std::vector<ProfileEvent> mEvents;     /** Temporary events for submission */
+    std::vector<uint64> mOcclusionResults; /** Occlusion results of last resolved frame */
+    uint64 mFrameIndex = 0;                /** Index of current frame */
+    uint64 mResolvedFrameIndex = 0;        /** Index of last resolved frame */
+    uint64 mDroppedFrames = 0;             /** Frames dropped since not ready in time */
+    uint32 mCurrent = 0;                   /** Slot of current frame */
+};
+
+/**
+ * @class GpuProfileScope
+ * @brief Profiles gpu commands of the enclosing scope
+ */
+class GpuProfileScope final {
+public:
+    GpuProfileScope(GpuProfiler &profiler, RHICommandList &commandList, const char *name)
+        : mProfiler(profiler), mCommandList(commandList) {
+        mProfiler.BeginScope(mCommandList, name);
+    }
+
+    ~GpuProfileScope() {
+        mProfiler.EndScope(mCommandList);
+    }
+
+    GpuProfileScope(const GpuProfileScope &) = delete;
+    GpuProfileScope &operator=(const GpuProfileScope &) = delete;
+
+private:
+    GpuProfiler &mProfiler;
+    RHICommandList &mCommandList;
+};
+
+#ifdef BERSERK_WITH_PROFILER
+    /** Profile gpu commands of enclosing scope; name must have static storage (requires core/Engine.hpp) */
+    #define BRK_GPU_PROFILE_SCOPE(commandList, name) \
+        BRK_NS ::GpuProfileScope BRK_PROFILE_CONCAT(brkGpuProfileScope, __LINE__)(BRK_NS ::Engine::Instance().GetRenderEngine().GetGpuProfiler(), commandList, name)
+#else
+    #define BRK_GPU_PROFILE_SCOPE(commandList, name) \
+        do {                                         \
+        } while (false)
+#endif
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_GPUPROFILER_HPP
@@ -25,6 +25,7 @@
 /* SOFTWARE.                                                                      */
 /**********************************************************************************/
 
+#include <core/Engine.hpp>
 #include <render/RenderEngine.hpp>
 
 BRK_NS_BEGIN
@@ -37,16 +38,42 @@ ShaderManager &RenderEngine::GetShaderManager() const {
     return *mShaderManager;
 }
 
+RenderQueue &RenderEngine::GetRenderQueue() const {
+    return *mRenderQueue;
+}
+
+GpuProfiler &RenderEngine::GetGpuProfiler() const {
+    return *mGpuProfiler;
+}
+
 
 void RenderEngine::Init() {
     mMeshFormats = std::unique_ptr<MeshFormats>(new MeshFormats);
     mShaderManager = std::unique_ptr<ShaderManager>(new ShaderManager);
+    mRenderQueue = std::unique_ptr<RenderQueue>(new RenderQueue(&Engine::Instance().GetJobSystem()));
+
+    auto &config = Engine::Instance().GetConfig();
+    auto gpuLatency = config.GetProperty(StringName("render"), StringName("gpu.profiler.latency"), static_cast<uint32>(GpuProfiler::DEFAULT_LATENCY));
+    mGpuProfiler = std::unique_ptr<GpuProfiler>(new GpuProfiler(gpuLatency));
+
+    // Pre-load cooked shader variants, so materials creation does not pay compile cost
+    auto variantPack = config.GetProperty(StringName("render"), StringName("shader.pack"), String("shaders/variants.pack"));
+    if (!variantPack.empty())
+        mShaderManager->LoadVariantPack(variantPack);
 }
 
 void RenderEngine::PreUpdate() {
+    mRenderQueue->Clear();
 }
 
 void RenderEngine::PostUpdate() {
+    auto &rhit = Engine::Instance().GetRHIThread();
+
+    // Poll queries after frame commands are submitted
+    if (rhit.OnThread())
+        mGpuProfiler->NextFrame_RT();
+    else
+        rhit.EnqueueAfter([this]() { mGpuProfiler->NextFrame_RT(); });
 }
 
 BRK_NS_END
\ No newline at end of file
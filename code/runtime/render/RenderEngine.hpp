@@ -31,6 +31,8 @@
 #include <core/Config.hpp>
 #include <core/Typedefs.hpp>
 
+#include <render/GpuProfiler.hpp>
+#include <render/RenderQueue.hpp>
 #include <render/mesh/MeshFormats.hpp>
 #include <render/shader/ShaderManager.hpp>
 
@@ -58,6 +60,12 @@ public:
     /** @return Shader manager */
     BRK_API ShaderManager &GetShaderManager() const;
 
+    /** @return Render queue for sorted drawing (cleared each frame) */
+    BRK_API RenderQueue &GetRenderQueue() const;
+
+    /** @return Gpu profiler for scopes timing and occlusion queries (rhi thread only) */
+    BRK_API GpuProfiler &GetGpuProfiler() const;
+
 private:
     friend class Engine;
 
@@ -68,6 +76,8 @@ private:
 private:
     std::unique_ptr<MeshFormats> mMeshFormats;     /** Mesh formats manager */
     std::unique_ptr<ShaderManager> mShaderManager; /** Shader manager */
+    std::unique_ptr<RenderQueue> mRenderQueue;     /** Render queue for sorted drawing */
+    std::unique_ptr<GpuProfiler> mGpuProfiler;     /** Gpu queries with deferred read back */
 };
 
 /**
@@ -0,0 +1,436 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/Engine.hpp>
+#include <core/Memory.hpp>
+#include <core/io/Logger.hpp>
+#include <render/RenderQueue.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+BRK_NS_BEGIN
+
+/** Bits of the key fields (from most to least significant) */
+static const uint32 KEY_PASS_BITS = 4;
+static const uint32 KEY_LAYER_BITS = 4;
+static const uint32 KEY_PIPELINE_BITS = 12;
+static const uint32 KEY_MATERIAL_BITS = 12;
+static const uint32 KEY_MESH_BITS = 12;
+static const uint32 KEY_DEPTH_BITS = 20;
+
+/** Sort is split into chunks for parallel processing only if queue is large enough */
+static const uint32 SORT_PARALLEL_THRESHOLD = 8 * 1024;
+static const uint32 SORT_RADIX_BITS = 8;
+static const uint32 SORT_RADIX = 1u << SORT_RADIX_BITS;
+
+static inline uint64 KeyField(uint64 value, uint32 bits) {
+    return value & ((uint64(1) << bits) - 1);
+}
+
+static inline uint32 QuantizeDepth(float depth) {
+    // Bits of positive float are ordered in the same way as values
+    depth = std::max(depth, 0.0f);
+    uint32 bits;
+    Memory::Copy(&bits, &depth, sizeof(float));
+    return bits >> (32 - KEY_DEPTH_BITS);
+}
+
+RenderQueue::RenderQueue(JobSystem *jobSystem) : mJobSystem(jobSystem) {
+    mSortModes.fill(SortMode::FrontToBack);
+    mPassRuns.fill(std::make_pair(0u, 0u));
+}
+
+void RenderQueue::SetInstanceStride(uint32 stride) {
+    assert(mPackets.empty());
+    mInstanceStride = stride;
+}
+
+void RenderQueue::SetSortMode(uint32 pass, SortMode mode) {
+    assert(pass < MAX_PASSES);
+    mSortModes[pass] = mode;
+}
+
+void RenderQueue::SetFallback(Ref<RHIGraphicsPipeline> pipeline, Ref<RHIResourceSet> resourceSet) {
+    mFallbackPipeline = std::move(pipeline);
+    mFallbackResourceSet = std::move(resourceSet);
+}
+
+void RenderQueue::Submit(const RenderPacket &packet, const void *instanceData) {
+    assert(packet.pipeline.IsNotNull());
+    assert(packet.mesh.IsNotNull());
+    assert(packet.subMesh.IsNotNull());
+
+    if (packet.pass >= MAX_PASSES || packet.layer >= MAX_LAYERS) {
+        BRK_ERROR("Invalid packet pass=" << packet.pass << " layer=" << packet.layer);
+        return;
+    }
+
+    if (!IsCompiled(packet.pipeline)) {
+        mPendingPackets += 1;
+
+        if (mFallbackPipeline.IsNull() || !IsCompiled(mFallbackPipeline))
+            return;
+
+        RenderPacket fallback = packet;
+        fallback.pipeline = mFallbackPipeline;
+        fallback.resourceSet = mFallbackResourceSet;
+        Submit(fallback, instanceData);
+        return;
+    }
+
+    if (mInstanceStride > 0) {
+        auto offset = mInstanceData.size();
+        mInstanceData.resize(offset + mInstanceStride);
+
+        if (instanceData)
+            Memory::Copy(mInstanceData.data() + offset, instanceData, mInstanceStride);
+        else
+            Memory::Set(mInstanceData.data() + offset, 0x0, mInstanceStride);
+    }
+
+    mKeys.push_back(MakeKey(packet));
+    mPackets.push_back(packet);
+    mPrepared = false;
+}
+
+void RenderQueue::Submit(const std::vector<RenderPacket> &packets, const std::vector<uint32> &indices, const void *instanceData) {
+    auto data = reinterpret_cast<const uint8 *>(instanceData);
+
+    mPackets.reserve(mPackets.size() + indices.size());
+    mKeys.reserve(mKeys.size() + indices.size());
+
+    for (auto index : indices) {
+        assert(index < packets.size());
+        Submit(packets[index], data ? data + static_cast<size_t>(index) * mInstanceStride : nullptr);
+    }
+}
+
+void RenderQueue::Prepare(RHICommandList &commandList) {
+    auto count = GetPacketsCount();
+
+    mRuns.clear();
+    mPassRuns.fill(std::make_pair(0u, 0u));
+    mStats = Stats();
+    mStats.packets = count;
+    mStats.pendingPackets = mPendingPackets;
+
+    mSorted.resize(count);
+    for (uint32 i = 0; i < count; i++)
+        mSorted[i] = i;
+
+    SortKeys(mKeys, mSorted, count, mJobSystem);
+
+    // Collapse adjacent equal packets into instanced draws
+    uint32 first = 0;
+    while (first < count) {
+        auto &head = mPackets[mSorted[first]];
+        uint32 end = first + 1;
+
+        while (end < count && CanInstance(head, mPackets[mSorted[end]]))
+            end += 1;
+
+        DrawRun run{};
+        run.first = first;
+        run.count = end - first;
+        run.instanceBuffer = 0;
+
+        auto &passRuns = mPassRuns[head.pass];
+        if (passRuns.first == passRuns.second)
+            passRuns.first = static_cast<uint32>(mRuns.size());
+        passRuns.second = static_cast<uint32>(mRuns.size()) + 1;
+
+        mRuns.push_back(run);
+        first = end;
+    }
+
+    // Pack instance data of each run into separate buffer (no base instance in rhi)
+    if (mInstanceStride > 0) {
+        auto &device = Engine::Instance().GetRHIDevice();
+        uint32 bufferIndex = 0;
+
+        for (auto &run : mRuns) {
+            uint32 size = run.count * mInstanceStride;
+            auto data = Data::Make(size);
+            auto dst = reinterpret_cast<uint8 *>(data->GetDataWrite());
+
+            for (uint32 i = 0; i < run.count; i++) {
+                auto src = mInstanceData.data() + static_cast<size_t>(mSorted[run.first + i]) * mInstanceStride;
+                Memory::Copy(dst + i * mInstanceStride, src, mInstanceStride);
+            }
+
+            if (bufferIndex >= mInstanceBuffers.size())
+                mInstanceBuffers.emplace_back();
+
+            auto &buffer = mInstanceBuffers[bufferIndex];
+            if (buffer.IsNull() || buffer->GetSize() < size) {
+                RHIBufferDesc desc{};
+                desc.size = std::max(static_cast<uint32>(Memory::AlignSize(size, 256)), buffer.IsNull() ? 0u : buffer->GetSize() * 2);
+                desc.bufferUsage = RHIBufferUsage::Dynamic;
+                buffer = device.CreateVertexBuffer(desc);
+            }
+
+            commandList.UpdateVertexBuffer(buffer, 0, size, data);
+            run.instanceBuffer = bufferIndex;
+            bufferIndex += 1;
+        }
+    }
+
+    mPrepared = true;
+}
+
+void RenderQueue::Emit(RHICommandList &commandList, uint32 pass) {
+    assert(pass < MAX_PASSES);
+
+    if (!mPrepared) {
+        BRK_ERROR("Queue must be prepared before emit");
+        return;
+    }
+
+    const RHIGraphicsPipeline *currentPipeline = nullptr;
+    const RHIResourceSet *currentSet = nullptr;
+    const Mesh *currentMesh = nullptr;
+    const RHIIndexBuffer *currentIndices = nullptr;
+
+    auto runs = mPassRuns[pass];
+
+    for (uint32 i = runs.first; i < runs.second; i++) {
+        auto &run = mRuns[i];
+        auto &packet = mPackets[mSorted[run.first]];
+        auto &subMesh = *packet.subMesh;
+
+        // Pipeline bind resets all bound state
+        if (packet.pipeline.Get() != currentPipeline) {
+            commandList.BindGraphicsPipeline(packet.pipeline);
+            currentPipeline = packet.pipeline.Get();
+            currentSet = nullptr;
+            currentMesh = nullptr;
+            currentIndices = nullptr;
+            mStats.pipelineBinds += 1;
+        }
+
+        if (packet.resourceSet.IsNotNull() && packet.resourceSet.Get() != currentSet) {
+            commandList.BindResourceSet(packet.resourceSet, 0);
+            currentSet = packet.resourceSet.Get();
+            mStats.resourceSetBinds += 1;
+        }
+
+        // Instance data is unique per run, so must be rebound each time
+        if (packet.mesh.Get() != currentMesh || mInstanceStride > 0) {
+            auto &mesh = *packet.mesh;
+            mVertexBuffers.clear();
+            if (mesh.HasVertexData()) mVertexBuffers.push_back(mesh.GetVertexData());
+            if (mesh.HasAttributeData()) mVertexBuffers.push_back(mesh.GetAttributeData());
+            if (mesh.HasSkinningData()) mVertexBuffers.push_back(mesh.GetSkinningData());
+            if (mInstanceStride > 0) mVertexBuffers.push_back(mInstanceBuffers[run.instanceBuffer]);
+
+            commandList.BindVertexBuffers(mVertexBuffers);
+            currentMesh = packet.mesh.Get();
+            mStats.vertexBuffersBinds += 1;
+        }
+
+        if (subMesh.IsIndexed()) {
+            if (subMesh.GetIndexBuffer().Get() != currentIndices) {
+                commandList.BindIndexBuffer(subMesh.GetIndexBuffer(), subMesh.GetIndexType());
+                currentIndices = subMesh.GetIndexBuffer().Get();
+            }
+
+            commandList.DrawIndexed(subMesh.GetIndicesCount(), subMesh.GetBaseVertex(), run.count);
+        } else {
+            commandList.Draw(subMesh.GetVerticesCount(), subMesh.GetBaseVertex(), run.count);
+        }
+
+        mStats.drawCalls += 1;
+    }
+}
+
+void RenderQueue::Clear() {
+    mPendingPackets = 0;
+    mPackets.clear();
+    mInstanceData.clear();
+    mKeys.clear();
+    mSorted.clear();
+    mRuns.clear();
+    mPipelineIds.clear();
+    mMaterialIds.clear();
+    mMeshIds.clear();
+    mVertexBuffers.clear();
+    mPrepared = false;
+}
+
+void RenderQueue::SortKeys(std::vector<uint64> &keys, std::vector<uint32> &values, uint32 count, JobSystem *jobSystem) {
+    assert(keys.size() >= count);
+    assert(values.size() >= count);
+
+    if (count <= 1)
+        return;
+
+    uint32 chunks = 1;
+    if (jobSystem && count >= SORT_PARALLEL_THRESHOLD)
+        chunks = std::min(jobSystem->GetWorkersCount() + 1, count / (SORT_PARALLEL_THRESHOLD / 2));
+
+    uint32 chunkSize = (count + chunks - 1) / chunks;
+
+    std::vector<uint64> tmpKeys(count);
+    std::vector<uint32> tmpValues(count);
+    std::vector<uint32> histograms(chunks * SORT_RADIX);
+
+    uint64 *srcKeys = keys.data();
+    uint32 *srcValues = values.data();
+    uint64 *dstKeys = tmpKeys.data();
+    uint32 *dstValues = tmpValues.data();
+
+    auto forEachChunk = [&](const JobSystem::RangeFunc &func) {
+        if (chunks > 1)
+            jobSystem->ParallelFor(chunks, 1, func);
+        else
+            func(0, 1);
+    };
+
+    for (uint32 shift = 0; shift < 64; shift += SORT_RADIX_BITS) {
+        // Count digits of each chunk
+        forEachChunk([&](uint32 begin, uint32 end) {
+            for (uint32 c = begin; c < end; c++) {
+                uint32 *histogram = histograms.data() + c * SORT_RADIX;
+                std::fill(histogram, histogram + SORT_RADIX, 0u);
+
+                uint32 from = c * chunkSize;
+                uint32 to = std::min(from + chunkSize, count);
+                for (uint32 i = from; i < to; i++)
+                    histogram[(srcKeys[i] >> shift) & (SORT_RADIX - 1)] += 1;
+            }
+        });
+
+        // Skip pass if all keys have the same digit (common for high bits)
+        bool trivial = false;
+        for (uint32 d = 0; d < SORT_RADIX && !trivial; d++) {
+            uint32 total = 0;
+            for (uint32 c = 0; c < chunks; c++)
+                total += histograms[c * SORT_RADIX + d];
+            trivial = total == count;
+        }
+
+        if (trivial)
+            continue;
+
+        // Exclusive scan in (digit, chunk) order keeps sort stable
+        uint32 offset = 0;
+        for (uint32 d = 0; d < SORT_RADIX; d++) {
+            for (uint32 c = 0; c < chunks; c++) {
+                uint32 &entry = histograms[c * SORT_RADIX + d];
+                uint32 digitCount = entry;
+                entry = offset;
+                offset += digitCount;
+            }
+        }
+
+        forEachChunk([&](uint32 begin, uint32 end) {
+            for (uint32 c = begin; c < end; c++) {
+                uint32 *offsets = histograms.data() + c * SORT_RADIX;
+
+                uint32 from = c * chunkSize;
+                uint32 to = std::min(from + chunkSize, count);
+                for (uint32 i = from; i < to; i++) {
+                    uint32 dst = offsets[(srcKeys[i] >> shift) & (SORT_RADIX - 1)]++;
+                    dstKeys[dst] = srcKeys[i];
+                    dstValues[dst] = srcValues[i];
+                }
+            }
+        });
+
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcValues, dstValues);
+    }
+
+    if (srcKeys != keys.data()) {
+        Memory::Copy(keys.data(), srcKeys, sizeof(uint64) * count);
+        Memory::Copy(values.data(), srcValues, sizeof(uint32) * count);
+    }
+}
+
+uint64 RenderQueue::MakeKey(const RenderPacket &packet) {
+    return EncodeKey(packet.pass, packet.layer,
+                     GetId(mPipelineIds, packet.pipeline.Get()),
+                     GetId(mMaterialIds, packet.resourceSet.Get()),
+                     GetId(mMeshIds, packet.subMesh.Get()),
+                     packet.depth, mSortModes[packet.pass]);
+}
+
+uint64 RenderQueue::EncodeKey(uint32 pass, uint32 layer, uint32 pipeline, uint32 material, uint32 mesh, float depth, SortMode mode) {
+    uint64 passField = KeyField(pass, KEY_PASS_BITS);
+    uint64 layerField = KeyField(layer, KEY_LAYER_BITS);
+    uint64 pipelineField = KeyField(pipeline, KEY_PIPELINE_BITS);
+    uint64 materialField = KeyField(material, KEY_MATERIAL_BITS);
+    uint64 meshField = KeyField(mesh, KEY_MESH_BITS);
+    uint64 depthField = QuantizeDepth(depth);
+
+    uint64 key = 0;
+    key = (key << KEY_PASS_BITS) | passField;
+    key = (key << KEY_LAYER_BITS) | layerField;
+
+    if (mode == SortMode::BackToFront) {
+        depthField = KeyField(~depthField, KEY_DEPTH_BITS);
+        key = (key << KEY_DEPTH_BITS) | depthField;
+        key = (key << KEY_PIPELINE_BITS) | pipelineField;
+        key = (key << KEY_MATERIAL_BITS) | materialField;
+        key = (key << KEY_MESH_BITS) | meshField;
+    } else {
+        key = (key << KEY_PIPELINE_BITS) | pipelineField;
+        key = (key << KEY_MATERIAL_BITS) | materialField;
+        key = (key << KEY_MESH_BITS) | meshField;
+        key = (key << KEY_DEPTH_BITS) | depthField;
+    }
+
+    return key;
+}
+
+uint32 RenderQueue::GetId(std::unordered_map<const void *, uint32> &ids, const void *object) {
+    auto query = ids.find(object);
+
+    if (query != ids.end())
+        return query->second;
+
+    auto id = static_cast<uint32>(ids.size());
+    ids.emplace(object, id);
+    return id;
+}
+
+bool RenderQueue::CanInstance(const RenderPacket &a, const RenderPacket &b) {
+    // Ids in keys may wrap around, so compare actual objects
+    return a.pass == b.pass &&
+           a.pipeline == b.pipeline &&
+           a.resourceSet == b.resourceSet &&
+           a.mesh == b.mesh &&
+           a.subMesh == b.subMesh;
+}
+
+bool RenderQueue::IsCompiled(const Ref<RHIGraphicsPipeline> &pipeline) {
+    const auto &shader = pipeline->GetDesc().shader;
+    return shader.IsNotNull() && shader->GetCompilationStatus() == RHIShader::Status::Compiled;
+}
+
+BRK_NS_END
@@ -0,0 +1,235 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_RENDERQUEUE_HPP
+#define BERSERK_RENDERQUEUE_HPP
+
+#include <core/Config.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+
+#include <render/mesh/Mesh.hpp>
+
+#include <rhi/RHIBuffer.hpp>
+#include <rhi/RHICommandList.hpp>
+#include <rhi/RHIGraphicsPipeline.hpp>
+#include <rhi/RHIResourceSet.hpp>
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup render
+ * @{
+ */
+
+/**
+ * @class RenderPacket
+ * @brief Single draw request submitted to the render queue
+ */
+struct RenderPacket {
+    Ref<RHIGraphicsPipeline> pipeline; /** Pipeline to draw with */
+    Ref<RHIResourceSet> resourceSet;   /** Material params set of the pass (bound to set 0) */
+    Ref<Mesh> mesh;                    /** Mesh with vertex data */
+    Ref<SubMesh> subMesh;              /** Sub-mesh of the mesh to draw */
+    uint32 pass = 0;                   /** Pass index in [0, MAX_PASSES) */
+    uint32 layer = 0;                  /** Layer inside pass in [0, MAX_LAYERS) */
+    float depth = 0.0f;                /** Positive view-space distance to the camera */
+};
+
+/**
+ * @class RenderQueue
+ * @brief Collects draw packets and emits sorted state-minimal draw calls
+ *
+ * Each submitted packet is encoded into 64-bit sort key (pass, layer, pipeline,
+ * material, mesh, depth). Keys are radix-sorted (in parallel for large queues),
+ * so that draws of the same pipeline and material go one by one. Adjacent packets
+ * with identical pipeline, material and sub-mesh collapse into single instanced
+ * draw call. Optional per-instance data of these packets is packed into instance
+ * vertex buffer, which is bound right after the mesh vertex buffers.
+ *
+ * Usage per frame:
+ *  - Submit packets (game thread)
+ *  - Call Prepare outside of render pass (sorts and uploads instance data)
+ *  - Call Emit for each pass inside matching render pass
+ *
+ * @note Queue is cleared by the render engine in the beginning of each frame.
+ */
+class RenderQueue final {
+public:
+    /** How packets with equal pass and layer are ordered */
+    enum class SortMode : uint8 {
+        /** Minimize state changes, then front to back (opaque geometry) */
+        FrontToBack,
+        /** Strictly back to front, then by state (translucent geometry) */
+        BackToFront
+    };
+
+    /** Draw statistics of the last emitted queue */
+    struct Stats {
+        uint32 packets = 0;
+        uint32 drawCalls = 0;
+        uint32 pipelineBinds = 0;
+        uint32 resourceSetBinds = 0;
+        uint32 vertexBuffersBinds = 0;
+        uint32 pendingPackets = 0;
+    };
+
+    static const uint32 MAX_PASSES = 16;
+    static const uint32 MAX_LAYERS = 16;
+
+    /** @param jobSystem Optional job system for parallel sorting */
+    BRK_API explicit RenderQueue(JobSystem *jobSystem = nullptr);
+    BRK_API ~RenderQueue() = default;
+
+    /** Set size in bytes of per-instance data of packets; must be called on empty queue */
+    BRK_API void SetInstanceStride(uint32 stride);
+    /** Set sort mode of packets of the pass */
+    BRK_API void SetSortMode(uint32 pass, SortMode mode);
+
+    /**
+     * @brief Set pipeline to draw packets which shaders are not compiled yet
+     *
+     * Shaders are compiled asynchronously, so packets may be submitted before
+     * its pipeline is ready. Such packets are drawn with fallback pipeline and
+     * resource set, or skipped if no fallback is set.
+     *
+     * @note Fallback pipeline must accept vertex layout of the meshes of the packets.
+     *
+     * @param pipeline Fallback pipeline (null to skip pending packets)
+     * @param resourceSet Params set of the fallback pipeline
+     */
+    BRK_API void SetFallback(Ref<RHIGraphicsPipeline> pipeline, Ref<RHIResourceSet> resourceSet);
+
+    /**
+     * @brief Submit packet for drawing
+     *
+     * @param packet Packet to draw
+     * @param instanceData Per-instance data of `instance stride` size (may be null if stride is 0)
+     */
+    BRK_API void Submit(const RenderPacket &packet, const void *instanceData = nullptr);
+
+    /**
+     * @brief Submit subset of packets (for instance, visible ids returned by culling)
+     *
+     * @param packets Array of packets
+     * @param indices Indices of packets to submit
+     * @param instanceData Array of per-instance data of packets (may be null if stride is 0)
+     */
+    BRK_API void Submit(const std::vector<RenderPacket> &packets, const std::vector<uint32> &indices, const void *instanceData = nullptr);
+
+    /** Sort packets, build instanced draws and upload instance data (outside render pass) */
+    BRK_API void Prepare(RHICommandList &commandList);
+
+    /** Emit draw calls of the pass into command list (inside render pass) */
+    BRK_API void Emit(RHICommandList &commandList, uint32 pass);
+
+    /** Remove all packets from the queue */
+    BRK_API void Clear();
+
+    /** @return Number of submitted packets */
+    BRK_API uint32 GetPacketsCount() const { return static_cast<uint32>(mPackets.size()); }
+    /** @return Size in bytes of per-instance data */
+    BRK_API uint32 GetInstanceStride() const { return mInstanceStride; }
+    /** @return Statistics of emitted draws */
+    BRK_API const Stats &GetStats() const { return mStats; }
+
+    /**
+     * @brief Sort keys in ascending order (stable LSD radix sort)
+     *
+     * @param keys Keys to sort
+     * @param values Values to permute along keys
+     * @param count Number of keys
+     * @param jobSystem Optional job system to sort in parallel
+     */
+    BRK_API static void SortKeys(std::vector<uint64> &keys, std::vector<uint32> &values, uint32 count, JobSystem *jobSystem);
+
+    /**
+     * @brief Encode sort key of the packet
+     *
+     * @param pass Pass index
+     * @param layer Layer inside pass
+     * @param pipeline Dense id of the pipeline
+     * @param material Dense id of the material (resource set)
+     * @param mesh Dense id of the sub-mesh
+     * @param depth Positive view-space distance to the camera
+     * @param mode Sort mode of the pass
+     *
+     * @return Key ordered by pass, layer, then state and depth as defined by mode
+     */
+    BRK_API static uint64 EncodeKey(uint32 pass, uint32 layer, uint32 pipeline, uint32 material, uint32 mesh, float depth, SortMode mode);
+
+private:
+    /** Contiguous run of sorted packets drawn by single (instanced) draw call */
+    struct DrawRun {
+        uint32 first;
+        uint32 count;
+        uint32 instanceBuffer;
+    };
+
+    uint64 MakeKey(const RenderPacket &packet);
+    static uint32 GetId(std::unordered_map<const void *, uint32> &ids, const void *object);
+    static bool CanInstance(const RenderPacket &a, const RenderPacket &b);
+    static bool IsCompiled(const Ref<RHIGraphicsPipeline> &pipeline);
+
+private:
+    std::vector<RenderPacket> mPackets; /** Submitted packets */
+    std::vector<uint8> mInstanceData;   /** Per-instance data of packets in submit order */
+    std::vector<uint64> mKeys;          /** Sort keys of packets */
+    std::vector<uint32> mSorted;        /** Packets indices in sorted order */
+
+    std::vector<DrawRun> mRuns;                                 /** Draw calls in sorted order */
+    std::array<std::pair<uint32, uint32>, MAX_PASSES> mPassRuns; /** Range of runs for each pass */
+    std::array<SortMode, MAX_PASSES> mSortModes;                /** Sort mode of each pass */
+
+    std::unordered_map<const void *, uint32> mPipelineIds; /** Dense ids of pipelines for keys */
+    std::unordered_map<const void *, uint32> mMaterialIds; /** Dense ids of materials for keys */
+    std::unordered_map<const void *, uint32> mMeshIds;     /** Dense ids of sub-meshes for keys */
+
+    std::vector<Ref<RHIVertexBuffer>> mInstanceBuffers; /** Pool of instance data buffers */
+    std::vector<Ref<RHIVertexBuffer>> mVertexBuffers;   /** Tmp list for binding */
+
+    Ref<RHIGraphicsPipeline> mFallbackPipeline; /** Pipeline for packets with pending shaders */
+    Ref<RHIResourceSet> mFallbackResourceSet;   /** Params of fallback pipeline */
+
+    JobSystem *mJobSystem = nullptr;
+    uint32 mInstanceStride = 0;
+    uint32 mPendingPackets = 0;
+    bool mPrepared = false;
+    Stats mStats;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_RENDERQUEUE_HPP
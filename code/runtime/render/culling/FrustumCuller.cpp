@@ -0,0 +1,273 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/math/Simd.hpp>
+#include <render/culling/FrustumCuller.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+BRK_NS_BEGIN
+
+/** Objects are stored in blocks of max simd width, so kernels have no tails */
+static const uint32 BLOCK_SIZE = 8;
+
+/** Extent of removed objects; box is always outside of any plane */
+static const float REMOVED_EXTENT = -std::numeric_limits<float>::max();
+
+FrustumCuller::FrustumCuller(JobSystem *jobSystem) : mJobSystem(jobSystem) {
+    static_assert(CHUNK_SIZE % BLOCK_SIZE == 0, "Chunk must consist of blocks");
+}
+
+uint32 FrustumCuller::Add(const Aabbf &aabb) {
+    uint32 id;
+
+    if (!mFreeIds.empty()) {
+        id = mFreeIds.back();
+        mFreeIds.pop_back();
+    } else {
+        id = mCount++;
+
+        if (id >= mCenterX.size()) {
+            auto size = mCenterX.size() + BLOCK_SIZE;
+            mCenterX.resize(size, 0.0f);
+            mCenterY.resize(size, 0.0f);
+            mCenterZ.resize(size, 0.0f);
+            mExtentX.resize(size, REMOVED_EXTENT);
+            mExtentY.resize(size, REMOVED_EXTENT);
+            mExtentZ.resize(size, REMOVED_EXTENT);
+        }
+    }
+
+    SetBounds(id, aabb);
+    return id;
+}
+
+void FrustumCuller::Update(uint32 id, const Aabbf &aabb) {
+    assert(id < mCount);
+    SetBounds(id, aabb);
+}
+
+void FrustumCuller::Remove(uint32 id) {
+    assert(id < mCount);
+    SetRemoved(id);
+    mFreeIds.push_back(id);
+}
+
+void FrustumCuller::Clear() {
+    mCenterX.clear();
+    mCenterY.clear();
+    mCenterZ.clear();
+    mExtentX.clear();
+    mExtentY.clear();
+    mExtentZ.clear();
+    mFreeIds.clear();
+    mCount = 0;
+}
+
+void FrustumCuller::Cull(const Frustumf &frustum, std::vector<uint32> &visible) {
+    visible.clear();
+
+    auto size = static_cast<uint32>(mCenterX.size());
+    auto chunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    if (chunks <= 1 || !mJobSystem) {
+        CullRange(frustum, 0, size, visible);
+        return;
+    }
+
+    if (mChunksVisible.size() < chunks)
+        mChunksVisible.resize(chunks);
+
+    mJobSystem->ParallelFor(chunks, 1, [&](uint32 begin, uint32 end) {
+        for (uint32 c = begin; c < end; c++) {
+            auto &chunkVisible = mChunksVisible[c];
+            chunkVisible.clear();
+            CullRange(frustum, c * CHUNK_SIZE, std::min(size, (c + 1) * CHUNK_SIZE), chunkVisible);
+        }
+    });
+
+    size_t total = 0;
+    for (uint32 c = 0; c < chunks; c++)
+        total += mChunksVisible[c].size();
+
+    visible.reserve(total);
+    for (uint32 c = 0; c < chunks; c++)
+        visible.insert(visible.end(), mChunksVisible[c].begin(), mChunksVisible[c].end());
+}
+
+void FrustumCuller::SetBounds(uint32 id, const Aabbf &aabb) {
+    auto c = aabb.GetCenter();
+    auto e = aabb.GetExtent();
+
+    mCenterX[id] = c[0];
+    mCenterY[id] = c[1];
+    mCenterZ[id] = c[2];
+    mExtentX[id] = e[0];
+    mExtentY[id] = e[1];
+    mExtentZ[id] = e[2];
+}
+
+void FrustumCuller::SetRemoved(uint32 id) {
+    mCenterX[id] = 0.0f;
+    mCenterY[id] = 0.0f;
+    mCenterZ[id] = 0.0f;
+    mExtentX[id] = REMOVED_EXTENT;
+    mExtentY[id] = REMOVED_EXTENT;
+    mExtentZ[id] = REMOVED_EXTENT;
+}
+
+void FrustumCuller::CullRange(const Frustumf &frustum, uint32 begin, uint32 end, std::vector<uint32> &visible) const {
+    assert(begin % BLOCK_SIZE == 0);
+    assert(end % BLOCK_SIZE == 0);
+
+    const float *cx = mCenterX.data();
+    const float *cy = mCenterY.data();
+    const float *cz = mCenterZ.data();
+    const float *ex = mExtentX.data();
+    const float *ey = mExtentY.data();
+    const float *ez = mExtentZ.data();
+
+    // Box is outside if for some plane: dot(n, c) + d + dot(|n|, e) < 0
+    float planes[Frustumf::PlanesCount][7];
+    for (uint32 p = 0; p < Frustumf::PlanesCount; p++) {
+        auto &plane = frustum.GetPlane(p);
+        planes[p][0] = plane[0];
+        planes[p][1] = plane[1];
+        planes[p][2] = plane[2];
+        planes[p][3] = plane[3];
+        planes[p][4] = MathUtils::Abs(plane[0]);
+        planes[p][5] = MathUtils::Abs(plane[1]);
+        planes[p][6] = MathUtils::Abs(plane[2]);
+    }
+
+#if defined(BRK_SIMD_AVX2)
+    __m256 pv[Frustumf::PlanesCount][7];
+    for (uint32 p = 0; p < Frustumf::PlanesCount; p++)
+        for (uint32 k = 0; k < 7; k++)
+            pv[p][k] = _mm256_set1_ps(planes[p][k]);
+
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (uint32 i = begin; i < end; i += 8) {
+        __m256 x = _mm256_loadu_ps(cx + i);
+        __m256 y = _mm256_loadu_ps(cy + i);
+        __m256 z = _mm256_loadu_ps(cz + i);
+        __m256 rx = _mm256_loadu_ps(ex + i);
+        __m256 ry = _mm256_loadu_ps(ey + i);
+        __m256 rz = _mm256_loadu_ps(ez + i);
+        __m256 outside = zero;
+
+        for (uint32 p = 0; p < Frustumf::PlanesCount; p++) {
+            __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pv[p][0], x), _mm256_mul_ps(pv[p][1], y)), _mm256_add_ps(_mm256_mul_ps(pv[p][2], z), pv[p][3]));
+            __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pv[p][4], rx), _mm256_mul_ps(pv[p][5], ry)), _mm256_mul_ps(pv[p][6], rz));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), zero, _CMP_LT_OQ));
+        }
+
+        auto mask = static_cast<uint32>(~_mm256_movemask_ps(outside)) & 0xffu;
+        for (uint32 lane = 0; lane < 8; lane++) {
+            if (mask & (1u << lane))
+                visible.push_back(i + lane);
+        }
+    }
+#elif defined(BRK_SIMD_SSE)
+    __m128 pv[Frustumf::PlanesCount][7];
+    for (uint32 p = 0; p < Frustumf::PlanesCount; p++)
+        for (uint32 k = 0; k < 7; k++)
+            pv[p][k] = _mm_set1_ps(planes[p][k]);
+
+    const __m128 zero = _mm_setzero_ps();
+
+    for (uint32 i = begin; i < end; i += 4) {
+        __m128 x = _mm_loadu_ps(cx + i);
+        __m128 y = _mm_loadu_ps(cy + i);
+        __m128 z = _mm_loadu_ps(cz + i);
+        __m128 rx = _mm_loadu_ps(ex + i);
+        __m128 ry = _mm_loadu_ps(ey + i);
+        __m128 rz = _mm_loadu_ps(ez + i);
+        __m128 outside = zero;
+
+        for (uint32 p = 0; p < Frustumf::PlanesCount; p++) {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pv[p][0], x), _mm_mul_ps(pv[p][1], y)), _mm_add_ps(_mm_mul_ps(pv[p][2], z), pv[p][3]));
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pv[p][4], rx), _mm_mul_ps(pv[p][5], ry)), _mm_mul_ps(pv[p][6], rz));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), zero));
+        }
+
+        auto mask = static_cast<uint32>(~_mm_movemask_ps(outside)) & 0xfu;
+        for (uint32 lane = 0; lane < 4; lane++) {
+            if (mask & (1u << lane))
+                visible.push_back(i + lane);
+        }
+    }
+#elif defined(BRK_SIMD_NEON)
+    float32x4_t pv[Frustumf::PlanesCount][7];
+    for (uint32 p = 0; p < Frustumf::PlanesCount; p++)
+        for (uint32 k = 0; k < 7; k++)
+            pv[p][k] = vdupq_n_f32(planes[p][k]);
+
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    for (uint32 i = begin; i < end; i += 4) {
+        float32x4_t x = vld1q_f32(cx + i);
+        float32x4_t y = vld1q_f32(cy + i);
+        float32x4_t z = vld1q_f32(cz + i);
+        float32x4_t rx = vld1q_f32(ex + i);
+        float32x4_t ry = vld1q_f32(ey + i);
+        float32x4_t rz = vld1q_f32(ez + i);
+        uint32x4_t outside = vdupq_n_u32(0);
+
+        for (uint32 p = 0; p < Frustumf::PlanesCount; p++) {
+            float32x4_t d = vmlaq_f32(vmlaq_f32(vmlaq_f32(pv[p][3], pv[p][0], x), pv[p][1], y), pv[p][2], z);
+            float32x4_t r = vmlaq_f32(vmlaq_f32(vmulq_f32(pv[p][4], rx), pv[p][5], ry), pv[p][6], rz);
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(d, r), zero));
+        }
+
+        uint32 lanes[4];
+        vst1q_u32(lanes, outside);
+        for (uint32 lane = 0; lane < 4; lane++) {
+            if (!lanes[lane])
+                visible.push_back(i + lane);
+        }
+    }
+#else
+    for (uint32 i = begin; i < end; i++) {
+        bool inside = true;
+
+        for (uint32 p = 0; p < Frustumf::PlanesCount && inside; p++) {
+            float d = planes[p][0] * cx[i] + planes[p][1] * cy[i] + planes[p][2] * cz[i] + planes[p][3];
+            float r = planes[p][4] * ex[i] + planes[p][5] * ey[i] + planes[p][6] * ez[i];
+            inside = d + r >= 0.0f;
+        }
+
+        if (inside)
+            visible.push_back(i);
+    }
+#endif
+}
+
+BRK_NS_END
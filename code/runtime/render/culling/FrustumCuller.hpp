@@ -0,0 +1,114 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_FRUSTUMCULLER_HPP
+#define BERSERK_FRUSTUMCULLER_HPP
+
+#include <core/Config.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+#include <core/math/Frustumf.hpp>
+#include <core/math/TAabb.hpp>
+
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup render
+ * @{
+ */
+
+/**
+ * @class FrustumCuller
+ * @brief Culls large sets of object bounds against view frustum
+ *
+ * Bounds are stored as SoA arrays of box centers and extents, so
+ * boxes are tested against frustum planes 8 (AVX2) or 4 (SSE/NEON)
+ * at once. Large sets are split into chunks processed on job system
+ * workers. Result is list of visible object ids in ascending order,
+ * which can be passed directly to the render queue.
+ *
+ * Object ids are stable until object is removed; ids of removed
+ * objects are reused by subsequent Add calls.
+ */
+class FrustumCuller final {
+public:
+    /** Number of objects in a single job; multiple of simd width */
+    static const uint32 CHUNK_SIZE = 4 * 1024;
+
+    /** @param jobSystem Optional job system for parallel culling */
+    BRK_API explicit FrustumCuller(JobSystem *jobSystem = nullptr);
+    BRK_API ~FrustumCuller() = default;
+
+    /** Add object bounds; @return Object id */
+    BRK_API uint32 Add(const Aabbf &aabb);
+    /** Update bounds of the object */
+    BRK_API void Update(uint32 id, const Aabbf &aabb);
+    /** Remove object (never reported as visible) */
+    BRK_API void Remove(uint32 id);
+    /** Remove all objects */
+    BRK_API void Clear();
+
+    /**
+     * @brief Cull objects against frustum
+     *
+     * @param frustum View frustum to test
+     * @param[out] visible Ids of objects in or intersecting frustum (ascending)
+     */
+    BRK_API void Cull(const Frustumf &frustum, std::vector<uint32> &visible);
+
+    /** @return Number of ids in use (including removed) */
+    BRK_API uint32 GetObjectsCount() const { return mCount; }
+
+private:
+    void SetBounds(uint32 id, const Aabbf &aabb);
+    void SetRemoved(uint32 id);
+    void CullRange(const Frustumf &frustum, uint32 begin, uint32 end, std::vector<uint32> &visible) const;
+
+private:
+    /** SoA bounds, size is rounded up to simd width */
+    std::vector<float> mCenterX;
+    std::vector<float> mCenterY;
+    std::vector<float> mCenterZ;
+    std::vector<float> mExtentX;
+    std::vector<float> mExtentY;
+    std::vector<float> mExtentZ;
+
+    std::vector<uint32> mFreeIds;                    /** Ids of removed objects for reuse */
+    std::vector<std::vector<uint32>> mChunksVisible; /** Per-chunk results */
+    JobSystem *mJobSystem = nullptr;
+    uint32 mCount = 0;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_FRUSTUMCULLER_HPP
@@ -41,11 +41,11 @@ Material::Material(Ref<const Shader> shader) {
     }
 
     mShader = std::move(shader);
-    mTechnique = mShader->FindFirstTechnique(ShaderTechniqueTags{}, true);
+    mTechnique = mShader->FindFirstTechnique(ShaderTechniqueTags{}, false);
     assert(mTechnique.IsNotNull());
 
     if (mTechnique.IsNull()) {
-        BRK_ERROR("Cannot find compiled technique for shader=" << mShader->GetName());
+        BRK_ERROR("Cannot find technique for shader=" << mShader->GetName());
         return;
     }
 
@@ -55,9 +55,30 @@ Material::Material(Ref<const Shader> shader) {
     mSamplers.resize(shaderParams->GetTexturesCount());
     mTextures.resize(shaderParams->GetTexturesCount());
     mDataParams = shaderParams->GetDefaultDataValues();
+    mDirtyFlags.resize(shaderParams->GetParams().size(), false);
     assert(mDataParams.size() == shaderParams->GetDataSize());
 
-    mPackedParams = Ref<MaterialParams>(new MaterialParams(*this));
+    // Programs of the technique may still compile, then params are packed later
+    if (mTechnique->IsCompiled()) {
+        mPackedParams = Ref<MaterialParams>(new MaterialParams(*this));
+        mIsDirty = false;
+    }
+}
+
+Ref<Material> Material::Clone() const {
+    Ref<Material> material(new Material());
+    material->mName = mName;
+    material->mDescription = mDescription;
+    material->mShader = mShader;
+    material->mTechnique = mTechnique;
+    material->mSamplers = mSamplers;
+    material->mTextures = mTextures;
+    material->mDataParams = mDataParams;
+    material->mDirtyFlags.resize(mDirtyFlags.size(), false);
+    material->mRevision = mRevision;
+
+    // Params are packed on first update
+    return material;
 }
 
 void Material::SetName(StringName name) {
@@ -70,25 +91,15 @@ void Material::SetDescription(String description) {
 
 void Material::SetTexture(const StringName &name, Ref<RHITexture> texture, Ref<RHISampler> sampler, uint32 arrayIndex) {
     assert(mShader.IsNotNull());
-    assert(texture.IsNotNull());
-    assert(sampler.IsNotNull());
 
-    const auto &params = mShader->GetParams();
-    auto *param = params->GetParamLight(name);
+    auto handle = GetParamHandle(name);
 
-    if (!param || param->type != ShaderParamType::Texture) {
+    if (!handle.IsValid() || handle.GetType() != ShaderParamType::Texture) {
         BRK_ERROR("No such texture param to set param=" << name);
         return;
     }
-    if (arrayIndex >= param->arraySize) {
-        BRK_ERROR("Array index of param=" << name << " out of bounds (size=" << param->arraySize << " index=" << arrayIndex << ")");
-        return;
-    }
 
-    const auto &paramInfo = params->GetTextureParamsInfo()[param->info];
-    mSamplers[paramInfo.offset + arrayIndex] = std::move(sampler);
-    mTextures[paramInfo.offset + arrayIndex] = std::move(texture);
-    mIsDirty = true;
+    SetTexture(handle, std::move(texture), std::move(sampler), arrayIndex);
 }
 
 void Material::SetFloat1(const StringName &name, float value, uint32 arrayIndex) {
@@ -167,34 +178,211 @@ void Material::SetMat4(const StringName &name, const Mat4x4f &value, uint32 arra
     SetDataParam(name, RHIShaderDataType::Mat4, &value, arrayIndex);
 }
 
+MaterialParamHandle Material::GetParamHandle(const StringName &name) const {
+    assert(mShader.IsNotNull());
+
+    MaterialParamHandle handle;
+    const auto &params = mShader->GetParams();
+    auto id = params->GetParamId(name);
+
+    if (id == ShaderParams::INVALID_ID)
+        return handle;
+
+    const auto &param = params->GetParamLight(id);
+
+    handle.mParams = params.Get();
+    handle.mId = id;
+    handle.mArraySize = param.arraySize;
+    handle.mType = param.type;
+    handle.mTypeData = param.typeData;
+
+    if (param.type == ShaderParamType::Texture) {
+        handle.mOffset = params->GetTextureParamsInfo()[param.info].offset;
+    } else if (param.type == ShaderParamType::Data) {
+        handle.mOffset = params->GetDataParamsInfo()[param.info].offset;
+        handle.mSize = params->GetDataParamsInfo()[param.info].size;
+    }
+
+    return handle;
+}
+
+void Material::SetTexture(const MaterialParamHandle &handle, Ref<RHITexture> texture, Ref<RHISampler> sampler, uint32 arrayIndex) {
+    assert(texture.IsNotNull());
+    assert(sampler.IsNotNull());
+
+    if (!CheckHandle(handle, ShaderParamType::Texture, arrayIndex))
+        return;
+
+    mSamplers[handle.mOffset + arrayIndex] = std::move(sampler);
+    mTextures[handle.mOffset + arrayIndex] = std::move(texture);
+    mTexturesDirty = true;
+    mIsDirty = true;
+    mRevision += 1;
+}
+
+void Material::SetFloat1(const MaterialParamHandle &handle, float value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Float1, &value, arrayIndex);
+}
+
+void Material::SetFloat2(const MaterialParamHandle &handle, const Vec2f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Float2, &value, arrayIndex);
+}
+
+void Material::SetFloat3(const MaterialParamHandle &handle, const Vec3f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Float3, &value, arrayIndex);
+}
+
+void Material::SetFloat4(const MaterialParamHandle &handle, const Vec4f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Float4, &value, arrayIndex);
+}
+
+void Material::SetInt1(const MaterialParamHandle &handle, int32 value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Int1, &value, arrayIndex);
+}
+
+void Material::SetInt2(const MaterialParamHandle &handle, const Vec2i &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Int2, &value, arrayIndex);
+}
+
+void Material::SetInt3(const MaterialParamHandle &handle, const Vec3i &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Int3, &value, arrayIndex);
+}
+
+void Material::SetInt4(const MaterialParamHandle &handle, const Vec4i &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Int4, &value, arrayIndex);
+}
+
+void Material::SetUInt1(const MaterialParamHandle &handle, uint32 value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Uint1, &value, arrayIndex);
+}
+
+void Material::SetUInt2(const MaterialParamHandle &handle, const Vec2u &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Uint2, &value, arrayIndex);
+}
+
+void Material::SetUInt3(const MaterialParamHandle &handle, const Vec3u &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Uint3, &value, arrayIndex);
+}
+
+void Material::SetUInt4(const MaterialParamHandle &handle, const Vec4u &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Uint4, &value, arrayIndex);
+}
+
+void Material::SetBool1(const MaterialParamHandle &handle, bool value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Bool1, &value, arrayIndex);
+}
+
+void Material::SetBool2(const MaterialParamHandle &handle, const Vec2b &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Bool2, &value, arrayIndex);
+}
+
+void Material::SetBool3(const MaterialParamHandle &handle, const Vec3b &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Bool3, &value, arrayIndex);
+}
+
+void Material::SetBool4(const MaterialParamHandle &handle, const Vec4b &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Bool4, &value, arrayIndex);
+}
+
+void Material::SetMat2(const MaterialParamHandle &handle, const Mat2x2f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Mat2, &value, arrayIndex);
+}
+
+void Material::SetMat3(const MaterialParamHandle &handle, const Mat3x3f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Mat3, &value, arrayIndex);
+}
+
+void Material::SetMat4(const MaterialParamHandle &handle, const Mat4x4f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Mat4, &value, arrayIndex);
+}
+
 void Material::UpdatePack() {
+    if (mPackedParams.IsNull()) {
+        if (mTechnique.IsNull() || !mTechnique->IsCompiled())
+            return;
+
+        mPackedParams = Ref<MaterialParams>(new MaterialParams(*this));
+        ClearDirty();
+        return;
+    }
+
     if (mIsDirty) {
         mPackedParams->Update(*this);
-        mIsDirty = false;
+        ClearDirty();
     }
 }
 
+const void *Material::GetParamData(const MaterialParamHandle &handle, uint32 arrayIndex) const {
+    if (!CheckHandle(handle, ShaderParamType::Data, arrayIndex))
+        return nullptr;
+
+    return mDataParams.data() + handle.mOffset + handle.mSize * arrayIndex;
+}
+
+bool Material::IsReady() const {
+    return mPackedParams.IsNotNull();
+}
+
 void Material::SetDataParam(const StringName &name, RHIShaderDataType type, const void *data, uint32 arrayIndex) {
     assert(mShader.IsNotNull());
-    const auto &params = mShader->GetParams();
-    auto *param = params->GetParamLight(name);
 
-    if (!param || param->type != ShaderParamType::Data) {
+    auto handle = GetParamHandle(name);
+
+    if (!handle.IsValid() || handle.GetType() != ShaderParamType::Data) {
         BRK_ERROR("No such data param to set param=" << name);
         return;
     }
-    if (param->typeData != type) {
-        BRK_ERROR("Param has another type=" << static_cast<uint32>(param->typeData) << " passed=" << static_cast<uint32>(type));
+
+    SetDataParam(handle, type, data, arrayIndex);
+}
+
+void Material::SetDataParam(const MaterialParamHandle &handle, RHIShaderDataType type, const void *data, uint32 arrayIndex) {
+    if (!CheckHandle(handle, ShaderParamType::Data, arrayIndex))
         return;
-    }
-    if (arrayIndex >= param->arraySize) {
-        BRK_ERROR("Array index of param=" << name << " out of bounds (size=" << param->arraySize << " index=" << arrayIndex << ")");
+
+    if (handle.mTypeData != type) {
+        BRK_ERROR("Param has another type=" << static_cast<uint32>(handle.mTypeData) << " passed=" << static_cast<uint32>(type));
         return;
     }
 
-    const auto &paramInfo = params->GetDataParamsInfo()[param->info];
-    Memory::Copy(mDataParams.data() + paramInfo.offset + paramInfo.size * arrayIndex, data, paramInfo.size);
+    Memory::Copy(mDataParams.data() + handle.mOffset + handle.mSize * arrayIndex, data, handle.mSize);
+    MarkDirty(handle.mId);
+}
+
+bool Material::CheckHandle(const MaterialParamHandle &handle, ShaderParamType type, uint32 arrayIndex) const {
+    assert(mShader.IsNotNull());
+    assert(!handle.IsValid() || handle.mParams == mShader->GetParams().Get());
+
+    if (!handle.IsValid() || handle.mType != type) {
+        BRK_ERROR("Invalid param handle id=" << handle.mId);
+        return false;
+    }
+    if (arrayIndex >= handle.mArraySize) {
+        const auto &name = mShader->GetParams()->GetParam(handle.mId).name;
+        BRK_ERROR("Array index of param=" << name << " out of bounds (size=" << handle.mArraySize << " index=" << arrayIndex << ")");
+        return false;
+    }
+
+    return true;
+}
+
+void Material::MarkDirty(uint32 id) {
+    if (!mDirtyFlags[id]) {
+        mDirtyFlags[id] = true;
+        mDirtyParams.push_back(id);
+    }
+
     mIsDirty = true;
+    mRevision += 1;
+}
+
+void Material::ClearDirty() {
+    for (auto id : mDirtyParams)
+        mDirtyFlags[id] = false;
+
+    mDirtyParams.clear();
+    mTexturesDirty = false;
+    mIsDirty = false;
 }
 
 BRK_NS_END
\ No newline at end of file
@@ -46,6 +46,42 @@ BRK_NS_BEGIN
  * @{
  */
 
+/**
+ * @class MaterialParamHandle
+ * @brief Pre-resolved material param for setting values without name look-up
+ *
+ * Resolve handle once with `Material::GetParamHandle` and pass it to the
+ * material setters. Handle is valid for all materials of the same shader.
+ */
+class MaterialParamHandle final {
+public:
+    BRK_API MaterialParamHandle() = default;
+
+    /** @return True if handle references existing param */
+    BRK_API bool IsValid() const { return mId != ShaderParams::INVALID_ID; }
+    /** @return Param id in the shader params */
+    BRK_API uint32 GetId() const { return mId; }
+    /** @return Number of elements in param array */
+    BRK_API uint32 GetArraySize() const { return mArraySize; }
+    /** @return General type of param */
+    BRK_API ShaderParamType GetType() const { return mType; }
+    /** @return Data type of data param */
+    BRK_API RHIShaderDataType GetDataType() const { return mTypeData; }
+
+private:
+    friend class Material;
+    friend class MaterialInstance;
+    friend class MaterialInstancePool;
+
+    const ShaderParams *mParams = nullptr;                    /** Params layout handle was resolved for */
+    uint32 mId = ShaderParams::INVALID_ID;                    /** Param id */
+    uint32 mOffset = 0;                                       /** Offset in raw data buffer (or index of first texture) */
+    uint32 mSize = 0;                                         /** Size of single array element in raw data buffer */
+    uint32 mArraySize = 0;                                    /** Number of elements in param array */
+    ShaderParamType mType = ShaderParamType::Unknown;         /** General type */
+    RHIShaderDataType mTypeData = RHIShaderDataType::Unknown; /** Data type of data param */
+};
+
 /**
  * @class Material
  * @brief Controls how object is actually rendered
@@ -75,6 +111,15 @@ public:
 
     BRK_API ~Material() override = default;
 
+    /**
+     * @brief Creates material with the same shader and params values
+     *
+     * Clone has its own packed params, so it can be modified independently.
+     *
+     * @return New material
+     */
+    BRK_API Ref<Material> Clone() const;
+
     /** Set material name */
     BRK_API void SetName(StringName name);
     /** Set optional material description  */
@@ -321,14 +366,71 @@ public:
      */
     BRK_API void SetMat4(const StringName &name, const Mat4x4f &value, uint32 arrayIndex = 0);
 
+    /**
+     * @brief Resolve param by name for fast access
+     *
+     * @param name Parameter name
+     * @return Handle (invalid if no such param)
+     */
+    BRK_API MaterialParamHandle GetParamHandle(const StringName &name) const;
+
+    /** Set material texture parameter by handle */
+    BRK_API void SetTexture(const MaterialParamHandle &handle, Ref<RHITexture> texture, Ref<RHISampler> sampler, uint32 arrayIndex = 0);
+    /** Set material float parameter by handle */
+    BRK_API void SetFloat1(const MaterialParamHandle &handle, float value, uint32 arrayIndex = 0);
+    /** Set material float vec2 parameter by handle */
+    BRK_API void SetFloat2(const MaterialParamHandle &handle, const Vec2f &value, uint32 arrayIndex = 0);
+    /** Set material float vec3 parameter by handle */
+    BRK_API void SetFloat3(const MaterialParamHandle &handle, const Vec3f &value, uint32 arrayIndex = 0);
+    /** Set material float vec4 parameter by handle */
+    BRK_API void SetFloat4(const MaterialParamHandle &handle, const Vec4f &value, uint32 arrayIndex = 0);
+    /** Set material int parameter by handle */
+    BRK_API void SetInt1(const MaterialParamHandle &handle, int32 value, uint32 arrayIndex = 0);
+    /** Set material int vec2 parameter by handle */
+    BRK_API void SetInt2(const MaterialParamHandle &handle, const Vec2i &value, uint32 arrayIndex = 0);
+    /** Set material int vec3 parameter by handle */
+    BRK_API void SetInt3(const MaterialParamHandle &handle, const Vec3i &value, uint32 arrayIndex = 0);
+    /** Set material int vec4 parameter by handle */
+    BRK_API void SetInt4(const MaterialParamHandle &handle, const Vec4i &value, uint32 arrayIndex = 0);
+    /** Set material uint parameter by handle */
+    BRK_API void SetUInt1(const MaterialParamHandle &handle, uint32 value, uint32 arrayIndex = 0);
+    /** Set material uint vec2 parameter by handle */
+    BRK_API void SetUInt2(const MaterialParamHandle &handle, const Vec2u &value, uint32 arrayIndex = 0);
+    /** Set material uint vec3 parameter by handle */
+    BRK_API void SetUInt3(const MaterialParamHandle &handle, const Vec3u &value, uint32 arrayIndex = 0);
+    /** Set material uint vec4 parameter by handle */
+    BRK_API void SetUInt4(const MaterialParamHandle &handle, const Vec4u &value, uint32 arrayIndex = 0);
+    /** Set material bool parameter by handle */
+    BRK_API void SetBool1(const MaterialParamHandle &handle, bool value, uint32 arrayIndex = 0);
+    /** Set material bool vec2 parameter by handle */
+    BRK_API void SetBool2(const MaterialParamHandle &handle, const Vec2b &value, uint32 arrayIndex = 0);
+    /** Set material bool vec3 parameter by handle */
+    BRK_API void SetBool3(const MaterialParamHandle &handle, const Vec3b &value, uint32 arrayIndex = 0);
+    /** Set material bool vec4 parameter by handle */
+    BRK_API void SetBool4(const MaterialParamHandle &handle, const Vec4b &value, uint32 arrayIndex = 0);
+    /** Set material float mat2x2 parameter by handle */
+    BRK_API void SetMat2(const MaterialParamHandle &handle, const Mat2x2f &value, uint32 arrayIndex = 0);
+    /** Set material float mat3x3 parameter by handle */
+    BRK_API void SetMat3(const MaterialParamHandle &handle, const Mat3x3f &value, uint32 arrayIndex = 0);
+    /** Set material float mat4x4 parameter by handle */
+    BRK_API void SetMat4(const MaterialParamHandle &handle, const Mat4x4f &value, uint32 arrayIndex = 0);
+
+    /** @return Raw value of data param element (null if handle is not a data param or index is out of bounds) */
+    BRK_API const void *GetParamData(const MaterialParamHandle &handle, uint32 arrayIndex = 0) const;
+
     /**
      * @brief Update rhi-set of the material
      *
      * Must be called by the material owner before rendering
      * to update actual state of material params and data on GPU-side.
+     * Params are packed for the first time, when material becomes ready.
+     * Then only params modified since last update are repacked.
      */
     BRK_API void UpdatePack();
 
+    /** @return True if technique programs are compiled and params are packed for rendering */
+    BRK_API bool IsReady() const;
+
     /** @return True if material is dirty and requires repacking */
     BRK_API bool IsDirty() const { return mIsDirty; }
 
@@ -338,16 +440,25 @@ public:
     BRK_API const Ref<const ShaderTechnique> &GetTechnique() const { return mTechnique; }
     BRK_API const ShaderVariation &GetVariation() const { return mShader->GetVariation(); }
 
-    /** @return Packed material params for rendering on GPU */
+    /** @return Packed material params for rendering on GPU (null until material is ready) */
     BRK_API Ref<const MaterialParams> GetPackedParams() const { return mPackedParams.As<const MaterialParams>(); }
 
 private:
     friend class MaterialParams;
+    friend class MaterialInstancePool;
+
+    Material() = default;
 
     void SetDataParam(const StringName &name, RHIShaderDataType type, const void *data, uint32 arrayIndex);
+    void SetDataParam(const MaterialParamHandle &handle, RHIShaderDataType type, const void *data, uint32 arrayIndex);
+    bool CheckHandle(const MaterialParamHandle &handle, ShaderParamType type, uint32 arrayIndex) const;
+    void MarkDirty(uint32 id);
+    void ClearDirty();
     const std::vector<Ref<RHISampler>> &GetSamplers() const { return mSamplers; }
     const std::vector<Ref<RHITexture>> &GetTextures() const { return mTextures; }
     const std::vector<unsigned char> &GetDataParams() const { return mDataParams; }
+    const std::vector<uint32> &GetDirtyParams() const { return mDirtyParams; }
+    bool AreTexturesDirty() const { return mTexturesDirty; }
 
 private:
     StringName mName;    /** Name of the material */
@@ -360,8 +471,12 @@ private:
     std::vector<Ref<RHISampler>> mSamplers; /** Bound samplers (stored separately, bound to concrete texture unit) */
     std::vector<Ref<RHITexture>> mTextures; /** Bound textures (each texture for each array unit) */
     std::vector<unsigned char> mDataParams; /** Raw buffer with all packed data params */
+    std::vector<uint32> mDirtyParams;       /** Ids of params modified since last update */
+    std::vector<bool> mDirtyFlags;          /** Per param flag to keep dirty params list unique */
 
-    bool mIsDirty = true; /** Dirty mechanism to track when to update params */
+    uint32 mRevision = 0;        /** Incremented on each params modification */
+    bool mTexturesDirty = false; /** Texture params modified since last update */
+    bool mIsDirty = true;        /** Dirty mechanism to track when to update params */
 };
 
 /**
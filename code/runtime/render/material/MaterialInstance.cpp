@@ -0,0 +1,252 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/io/Logger.hpp>
+#include <render/material/MaterialInstance.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+BRK_NS_BEGIN
+
+MaterialInstance::MaterialInstance(Ref<MaterialInstancePool> pool, uint32 instanceId)
+    : mPool(std::move(pool)), mInstanceId(instanceId) {
+}
+
+MaterialInstance::~MaterialInstance() {
+    if (!mKey.empty())
+        mPool->Release(mKey);
+
+    mPool->ReleaseInstance(mInstanceId);
+}
+
+MaterialParamHandle MaterialInstance::GetParamHandle(const StringName &name) const {
+    return mPool->GetParent()->GetParamHandle(name);
+}
+
+void MaterialInstance::SetTexture(const MaterialParamHandle &handle, Ref<RHITexture> texture, Ref<RHISampler> sampler, uint32 arrayIndex) {
+    assert(texture.IsNotNull());
+    assert(sampler.IsNotNull());
+
+    if (!CheckHandle(handle, ShaderParamType::Texture, arrayIndex))
+        return;
+
+    auto index = handle.mOffset + arrayIndex;
+    auto &textures = mOverrides.textures;
+    auto query = std::lower_bound(textures.begin(), textures.end(), index, [](const MaterialInstancePool::TextureOverride &entry, uint32 i) { return entry.index < i; });
+
+    if (query != textures.end() && query->index == index) {
+        if (query->texture == texture && query->sampler == sampler)
+            return;
+
+        query->texture = std::move(texture);
+        query->sampler = std::move(sampler);
+    } else {
+        MaterialInstancePool::TextureOverride entry;
+        entry.index = index;
+        entry.texture = std::move(texture);
+        entry.sampler = std::move(sampler);
+        textures.insert(query, std::move(entry));
+    }
+
+    mOverridesDirty = true;
+}
+
+void MaterialInstance::SetFloat1(const MaterialParamHandle &handle, float value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Float1, &value, arrayIndex);
+}
+
+void MaterialInstance::SetFloat2(const MaterialParamHandle &handle, const Vec2f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Float2, &value, arrayIndex);
+}
+
+void MaterialInstance::SetFloat3(const MaterialParamHandle &handle, const Vec3f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Float3, &value, arrayIndex);
+}
+
+void MaterialInstance::SetFloat4(const MaterialParamHandle &handle, const Vec4f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Float4, &value, arrayIndex);
+}
+
+void MaterialInstance::SetInt1(const MaterialParamHandle &handle, int32 value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Int1, &value, arrayIndex);
+}
+
+void MaterialInstance::SetInt2(const MaterialParamHandle &handle, const Vec2i &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Int2, &value, arrayIndex);
+}
+
+void MaterialInstance::SetInt3(const MaterialParamHandle &handle, const Vec3i &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Int3, &value, arrayIndex);
+}
+
+void MaterialInstance::SetInt4(const MaterialParamHandle &handle, const Vec4i &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Int4, &value, arrayIndex);
+}
+
+void MaterialInstance::SetUInt1(const MaterialParamHandle &handle, uint32 value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Uint1, &value, arrayIndex);
+}
+
+void MaterialInstance::SetUInt2(const MaterialParamHandle &handle, const Vec2u &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Uint2, &value, arrayIndex);
+}
+
+void MaterialInstance::SetUInt3(const MaterialParamHandle &handle, const Vec3u &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Uint3, &value, arrayIndex);
+}
+
+void MaterialInstance::SetUInt4(const MaterialParamHandle &handle, const Vec4u &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Uint4, &value, arrayIndex);
+}
+
+void MaterialInstance::SetBool1(const MaterialParamHandle &handle, bool value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Bool1, &value, arrayIndex);
+}
+
+void MaterialInstance::SetBool2(const MaterialParamHandle &handle, const Vec2b &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Bool2, &value, arrayIndex);
+}
+
+void MaterialInstance::SetBool3(const MaterialParamHandle &handle, const Vec3b &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Bool3, &value, arrayIndex);
+}
+
+void MaterialInstance::SetBool4(const MaterialParamHandle &handle, const Vec4b &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Bool4, &value, arrayIndex);
+}
+
+void MaterialInstance::SetMat2(const MaterialParamHandle &handle, const Mat2x2f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Mat2, &value, arrayIndex);
+}
+
+void MaterialInstance::SetMat3(const MaterialParamHandle &handle, const Mat3x3f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Mat3, &value, arrayIndex);
+}
+
+void MaterialInstance::SetMat4(const MaterialParamHandle &handle, const Mat4x4f &value, uint32 arrayIndex) {
+    SetDataParam(handle, RHIShaderDataType::Mat4, &value, arrayIndex);
+}
+
+void MaterialInstance::ResetOverrides() {
+    if (mOverrides.IsEmpty())
+        return;
+
+    mOverrides.data.clear();
+    mOverrides.textures.clear();
+    mOverrides.values.clear();
+    mOverridesDirty = true;
+}
+
+void MaterialInstance::UpdatePack() {
+    if (mOverridesDirty) {
+        String key;
+        Ref<Material> material;
+
+        // Acquire new material before release of the old one, so it is not recreated if the key is the same
+        if (mOverrides.IsEmpty())
+            material = mPool->GetParent();
+        else
+            material = mPool->Acquire(mOverrides, key);
+
+        if (!mKey.empty())
+            mPool->Release(mKey);
+
+        mKey = std::move(key);
+        mMaterial = std::move(material);
+        mOverridesDirty = false;
+    }
+
+    if (!mKey.empty())
+        mPool->Sync(mKey);
+
+    mMaterial->UpdatePack();
+}
+
+bool MaterialInstance::IsReady() const {
+    return mMaterial.IsNotNull() && mMaterial->IsReady();
+}
+
+uint32 MaterialInstance::GetOverridesCount() const {
+    return static_cast<uint32>(mOverrides.data.size() + mOverrides.textures.size());
+}
+
+void MaterialInstance::SetDataParam(const MaterialParamHandle &handle, RHIShaderDataType type, const void *data, uint32 arrayIndex) {
+    if (!CheckHandle(handle, ShaderParamType::Data, arrayIndex))
+        return;
+
+    if (handle.mTypeData != type) {
+        BRK_ERROR("Param has another type=" << static_cast<uint32>(handle.mTypeData) << " passed=" << static_cast<uint32>(type));
+        return;
+    }
+
+    if (mPool->IsPerInstance(handle)) {
+        mPool->SetInstanceParam(mInstanceId, handle, data, arrayIndex);
+        return;
+    }
+
+    auto offset = handle.mOffset + handle.mSize * arrayIndex;
+    auto &entries = mOverrides.data;
+    auto &values = mOverrides.values;
+    auto query = std::lower_bound(entries.begin(), entries.end(), offset, [](const MaterialInstancePool::DataOverride &entry, uint32 o) { return entry.offset < o; });
+
+    if (query != entries.end() && query->offset == offset) {
+        if (std::memcmp(values.data() + query->value, data, handle.mSize) == 0)
+            return;
+
+        Memory::Copy(values.data() + query->value, data, handle.mSize);
+    } else {
+        MaterialInstancePool::DataOverride entry;
+        entry.offset = offset;
+        entry.size = handle.mSize;
+        entry.value = static_cast<uint32>(values.size());
+
+        values.resize(values.size() + handle.mSize);
+        Memory::Copy(values.data() + entry.value, data, handle.mSize);
+        entries.insert(query, entry);
+    }
+
+    mOverridesDirty = true;
+}
+
+bool MaterialInstance::CheckHandle(const MaterialParamHandle &handle, ShaderParamType type, uint32 arrayIndex) const {
+    assert(!handle.IsValid() || handle.mParams == GetParent()->GetShader()->GetParams().Get());
+
+    if (!handle.IsValid() || handle.mType != type) {
+        BRK_ERROR("Invalid param handle id=" << handle.mId);
+        return false;
+    }
+    if (arrayIndex >= handle.mArraySize) {
+        BRK_ERROR("Array index of param id=" << handle.mId << " out of bounds (size=" << handle.mArraySize << " index=" << arrayIndex << ")");
+        return false;
+    }
+
+    return true;
+}
+
+BRK_NS_END
@@ -0,0 +1,154 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_MATERIALINSTANCE_HPP
+#define BERSERK_MATERIALINSTANCE_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <core/string/String.hpp>
+#include <render/material/Material.hpp>
+#include <render/material/MaterialInstancePool.hpp>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup render
+ * @{
+ */
+
+/**
+ * @class MaterialInstance
+ * @brief Lightweight variation of parent material
+ *
+ * Instance stores only params overridden relative to the parent material.
+ * Per-instance params are written to the instance data table of the pool,
+ * other overrides select shared material with the same overrides on update.
+ * Instances are created by `MaterialInstancePool::CreateInstance`.
+ *
+ * @see MaterialInstancePool
+ */
+class MaterialInstance final : public RefCnt {
+public:
+    BRK_API ~MaterialInstance() override;
+
+    /** @return Handle of parent material param */
+    BRK_API MaterialParamHandle GetParamHandle(const StringName &name) const;
+
+    /** Override texture parameter */
+    BRK_API void SetTexture(const MaterialParamHandle &handle, Ref<RHITexture> texture, Ref<RHISampler> sampler, uint32 arrayIndex = 0);
+    /** Override float parameter */
+    BRK_API void SetFloat1(const MaterialParamHandle &handle, float value, uint32 arrayIndex = 0);
+    /** Override float vec2 parameter */
+    BRK_API void SetFloat2(const MaterialParamHandle &handle, const Vec2f &value, uint32 arrayIndex = 0);
+    /** Override float vec3 parameter */
+    BRK_API void SetFloat3(const MaterialParamHandle &handle, const Vec3f &value, uint32 arrayIndex = 0);
+    /** Override float vec4 parameter */
+    BRK_API void SetFloat4(const MaterialParamHandle &handle, const Vec4f &value, uint32 arrayIndex = 0);
+    /** Override int parameter */
+    BRK_API void SetInt1(const MaterialParamHandle &handle, int32 value, uint32 arrayIndex = 0);
+    /** Override int vec2 parameter */
+    BRK_API void SetInt2(const MaterialParamHandle &handle, const Vec2i &value, uint32 arrayIndex = 0);
+    /** Override int vec3 parameter */
+    BRK_API void SetInt3(const MaterialParamHandle &handle, const Vec3i &value, uint32 arrayIndex = 0);
+    /** Override int vec4 parameter */
+    BRK_API void SetInt4(const MaterialParamHandle &handle, const Vec4i &value, uint32 arrayIndex = 0);
+    /** Override uint parameter */
+    BRK_API void SetUInt1(const MaterialParamHandle &handle, uint32 value, uint32 arrayIndex = 0);
+    /** Override uint vec2 parameter */
+    BRK_API void SetUInt2(const MaterialParamHandle &handle, const Vec2u &value, uint32 arrayIndex = 0);
+    /** Override uint vec3 parameter */
+    BRK_API void SetUInt3(const MaterialParamHandle &handle, const Vec3u &value, uint32 arrayIndex = 0);
+    /** Override uint vec4 parameter */
+    BRK_API void SetUInt4(const MaterialParamHandle &handle, const Vec4u &value, uint32 arrayIndex = 0);
+    /** Override bool parameter */
+    BRK_API void SetBool1(const MaterialParamHandle &handle, bool value, uint32 arrayIndex = 0);
+    /** Override bool vec2 parameter */
+    BRK_API void SetBool2(const MaterialParamHandle &handle, const Vec2b &value, uint32 arrayIndex = 0);
+    /** Override bool vec3 parameter */
+    BRK_API void SetBool3(const MaterialParamHandle &handle, const Vec3b &value, uint32 arrayIndex = 0);
+    /** Override bool vec4 parameter */
+    BRK_API void SetBool4(const MaterialParamHandle &handle, const Vec4b &value, uint32 arrayIndex = 0);
+    /** Override float mat2x2 parameter */
+    BRK_API void SetMat2(const MaterialParamHandle &handle, const Mat2x2f &value, uint32 arrayIndex = 0);
+    /** Override float mat3x3 parameter */
+    BRK_API void SetMat3(const MaterialParamHandle &handle, const Mat3x3f &value, uint32 arrayIndex = 0);
+    /** Override float mat4x4 parameter */
+    BRK_API void SetMat4(const MaterialParamHandle &handle, const Mat4x4f &value, uint32 arrayIndex = 0);
+
+    /** Remove all shared overrides, so instance uses parent material (per-instance params are kept) */
+    BRK_API void ResetOverrides();
+
+    /**
+     * @brief Update material used by the instance
+     *
+     * Must be called before rendering. If overrides were modified, instance
+     * selects (or creates) shared material with the same overrides.
+     * Then packs of the selected material are updated.
+     */
+    BRK_API void UpdatePack();
+
+    /** @return True if material of the instance is ready for rendering */
+    BRK_API bool IsReady() const;
+
+    /** @return Material to render instance with (parent or shared material; null until first update) */
+    BRK_API const Ref<Material> &GetMaterial() const { return mMaterial; }
+    /** @return Parent material */
+    BRK_API const Ref<Material> &GetParent() const { return mPool->GetParent(); }
+    /** @return Pool of the instance */
+    BRK_API const Ref<MaterialInstancePool> &GetPool() const { return mPool; }
+    /** @return Id of the instance in the pool instance data table */
+    BRK_API uint32 GetInstanceId() const { return mInstanceId; }
+    /** @return Per-instance params record to submit with render packet (null if none) */
+    BRK_API const void *GetInstanceData() const { return mPool->GetInstanceData(mInstanceId); }
+    /** @return Number of overridden param elements (excluding per-instance params) */
+    BRK_API uint32 GetOverridesCount() const;
+
+private:
+    friend class MaterialInstancePool;
+
+    MaterialInstance(Ref<MaterialInstancePool> pool, uint32 instanceId);
+
+    void SetDataParam(const MaterialParamHandle &handle, RHIShaderDataType type, const void *data, uint32 arrayIndex);
+    bool CheckHandle(const MaterialParamHandle &handle, ShaderParamType type, uint32 arrayIndex) const;
+
+private:
+    Ref<MaterialInstancePool> mPool;            /** Pool with parent and shared materials */
+    Ref<Material> mMaterial;                    /** Material selected for rendering */
+    MaterialInstancePool::Overrides mOverrides; /** Sparse overrides of parent params */
+    String mKey;                                /** Key of the acquired shared material (empty if parent) */
+    uint32 mInstanceId;                         /** Id in pool instance data table */
+    bool mOverridesDirty = true;                /** Overrides modified since last update */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_MATERIALINSTANCE_HPP
@@ -0,0 +1,200 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/io/Logger.hpp>
+#include <render/material/MaterialInstance.hpp>
+#include <render/material/MaterialInstancePool.hpp>
+
+#include <cassert>
+
+BRK_NS_BEGIN
+
+MaterialInstancePool::MaterialInstancePool(Ref<Material> parent, const std::vector<MaterialParamHandle> &instanceParams) {
+    assert(parent.IsNotNull());
+
+    mParent = std::move(parent);
+    mInstanceSlots.resize(mParent->mDirtyFlags.size(), static_cast<uint32>(NO_SLOT));
+
+    for (const auto &handle : instanceParams) {
+        if (!handle.IsValid() || handle.mType != ShaderParamType::Data) {
+            BRK_ERROR("Only data params can be stored per-instance id=" << handle.mId);
+            continue;
+        }
+        if (mInstanceSlots[handle.mId] != NO_SLOT)
+            continue;
+
+        auto size = handle.mSize * handle.mArraySize;
+        const auto *defaults = mParent->mDataParams.data() + handle.mOffset;
+
+        mInstanceSlots[handle.mId] = mInstanceStride;
+        mInstanceDefaults.insert(mInstanceDefaults.end(), defaults, defaults + size);
+        mInstanceStride += size;
+    }
+}
+
+Ref<MaterialInstance> MaterialInstancePool::CreateInstance() {
+    uint32 instanceId;
+
+    if (!mFreeIds.empty()) {
+        instanceId = mFreeIds.back();
+        mFreeIds.pop_back();
+    } else {
+        instanceId = mNextId++;
+        mInstanceData.resize(mNextId * mInstanceStride);
+    }
+
+    if (mInstanceStride > 0)
+        Memory::Copy(mInstanceData.data() + instanceId * mInstanceStride, mInstanceDefaults.data(), mInstanceStride);
+
+    mInstancesCount += 1;
+
+    return Ref<MaterialInstance>(new MaterialInstance(Ref<MaterialInstancePool>(this), instanceId));
+}
+
+void MaterialInstancePool::UpdatePack() {
+    mParent->UpdatePack();
+
+    for (auto &entry : mShared) {
+        Sync(entry.second);
+        entry.second.material->UpdatePack();
+    }
+}
+
+bool MaterialInstancePool::IsPerInstance(const MaterialParamHandle &handle) const {
+    return handle.IsValid() && handle.mId < mInstanceSlots.size() && mInstanceSlots[handle.mId] != NO_SLOT;
+}
+
+const void *MaterialInstancePool::GetInstanceData(uint32 instanceId) const {
+    assert(instanceId < mNextId);
+    return mInstanceStride > 0 ? mInstanceData.data() + instanceId * mInstanceStride : nullptr;
+}
+
+Ref<Material> MaterialInstancePool::Acquire(const Overrides &overrides, String &key) {
+    key = MakeKey(overrides);
+
+    auto query = mShared.find(key);
+
+    if (query != mShared.end()) {
+        query->second.users += 1;
+        return query->second.material;
+    }
+
+    Shared shared;
+    shared.material = mParent->Clone();
+    shared.overrides = overrides;
+    shared.parentRevision = mParent->mRevision;
+    shared.users = 1;
+    ApplyOverrides(*shared.material, shared.overrides);
+
+    auto material = shared.material;
+    mShared.emplace(key, std::move(shared));
+
+    return material;
+}
+
+void MaterialInstancePool::Release(const String &key) {
+    auto query = mShared.find(key);
+    assert(query != mShared.end());
+
+    if (query != mShared.end() && --query->second.users == 0)
+        mShared.erase(query);
+}
+
+void MaterialInstancePool::Sync(const String &key) {
+    auto query = mShared.find(key);
+
+    if (query != mShared.end())
+        Sync(query->second);
+}
+
+void MaterialInstancePool::Sync(Shared &shared) {
+    if (shared.parentRevision == mParent->mRevision)
+        return;
+
+    // Parent params changed: take new parent values and re-apply overrides on top
+    auto &material = *shared.material;
+    material.mDataParams = mParent->mDataParams;
+    material.mTextures = mParent->mTextures;
+    material.mSamplers = mParent->mSamplers;
+    ApplyOverrides(material, shared.overrides);
+
+    for (uint32 id = 0; id < static_cast<uint32>(material.mDirtyFlags.size()); id++)
+        material.MarkDirty(id);
+
+    material.mTexturesDirty = true;
+    shared.parentRevision = mParent->mRevision;
+}
+
+void MaterialInstancePool::ReleaseInstance(uint32 instanceId) {
+    assert(instanceId < mNextId);
+
+    mFreeIds.push_back(instanceId);
+    mInstancesCount -= 1;
+}
+
+void MaterialInstancePool::SetInstanceParam(uint32 instanceId, const MaterialParamHandle &handle, const void *data, uint32 arrayIndex) {
+    auto offset = instanceId * mInstanceStride + mInstanceSlots[handle.mId] + handle.mSize * arrayIndex;
+    Memory::Copy(mInstanceData.data() + offset, data, handle.mSize);
+}
+
+String MaterialInstancePool::MakeKey(const Overrides &overrides) {
+    String key;
+
+    if (overrides.IsEmpty())
+        return key;
+
+    // Exact binary description of overrides, so different overrides never share material
+    auto append = [&](const void *data, size_t size) { key.append(reinterpret_cast<const char *>(data), size); };
+
+    for (const auto &entry : overrides.data) {
+        append(&entry.offset, sizeof(entry.offset));
+        append(&entry.size, sizeof(entry.size));
+        append(overrides.values.data() + entry.value, entry.size);
+    }
+
+    for (const auto &entry : overrides.textures) {
+        auto texture = entry.texture.Get();
+        auto sampler = entry.sampler.Get();
+        append(&entry.index, sizeof(entry.index));
+        append(&texture, sizeof(texture));
+        append(&sampler, sizeof(sampler));
+    }
+
+    return key;
+}
+
+void MaterialInstancePool::ApplyOverrides(Material &material, const Overrides &overrides) {
+    for (const auto &entry : overrides.data)
+        Memory::Copy(material.mDataParams.data() + entry.offset, overrides.values.data() + entry.value, entry.size);
+
+    for (const auto &entry : overrides.textures) {
+        material.mTextures[entry.index] = entry.texture;
+        material.mSamplers[entry.index] = entry.sampler;
+    }
+}
+
+BRK_NS_END
@@ -0,0 +1,160 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_MATERIALINSTANCEPOOL_HPP
+#define BERSERK_MATERIALINSTANCEPOOL_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <core/string/String.hpp>
+#include <render/material/Material.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup render
+ * @{
+ */
+
+class MaterialInstance;
+
+/**
+ * @class MaterialInstancePool
+ * @brief Shares parent material resources between material instances
+ *
+ * Pool references parent material and creates lightweight instances of it.
+ * Instance stores only overridden params (sparse delta of the parent params).
+ * Instances with the same set of overrides share single packed material
+ * (uniform buffers and resource sets), instances without overrides render
+ * with the parent material itself. So memory and bind changes depend
+ * on the number of distinct params values, not on the number of objects.
+ *
+ * Params listed as per-instance at pool creation never create new shared
+ * materials. Their values are packed into the instance data table of the pool,
+ * one record of `GetInstanceStride()` bytes per instance id. Record of the instance
+ * is passed to `RenderQueue::Submit` as instance data and reaches the shader as
+ * per-instance vertex attributes (params are packed tightly in declaration order).
+ *
+ * @note Parent material changes are propagated to shared materials on next update.
+ * @note Not thread-safe; instances must be modified and updated on the game thread.
+ *
+ * @see MaterialInstance
+ */
+class MaterialInstancePool final : public RefCnt {
+public:
+    /**
+     * @brief Create pool for parent material
+     *
+     * @param parent Parent material of instances
+     * @param instanceParams Data params which instances set per-instance
+     */
+    BRK_API explicit MaterialInstancePool(Ref<Material> parent, const std::vector<MaterialParamHandle> &instanceParams = std::vector<MaterialParamHandle>());
+    BRK_API ~MaterialInstancePool() override = default;
+
+    /** @return New instance of the parent material without overrides */
+    BRK_API Ref<MaterialInstance> CreateInstance();
+
+    /** Update packs of the parent and all shared materials */
+    BRK_API void UpdatePack();
+
+    /** @return True if param is stored per-instance in the instance data table */
+    BRK_API bool IsPerInstance(const MaterialParamHandle &handle) const;
+
+    /** @return Size in bytes of per-instance params record */
+    BRK_API uint32 GetInstanceStride() const { return mInstanceStride; }
+    /** @return Per-instance params record of instance (null if pool has no per-instance params) */
+    BRK_API const void *GetInstanceData(uint32 instanceId) const;
+    /** @return Number of alive instances */
+    BRK_API uint32 GetInstancesCount() const { return mInstancesCount; }
+    /** @return Number of shared materials with distinct overrides */
+    BRK_API uint32 GetSharedCount() const { return static_cast<uint32>(mShared.size()); }
+    /** @return Parent material */
+    BRK_API const Ref<Material> &GetParent() const { return mParent; }
+
+private:
+    friend class MaterialInstance;
+
+    static const uint32 NO_SLOT = 0xffffffff;
+
+    struct DataOverride {
+        uint32 offset; /** Offset of the element in material raw data buffer */
+        uint32 size;   /** Size of the element */
+        uint32 value;  /** Offset of the value in overrides values */
+    };
+
+    struct TextureOverride {
+        uint32 index;            /** Index of the texture unit in material */
+        Ref<RHITexture> texture; /** Texture to set */
+        Ref<RHISampler> sampler; /** Sampler to set */
+    };
+
+    struct Overrides {
+        std::vector<DataOverride> data;        /** Data overrides sorted by offset */
+        std::vector<TextureOverride> textures; /** Texture overrides sorted by index */
+        std::vector<unsigned char> values;     /** Raw values of data overrides */
+
+        bool IsEmpty() const { return data.empty() && textures.empty(); }
+    };
+
+    struct Shared {
+        Ref<Material> material; /** Parent clone with applied overrides */
+        Overrides overrides;    /** Overrides to re-apply when parent changes */
+        uint32 parentRevision;  /** Parent revision material was synced with */
+        uint32 users;           /** Number of instances using this material */
+    };
+
+    Ref<Material> Acquire(const Overrides &overrides, String &key);
+    void Release(const String &key);
+    void Sync(const String &key);
+    void Sync(Shared &shared);
+    void ReleaseInstance(uint32 instanceId);
+    void SetInstanceParam(uint32 instanceId, const MaterialParamHandle &handle, const void *data, uint32 arrayIndex);
+    static String MakeKey(const Overrides &overrides);
+    static void ApplyOverrides(Material &material, const Overrides &overrides);
+
+private:
+    Ref<Material> mParent;                        /** Parent material of all instances */
+    std::unordered_map<String, Shared> mShared;   /** Shared materials by overrides key */
+    std::vector<uint32> mInstanceSlots;           /** Per param id offset in instance record (or no slot) */
+    std::vector<unsigned char> mInstanceDefaults; /** Record with parent values of per-instance params */
+    std::vector<unsigned char> mInstanceData;     /** Records of all instances indexed by instance id */
+    std::vector<uint32> mFreeIds;                 /** Ids of released instances for reuse */
+    uint32 mInstanceStride = 0;                   /** Size of instance record */
+    uint32 mInstancesCount = 0;                   /** Number of alive instances */
+    uint32 mNextId = 0;                           /** Next never used instance id */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_MATERIALINSTANCEPOOL_HPP
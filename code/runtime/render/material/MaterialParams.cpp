@@ -30,160 +30,229 @@
 #include <render/material/MaterialParams.hpp>
 #include <render/shader/ShaderArchetype.hpp>
 
+#include <algorithm>
+
 BRK_NS_BEGIN
 
+namespace {
+    template<typename MatT>
+    void PackMatrix(const unsigned char *src, unsigned char *dst, uint32 dstMatrixStride) {
+        MatT mat(reinterpret_cast<const float *>(src), MatT::GetSize());
+        auto matT = mat.Transpose();
+        for (uint32 row = 0; row < MatT::GetDimM(); row++)
+            Memory::Copy(dst + row * dstMatrixStride,
+                         matT.GetData() + row * MatT::GetDimN(),
+                         sizeof(float) * MatT::GetDimN());
+    }
+
+    uint32 GetMatrixRows(RHIShaderDataType type) {
+        switch (type) {
+            case RHIShaderDataType::Mat2:
+                return Mat2x2f::GetDimM();
+            case RHIShaderDataType::Mat3:
+                return Mat3x3f::GetDimM();
+            case RHIShaderDataType::Mat4:
+                return Mat4x4f::GetDimM();
+            default:
+                return 0;
+        }
+    }
+}// namespace
+
 MaterialParams::MaterialParams(class Material &material) {
+    const auto &shader = material.GetShader();
     const auto &technique = material.GetTechnique();
     const auto &passes = technique->GetPasses();
+    const auto &params = shader->GetParams();
+    const auto &paramsLight = params->GetParamsLight();
 
+    mPasses.resize(passes.size());
     mResourceSets.reserve(passes.size());
     mUniformBuffers.reserve(passes.size());
 
     auto &device = Engine::Instance().GetRHIDevice();
     static StringName nShaderParams(ShaderArchetype::SHADER_PARAMS_BLOCK);
 
-    for (auto &pass : passes) {
+    for (size_t passIdx = 0; passIdx < passes.size(); passIdx++) {
+        const auto &pass = passes[passIdx];
         const auto &passProgram = pass->GetShader();
         const auto meta = passProgram->GetShaderMeta();
 
+        auto &passParams = mPasses[passIdx];
+        passParams.paramCopies.resize(paramsLight.size(), static_cast<uint32>(INVALID_COPY));
+
+        mResourceSets.push_back(device.CreateResourceSet(RHIResourceSetDesc{}));
+
         auto blockInfo = meta->paramBlocks.find(nShaderParams);
         if (blockInfo == meta->paramBlocks.end()) {
             BRK_ERROR("No block=" << nShaderParams << " in pass name=" << pass->GetName());
-            continue;
+            mUniformBuffers.emplace_back();
+        } else {
+            RHIBufferDesc bufferDesc{};
+            bufferDesc.size = blockInfo->second.size;
+            bufferDesc.bufferUsage = RHIBufferUsage::Dynamic;
+
+            mUniformBuffers.push_back(device.CreateUniformBuffer(bufferDesc));
+            passParams.block.resize(blockInfo->second.size, 0x0);
+            passParams.blockSlot = blockInfo->second.slot;
         }
 
-        RHIBufferDesc bufferDesc{};
-        bufferDesc.size = blockInfo->second.size;
-        bufferDesc.bufferUsage = RHIBufferUsage::Dynamic;
+        // Precompute copy program for the params, present in the pass shader
+        for (const auto &paramNameId : params->GetParamLookUp()) {
+            const auto &name = paramNameId.first;
+            const auto id = paramNameId.second;
+            const auto &param = paramsLight[id];
 
-        RHIResourceSetDesc setDesc{};
+            if (param.type == ShaderParamType::Texture) {
+                auto metaQuery = meta->samplers.find(name);
+                if (metaQuery != meta->samplers.end()) {
+                    TextureBinding binding{};
+                    binding.offset = params->GetTextureParamsInfo()[param.info].offset;
+                    binding.arraySize = param.arraySize;
+                    binding.location = metaQuery->second.location;
+                    passParams.textures.push_back(binding);
+                }
+            } else if (param.type == ShaderParamType::Data && !passParams.block.empty()) {
+                auto metaQuery = meta->params.find(name);
+                if (metaQuery != meta->params.end()) {
+                    const auto &info = params->GetDataParamsInfo()[param.info];
+                    const auto &dst = metaQuery->second;
+                    auto rows = GetMatrixRows(param.typeData);
 
-        mUniformBuffers.push_back(device.CreateUniformBuffer(bufferDesc));
-        mResourceSets.push_back(device.CreateResourceSet(setDesc));
-    }
+                    DataCopy copy{};
+                    copy.srcOffset = info.offset;
+                    copy.srcSize = info.size;
+                    copy.dstOffset = dst.blockOffset;
+                    copy.dstArrayStride = dst.arrayStride;
+                    copy.dstMatrixStride = dst.matrixStride;
+                    copy.arraySize = param.arraySize;
+                    copy.type = param.typeData;
+
+                    // Bytes range of the last element defines the end of param in the block
+                    auto elementSize = rows > 0 ? (rows - 1) * copy.dstMatrixStride + info.size / rows : info.size;
+                    copy.dstSize = (copy.arraySize - 1) * copy.dstArrayStride + elementSize;
+
+                    if (copy.dstOffset + copy.dstSize > passParams.block.size()) {
+                        BRK_ERROR("Param=" << name << " out of block bounds in pass name=" << pass->GetName());
+                        continue;
+                    }
+
+                    passParams.paramCopies[id] = static_cast<uint32>(passParams.copies.size());
+                    passParams.copies.push_back(copy);
+                }
+            }
+        }
 
-    Update(material);
+        // Pack all params for the first time
+        const auto &data = material.GetDataParams();
+        for (const auto &copy : passParams.copies)
+            ExecuteCopy(copy, data, passParams);
+
+        if (mUniformBuffers[passIdx].IsNotNull()) {
+            auto blockSize = static_cast<uint32>(passParams.block.size());
+            device.UpdateUniformBuffer(mUniformBuffers[passIdx], 0, blockSize, Data::Make(passParams.block.data(), blockSize));
+        }
+
+        UpdateResourceSet(material, passIdx);
+    }
 }
 
 void MaterialParams::Update(class Material &material) {
-    const auto &shader = material.GetShader();
-    const auto &technique = material.GetTechnique();
-    const auto &passes = technique->GetPasses();
-    const auto &params = shader->GetParams();
-
-    assert(mResourceSets.size() == passes.size());
+    const auto &dirtyParams = material.GetDirtyParams();
+    const auto &data = material.GetDataParams();
+    const bool texturesDirty = material.AreTexturesDirty();
 
     auto &device = Engine::Instance().GetRHIDevice();
-    static StringName nShaderParams(ShaderArchetype::SHADER_PARAMS_BLOCK);
 
-    // NOTE: in future maybe we need to track modified resources and values and
-    // update only them (use history mark or track modified by boolean flags).
-    // For know all resources are update and rewritten
+    // Dirty ranges [begin, end) of the block
+    std::vector<std::pair<uint32, uint32>> ranges;
 
-    for (size_t passIdx = 0; passIdx < passes.size(); passIdx++) {
-        const auto &pass = passes[passIdx];
-        const auto &program = pass->GetShader();
-        const auto meta = program->GetShaderMeta();
+    for (size_t passIdx = 0; passIdx < mPasses.size(); passIdx++) {
+        auto &passParams = mPasses[passIdx];
 
-        const auto &samplers = material.GetSamplers();
-        const auto &textures = material.GetTextures();
-        const auto &data = material.GetDataParams();
+        ranges.clear();
 
-        auto dataBuffer = Data::Make(mUniformBuffers[passIdx]->GetSize());
-        Memory::Set(dataBuffer->GetDataWrite(), 0x0, dataBuffer->GetSize());
+        for (auto id : dirtyParams) {
+            auto copyIdx = passParams.paramCopies[id];
+            if (copyIdx == INVALID_COPY)
+                continue;
 
-        RHIResourceSetDesc resourceSetDesc;
+            const auto &copy = passParams.copies[copyIdx];
+            ExecuteCopy(copy, data, passParams);
+            ranges.emplace_back(copy.dstOffset, copy.dstOffset + copy.dstSize);
+        }
 
-        for (const auto &paramNameId : params->GetParamLookUp()) {
-            const auto &name = paramNameId.first;
-            const auto id = paramNameId.second;
-            const auto &param = params->GetParamsLight()[id];
+        if (!ranges.empty() && mUniformBuffers[passIdx].IsNotNull()) {
+            std::sort(ranges.begin(), ranges.end());
 
-            if (param.type == ShaderParamType::Texture) {
-                auto metaQuery = meta->samplers.find(name);
-                if (metaQuery != meta->samplers.end()) {
-                    // If this texture param is present in the pass shader
-                    // then set all array textures and samplers of this param
-                    auto baseLocation = metaQuery->second.location;
-                    auto baseOffset = params->GetTextureParamsInfo()[param.info].offset;
-                    for (uint32 i = 0; i < param.arraySize; i++) {
-                        // Skip null textures
-                        if (textures[baseOffset + i].IsNotNull()) {
-                            resourceSetDesc.AddSampler(samplers[baseOffset + i], baseLocation, i);
-                            resourceSetDesc.AddTexture(textures[baseOffset + i], baseLocation, i);
-                        }
-                    }
-                }
-            } else if (param.type == ShaderParamType::Data) {
-                auto metaQuery = meta->params.find(name);
-                if (metaQuery != meta->params.end()) {
-                    // If data param is present, then pack it all array elements
-                    // and transform data if required for the layout
-                    const auto typeData = param.typeData;
-                    const auto srcSize = params->GetDataParamsInfo()[param.info].size;
-                    const auto srcOffset = params->GetDataParamsInfo()[param.info].offset;
-                    const auto dstOffset = metaQuery->second.blockOffset;
-                    const auto dstArrayStride = metaQuery->second.arrayStride;
-                    const auto dstMatrixStride = metaQuery->second.matrixStride;
-
-                    for (uint32 i = 0; i < param.arraySize; i++) {
-                        const unsigned char *src = data.data() + srcOffset + i * srcSize;
-                        unsigned char *dst = reinterpret_cast<unsigned char *>(dataBuffer->GetDataWrite()) + dstOffset + i * dstArrayStride;
-
-                        switch (typeData) {
-                            case RHIShaderDataType::Mat2: {
-                                using MatT = Mat2x2f;
-                                MatT mat(reinterpret_cast<const float *>(src), MatT::GetSize());
-                                auto matT = mat.Transpose();
-                                for (uint32 row = 0; row < MatT::GetDimM(); row++)
-                                    Memory::Copy(dst + row * dstMatrixStride,
-                                                 matT.GetData() + row * MatT::GetDimN(),
-                                                 sizeof(float) * MatT::GetDimN());
-                                break;
-                            }
-                            case RHIShaderDataType::Mat3: {
-                                using MatT = Mat3x3f;
-                                MatT mat(reinterpret_cast<const float *>(src), MatT::GetSize());
-                                auto matT = mat.Transpose();
-                                for (uint32 row = 0; row < MatT::GetDimM(); row++)
-                                    Memory::Copy(dst + row * dstMatrixStride,
-                                                 matT.GetData() + row * MatT::GetDimN(),
-                                                 sizeof(float) * MatT::GetDimN());
-                                break;
-                            }
-                            case RHIShaderDataType::Mat4: {
-                                using MatT = Mat4x4f;
-                                MatT mat(reinterpret_cast<const float *>(src), MatT::GetSize());
-                                auto matT = mat.Transpose();
-                                for (uint32 row = 0; row < MatT::GetDimM(); row++)
-                                    Memory::Copy(dst + row * dstMatrixStride,
-                                                 matT.GetData() + row * MatT::GetDimN(),
-                                                 sizeof(float) * MatT::GetDimN());
-                                break;
-                            }
-                            default:
-                                Memory::Copy(dst, src, srcSize);
-                                break;
-                        }
-                    }
-                }
+            // Merge close ranges to reduce number of updates
+            size_t merged = 0;
+            for (size_t i = 1; i < ranges.size(); i++) {
+                if (ranges[i].first <= ranges[merged].second + MERGE_GAP)
+                    ranges[merged].second = std::max(ranges[merged].second, ranges[i].second);
+                else
+                    ranges[++merged] = ranges[i];
+            }
+            ranges.resize(merged + 1);
+
+            for (const auto &range : ranges) {
+                auto size = range.second - range.first;
+                auto rangeData = Data::Make(passParams.block.data() + range.first, size);
+                device.UpdateUniformBuffer(mUniformBuffers[passIdx], range.first, size, rangeData);
             }
         }
 
-        if (mUniformBuffers[passIdx].IsNotNull()) {
-            // Update uniform buffer
-            device.UpdateUniformBuffer(mUniformBuffers[passIdx], 0, static_cast<uint32>(dataBuffer->GetSize()), dataBuffer);
+        if (texturesDirty && !passParams.textures.empty())
+            UpdateResourceSet(material, passIdx);
+    }
+}
+
+void MaterialParams::ExecuteCopy(const DataCopy &copy, const std::vector<unsigned char> &data, PassParams &pass) const {
+    for (uint32 i = 0; i < copy.arraySize; i++) {
+        const unsigned char *src = data.data() + copy.srcOffset + i * copy.srcSize;
+        unsigned char *dst = pass.block.data() + copy.dstOffset + i * copy.dstArrayStride;
 
-            // Add info about uniform buffer of the resource set for the pass
-            auto blockInfo = meta->paramBlocks.find(nShaderParams);
-            assert(blockInfo != meta->paramBlocks.end());
+        switch (copy.type) {
+            case RHIShaderDataType::Mat2:
+                PackMatrix<Mat2x2f>(src, dst, copy.dstMatrixStride);
+                break;
+            case RHIShaderDataType::Mat3:
+                PackMatrix<Mat3x3f>(src, dst, copy.dstMatrixStride);
+                break;
+            case RHIShaderDataType::Mat4:
+                PackMatrix<Mat4x4f>(src, dst, copy.dstMatrixStride);
+                break;
+            default:
+                Memory::Copy(dst, src, copy.srcSize);
+                break;
+        }
+    }
+}
+
+void MaterialParams::UpdateResourceSet(class Material &material, size_t passIdx) {
+    const auto &samplers = material.GetSamplers();
+    const auto &textures = material.GetTextures();
+    const auto &passParams = mPasses[passIdx];
+
+    RHIResourceSetDesc resourceSetDesc;
 
-            resourceSetDesc.AddBuffer(mUniformBuffers[passIdx], blockInfo->second.slot, 0, blockInfo->second.size);
+    for (const auto &binding : passParams.textures) {
+        for (uint32 i = 0; i < binding.arraySize; i++) {
+            // Skip null textures
+            if (textures[binding.offset + i].IsNotNull()) {
+                resourceSetDesc.AddSampler(samplers[binding.offset + i], binding.location, i);
+                resourceSetDesc.AddTexture(textures[binding.offset + i], binding.location, i);
+            }
         }
+    }
 
-        // Update resource set
-        device.UpdateResourceSet(mResourceSets[passIdx], resourceSetDesc);
+    if (mUniformBuffers[passIdx].IsNotNull()) {
+        auto blockSize = static_cast<uint32>(passParams.block.size());
+        resourceSetDesc.AddBuffer(mUniformBuffers[passIdx], passParams.blockSlot, 0, blockSize);
     }
+
+    auto &device = Engine::Instance().GetRHIDevice();
+    device.UpdateResourceSet(mResourceSets[passIdx], resourceSetDesc);
 }
 
 BRK_NS_END
\ No newline at end of file
@@ -46,20 +46,64 @@ BRK_NS_BEGIN
 /**
  * @class MaterialParams
  * @brief Packed material params ready for rendering usage
+ *
+ * For each pass of the material technique precomputes copy program:
+ * list of data params copies from material raw data into the pass uniform
+ * block layout and list of texture bindings. Keeps CPU copy of each uniform
+ * block, so update executes copies only for dirty params, uploads only
+ * changed byte ranges and rebuilds resource sets only when textures change.
  */
 class MaterialParams final : public RefCnt {
 public:
+    /** Dirty ranges closer than this number of bytes are uploaded by single update */
+    static const uint32 MERGE_GAP = 64;
+
     /** Creates material params for material (uses material technique) */
     BRK_API explicit MaterialParams(class Material &material);
     BRK_API ~MaterialParams() override = default;
 
-    /** Updates material params set */
+    /** Updates material params set (uses material dirty params) */
     BRK_API void Update(class Material &material);
 
     /** @return Resources sets of material for each pass */
     BRK_API const std::vector<Ref<RHIResourceSet>> &GetResourceSets() const { return mResourceSets; }
 
 private:
+    /** Copy of single data param (all array elements) into block */
+    struct DataCopy {
+        uint32 srcOffset;
+        uint32 srcSize;
+        uint32 dstOffset;
+        uint32 dstSize;
+        uint32 dstArrayStride;
+        uint32 dstMatrixStride;
+        uint32 arraySize;
+        RHIShaderDataType type;
+    };
+
+    /** Binding of texture param (all array elements) */
+    struct TextureBinding {
+        uint32 offset;
+        uint32 arraySize;
+        uint32 location;
+    };
+
+    /** Packing program and state of single pass */
+    struct PassParams {
+        std::vector<DataCopy> copies;          /** Copies of data params present in pass */
+        std::vector<uint32> paramCopies;       /** Param id to copy index (or INVALID_COPY) */
+        std::vector<TextureBinding> textures;  /** Texture params present in pass */
+        std::vector<uint8> block;              /** CPU copy of uniform block */
+        uint32 blockSlot = 0;                  /** Uniform block binding slot */
+    };
+
+    static const uint32 INVALID_COPY = 0xffffffff;
+
+    void ExecuteCopy(const DataCopy &copy, const std::vector<unsigned char> &data, PassParams &pass) const;
+    void UpdateResourceSet(class Material &material, size_t passIdx);
+
+private:
+    std::vector<PassParams> mPasses;                    /** Packing info for each pass */
     std::vector<Ref<RHIUniformBuffer>> mUniformBuffers; /** GPU-uniform buffers for each pass */
     std::vector<Ref<RHIResourceSet>> mResourceSets;     /** Sets for each pass */
 };
@@ -27,25 +27,32 @@
 
 #include <core/Engine.hpp>
 #include <render/shader/ShaderCompiler.hpp>
+#include <render/shader/ShaderManager.hpp>
 
 #include <tinyxml2.hpp>
 
 BRK_NS_BEGIN
 
+ShaderCompiler::ShaderCompiler(const ShaderManager &manager) : mManager(manager) {
+}
+
 ShaderCompiler::CompilationResult ShaderCompiler::Compile(const String &filepath, const Ref<ShaderCompileOptions> &options) {
     auto &engine = Engine::Instance();
     auto &fileSystem = engine.GetFileSystem();
 
-    auto file = fileSystem.OpenFile(filepath, "rb");
-    if (!file) {
+    auto data = fileSystem.ReadFile(filepath);
+    if (data.IsNull()) {
         mResult.error = BRK_TEXT("Failed to load shader file content from disc");
         return mResult;
     }
 
-    tinyxml2::XMLDocument document;
-    tinyxml2::XMLError error = document.LoadFile(file);
+    String source(reinterpret_cast<const char *>(data->GetData()), data->GetSize());
+    return Compile(filepath, source, options);
+}
 
-    fileSystem.CloseFile(file);
+ShaderCompiler::CompilationResult ShaderCompiler::Compile(const String &filepath, const String &source, const Ref<ShaderCompileOptions> &options) {
+    tinyxml2::XMLDocument document;
+    tinyxml2::XMLError error = document.Parse(source.c_str(), source.size());
 
     if (error != tinyxml2::XML_SUCCESS) {
         mResult.error = BRK_TEXT("Failed to parse shader file");
@@ -59,12 +66,37 @@ ShaderCompiler::CompilationResult ShaderCompiler::Compile(const String &filepath
         return mResult;
     }
 
+    if (mCookedPasses && mCookedPasses->size() != mResult.passes.size()) {
+        mResult.error = BRK_TEXT("Cooked passes do not match shader file passes");
+        mResult.shader.Reset();
+        return mResult;
+    }
+
+    if (!mCooking)
+        mResult.passes.clear();
+
     mResult.shader = mShader;
     mResult.shader->SetLoadPath(filepath);
     mResult.shader->SetOptions(mOptions);
     return mResult;
 }
 
+bool ShaderCompiler::ParseArchetype(const String &source, StringName &archetype) {
+    tinyxml2::XMLDocument document;
+
+    if (document.Parse(source.c_str(), source.size()) != tinyxml2::XML_SUCCESS)
+        return false;
+
+    auto element = document.FirstChildElement("shader");
+    auto attribute = element ? element->FindAttribute("archetype") : nullptr;
+
+    if (!attribute)
+        return false;
+
+    archetype = StringName(attribute->Value());
+    return true;
+}
+
 #define BRK_SC_ERROR(what)          \
     mResult.error = BRK_TEXT(what); \
     return false;
@@ -102,8 +134,7 @@ bool ShaderCompiler::ParseShader(tinyxml2::XMLElement *element) {
     BRK_SC_CHECK_ERROR_W(archetype, "Shader archetype must be provided", element);
 
     StringName archetypeName(archetype->Value());
-    auto &shaderManager = Engine::Instance().GetRenderEngine().GetShaderManager();
-    mArchetype = shaderManager.FindArchetype(archetypeName);
+    mArchetype = mManager.FindArchetype(archetypeName);
 
     BRK_SC_CHECK_ERROR_W(mArchetype, "No archetype registered for this shader", element);
 
@@ -111,11 +142,14 @@ bool ShaderCompiler::ParseShader(tinyxml2::XMLElement *element) {
     mShader->SetName(StringName(name->Value()));
     mShader->SetArchetype(std::move(archetypeName));
 
-    ShaderVariation variation;
+    ShaderVariation variation = 0;
     MeshFormat format;
-    mArchetype->DefineVariation(*mOptions, variation);
     mArchetype->DefineFormat(*mOptions, format);
 
+    // Variation ids are assigned by archetype at runtime (not needed for cooking)
+    if (!mCooking)
+        mArchetype->DefineVariation(*mOptions, variation);
+
     mShader->SetVariation(variation);
     mShader->SetFormat(format);
 
@@ -308,32 +342,44 @@ bool ShaderCompiler::ParsePass(tinyxml2::XMLElement *element) {
     mPass->SetName(StringName(name->Value()));
     mPass->SetTechnique(mTechnique.Get());
 
-    ShaderArchetype::InputData inputData;
-    inputData.language = mTechnique->GetRHILanguage();
-    inputData.options = mOptions;
-    inputData.params = mParams;
-    inputData.vertexCode = vertex->GetText();
-    inputData.fragmentCode = fragment->GetText();
-    inputData.passIndex = mPassIndex;
-
-    ShaderArchetype::OutputData outputData;
-    mArchetype->Process(inputData, outputData);
+    auto passId = mResult.passes.size();
+    mResult.passes.emplace_back();
+
+    RHIShaderDesc &shaderDesc = mResult.passes.back();
+
+    if (mCookedPasses) {
+        // Pass already processed offline
+        BRK_SC_CHECK_ERROR_W(passId < mCookedPasses->size(), "No cooked pass for shader pass", element);
+        shaderDesc = (*mCookedPasses)[passId];
+    } else {
+        ShaderArchetype::InputData inputData;
+        inputData.language = mTechnique->GetRHILanguage();
+        inputData.options = mOptions;
+        inputData.params = mParams;
+        inputData.vertexCode = vertex->GetText();
+        inputData.fragmentCode = fragment->GetText();
+        inputData.passIndex = mPassIndex;
+
+        ShaderArchetype::OutputData outputData;
+        mArchetype->Process(inputData, outputData);
+
+        if (outputData.failed) {
+            mResult.line = element->GetLineNum();
+            mResult.error = outputData.error;
+            return false;
+        }
 
-    if (outputData.failed) {
-        mResult.line = element->GetLineNum();
-        mResult.error = outputData.error;
-        return false;
+        shaderDesc.language = outputData.language;
+        shaderDesc.name = mPass->GetName();
+        shaderDesc.stages.resize(2);
+        shaderDesc.stages[0].type = RHIShaderType::Vertex;
+        shaderDesc.stages[0].sourceCode = std::move(outputData.vertexCode);
+        shaderDesc.stages[1].type = RHIShaderType::Fragment;
+        shaderDesc.stages[1].sourceCode = std::move(outputData.fragmentCode);
     }
 
-    RHIShaderDesc shaderDesc;
-    shaderDesc.language = outputData.language;
-    shaderDesc.name = mPass->GetName();
-    shaderDesc.stages.resize(2);
-    shaderDesc.stages[0].type = RHIShaderType::Vertex;
-    shaderDesc.stages[0].sourceCode = std::move(outputData.vertexCode);
-    shaderDesc.stages[1].type = RHIShaderType::Fragment;
-    shaderDesc.stages[1].sourceCode = std::move(outputData.fragmentCode);
-    mPass->SetShader(Engine::Instance().GetRHIDevice().CreateShader(shaderDesc));
+    if (!mCooking)
+        mPass->SetShader(Engine::Instance().GetRHIDevice().CreateShader(shaderDesc));
 
     return true;
 }
@@ -29,9 +29,12 @@
 #define BERSERK_SHADERCOMPILER_HPP
 
 #include <render/shader/Shader.hpp>
+#include <render/shader/ShaderArchetype.hpp>
 
 #include <tinyxml2.hpp>
 
+#include <vector>
+
 BRK_NS_BEGIN
 
 /**
@@ -39,6 +42,8 @@ BRK_NS_BEGIN
  * @{
  */
 
+class ShaderManager;
+
 /**
  * @class ShaderCompiler
  * @brief Responsible to compile shaders in engine .shader.xml format
@@ -50,9 +55,11 @@ public:
         String error;
         uint32 line{};
         Ref<Shader> shader;
+        std::vector<RHIShaderDesc> passes; /** Processed passes of all techniques (filled when cooking) */
     };
 
-    BRK_API ShaderCompiler() = default;
+    /** @param manager Manager to look up shader archetypes */
+    BRK_API explicit ShaderCompiler(const ShaderManager &manager);
     BRK_API ~ShaderCompiler() = default;
 
     /**
@@ -67,6 +74,44 @@ public:
      */
     BRK_API CompilationResult Compile(const String &filepath, const Ref<ShaderCompileOptions> &options);
 
+    /**
+     * @brief Compile shader from already loaded `.shader.xml` file content
+     *
+     * @param filepath Path of the shader file (used as shader load path)
+     * @param source Content of the shader file
+     * @param options Options to compile with
+     *
+     * @return Compilation result
+     */
+    BRK_API CompilationResult Compile(const String &filepath, const String &source, const Ref<ShaderCompileOptions> &options);
+
+    /**
+     * @brief Enables offline cooking mode
+     *
+     * In cooking mode passes are processed by archetype, but RHI shaders
+     * are not created; processed sources are returned in result passes.
+     * Does not touch engine state, so cooking can run on any thread.
+     */
+    BRK_API void SetCooking(bool cooking) { mCooking = cooking; }
+
+    /**
+     * @brief Use pre-processed passes instead of archetype processing
+     *
+     * @param passes Passes of all techniques in the order of the shader file
+     *               (as returned in cooking mode); must outlive compilation
+     */
+    BRK_API void SetCookedPasses(const std::vector<RHIShaderDesc> *passes) { mCookedPasses = passes; }
+
+    /**
+     * @brief Read archetype name of the shader without compiling it
+     *
+     * @param source Content of the `.shader.xml` file
+     * @param[out] archetype Archetype name of the shader
+     *
+     * @return True if archetype found
+     */
+    BRK_API static bool ParseArchetype(const String &source, StringName &archetype);
+
 private:
     bool ParseShader(tinyxml2::XMLElement *element);
     bool ParseOptions(tinyxml2::XMLElement *element);
@@ -78,6 +123,10 @@ private:
     static bool ParseParamType(const char *typeName, ShaderParamType &type, RHIShaderDataType &dataType, RHIShaderParamType &paramType);
 
 private:
+    const ShaderManager &mManager;
+    const std::vector<RHIShaderDesc> *mCookedPasses = nullptr;
+    bool mCooking = false;
+
     CompilationResult mResult;
 
     Ref<Shader> mShader;
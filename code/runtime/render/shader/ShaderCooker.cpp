@@ -0,0 +1,166 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/io/Logger.hpp>
+#include <render/shader/ShaderCompiler.hpp>
+#include <render/shader/ShaderCooker.hpp>
+
+#include <algorithm>
+
+BRK_NS_BEGIN
+
+ShaderCooker::ShaderCooker(const ShaderManager &manager, FileSystem &fileSystem, JobSystem &jobSystem)
+    : mManager(manager), mFileSystem(fileSystem), mJobSystem(jobSystem) {
+}
+
+void ShaderCooker::AddFile(String path, String fullPath) {
+    mFiles.push_back({std::move(path), std::move(fullPath)});
+}
+
+bool ShaderCooker::Cook(ShaderVariantPack &pack) {
+    struct Source {
+        String content;
+        std::vector<StringName> options;
+        bool valid = false;
+    };
+
+    struct Task {
+        uint32 file;
+        uint32 mask;
+        ShaderVariantPack::Variant variant;
+        String error;
+        uint32 line = 0;
+        bool failed = false;
+    };
+
+    bool success = true;
+    std::vector<Source> sources(mFiles.size());
+    std::vector<Task> tasks;
+
+    // Parse files once to get all exposed options
+    for (size_t i = 0; i < mFiles.size(); i++) {
+        auto &file = mFiles[i];
+        auto &source = sources[i];
+
+        auto data = mFileSystem.ReadFile(file.fullPath);
+        if (data.IsNull()) {
+            BRK_ERROR("Failed to read shader file=" << file.fullPath);
+            success = false;
+            continue;
+        }
+
+        source.content.assign(reinterpret_cast<const char *>(data->GetData()), data->GetSize());
+
+        ShaderCompiler compiler(mManager);
+        compiler.SetCooking(true);
+        auto result = compiler.Compile(file.fullPath, source.content, Ref<ShaderCompileOptions>(new ShaderCompileOptions));
+
+        if (result.shader.IsNull()) {
+            BRK_ERROR("Failed to compile shader path=" << file.fullPath << " line=" << result.line << " error=" << result.error);
+            success = false;
+            continue;
+        }
+
+        for (auto &option : result.shader->GetAllOptions()) {
+            if (std::find(source.options.begin(), source.options.end(), option.name) == source.options.end())
+                source.options.push_back(option.name);
+        }
+
+        if (source.options.size() > mMaxOptions) {
+            BRK_WARNING("Too many options to cook all variants path=" << file.fullPath << " options=" << source.options.size() << " max=" << mMaxOptions);
+            source.options.resize(mMaxOptions);
+        }
+
+        source.valid = true;
+
+        auto variantsCount = static_cast<uint32>(1u) << static_cast<uint32>(source.options.size());
+        for (uint32 mask = 0; mask < variantsCount; mask++) {
+            tasks.emplace_back();
+            tasks.back().file = static_cast<uint32>(i);
+            tasks.back().mask = mask;
+        }
+    }
+
+    // Process permutations in parallel, each task writes only its own slot
+    mJobSystem.ParallelFor(static_cast<uint32>(tasks.size()), 1, [&](uint32 begin, uint32 end) {
+        for (uint32 t = begin; t < end; t++) {
+            auto &task = tasks[t];
+            auto &source = sources[task.file];
+
+            Ref<ShaderCompileOptions> options(new ShaderCompileOptions);
+            for (size_t bit = 0; bit < source.options.size(); bit++) {
+                if (task.mask & (static_cast<uint32>(1u) << static_cast<uint32>(bit))) {
+                    options->Set(source.options[bit]);
+                    task.variant.options.push_back(source.options[bit]);
+                }
+            }
+
+            ShaderCompiler compiler(mManager);
+            compiler.SetCooking(true);
+            auto result = compiler.Compile(mFiles[task.file].fullPath, source.content, options);
+
+            if (result.shader.IsNull()) {
+                task.failed = true;
+                task.error = std::move(result.error);
+                task.line = result.line;
+                continue;
+            }
+
+            task.variant.passes = std::move(result.passes);
+        }
+    });
+
+    // Collect variants into pack entries in files order
+    auto task = tasks.begin();
+
+    for (size_t i = 0; i < mFiles.size(); i++) {
+        auto &source = sources[i];
+
+        if (!source.valid)
+            continue;
+
+        ShaderVariantPack::Entry entry;
+        entry.path = mFiles[i].path;
+        entry.sourceHash = Crc32::Hash(source.content.data(), source.content.size());
+
+        for (; task != tasks.end() && task->file == i; ++task) {
+            if (task->failed) {
+                BRK_ERROR("Failed to cook shader variant path=" << mFiles[i].fullPath << " line=" << task->line << " error=" << task->error);
+                success = false;
+                continue;
+            }
+
+            entry.variants.push_back(std::move(task->variant));
+        }
+
+        pack.AddEntry(std::move(entry));
+    }
+
+    return success;
+}
+
+BRK_NS_END
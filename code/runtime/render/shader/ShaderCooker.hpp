@@ -0,0 +1,110 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_SHADERCOOKER_HPP
+#define BERSERK_SHADERCOOKER_HPP
+
+#include <core/Config.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+#include <platform/FileSystem.hpp>
+#include <render/shader/ShaderManager.hpp>
+#include <render/shader/ShaderVariantPack.hpp>
+
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup render
+ * @{
+ */
+
+/**
+ * @class ShaderCooker
+ * @brief Offline precompiler of shader variants
+ *
+ * Enumerates permutations of options declared by `.shader.xml` files
+ * (including archetype options), processes passes of each permutation
+ * in parallel and collects results into ShaderVariantPack.
+ *
+ * Does not require engine instance or RHI device, so can be used by tools.
+ */
+class ShaderCooker final {
+public:
+    /** Default limit of options to permute (2^N variants per shader) */
+    static const uint32 DEFAULT_MAX_OPTIONS = 8;
+
+    /**
+     * @brief Create cooker
+     *
+     * @param manager Manager with registered archetypes
+     * @param fileSystem File system to read shader files
+     * @param jobSystem Job system to process variants in parallel
+     */
+    BRK_API ShaderCooker(const ShaderManager &manager, FileSystem &fileSystem, JobSystem &jobSystem);
+    BRK_API ~ShaderCooker() = default;
+
+    /** Set max number of options to permute; options beyond the limit are always disabled */
+    BRK_API void SetMaxOptions(uint32 maxOptions) { mMaxOptions = maxOptions; }
+
+    /**
+     * @brief Add shader file to cook
+     *
+     * @param path Path to store in the pack (as passed to ShaderManager::Load at runtime)
+     * @param fullPath Path to read the file
+     */
+    BRK_API void AddFile(String path, String fullPath);
+
+    /**
+     * @brief Cook all added files
+     *
+     * @param pack Pack to add cooked entries
+     * @return True if all variants successfully processed
+     */
+    BRK_API bool Cook(ShaderVariantPack &pack);
+
+private:
+    struct File {
+        String path;
+        String fullPath;
+    };
+
+    const ShaderManager &mManager;
+    FileSystem &mFileSystem;
+    JobSystem &mJobSystem;
+    std::vector<File> mFiles;
+    uint32 mMaxOptions = DEFAULT_MAX_OPTIONS;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_SHADERCOOKER_HPP
@@ -25,10 +25,12 @@
 /* SOFTWARE.                                                                      */
 /**********************************************************************************/
 
+#include <core/Crc32.hpp>
 #include <core/Engine.hpp>
 #include <core/io/Logger.hpp>
 #include <render/shader/ShaderCompiler.hpp>
 #include <render/shader/ShaderManager.hpp>
+#include <render/shader/ShaderVariantPack.hpp>
 
 #include <render/archetypes/ShaderArchetypeBase.hpp>
 
@@ -50,9 +52,49 @@ Ref<const Shader> ShaderManager::Load(const String &filepath, const Ref<ShaderCo
         return Ref<const Shader>();
     }
 
-    // Compile from scratch
-    ShaderCompiler compiler;
-    ShaderCompiler::CompilationResult result = compiler.Compile(fullPath, options);
+    CookedVariant cooked;
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+
+        // Archetype of the file is known if any variant already loaded or cooked
+        auto fileArchetype = mFileArchetypes.find(fullPath);
+        if (fileArchetype != mFileArchetypes.end()) {
+            auto archetype = FindArchetype(fileArchetype->second);
+            assert(archetype);
+
+            VariantKey key;
+            key.path = fullPath;
+            archetype->DefineVariation(*options, key.variation);
+
+            auto cached = mShaders.find(key);
+            if (cached != mShaders.end())
+                return cached->second.As<const Shader>();
+
+            auto query = mCooked.find(key);
+            if (query != mCooked.end()) {
+                cooked = std::move(query->second);
+                mCooked.erase(query);
+            }
+        }
+    }
+
+    // Compile outside of the lock; concurrent load of the same variant may compile it too
+    ShaderCompiler::CompilationResult result;
+
+    if (cooked.passes) {
+        ShaderCompiler compiler(*this);
+        compiler.SetCookedPasses(cooked.passes);
+        result = compiler.Compile(fullPath, *cooked.source, options);
+
+        if (result.shader.IsNull()) {
+            BRK_WARNING("Failed to create cooked shader path=" << fullPath << " error=" << result.error);
+        }
+    }
+
+    if (result.shader.IsNull()) {
+        ShaderCompiler compiler(*this);
+        result = compiler.Compile(fullPath, options);
+    }
 
     // Check result
     if (result.shader.IsNull()) {
@@ -60,7 +102,112 @@ Ref<const Shader> ShaderManager::Load(const String &filepath, const Ref<ShaderCo
         return Ref<const Shader>();
     }
 
-    return result.shader.As<const Shader>();
+    std::lock_guard<std::mutex> guard(mMutex);
+    return AddToCache(fullPath, result.shader).As<const Shader>();
+}
+
+bool ShaderManager::LoadVariantPack(const String &filepath) {
+    auto &fs = Engine::Instance().GetFileSystem();
+    auto fullPath = fs.GetFullFilePath(filepath);
+
+    if (fullPath.empty()) {
+        BRK_INFO("No shader variant pack file=\"" << filepath << "\"");
+        return false;
+    }
+
+    auto pack = std::make_shared<ShaderVariantPack>();
+    if (!pack->Load(fs, fullPath))
+        return false;
+
+    size_t registered = 0;
+
+    for (auto &entry : pack->GetEntries()) {
+        auto shaderPath = fs.GetFullFilePath(entry.path);
+        auto data = shaderPath.empty() ? Ref<Data>() : fs.ReadFile(shaderPath);
+
+        if (data.IsNull()) {
+            BRK_WARNING("Failed to find cooked shader file=\"" << entry.path << "\"");
+            continue;
+        }
+
+        auto source = std::make_shared<const String>(reinterpret_cast<const char *>(data->GetData()), data->GetSize());
+
+        if (Crc32::Hash(source->data(), source->size()) != entry.sourceHash) {
+            BRK_WARNING("Cooked variants are outdated for shader file=\"" << entry.path << "\"");
+            continue;
+        }
+
+        StringName archetypeName;
+        ArchetypePtr archetype;
+
+        if (ShaderCompiler::ParseArchetype(*source, archetypeName))
+            archetype = FindArchetype(archetypeName);
+
+        if (!archetype) {
+            BRK_WARNING("No archetype for cooked shader file=\"" << entry.path << "\"");
+            continue;
+        }
+
+        std::lock_guard<std::mutex> guard(mMutex);
+        mFileArchetypes[shaderPath] = archetypeName;
+
+        for (auto &variant : entry.variants) {
+            ShaderCompileOptions options;
+            for (auto &option : variant.options)
+                options.Set(option);
+
+            VariantKey key;
+            key.path = shaderPath;
+            archetype->DefineVariation(options, key.variation);
+
+            if (mShaders.find(key) != mShaders.end())
+                continue;
+
+            CookedVariant &cooked = mCooked[key];
+            cooked.pack = pack;
+            cooked.source = source;
+            cooked.passes = &variant.passes;
+            registered += 1;
+        }
+    }
+
+    BRK_INFO("Registered shader variants=" << registered << " from pack file=\"" << fullPath << "\"");
+
+    return true;
+}
+
+void ShaderManager::Invalidate(const String &filepath) {
+    auto &fs = Engine::Instance().GetFileSystem();
+    auto fullPath = fs.GetFullFilePath(filepath);
+
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    for (auto iter = mShaders.begin(); iter != mShaders.end();) {
+        if (iter->first.path == fullPath)
+            iter = mShaders.erase(iter);
+        else
+            ++iter;
+    }
+
+    // Cooked variants are outdated if file changed
+    for (auto iter = mCooked.begin(); iter != mCooked.end();) {
+        if (iter->first.path == fullPath)
+            iter = mCooked.erase(iter);
+        else
+            ++iter;
+    }
+
+    mFileArchetypes.erase(fullPath);
+}
+
+size_t ShaderManager::GetCachedCount() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mShaders.size();
+}
+
+size_t ShaderManager::GetCookedCount() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mCooked.size();
 }
 
 bool ShaderManager::IsRegistered(const StringName &archetype) const {
@@ -83,4 +230,16 @@ ShaderManager::ArchetypePtr ShaderManager::FindArchetype(const StringName &arche
     return query != mArchetypes.end() ? query->second : ArchetypePtr();
 }
 
+Ref<Shader> ShaderManager::AddToCache(const String &fullPath, const Ref<Shader> &shader) {
+    VariantKey key;
+    key.path = fullPath;
+    key.variation = shader->GetVariation();
+
+    // Shader of concurrent load of the same variant may be already cached
+    auto inserted = mShaders.emplace(std::move(key), shader);
+    mFileArchetypes[fullPath] = shader->GetArchetype();
+
+    return inserted.first->second;
+}
+
 BRK_NS_END
\ No newline at end of file
@@ -29,11 +29,14 @@
 #define BERSERK_SHADERMANAGER_HPP
 
 #include <core/Config.hpp>
-#include <core/Crc32.hpp>
+#include <core/Hash64.hpp>
 #include <core/Typedefs.hpp>
 #include <render/shader/Shader.hpp>
 #include <render/shader/ShaderArchetype.hpp>
+#include <render/shader/ShaderVariantPack.hpp>
 
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 BRK_NS_BEGIN
@@ -46,6 +49,16 @@ BRK_NS_BEGIN
 /**
  * @class ShaderManager
  * @brief Class for loading and importing engine shaders
+ *
+ * Manager caches loaded shaders by (full path, variation) key, so
+ * materials with the same shader and options share single shader instance.
+ * Variants cooked by `brk-shadercook` can be registered at startup from
+ * variant pack; such variants skip archetype processing on first load.
+ *
+ * Shaders are compiled outside of the manager lock, so loads of different
+ * shaders do not wait for each other.
+ *
+ * @note Thread-safe
  */
 class ShaderManager {
 public:
@@ -66,6 +79,11 @@ public:
      *  cached, the manager will return cached instance handler.
      *  Otherwise new instance must be compiled and cached.
      *
+     * @paragraph
+     *  Returns immediately: shader programs are compiled by RHI asynchronously,
+     *  so passes of the returned shader may be pending compilation. Check
+     *  `Material::IsReady` or pass `IsCompiled` before using it for rendering.
+     *
      * @param filepath Path to shader file; might be relative to game resource folder
      * @param options Set of options to pass to the shader
      *
@@ -73,13 +91,73 @@ public:
      */
     BRK_API Ref<const Shader> Load(const String &filepath, const Ref<ShaderCompileOptions> &options);
 
+    /**
+     * @brief Register cooked variants from pack
+     *
+     * Shaders of variants are created lazily on first load of the variant.
+     * Entries of shader files, changed after cooking, are skipped
+     * (such variants are compiled from scratch on load).
+     *
+     * @param filepath Path to the pack file; might be relative to search paths
+     *
+     * @return True if pack loaded
+     */
+    BRK_API bool LoadVariantPack(const String &filepath);
+
+    /**
+     * @brief Remove cached variants of shader file
+     *
+     * Shaders already loaded from this file remain valid; next load compiles file again.
+     *
+     * @param filepath Path to shader file; might be relative to game resource folder
+     */
+    BRK_API void Invalidate(const String &filepath);
+
+    /** @return Number of cached shader variants */
+    BRK_API size_t GetCachedCount() const;
+
+    /** @return Number of registered cooked variants not loaded yet */
+    BRK_API size_t GetCookedCount() const;
+
     BRK_API bool IsRegistered(const StringName &archetype) const;
     BRK_API void RegisterArchetype(ArchetypePtr archetypePtr);
     BRK_API ArchetypePtr FindArchetype(const StringName &archetype) const;
 
 private:
+    struct VariantKey {
+        String path;
+        ShaderVariation variation;
+
+        bool operator==(const VariantKey &other) const {
+            return variation == other.variation && path == other.path;
+        }
+    };
+
+    struct VariantKeyHash {
+        size_t operator()(const VariantKey &key) const {
+            return static_cast<size_t>(Hash64::Combine(Hash64::Hash(key.path), Hash64::Mix(key.variation)));
+        }
+    };
+
+    /** Cooked variant registered from pack */
+    struct CookedVariant {
+        std::shared_ptr<const ShaderVariantPack> pack;      /** Pack owning variant passes */
+        std::shared_ptr<const String> source;               /** Content of the shader file */
+        const std::vector<RHIShaderDesc> *passes = nullptr; /** Processed passes of the variant */
+    };
+
+    Ref<Shader> AddToCache(const String &fullPath, const Ref<Shader> &shader);
+
     /** Registered archetypes */
     std::unordered_map<StringName, ArchetypePtr> mArchetypes;
+    /** Loaded shaders variants */
+    std::unordered_map<VariantKey, Ref<Shader>, VariantKeyHash> mShaders;
+    /** Cooked variants which shaders are not created yet */
+    std::unordered_map<VariantKey, CookedVariant, VariantKeyHash> mCooked;
+    /** Archetypes of loaded shader files (to get variation before compilation) */
+    std::unordered_map<String, StringName> mFileArchetypes;
+
+    mutable std::mutex mMutex;
 };
 
 /**
@@ -0,0 +1,242 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/io/Logger.hpp>
+#include <render/shader/ShaderVariantPack.hpp>
+
+#include <cstring>
+
+BRK_NS_BEGIN
+
+namespace {
+    /** Identifies variant pack file: 'BRKV' */
+    const uint32 PACK_MAGIC = 0x564b5242;
+    /** Increment on any change of the pack layout */
+    const uint32 PACK_VERSION = 1;
+
+    /** Appends values to pack binary blob */
+    class PackWriter {
+    public:
+        template<typename T>
+        void Write(const T &value) {
+            auto p = reinterpret_cast<const uint8 *>(&value);
+            mBuffer.insert(mBuffer.end(), p, p + sizeof(T));
+        }
+
+        void Write(const String &str) {
+            Write(static_cast<uint32>(str.size()));
+            mBuffer.insert(mBuffer.end(), str.begin(), str.end());
+        }
+
+        void Write(const StringName &name) {
+            Write(name.GetStr());
+        }
+
+        Ref<Data> GetData() const {
+            return Data::Make(mBuffer.data(), mBuffer.size());
+        }
+
+    private:
+        std::vector<uint8> mBuffer;
+    };
+
+    /** Reads values from pack binary blob with bounds checks */
+    class PackReader {
+    public:
+        explicit PackReader(const Ref<Data> &data)
+            : mData(reinterpret_cast<const uint8 *>(data->GetData())), mSize(data->GetSize()) {}
+
+        template<typename T>
+        bool Read(T &value) {
+            if (mOffset + sizeof(T) > mSize)
+                return false;
+            std::memcpy(&value, mData + mOffset, sizeof(T));
+            mOffset += sizeof(T);
+            return true;
+        }
+
+        /** Reads items count (each item takes at least a byte, so it is limited by remaining size) */
+        bool ReadCount(uint32 &count) {
+            return Read(count) && count <= mSize - mOffset;
+        }
+
+        bool Read(String &str) {
+            uint32 length;
+            if (!Read(length) || mOffset + length > mSize)
+                return false;
+            str.assign(reinterpret_cast<const char *>(mData + mOffset), length);
+            mOffset += length;
+            return true;
+        }
+
+        bool Read(StringName &name) {
+            String str;
+            if (!Read(str))
+                return false;
+            name = StringName(str);
+            return true;
+        }
+
+    private:
+        const uint8 *mData;
+        size_t mSize;
+        size_t mOffset = 0;
+    };
+
+    bool ReadPass(PackReader &reader, RHIShaderDesc &pass) {
+        uint32 stagesCount;
+
+        if (!reader.Read(pass.name) || !reader.Read(pass.language) || !reader.ReadCount(stagesCount))
+            return false;
+
+        pass.stages.resize(stagesCount);
+
+        for (auto &stage : pass.stages) {
+            if (!reader.Read(stage.type) || !reader.Read(stage.sourceCode))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ReadVariant(PackReader &reader, ShaderVariantPack::Variant &variant) {
+        uint32 optionsCount;
+        uint32 passesCount;
+
+        if (!reader.ReadCount(optionsCount))
+            return false;
+
+        variant.options.resize(optionsCount);
+        for (auto &option : variant.options) {
+            if (!reader.Read(option))
+                return false;
+        }
+
+        if (!reader.ReadCount(passesCount))
+            return false;
+
+        variant.passes.resize(passesCount);
+        for (auto &pass : variant.passes) {
+            if (!ReadPass(reader, pass))
+                return false;
+        }
+
+        return true;
+    }
+}// namespace
+
+bool ShaderVariantPack::Save(FileSystem &fileSystem, const String &filepath) const {
+    PackWriter writer;
+    writer.Write(PACK_MAGIC);
+    writer.Write(PACK_VERSION);
+    writer.Write(static_cast<uint32>(mEntries.size()));
+
+    for (auto &entry : mEntries) {
+        writer.Write(entry.path);
+        writer.Write(entry.sourceHash);
+        writer.Write(static_cast<uint32>(entry.variants.size()));
+
+        for (auto &variant : entry.variants) {
+            writer.Write(static_cast<uint32>(variant.options.size()));
+            for (auto &option : variant.options)
+                writer.Write(option);
+
+            writer.Write(static_cast<uint32>(variant.passes.size()));
+            for (auto &pass : variant.passes) {
+                writer.Write(pass.name);
+                writer.Write(pass.language);
+                writer.Write(static_cast<uint32>(pass.stages.size()));
+
+                for (auto &stage : pass.stages) {
+                    writer.Write(stage.type);
+                    writer.Write(stage.sourceCode);
+                }
+            }
+        }
+    }
+
+    if (!fileSystem.WriteFile(filepath, writer.GetData())) {
+        BRK_ERROR("Failed to write shader variant pack file=" << filepath);
+        return false;
+    }
+
+    return true;
+}
+
+bool ShaderVariantPack::Load(FileSystem &fileSystem, const String &filepath) {
+    auto data = fileSystem.ReadFile(filepath);
+
+    if (data.IsNull()) {
+        BRK_ERROR("Failed to read shader variant pack file=" << filepath);
+        return false;
+    }
+
+    PackReader reader(data);
+
+    uint32 magic;
+    uint32 version;
+    uint32 entriesCount;
+
+    if (!reader.Read(magic) || !reader.Read(version) || magic != PACK_MAGIC || version != PACK_VERSION) {
+        BRK_ERROR("Invalid shader variant pack file=" << filepath);
+        return false;
+    }
+
+    std::vector<Entry> entries;
+
+    bool valid = reader.ReadCount(entriesCount);
+    if (valid)
+        entries.resize(entriesCount);
+
+    for (auto entry = entries.begin(); valid && entry != entries.end(); ++entry) {
+        uint32 variantsCount;
+        valid = reader.Read(entry->path) && reader.Read(entry->sourceHash) && reader.ReadCount(variantsCount);
+
+        if (valid)
+            entry->variants.resize(variantsCount);
+
+        for (auto variant = entry->variants.begin(); valid && variant != entry->variants.end(); ++variant)
+            valid = ReadVariant(reader, *variant);
+    }
+
+    if (!valid) {
+        BRK_ERROR("Corrupted shader variant pack file=" << filepath);
+        return false;
+    }
+
+    mEntries = std::move(entries);
+    return true;
+}
+
+size_t ShaderVariantPack::GetVariantsCount() const {
+    size_t count = 0;
+    for (auto &entry : mEntries)
+        count += entry.variants.size();
+    return count;
+}
+
+BRK_NS_END
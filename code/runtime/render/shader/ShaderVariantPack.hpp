@@ -0,0 +1,101 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_SHADERVARIANTPACK_HPP
+#define BERSERK_SHADERVARIANTPACK_HPP
+
+#include <core/Config.hpp>
+#include <core/Crc32.hpp>
+#include <core/Typedefs.hpp>
+#include <platform/FileSystem.hpp>
+#include <rhi/RHIShader.hpp>
+
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup render
+ * @{
+ */
+
+/**
+ * @class ShaderVariantPack
+ * @brief Pack of shader variants processed offline
+ *
+ * Stores archetype-processed passes sources for permutations of options
+ * of `.shader.xml` files. Pack is produced by `brk-shadercook` tool and
+ * loaded by ShaderManager at startup, so shaders with cooked variants are
+ * created without parsing and processing on material creation.
+ *
+ * Each entry stores hash of the shader file content; entries of changed
+ * files are considered stale and ignored by runtime.
+ */
+class ShaderVariantPack final {
+public:
+    /** @brief Single cooked permutation of options */
+    struct Variant {
+        std::vector<StringName> options;   /** Options set of the variant */
+        std::vector<RHIShaderDesc> passes; /** Processed passes of all techniques */
+    };
+
+    /** @brief Cooked shader file */
+    struct Entry {
+        String path;                   /** Path of the shader file, relative to search paths */
+        Crc32Hash sourceHash = 0;      /** Hash of the shader file content */
+        std::vector<Variant> variants; /** Cooked variants */
+    };
+
+    BRK_API ShaderVariantPack() = default;
+    BRK_API ~ShaderVariantPack() = default;
+
+    /** Add cooked shader file entry */
+    BRK_API void AddEntry(Entry entry) { mEntries.push_back(std::move(entry)); }
+
+    /** Save pack into file; @return True if saved */
+    BRK_API bool Save(FileSystem &fileSystem, const String &filepath) const;
+
+    /** Load pack from file; @return True if loaded */
+    BRK_API bool Load(FileSystem &fileSystem, const String &filepath);
+
+    /** @return Cooked entries */
+    BRK_API const std::vector<Entry> &GetEntries() const { return mEntries; }
+
+    /** @return Total number of variants in the pack */
+    BRK_API size_t GetVariantsCount() const;
+
+private:
+    std::vector<Entry> mEntries;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_SHADERVARIANTPACK_HPP
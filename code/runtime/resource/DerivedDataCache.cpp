@@ -0,0 +1,303 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/Crc32.hpp>
+#include <core/io/Logger.hpp>
+#include <core/profiler/Counters.hpp>
+#include <resource/DerivedDataCache.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <ctime>
+
+#include <sys/stat.h>
+
+#ifdef BERSERK_TARGET_WINDOWS
+    #include <sys/utime.h>
+#else
+    #include <utime.h>
+#endif
+
+BRK_NS_BEGIN
+
+namespace {
+    /** Identifies cache entry file: 'BRKD' */
+    const uint32 ENTRY_MAGIC = 0x444b5242;
+    /** Increment on any change of the entry layout or checksum */
+    const uint32 ENTRY_VERSION = 2;
+
+    struct EntryHeader {
+        uint32 magic;
+        uint32 version;
+        uint64 size;
+        uint32 crc;
+        uint32 reserved;
+    };
+
+    static_assert(sizeof(EntryHeader) == 24, "Unexpected entry header size");
+
+    bool GetFileInfo(const String &path, uint64 &size, int64 &modified) {
+        struct stat statBuf {};
+        if (stat(path.c_str(), &statBuf) == -1)
+            return false;
+
+        size = static_cast<uint64>(statBuf.st_size);
+        modified = static_cast<int64>(statBuf.st_mtime) * 1000000;
+
+        // Sub-second precision, so entries accessed within a second are ordered
+#if defined(BERSERK_TARGET_LINUX)
+        modified += static_cast<int64>(statBuf.st_mtim.tv_nsec / 1000);
+#elif defined(BERSERK_TARGET_MACOS)
+        modified += static_cast<int64>(statBuf.st_mtimespec.tv_nsec / 1000);
+#endif
+        return true;
+    }
+
+    bool IsKey(const String &name) {
+        return name.size() == 64 && std::all_of(name.begin(), name.end(), [](char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'); });
+    }
+}// namespace
+
+DerivedDataCache::DerivedDataCache(FileSystem &fileSystem, String path, uint64 maxSize)
+    : mFileSystem(fileSystem), mPath(std::move(path)), mMaxSize(maxSize) {
+    if (!mFileSystem.MakeDir(mPath)) {
+        BRK_ERROR("Failed to create derived data cache dir=" << mPath);
+        return;
+    }
+
+    mValid = true;
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    Scan();
+}
+
+Sha256 DerivedDataCache::BeginKey(const String &importer, uint32 version, const Ref<Data> &source) {
+    assert(source.IsNotNull());
+
+    Sha256 hash;
+    hash.Update(ENTRY_VERSION);
+    hash.Update(importer);
+    hash.Update(version);
+    hash.Update(static_cast<uint64>(source->GetSize()));
+    hash.Update(source->GetData(), source->GetSize());
+    return hash;
+}
+
+String DerivedDataCache::MakeKey(Sha256 &hash) {
+    return Sha256::ToHex(hash.Finish());
+}
+
+Ref<Data> DerivedDataCache::Get(const String &key) {
+    assert(IsKey(key));
+
+    auto path = GetEntryPath(key);
+    Ref<Data> data;
+
+    if (mValid && mFileSystem.IsFileExists(path))
+        data = mFileSystem.ReadFile(path);
+
+    if (data.IsNull()) {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mMisses += 1;
+        BRK_COUNTER_ADD("resource.ddc_misses", 1);
+        return Ref<Data>();
+    }
+
+    EntryHeader header{};
+    auto size = data->GetSize();
+    auto *payload = reinterpret_cast<const uint8 *>(data->GetData()) + sizeof(EntryHeader);
+
+    if (size >= sizeof(EntryHeader))
+        std::memcpy(&header, data->GetData(), sizeof(EntryHeader));
+
+    if (size < sizeof(EntryHeader) || header.magic != ENTRY_MAGIC || header.version != ENTRY_VERSION ||
+        header.size != size - sizeof(EntryHeader) || header.crc != Crc32C::Hash(payload, static_cast<size_t>(header.size))) {
+        BRK_WARNING("Corrupted derived data cache entry " << path);
+        std::remove(path.c_str());
+
+        std::lock_guard<std::mutex> guard(mMutex);
+        auto query = mEntries.find(key);
+        if (query != mEntries.end()) {
+            mSize -= query->second.size;
+            mEntries.erase(query);
+        }
+        mMisses += 1;
+        BRK_COUNTER_ADD("resource.ddc_misses", 1);
+        return Ref<Data>();
+    }
+
+    // Modification time is last access time for eviction
+    utime(path.c_str(), nullptr);
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        auto &entry = mEntries[key];
+        mSize += size - entry.size;
+        entry.size = size;
+        mHits += 1;
+        BRK_COUNTER_ADD("resource.ddc_hits", 1);
+    }
+
+    return Data::MakeSubset(data, sizeof(EntryHeader), static_cast<size_t>(header.size));
+}
+
+bool DerivedDataCache::Put(const String &key, const Ref<Data> &data) {
+    assert(IsKey(key));
+    assert(data.IsNotNull());
+
+    if (!mValid)
+        return false;
+
+    static std::atomic<uint32> gTempIndex{0};
+
+    auto path = GetEntryPath(key);
+    auto dir = path.substr(0, path.find_last_of('/'));
+    auto tempPath = path + ".tmp" + std::to_string(gTempIndex.fetch_add(1)) + "-" + std::to_string(std::time(nullptr));
+
+    EntryHeader header{};
+    header.magic = ENTRY_MAGIC;
+    header.version = ENTRY_VERSION;
+    header.size = data->GetSize();
+    header.crc = Crc32C::Hash(data->GetData(), data->GetSize());
+
+    auto entry = Data::Make(sizeof(EntryHeader) + data->GetSize());
+    auto *p = reinterpret_cast<uint8 *>(entry->GetDataWrite());
+    std::memcpy(p, &header, sizeof(EntryHeader));
+    std::memcpy(p + sizeof(EntryHeader), data->GetData(), data->GetSize());
+
+    if (!mFileSystem.MakeDir(dir) || !mFileSystem.WriteFile(tempPath, entry)) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    // Rename does not replace existing file on some platforms
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(path.c_str());
+
+        if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            BRK_ERROR("Failed to store derived data cache entry " << path);
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    auto &info = mEntries[key];
+    mSize += entry->GetSize() - info.size;
+    info.size = entry->GetSize();
+
+    if (mSize > mMaxSize)
+        TrimLocked();
+
+    BRK_GAUGE_SET("resource.ddc_size", mSize);
+    return true;
+}
+
+void DerivedDataCache::Trim() {
+    std::lock_guard<std::mutex> guard(mMutex);
+    TrimLocked();
+}
+
+uint64 DerivedDataCache::GetSize() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mSize;
+}
+
+uint64 DerivedDataCache::GetHitsCount() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mHits;
+}
+
+uint64 DerivedDataCache::GetMissesCount() const {
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mMisses;
+}
+
+String DerivedDataCache::GetEntryPath(const String &key) const {
+    return mPath + "/" + key.substr(0, 2) + "/" + key;
+}
+
+void DerivedDataCache::Scan() {
+    mEntries.clear();
+    mSize = 0;
+
+    for (auto &dir : mFileSystem.ListDir(mPath)) {
+        if (dir.type != FileSystem::EntryType::Directory || dir.name.size() != 2)
+            continue;
+
+        auto dirPath = mPath + "/" + dir.name;
+
+        for (auto &file : mFileSystem.ListDir(dirPath)) {
+            EntryInfo info;
+
+            if (file.type != FileSystem::EntryType::File || !IsKey(file.name))
+                continue;
+            if (!GetFileInfo(dirPath + "/" + file.name, info.size, info.lastAccess))
+                continue;
+
+            mEntries.emplace(file.name, info);
+            mSize += info.size;
+        }
+    }
+}
+
+void DerivedDataCache::TrimLocked() {
+    // Other processes may share directory, so take actual state of it
+    Scan();
+
+    if (mSize <= mMaxSize)
+        return;
+
+    std::vector<std::pair<int64, String>> entries;
+    entries.reserve(mEntries.size());
+    for (auto &entry : mEntries)
+        entries.emplace_back(entry.second.lastAccess, entry.first);
+
+    std::sort(entries.begin(), entries.end());
+
+    // Evict to 3/4 of limit, so following puts do not trim each time
+    auto target = mMaxSize / 4 * 3;
+    uint32 evicted = 0;
+
+    for (auto &entry : entries) {
+        if (mSize <= target)
+            break;
+
+        auto query = mEntries.find(entry.second);
+        std::remove(GetEntryPath(entry.second).c_str());
+        mSize -= query->second.size;
+        mEntries.erase(query);
+        evicted += 1;
+    }
+
+    BRK_COUNTER_ADD("resource.ddc_evictions", evicted);
+    BRK_GAUGE_SET("resource.ddc_size", mSize);
+}
+
+BRK_NS_END
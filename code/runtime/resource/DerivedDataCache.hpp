@@ -0,0 +1,252 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_DERIVEDDATACACHE_HPP
+#define BERSERK_DERIVEDDATACACHE_HPP
+
+#include <core/Config.hpp>
+#include <core/Data.hpp>
+#include <core/Sha256.hpp>
+#include <core/Typedefs.hpp>
+#include <core/string/String.hpp>
+#include <core/templates/Ref.hpp>
+#include <platform/FileSystem.hpp>
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup resource
+ * @{
+ */
+
+/**
+ * @class DerivedDataWriter
+ * @brief Writes values into binary blob of derived data
+ */
+class DerivedDataWriter final {
+public:
+    template<typename T>
+    void Write(const T &value) {
+        Write(&value, sizeof(T));
+    }
+
+    void Write(const void *data, size_t size) {
+        auto p = reinterpret_cast<const uint8 *>(data);
+        mBuffer.insert(mBuffer.end(), p, p + size);
+    }
+
+    void Write(const String &string) {
+        Write(static_cast<uint32>(string.size()));
+        Write(string.data(), string.size());
+    }
+
+    /** Writes data with its size */
+    void Write(const Ref<Data> &data) {
+        Write(static_cast<uint64>(data->GetSize()));
+        Write(data->GetData(), data->GetSize());
+    }
+
+    /** @return Written blob */
+    Ref<Data> GetData() const { return Data::Make(mBuffer.data(), mBuffer.size()); }
+
+private:
+    std::vector<uint8> mBuffer;
+};
+
+/**
+ * @class DerivedDataReader
+ * @brief Reads values from binary blob of derived data with bounds checks
+ */
+class DerivedDataReader final {
+public:
+    explicit DerivedDataReader(const Ref<Data> &data)
+        : mData(reinterpret_cast<const uint8 *>(data->GetData())), mSize(data->GetSize()) {}
+
+    template<typename T>
+    bool Read(T &value) {
+        return Read(&value, sizeof(T));
+    }
+
+    bool Read(void *data, size_t size) {
+        if (size > mSize - mOffset)
+            return false;
+        std::memcpy(data, mData + mOffset, size);
+        mOffset += size;
+        return true;
+    }
+
+    bool Read(String &string) {
+        uint32 length;
+        if (!Read(length) || length > mSize - mOffset)
+            return false;
+        string.assign(reinterpret_cast<const char *>(mData + mOffset), length);
+        mOffset += length;
+        return true;
+    }
+
+    /** Reads data written with its size */
+    bool Read(Ref<Data> &data) {
+        uint64 size;
+        if (!Read(size) || size > mSize - mOffset)
+            return false;
+        data = Data::Make(mData + mOffset, static_cast<size_t>(size));
+        mOffset += static_cast<size_t>(size);
+        return true;
+    }
+
+    /** @return True if all bytes are read */
+    bool IsEnd() const { return mOffset == mSize; }
+
+private:
+    const uint8 *mData;
+    size_t mSize;
+    size_t mOffset = 0;
+};
+
+/**
+ * @class DerivedDataCache
+ * @brief Local directory cache of data derived from source assets
+ *
+ * Importers store results of expensive processing (decoded images,
+ * triangulated meshes) under key, which is sha256 hash of everything
+ * the result depends on: source file bytes, importer name and version
+ * and import options. If nothing changed, next import reads the result
+ * from the cache instead of processing the source again. Since keys
+ * depend only on content, directory can be shared between machines.
+ *
+ * Entries are files `<path>/<key[0:2]>/<key>` with header and crc32 of
+ * payload; corrupted entries are removed on read. Reads update file
+ * modification time, which is used as last access time to evict least
+ * recently used entries when total size exceeds the limit.
+ *
+ * Configured by `resource` section of the engine config: `ddc` (0 to disable),
+ * `ddc.path` (absolute or relative to executable dir) and `ddc.size` (limit in MiB).
+ *
+ * @note Thread-safe
+ */
+class DerivedDataCache final {
+public:
+    /** Default size limit of cache */
+    static const uint64 DEFAULT_MAX_SIZE = 1024ull * 1024ull * 1024ull;
+
+    /**
+     * @brief Create cache in directory
+     *
+     * @param fileSystem File system to access cache files
+     * @param path Full path of the cache directory (created if missing)
+     * @param maxSize Max total size of entries in bytes
+     */
+    BRK_API DerivedDataCache(FileSystem &fileSystem, String path, uint64 maxSize = DEFAULT_MAX_SIZE);
+    BRK_API ~DerivedDataCache() = default;
+
+    /**
+     * @brief Start key of derived data
+     *
+     * @param importer Name of importer (or other producer of data)
+     * @param version Version of importer; increment on any change of produced data
+     * @param source Bytes of source asset
+     *
+     * @return Hash builder; append options and call MakeKey
+     */
+    BRK_API static Sha256 BeginKey(const String &importer, uint32 version, const Ref<Data> &source);
+
+    /** @return Key made from hash of key content */
+    BRK_API static String MakeKey(Sha256 &hash);
+
+    /**
+     * @brief Get cached data
+     *
+     * @param key Key of the data
+     * @return Data or null if not in cache
+     */
+    BRK_API Ref<Data> Get(const String &key);
+
+    /**
+     * @brief Put data into cache
+     *
+     * Entry is written into temporary file and renamed, so concurrent
+     * readers (other threads or processes) never see partial entry.
+     *
+     * @param key Key of the data
+     * @param data Data to store
+     *
+     * @return True if stored
+     */
+    BRK_API bool Put(const String &key, const Ref<Data> &data);
+
+    /** Remove least recently used entries until total size fits the limit */
+    BRK_API void Trim();
+
+    /** @return True if cache directory is available */
+    BRK_API bool IsValid() const { return mValid; }
+
+    /** @return Full path of cache directory */
+    BRK_API const String &GetPath() const { return mPath; }
+
+    /** @return Total size of entries */
+    BRK_API uint64 GetSize() const;
+
+    /** @return Number of hits since creation */
+    BRK_API uint64 GetHitsCount() const;
+
+    /** @return Number of misses since creation */
+    BRK_API uint64 GetMissesCount() const;
+
+private:
+    struct EntryInfo {
+        uint64 size = 0;       /** Size of entry file */
+        int64 lastAccess = 0;  /** Last access time in microseconds (modification time of file) */
+    };
+
+    String GetEntryPath(const String &key) const;
+    void Scan();
+    void TrimLocked();
+
+    FileSystem &mFileSystem;
+    String mPath;
+    uint64 mMaxSize;
+    uint64 mSize = 0;
+    uint64 mHits = 0;
+    uint64 mMisses = 0;
+    bool mValid = false;
+    std::unordered_map<String, EntryInfo> mEntries; /** Known entries by key */
+
+    mutable std::mutex mMutex;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_DERIVEDDATACACHE_HPP
@@ -25,8 +25,12 @@
 /* SOFTWARE.                                                                      */
 /**********************************************************************************/
 
+#include <core/io/Logger.hpp>
 #include <resource/ResMaterial.hpp>
 
+#include <algorithm>
+#include <cassert>
+
 BRK_NS_BEGIN
 
 const StringName &ResMaterial::GetResourceType() const {
@@ -38,4 +42,58 @@ const StringName &ResMaterial::GetResourceTypeStatic() {
     return resourceType;
 }
 
+void ResMaterial::SetMaterial(Ref<Material> material) {
+    mMaterial = std::move(material);
+    mInstances.Reset();
+
+    for (auto &binding : mTextures)
+        BindTexture(binding);
+}
+
+void ResMaterial::SetTexture(const StringName &name, const Ref<ResTexture> &texture, uint32 arrayIndex) {
+    assert(texture);
+
+    auto query = std::find_if(mTextures.begin(), mTextures.end(), [&](const TextureBinding &binding) {
+        return binding.name == name && binding.arrayIndex == arrayIndex;
+    });
+
+    if (query == mTextures.end()) {
+        mTextures.emplace_back();
+        query = mTextures.end() - 1;
+    }
+
+    query->name = name;
+    query->texture = texture;
+    query->arrayIndex = arrayIndex;
+
+    BindTexture(*query);
+}
+
+Ref<MaterialInstance> ResMaterial::CreateInstance() {
+    if (mMaterial.IsNull()) {
+        BRK_ERROR("Cannot create instance of material resource without material");
+        return Ref<MaterialInstance>();
+    }
+
+    if (mInstances.IsNull())
+        mInstances = Ref<MaterialInstancePool>(new MaterialInstancePool(mMaterial));
+
+    return mInstances->CreateInstance();
+}
+
+void ResMaterial::OnDependencyReloaded(const Resource &dependency) {
+    // Reloaded texture has new gpu objects
+    for (auto &binding : mTextures) {
+        if (binding.texture.Get() == &dependency)
+            BindTexture(binding);
+    }
+}
+
+void ResMaterial::BindTexture(const TextureBinding &binding) {
+    if (mMaterial.IsNull())
+        return;
+
+    mMaterial->SetTexture(binding.name, binding.texture->GetRHITexture(), binding.texture->GetRHISampler(), binding.arrayIndex);
+}
+
 BRK_NS_END
\ No newline at end of file
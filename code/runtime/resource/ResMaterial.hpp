@@ -33,6 +33,9 @@
 #include <resource/ResourceImporter.hpp>
 
 #include <render/material/Material.hpp>
+#include <render/material/MaterialInstance.hpp>
+
+#include <vector>
 
 BRK_NS_BEGIN
 
@@ -53,10 +56,50 @@ public:
     BRK_API const StringName &GetResourceType() const override;
     BRK_API static const StringName &GetResourceTypeStatic();
 
+    /** Set internal material object; previously bound textures are bound to new material */
+    BRK_API void SetMaterial(Ref<Material> material);
+
+    /**
+     * @brief Bind texture resource to material param
+     *
+     * Binding is remembered, so texture is bound again after it is hot reloaded.
+     * Register dependency of this material on the texture in `ResourceManager`
+     * to get notified about reload.
+     *
+     * @param name Name of texture param
+     * @param texture Texture to bind
+     * @param arrayIndex Index of element if param is array
+     */
+    BRK_API void SetTexture(const StringName &name, const Ref<ResTexture> &texture, uint32 arrayIndex = 0);
+
+    BRK_API void OnDependencyReloaded(const Resource &dependency) override;
+
+    /**
+     * @brief Create lightweight instance of the material
+     *
+     * Instances of the resource share single pool, so instances with the same
+     * overrides render with the same material. Reloaded textures are rebound to
+     * the parent material and reach instances on their next update.
+     *
+     * @return New instance without overrides (null if material is not set)
+     */
+    BRK_API Ref<MaterialInstance> CreateInstance();
+
     BRK_API const Ref<Material> &GetMaterial() const { return mMaterial; }
 
 private:
-    Ref<Material> mMaterial; /** Internal material object for rendering */
+    struct TextureBinding {
+        StringName name;
+        Ref<ResTexture> texture;
+        uint32 arrayIndex;
+    };
+
+    void BindTexture(const TextureBinding &binding);
+
+private:
+    Ref<Material> mMaterial;               /** Internal material object for rendering */
+    Ref<MaterialInstancePool> mInstances;  /** Pool of material instances (created on first instance) */
+    std::vector<TextureBinding> mTextures; /** Bound texture resources */
 };
 
 /**
@@ -30,6 +30,14 @@
 
 BRK_NS_BEGIN
 
+bool ResMeshImportOptions::WriteKey(Sha256 &hash) const {
+    hash.Update(static_cast<uint32>(meshFormat.value.to_ulong()));
+    hash.Update(flipUVs);
+    hash.Update(triangulate);
+    hash.Update(indexed);
+    return true;
+}
+
 const StringName &ResMesh::GetResourceType() const {
     return GetResourceTypeStatic();
 }
@@ -39,6 +47,16 @@ const StringName &ResMesh::GetResourceTypeStatic() {
     return resourceType;
 }
 
+bool ResMesh::ReloadFrom(Resource &imported) {
+    auto mesh = dynamic_cast<ResMesh *>(&imported);
+    if (!mesh)
+        return false;
+
+    std::swap(mMesh, mesh->mMesh);
+    std::swap(mSubMeshes, mesh->mSubMeshes);
+    return true;
+}
+
 void ResMesh::CreateFromArrays(MeshFormat format, uint32 verticesCount, const MeshArrays &arrays) {
     mMesh.Reset();
     mSubMeshes.clear();
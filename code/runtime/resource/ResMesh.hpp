@@ -52,6 +52,8 @@ public:
     BRK_API ResMeshImportOptions() = default;
     BRK_API ~ResMeshImportOptions() override = default;
 
+    BRK_API bool WriteKey(Sha256 &hash) const override;
+
     MeshFormat meshFormat = {MeshAttribute::Position, MeshAttribute::Normal, MeshAttribute::Tangent, MeshAttribute::UV}; /** Format of the data to import and preserve */
 
     bool flipUVs = true;     /** Flip uv coords on loading */
@@ -81,6 +83,7 @@ public:
 
     BRK_API const StringName &GetResourceType() const override;
     BRK_API static const StringName &GetResourceTypeStatic();
+    BRK_API bool ReloadFrom(Resource &imported) override;
 
     BRK_API void CreateFromArrays(MeshFormat format, uint32 verticesCount, const MeshArrays &arrays);
     BRK_API void CreateFromData(MeshFormat format, uint32 verticesCount, const Ref<Data> &vertexData, const Ref<Data> &attributeData, const Ref<Data> &skinningData);
@@ -38,6 +38,15 @@ const StringName &ResShader::GetResourceTypeStatic() {
     return resourceType;
 }
 
+bool ResShader::ReloadFrom(Resource &imported) {
+    auto shader = dynamic_cast<ResShader *>(&imported);
+    if (!shader)
+        return false;
+
+    std::swap(mShader, shader->mShader);
+    return true;
+}
+
 void ResShader::CreateFromShader(Ref<const Shader> shader) {
     if (shader.IsNull()) {
         BRK_ERROR("An attempt to create shader resource from null shader");
@@ -62,6 +62,7 @@ public:
 
     BRK_API const StringName &GetResourceType() const override;
     BRK_API static const StringName &GetResourceTypeStatic();
+    BRK_API bool ReloadFrom(Resource &imported) override;
 
     BRK_API void CreateFromShader(Ref<const Shader> shader);
     BRK_API bool HasParam(const StringName &name) const;
@@ -30,8 +30,18 @@
 #include <core/io/Logger.hpp>
 #include <resource/ResTexture.hpp>
 
+#include <cstring>
+
 BRK_NS_BEGIN
 
+bool ResTextureImportOptions::WriteKey(Sha256 &hash) const {
+    hash.Update(width);
+    hash.Update(height);
+    hash.Update(channels);
+    hash.Update(static_cast<uint32>(format));
+    return true;
+}
+
 const StringName &ResTexture::GetResourceType() const {
     return GetResourceTypeStatic();
 }
@@ -41,6 +51,21 @@ const StringName &ResTexture::GetResourceTypeStatic() {
     return resourceType;
 }
 
+bool ResTexture::ReloadFrom(Resource &imported) {
+    auto texture = dynamic_cast<ResTexture *>(&imported);
+    if (!texture)
+        return false;
+
+    std::swap(mRHITexture, texture->mRHITexture);
+    std::swap(mRHISampler, texture->mRHISampler);
+    std::swap(mImage, texture->mImage);
+    mFormat = texture->mFormat;
+    mWidth = texture->mWidth;
+    mHeight = texture->mHeight;
+    mMipmaps = texture->mMipmaps;
+    return true;
+}
+
 void ResTexture::CreateFromImage(const Image &image, bool mipmaps, bool cache) {
     if (image.Empty()) {
         BRK_ERROR("an attempt to create texture from empty image");
@@ -69,8 +94,17 @@ void ResTexture::CreateFromImage(const Image &image, bool mipmaps, bool cache) {
     textureDesc.textureUsage = {RHITextureUsage::Sampling};
     mRHITexture = device.CreateTexture(textureDesc);
 
-    // Upload actual data
-    device.UpdateTexture2D(mRHITexture, 0, {0, 0, image.GetWidth(), image.GetHeight()}, image.GetPixelData());
+    // Pixels are copied on calling thread into staging memory, so RHI thread only issues the copy to texture.
+    // Image is not decoded there directly: staging memory is write-only, while importer still reads pixels.
+    auto pixelData = image.GetPixelData();
+    auto upload = device.AllocateUploadData(image.GetSizeBytes());
+
+    if (upload.IsNotNull()) {
+        std::memcpy(upload->GetDataWrite(), pixelData->GetData(), image.GetSizeBytes());
+        pixelData = std::move(upload);
+    }
+
+    device.UpdateTexture2D(mRHITexture, 0, {0, 0, image.GetWidth(), image.GetHeight()}, pixelData);
 
     // Generate mip maps if required
     if (MipMaps())
@@ -51,11 +51,15 @@ public:
     BRK_API ResTextureImportOptions() = default;
     BRK_API ~ResTextureImportOptions() override = default;
 
-    int width = -1;        /** Desired width; -1 use native from file */
-    int height = -1;       /** Desired height; -1 use native from file */
-    bool mipmaps = false;  /** Generate mip maps for texture */
-    bool cacheCPU = false; /** Cache loaded image data on cpu */
-    uint32 channels = 4;   /** Number of color channels to load */
+    /** Writes size, channels and format; mipmaps and caching are applied after import */
+    BRK_API bool WriteKey(Sha256 &hash) const override;
+
+    int width = -1;                                /** Desired width; -1 use native from file */
+    int height = -1;                               /** Desired height; -1 use native from file */
+    bool mipmaps = false;                          /** Generate mip maps for texture */
+    bool cacheCPU = false;                         /** Cache loaded image data on cpu */
+    uint32 channels = 4;                           /** Number of color channels to load */
+    Image::Format format = Image::Format::Unknown; /** Desired texture format; Unknown selects upload format of loaded channels */
 };
 
 /**
@@ -69,6 +73,7 @@ public:
 
     BRK_API const StringName &GetResourceType() const override;
     BRK_API static const StringName &GetResourceTypeStatic();
+    BRK_API bool ReloadFrom(Resource &imported) override;
 
     BRK_API void CreateFromImage(const Image &image, bool mipmaps, bool cache);
     BRK_API void SetSampler(Ref<RHISampler> sampler);
@@ -60,6 +60,23 @@ public:
     BRK_API const String &GetPath() const { return mPath; };
     BRK_API const UUID &GetUUID() const { return mUUID; };
 
+    /**
+     * @brief Replace content with content of reimported resource
+     *
+     * Used for hot reload, so references to this resource remain valid.
+     * Name, path and uuid of this resource are kept.
+     *
+     * @param imported Reimported resource of the same type
+     * @return True if replaced; false if resource does not support reload
+     */
+    BRK_API virtual bool ReloadFrom(Resource &) { return false; }
+
+    /**
+     * @brief Called on game thread after resource this one depends on is reloaded
+     * @param dependency Reloaded resource
+     */
+    BRK_API virtual void OnDependencyReloaded(const Resource &) {}
+
 private:
     StringName mName; /** Resource name */
     String mPath;     /** Load path */
@@ -0,0 +1,209 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <resource/ResourceDependencyGraph.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_set>
+
+BRK_NS_BEGIN
+
+namespace {
+    template<typename T>
+    void RemoveValue(std::vector<T> &values, const T &value) {
+        values.erase(std::remove(values.begin(), values.end(), value), values.end());
+    }
+}// namespace
+
+void ResourceDependencyGraph::AddImported(const Ref<Resource> &resource, const Ref<ResourceImportOptions> &options, const std::vector<String> &files) {
+    assert(resource);
+
+    auto &node = GetOrAdd(resource);
+    node.options = options;
+    node.imported = true;
+
+    RemoveFiles(node);
+    AddFile(node, resource->GetPath());
+
+    for (auto &file : files)
+        AddFile(node, file);
+}
+
+void ResourceDependencyGraph::AddFileDependency(const Ref<Resource> &resource, const String &filepath) {
+    assert(resource);
+    AddFile(GetOrAdd(resource), filepath);
+}
+
+void ResourceDependencyGraph::AddResourceDependency(const Ref<Resource> &resource, const Ref<Resource> &dependency) {
+    assert(resource);
+    assert(dependency);
+
+    if (resource == dependency)
+        return;
+
+    auto &node = GetOrAdd(resource);
+    auto &dependencyNode = GetOrAdd(dependency);
+
+    if (std::find(node.dependencies.begin(), node.dependencies.end(), dependency.Get()) != node.dependencies.end())
+        return;
+
+    node.dependencies.push_back(dependency.Get());
+    dependencyNode.dependants.push_back(resource.Get());
+}
+
+void ResourceDependencyGraph::Remove(const Resource &resource) {
+    auto query = mNodes.find(&resource);
+    if (query == mNodes.end())
+        return;
+
+    auto &node = query->second;
+    RemoveFiles(node);
+
+    for (auto dependency : node.dependencies)
+        RemoveValue(mNodes[dependency].dependants, &resource);
+    for (auto dependant : node.dependants)
+        RemoveValue(mNodes[dependant].dependencies, &resource);
+
+    // Release reference last, graph may hold the only one
+    auto ref = std::move(node.resource);
+    mNodes.erase(query);
+}
+
+uint32 ResourceDependencyGraph::Prune() {
+    uint32 removed = 0;
+    std::vector<const Resource *> unused;
+
+    // Removed dependant may release the last external reference of its dependency
+    do {
+        unused.clear();
+
+        for (auto &entry : mNodes) {
+            if (entry.second.resource.IsUnique())
+                unused.push_back(entry.first);
+        }
+
+        for (auto resource : unused)
+            Remove(*resource);
+
+        removed += static_cast<uint32>(unused.size());
+    } while (!unused.empty());
+
+    return removed;
+}
+
+void ResourceDependencyGraph::Clear() {
+    mFiles.clear();
+    mNodes.clear();
+}
+
+void ResourceDependencyGraph::GetAffected(const std::vector<String> &files, std::vector<Entry> &affected) const {
+    std::unordered_set<const Resource *> visited;
+
+    for (auto &file : files) {
+        auto query = mFiles.find(file);
+        if (query == mFiles.end())
+            continue;
+
+        for (auto resource : query->second) {
+            auto &node = mNodes.at(resource);
+
+            if (node.imported && visited.insert(resource).second) {
+                Entry entry;
+                entry.resource = node.resource;
+                entry.options = node.options;
+                affected.push_back(std::move(entry));
+            }
+        }
+    }
+}
+
+void ResourceDependencyGraph::GetDependants(const Resource &resource, std::vector<Dependant> &dependants) const {
+    auto query = mNodes.find(&resource);
+    if (query == mNodes.end())
+        return;
+
+    std::unordered_set<const Resource *> visited;
+    visited.insert(&resource);
+
+    auto first = dependants.size();
+
+    for (auto dependant : query->second.dependants) {
+        if (visited.insert(dependant).second) {
+            Dependant entry;
+            entry.resource = mNodes.at(dependant).resource;
+            entry.dependency = query->second.resource;
+            dependants.push_back(std::move(entry));
+        }
+    }
+
+    for (auto i = first; i < dependants.size(); i++) {
+        auto &node = mNodes.at(dependants[i].resource.Get());
+
+        for (auto dependant : node.dependants) {
+            if (visited.insert(dependant).second) {
+                Dependant entry;
+                entry.resource = mNodes.at(dependant).resource;
+                entry.dependency = node.resource;
+                dependants.push_back(std::move(entry));
+            }
+        }
+    }
+}
+
+ResourceDependencyGraph::Node &ResourceDependencyGraph::GetOrAdd(const Ref<Resource> &resource) {
+    auto &node = mNodes[resource.Get()];
+
+    if (node.resource.IsNull())
+        node.resource = resource;
+
+    return node;
+}
+
+void ResourceDependencyGraph::AddFile(Node &node, const String &filepath) {
+    if (filepath.empty() || std::find(node.files.begin(), node.files.end(), filepath) != node.files.end())
+        return;
+
+    node.files.push_back(filepath);
+    mFiles[filepath].push_back(node.resource.Get());
+}
+
+void ResourceDependencyGraph::RemoveFiles(Node &node) {
+    for (auto &file : node.files) {
+        auto query = mFiles.find(file);
+        assert(query != mFiles.end());
+
+        RemoveValue(query->second, static_cast<const Resource *>(node.resource.Get()));
+
+        if (query->second.empty())
+            mFiles.erase(query);
+    }
+
+    node.files.clear();
+}
+
+BRK_NS_END
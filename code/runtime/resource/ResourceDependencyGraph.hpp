@@ -0,0 +1,154 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_RESOURCEDEPENDENCYGRAPH_HPP
+#define BERSERK_RESOURCEDEPENDENCYGRAPH_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <resource/Resource.hpp>
+#include <resource/ResourceImporter.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup resource
+ * @{
+ */
+
+/**
+ * @class ResourceDependencyGraph
+ * @brief Dependencies of resources on source files and other resources
+ *
+ * Tracks imported resources together with options used to import them,
+ * so resources affected by changed source files can be reimported.
+ * Edges between resources (for instance from material to its textures)
+ * are used to notify dependants once dependency is reloaded.
+ *
+ * Graph keeps references to tracked resources; `Prune` releases
+ * resources which are not referenced anywhere else.
+ *
+ * @note Not thread-safe
+ */
+class ResourceDependencyGraph final {
+public:
+    /** @brief Imported resource to reimport */
+    struct Entry {
+        Ref<Resource> resource;             /** Tracked resource */
+        Ref<ResourceImportOptions> options; /** Options used to import resource */
+    };
+
+    /** @brief Resource to notify about reloaded dependency */
+    struct Dependant {
+        Ref<Resource> resource;   /** Dependant resource */
+        Ref<Resource> dependency; /** Reloaded (directly or through other dependency) resource */
+    };
+
+    BRK_API ResourceDependencyGraph() = default;
+    BRK_API ~ResourceDependencyGraph() = default;
+
+    /**
+     * @brief Track imported resource
+     *
+     * Replaces source files of already tracked resource,
+     * but keeps its edges to other resources.
+     *
+     * @param resource Resource with full path of the main source file
+     * @param options Options used to import resource
+     * @param files Full paths of other source files read by importer
+     */
+    BRK_API void AddImported(const Ref<Resource> &resource, const Ref<ResourceImportOptions> &options, const std::vector<String> &files);
+
+    /** Add dependency of resource on source file (full path) */
+    BRK_API void AddFileDependency(const Ref<Resource> &resource, const String &filepath);
+
+    /** Add dependency of resource on other resource */
+    BRK_API void AddResourceDependency(const Ref<Resource> &resource, const Ref<Resource> &dependency);
+
+    /** Stop tracking resource */
+    BRK_API void Remove(const Resource &resource);
+
+    /** Stop tracking resources referenced only by graph; @return Number of removed resources */
+    BRK_API uint32 Prune();
+
+    /** Remove all resources */
+    BRK_API void Clear();
+
+    /**
+     * @brief Find imported resources affected by changed files
+     *
+     * @param files Full paths of changed files
+     * @param[out] affected Imported resources, which depend on any of files (each listed once)
+     */
+    BRK_API void GetAffected(const std::vector<String> &files, std::vector<Entry> &affected) const;
+
+    /**
+     * @brief Find resources which depend on resource
+     *
+     * @param resource Reloaded resource
+     * @param[out] dependants Direct and transitive dependants in breadth-first order (each listed once)
+     */
+    BRK_API void GetDependants(const Resource &resource, std::vector<Dependant> &dependants) const;
+
+    /** @return True if resource is tracked */
+    BRK_API bool Contains(const Resource &resource) const { return mNodes.find(&resource) != mNodes.end(); }
+
+    /** @return Number of tracked resources */
+    BRK_API uint32 GetResourcesCount() const { return static_cast<uint32>(mNodes.size()); }
+
+    /** @return Number of tracked source files */
+    BRK_API uint32 GetFilesCount() const { return static_cast<uint32>(mFiles.size()); }
+
+private:
+    struct Node {
+        Ref<Resource> resource;                     /** Tracked resource */
+        Ref<ResourceImportOptions> options;         /** Import options (if imported) */
+        std::vector<String> files;                  /** Source files of the resource */
+        std::vector<const Resource *> dependencies; /** Resources this one depends on */
+        std::vector<const Resource *> dependants;   /** Resources which depend on this one */
+        bool imported = false;                      /** If can be reimported */
+    };
+
+    Node &GetOrAdd(const Ref<Resource> &resource);
+    void AddFile(Node &node, const String &filepath);
+    void RemoveFiles(Node &node);
+
+private:
+    std::unordered_map<const Resource *, Node> mNodes;                 /** Tracked resources */
+    std::unordered_map<String, std::vector<const Resource *>> mFiles; /** Resources by source file */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_RESOURCEDEPENDENCYGRAPH_HPP
@@ -29,6 +29,7 @@
 #define BERSERK_RESOURCEIMPORTER_HPP
 
 #include <core/Config.hpp>
+#include <core/Sha256.hpp>
 #include <core/Typedefs.hpp>
 #include <resource/Resource.hpp>
 
@@ -48,6 +49,14 @@ BRK_NS_BEGIN
 class ResourceImportOptions : public RefCnt {
 public:
     BRK_API ~ResourceImportOptions() override = default;
+
+    /**
+     * @brief Append options, which affect imported data, to key of derived data
+     *
+     * @param hash Hash of the key
+     * @return True if written; false if options do not support derived data cache
+     */
+    BRK_API virtual bool WriteKey(Sha256 &) const { return false; }
 };
 
 /**
@@ -59,6 +68,7 @@ struct ResourceImportResult {
     String error;
     Ref<Resource> resource;
     std::vector<Ref<Resource>> resources;
+    std::vector<String> dependencies; /** Full paths of source files read in addition to imported file */
 };
 
 /**
@@ -91,6 +101,15 @@ public:
      * @param[out] result Result of the import operation
      */
     BRK_API virtual void Import(const String &fullpath, const Ref<ResourceImportOptions> &options, ResourceImportResult &result) = 0;
+
+    /**
+     * @brief Drop data of the file cached by importer
+     *
+     * Called before changed file is reimported.
+     *
+     * @param fullpath Full path to the changed file
+     */
+    BRK_API virtual void Invalidate(const String &) {}
 };
 
 /**
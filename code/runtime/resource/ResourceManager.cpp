@@ -26,6 +26,8 @@
 /**********************************************************************************/
 
 #include <core/Engine.hpp>
+#include <core/profiler/Counters.hpp>
+#include <core/profiler/Profiler.hpp>
 #include <resource/ResourceManager.hpp>
 #include <resource/importers/ImporterMesh.hpp>
 #include <resource/importers/ImporterShader.hpp>
@@ -35,15 +37,51 @@
 
 BRK_NS_BEGIN
 
-ResourceManager::ResourceManager() {
+ResourceManager::ResourceManager(FileSystem *fileSystem, Scheduler *scheduler, JobSystem *jobSystem)
+    : mFileSystem(fileSystem), mScheduler(scheduler), mJobSystem(jobSystem) {
+    assert(mFileSystem);
+    assert(mJobSystem);
+
     // Register default importers
     RegisterImporter(std::make_shared<ImporterMesh>());
     RegisterImporter(std::make_shared<ImporterShader>());
     RegisterImporter(std::make_shared<ImporterTexture>());
 }
 
+ResourceManager::~ResourceManager() {
+    Shutdown();
+}
+
+void ResourceManager::Init() {
+    auto &config = Engine::Instance().GetConfig();
+
+    StringName sectionResource("resource");
+
+    auto hotReload = config.GetProperty(sectionResource, StringName("hotreload"), 0u);
+    auto debounceMs = config.GetProperty(sectionResource, StringName("hotreload.debounce"), static_cast<uint32>(FileWatcher::DEFAULT_DEBOUNCE_MS));
+
+    if (hotReload)
+        EnableHotReload(debounceMs);
+}
+
+void ResourceManager::Shutdown() {
+    std::unique_ptr<FileWatcher> fileWatcher;
+
+    {
+        std::lock_guard<std::recursive_mutex> guard(mMutex);
+        mHotReload = false;
+        fileWatcher = std::move(mFileWatcher);
+    }
+
+    // Stop watcher first, so no new reloads are scheduled (outside of lock, since its callback may lock)
+    fileWatcher.reset();
+
+    std::unique_lock<std::recursive_mutex> lock(mMutex);
+    mReloadJobsCv.wait(lock, [this]() { return mReloadJobs == 0; });
+}
+
 Ref<Resource> ResourceManager::Import(const String &filepath, const Ref<ResourceImportOptions> &options, const UUID &uuid) {
-    auto &fileSystem = Engine::Instance().GetFileSystem();
+    auto &fileSystem = *mFileSystem;
 
     auto path = fileSystem.GetFullFilePath(filepath);
     if (path.empty()) {
@@ -58,9 +96,14 @@ Ref<Resource> ResourceManager::Import(const String &filepath, const Ref<Resource
     }
 
     ResourceImportResult importResult;
+    BRK_PROFILE_TIME(importStart);
     importer->Import(path, options, importResult);
 
+    BRK_COUNTER_ADD("resource.imports", 1);
+    BRK_HISTOGRAM_RECORD("resource.import_time_us", (Profiler::GetTime() - importStart) / 1000u);
+
     if (importResult.failed) {
+        BRK_COUNTER_ADD("resource.import_failures", 1);
         BRK_ERROR("Failed to import resource path=" << filepath << " error=" << importResult.error);
         return Ref<Resource>();
     }
@@ -76,6 +119,12 @@ Ref<Resource> ResourceManager::Import(const String &filepath, const Ref<Resource
     importResult.resource->SetUUID(uuid);
     importResult.resource->SetPath(std::move(path));
 
+    {
+        std::lock_guard<std::recursive_mutex> guard(mMutex);
+        if (mHotReload)
+            mDependencies.AddImported(importResult.resource, options, importResult.dependencies);
+    }
+
     return importResult.resource;
 }
 
@@ -86,11 +135,202 @@ void ResourceManager::RegisterImporter(std::shared_ptr<ResourceImporter> importe
 }
 
 bool ResourceManager::CanImport(const String &filepath) const {
-    auto &fileSystem = Engine::Instance().GetFileSystem();
-    auto ext = fileSystem.GetFileExtension(filepath);
+    auto ext = mFileSystem->GetFileExtension(filepath);
     return FindImporter(ext) != nullptr;
 }
 
+DerivedDataCache *ResourceManager::GetDerivedDataCache() {
+    std::lock_guard<std::recursive_mutex> guard(mMutex);
+
+    if (!mDerivedDataCacheInitialized) {
+        mDerivedDataCacheInitialized = true;
+
+        auto &config = Engine::Instance().GetConfig();
+        auto &fileSystem = *mFileSystem;
+
+        StringName sectionResource("resource");
+
+        auto enabled = config.GetProperty(sectionResource, StringName("ddc"), 1u);
+        auto path = config.GetProperty(sectionResource, StringName("ddc.path"), String("cache/ddc"));
+        auto sizeMiB = config.GetProperty(sectionResource, StringName("ddc.size"), 1024u);
+
+        if (enabled) {
+            path = fileSystem.IsAbsolutePath(path) ? path : fileSystem.GetExecutableDir() + "/" + path;
+            mDerivedDataCache.reset(new DerivedDataCache(fileSystem, path, static_cast<uint64>(sizeMiB) * 1024 * 1024));
+
+            if (!mDerivedDataCache->IsValid())
+                mDerivedDataCache.reset();
+        }
+    }
+
+    return mDerivedDataCache.get();
+}
+
+void ResourceManager::EnableHotReload(uint32 debounceMs) {
+    std::lock_guard<std::recursive_mutex> guard(mMutex);
+
+    if (mHotReload)
+        return;
+
+    mHotReload = true;
+
+    auto &fileSystem = *mFileSystem;
+
+    auto onChanged = [this](const std::vector<String> &files) {
+        // Called on watcher thread, so reload is started on game thread
+        if (mScheduler)
+            mScheduler->ScheduleOnGameThread([this, files]() { Reload(files); });
+        else
+            Reload(files);
+    };
+
+    mFileWatcher.reset(new FileWatcher(std::move(onChanged), debounceMs));
+
+    if (!mFileWatcher->IsValid()) {
+        BRK_WARNING("Search paths are not watched, changed files must be passed to ResourceManager::Reload");
+        mFileWatcher.reset();
+        return;
+    }
+
+    for (auto &path : fileSystem.GetSearchPaths()) {
+        // Skip mounted pak archives
+        if (fileSystem.IsDirExists(path) && !mFileWatcher->AddDirectory(path)) {
+            BRK_WARNING("Failed to watch search path " << path);
+        }
+    }
+
+    BRK_INFO("Hot reload enabled, watched dirs=" << mFileWatcher->GetDirectoriesCount());
+}
+
+bool ResourceManager::IsHotReloadEnabled() const {
+    std::lock_guard<std::recursive_mutex> guard(mMutex);
+    return mHotReload;
+}
+
+void ResourceManager::AddDependency(const Ref<Resource> &resource, const String &filepath) {
+    assert(resource);
+
+    auto path = mFileSystem->GetFullFilePath(filepath);
+    if (path.empty()) {
+        BRK_ERROR("Failed to find full path for resource dependency " << filepath);
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(mMutex);
+    if (mHotReload)
+        mDependencies.AddFileDependency(resource, path);
+}
+
+void ResourceManager::AddDependency(const Ref<Resource> &resource, const Ref<Resource> &dependency) {
+    assert(resource);
+    assert(dependency);
+
+    std::lock_guard<std::recursive_mutex> guard(mMutex);
+    if (mHotReload)
+        mDependencies.AddResourceDependency(resource, dependency);
+}
+
+uint32 ResourceManager::Reload(const std::vector<String> &files) {
+    BRK_PROFILE_SCOPE("ResourceManager::Reload");
+
+    std::lock_guard<std::recursive_mutex> guard(mMutex);
+
+    if (!mHotReload)
+        return 0;
+
+    // Release resources which are not used anymore
+    mDependencies.Prune();
+
+    std::vector<ResourceDependencyGraph::Entry> affected;
+    mDependencies.GetAffected(files, affected);
+
+    for (auto &entry : affected)
+        ReloadResource(entry);
+
+    return static_cast<uint32>(affected.size());
+}
+
+void ResourceManager::ReloadResource(const ResourceDependencyGraph::Entry &entry) {
+    auto reloading = mReloading.find(entry.resource.Get());
+    if (reloading != mReloading.end()) {
+        // Reimport again once current reimport is finished
+        reloading->second = true;
+        return;
+    }
+
+    auto &fileSystem = *mFileSystem;
+    auto &path = entry.resource->GetPath();
+
+    auto importer = FindImporter(fileSystem.GetFileExtension(fileSystem.GetFileName(path)));
+    if (!importer) {
+        BRK_ERROR("Failed to find importer to reload resource path=" << path);
+        return;
+    }
+
+    importer->Invalidate(path);
+
+    mReloading.emplace(entry.resource.Get(), false);
+    mReloadJobs += 1;
+
+    BRK_PROFILE_TIME(started);
+
+    mJobSystem->Submit([this, entry, importer, started]() {
+        BRK_PROFILE_SCOPE("ResourceManager::ReloadJob");
+
+        auto result = std::make_shared<ResourceImportResult>();
+        importer->Import(entry.resource->GetPath(), entry.options, *result);
+
+        if (mScheduler) {
+            mScheduler->ScheduleOnGameThread([this, entry, result, started]() {
+                FinishReload(entry, *result, started);
+            });
+        } else {
+            FinishReload(entry, *result, started);
+        }
+
+        std::lock_guard<std::recursive_mutex> guard(mMutex);
+        mReloadJobs -= 1;
+        mReloadJobsCv.notify_all();
+    });
+}
+
+void ResourceManager::FinishReload(const ResourceDependencyGraph::Entry &entry, const ResourceImportResult &result, uint64 started) {
+    std::vector<ResourceDependencyGraph::Dependant> dependants;
+
+    {
+        std::lock_guard<std::recursive_mutex> guard(mMutex);
+
+        auto &path = entry.resource->GetPath();
+        auto reloading = mReloading.find(entry.resource.Get());
+        assert(reloading != mReloading.end());
+
+        bool changedAgain = reloading->second;
+        mReloading.erase(reloading);
+
+        if (result.failed || result.resource.IsNull()) {
+            BRK_COUNTER_ADD("resource.reload_failures", 1);
+            BRK_ERROR("Failed to reload resource path=" << path << " error=" << result.error);
+        } else if (!entry.resource->ReloadFrom(*result.resource)) {
+            BRK_WARNING("Resource does not support reload path=" << path << " type=" << entry.resource->GetResourceType());
+        } else {
+            BRK_COUNTER_ADD("resource.reloads", 1);
+            BRK_HISTOGRAM_RECORD("resource.reload_time_us", (Profiler::GetTime() - started) / 1000u);
+            BRK_INFO("Reload " << path << " type=" << entry.resource->GetResourceType());
+
+            if (mHotReload) {
+                mDependencies.AddImported(entry.resource, entry.options, result.dependencies);
+                mDependencies.GetDependants(*entry.resource, dependants);
+            }
+        }
+
+        if (changedAgain && mHotReload)
+            ReloadResource(entry);
+    }
+
+    for (auto &dependant : dependants)
+        dependant.resource->OnDependencyReloaded(*dependant.dependency);
+}
+
 ResourceImporter *ResourceManager::FindImporter(const String &ext) const {
     std::lock_guard<std::recursive_mutex> guard(mMutex);
 
@@ -29,10 +29,18 @@
 #define BERSERK_RESOURCEMANAGER_HPP
 
 #include <core/Config.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Scheduler.hpp>
 #include <core/Typedefs.hpp>
+#include <platform/FileSystem.hpp>
+#include <platform/FileWatcher.hpp>
+#include <resource/DerivedDataCache.hpp>
 #include <resource/Resource.hpp>
+#include <resource/ResourceDependencyGraph.hpp>
 #include <resource/ResourceImporter.hpp>
 
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -55,11 +63,36 @@ BRK_NS_BEGIN
  *  - Import some resource using import options
  *  - Load resource with specified id
  *  - Save resource on disc
+ *
+ * With hot reload enabled, imported resources are tracked together with
+ * their source files. Changed files are reimported on job system and
+ * resources are replaced in place on game thread, so references to them
+ * remain valid.
  */
 class ResourceManager {
 public:
-    BRK_API ResourceManager();
-    BRK_API ~ResourceManager() = default;
+    /**
+     * @brief Create manager
+     *
+     * @param fileSystem File system to find and watch resource files
+     * @param scheduler Scheduler to replace reloaded resources on game thread (if null replaced on job thread)
+     * @param jobSystem Job system to reimport changed resources
+     */
+    BRK_API ResourceManager(FileSystem *fileSystem, Scheduler *scheduler, JobSystem *jobSystem);
+
+    /** Calls `Shutdown` if not called yet */
+    BRK_API ~ResourceManager();
+
+    /** Setup manager from `resource` section of engine config */
+    BRK_API void Init();
+
+    /**
+     * @brief Stop hot reload and wait for reimport jobs in flight
+     *
+     * Called by engine before its systems are released, since
+     * importers access engine systems on job threads.
+     */
+    BRK_API void Shutdown();
 
     /**
      * @brief Import resource at specified file location
@@ -91,12 +124,88 @@ public:
      */
     BRK_API bool CanImport(const String &filepath) const;
 
+    /**
+     * @brief Cache of importers derived data
+     *
+     * Created on first call from `resource` section of engine config.
+     *
+     * @return Cache or null if disabled
+     */
+    BRK_API DerivedDataCache *GetDerivedDataCache();
+
+    /**
+     * @brief Enable hot reload of imported resources
+     *
+     * Resources imported after this call are tracked for reload. If supported
+     * by platform, search paths of file system are watched and changed files
+     * are reloaded automatically; otherwise call `Reload` with changed files.
+     *
+     * @param debounceMs Interval without changes before batch of changed files is reloaded
+     */
+    BRK_API void EnableHotReload(uint32 debounceMs = FileWatcher::DEFAULT_DEBOUNCE_MS);
+
+    /** @return True if hot reload is enabled */
+    BRK_API bool IsHotReloadEnabled() const;
+
+    /**
+     * @brief Add dependency of resource on source file
+     *
+     * Resource is reimported when file is changed (if resource is imported)
+     * or notified as dependant of resources, reloaded because of the file.
+     *
+     * @note Does nothing if hot reload is disabled
+     *
+     * @param resource Dependant resource
+     * @param filepath Relative or absolute path of the file
+     */
+    BRK_API void AddDependency(const Ref<Resource> &resource, const String &filepath);
+
+    /**
+     * @brief Add dependency of resource on other resource
+     *
+     * Dependant is notified by `Resource::OnDependencyReloaded` after dependency is reloaded.
+     *
+     * @note Does nothing if hot reload is disabled
+     *
+     * @param resource Dependant resource (for instance material)
+     * @param dependency Resource used by dependant (for instance texture)
+     */
+    BRK_API void AddDependency(const Ref<Resource> &resource, const Ref<Resource> &dependency);
+
+    /**
+     * @brief Reload resources affected by changed files
+     *
+     * Affected resources are reimported as jobs of job system and replaced on
+     * game thread; resource changed again while reimported is reimported once more.
+     *
+     * @note Must be called from game thread (if manager has scheduler); does nothing if hot reload is disabled
+     *
+     * @param files Full paths of changed files
+     * @return Number of resources scheduled for reimport
+     */
+    BRK_API uint32 Reload(const std::vector<String> &files);
+
 private:
     ResourceImporter *FindImporter(const String &ext) const;
+    void ReloadResource(const ResourceDependencyGraph::Entry &entry);
+    void FinishReload(const ResourceDependencyGraph::Entry &entry, const ResourceImportResult &result, uint64 started);
 
 private:
+    FileSystem *mFileSystem;
+    Scheduler *mScheduler;
+    JobSystem *mJobSystem;
+
     std::vector<std::shared_ptr<ResourceImporter>> mImporters;
+    std::unique_ptr<DerivedDataCache> mDerivedDataCache;
+    bool mDerivedDataCacheInitialized = false;
+
+    std::unique_ptr<FileWatcher> mFileWatcher;             /** Watcher of search paths for hot reload */
+    ResourceDependencyGraph mDependencies;                 /** Tracked resources for hot reload */
+    std::unordered_map<const Resource *, bool> mReloading; /** Resources in reimport; true if changed again */
+    uint32 mReloadJobs = 0;                                /** Reimport jobs in flight */
+    bool mHotReload = false;
 
+    std::condition_variable_any mReloadJobsCv;
     mutable std::recursive_mutex mMutex;
 };
 
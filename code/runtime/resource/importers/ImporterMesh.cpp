@@ -27,237 +27,399 @@
 
 #include <core/Engine.hpp>
 #include <core/math/Geometry.hpp>
+#include <core/profiler/Profiler.hpp>
 
+#include <resource/DerivedDataCache.hpp>
 #include <resource/ResMesh.hpp>
 #include <resource/importers/ImporterMesh.hpp>
 
 #include <array>
+#include <cstring>
 #include <vector>
 
 #include <tiny_obj_loader.h>
 
 BRK_NS_BEGIN
 
-ImporterMesh::ImporterMesh() {
-    mExtensions.emplace_back("obj");
-}
+namespace {
+    /** Increment on any change of imported mesh data */
+    const uint32 DDC_VERSION = 1;
+
+    /** Mesh data produced from source file, before creation of gpu resources */
+    struct MeshImportData {
+        struct SubMesh {
+            String name;
+            Aabbf aabb;
+            uint32 indicesCount = 0;
+            Ref<Data> indices;
+        };
+
+        MeshFormat format;
+        uint32 verticesCount = 0;
+        std::vector<Vec3f> positions;
+        std::vector<Vec3f> normals;
+        std::vector<Vec3f> tangents;
+        std::vector<Vec3f> colors;
+        std::vector<Vec2f> uvs;
+        std::vector<SubMesh> subMeshes;
+        Aabbf aabb;
+    };
+
+    template<typename T>
+    void WriteArray(DerivedDataWriter &writer, const std::vector<T> &array) {
+        writer.Write(static_cast<uint64>(array.size() * sizeof(T)));
+        writer.Write(array.data(), array.size() * sizeof(T));
+    }
 
-Ref<ResourceImportOptions> ImporterMesh::CreateDefaultOptions() const {
-    return Ref<ResourceImportOptions>(new ResMeshImportOptions);
-}
+    template<typename T>
+    bool ReadArray(DerivedDataReader &reader, std::vector<T> &array, uint32 expectedSize) {
+        Ref<Data> data;
 
-const std::vector<String> &ImporterMesh::GetSupportedExtensions() const {
-    return mExtensions;
-}
+        if (!reader.Read(data) || (data->GetSize() != expectedSize * sizeof(T) && data->GetSize() != 0))
+            return false;
 
-void ImporterMesh::Import(const String &fullpath, const Ref<ResourceImportOptions> &options, ResourceImportResult &result) {
-    auto opt = options.Cast<ResMeshImportOptions>();
+        array.resize(data->GetSize() / sizeof(T));
+        std::memcpy(static_cast<void *>(array.data()), data->GetData(), data->GetSize());
+        return true;
+    }
 
-    if (opt.IsNull()) {
-        BRK_ERROR("Passed invalid options for import file=" << fullpath);
-        opt = Ref<ResMeshImportOptions>(new ResMeshImportOptions);
+    Ref<Data> WriteMesh(const MeshImportData &mesh) {
+        DerivedDataWriter writer;
+        writer.Write(static_cast<uint32>(mesh.format.value.to_ulong()));
+        writer.Write(mesh.verticesCount);
+        WriteArray(writer, mesh.positions);
+        WriteArray(writer, mesh.normals);
+        WriteArray(writer, mesh.tangents);
+        WriteArray(writer, mesh.colors);
+        WriteArray(writer, mesh.uvs);
+        writer.Write(mesh.aabb.GetMin());
+        writer.Write(mesh.aabb.GetMax());
+        writer.Write(static_cast<uint32>(mesh.subMeshes.size()));
+
+        for (auto &subMesh : mesh.subMeshes) {
+            writer.Write(subMesh.name);
+            writer.Write(subMesh.aabb.GetMin());
+            writer.Write(subMesh.aabb.GetMax());
+            writer.Write(subMesh.indicesCount);
+            writer.Write(subMesh.indices);
+        }
+
+        return writer.GetData();
     }
 
-    using namespace tinyobj;
+    bool ReadAabb(DerivedDataReader &reader, Aabbf &aabb) {
+        Vec3f min;
+        Vec3f max;
 
-    // Import params
-    auto pMeshFormat = opt->meshFormat;
-    auto pTriangulate = opt->triangulate;
-    auto pFlipUVs = opt->flipUVs;
-    auto pIndexed = opt->indexed;
-    auto pFallbackColors = pMeshFormat.Get(MeshAttribute::Color);
+        if (!reader.Read(min) || !reader.Read(max))
+            return false;
 
-    assert(pTriangulate);
-    assert(pIndexed);
+        aabb = Aabbf(min, max);
+        return true;
+    }
 
-    // Imported data
-    attrib_t attrib;
-    std::vector<shape_t> shapes;
-    std::vector<material_t> materials;
-    std::string warning;
-    std::string error;
+    bool ReadMesh(const Ref<Data> &data, MeshImportData &mesh) {
+        DerivedDataReader reader(data);
+        uint32 format;
+        uint32 subMeshesCount;
 
-    // Actual import
-    auto success = LoadObj(&attrib, &shapes, &materials, &warning, &error, fullpath.data(), nullptr, pTriangulate, pFallbackColors);
+        if (!reader.Read(format) || !reader.Read(mesh.verticesCount) ||
+            !ReadArray(reader, mesh.positions, mesh.verticesCount) || !ReadArray(reader, mesh.normals, mesh.verticesCount) ||
+            !ReadArray(reader, mesh.tangents, mesh.verticesCount) || !ReadArray(reader, mesh.colors, mesh.verticesCount) ||
+            !ReadArray(reader, mesh.uvs, mesh.verticesCount) || !ReadAabb(reader, mesh.aabb) ||
+            !reader.Read(subMeshesCount))
+            return false;
 
-    // Always display warning if present
-    if (!warning.empty()) {
-        BRK_WARNING("Warning: \"" << warning << "\" on import file=" << fullpath);
-    }
+        mesh.format.value = std::bitset<8>(format);
 
-    // Check success first
-    if (!success) {
-        result.failed = true;
-        result.error = std::move(error);
-        return;
-    }
+        if (mesh.positions.size() != mesh.verticesCount ||
+            mesh.format.Get(MeshAttribute::Normal) != !mesh.normals.empty() ||
+            mesh.format.Get(MeshAttribute::Tangent) != !mesh.tangents.empty() ||
+            mesh.format.Get(MeshAttribute::Color) != !mesh.colors.empty() ||
+            mesh.format.Get(MeshAttribute::UV) != !mesh.uvs.empty())
+            return false;
 
-    // Check which attributes we have
-    auto hasPosition = !attrib.vertices.empty();
-    auto hasNormal = !attrib.normals.empty() && pMeshFormat.Get(MeshAttribute::Normal);
-    auto hasUV = !attrib.texcoords.empty() && pMeshFormat.Get(MeshAttribute::UV);
-    auto hasColor = !attrib.colors.empty() && pMeshFormat.Get(MeshAttribute::Color);
-    auto hasTangent = hasPosition && hasNormal && hasUV && pMeshFormat.Get(MeshAttribute::Tangent);
-
-    // Position is mandatory
-    if (!hasPosition) {
-        result.failed = true;
-        result.error = BRK_TEXT("No position data in the file");
-        return;
+        for (uint32 i = 0; i < subMeshesCount; i++) {
+            MeshImportData::SubMesh subMesh;
+
+            if (!reader.Read(subMesh.name) || !ReadAabb(reader, subMesh.aabb) ||
+                !reader.Read(subMesh.indicesCount) || !reader.Read(subMesh.indices) ||
+                subMesh.indices->GetSize() != subMesh.indicesCount * sizeof(uint32))
+                return false;
+
+            mesh.subMeshes.push_back(std::move(subMesh));
+        }
+
+        return reader.IsEnd();
     }
 
-    MeshFormat actualFormat;
-    actualFormat.Set(MeshAttribute::Position, hasPosition);
-    actualFormat.Set(MeshAttribute::Normal, hasNormal);
-    actualFormat.Set(MeshAttribute::UV, hasUV);
-    actualFormat.Set(MeshAttribute::Color, hasColor);
-    actualFormat.Set(MeshAttribute::Tangent, hasTangent);
+    bool LoadObj(const String &fullpath, const ResMeshImportOptions &opt, MeshImportData &mesh, ResourceImportResult &result) {
+        using namespace tinyobj;
+
+        // Import params
+        auto pMeshFormat = opt.meshFormat;
+        auto pTriangulate = opt.triangulate;
+        auto pFlipUVs = opt.flipUVs;
+        auto pIndexed = opt.indexed;
+        auto pFallbackColors = pMeshFormat.Get(MeshAttribute::Color);
+
+        assert(pTriangulate);
+        assert(pIndexed);
 
-    static const uint32 VERTICES_PER_FACE = 3;// handle triangles only
+        // Imported data
+        attrib_t attrib;
+        std::vector<shape_t> shapes;
+        std::vector<material_t> materials;
+        std::string warning;
+        std::string error;
 
-    // FLip uvs
-    if (pFlipUVs) {
-        for (size_t i = 1; i < attrib.texcoords.size(); i += 2) {
-            attrib.texcoords[i] = 1.0f - attrib.texcoords[i];
+        // Actual import
+        auto success = tinyobj::LoadObj(&attrib, &shapes, &materials, &warning, &error, fullpath.data(), nullptr, pTriangulate, pFallbackColors);
+
+        // Always display warning if present
+        if (!warning.empty()) {
+            BRK_WARNING("Warning: \"" << warning << "\" on import file=" << fullpath);
         }
-    }
 
-    // Generate tangents
-    std::vector<Vec3f> packedTangents;
-    if (hasTangent) {
-        for (auto &shape : shapes) {
-            auto &mesh = shape.mesh;
-            auto &indices = mesh.indices;
+        // Check success first
+        if (!success) {
+            result.failed = true;
+            result.error = std::move(error);
+            return false;
+        }
+
+        // Check which attributes we have
+        auto hasPosition = !attrib.vertices.empty();
+        auto hasNormal = !attrib.normals.empty() && pMeshFormat.Get(MeshAttribute::Normal);
+        auto hasUV = !attrib.texcoords.empty() && pMeshFormat.Get(MeshAttribute::UV);
+        auto hasColor = !attrib.colors.empty() && pMeshFormat.Get(MeshAttribute::Color);
+        auto hasTangent = hasPosition && hasNormal && hasUV && pMeshFormat.Get(MeshAttribute::Tangent);
+
+        // Position is mandatory
+        if (!hasPosition) {
+            result.failed = true;
+            result.error = BRK_TEXT("No position data in the file");
+            return false;
+        }
 
-            for (uint32 i = 0; i < indices.size(); i += VERTICES_PER_FACE) {
-                // To generate tangent vectors
-                std::array<Vec3f, VERTICES_PER_FACE> positionsPerFace;
-                std::array<Vec3f, VERTICES_PER_FACE> normalsPerFace;
-                std::array<Vec2f, VERTICES_PER_FACE> texCoordsPerFace;
+        MeshFormat &actualFormat = mesh.format;
+        actualFormat.Set(MeshAttribute::Position, hasPosition);
+        actualFormat.Set(MeshAttribute::Normal, hasNormal);
+        actualFormat.Set(MeshAttribute::UV, hasUV);
+        actualFormat.Set(MeshAttribute::Color, hasColor);
+        actualFormat.Set(MeshAttribute::Tangent, hasTangent);
 
-                for (uint32 v = 0; v < VERTICES_PER_FACE; v++) {
-                    auto posX = attrib.vertices[3 * indices[i + v].vertex_index + 0];
-                    auto posY = attrib.vertices[3 * indices[i + v].vertex_index + 1];
-                    auto posZ = attrib.vertices[3 * indices[i + v].vertex_index + 2];
+        static const uint32 VERTICES_PER_FACE = 3;// handle triangles only
+
+        // FLip uvs
+        if (pFlipUVs) {
+            for (size_t i = 1; i < attrib.texcoords.size(); i += 2) {
+                attrib.texcoords[i] = 1.0f - attrib.texcoords[i];
+            }
+        }
 
-                    positionsPerFace[v] = Vec3f(posX, posY, posZ);
+        // Generate tangents
+        std::vector<Vec3f> &packedTangents = mesh.tangents;
+        if (hasTangent) {
+            for (auto &shape : shapes) {
+                auto &shapeMesh = shape.mesh;
+                auto &indices = shapeMesh.indices;
 
-                    auto normX = attrib.normals[3 * indices[i + v].normal_index + 0];
-                    auto normY = attrib.normals[3 * indices[i + v].normal_index + 1];
-                    auto normZ = attrib.normals[3 * indices[i + v].normal_index + 2];
+                for (uint32 i = 0; i < indices.size(); i += VERTICES_PER_FACE) {
+                    // To generate tangent vectors
+                    std::array<Vec3f, VERTICES_PER_FACE> positionsPerFace;
+                    std::array<Vec3f, VERTICES_PER_FACE> normalsPerFace;
+                    std::array<Vec2f, VERTICES_PER_FACE> texCoordsPerFace;
 
-                    normalsPerFace[v] = Vec3f(normX, normY, normZ).Normalized();
+                    for (uint32 v = 0; v < VERTICES_PER_FACE; v++) {
+                        auto posX = attrib.vertices[3 * indices[i + v].vertex_index + 0];
+                        auto posY = attrib.vertices[3 * indices[i + v].vertex_index + 1];
+                        auto posZ = attrib.vertices[3 * indices[i + v].vertex_index + 2];
 
-                    auto texCoordsU = attrib.texcoords[2 * indices[i + v].texcoord_index + 0];
-                    auto texCoordsV = attrib.texcoords[2 * indices[i + v].texcoord_index + 1];
+                        positionsPerFace[v] = Vec3f(posX, posY, posZ);
 
-                    texCoordsPerFace[v] = Vec2f(texCoordsU, texCoordsV);
+                        auto normX = attrib.normals[3 * indices[i + v].normal_index + 0];
+                        auto normY = attrib.normals[3 * indices[i + v].normal_index + 1];
+                        auto normZ = attrib.normals[3 * indices[i + v].normal_index + 2];
+
+                        normalsPerFace[v] = Vec3f(normX, normY, normZ).Normalized();
+
+                        auto texCoordsU = attrib.texcoords[2 * indices[i + v].texcoord_index + 0];
+                        auto texCoordsV = attrib.texcoords[2 * indices[i + v].texcoord_index + 1];
+
+                        texCoordsPerFace[v] = Vec2f(texCoordsU, texCoordsV);
+                    }
+
+                    std::array<Vec3f, VERTICES_PER_FACE> tans;
+                    std::array<Vec3f, VERTICES_PER_FACE> bitans;
+
+                    Geometry::GenTangentSpace(positionsPerFace, normalsPerFace, texCoordsPerFace, tans, bitans);
+
+                    for (uint32 v = 0; v < VERTICES_PER_FACE; v++) {
+                        packedTangents.push_back(tans[v]);
+                    }
                 }
+            }
+        }
 
-                std::array<Vec3f, VERTICES_PER_FACE> tans;
-                std::array<Vec3f, VERTICES_PER_FACE> bitans;
+        std::vector<Vec3f> &packedPositions = mesh.positions;
+        std::vector<Vec3f> &packedNormals = mesh.normals;
+        std::vector<Vec3f> &packedColors = mesh.colors;
+        std::vector<Vec2f> &packedUVs = mesh.uvs;
 
-                Geometry::GenTangentSpace(positionsPerFace, normalsPerFace, texCoordsPerFace, tans, bitans);
+        for (auto &shape : shapes) {
+            auto &shapeMesh = shape.mesh;
+            auto &indices = shapeMesh.indices;
+
+            for (auto &index : indices) {
+                // Positions
+                {
+                    uint32 idx = index.vertex_index;
+                    auto posX = attrib.vertices[3 * idx + 0];
+                    auto posY = attrib.vertices[3 * idx + 1];
+                    auto posZ = attrib.vertices[3 * idx + 2];
+                    packedPositions.emplace_back(posX, posY, posZ);
+                }
 
-                for (uint32 v = 0; v < VERTICES_PER_FACE; v++) {
-                    packedTangents.push_back(tans[v]);
+                if (hasNormal) {
+                    uint32 idx = index.normal_index;
+                    auto normX = attrib.normals[3 * idx + 0];
+                    auto normY = attrib.normals[3 * idx + 1];
+                    auto normZ = attrib.normals[3 * idx + 2];
+                    packedNormals.push_back(Vec3f(normX, normY, normZ).Normalized());
+                }
+                if (hasColor) {
+                    uint32 idx = index.vertex_index;
+                    auto colR = attrib.colors[3 * idx + 0];
+                    auto colG = attrib.colors[3 * idx + 1];
+                    auto colB = attrib.colors[3 * idx + 2];
+                    packedColors.emplace_back(colR, colG, colB);
+                }
+                if (hasUV) {
+                    uint32 idx = index.texcoord_index;
+                    auto texCoordsU = attrib.texcoords[2 * idx + 0];
+                    auto texCoordsV = attrib.texcoords[2 * idx + 1];
+                    packedUVs.emplace_back(texCoordsU, texCoordsV);
                 }
             }
         }
-    }
 
-    std::vector<Vec3f> packedPositions;
-    std::vector<Vec3f> packedNormals;
-    std::vector<Vec3f> packedColors;
-    std::vector<Vec2f> packedUVs;
+        mesh.verticesCount = static_cast<uint32>(packedPositions.size());
+
+        // Create sub-meshes from shapes
+        std::size_t baseIndex = 0;
+
+        for (auto &shape : shapes) {
+            auto &indices = shape.mesh.indices;
+
+            MeshImportData::SubMesh subMesh;
+            subMesh.name = shape.name;
 
-    for (auto &shape : shapes) {
-        auto &mesh = shape.mesh;
-        auto &indices = mesh.indices;
+            std::size_t nextIndex = 0;
+            std::size_t indexSize = RHIGetIndexSize(RHIIndexType::Uint32);
+            std::size_t indicesCount = indices.size();
+            Ref<Data> indicesData = Data::Make(indexSize * indicesCount);
+            auto *indicesGenerated = reinterpret_cast<uint32 *>(indicesData->GetDataWrite());
 
-        for (auto &index : indices) {
-            // Positions
-            {
-                uint32 idx = index.vertex_index;
+            for (std::size_t i = 0; i < indicesCount; i++) {
+                uint32 idx = indices[i].vertex_index;
                 auto posX = attrib.vertices[3 * idx + 0];
                 auto posY = attrib.vertices[3 * idx + 1];
                 auto posZ = attrib.vertices[3 * idx + 2];
-                packedPositions.emplace_back(posX, posY, posZ);
+                auto attribute = Vec3f(posX, posY, posZ);
+                subMesh.aabb.Fit(attribute);
+                indicesGenerated[nextIndex++] = static_cast<uint32>(baseIndex + i);
             }
 
-            if (hasNormal) {
-                uint32 idx = index.normal_index;
-                auto normX = attrib.normals[3 * idx + 0];
-                auto normY = attrib.normals[3 * idx + 1];
-                auto normZ = attrib.normals[3 * idx + 2];
-                packedNormals.push_back(Vec3f(normX, normY, normZ).Normalized());
-            }
-            if (hasColor) {
-                uint32 idx = index.vertex_index;
-                auto colR = attrib.colors[3 * idx + 0];
-                auto colG = attrib.colors[3 * idx + 1];
-                auto colB = attrib.colors[3 * idx + 2];
-                packedColors.emplace_back(colR, colG, colB);
-            }
-            if (hasUV) {
-                uint32 idx = index.texcoord_index;
-                auto texCoordsU = attrib.texcoords[2 * idx + 0];
-                auto texCoordsV = attrib.texcoords[2 * idx + 1];
-                packedUVs.emplace_back(texCoordsU, texCoordsV);
+            subMesh.indicesCount = static_cast<uint32>(indicesCount);
+            subMesh.indices = std::move(indicesData);
+
+            mesh.aabb.Fit(subMesh.aabb);
+            mesh.subMeshes.push_back(std::move(subMesh));
+
+            baseIndex += nextIndex;
+        }
+
+        return true;
+    }
+}// namespace
+
+ImporterMesh::ImporterMesh() {
+    mExtensions.emplace_back("obj");
+}
+
+Ref<ResourceImportOptions> ImporterMesh::CreateDefaultOptions() const {
+    return Ref<ResourceImportOptions>(new ResMeshImportOptions);
+}
+
+const std::vector<String> &ImporterMesh::GetSupportedExtensions() const {
+    return mExtensions;
+}
+
+void ImporterMesh::Import(const String &fullpath, const Ref<ResourceImportOptions> &options, ResourceImportResult &result) {
+    BRK_PROFILE_SCOPE("ImporterMesh::Import");
+
+    auto opt = options.Cast<ResMeshImportOptions>();
+
+    if (opt.IsNull()) {
+        BRK_ERROR("Passed invalid options for import file=" << fullpath);
+        opt = Ref<ResMeshImportOptions>(new ResMeshImportOptions);
+    }
+
+    auto &engine = Engine::Instance();
+    auto *cache = engine.GetResourceManager().GetDerivedDataCache();
+    String key;
+    MeshImportData mesh;
+    bool loaded = false;
+
+    // Parsed and packed mesh is taken from cache if source and options are the same
+    if (cache) {
+        auto source = engine.GetFileSystem().ReadFile(fullpath);
+
+        if (source.IsNotNull()) {
+            auto hash = DerivedDataCache::BeginKey(BRK_TEXT("ImporterMesh"), DDC_VERSION, source);
+
+            if (opt->WriteKey(hash)) {
+                key = DerivedDataCache::MakeKey(hash);
+                auto cached = cache->Get(key);
+
+                if (cached.IsNotNull()) {
+                    loaded = ReadMesh(cached, mesh);
+
+                    if (!loaded) {
+                        BRK_WARNING("Invalid cached mesh for " << fullpath);
+                        mesh = MeshImportData();
+                    }
+                }
             }
         }
     }
 
+    if (!loaded) {
+        if (!LoadObj(fullpath, *opt, mesh, result))
+            return;
+
+        if (!key.empty())
+            cache->Put(key, WriteMesh(mesh));
+    }
+
     // Fill arrays with data
     MeshArrays arrays;
-    arrays.positions = reinterpret_cast<const float *>(packedPositions.data());
-    if (hasNormal) arrays.normals = reinterpret_cast<const float *>(packedNormals.data());
-    if (hasTangent) arrays.tangents = reinterpret_cast<const float *>(packedTangents.data());
-    if (hasColor) arrays.colors = reinterpret_cast<const float *>(packedColors.data());
-    if (hasUV) arrays.uvs = reinterpret_cast<const float *>(packedUVs.data());
-    auto verticesCount = static_cast<uint32>(packedPositions.size());
+    arrays.positions = reinterpret_cast<const float *>(mesh.positions.data());
+    if (!mesh.normals.empty()) arrays.normals = reinterpret_cast<const float *>(mesh.normals.data());
+    if (!mesh.tangents.empty()) arrays.tangents = reinterpret_cast<const float *>(mesh.tangents.data());
+    if (!mesh.colors.empty()) arrays.colors = reinterpret_cast<const float *>(mesh.colors.data());
+    if (!mesh.uvs.empty()) arrays.uvs = reinterpret_cast<const float *>(mesh.uvs.data());
 
     // Create resource mesh from arrays
     Ref<ResMesh> resMesh(new ResMesh);
-    resMesh->SetName(StringName(Engine::Instance().GetFileSystem().GetFileName(fullpath, true)));
-    resMesh->CreateFromArrays(actualFormat, verticesCount, arrays);
-
-    // Create sub-meshes from shapes
-    Aabbf meshAabb;
-    std::size_t baseIndex = 0;
-
-    for (auto &shape : shapes) {
-        auto &mesh = shape.mesh;
-        auto &indices = mesh.indices;
-
-        Aabbf shapeAabb;
-        StringName shapeName(shape.name);
-        RHIPrimitivesType primitivesType = RHIPrimitivesType::Triangles;
-        RHIIndexType indexType = RHIIndexType::Uint32;
-
-        std::size_t nextIndex = 0;
-        std::size_t indexSize = RHIGetIndexSize(indexType);
-        std::size_t indicesCount = indices.size();
-        Ref<Data> indicesData = Data::Make(indexSize * indicesCount);
-        auto *indicesGenerated = reinterpret_cast<uint32 *>(indicesData->GetDataWrite());
-
-        for (std::size_t i = 0; i < indicesCount; i++) {
-            uint32 idx = indices[i].vertex_index;
-            auto posX = attrib.vertices[3 * idx + 0];
-            auto posY = attrib.vertices[3 * idx + 1];
-            auto posZ = attrib.vertices[3 * idx + 2];
-            auto attribute = Vec3f(posX, posY, posZ);
-            shapeAabb.Fit(attribute);
-            indicesGenerated[nextIndex++] = static_cast<uint32>(baseIndex + i);
-        }
+    resMesh->SetName(StringName(engine.GetFileSystem().GetFileName(fullpath, true)));
+    resMesh->CreateFromArrays(mesh.format, mesh.verticesCount, arrays);
 
-        meshAabb.Fit(shapeAabb);
-        resMesh->AddSubMesh(shapeName, primitivesType, shapeAabb, 0, indexType, static_cast<uint32>(indicesCount), indicesData);
-
-        baseIndex += nextIndex;
-    }
+    for (auto &subMesh : mesh.subMeshes)
+        resMesh->AddSubMesh(StringName(subMesh.name), RHIPrimitivesType::Triangles, subMesh.aabb, 0, RHIIndexType::Uint32, subMesh.indicesCount, subMesh.indices);
 
-    resMesh->SetAabb(meshAabb);
+    resMesh->SetAabb(mesh.aabb);
     result.resource = resMesh.As<Resource>();
 }
 
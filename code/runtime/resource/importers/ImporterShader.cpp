@@ -26,6 +26,7 @@
 /**********************************************************************************/
 
 #include <core/Engine.hpp>
+#include <core/profiler/Profiler.hpp>
 #include <resource/ResShader.hpp>
 #include <resource/importers/ImporterShader.hpp>
 
@@ -44,6 +45,8 @@ const std::vector<String> &ImporterShader::GetSupportedExtensions() const {
 }
 
 void ImporterShader::Import(const String &fullpath, const Ref<ResourceImportOptions> &options, ResourceImportResult &result) {
+    BRK_PROFILE_SCOPE("ImporterShader::Import");
+
     auto ops = options.Cast<ResShaderImportOptions>();
     Ref<ShaderCompileOptions> compileOptions;
 
@@ -70,4 +73,9 @@ void ImporterShader::Import(const String &fullpath, const Ref<ResourceImportOpti
     result.resource = resShader.As<Resource>();
 }
 
+void ImporterShader::Invalidate(const String &fullpath) {
+    // Compiled variants of changed file are cached by manager
+    Engine::Instance().GetRenderEngine().GetShaderManager().Invalidate(fullpath);
+}
+
 BRK_NS_END
\ No newline at end of file
@@ -48,6 +48,7 @@ public:
     Ref<ResourceImportOptions> CreateDefaultOptions() const override;
     const std::vector<String> &GetSupportedExtensions() const override;
     void Import(const String &fullpath, const Ref<ResourceImportOptions> &options, ResourceImportResult &result) override;
+    void Invalidate(const String &fullpath) override;
 
 private:
     std::vector<String> mExtensions;
@@ -26,12 +26,45 @@
 /**********************************************************************************/
 
 #include <core/Engine.hpp>
+#include <core/image/ImageConvert.hpp>
+#include <core/image/ImageDecoder.hpp>
 #include <core/io/Logger.hpp>
+#include <core/profiler/Profiler.hpp>
+#include <resource/DerivedDataCache.hpp>
 #include <resource/ResTexture.hpp>
 #include <resource/importers/ImporterTexture.hpp>
 
 BRK_NS_BEGIN
 
+namespace {
+    /** Increment on any change of imported image data */
+    const uint32 DDC_VERSION = 2;
+
+    Ref<Data> WriteImage(const Image &image) {
+        DerivedDataWriter writer;
+        writer.Write(image.GetWidth());
+        writer.Write(image.GetHeight());
+        writer.Write(image.GetStride());
+        writer.Write(image.GetPixelSize());
+        writer.Write(static_cast<uint32>(image.GetFormat()));
+        writer.Write(image.GetPixelData());
+        return writer.GetData();
+    }
+
+    bool ReadImage(const Ref<Data> &data, Image &image) {
+        DerivedDataReader reader(data);
+        uint32 width, height, stride, pixelSize, format;
+        Ref<Data> pixelData;
+
+        if (!reader.Read(width) || !reader.Read(height) || !reader.Read(stride) || !reader.Read(pixelSize) ||
+            !reader.Read(format) || !reader.Read(pixelData) || !reader.IsEnd() || pixelData->GetSize() < static_cast<size_t>(stride) * height)
+            return false;
+
+        image = Image(width, height, stride, pixelSize, static_cast<Image::Format>(format), std::move(pixelData));
+        return true;
+    }
+}// namespace
+
 ImporterTexture::ImporterTexture() {
     mExtensions.emplace_back(BRK_TEXT("png"));
     mExtensions.emplace_back(BRK_TEXT("jpg"));
@@ -53,6 +86,8 @@ const std::vector<String> &ImporterTexture::GetSupportedExtensions() const {
 }
 
 void ImporterTexture::Import(const String &fullpath, const Ref<ResourceImportOptions> &options, ResourceImportResult &result) {
+    BRK_PROFILE_SCOPE("ImporterTexture::Import");
+
     auto ops = options.Cast<ResTextureImportOptions>();
 
     if (ops.IsNull()) {
@@ -60,20 +95,62 @@ void ImporterTexture::Import(const String &fullpath, const Ref<ResourceImportOpt
         ops = Ref<ResTextureImportOptions>(new ResTextureImportOptions);
     }
 
-    auto image = Image::LoadRgba(fullpath, ops->channels);
+    auto &engine = Engine::Instance();
+    auto *cache = engine.GetResourceManager().GetDerivedDataCache();
+    String key;
+    Image image;
 
-    if (image.Empty()) {
-        result.failed = true;
-        result.error = BRK_TEXT("Failed load rgba image");
-        return;
+    // Source is read once and used both for cache key and decoding
+    auto source = engine.GetFileSystem().ReadFile(fullpath);
+
+    // Decoded and resized image is taken from cache if source and options are the same
+    if (cache && source.IsNotNull()) {
+        auto hash = DerivedDataCache::BeginKey(BRK_TEXT("ImporterTexture"), DDC_VERSION, source);
+
+        if (ops->WriteKey(hash)) {
+            key = DerivedDataCache::MakeKey(hash);
+            auto cached = cache->Get(key);
+
+            if (cached.IsNotNull() && !ReadImage(cached, image)) {
+                BRK_WARNING("Invalid cached image for " << fullpath);
+            }
+        }
     }
 
-    if (ops->width > 0 || ops->height > 0) {
-        image = image.Resize(ops->width > 0 ? ops->width : image.GetWidth(), ops->height > 0 ? ops->height : image.GetHeight());
+    if (image.Empty()) {
+        ImageDecoder::Request request;
+        request.filepath = fullpath;
+        request.encoded = source;
+        request.channels = ops->channels;
+        image = ImageDecoder::Decode(request);
+
+        if (image.Empty()) {
+            result.failed = true;
+            result.error = BRK_TEXT("Failed load rgba image");
+            return;
+        }
+
+        if (ops->width > 0 || ops->height > 0) {
+            image = image.Resize(ops->width > 0 ? ops->width : image.GetWidth(), ops->height > 0 ? ops->height : image.GetHeight());
+        }
+
+        // Converted here, so driver does not repack pixels on upload
+        auto format = ops->format != Image::Format::Unknown ? ops->format : ImageConvert::GetUploadFormat(image.GetFormat());
+
+        if (format != image.GetFormat()) {
+            if (ImageConvert::CanConvert(image.GetFormat(), format)) {
+                image = ImageConvert::Convert(image, format, &engine.GetJobSystem());
+            } else {
+                BRK_WARNING("Cannot convert texture " << fullpath << " to requested format");
+            }
+        }
+
+        if (!key.empty())
+            cache->Put(key, WriteImage(image));
     }
 
     Ref<ResTexture> texture(new ResTexture());
-    texture->SetName(StringName(Engine::Instance().GetFileSystem().GetFileName(fullpath, true)));
+    texture->SetName(StringName(engine.GetFileSystem().GetFileName(fullpath, true)));
     texture->CreateFromImage(image, ops->mipmaps, ops->cacheCPU);
 
     // todo: remove
@@ -85,7 +162,7 @@ void ImporterTexture::Import(const String &fullpath, const Ref<ResourceImportOpt
     samplerDesc.u = RHISamplerRepeatMode::Repeat;
     samplerDesc.v = RHISamplerRepeatMode::Repeat;
     samplerDesc.w = RHISamplerRepeatMode::Repeat;
-    auto sampler = Engine::Instance().GetRHIDevice().CreateSampler(samplerDesc);
+    auto sampler = engine.GetRHIDevice().CreateSampler(samplerDesc);
 
     texture->SetSampler(sampler);
     result.resource = texture.As<Resource>();
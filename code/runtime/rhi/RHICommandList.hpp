@@ -31,8 +31,10 @@
 #include <core/Config.hpp>
 #include <core/Data.hpp>
 #include <core/Typedefs.hpp>
+#include <core/string/String.hpp>
 #include <rhi/RHIBuffer.hpp>
 #include <rhi/RHIGraphicsPipeline.hpp>
+#include <rhi/RHIQuery.hpp>
 #include <rhi/RHIRenderPass.hpp>
 #include <rhi/RHIResource.hpp>
 #include <rhi/RHIResourceSet.hpp>
@@ -100,6 +102,21 @@ public:
     /** End render pass (must be called in the end after begin render pass) */
     BRK_API virtual void EndRenderPass() = 0;
 
+    /** Begin named group of commands shown in graphics debuggers (must be followed with end call) */
+    BRK_API virtual void BeginMarker(const String &name) = 0;
+
+    /** End named group of commands */
+    BRK_API virtual void EndMarker() = 0;
+
+    /** Write GPU timestamp to query when previous commands are complete */
+    BRK_API virtual void WriteTimestamp(const Ref<RHITimerQuery> &query) = 0;
+
+    /** Begin counting of samples passed by following draws (queries can not be nested) */
+    BRK_API virtual void BeginOcclusionQuery(const Ref<RHIOcclusionQuery> &query) = 0;
+
+    /** End counting of samples passed */
+    BRK_API virtual void EndOcclusionQuery(const Ref<RHIOcclusionQuery> &query) = 0;
+
     /** Request buffers swap */
     BRK_API virtual void SwapBuffers(const Ref<Window> &window) = 0;
 
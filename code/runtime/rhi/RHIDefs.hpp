@@ -355,6 +355,8 @@ struct RHIDeviceCaps {
     uint32 uniformBlockOffsetAlignment;
     float maxAnisotropy;
     bool supportAnisotropy;
+    bool supportTimerQuery;
+    bool supportDebugMarkers;
 };
 
 /** @return Host data size of value of specified type */
@@ -151,6 +151,10 @@ void RHIDevice::UpdateTextureCube(const Ref<RHITexture> &texture, RHITextureCube
     });
 }
 
+Ref<Data> RHIDevice::AllocateUploadData(size_t) {
+    return Ref<Data>();
+}
+
 void RHIDevice::UpdateResourceSet(const Ref<RHIResourceSet> &set, const RHIResourceSetDesc &desc) {
     BRK_RENDER_THREAD_SETUP
 
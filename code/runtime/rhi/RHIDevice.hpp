@@ -35,6 +35,7 @@
 #include <rhi/RHIDefs.hpp>
 #include <rhi/RHIFramebuffer.hpp>
 #include <rhi/RHIGraphicsPipeline.hpp>
+#include <rhi/RHIQuery.hpp>
 #include <rhi/RHIRenderPass.hpp>
 #include <rhi/RHIResource.hpp>
 #include <rhi/RHIResourceSet.hpp>
@@ -101,6 +102,12 @@ public:
     /** @return CreateFromImage and compile pipeline from desc */
     BRK_API virtual Ref<RHIGraphicsPipeline> CreateGraphicsPipeline(const RHIGraphicsPipelineDesc &desc) = 0;
 
+    /** @return Create timer query */
+    BRK_API virtual Ref<RHITimerQuery> CreateTimerQuery() = 0;
+
+    /** @return Create occlusion query */
+    BRK_API virtual Ref<RHIOcclusionQuery> CreateOcclusionQuery() = 0;
+
     /** Update vertex buffer with data */
     BRK_API virtual void UpdateVertexBuffer(const Ref<RHIVertexBuffer> &buffer, uint32 byteOffset, uint32 byteSize, const Ref<Data> &data);
 
@@ -125,6 +132,18 @@ public:
     /** Update resource set */
     BRK_API virtual void UpdateResourceSet_RT(const Ref<RHIResourceSet> &set, const RHIResourceSetDesc &desc) = 0;
 
+    /**
+     * @brief Allocate memory for texture update data (thread-safe)
+     *
+     * Returns memory visible to the driver (staging memory), so pixels
+     * written by the caller are copied to the texture without intermediate
+     * driver copy. Fill memory before the update call.
+     *
+     * @param size Size in bytes of the memory
+     * @return Writable data of size bytes; null if backend has no free upload memory
+     */
+    BRK_API virtual Ref<Data> AllocateUploadData(size_t size);
+
     /** Generate mip maps for the texture (2d, 2d array, cube) */
     BRK_API virtual void GenerateMipMaps(const Ref<RHITexture> &texture);
 
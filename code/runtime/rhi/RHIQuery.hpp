@@ -0,0 +1,96 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_RHIQUERY_HPP
+#define BERSERK_RHIQUERY_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <rhi/RHIResource.hpp>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup rhi
+ * @{
+ */
+
+/**
+ * @class RHIQuery
+ * @brief RHI query object
+ *
+ * Query is issued by the command list and its result becomes
+ * available when the GPU reaches the query, usually a few frames later.
+ * Results are polled without stalling the pipeline.
+ */
+class RHIQuery : public RHIResource {
+public:
+    BRK_API ~RHIQuery() override = default;
+
+    /**
+     * @brief Poll query result without blocking
+     *
+     * @warning Must be called on rhi thread only
+     *
+     * @param[out] result Query result, set only if available
+     * @return True if result is available
+     */
+    BRK_API virtual bool GetResult_RT(uint64 &result) = 0;
+};
+
+/**
+ * @class RHITimerQuery
+ * @brief Query of GPU timestamp (result in nanoseconds)
+ *
+ * Written by `RHICommandList::WriteTimestamp` when all previous
+ * commands are complete. Difference of two timestamps is GPU time
+ * of commands between them.
+ */
+class RHITimerQuery : public RHIQuery {
+public:
+    BRK_API ~RHITimerQuery() override = default;
+};
+
+/**
+ * @class RHIOcclusionQuery
+ * @brief Query of number of samples passed depth and stencil tests
+ *
+ * Counts samples of draws between `RHICommandList::BeginOcclusionQuery`
+ * and `RHICommandList::EndOcclusionQuery` calls.
+ */
+class RHIOcclusionQuery : public RHIQuery {
+public:
+    BRK_API ~RHIOcclusionQuery() override = default;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_RHIQUERY_HPP
@@ -26,31 +26,38 @@
 /**********************************************************************************/
 
 #include <core/Engine.hpp>
+#include <core/profiler/Counters.hpp>
+#include <core/profiler/Profiler.hpp>
 #include <rhi/opengl/GLBuffer.hpp>
 #include <rhi/opengl/GLCommandList.hpp>
 #include <rhi/opengl/GLDevice.hpp>
+#include <rhi/opengl/GLQuery.hpp>
 #include <rhi/opengl/GLTexture.hpp>
 
 #include <cassert>
 
 BRK_NS_BEGIN
 
-#define BRK_GL_UPDATE_BUFFER(gl_type)       \
-    assert(!mInRenderPass);                 \
-    assert(buffer.IsNotNull());             \
-    assert(data.IsNotNull());               \
-    auto native = (gl_type *) buffer.Get(); \
-    native->Update(byteOffset, byteSize, data->GetData());
+#define BRK_GL_UPDATE_BUFFER(gl_type)                      \
+    assert(!mInRenderPass);                                \
+    assert(buffer.IsNotNull());                            \
+    assert(data.IsNotNull());                              \
+    auto native = (gl_type *) buffer.Get();                \
+    native->Update(byteOffset, byteSize, data->GetData()); \
+    BRK_COUNTER_ADD("rhi.buffer_upload_bytes", byteSize);
 
 void GLCommandList::UpdateVertexBuffer(const Ref<RHIVertexBuffer> &buffer, uint32 byteOffset, uint32 byteSize, const Ref<Data> &data) {
+    BRK_PROFILE_SCOPE("GLCommandList::UpdateVertexBuffer");
     BRK_GL_UPDATE_BUFFER(GLVertexBuffer);
 }
 
 void GLCommandList::UpdateIndexBuffer(const Ref<RHIIndexBuffer> &buffer, uint32 byteOffset, uint32 byteSize, const Ref<Data> &data) {
+    BRK_PROFILE_SCOPE("GLCommandList::UpdateIndexBuffer");
     BRK_GL_UPDATE_BUFFER(GLIndexBuffer);
 }
 
 void GLCommandList::UpdateUniformBuffer(const Ref<RHIUniformBuffer> &buffer, uint32 byteOffset, uint32 byteSize, const Ref<Data> &data) {
+    BRK_PROFILE_SCOPE("GLCommandList::UpdateUniformBuffer");
     BRK_GL_UPDATE_BUFFER(GLUniformBuffer);
 }
 
@@ -61,55 +68,93 @@ void GLCommandList::UpdateUniformBuffer(const Ref<RHIUniformBuffer> &buffer, uin
     assert(texture.IsNotNull()); \
     auto native = (GLTexture *) texture.Get();
 
-#define BRK_GL_TEXTURE_UPDATE_SETUP \
-    assert(data.IsNotNull());       \
-    BRK_GL_TEXTURE_SETUP
+// Uploads from staging memory may be deferred by upload queue to fit frame budget
+#define BRK_GL_TEXTURE_UPDATE_SETUP                                            \
+    assert(data.IsNotNull());                                                  \
+    BRK_COUNTER_ADD("rhi.texture_upload_bytes", data->GetSize());              \
+    BRK_GL_TEXTURE_SETUP                                                       \
+    auto &device = static_cast<GLDevice &>(Engine::Instance().GetRHIDevice()); \
+    GLuint stagingBuffer;                                                      \
+    size_t stagingOffset;                                                      \
+    auto staged = device.GetStagingPool().Find(data->GetData(), stagingBuffer, stagingOffset);
 
 void GLCommandList::UpdateTexture2D(const Ref<RHITexture> &texture, uint32 mipLevel, const Rect2u &region, const Ref<Data> &data) {
+    BRK_PROFILE_SCOPE("GLCommandList::UpdateTexture2D");
     BRK_GL_TEXTURE_UPDATE_SETUP;
-    native->UpdateTexture2D(mipLevel, region, data);
+    device.GetUploadQueue().Submit(Ref<GLTexture>(native), data->GetSize(), staged, [=]() {
+        native->UpdateTexture2D(mipLevel, region, data);
+    });
 }
 
 void GLCommandList::UpdateTexture2DArray(const Ref<RHITexture> &texture, uint32 arrayIndex, uint32 mipLevel, const Rect2u &region, const Ref<Data> &data) {
+    BRK_PROFILE_SCOPE("GLCommandList::UpdateTexture2DArray");
     BRK_GL_TEXTURE_UPDATE_SETUP;
-    native->UpdateTexture2DArray(arrayIndex, mipLevel, region, data);
+    device.GetUploadQueue().Submit(Ref<GLTexture>(native), data->GetSize(), staged, [=]() {
+        native->UpdateTexture2DArray(arrayIndex, mipLevel, region, data);
+    });
 }
 
 void GLCommandList::UpdateTextureCube(const Ref<RHITexture> &texture, RHITextureCubemapFace face, uint32 mipLevel, const Rect2u &region, const Ref<Data> &data) {
+    BRK_PROFILE_SCOPE("GLCommandList::UpdateTextureCube");
     BRK_GL_TEXTURE_UPDATE_SETUP;
-    native->UpdateTextureCube(face, mipLevel, region, data);
+    device.GetUploadQueue().Submit(Ref<GLTexture>(native), data->GetSize(), staged, [=]() {
+        native->UpdateTextureCube(face, mipLevel, region, data);
+    });
 }
 
 void GLCommandList::GenerateMipMaps(const Ref<RHITexture> &texture) {
+    BRK_PROFILE_SCOPE("GLCommandList::GenerateMipMaps");
     BRK_GL_TEXTURE_SETUP;
-    native->GenerateMipMaps();
+    auto &device = static_cast<GLDevice &>(Engine::Instance().GetRHIDevice());
+    device.GetUploadQueue().Submit(Ref<GLTexture>(native), 0, false, [=]() {
+        native->GenerateMipMaps();
+    });
 }
 
 #undef BRK_GL_TEXTURE_UPDATE_SETUP
 #undef BRK_GL_TEXTURE_SETUP
 
 void GLCommandList::BeginRenderPass(const Ref<RHIRenderPass> &renderPass, const RHIRenderPassBeginInfo &beginInfo) {
+    BRK_PROFILE_SCOPE("GLCommandList::BeginRenderPass");
     assert(!mInRenderPass);
     assert(renderPass.IsNotNull());
 
     mRenderPass = std::move(renderPass.Cast<GLRenderPass>());
     mRenderPass->Bind(mStateVars, beginInfo);
     mInRenderPass = true;
+
+    BRK_COUNTER_ADD("rhi.render_passes", 1);
 }
 
 void GLCommandList::BindGraphicsPipeline(const Ref<RHIGraphicsPipeline> &pipeline) {
+    BRK_PROFILE_SCOPE("GLCommandList::BindGraphicsPipeline");
     assert(mInRenderPass);
     assert(pipeline.IsNotNull());
     assert(pipeline->GetDesc().renderPass.Get() == static_cast<RHIRenderPass *>(mRenderPass.Get()));
 
     PipelineCleanUp();
 
+    auto status = pipeline->GetDesc().shader->GetCompilationStatus();
+
+    // Failed shader has no program to draw with: report it once, then drop its draws
+    if (status == RHIShader::Status::FailedCompile)
+        pipeline->GetDesc().shader.Cast<GLShader>()->ReportFailedUse();
+
+    // Shader still compiles: draws of this pipeline are skipped until it is ready
+    mSkipDraws = status == RHIShader::Status::PendingCompilation;
+    mShaderFailed = status == RHIShader::Status::FailedCompile;
+    mPipelineBound = true;
+
+    if (mSkipDraws || mShaderFailed)
+        return;
+
+    BRK_COUNTER_ADD("rhi.pipeline_binds", 1);
+
     mGraphicsPipeline = std::move(pipeline.Cast<GLGraphicsPipeline>());
     mGraphicsPipeline->Bind(mStateVars);
     mShader = std::move(mGraphicsPipeline->GetDesc().shader.Cast<GLShader>());
     mVaoDesc.declaration = mGraphicsPipeline->GetDesc().declaration;
     mPrimitivesType = GLDefs::GetPrimitivesType(mGraphicsPipeline->GetDesc().primitivesType);
-    mPipelineBound = true;
 }
 
 void GLCommandList::BindVertexBuffers(const std::vector<Ref<RHIVertexBuffer>> &buffers) {
@@ -132,20 +177,38 @@ void GLCommandList::BindIndexBuffer(const Ref<RHIIndexBuffer> &buffer, RHIIndexT
 }
 
 void GLCommandList::BindResourceSet(const Ref<RHIResourceSet> &resourceSet, uint32 set) {
+    BRK_PROFILE_SCOPE("GLCommandList::BindResourceSet");
     assert(mPipelineBound);
     assert(resourceSet.IsNotNull());
     assert(set < RHILimits::MAX_RESOURCE_SETS);
 
+    if (mSkipDraws || mShaderFailed)
+        return;
+
     mSets[set] = std::move(resourceSet.Cast<GLResourceSet>());
     mSets[set]->Bind(mResourceBindingState, mShader);
+
+    BRK_COUNTER_ADD("rhi.resource_set_binds", 1);
 }
 
 void GLCommandList::Draw(uint32 verticesCount, uint32 baseVertex, uint32 instancesCount) {
+    BRK_PROFILE_SCOPE("GLCommandList::Draw");
     assert(mPipelineBound);
 
+    if (mSkipDraws) {
+        BRK_COUNTER_ADD("rhi.draw_calls_skipped", 1);
+        return;
+    }
+
+    if (mShaderFailed) {
+        BRK_COUNTER_ADD("rhi.draw_calls_dropped", 1);
+        return;
+    }
+
     if (mNeedUpdateVao) {
         mCurrentVao = mVaoCache.GetOrCreateVao(mVaoDesc);
         mNeedUpdateVao = false;
+        BRK_COUNTER_ADD("rhi.vao_binds", 1);
     }
 
     glBindVertexArray(mCurrentVao);
@@ -153,14 +216,30 @@ void GLCommandList::Draw(uint32 verticesCount, uint32 baseVertex, uint32 instanc
 
     glDrawArraysInstanced(mPrimitivesType, static_cast<GLint>(baseVertex), static_cast<GLint>(verticesCount), static_cast<GLsizei>(instancesCount));
     BRK_GL_CATCH_ERR();
+
+    BRK_COUNTER_ADD("rhi.draw_calls", 1);
+    BRK_COUNTER_ADD("rhi.vertices", static_cast<uint64>(verticesCount) * instancesCount);
+    BRK_HISTOGRAM_RECORD("rhi.draw_instances", instancesCount);
 }
 
 void GLCommandList::DrawIndexed(uint32 indexCount, uint32 baseVertex, uint32 instanceCount) {
+    BRK_PROFILE_SCOPE("GLCommandList::DrawIndexed");
     assert(mPipelineBound);
 
+    if (mSkipDraws) {
+        BRK_COUNTER_ADD("rhi.draw_calls_skipped", 1);
+        return;
+    }
+
+    if (mShaderFailed) {
+        BRK_COUNTER_ADD("rhi.draw_calls_dropped", 1);
+        return;
+    }
+
     if (mNeedUpdateVao) {
         mCurrentVao = mVaoCache.GetOrCreateVao(mVaoDesc);
         mNeedUpdateVao = false;
+        BRK_COUNTER_ADD("rhi.vao_binds", 1);
     }
 
     glBindVertexArray(mCurrentVao);
@@ -168,18 +247,59 @@ void GLCommandList::DrawIndexed(uint32 indexCount, uint32 baseVertex, uint32 ins
 
     glDrawElementsInstancedBaseVertex(mPrimitivesType, static_cast<GLint>(indexCount), mIndexType, nullptr, static_cast<GLsizei>(instanceCount), static_cast<GLint>(baseVertex));
     BRK_GL_CATCH_ERR();
+
+    BRK_COUNTER_ADD("rhi.draw_calls", 1);
+    BRK_COUNTER_ADD("rhi.vertices", static_cast<uint64>(indexCount) * instanceCount);
+    BRK_HISTOGRAM_RECORD("rhi.draw_instances", instanceCount);
 }
 
 void GLCommandList::EndRenderPass() {
+    BRK_PROFILE_SCOPE("GLCommandList::EndRenderPass");
     assert(mInRenderPass);
 
     PipelineCleanUp();
     mStateVars.Reset();
     mInRenderPass = false;
     mPipelineBound = false;
+    mSkipDraws = false;
+    mShaderFailed = false;
+}
+
+void GLCommandList::BeginMarker(const String &name) {
+    // Debug groups are available only with KHR_debug (core since 4.3)
+    if (GLEW_KHR_debug) {
+        glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name.c_str());
+        BRK_GL_CATCH_ERR();
+    }
+}
+
+void GLCommandList::EndMarker() {
+    if (GLEW_KHR_debug) {
+        glPopDebugGroup();
+        BRK_GL_CATCH_ERR();
+    }
+}
+
+void GLCommandList::WriteTimestamp(const Ref<RHITimerQuery> &query) {
+    assert(query.IsNotNull());
+    auto native = (GLTimerQuery *) query.Get();
+    native->Write();
+}
+
+void GLCommandList::BeginOcclusionQuery(const Ref<RHIOcclusionQuery> &query) {
+    assert(query.IsNotNull());
+    auto native = (GLOcclusionQuery *) query.Get();
+    native->Begin();
+}
+
+void GLCommandList::EndOcclusionQuery(const Ref<RHIOcclusionQuery> &query) {
+    assert(query.IsNotNull());
+    auto native = (GLOcclusionQuery *) query.Get();
+    native->End();
 }
 
 void GLCommandList::SwapBuffers(const Ref<Window> &window) {
+    BRK_PROFILE_SCOPE("GLCommandList::SwapBuffers");
     assert(!mInRenderPass);
     auto &engine = Engine::Instance();
     auto *device = (GLDevice *) &engine.GetRHIDevice();
@@ -187,7 +307,12 @@ void GLCommandList::SwapBuffers(const Ref<Window> &window) {
 }
 
 void GLCommandList::Submit() {
-    // nothing to do
+    BRK_PROFILE_SCOPE("GLCommandList::Submit");
+    auto &device = static_cast<GLDevice &>(Engine::Instance().GetRHIDevice());
+    device.GetShaderCompileQueue().Update();
+    device.GetUploadQueue().Update();
+    device.GetStagingPool().Update();
+
     mSubmitCount += 1;
     mVaoCache.GC();
 }
@@ -71,6 +71,12 @@ public:
     BRK_API void DrawIndexed(uint32 indexCount, uint32 baseVertex, uint32 instanceCount) override;
     BRK_API void EndRenderPass() override;
 
+    BRK_API void BeginMarker(const String &name) override;
+    BRK_API void EndMarker() override;
+    BRK_API void WriteTimestamp(const Ref<RHITimerQuery> &query) override;
+    BRK_API void BeginOcclusionQuery(const Ref<RHIOcclusionQuery> &query) override;
+    BRK_API void EndOcclusionQuery(const Ref<RHIOcclusionQuery> &query) override;
+
     BRK_API void SwapBuffers(const Ref<Window> &window) override;
     BRK_API void Submit() override;
 
@@ -93,6 +99,8 @@ private:
 
     bool mInRenderPass = false;
     bool mPipelineBound = false;
+    bool mSkipDraws = false;
+    bool mShaderFailed = false;
     bool mNeedUpdateVao = true;
 
     size_t mSubmitCount = 0;
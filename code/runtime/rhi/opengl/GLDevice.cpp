@@ -27,11 +27,13 @@
 
 #include <core/Engine.hpp>
 #include <core/math/MathUtils3d.hpp>
+#include <core/profiler/Counters.hpp>
 #include <rhi/opengl/GLBuffer.hpp>
 #include <rhi/opengl/GLCommandList.hpp>
 #include <rhi/opengl/GLDevice.hpp>
 #include <rhi/opengl/GLFramebuffer.hpp>
 #include <rhi/opengl/GLGraphicsPipeline.hpp>
+#include <rhi/opengl/GLQuery.hpp>
 #include <rhi/opengl/GLRenderPass.hpp>
 #include <rhi/opengl/GLResourceSet.hpp>
 #include <rhi/opengl/GLSampler.hpp>
@@ -151,11 +153,17 @@ GLDevice::GLDevice(MakeContextCurrentFunc makeCurrentFunc, SwapBuffersFunc swapB
     BRK_GL_CATCH_ERR();
     mCaps.maxAnisotropy = maxAnisotropy;
     mCaps.supportAnisotropy = IsExtensionSupported("GL_EXT_texture_filter_anisotropic");
+    mCaps.supportTimerQuery = true;
+    mCaps.supportDebugMarkers = IsExtensionSupported("GL_KHR_debug");
 
     mClipMatrix = MathUtils3d::IdentityMatrix();
     mType = RHIType::OpenGL;
     mRHIThread = &Engine::Instance().GetRHIThread();
     mCoreCommandList = Ref<GLCommandList>(new GLCommandList);
+    mProgramCache = std::unique_ptr<GLProgramCache>(new GLProgramCache());
+    mShaderCompileQueue = std::unique_ptr<GLShaderCompileQueue>(new GLShaderCompileQueue());
+    mStagingPool = std::unique_ptr<GLStagingPool>(new GLStagingPool());
+    mUploadQueue = std::unique_ptr<GLUploadQueue>(new GLUploadQueue());
 
     BRK_INFO("Initialize RHI Device");
 
@@ -175,6 +183,10 @@ GLDevice::GLDevice(MakeContextCurrentFunc makeCurrentFunc, SwapBuffersFunc swapB
 }
 
 GLDevice::~GLDevice() {
+    // Queued uploads keep staging data, so queue is released first
+    mUploadQueue.reset();
+    mStagingPool.reset();
+    mShaderCompileQueue.reset();
     mCoreCommandList.Reset();
     BRK_INFO(BRK_TEXT("Finalize RHI Device"));
 }
@@ -192,45 +204,75 @@ Ref<RHIVertexDeclaration> GLDevice::CreateVertexDeclaration(const RHIVertexDecla
 }
 
 Ref<RHIVertexBuffer> GLDevice::CreateVertexBuffer(const RHIBufferDesc &desc) {
+    BRK_COUNTER_ADD("rhi.buffers_created", 1);
     BRK_GL_CREATE_RESOURCE(RHIVertexBuffer, GLVertexBuffer, desc);
 }
 
 Ref<RHIIndexBuffer> GLDevice::CreateIndexBuffer(const RHIBufferDesc &desc) {
+    BRK_COUNTER_ADD("rhi.buffers_created", 1);
     BRK_GL_CREATE_RESOURCE(RHIIndexBuffer, GLIndexBuffer, desc);
 }
 
 Ref<RHIUniformBuffer> GLDevice::CreateUniformBuffer(const RHIBufferDesc &desc) {
+    BRK_COUNTER_ADD("rhi.buffers_created", 1);
     BRK_GL_CREATE_RESOURCE(RHIUniformBuffer, GLUniformBuffer, desc);
 }
 
 Ref<RHISampler> GLDevice::CreateSampler(const RHISamplerDesc &desc) {
+    BRK_COUNTER_ADD("rhi.samplers_created", 1);
     BRK_GL_CREATE_RESOURCE(RHISampler, GLSampler, desc);
 }
 
 Ref<RHITexture> GLDevice::CreateTexture(const RHITextureDesc &desc) {
+    BRK_COUNTER_ADD("rhi.textures_created", 1);
     BRK_GL_CREATE_RESOURCE(RHITexture, GLTexture, desc);
 }
 
 Ref<RHIResourceSet> GLDevice::CreateResourceSet(const RHIResourceSetDesc &desc) {
+    BRK_COUNTER_ADD("rhi.resource_sets_created", 1);
     return Ref<RHIResourceSet>(new GLResourceSet(desc));
 }
 
 Ref<RHIFramebuffer> GLDevice::CreateFramebuffer(const RHIFramebufferDesc &desc) {
+    BRK_COUNTER_ADD("rhi.framebuffers_created", 1);
     BRK_GL_CREATE_RESOURCE(RHIFramebuffer, GLFramebuffer, desc);
 }
 
 Ref<RHIShader> GLDevice::CreateShader(const RHIShaderDesc &desc) {
+    BRK_COUNTER_ADD("rhi.shaders_created", 1);
     BRK_GL_CREATE_RESOURCE(RHIShader, GLShader, desc);
 }
 
 Ref<RHIRenderPass> GLDevice::CreateRenderPass(const RHIRenderPassDesc &desc) {
+    BRK_COUNTER_ADD("rhi.render_passes_created", 1);
     return Ref<RHIRenderPass>(new GLRenderPass(desc));
 }
 
 Ref<RHIGraphicsPipeline> GLDevice::CreateGraphicsPipeline(const RHIGraphicsPipelineDesc &desc) {
+    BRK_COUNTER_ADD("rhi.pipelines_created", 1);
     return Ref<RHIGraphicsPipeline>(new GLGraphicsPipeline(desc));
 }
 
+Ref<RHITimerQuery> GLDevice::CreateTimerQuery() {
+    BRK_COUNTER_ADD("rhi.queries_created", 1);
+    Ref<GLTimerQuery> object(new GLTimerQuery());
+    if (mRHIThread->OnThread())
+        object->Initialize();
+    else
+        mRHIThread->EnqueueBefore([=]() { object->Initialize(); });
+    return object.Cast<RHITimerQuery>();
+}
+
+Ref<RHIOcclusionQuery> GLDevice::CreateOcclusionQuery() {
+    BRK_COUNTER_ADD("rhi.queries_created", 1);
+    Ref<GLOcclusionQuery> object(new GLOcclusionQuery());
+    if (mRHIThread->OnThread())
+        object->Initialize();
+    else
+        mRHIThread->EnqueueBefore([=]() { object->Initialize(); });
+    return object.Cast<RHIOcclusionQuery>();
+}
+
 Ref<RHICommandList> GLDevice::GetCoreCommandList() {
     return mCoreCommandList.As<RHICommandList>();
 }
@@ -241,6 +283,10 @@ void GLDevice::UpdateResourceSet_RT(const Ref<RHIResourceSet> &set, const RHIRes
     native->Update(desc);
 }
 
+Ref<Data> GLDevice::AllocateUploadData(size_t size) {
+    return mStagingPool->Allocate(size);
+}
+
 #undef BRK_GL_CREATE_RESOURCE
 
 GLDevice::MakeContextCurrentFunc &GLDevice::GetContextFunc() {
@@ -251,6 +297,22 @@ GLDevice::SwapBuffersFunc &GLDevice::GetSwapFunc() {
     return mSwapBuffersFunc;
 }
 
+GLProgramCache &GLDevice::GetProgramCache() {
+    return *mProgramCache;
+}
+
+GLShaderCompileQueue &GLDevice::GetShaderCompileQueue() {
+    return *mShaderCompileQueue;
+}
+
+GLStagingPool &GLDevice::GetStagingPool() {
+    return *mStagingPool;
+}
+
+GLUploadQueue &GLDevice::GetUploadQueue() {
+    return *mUploadQueue;
+}
+
 std::shared_ptr<GLDevice> GLDevice::Make(MakeContextCurrentFunc makeCurrentFunc, SwapBuffersFunc swapBuffersFunc) {
     GLenum error = glewInit();
 
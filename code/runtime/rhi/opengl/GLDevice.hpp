@@ -31,8 +31,13 @@
 #include <core/Thread.hpp>
 #include <rhi/RHIDevice.hpp>
 #include <rhi/opengl/GLDefs.hpp>
+#include <rhi/opengl/GLProgramCache.hpp>
+#include <rhi/opengl/GLShaderCompileQueue.hpp>
+#include <rhi/opengl/GLStagingPool.hpp>
+#include <rhi/opengl/GLUploadQueue.hpp>
 
 #include <functional>
+#include <memory>
 
 BRK_NS_BEGIN
 
@@ -64,13 +69,28 @@ public:
     BRK_API Ref<RHIShader> CreateShader(const RHIShaderDesc &desc) override;
     BRK_API Ref<RHIRenderPass> CreateRenderPass(const RHIRenderPassDesc &desc) override;
     BRK_API Ref<RHIGraphicsPipeline> CreateGraphicsPipeline(const RHIGraphicsPipelineDesc &desc) override;
+    BRK_API Ref<RHITimerQuery> CreateTimerQuery() override;
+    BRK_API Ref<RHIOcclusionQuery> CreateOcclusionQuery() override;
     BRK_API Ref<RHICommandList> GetCoreCommandList() override;
 
     BRK_API void UpdateResourceSet_RT(const Ref<RHIResourceSet> &set, const RHIResourceSetDesc &desc) override;
+    BRK_API Ref<Data> AllocateUploadData(size_t size) override;
 
     BRK_API MakeContextCurrentFunc &GetContextFunc();
     BRK_API SwapBuffersFunc &GetSwapFunc();
 
+    /** @return Cache of linked programs binaries (RHI thread only) */
+    BRK_API GLProgramCache &GetProgramCache();
+
+    /** @return Queue of programs pending compilation (RHI thread only) */
+    BRK_API GLShaderCompileQueue &GetShaderCompileQueue();
+
+    /** @return Pool of texture staging buffers */
+    BRK_API GLStagingPool &GetStagingPool();
+
+    /** @return Queue of texture uploads (RHI thread only) */
+    BRK_API GLUploadQueue &GetUploadQueue();
+
     /**
      * @brief CreateFromImage GL RHI device
      *
@@ -89,6 +109,10 @@ private:
     SwapBuffersFunc mSwapBuffersFunc;
     Thread *mRHIThread = nullptr;
     Ref<class GLCommandList> mCoreCommandList;
+    std::unique_ptr<GLProgramCache> mProgramCache;
+    std::unique_ptr<GLShaderCompileQueue> mShaderCompileQueue;
+    std::unique_ptr<GLStagingPool> mStagingPool;
+    std::unique_ptr<GLUploadQueue> mUploadQueue;
 };
 
 /**
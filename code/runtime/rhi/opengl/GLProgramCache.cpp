@@ -0,0 +1,355 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/Hash64.hpp>
+#include <core/Engine.hpp>
+#include <rhi/opengl/GLProgramCache.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+BRK_NS_BEGIN
+
+namespace {
+    /** Identifies cache entry file: 'BRKP' */
+    const uint32 CACHE_MAGIC = 0x504b5242;
+    /** Increment on any change of the entry layout */
+    const uint32 CACHE_VERSION = 1;
+
+    /** Appends values to entry binary blob */
+    class EntryWriter {
+    public:
+        template<typename T>
+        void Write(const T &value) {
+            auto p = reinterpret_cast<const uint8 *>(&value);
+            mBuffer.insert(mBuffer.end(), p, p + sizeof(T));
+        }
+
+        void Write(const void *data, size_t size) {
+            auto p = reinterpret_cast<const uint8 *>(data);
+            mBuffer.insert(mBuffer.end(), p, p + size);
+        }
+
+        void Write(const StringName &name) {
+            auto &str = name.GetStr();
+            Write(static_cast<uint32>(str.size()));
+            Write(str.data(), str.size());
+        }
+
+        Ref<Data> GetData() const {
+            return Data::Make(mBuffer.data(), mBuffer.size());
+        }
+
+    private:
+        std::vector<uint8> mBuffer;
+    };
+
+    /** Reads values from entry binary blob with bounds checks */
+    class EntryReader {
+    public:
+        explicit EntryReader(const Ref<Data> &data)
+            : mData(reinterpret_cast<const uint8 *>(data->GetData())), mSize(data->GetSize()) {}
+
+        template<typename T>
+        bool Read(T &value) {
+            return Read(&value, sizeof(T));
+        }
+
+        bool Read(void *data, size_t size) {
+            if (mOffset + size > mSize)
+                return false;
+            std::memcpy(data, mData + mOffset, size);
+            mOffset += size;
+            return true;
+        }
+
+        bool Read(StringName &name) {
+            uint32 length;
+            if (!Read(length) || mOffset + length > mSize)
+                return false;
+            name = StringName(String(reinterpret_cast<const char *>(mData + mOffset), length));
+            mOffset += length;
+            return true;
+        }
+
+        const uint8 *GetCurrent() const { return mData + mOffset; }
+
+        bool Skip(size_t size) {
+            if (mOffset + size > mSize)
+                return false;
+            mOffset += size;
+            return true;
+        }
+
+    private:
+        const uint8 *mData;
+        size_t mSize;
+        size_t mOffset = 0;
+    };
+
+    void WriteMeta(EntryWriter &writer, const RHIShaderMeta &meta) {
+        writer.Write(meta.name);
+
+        writer.Write(static_cast<uint32>(meta.inputs.size()));
+        for (auto &entry : meta.inputs) {
+            auto &input = entry.second;
+            writer.Write(input.name);
+            writer.Write(input.location);
+            writer.Write(input.type);
+        }
+
+        writer.Write(static_cast<uint32>(meta.params.size()));
+        for (auto &entry : meta.params) {
+            auto &param = entry.second;
+            writer.Write(param.name);
+            writer.Write(param.elementSize);
+            writer.Write(param.arraySize);
+            writer.Write(param.arrayStride);
+            writer.Write(param.matrixStride);
+            writer.Write(param.blockSlot);
+            writer.Write(param.blockOffset);
+            writer.Write(param.type);
+        }
+
+        writer.Write(static_cast<uint32>(meta.paramBlocks.size()));
+        for (auto &entry : meta.paramBlocks) {
+            auto &block = entry.second;
+            writer.Write(block.name);
+            writer.Write(block.slot);
+            writer.Write(block.size);
+        }
+
+        writer.Write(static_cast<uint32>(meta.samplers.size()));
+        for (auto &entry : meta.samplers) {
+            auto &sampler = entry.second;
+            writer.Write(sampler.name);
+            writer.Write(sampler.location);
+            writer.Write(sampler.arraySize);
+            writer.Write(sampler.type);
+        }
+    }
+
+    bool ReadMeta(EntryReader &reader, RHIShaderMeta &meta) {
+        uint32 count;
+
+        if (!reader.Read(meta.name))
+            return false;
+
+        if (!reader.Read(count))
+            return false;
+        for (uint32 i = 0; i < count; i++) {
+            RHIShaderMeta::InputAttribute input;
+            if (!reader.Read(input.name) || !reader.Read(input.location) || !reader.Read(input.type))
+                return false;
+            meta.inputs.emplace(input.name, input);
+        }
+
+        if (!reader.Read(count))
+            return false;
+        for (uint32 i = 0; i < count; i++) {
+            RHIShaderMeta::DataParam param;
+            if (!reader.Read(param.name) || !reader.Read(param.elementSize) || !reader.Read(param.arraySize) ||
+                !reader.Read(param.arrayStride) || !reader.Read(param.matrixStride) || !reader.Read(param.blockSlot) ||
+                !reader.Read(param.blockOffset) || !reader.Read(param.type))
+                return false;
+            meta.params.emplace(param.name, param);
+        }
+
+        if (!reader.Read(count))
+            return false;
+        for (uint32 i = 0; i < count; i++) {
+            RHIShaderMeta::DataParamBlock block;
+            if (!reader.Read(block.name) || !reader.Read(block.slot) || !reader.Read(block.size))
+                return false;
+            meta.paramBlocks.emplace(block.name, block);
+        }
+
+        if (!reader.Read(count))
+            return false;
+        for (uint32 i = 0; i < count; i++) {
+            RHIShaderMeta::ObjectParam sampler;
+            if (!reader.Read(sampler.name) || !reader.Read(sampler.location) || !reader.Read(sampler.arraySize) || !reader.Read(sampler.type))
+                return false;
+            meta.samplers.emplace(sampler.name, sampler);
+        }
+
+        return true;
+    }
+}// namespace
+
+GLProgramCache::GLProgramCache() {
+    auto &engine = Engine::Instance();
+    auto &config = engine.GetConfig();
+    auto &fileSystem = engine.GetFileSystem();
+
+    StringName sectionRhi("rhi");
+
+    auto enabled = config.GetProperty(sectionRhi, StringName("shader.cache"), 1u);
+    auto path = config.GetProperty(sectionRhi, StringName("shader.cache.path"), String("cache/shaders"));
+
+    GLint formatsCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatsCount);
+    BRK_GL_CATCH_ERR();
+
+    if (!enabled || formatsCount <= 0) {
+        BRK_INFO("Program binary cache is disabled");
+        return;
+    }
+
+    auto vendor = glGetString(GL_VENDOR);
+    BRK_GL_CATCH_ERR();
+    auto renderer = glGetString(GL_RENDERER);
+    BRK_GL_CATCH_ERR();
+    auto version = glGetString(GL_VERSION);
+    BRK_GL_CATCH_ERR();
+
+    mDriver += vendor ? reinterpret_cast<const char *>(vendor) : "";
+    mDriver += renderer ? reinterpret_cast<const char *>(renderer) : "";
+    mDriver += version ? reinterpret_cast<const char *>(version) : "";
+
+    mPath = fileSystem.IsAbsolutePath(path) ? path : fileSystem.GetExecutableDir() + "/" + path;
+
+    if (!fileSystem.MakeDir(mPath)) {
+        BRK_ERROR("Failed to create program binary cache dir=" << mPath);
+        return;
+    }
+
+    mEnabled = true;
+}
+
+GLProgramCache::Key GLProgramCache::GetKey(RHIShaderLanguage language, const std::vector<RHIShaderStageDesc> &stages) const {
+    String content = mDriver;
+    content += static_cast<char>(language);
+
+    for (auto &stage : stages) {
+        content += static_cast<char>(stage.type);
+        content += stage.sourceCode;
+        content += '\0';
+    }
+
+    return static_cast<Key>(Hash64::Hash(content));
+}
+
+bool GLProgramCache::Load(GLuint program, Key key, Ref<RHIShaderMeta> &meta) {
+    assert(mEnabled);
+
+    auto &fileSystem = Engine::Instance().GetFileSystem();
+    auto path = GetEntryPath(key);
+
+    if (!fileSystem.IsFileExists(path))
+        return false;
+
+    auto data = fileSystem.ReadFile(path);
+
+    if (data.IsNull())
+        return false;
+
+    EntryReader reader(data);
+
+    uint32 magic;
+    uint32 version;
+    Key storedKey;
+    GLenum format;
+    uint32 binarySize;
+
+    if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(storedKey) || !reader.Read(format) || !reader.Read(binarySize) ||
+        magic != CACHE_MAGIC || version != CACHE_VERSION || storedKey != key) {
+        BRK_WARNING("Invalid program binary cache entry " << path);
+        std::remove(path.c_str());
+        return false;
+    }
+
+    auto binary = reader.GetCurrent();
+    Ref<RHIShaderMeta> cachedMeta(new RHIShaderMeta);
+
+    if (!reader.Skip(binarySize) || !ReadMeta(reader, *cachedMeta)) {
+        BRK_WARNING("Corrupted program binary cache entry " << path);
+        std::remove(path.c_str());
+        return false;
+    }
+
+    glProgramBinary(program, format, binary, static_cast<GLsizei>(binarySize));
+
+    // Driver may reject binary with an error, so do not catch it as engine error
+    while (glGetError() != GL_NO_ERROR) {}
+
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    BRK_GL_CATCH_ERR();
+
+    if (!status) {
+        BRK_WARNING("Program binary rejected by driver " << path);
+        std::remove(path.c_str());
+        return false;
+    }
+
+    meta = std::move(cachedMeta);
+    return true;
+}
+
+void GLProgramCache::Store(GLuint program, Key key, const RHIShaderMeta &meta) {
+    assert(mEnabled);
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    BRK_GL_CATCH_ERR();
+
+    if (length <= 0)
+        return;
+
+    std::vector<uint8> binary(length);
+    GLenum format;
+    GLsizei written = 0;
+
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    BRK_GL_CATCH_ERR();
+
+    if (written <= 0)
+        return;
+
+    EntryWriter writer;
+    writer.Write(CACHE_MAGIC);
+    writer.Write(CACHE_VERSION);
+    writer.Write(key);
+    writer.Write(format);
+    writer.Write(static_cast<uint32>(written));
+    writer.Write(binary.data(), static_cast<size_t>(written));
+    WriteMeta(writer, meta);
+
+    auto path = GetEntryPath(key);
+    Engine::Instance().GetFileSystem().WriteFile(path, writer.GetData());
+}
+
+String GLProgramCache::GetEntryPath(Key key) const {
+    std::stringstream name;
+    name << mPath << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".glbin";
+    return name.str();
+}
+
+BRK_NS_END
@@ -0,0 +1,113 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_GLPROGRAMCACHE_HPP
+#define BERSERK_GLPROGRAMCACHE_HPP
+
+#include <rhi/RHIShader.hpp>
+#include <rhi/opengl/GLDefs.hpp>
+
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup opengl
+ * @{
+ */
+
+/**
+ * @class GLProgramCache
+ * @brief On-disk cache of linked GL program binaries
+ *
+ * Stores program binary (`glGetProgramBinary`) together with reflected
+ * shader meta, so warm start skips compilation, linking and reflection.
+ * Entries are keyed by hash of the stages source code, language and
+ * driver vendor/renderer/version strings. Binaries rejected by the driver
+ * (for instance, after driver update) are removed and program is compiled again.
+ *
+ * Configured by `rhi` section of the engine config:
+ * `shader.cache` (0 to disable) and `shader.cache.path` (relative to executable dir).
+ *
+ * @note Must be used on RHI thread only.
+ */
+class GLProgramCache final {
+public:
+    /** @brief Key of the program in cache */
+    using Key = uint64;
+
+    BRK_API GLProgramCache();
+    BRK_API ~GLProgramCache() = default;
+
+    /**
+     * @brief Compute key of the program
+     *
+     * @param language Shader language
+     * @param stages Stages with source code
+     *
+     * @return Key of the program for current driver
+     */
+    BRK_API Key GetKey(RHIShaderLanguage language, const std::vector<RHIShaderStageDesc> &stages) const;
+
+    /**
+     * @brief Load program binary from the cache
+     *
+     * @param program Created program handle without attached shaders
+     * @param key Key of the program
+     * @param[out] meta Cached reflection meta of the program
+     *
+     * @return True if program binary is loaded and linked
+     */
+    BRK_API bool Load(GLuint program, Key key, Ref<RHIShaderMeta> &meta);
+
+    /**
+     * @brief Store linked program binary into the cache
+     *
+     * @param program Linked program, created with `GL_PROGRAM_BINARY_RETRIEVABLE_HINT`
+     * @param key Key of the program
+     * @param meta Reflection meta of the program
+     */
+    BRK_API void Store(GLuint program, Key key, const RHIShaderMeta &meta);
+
+    /** @return True if driver supports program binaries and cache is enabled */
+    bool IsEnabled() const { return mEnabled; }
+
+private:
+    String GetEntryPath(Key key) const;
+
+    String mPath;               /** Full path to cache directory */
+    String mDriver;             /** Driver vendor, renderer and version */
+    bool mEnabled = false;      /** Whether cache is used */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_GLPROGRAMCACHE_HPP
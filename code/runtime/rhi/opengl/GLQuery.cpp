@@ -0,0 +1,102 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <rhi/opengl/GLQuery.hpp>
+
+BRK_NS_BEGIN
+
+namespace {
+    /** Read query result if GPU has reached the query */
+    bool PollQuery(GLuint handle, uint64 &result) {
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(handle, GL_QUERY_RESULT_AVAILABLE, &available);
+        BRK_GL_CATCH_ERR();
+
+        if (available == GL_FALSE)
+            return false;
+
+        GLuint64 value = 0;
+        glGetQueryObjectui64v(handle, GL_QUERY_RESULT, &value);
+        BRK_GL_CATCH_ERR();
+
+        result = static_cast<uint64>(value);
+        return true;
+    }
+}// namespace
+
+GLTimerQuery::~GLTimerQuery() {
+    if (mHandle) {
+        glDeleteQueries(1, &mHandle);
+        BRK_GL_CATCH_ERR();
+        mHandle = 0;
+    }
+}
+
+void GLTimerQuery::Initialize() {
+    glGenQueries(1, &mHandle);
+    BRK_GL_CATCH_ERR();
+}
+
+void GLTimerQuery::Write() {
+    glQueryCounter(mHandle, GL_TIMESTAMP);
+    BRK_GL_CATCH_ERR();
+    mIssued = true;
+}
+
+bool GLTimerQuery::GetResult_RT(uint64 &result) {
+    return mIssued && PollQuery(mHandle, result);
+}
+
+GLOcclusionQuery::~GLOcclusionQuery() {
+    if (mHandle) {
+        glDeleteQueries(1, &mHandle);
+        BRK_GL_CATCH_ERR();
+        mHandle = 0;
+    }
+}
+
+void GLOcclusionQuery::Initialize() {
+    glGenQueries(1, &mHandle);
+    BRK_GL_CATCH_ERR();
+}
+
+void GLOcclusionQuery::Begin() {
+    glBeginQuery(GL_SAMPLES_PASSED, mHandle);
+    BRK_GL_CATCH_ERR();
+}
+
+void GLOcclusionQuery::End() {
+    glEndQuery(GL_SAMPLES_PASSED);
+    BRK_GL_CATCH_ERR();
+    mIssued = true;
+}
+
+bool GLOcclusionQuery::GetResult_RT(uint64 &result) {
+    return mIssued && PollQuery(mHandle, result);
+}
+
+BRK_NS_END
@@ -0,0 +1,84 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_GLQUERY_HPP
+#define BERSERK_GLQUERY_HPP
+
+#include <rhi/RHIQuery.hpp>
+#include <rhi/opengl/GLDefs.hpp>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup opengl
+ * @{
+ */
+
+/**
+ * @class GLTimerQuery
+ * @brief GL timestamp query implementation
+ */
+class GLTimerQuery final : public RHITimerQuery {
+public:
+    BRK_API GLTimerQuery() = default;
+    BRK_API ~GLTimerQuery() override;
+
+    BRK_API void Initialize();
+    BRK_API void Write();
+    BRK_API bool GetResult_RT(uint64 &result) override;
+
+private:
+    GLuint mHandle = 0;
+    bool mIssued = false;
+};
+
+/**
+ * @class GLOcclusionQuery
+ * @brief GL samples passed query implementation
+ */
+class GLOcclusionQuery final : public RHIOcclusionQuery {
+public:
+    BRK_API GLOcclusionQuery() = default;
+    BRK_API ~GLOcclusionQuery() override;
+
+    BRK_API void Initialize();
+    BRK_API void Begin();
+    BRK_API void End();
+    BRK_API bool GetResult_RT(uint64 &result) override;
+
+private:
+    GLuint mHandle = 0;
+    bool mIssued = false;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_GLQUERY_HPP
@@ -26,6 +26,8 @@
 /**********************************************************************************/
 
 #include <core/Engine.hpp>
+#include <core/profiler/Counters.hpp>
+#include <rhi/opengl/GLDevice.hpp>
 #include <rhi/opengl/GLShader.hpp>
 
 BRK_NS_BEGIN
@@ -83,12 +85,18 @@ void GLShader::Initialize() {
         return;
     }
 
-    GLsizei current = 0;
-    GLuint shaders[RHILimits::MAX_SHADER_STAGES];
+    auto &device = static_cast<GLDevice &>(Engine::Instance().GetRHIDevice());
+    auto &cache = device.GetProgramCache();
+    mCacheKey = cache.IsEnabled() ? cache.GetKey(mLanguage, mStages) : 0;
 
-    bool withError = false;
-    String error;
+    // Warm start: take linked binary and reflection from the cache
+    if (cache.IsEnabled() && InitializeFromCache(cache, mCacheKey)) {
+        BRK_INFO("Shader \"" << mName << "\" loaded from cache");
+        NotifyCompiled();
+        return;
+    }
 
+    // Submit compilation and linking, status is checked later, when driver is done
     for (const auto &module : mStages) {
         assert(!module.sourceCode.empty());
 
@@ -107,6 +115,46 @@ void GLShader::Initialize() {
         glCompileShader(handle);
         BRK_GL_CATCH_ERR();
 
+        mStagesHandles[mStagesCount] = handle;
+        mStagesCount++;
+    }
+
+    mHandle = glCreateProgram();
+    BRK_GL_CATCH_ERR();
+
+    for (uint32 i = 0; i < mStagesCount; i++) {
+        glAttachShader(mHandle, mStagesHandles[i]);
+        BRK_GL_CATCH_ERR();
+    }
+
+    if (cache.IsEnabled()) {
+        glProgramParameteri(mHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        BRK_GL_CATCH_ERR();
+    }
+
+    glLinkProgram(mHandle);
+    BRK_GL_CATCH_ERR();
+
+    device.GetShaderCompileQueue().Add(Ref<GLShader>(this));
+}
+
+bool GLShader::IsCompilationComplete() const {
+    GLint complete = GL_TRUE;
+    glGetProgramiv(mHandle, GL_COMPLETION_STATUS_KHR, &complete);
+    BRK_GL_CATCH_ERR();
+
+    return complete == GL_TRUE;
+}
+
+void GLShader::FinishCompilation() {
+    assert(mHandle);
+
+    bool withError = false;
+    String error;
+
+    for (uint32 i = 0; i < mStagesCount; i++) {
+        GLuint handle = mStagesHandles[i];
+
         GLint result = 0;
         glGetShaderiv(handle, GL_COMPILE_STATUS, &result);
         BRK_GL_CATCH_ERR();
@@ -130,91 +178,93 @@ void GLShader::Initialize() {
                 error = log.data();
             }
 
-            glDeleteShader(handle);
-            BRK_GL_CATCH_ERR();
-
             break;
         }
-
-        shaders[current] = handle;
-        current++;
     }
 
-    if (withError) {
-        // Release all created shader stages
-        for (GLsizei i = 0; i < current; i++) {
-            glDeleteShader(shaders[i]);
-            BRK_GL_CATCH_ERR();
-        }
-
-        BRK_ERROR("Shader \"" << mName << "\" compilation: Error: " << error);
-
-        mCompilerMessage = std::move(error);
-        mCompilationStatus.store(Status::FailedCompile);
-        return;
-    }
-
-    mHandle = glCreateProgram();
-    BRK_GL_CATCH_ERR();
-
-    for (GLsizei i = 0; i < current; i++) {
-        glAttachShader(mHandle, shaders[i]);
+    if (!withError) {
+        GLint status;
+        glGetProgramiv(mHandle, GL_LINK_STATUS, &status);
         BRK_GL_CATCH_ERR();
-    }
 
-    glLinkProgram(mHandle);
-    BRK_GL_CATCH_ERR();
-
-    GLint status;
-    glGetProgramiv(mHandle, GL_LINK_STATUS, &status);
-
-    if (!status) {
-        withError = true;
+        if (!status) {
+            withError = true;
 
-        int32 logLength;
-        glGetProgramiv(mHandle, GL_INFO_LOG_LENGTH, &logLength);
-        BRK_GL_CATCH_ERR();
+            int32 logLength;
+            glGetProgramiv(mHandle, GL_INFO_LOG_LENGTH, &logLength);
+            BRK_GL_CATCH_ERR();
 
-        if (logLength > 0) {
-            std::vector<char> log(logLength + 1);
+            if (logLength > 0) {
+                std::vector<char> log(logLength + 1);
 
-            GLint written;
-            glGetShaderInfoLog(mHandle, logLength, &written, log.data());
-            BRK_GL_CATCH_ERR();
+                GLint written;
+                glGetProgramInfoLog(mHandle, logLength, &written, log.data());
+                BRK_GL_CATCH_ERR();
 
-            assert(written <= logLength);
-            log[written] = '\0';
-            error = log.data();
+                assert(written <= logLength);
+                log[written] = '\0';
+                error = log.data();
+            }
         }
     }
 
     if (withError) {
-        // Release all created shader stages
-        for (GLsizei i = 0; i < current; i++) {
-            glDeleteShader(shaders[i]);
-            BRK_GL_CATCH_ERR();
-        }
-
         // Release program handle
         glDeleteProgram(mHandle);
         BRK_GL_CATCH_ERR();
 
+        // Release all created shader stages
+        for (uint32 i = 0; i < mStagesCount; i++) {
+            glDeleteShader(mStagesHandles[i]);
+            BRK_GL_CATCH_ERR();
+        }
+
         BRK_ERROR("Shader \"" << mName << "\" compilation: Error: " << error);
 
         mHandle = 0;
+        mStagesCount = 0;
         mCompilerMessage = std::move(error);
         mCompilationStatus.store(Status::FailedCompile);
         return;
     }
+
     // Create reflection meta information
     InitializeMeta();
 
-    // Remember to notify user, that program is compiled
-    mCompilationStatus.store(Status::Compiled);
+    // Next launch will skip compilation
+    auto &cache = static_cast<GLDevice &>(Engine::Instance().GetRHIDevice()).GetProgramCache();
+    if (cache.IsEnabled())
+        cache.Store(mHandle, mCacheKey, *mMeta);
 
     // Debug only
     BRK_INFO("Shader \"" << mName << "\" compilation: OK");
 
+    NotifyCompiled();
+}
+
+bool GLShader::InitializeFromCache(GLProgramCache &cache, GLProgramCache::Key key) {
+    mHandle = glCreateProgram();
+    BRK_GL_CATCH_ERR();
+
+    if (!cache.Load(mHandle, key, mMeta)) {
+        glDeleteProgram(mHandle);
+        BRK_GL_CATCH_ERR();
+
+        mHandle = 0;
+        return false;
+    }
+
+    /** Meta name is the same as program has */
+    mMeta->name = GetShaderName();
+
+    return true;
+}
+
+void GLShader::NotifyCompiled() {
+    // Remember to notify user, that program is compiled
+    mCompilationStatus.store(Status::Compiled);
+    BRK_COUNTER_ADD("rhi.shaders_compiled", 1);
+
     // Notify user
     if (mCallback) {
         auto &scheduler = Engine::Instance().GetScheduler();
@@ -419,4 +469,12 @@ void GLShader::Use() const {
     BRK_GL_CATCH_ERR();
 }
 
+bool GLShader::ReportFailedUse() {
+    if (mFailedUseReported.exchange(true))
+        return false;
+
+    BRK_ERROR("Shader \"" << mName << "\" failed to compile, draws with it are dropped: " << mCompilerMessage);
+    return true;
+}
+
 BRK_NS_END
\ No newline at end of file
@@ -30,6 +30,7 @@
 
 #include <rhi/RHIShader.hpp>
 #include <rhi/opengl/GLDefs.hpp>
+#include <rhi/opengl/GLProgramCache.hpp>
 
 BRK_NS_BEGIN
 
@@ -52,19 +53,28 @@ public:
     BRK_API Ref<const RHIShaderMeta> GetShaderMeta() const override;
 
     BRK_API void Initialize();
+    BRK_API bool InitializeFromCache(GLProgramCache &cache, GLProgramCache::Key key);
+    BRK_API bool IsCompilationComplete() const;
+    BRK_API void FinishCompilation();
+    BRK_API void NotifyCompiled();
     BRK_API bool ValidateStages() const;
     BRK_API void InitializeMeta();
     BRK_API void BindUniformBlock(uint32 binding) const;
     BRK_API void Use() const;
+    BRK_API bool ReportFailedUse();
 
     GLuint GetHandle() const { return mHandle; }
 
 private:
     GLuint mHandle = 0;
+    GLuint mStagesHandles[RHILimits::MAX_SHADER_STAGES];
+    uint32 mStagesCount = 0;
+    GLProgramCache::Key mCacheKey = 0;
     String mCompilerMessage;
     Ref<RHIShaderMeta> mMeta{};
     Ref<Data> mByteCode{};
     std::atomic<Status> mCompilationStatus{Status::PendingCompilation};
+    std::atomic<bool> mFailedUseReported{false};
     std::function<void(Ref<class RHIShader>)> mCallback;
 };
 
@@ -0,0 +1,82 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <rhi/opengl/GLShader.hpp>
+#include <rhi/opengl/GLShaderCompileQueue.hpp>
+
+#include <chrono>
+
+BRK_NS_BEGIN
+
+GLShaderCompileQueue::GLShaderCompileQueue() {
+    // Let driver choose number of compiler threads
+    if (GLEW_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xffffffff);
+        BRK_GL_CATCH_ERR();
+        mParallel = true;
+    } else if (GLEW_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xffffffff);
+        BRK_GL_CATCH_ERR();
+        mParallel = true;
+    }
+
+    BRK_INFO("Parallel shader compilation: " << (mParallel ? "supported" : "not supported"));
+}
+
+void GLShaderCompileQueue::Add(Ref<GLShader> shader) {
+    assert(shader.IsNotNull());
+    mPending.push_back(std::move(shader));
+}
+
+void GLShaderCompileQueue::Update() {
+    using namespace std::chrono;
+
+    auto start = steady_clock::now();
+    auto budget = milliseconds(SYNC_BUDGET_MS);
+    size_t finished = 0;
+    size_t remaining = 0;
+
+    for (size_t i = 0; i < mPending.size(); i++) {
+        auto &shader = mPending[i];
+
+        // Sync path finishes at least one program per frame
+        bool ready = mParallel ? shader->IsCompilationComplete() : (finished == 0 || steady_clock::now() - start < budget);
+
+        if (ready) {
+            shader->FinishCompilation();
+            finished += 1;
+        } else {
+            if (remaining != i)
+                mPending[remaining] = std::move(shader);
+            remaining += 1;
+        }
+    }
+
+    mPending.resize(remaining);
+}
+
+BRK_NS_END
@@ -0,0 +1,87 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_GLSHADERCOMPILEQUEUE_HPP
+#define BERSERK_GLSHADERCOMPILEQUEUE_HPP
+
+#include <core/templates/Ref.hpp>
+#include <rhi/opengl/GLDefs.hpp>
+
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup opengl
+ * @{
+ */
+
+/**
+ * @class GLShaderCompileQueue
+ * @brief Tracks programs which compilation and linking is submitted to the driver
+ *
+ * Shaders submit compile and link commands without querying its status,
+ * so the RHI thread is not blocked. The queue is polled once per frame.
+ * If `GL_KHR_parallel_shader_compile` (or ARB version) is supported, driver
+ * compiles programs on its own threads and queue finishes only programs
+ * which report completion. Otherwise status query blocks, so queue finishes
+ * programs in submit order within per-frame time budget.
+ *
+ * @note Must be used on RHI thread only.
+ */
+class GLShaderCompileQueue final {
+public:
+    /** Time budget of finishing programs per frame if driver compiles synchronously */
+    static const uint32 SYNC_BUDGET_MS = 4;
+
+    BRK_API GLShaderCompileQueue();
+    BRK_API ~GLShaderCompileQueue() = default;
+
+    /** Add shader with submitted compilation to track */
+    BRK_API void Add(Ref<class GLShader> shader);
+
+    /** Finish compiled shaders and notify its owners */
+    BRK_API void Update();
+
+    /** @return True if driver compiles programs in parallel */
+    bool IsParallel() const { return mParallel; }
+
+    /** @return Number of programs pending compilation */
+    uint32 GetPendingCount() const { return static_cast<uint32>(mPending.size()); }
+
+private:
+    std::vector<Ref<class GLShader>> mPending; /** Shaders in submit order */
+    bool mParallel = false;                   /** Driver parallel compile support */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_GLSHADERCOMPILEQUEUE_HPP
@@ -0,0 +1,218 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/profiler/Counters.hpp>
+#include <rhi/opengl/GLStagingPool.hpp>
+
+#include <cassert>
+
+BRK_NS_BEGIN
+
+GLStagingPool::GLStagingPool() : mShared(std::make_shared<Shared>()) {
+    mSupported = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+
+    if (mSupported) {
+        for (uint32 i = 0; i < INITIAL_BLOCKS; i++)
+            AddBlock();
+    }
+
+    BRK_INFO("Persistent texture staging buffers: " << (mSupported ? "supported" : "not supported"));
+}
+
+GLStagingPool::~GLStagingPool() {
+    std::lock_guard<std::mutex> guard(mShared->mutex);
+
+    for (auto &block : mShared->blocks) {
+        if (block.fence) {
+            glDeleteSync(block.fence);
+            BRK_GL_CATCH_ERR();
+        }
+
+        // Upload data must be released before device; otherwise keep memory mapped, so writers do not fault
+        assert(block.allocations == 0);
+        if (block.allocations > 0) {
+            BRK_ERROR("Staging block is destroyed with " << block.allocations << " not released allocations, buffer is leaked");
+            continue;
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, block.buffer);
+        BRK_GL_CATCH_ERR();
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        BRK_GL_CATCH_ERR();
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        BRK_GL_CATCH_ERR();
+        glDeleteBuffers(1, &block.buffer);
+        BRK_GL_CATCH_ERR();
+    }
+
+    // Not released allocations must not be reused
+    mShared->blocks.clear();
+}
+
+Ref<Data> GLStagingPool::Allocate(size_t size) {
+    if (!mSupported || size == 0 || size > BLOCK_SIZE)
+        return Ref<Data>();
+
+    auto alignedSize = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+    std::lock_guard<std::mutex> guard(mShared->mutex);
+    auto &blocks = mShared->blocks;
+
+    for (uint32 pass = 0; pass < 2; pass++) {
+        for (uint32 i = 0; i < blocks.size(); i++) {
+            auto &block = blocks[i];
+
+            // First try to fit into active blocks, then start free ones
+            if (block.state != (pass == 0 ? State::Active : State::Free))
+                continue;
+
+            if (block.offset + alignedSize > BLOCK_SIZE) {
+                block.state = State::Retired;
+                continue;
+            }
+
+            auto memory = block.mapped + block.offset;
+            block.offset += alignedSize;
+            block.allocations += 1;
+            block.state = State::Active;
+
+            auto shared = mShared;
+            return Data::MakeOwned(memory, size, [shared, i](void *) { Release(shared, i); });
+        }
+    }
+
+    mShared->misses += 1;
+    return Ref<Data>();
+}
+
+bool GLStagingPool::Find(const void *memory, GLuint &buffer, size_t &offset) const {
+    auto ptr = static_cast<const uint8 *>(memory);
+
+    std::lock_guard<std::mutex> guard(mShared->mutex);
+
+    for (auto &block : mShared->blocks) {
+        if (block.mapped <= ptr && ptr < block.mapped + BLOCK_SIZE) {
+            buffer = block.buffer;
+            offset = static_cast<size_t>(ptr - block.mapped);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void GLStagingPool::Update() {
+    if (!mSupported)
+        return;
+
+    uint32 misses;
+    uint32 used = 0;
+    {
+        std::lock_guard<std::mutex> guard(mShared->mutex);
+
+        for (auto &block : mShared->blocks) {
+            // All copies from block are issued, so fence is placed after them
+            if (block.state == State::Retired && block.allocations == 0) {
+                block.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                BRK_GL_CATCH_ERR();
+                block.state = State::Fenced;
+            } else if (block.state == State::Fenced) {
+                auto status = glClientWaitSync(block.fence, 0, 0);
+                BRK_GL_CATCH_ERR();
+
+                if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+                    glDeleteSync(block.fence);
+                    BRK_GL_CATCH_ERR();
+                    block.fence = nullptr;
+                    block.offset = 0;
+                    block.state = State::Free;
+                }
+            }
+
+            used += block.state != State::Free ? 1 : 0;
+        }
+
+        misses = mShared->misses;
+        mShared->misses = 0;
+    }
+
+    if (misses > 0)
+        AddBlock();
+
+    BRK_GAUGE_SET("rhi.staging_blocks_used", used);
+}
+
+size_t GLStagingPool::GetCapacity() const {
+    std::lock_guard<std::mutex> guard(mShared->mutex);
+    return mShared->blocks.size() * BLOCK_SIZE;
+}
+
+bool GLStagingPool::AddBlock() {
+    {
+        std::lock_guard<std::mutex> guard(mShared->mutex);
+        if (mShared->blocks.size() >= MAX_BLOCKS)
+            return false;
+    }
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    Block block;
+    glGenBuffers(1, &block.buffer);
+    BRK_GL_CATCH_ERR();
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, block.buffer);
+    BRK_GL_CATCH_ERR();
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(BLOCK_SIZE), nullptr, flags);
+    BRK_GL_CATCH_ERR();
+    block.mapped = static_cast<uint8 *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(BLOCK_SIZE), flags));
+    BRK_GL_CATCH_ERR();
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    BRK_GL_CATCH_ERR();
+
+    if (!block.mapped) {
+        BRK_ERROR("Failed to map staging buffer");
+        glDeleteBuffers(1, &block.buffer);
+        BRK_GL_CATCH_ERR();
+        return false;
+    }
+
+    // Released data refers to blocks by index, so blocks are only added
+    std::lock_guard<std::mutex> guard(mShared->mutex);
+    mShared->blocks.push_back(block);
+    return true;
+}
+
+void GLStagingPool::Release(const std::shared_ptr<Shared> &shared, uint32 index) {
+    std::lock_guard<std::mutex> guard(shared->mutex);
+
+    if (index < shared->blocks.size()) {
+        auto &block = shared->blocks[index];
+        assert(block.allocations > 0);
+        block.allocations -= 1;
+    }
+}
+
+BRK_NS_END
@@ -0,0 +1,145 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_GLSTAGINGPOOL_HPP
+#define BERSERK_GLSTAGINGPOOL_HPP
+
+#include <core/Data.hpp>
+#include <rhi/opengl/GLDefs.hpp>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup opengl
+ * @{
+ */
+
+/**
+ * @class GLStagingPool
+ * @brief Pool of persistently mapped pixel unpack buffers for texture uploads
+ *
+ * Staging memory is allocated from any thread as data, which points
+ * directly into mapped `GL_PIXEL_UNPACK_BUFFER` memory, so workers write
+ * pixels where driver reads them and RHI thread only issues the copy.
+ *
+ * Memory is sub-allocated linearly from fixed size blocks. Full block is
+ * retired; once all its allocations are released, RHI thread inserts fence
+ * after the last copy and block is reused when the fence is signaled.
+ * Pool grows on RHI thread (up to `MAX_BLOCKS`) when allocations fail.
+ *
+ * Requires `GL_ARB_buffer_storage` (GL 4.4); otherwise allocations
+ * fail and textures are updated from client memory.
+ *
+ * @note Allocate is thread-safe; other methods are for RHI thread only.
+ */
+class GLStagingPool final {
+public:
+    /** Size of single staging block */
+    static const size_t BLOCK_SIZE = 16 * 1024 * 1024;
+    /** Number of blocks created on start */
+    static const uint32 INITIAL_BLOCKS = 2;
+    /** Max number of blocks */
+    static const uint32 MAX_BLOCKS = 8;
+    /** Alignment of allocations */
+    static const size_t ALIGNMENT = 256;
+
+    BRK_API GLStagingPool();
+
+    /** All allocated data must be released before; blocks with live allocations are leaked */
+    BRK_API ~GLStagingPool();
+
+    /**
+     * @brief Allocate staging memory (thread-safe)
+     *
+     * @param size Size in bytes to allocate
+     * @return Writable data in staging memory; null if no free memory or not supported
+     */
+    BRK_API Ref<Data> Allocate(size_t size);
+
+    /**
+     * @brief Find staging buffer of memory
+     *
+     * @param memory Pointer to memory of data
+     * @param[out] buffer Staging buffer containing memory
+     * @param[out] offset Offset of memory in the buffer
+     *
+     * @return True if memory is allocated from this pool
+     */
+    BRK_API bool Find(const void *memory, GLuint &buffer, size_t &offset) const;
+
+    /** Fence retired blocks, recycle completed and grow pool if required; call once per frame */
+    BRK_API void Update();
+
+    /** @return True if persistent mapping is supported */
+    bool IsSupported() const { return mSupported; }
+
+    /** @return Total size of staging blocks */
+    BRK_API size_t GetCapacity() const;
+
+private:
+    enum class State {
+        Free,
+        Active,
+        Retired,
+        Fenced
+    };
+
+    struct Block {
+        GLuint buffer = 0;         /** Pixel unpack buffer */
+        uint8 *mapped = nullptr;   /** Persistently mapped memory */
+        size_t offset = 0;         /** Offset of next allocation */
+        uint32 allocations = 0;    /** Number of not released allocations */
+        GLsync fence = nullptr;    /** Fence after last copy from block */
+        State state = State::Free; /** Block state */
+    };
+
+    /** Shared with released data, which may outlive the pool */
+    struct Shared {
+        std::vector<Block> blocks;
+        uint32 misses = 0; /** Failed allocations since last update */
+        std::mutex mutex;
+    };
+
+    bool AddBlock();
+    static void Release(const std::shared_ptr<Shared> &shared, uint32 index);
+
+private:
+    std::shared_ptr<Shared> mShared;
+    bool mSupported = false;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_GLSTAGINGPOOL_HPP
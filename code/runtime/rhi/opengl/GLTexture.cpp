@@ -25,11 +25,42 @@
 /* SOFTWARE.                                                                      */
 /**********************************************************************************/
 
+#include <core/Engine.hpp>
 #include <core/image/ImageUtil.hpp>
+#include <core/profiler/Counters.hpp>
+#include <rhi/opengl/GLDevice.hpp>
 #include <rhi/opengl/GLTexture.hpp>
 
 BRK_NS_BEGIN
 
+namespace {
+    /**
+     * Bind staging buffer if memory is allocated in staging pool.
+     * @return Pointer to pixels or offset in bound unpack buffer
+     */
+    const void *BindPixels(const Ref<Data> &memory, bool &bound) {
+        auto &device = static_cast<GLDevice &>(Engine::Instance().GetRHIDevice());
+        GLuint buffer;
+        size_t offset;
+
+        bound = device.GetStagingPool().Find(memory->GetData(), buffer, offset);
+
+        if (!bound)
+            return memory->GetData();
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+        BRK_GL_CATCH_ERR();
+        return reinterpret_cast<const void *>(offset);
+    }
+
+    void UnbindPixels(bool bound) {
+        if (bound) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            BRK_GL_CATCH_ERR();
+        }
+    }
+}// namespace
+
 GLTexture::GLTexture(const RHITextureDesc &desc) {
     mDesc = desc;
 }
@@ -38,6 +69,7 @@ GLTexture::~GLTexture() {
     if (mHandle) {
         glDeleteTextures(1, &mHandle);
         mHandle = 0;
+        BRK_GAUGE_ADD("rhi.textures_resident", -1);
     }
 }
 
@@ -56,6 +88,9 @@ void GLTexture::Initialize() {
             BRK_ERROR("Unsupported RHITextureType");
             break;
     }
+
+    if (mHandle)
+        BRK_GAUGE_ADD("rhi.textures_resident", 1);
 }
 
 void GLTexture::Initialize2d() {
@@ -195,7 +230,8 @@ void GLTexture::UpdateTexture2D(uint32 mipLevel, const Rect2u &region, const Ref
     assert(region.z() <= mipSize.x());
     assert(region.w() <= mipSize.y());
 
-    const auto *pixels = memory->GetData();
+    bool bound;
+    const auto *pixels = BindPixels(memory, bound);
     auto dataFormat = GLDefs::GetTextureDataBaseFormat(GetTextureFormat());
     auto dataType = GLDefs::GetTextureDataType(GetTextureFormat());
     auto target = GetTextureTarget();
@@ -214,6 +250,8 @@ void GLTexture::UpdateTexture2D(uint32 mipLevel, const Rect2u &region, const Ref
     glTexSubImage2D(target, mipLevel, xoffset, yoffset, width, height, dataFormat, dataType, pixels);
     BRK_GL_CATCH_ERR();
 
+    UnbindPixels(bound);
+
     glBindTexture(target, 0);
     BRK_GL_CATCH_ERR();
 }
@@ -229,7 +267,8 @@ void GLTexture::UpdateTexture2DArray(uint32 arrayIndex, uint32 mipLevel, const R
     assert(region.z() <= mipSize.x());
     assert(region.w() <= mipSize.y());
 
-    const auto *pixels = memory->GetData();
+    bool bound;
+    const auto *pixels = BindPixels(memory, bound);
     auto dataFormat = GLDefs::GetTextureDataBaseFormat(GetTextureFormat());
     auto dataType = GLDefs::GetTextureDataType(GetTextureFormat());
     auto target = GetTextureTarget();
@@ -248,6 +287,8 @@ void GLTexture::UpdateTexture2DArray(uint32 arrayIndex, uint32 mipLevel, const R
     glTexSubImage3D(target, mipLevel, xoffset, yoffset, arrayIndex, width, height, 1, dataFormat, dataType, pixels);
     BRK_GL_CATCH_ERR();
 
+    UnbindPixels(bound);
+
     glBindTexture(target, 0);
     BRK_GL_CATCH_ERR();
 }
@@ -262,7 +303,8 @@ void GLTexture::UpdateTextureCube(RHITextureCubemapFace face, uint32 mipLevel, c
     assert(region.z() <= mipSize.x());
     assert(region.w() <= mipSize.y());
 
-    const auto *pixels = memory->GetData();
+    bool bound;
+    const auto *pixels = BindPixels(memory, bound);
     auto dataFormat = GLDefs::GetTextureDataBaseFormat(GetTextureFormat());
     auto dataType = GLDefs::GetTextureDataType(GetTextureFormat());
 
@@ -283,6 +325,8 @@ void GLTexture::UpdateTextureCube(RHITextureCubemapFace face, uint32 mipLevel, c
     glTexSubImage2D(faceTarget, mipLevel, xoffset, yoffset, width, height, dataFormat, dataType, pixels);
     BRK_GL_CATCH_ERR();
 
+    UnbindPixels(bound);
+
     glBindTexture(target, 0);
     BRK_GL_CATCH_ERR();
 }
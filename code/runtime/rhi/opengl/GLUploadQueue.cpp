@@ -0,0 +1,84 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/profiler/Counters.hpp>
+#include <rhi/opengl/GLTexture.hpp>
+#include <rhi/opengl/GLUploadQueue.hpp>
+
+BRK_NS_BEGIN
+
+GLUploadQueue::GLUploadQueue(size_t frameBudget) : mFrameBudget(frameBudget) {
+}
+
+void GLUploadQueue::Submit(Ref<GLTexture> texture, size_t bytes, bool staged, Upload upload) {
+    auto query = mQueued.find(texture.Get());
+    auto hasQueued = query != mQueued.end();
+
+    if (!hasQueued && (!staged || FitsBudget(bytes))) {
+        Issue(bytes, upload);
+        return;
+    }
+
+    if (hasQueued)
+        query->second += 1;
+    else
+        mQueued.emplace(texture.Get(), 1);
+
+    mQueuedBytes += bytes;
+    mQueue.push_back({std::move(texture), bytes, std::move(upload)});
+    BRK_COUNTER_ADD("rhi.texture_uploads_deferred", 1);
+}
+
+void GLUploadQueue::Update() {
+    mFrameBytes = 0;
+
+    while (!mQueue.empty() && FitsBudget(mQueue.front().bytes)) {
+        auto entry = std::move(mQueue.front());
+        mQueue.pop_front();
+
+        auto query = mQueued.find(entry.texture.Get());
+        if (--query->second == 0)
+            mQueued.erase(query);
+
+        mQueuedBytes -= entry.bytes;
+        Issue(entry.bytes, entry.upload);
+    }
+
+    BRK_GAUGE_SET("rhi.texture_upload_queued_bytes", mQueuedBytes);
+}
+
+bool GLUploadQueue::FitsBudget(size_t bytes) const {
+    // At least one upload per frame is issued, even if it is larger than budget
+    return mFrameBytes == 0 || mFrameBytes + bytes <= mFrameBudget;
+}
+
+void GLUploadQueue::Issue(size_t bytes, const Upload &upload) {
+    upload();
+    mFrameBytes += bytes;
+}
+
+BRK_NS_END
@@ -0,0 +1,117 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_GLUPLOADQUEUE_HPP
+#define BERSERK_GLUPLOADQUEUE_HPP
+
+#include <core/Typedefs.hpp>
+#include <core/templates/Ref.hpp>
+#include <rhi/opengl/GLDefs.hpp>
+
+#include <deque>
+#include <functional>
+#include <unordered_map>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup opengl
+ * @{
+ */
+
+/**
+ * @class GLUploadQueue
+ * @brief Spreads texture uploads from staging memory over frames
+ *
+ * Uploads from staging memory are issued immediately while bytes issued
+ * in the frame fit into the budget; others are queued and issued on next
+ * frames in submit order, so many textures streamed in at once do not
+ * stall single frame. Uploads from client memory are never deferred.
+ *
+ * Operations on a texture with queued uploads (including mip maps
+ * generation) are queued too, so operations on a texture keep order.
+ *
+ * @note Must be used on RHI thread only.
+ */
+class GLUploadQueue final {
+public:
+    /** Default bytes of staged uploads issued per frame */
+    static const size_t DEFAULT_FRAME_BUDGET = 32 * 1024 * 1024;
+
+    /** Upload operation */
+    using Upload = std::function<void()>;
+
+    BRK_API explicit GLUploadQueue(size_t frameBudget = DEFAULT_FRAME_BUDGET);
+    BRK_API ~GLUploadQueue() = default;
+
+    /**
+     * @brief Issue or queue texture operation
+     *
+     * @param texture Texture to update
+     * @param bytes Number of uploaded bytes
+     * @param staged True if uploaded from staging memory and can be deferred
+     * @param upload Operation to issue
+     */
+    BRK_API void Submit(Ref<class GLTexture> texture, size_t bytes, bool staged, Upload upload);
+
+    /** Start new frame and issue queued uploads within budget */
+    BRK_API void Update();
+
+    /** Set bytes of staged uploads issued per frame */
+    void SetFrameBudget(size_t frameBudget) { mFrameBudget = frameBudget; }
+
+    /** @return Number of queued operations */
+    uint32 GetQueuedCount() const { return static_cast<uint32>(mQueue.size()); }
+
+    /** @return Number of queued bytes */
+    size_t GetQueuedBytes() const { return mQueuedBytes; }
+
+private:
+    struct Entry {
+        Ref<class GLTexture> texture;
+        size_t bytes;
+        Upload upload;
+    };
+
+    bool FitsBudget(size_t bytes) const;
+    void Issue(size_t bytes, const Upload &upload);
+
+private:
+    std::deque<Entry> mQueue;                                   /** Deferred operations in submit order */
+    std::unordered_map<const class GLTexture *, uint32> mQueued; /** Number of queued operations of texture */
+    size_t mFrameBudget;
+    size_t mFrameBytes = 0;  /** Bytes issued in current frame */
+    size_t mQueuedBytes = 0; /** Bytes of queued operations */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_GLUPLOADQUEUE_HPP
@@ -25,6 +25,7 @@
 /* SOFTWARE.                                                                      */
 /**********************************************************************************/
 
+#include <core/profiler/Counters.hpp>
 #include <rhi/opengl/GLBuffer.hpp>
 #include <rhi/opengl/GLVaoCache.hpp>
 
@@ -50,6 +51,7 @@ GLuint GLVaoCache::GetOrCreateVao(const GLVaoDescriptor &descriptor) {
     // Found entry, return it and update frame used info
     if (value != mEntries.end()) {
         value->second.frameUsed = mCurrentFrame;
+        BRK_COUNTER_ADD("rhi.vao_cache_hits", 1);
         return value->second.handle;
     }
 
@@ -79,6 +81,7 @@ void GLVaoCache::GC() {
         }
     }
 
+    BRK_GAUGE_SET("rhi.vao_cached", mEntries.size());
     mCurrentFrame += 1;
 }
 
@@ -146,12 +149,15 @@ void GLVaoCache::CreateVaoObject(const GLVaoDescriptor &descriptor, GLVaoCache::
     vao.handle = handle;
     vao.frameUsed = mCurrentFrame;
 
+    BRK_COUNTER_ADD("rhi.vao_created", 1);
     BRK_INFO("CreateFromImage VAO hnd=" << vao.handle << " frame used=" << vao.frameUsed);
 }
 
 void GLVaoCache::ReleaseVaoObject(const GLVaoCache::GLVaoValue &vao) const {
     glDeleteVertexArrays(1, &vao.handle);
     BRK_GL_CATCH_ERR();
+
+    BRK_COUNTER_ADD("rhi.vao_released", 1);
     BRK_INFO("Release VAO hnd=" << vao.handle << " frame used=" << vao.frameUsed);
 }
 
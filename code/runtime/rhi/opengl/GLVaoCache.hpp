@@ -28,7 +28,7 @@
 #ifndef BERSERK_GLVAOCACHE_HPP
 #define BERSERK_GLVAOCACHE_HPP
 
-#include <core/Crc32.hpp>
+#include <core/Hash64.hpp>
 #include <rhi/RHIBuffer.hpp>
 #include <rhi/RHIVertexDeclaration.hpp>
 
@@ -68,7 +68,7 @@ struct GLVaoKey {
     std::array<Ref<RHIVertexBuffer>, RHILimits::MAX_VERTEX_BUFFERS> buffers;
     Ref<RHIIndexBuffer> indices;
     Ref<RHIVertexDeclaration> declaration;
-    Crc32Hash hash;
+    uint64 hash;
 
     /** @brief Initialize key from descriptor */
     inline void Setup(const GLVaoDescriptor &descriptor) {
@@ -76,7 +76,7 @@ struct GLVaoKey {
         std::copy(descriptor.buffers.begin(), descriptor.buffers.end(), buffers.begin());
         indices = descriptor.indices;
         declaration = descriptor.declaration;
-        hash = Crc32::Hash(this, sizeof(GLVaoKey));
+        hash = Hash64::Hash(this, sizeof(GLVaoKey));
     }
 
     /** @brief Fast compare op */
@@ -99,7 +99,7 @@ namespace std {
     struct hash<BRK_NS::GLVaoKey> {
     public:
         size_t operator()(const BRK_NS::GLVaoKey &key) const {
-            return key.hash;
+            return static_cast<size_t>(key.hash);
         }
     };
 
@@ -0,0 +1,377 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/math/MathSimd.hpp>
+#include <core/profiler/Counters.hpp>
+#include <scene/SceneHierarchy.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+BRK_NS_BEGIN
+
+SceneHierarchy::SceneHierarchy(JobSystem *jobSystem) : mJobSystem(jobSystem) {
+}
+
+uint32 SceneHierarchy::CreateNode(uint32 parent) {
+    assert(parent == NULL_NODE || (parent < mNodes.size() && mNodes[parent].alive));
+
+    uint32 node;
+
+    if (!mFreeNodes.empty()) {
+        node = mFreeNodes.back();
+        mFreeNodes.pop_back();
+        mNodes[node] = Node();
+    } else {
+        node = static_cast<uint32>(mNodes.size());
+        mNodes.emplace_back();
+    }
+
+    // Appended to the end until next update re-sorts arrays
+    mNodes[node].alive = true;
+    mNodes[node].slot = static_cast<uint32>(mSlotToNode.size());
+
+    mSlotToNode.push_back(node);
+    mPositions.emplace_back(0.0f, 0.0f, 0.0f);
+    mRotations.emplace_back();
+    mScales.emplace_back(1.0f, 1.0f, 1.0f);
+    mParents.push_back(static_cast<uint32>(NULL_NODE));
+    mFlags.push_back(static_cast<uint8>(FLAG_DIRTY));
+    mWorld.push_back(MathUtils3d::IdentityMatrix());
+    mLocalBounds.emplace_back();
+    mWorldBounds.emplace_back();
+
+    Link(node, parent);
+
+    mNodesCount += 1;
+    mDirtyCount += 1;
+    mLayoutDirty = true;
+
+    return node;
+}
+
+void SceneHierarchy::DestroyNode(uint32 node) {
+    assert(node < mNodes.size() && mNodes[node].alive);
+
+    Unlink(node);
+
+    std::vector<uint32> stack;
+    stack.push_back(node);
+
+    while (!stack.empty()) {
+        uint32 current = stack.back();
+        stack.pop_back();
+
+        for (uint32 child = mNodes[current].firstChild; child != NULL_NODE; child = mNodes[child].nextSibling)
+            stack.push_back(child);
+
+        Node &n = mNodes[current];
+        mSlotToNode[n.slot] = NULL_NODE;
+        n = Node();
+        mFreeNodes.push_back(current);
+        mNodesCount -= 1;
+    }
+
+    mLayoutDirty = true;
+}
+
+bool SceneHierarchy::SetParent(uint32 node, uint32 parent) {
+    assert(node < mNodes.size() && mNodes[node].alive);
+    assert(parent == NULL_NODE || (parent < mNodes.size() && mNodes[parent].alive));
+
+    if (mNodes[node].parent == parent)
+        return true;
+
+    for (uint32 ancestor = parent; ancestor != NULL_NODE; ancestor = mNodes[ancestor].parent) {
+        if (ancestor == node)
+            return false;
+    }
+
+    Unlink(node);
+    Link(node, parent);
+
+    // Depth of the whole sub-tree is changed
+    std::vector<uint32> stack;
+    stack.push_back(node);
+
+    while (!stack.empty()) {
+        uint32 current = stack.back();
+        stack.pop_back();
+
+        for (uint32 child = mNodes[current].firstChild; child != NULL_NODE; child = mNodes[child].nextSibling) {
+            mNodes[child].depth = mNodes[current].depth + 1;
+            stack.push_back(child);
+        }
+    }
+
+    MarkDirty(node);
+    mLayoutDirty = true;
+
+    return true;
+}
+
+void SceneHierarchy::Clear() {
+    mNodes.clear();
+    mFreeNodes.clear();
+    mSlotToNode.clear();
+    mLevels.clear();
+    mPositions.clear();
+    mRotations.clear();
+    mScales.clear();
+    mParents.clear();
+    mFlags.clear();
+    mWorld.clear();
+    mLocalBounds.clear();
+    mWorldBounds.clear();
+    mNodesCount = 0;
+    mDirtyCount = 0;
+    mUpdatedCount = 0;
+    mLayoutDirty = false;
+}
+
+void SceneHierarchy::SetLocalPosition(uint32 node, const Vec3f &position) {
+    mPositions[mNodes[node].slot] = position;
+    MarkDirty(node);
+}
+
+void SceneHierarchy::SetLocalRotation(uint32 node, const Quatf &rotation) {
+    mRotations[mNodes[node].slot] = rotation;
+    MarkDirty(node);
+}
+
+void SceneHierarchy::SetLocalScale(uint32 node, const Vec3f &scale) {
+    mScales[mNodes[node].slot] = scale;
+    MarkDirty(node);
+}
+
+void SceneHierarchy::SetLocalTransform(uint32 node, const Transformf &transform) {
+    uint32 slot = mNodes[node].slot;
+    mPositions[slot] = transform.GetOffset();
+    mRotations[slot] = transform.GetRotation();
+    mScales[slot] = transform.GetScale();
+    MarkDirty(node);
+}
+
+void SceneHierarchy::SetLocalBounds(uint32 node, const Aabbf &aabb) {
+    uint32 slot = mNodes[node].slot;
+    mLocalBounds[slot] = aabb;
+    mFlags[slot] |= FLAG_BOUNDS;
+    MarkDirty(node);
+}
+
+void SceneHierarchy::SetMesh(uint32 node, const Ref<Mesh> &mesh) {
+    mNodes[node].mesh = mesh;
+
+    if (mesh.IsNotNull()) {
+        SetLocalBounds(node, mesh->GetAabb());
+    } else {
+        uint32 slot = mNodes[node].slot;
+        mFlags[slot] &= static_cast<uint8>(~FLAG_BOUNDS);
+        mWorldBounds[slot] = Aabbf();
+    }
+}
+
+void SceneHierarchy::Update() {
+    if (mLayoutDirty)
+        RebuildLayout();
+
+    // Nothing to recompute and no changed flags to reset
+    if (mDirtyCount == 0 && mUpdatedCount == 0)
+        return;
+
+    std::atomic<uint32> updated{0};
+
+    // Parents are processed strictly before children, level by level
+    for (uint32 level = 0; level + 1 < mLevels.size(); level++) {
+        uint32 begin = mLevels[level];
+        uint32 count = mLevels[level + 1] - begin;
+
+        auto process = [&](uint32 first, uint32 last) {
+            updated.fetch_add(UpdateRange(begin + first, begin + last), std::memory_order_relaxed);
+        };
+
+        if (mJobSystem)
+            mJobSystem->ParallelFor(count, CHUNK_SIZE, process);
+        else
+            process(0, count);
+    }
+
+    mUpdatedCount = updated.load();
+    mDirtyCount = 0;
+
+    BRK_COUNTER_ADD("scene.nodes_updated", mUpdatedCount);
+    BRK_GAUGE_SET("scene.nodes", mNodesCount);
+}
+
+void SceneHierarchy::GatherWorldMatrices(const uint32 *nodes, uint32 count, float *out) const {
+    for (uint32 i = 0; i < count; i++)
+        MathSimd::TransposeMat4(mWorld[mNodes[nodes[i]].slot].values, out + i * 16);
+}
+
+void SceneHierarchy::Link(uint32 node, uint32 parent) {
+    Node &n = mNodes[node];
+    n.parent = parent;
+    n.prevSibling = NULL_NODE;
+    n.nextSibling = NULL_NODE;
+    n.depth = 0;
+
+    if (parent == NULL_NODE)
+        return;
+
+    Node &p = mNodes[parent];
+    n.depth = p.depth + 1;
+    n.nextSibling = p.firstChild;
+
+    if (p.firstChild != NULL_NODE)
+        mNodes[p.firstChild].prevSibling = node;
+
+    p.firstChild = node;
+}
+
+void SceneHierarchy::Unlink(uint32 node) {
+    Node &n = mNodes[node];
+
+    if (n.parent == NULL_NODE)
+        return;
+
+    if (n.prevSibling != NULL_NODE)
+        mNodes[n.prevSibling].nextSibling = n.nextSibling;
+    else
+        mNodes[n.parent].firstChild = n.nextSibling;
+
+    if (n.nextSibling != NULL_NODE)
+        mNodes[n.nextSibling].prevSibling = n.prevSibling;
+
+    n.parent = NULL_NODE;
+    n.prevSibling = NULL_NODE;
+    n.nextSibling = NULL_NODE;
+}
+
+void SceneHierarchy::MarkDirty(uint32 node) {
+    assert(node < mNodes.size() && mNodes[node].alive);
+
+    uint8 &flags = mFlags[mNodes[node].slot];
+
+    if ((flags & FLAG_DIRTY) == 0) {
+        flags |= FLAG_DIRTY;
+        mDirtyCount += 1;
+    }
+}
+
+void SceneHierarchy::RebuildLayout() {
+    // Counting sort of alive nodes by depth, keeping relative order inside level
+    uint32 levelsCount = 0;
+
+    for (auto node : mSlotToNode) {
+        if (node != NULL_NODE)
+            levelsCount = std::max(levelsCount, mNodes[node].depth + 1);
+    }
+
+    mLevels.assign(levelsCount + 1, 0);
+
+    for (auto node : mSlotToNode) {
+        if (node != NULL_NODE)
+            mLevels[mNodes[node].depth + 1] += 1;
+    }
+
+    for (uint32 level = 1; level <= levelsCount; level++)
+        mLevels[level] += mLevels[level - 1];
+
+    std::vector<uint32> cursor(mLevels.begin(), mLevels.end() - 1);
+    std::vector<uint32> order(mNodesCount);
+
+    for (uint32 slot = 0; slot < mSlotToNode.size(); slot++) {
+        uint32 node = mSlotToNode[slot];
+        if (node != NULL_NODE)
+            order[cursor[mNodes[node].depth]++] = slot;
+    }
+
+    Permute(mSlotToNode, order);
+    Permute(mPositions, order);
+    Permute(mRotations, order);
+    Permute(mScales, order);
+    Permute(mFlags, order);
+    Permute(mWorld, order);
+    Permute(mLocalBounds, order);
+    Permute(mWorldBounds, order);
+
+    for (uint32 slot = 0; slot < mNodesCount; slot++)
+        mNodes[mSlotToNode[slot]].slot = slot;
+
+    mParents.resize(mNodesCount);
+
+    for (uint32 slot = 0; slot < mNodesCount; slot++) {
+        uint32 parent = mNodes[mSlotToNode[slot]].parent;
+        mParents[slot] = parent != NULL_NODE ? mNodes[parent].slot : static_cast<uint32>(NULL_NODE);
+    }
+
+    mLayoutDirty = false;
+}
+
+uint32 SceneHierarchy::UpdateRange(uint32 begin, uint32 end) {
+    uint32 updated = 0;
+
+    for (uint32 slot = begin; slot < end; slot++) {
+        uint32 parent = mParents[slot];
+        uint8 flags = mFlags[slot];
+        bool changed = (flags & FLAG_DIRTY) || (parent != NULL_NODE && (mFlags[parent] & FLAG_CHANGED));
+
+        if (!changed) {
+            mFlags[slot] = static_cast<uint8>(flags & ~FLAG_CHANGED);
+            continue;
+        }
+
+        // Local = translation * scale * rotation
+        Mat4x4f local = mRotations[slot].AsMatrix();
+        const Vec3f &scale = mScales[slot];
+        const Vec3f &position = mPositions[slot];
+
+        for (uint32 i = 0; i < 3; i++) {
+            float *row = local[i];
+            row[0] *= scale[i];
+            row[1] *= scale[i];
+            row[2] *= scale[i];
+            row[3] = position[i];
+        }
+
+        if (parent != NULL_NODE)
+            MathSimd::MultiplyMat4(mWorld[parent].values, local.values, mWorld[slot].values);
+        else
+            mWorld[slot] = local;
+
+        if (flags & FLAG_BOUNDS)
+            mWorldBounds[slot] = mLocalBounds[slot].Transformed(mWorld[slot]);
+
+        mFlags[slot] = static_cast<uint8>((flags & ~FLAG_DIRTY) | FLAG_CHANGED);
+        updated += 1;
+    }
+
+    return updated;
+}
+
+BRK_NS_END
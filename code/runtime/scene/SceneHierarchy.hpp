@@ -0,0 +1,209 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_SCENEHIERARCHY_HPP
+#define BERSERK_SCENEHIERARCHY_HPP
+
+#include <core/Config.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+#include <core/math/TAabb.hpp>
+#include <core/math/TMatMxN.hpp>
+#include <core/math/TQuat.hpp>
+#include <core/math/Transformf.hpp>
+#include <core/templates/Ref.hpp>
+#include <render/mesh/Mesh.hpp>
+
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup scene
+ * @{
+ */
+
+/**
+ * @class SceneHierarchy
+ * @brief Hierarchy of scene nodes with local and world transforms
+ *
+ * Node is identified by stable id, returned on creation. Hot per-node
+ * data (local position, rotation and scale, parent, world matrix and
+ * bounds) is stored in SoA arrays, sorted by node depth in the hierarchy,
+ * so all nodes of single level form contiguous range and every parent
+ * precedes its children. Structural changes (create, destroy, re-parent)
+ * only mark layout as dirty; arrays are re-sorted once on next update.
+ *
+ * Modification of local transform marks node as dirty. Update propagates
+ * changes level by level: node world matrix is recomputed if node is dirty
+ * or its parent world matrix was recomputed in this update. Levels are
+ * split into chunks processed on job system workers.
+ *
+ * Local matrix follows Transformf convention: translation * scale * rotation.
+ * World matrices of all nodes are stored contiguously in the hierarchy order.
+ *
+ * @note Not thread-safe; update runs on the calling thread and job system workers.
+ */
+class SceneHierarchy final {
+public:
+    static const uint32 NULL_NODE = 0xffffffff;
+    /** Max number of nodes of single level in a single job */
+    static const uint32 CHUNK_SIZE = 2 * 1024;
+
+    /** @param jobSystem Optional job system for parallel update */
+    BRK_API explicit SceneHierarchy(JobSystem *jobSystem = nullptr);
+    BRK_API ~SceneHierarchy() = default;
+
+    /** Create node with identity local transform; @return Node id */
+    BRK_API uint32 CreateNode(uint32 parent = NULL_NODE);
+    /** Destroy node and all its children */
+    BRK_API void DestroyNode(uint32 node);
+    /** Attach node to new parent (null to make it root); @return False if parent is node itself or its child */
+    BRK_API bool SetParent(uint32 node, uint32 parent);
+    /** Destroy all nodes */
+    BRK_API void Clear();
+
+    BRK_API void SetLocalPosition(uint32 node, const Vec3f &position);
+    BRK_API void SetLocalRotation(uint32 node, const Quatf &rotation);
+    BRK_API void SetLocalScale(uint32 node, const Vec3f &scale);
+    BRK_API void SetLocalTransform(uint32 node, const Transformf &transform);
+
+    /** Set bounds of node content in local space (used to compute world bounds) */
+    BRK_API void SetLocalBounds(uint32 node, const Aabbf &aabb);
+    /** Set mesh of the node; local bounds are taken from mesh */
+    BRK_API void SetMesh(uint32 node, const Ref<Mesh> &mesh);
+
+    /**
+     * @brief Propagate transforms
+     *
+     * Re-sorts node arrays if hierarchy structure was changed and
+     * recomputes world matrices and bounds of changed nodes.
+     */
+    BRK_API void Update();
+
+    /**
+     * @brief Gather world matrices of nodes for GPU upload
+     *
+     * @param nodes Ids of nodes to gather
+     * @param count Number of nodes
+     * @param[out] out Destination for count * 16 floats, matrices are written in column-major order
+     */
+    BRK_API void GatherWorldMatrices(const uint32 *nodes, uint32 count, float *out) const;
+
+    BRK_API uint32 GetParent(uint32 node) const { return mNodes[node].parent; }
+    BRK_API uint32 GetDepth(uint32 node) const { return mNodes[node].depth; }
+    BRK_API const Ref<Mesh> &GetMesh(uint32 node) const { return mNodes[node].mesh; }
+
+    BRK_API const Vec3f &GetLocalPosition(uint32 node) const { return mPositions[mNodes[node].slot]; }
+    BRK_API const Quatf &GetLocalRotation(uint32 node) const { return mRotations[mNodes[node].slot]; }
+    BRK_API const Vec3f &GetLocalScale(uint32 node) const { return mScales[mNodes[node].slot]; }
+
+    /** @return World matrix of node, computed on last update */
+    BRK_API const Mat4x4f &GetWorldMatrix(uint32 node) const { return mWorld[mNodes[node].slot]; }
+    /** @return World bounds of node, computed on last update (empty if node has no bounds) */
+    BRK_API const Aabbf &GetWorldAabb(uint32 node) const { return mWorldBounds[mNodes[node].slot]; }
+    /** @return True if node has local bounds */
+    BRK_API bool HasBounds(uint32 node) const { return (mFlags[mNodes[node].slot] & FLAG_BOUNDS) != 0; }
+    /** @return True if world transform of node was recomputed on last update */
+    BRK_API bool IsWorldChanged(uint32 node) const { return (mFlags[mNodes[node].slot] & FLAG_CHANGED) != 0; }
+
+    /** @return World matrices of all nodes in hierarchy order (valid after update) */
+    BRK_API const Mat4x4f *GetWorldMatrices() const { return mWorld.data(); }
+    /** @return Index of node in hierarchy order (valid after update) */
+    BRK_API uint32 GetNodeIndex(uint32 node) const { return mNodes[node].slot; }
+    /** @return Node id at index in hierarchy order */
+    BRK_API uint32 GetNodeAt(uint32 index) const { return mSlotToNode[index]; }
+
+    /** @return Number of alive nodes */
+    BRK_API uint32 GetNodesCount() const { return mNodesCount; }
+    /** @return Number of hierarchy levels (valid after update) */
+    BRK_API uint32 GetLevelsCount() const { return mLevels.empty() ? 0 : static_cast<uint32>(mLevels.size() - 1); }
+    /** @return Number of nodes with recomputed world matrix on last update */
+    BRK_API uint32 GetUpdatedCount() const { return mUpdatedCount; }
+
+private:
+    static const uint8 FLAG_DIRTY = 1u << 0u;   /** Local transform changed */
+    static const uint8 FLAG_CHANGED = 1u << 1u; /** World transform recomputed on last update */
+    static const uint8 FLAG_BOUNDS = 1u << 2u;  /** Node has local bounds */
+
+    /** Cold per-node data, indexed by node id */
+    struct Node {
+        Ref<Mesh> mesh;                 /** Optional mesh of the node */
+        uint32 parent = NULL_NODE;      /** Parent node (or next free node) */
+        uint32 firstChild = NULL_NODE;  /** First child in children list */
+        uint32 nextSibling = NULL_NODE; /** Next node in parent children list */
+        uint32 prevSibling = NULL_NODE; /** Previous node in parent children list */
+        uint32 slot = NULL_NODE;        /** Index in SoA arrays */
+        uint32 depth = 0;               /** Depth in hierarchy (roots have 0) */
+        bool alive = false;
+    };
+
+    void Link(uint32 node, uint32 parent);
+    void Unlink(uint32 node);
+    void MarkDirty(uint32 node);
+    void RebuildLayout();
+    uint32 UpdateRange(uint32 begin, uint32 end);
+
+    template<typename T>
+    static void Permute(std::vector<T> &data, const std::vector<uint32> &order) {
+        std::vector<T> sorted;
+        sorted.reserve(order.size());
+        for (auto slot : order)
+            sorted.push_back(std::move(data[slot]));
+        data = std::move(sorted);
+    }
+
+private:
+    std::vector<Node> mNodes;          /** Nodes by id */
+    std::vector<uint32> mFreeNodes;    /** Ids of destroyed nodes for reuse */
+    std::vector<uint32> mSlotToNode;   /** Node id by slot (null for destroyed) */
+    std::vector<uint32> mLevels;       /** Begin slot of each level, last is total count */
+
+    /** SoA per-node data, indexed by slot */
+    std::vector<Vec3f> mPositions;
+    std::vector<Quatf> mRotations;
+    std::vector<Vec3f> mScales;
+    std::vector<uint32> mParents; /** Parent slot (null for roots) */
+    std::vector<uint8> mFlags;
+    std::vector<Mat4x4f> mWorld;
+    std::vector<Aabbf> mLocalBounds;
+    std::vector<Aabbf> mWorldBounds;
+
+    JobSystem *mJobSystem = nullptr;
+    uint32 mNodesCount = 0;
+    uint32 mDirtyCount = 0;
+    uint32 mUpdatedCount = 0;
+    bool mLayoutDirty = false;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_SCENEHIERARCHY_HPP
@@ -0,0 +1,138 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/Memory.hpp>
+#include <scene/ecs/Archetype.hpp>
+
+#include <cassert>
+
+BRK_NS_BEGIN
+
+namespace {
+    uint32 AlignUp(uint32 value, uint32 alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}// namespace
+
+Archetype::Archetype(ComponentMask mask) : mMask(mask) {
+    Memory::Set(mLookup, 0xff, sizeof(mLookup));
+
+    const auto alignment = static_cast<uint32>(Memory::ALIGNMENT);
+    uint32 rowSize = sizeof(Entity);
+
+    for (uint32 id = 0; id < ComponentRegistry::MAX_COMPONENTS; id++) {
+        if (mask & (static_cast<ComponentMask>(1) << id)) {
+            mLookup[id] = static_cast<uint8>(mComponents.size());
+            mComponents.push_back(id);
+            mSizes.push_back(ComponentRegistry::GetInfo(id).size);
+            rowSize += mSizes.back();
+        }
+    }
+
+    // Reserve space for aligning start of each array
+    uint32 padding = alignment * static_cast<uint32>(mComponents.size() + 1);
+    mCapacity = (CHUNK_SIZE - padding) / rowSize;
+    assert(mCapacity > 0);
+
+    uint32 offset = AlignUp(mCapacity * static_cast<uint32>(sizeof(Entity)), alignment);
+    for (auto size : mSizes) {
+        mOffsets.push_back(offset);
+        offset = AlignUp(offset + mCapacity * size, alignment);
+    }
+
+    assert(offset <= CHUNK_SIZE);
+}
+
+Archetype::~Archetype() {
+    for (uint32 row = 0; row < mCount; row++) {
+        for (auto id : mComponents)
+            ComponentRegistry::GetInfo(id).destruct(GetComponent(row, id));
+    }
+
+    for (auto chunk : mChunks)
+        Memory::Deallocate(chunk);
+}
+
+uint32 Archetype::AllocateRow(Entity entity) {
+    if (mCount == mChunks.size() * mCapacity)
+        mChunks.push_back(static_cast<uint8 *>(Memory::Allocate(CHUNK_SIZE)));
+
+    uint32 row = mCount;
+    GetEntities(row / mCapacity)[row % mCapacity] = entity;
+    mCount += 1;
+
+    return row;
+}
+
+void Archetype::ConstructRow(uint32 row) {
+    for (auto id : mComponents)
+        ComponentRegistry::GetInfo(id).construct(GetComponent(row, id));
+}
+
+Entity Archetype::RemoveRow(uint32 row, bool destroy) {
+    assert(row < mCount);
+
+    if (destroy) {
+        for (auto id : mComponents)
+            ComponentRegistry::GetInfo(id).destruct(GetComponent(row, id));
+    }
+
+    uint32 last = mCount - 1;
+    Entity moved;
+
+    if (row != last) {
+        for (auto id : mComponents)
+            ComponentRegistry::GetInfo(id).move(GetComponent(row, id), GetComponent(last, id));
+
+        moved = GetEntity(last);
+        GetEntities(row / mCapacity)[row % mCapacity] = moved;
+    }
+
+    mCount -= 1;
+
+    // Release empty chunk at the end
+    if (mCount <= (mChunks.size() - 1) * mCapacity) {
+        Memory::Deallocate(mChunks.back());
+        mChunks.pop_back();
+    }
+
+    return moved;
+}
+
+void Archetype::MoveRow(uint32 row, Archetype &target, uint32 targetRow) {
+    for (auto id : mComponents) {
+        auto &info = ComponentRegistry::GetInfo(id);
+        void *component = GetComponent(row, id);
+
+        if (target.HasComponent(id))
+            info.move(target.GetComponent(targetRow, id), component);
+        else
+            info.destruct(component);
+    }
+}
+
+BRK_NS_END
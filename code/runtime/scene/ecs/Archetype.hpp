@@ -0,0 +1,143 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_ARCHETYPE_HPP
+#define BERSERK_ARCHETYPE_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <scene/ecs/Component.hpp>
+#include <scene/ecs/Entity.hpp>
+
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup scene
+ * @{
+ */
+
+/**
+ * @class Archetype
+ * @brief Storage of entities with the same set of components
+ *
+ * Entities are stored densely in fixed size chunks. Chunk keeps
+ * array of entity ids followed by array of each component (SoA),
+ * so iteration over components touches only required arrays.
+ * All chunks are full except the last one; removal moves the last
+ * entity of archetype into the hole.
+ *
+ * Entity in archetype is addressed by row: chunk = row / capacity.
+ */
+class Archetype final {
+public:
+    /** Size of chunk in bytes */
+    static const uint32 CHUNK_SIZE = 16 * 1024;
+    /** Not present component */
+    static const uint32 NULL_COMPONENT = 0xff;
+
+    BRK_API explicit Archetype(ComponentMask mask);
+    BRK_API ~Archetype();
+
+    Archetype(const Archetype &) = delete;
+    Archetype &operator=(const Archetype &) = delete;
+
+    /**
+     * @brief Allocate row for entity
+     * @note Components are not constructed
+     * @return Row of the entity
+     */
+    BRK_API uint32 AllocateRow(Entity entity);
+
+    /** Default construct components of row */
+    BRK_API void ConstructRow(uint32 row);
+
+    /**
+     * @brief Remove row, moving last row of archetype in its place
+     *
+     * @param row Row to remove
+     * @param destroy True to destroy components of row; false if they were already moved out
+     * @return Entity moved to row (null if no entity moved)
+     */
+    BRK_API Entity RemoveRow(uint32 row, bool destroy);
+
+    /** Move components of row to other archetype row (components not present in target are destroyed) */
+    BRK_API void MoveRow(uint32 row, Archetype &target, uint32 targetRow);
+
+    /** @return Pointer to component of entity in row (null if not present) */
+    void *GetComponent(uint32 row, uint32 componentId) const {
+        uint32 index = mLookup[componentId];
+        if (index == NULL_COMPONENT)
+            return nullptr;
+        return mChunks[row / mCapacity] + mOffsets[index] + (row % mCapacity) * mSizes[index];
+    }
+
+    /** @return Array of component in chunk (null if not present) */
+    void *GetComponentArray(uint32 chunk, uint32 componentId) const {
+        uint32 index = mLookup[componentId];
+        return index != NULL_COMPONENT ? mChunks[chunk] + mOffsets[index] : nullptr;
+    }
+
+    /** @return Array of entities in chunk */
+    Entity *GetEntities(uint32 chunk) const { return reinterpret_cast<Entity *>(mChunks[chunk]); }
+    /** @return Entity in row */
+    Entity GetEntity(uint32 row) const { return GetEntities(row / mCapacity)[row % mCapacity]; }
+    /** @return Number of entities in chunk */
+    uint32 GetChunkSize(uint32 chunk) const { return chunk + 1 < mChunks.size() ? mCapacity : mCount - chunk * mCapacity; }
+
+    /** @return True if archetype has component */
+    bool HasComponent(uint32 componentId) const { return mLookup[componentId] != NULL_COMPONENT; }
+
+    ComponentMask GetMask() const { return mMask; }
+    const std::vector<uint32> &GetComponents() const { return mComponents; }
+    uint32 GetChunksCount() const { return static_cast<uint32>(mChunks.size()); }
+    uint32 GetChunkCapacity() const { return mCapacity; }
+    uint32 GetEntitiesCount() const { return mCount; }
+
+    /** Cached transitions of the archetypes graph (null if not resolved yet) */
+    Archetype *addEdges[ComponentRegistry::MAX_COMPONENTS] = {};
+    Archetype *removeEdges[ComponentRegistry::MAX_COMPONENTS] = {};
+
+private:
+    ComponentMask mMask;
+    std::vector<uint32> mComponents; /** Ids of components (ascending) */
+    std::vector<uint32> mOffsets;    /** Offset of component array in chunk */
+    std::vector<uint32> mSizes;      /** Size of component */
+    std::vector<uint8 *> mChunks;    /** Allocated chunks */
+    uint8 mLookup[ComponentRegistry::MAX_COMPONENTS];
+    uint32 mCapacity = 0; /** Max entities in chunk */
+    uint32 mCount = 0;    /** Entities count */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_ARCHETYPE_HPP
@@ -0,0 +1,88 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/io/Logger.hpp>
+#include <scene/ecs/Component.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+BRK_NS_BEGIN
+
+namespace {
+    struct Registry {
+        std::mutex mutex;
+        std::unordered_map<std::type_index, uint32> ids;
+        ComponentInfo infos[ComponentRegistry::MAX_COMPONENTS];
+        std::atomic<uint32> count{0};
+    };
+
+    Registry &GetRegistry() {
+        static Registry registry;
+        return registry;
+    }
+}// namespace
+
+const ComponentInfo &ComponentRegistry::GetInfo(uint32 id) {
+    auto &registry = GetRegistry();
+    assert(id < registry.count.load(std::memory_order_acquire));
+    return registry.infos[id];
+}
+
+uint32 ComponentRegistry::GetComponentsCount() {
+    return GetRegistry().count.load(std::memory_order_acquire);
+}
+
+uint32 ComponentRegistry::Register(std::type_index type, ComponentInfo info) {
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+
+    auto found = registry.ids.find(type);
+    if (found != registry.ids.end())
+        return found->second;
+
+    uint32 id = registry.count.load(std::memory_order_relaxed);
+
+    // Id is a bit in 64-bit component mask, so there is no way to continue
+    if (id >= MAX_COMPONENTS) {
+        BRK_ERROR("Too many component types registered (max " << MAX_COMPONENTS << ") type=" << type.name());
+        Logger::Instance().Flush();
+        std::abort();
+    }
+
+    info.id = id;
+    registry.infos[id] = info;
+    registry.ids.emplace(type, id);
+    registry.count.store(id + 1, std::memory_order_release);
+
+    return id;
+}
+
+BRK_NS_END
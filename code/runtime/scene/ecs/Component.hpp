@@ -0,0 +1,140 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_COMPONENT_HPP
+#define BERSERK_COMPONENT_HPP
+
+#include <core/Config.hpp>
+#include <core/Memory.hpp>
+#include <core/Typedefs.hpp>
+
+#include <new>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup scene
+ * @{
+ */
+
+/** Set of component types, bit per component id */
+using ComponentMask = uint64;
+
+/**
+ * @class ComponentInfo
+ * @brief Type-erased description of component type
+ */
+struct ComponentInfo {
+    using Construct = void (*)(void *memory);
+    using Destruct = void (*)(void *object);
+    using Move = void (*)(void *memory, void *object);
+
+    const char *name = nullptr;    /** Debug name of the type */
+    uint32 id = 0;                 /** Index of the component bit */
+    uint32 size = 0;               /** Size of the component (0 for empty tags) */
+    uint32 alignment = 0;          /** Alignment of the component */
+    Construct construct = nullptr; /** Default construct in memory */
+    Destruct destruct = nullptr;   /** Destroy object */
+    Move move = nullptr;           /** Move construct in memory and destroy source object */
+};
+
+/**
+ * @class ComponentRegistry
+ * @brief Assigns ids to component types
+ *
+ * Any default constructible and movable type can be used as component.
+ * Id is assigned on first use of the type and is the same for all modules.
+ * Empty types (tags) occupy no memory in chunks.
+ *
+ * @note Thread-safe
+ */
+class ComponentRegistry final {
+public:
+    /** Max number of component types (registration of more types aborts the program) */
+    static const uint32 MAX_COMPONENTS = 64;
+
+    /** @return Id of component type T */
+    template<typename T>
+    static uint32 GetId() {
+        using Type = typename std::remove_const<T>::type;
+        static const uint32 id = Register(std::type_index(typeid(Type)), MakeInfo<Type>());
+        return id;
+    }
+
+    /** @return Mask of component type T */
+    template<typename T>
+    static ComponentMask GetMask() {
+        return static_cast<ComponentMask>(1) << GetId<T>();
+    }
+
+    /** @return Mask of all component types Ts */
+    template<typename... Ts>
+    static ComponentMask GetMaskOf() {
+        ComponentMask masks[] = {0, GetMask<Ts>()...};
+        ComponentMask result = 0;
+        for (auto mask : masks)
+            result |= mask;
+        return result;
+    }
+
+    /** @return Info of registered component */
+    BRK_API static const ComponentInfo &GetInfo(uint32 id);
+
+    /** @return Number of registered components */
+    BRK_API static uint32 GetComponentsCount();
+
+private:
+    BRK_API static uint32 Register(std::type_index type, ComponentInfo info);
+
+    template<typename T>
+    static ComponentInfo MakeInfo() {
+        static_assert(alignof(T) <= Memory::ALIGNMENT, "Component alignment is not supported");
+
+        ComponentInfo info;
+        info.name = typeid(T).name();
+        info.size = std::is_empty<T>::value ? 0 : static_cast<uint32>(sizeof(T));
+        info.alignment = static_cast<uint32>(alignof(T));
+        info.construct = [](void *memory) { new (memory) T(); };
+        info.destruct = [](void *object) { static_cast<T *>(object)->~T(); };
+        info.move = [](void *memory, void *object) {
+            new (memory) T(std::move(*static_cast<T *>(object)));
+            static_cast<T *>(object)->~T();
+        };
+        return info;
+    }
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_COMPONENT_HPP
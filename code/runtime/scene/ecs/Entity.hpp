@@ -0,0 +1,88 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_ENTITY_HPP
+#define BERSERK_ENTITY_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+
+#include <functional>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup scene
+ * @{
+ */
+
+/**
+ * @class Entity
+ * @brief Generational entity id
+ *
+ * Index addresses entity record in the world, generation is incremented
+ * each time index is reused, so ids of destroyed entities never alias
+ * ids of new entities with the same index.
+ */
+struct Entity {
+    static const uint32 NULL_INDEX = 0xffffffff;
+
+    Entity() = default;
+    Entity(uint32 index, uint32 generation) : index(index), generation(generation) {}
+
+    bool IsNull() const { return index == NULL_INDEX; }
+    bool IsNotNull() const { return index != NULL_INDEX; }
+
+    /** @return Packed id of the entity */
+    uint64 GetId() const { return (static_cast<uint64>(generation) << 32u) | static_cast<uint64>(index); }
+
+    bool operator==(const Entity &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Entity &other) const { return index != other.index || generation != other.generation; }
+
+    uint32 index = NULL_INDEX;
+    uint32 generation = 0;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+namespace std {
+
+    template<>
+    struct hash<BRK_NS::Entity> {
+    public:
+        std::size_t operator()(const BRK_NS::Entity &entity) const {
+            return std::hash<BRK_NS::uint64>()(entity.GetId());
+        }
+    };
+
+}// namespace std
+
+#endif//BERSERK_ENTITY_HPP
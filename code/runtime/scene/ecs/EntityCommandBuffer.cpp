@@ -0,0 +1,127 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/Memory.hpp>
+#include <scene/ecs/EntityCommandBuffer.hpp>
+#include <scene/ecs/EntityWorld.hpp>
+
+#include <cassert>
+
+BRK_NS_BEGIN
+
+EntityCommandBuffer::~EntityCommandBuffer() {
+    Clear();
+
+    for (auto block : mBlocks)
+        Memory::Deallocate(block);
+}
+
+Entity EntityCommandBuffer::CreateEntity() {
+    Entity entity(mCreated, DEFERRED_GENERATION);
+    mCreated += 1;
+    Push(CommandType::Create, entity, 0, nullptr);
+    return entity;
+}
+
+void EntityCommandBuffer::DestroyEntity(Entity entity) {
+    Push(CommandType::Destroy, entity, 0, nullptr);
+}
+
+void EntityCommandBuffer::Playback(EntityWorld &world) {
+    std::vector<Entity> created(mCreated);
+
+    for (auto &command : mCommands) {
+        Entity entity = IsDeferred(command.entity) ? created[command.entity.index] : command.entity;
+
+        if (command.type == CommandType::Create) {
+            created[command.entity.index] = world.CreateEntity();
+            continue;
+        }
+
+        // Entity destroyed by previous command or before playback
+        if (!world.IsAlive(entity))
+            continue;
+
+        switch (command.type) {
+            case CommandType::Destroy:
+                world.DestroyEntity(entity);
+                break;
+            case CommandType::Add:
+                world.AddComponent(entity, command.componentId, command.payload);
+                command.payload = nullptr;
+                break;
+            case CommandType::Remove:
+                world.RemoveComponent(entity, command.componentId);
+                break;
+            default:
+                break;
+        }
+    }
+
+    Clear();
+}
+
+void EntityCommandBuffer::Clear() {
+    // Payload of not applied commands
+    for (auto &command : mCommands) {
+        if (command.payload)
+            ComponentRegistry::GetInfo(command.componentId).destruct(command.payload);
+    }
+
+    mCommands.clear();
+    mBlocksUsed = 0;
+    mBlockOffset = BLOCK_SIZE;
+    mCreated = 0;
+}
+
+void *EntityCommandBuffer::AllocatePayload(uint32 size, uint32 alignment) {
+    uint32 offset = (mBlockOffset + alignment - 1) / alignment * alignment;
+
+    if (offset + size > BLOCK_SIZE) {
+        if (mBlocksUsed == mBlocks.size())
+            mBlocks.push_back(static_cast<uint8 *>(Memory::Allocate(BLOCK_SIZE)));
+
+        mBlocksUsed += 1;
+        offset = 0;
+    }
+
+    mBlockOffset = offset + size;
+    return mBlocks[mBlocksUsed - 1] + offset;
+}
+
+void EntityCommandBuffer::Push(CommandType type, Entity entity, uint32 componentId, void *payload) {
+    assert(!IsDeferred(entity) || entity.index < mCreated);
+
+    Command command;
+    command.type = type;
+    command.componentId = componentId;
+    command.entity = entity;
+    command.payload = payload;
+    mCommands.push_back(command);
+}
+
+BRK_NS_END
@@ -0,0 +1,141 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_ENTITYCOMMANDBUFFER_HPP
+#define BERSERK_ENTITYCOMMANDBUFFER_HPP
+
+#include <core/Config.hpp>
+#include <core/Typedefs.hpp>
+#include <scene/ecs/Component.hpp>
+#include <scene/ecs/Entity.hpp>
+
+#include <new>
+#include <utility>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup scene
+ * @{
+ */
+
+class EntityWorld;
+
+/**
+ * @class EntityCommandBuffer
+ * @brief Deferred structural changes of entity world
+ *
+ * Records create, destroy, add and remove component commands while
+ * world is iterated, and applies them later in recorded order.
+ * Entities created by buffer are deferred: they can be referenced by
+ * following commands of the same buffer and become real on playback.
+ * Commands for entities destroyed before playback are ignored.
+ *
+ * @note Not thread-safe; use one buffer per system or job.
+ */
+class EntityCommandBuffer final {
+public:
+    /** Size of block of components payload */
+    static const uint32 BLOCK_SIZE = 16 * 1024;
+    /** Generation of deferred entities */
+    static const uint32 DEFERRED_GENERATION = 0xffffffff;
+
+    BRK_API EntityCommandBuffer() = default;
+    BRK_API ~EntityCommandBuffer();
+
+    EntityCommandBuffer(const EntityCommandBuffer &) = delete;
+    EntityCommandBuffer &operator=(const EntityCommandBuffer &) = delete;
+
+    /** Create entity; @return Deferred entity valid only for this buffer */
+    BRK_API Entity CreateEntity();
+
+    /** Destroy entity */
+    BRK_API void DestroyEntity(Entity entity);
+
+    /** Add component to entity (or assign if present) */
+    template<typename T>
+    void AddComponent(Entity entity, T component = T()) {
+        static_assert(sizeof(T) <= BLOCK_SIZE, "Component is too large for command buffer");
+        void *payload = AllocatePayload(static_cast<uint32>(sizeof(T)), static_cast<uint32>(alignof(T)));
+        new (payload) T(std::move(component));
+        Push(CommandType::Add, entity, ComponentRegistry::GetId<T>(), payload);
+    }
+
+    /** Remove component from entity */
+    template<typename T>
+    void RemoveComponent(Entity entity) {
+        Push(CommandType::Remove, entity, ComponentRegistry::GetId<T>(), nullptr);
+    }
+
+    /** Apply commands to world and clear buffer */
+    BRK_API void Playback(EntityWorld &world);
+
+    /** Discard commands */
+    BRK_API void Clear();
+
+    /** @return True if entity was created by command buffer */
+    static bool IsDeferred(Entity entity) { return entity.generation == DEFERRED_GENERATION; }
+
+    /** @return Number of recorded commands */
+    BRK_API uint32 GetCommandsCount() const { return static_cast<uint32>(mCommands.size()); }
+    /** @return True if no commands recorded */
+    BRK_API bool IsEmpty() const { return mCommands.empty(); }
+
+private:
+    enum class CommandType : uint8 {
+        Create,
+        Destroy,
+        Add,
+        Remove
+    };
+
+    struct Command {
+        CommandType type;
+        uint32 componentId;
+        Entity entity;
+        void *payload;
+    };
+
+    BRK_API void *AllocatePayload(uint32 size, uint32 alignment);
+    BRK_API void Push(CommandType type, Entity entity, uint32 componentId, void *payload);
+
+private:
+    std::vector<Command> mCommands;
+    std::vector<uint8 *> mBlocks;     /** Blocks of payload, reused after playback */
+    uint32 mBlocksUsed = 0;            /** Blocks in use, the last one is filled */
+    uint32 mBlockOffset = BLOCK_SIZE; /** Offset in filled block */
+    uint32 mCreated = 0;              /** Deferred entities count */
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_ENTITYCOMMANDBUFFER_HPP
@@ -0,0 +1,92 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/profiler/Counters.hpp>
+#include <scene/ecs/EntitySystem.hpp>
+
+#include <algorithm>
+
+BRK_NS_BEGIN
+
+EntityScheduler::EntityScheduler(JobSystem *jobSystem) : mJobSystem(jobSystem) {
+}
+
+EntityScheduler::~EntityScheduler() = default;
+
+EntitySystem &EntityScheduler::AddSystem(String name, EntitySystem::Func func) {
+    mSystems.emplace_back(new EntitySystem(std::move(name), std::move(func)));
+    mStages.clear();
+    return *mSystems.back();
+}
+
+void EntityScheduler::Run(EntityWorld &world) {
+    // Access may be declared after add, so stages are built on first run
+    if (mStages.empty())
+        BuildStages();
+
+    for (auto &stage : mStages) {
+        auto run = [&](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; i++)
+                stage[i]->mFunc(world, stage[i]->mCommands);
+        };
+
+        if (mJobSystem && stage.size() > 1)
+            mJobSystem->ParallelFor(static_cast<uint32>(stage.size()), 1, run);
+        else
+            run(0, static_cast<uint32>(stage.size()));
+    }
+
+    uint32 commands = 0;
+    for (auto &system : mSystems) {
+        commands += system->mCommands.GetCommandsCount();
+        system->mCommands.Playback(world);
+    }
+
+    BRK_COUNTER_ADD("ecs.commands", commands);
+}
+
+void EntityScheduler::BuildStages() {
+    std::vector<uint32> systemStage(mSystems.size(), 0);
+
+    for (size_t j = 0; j < mSystems.size(); j++) {
+        uint32 stage = 0;
+
+        for (size_t i = 0; i < j; i++) {
+            if (mSystems[i]->Conflicts(*mSystems[j]))
+                stage = std::max(stage, systemStage[i] + 1);
+        }
+
+        systemStage[j] = stage;
+
+        if (stage == mStages.size())
+            mStages.emplace_back();
+
+        mStages[stage].push_back(mSystems[j].get());
+    }
+}
+
+BRK_NS_END
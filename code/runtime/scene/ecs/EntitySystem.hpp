@@ -0,0 +1,146 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_ENTITYSYSTEM_HPP
+#define BERSERK_ENTITYSYSTEM_HPP
+
+#include <core/Config.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+#include <core/string/String.hpp>
+#include <scene/ecs/Component.hpp>
+#include <scene/ecs/EntityCommandBuffer.hpp>
+#include <scene/ecs/EntityWorld.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup scene
+ * @{
+ */
+
+/**
+ * @class EntitySystem
+ * @brief System processing entities of world
+ *
+ * System declares components it reads and writes; scheduler runs
+ * systems without conflicting access in parallel. System must not
+ * change world structure directly, use provided command buffer instead.
+ */
+class EntitySystem final {
+public:
+    /** System function */
+    using Func = std::function<void(EntityWorld &world, EntityCommandBuffer &commands)>;
+
+    EntitySystem(String name, Func func) : mName(std::move(name)), mFunc(std::move(func)) {}
+
+    /** Declare read-only access to components Ts */
+    template<typename... Ts>
+    EntitySystem &Read() {
+        mRead |= ComponentRegistry::GetMaskOf<Ts...>();
+        return *this;
+    }
+
+    /** Declare read-write access to components Ts */
+    template<typename... Ts>
+    EntitySystem &Write() {
+        mWrite |= ComponentRegistry::GetMaskOf<Ts...>();
+        return *this;
+    }
+
+    /** @return True if system can not run in parallel with other system */
+    bool Conflicts(const EntitySystem &other) const {
+        return (mWrite & (other.mRead | other.mWrite)) || (mRead & other.mWrite);
+    }
+
+    const String &GetName() const { return mName; }
+    ComponentMask GetReadMask() const { return mRead; }
+    ComponentMask GetWriteMask() const { return mWrite; }
+
+private:
+    friend class EntityScheduler;
+
+    String mName;
+    Func mFunc;
+    EntityCommandBuffer mCommands;
+    ComponentMask mRead = 0;
+    ComponentMask mWrite = 0;
+};
+
+/**
+ * @class EntityScheduler
+ * @brief Runs entity systems on job system
+ *
+ * Systems are grouped into stages in order of registration: system is
+ * placed into the stage after the last stage with conflicting system.
+ * Systems of one stage run in parallel; stages run one by one. After
+ * all stages, command buffers of systems are played back in order of
+ * registration, so result does not depend on systems timing.
+ *
+ * @code
+ * scheduler.AddSystem("Move", [&](EntityWorld &world, EntityCommandBuffer &) { ... })
+ *     .Read<Velocity>()
+ *     .Write<Position>();
+ * @endcode
+ */
+class EntityScheduler final {
+public:
+    /** @param jobSystem Job system to run systems; if null systems run on calling thread */
+    BRK_API explicit EntityScheduler(JobSystem *jobSystem = nullptr);
+    BRK_API ~EntityScheduler();
+
+    /** Add system; declare its access on returned object */
+    BRK_API EntitySystem &AddSystem(String name, EntitySystem::Func func);
+
+    /** Run all systems and apply their structural changes */
+    BRK_API void Run(EntityWorld &world);
+
+    /** @return Number of stages (valid after run) */
+    BRK_API uint32 GetStagesCount() const { return static_cast<uint32>(mStages.size()); }
+    /** @return Number of systems */
+    BRK_API uint32 GetSystemsCount() const { return static_cast<uint32>(mSystems.size()); }
+
+private:
+    void BuildStages();
+
+private:
+    std::vector<std::unique_ptr<EntitySystem>> mSystems;
+    std::vector<std::vector<EntitySystem *>> mStages;
+    JobSystem *mJobSystem;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_ENTITYSYSTEM_HPP
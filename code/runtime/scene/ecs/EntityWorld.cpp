@@ -0,0 +1,197 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/profiler/Counters.hpp>
+#include <scene/ecs/EntityWorld.hpp>
+
+#include <cassert>
+
+BRK_NS_BEGIN
+
+EntityWorld::EntityWorld() {
+    // Archetype of entities without components
+    GetOrCreateArchetype(0);
+}
+
+EntityWorld::~EntityWorld() = default;
+
+Entity EntityWorld::CreateEntity() {
+    return AllocateEntity(mArchetypes[0].get());
+}
+
+void EntityWorld::DestroyEntity(Entity entity) {
+    assert(IsAlive(entity));
+
+    Record &record = mRecords[entity.index];
+    Entity moved = record.archetype->RemoveRow(record.row, true);
+    OnRowRemoved(moved, record.row);
+
+    record.archetype = nullptr;
+    record.row = mFreeList;
+    record.generation += 1;
+    mFreeList = entity.index;
+    mEntitiesCount -= 1;
+}
+
+void *EntityWorld::AddComponent(Entity entity, uint32 componentId, void *value) {
+    assert(IsAlive(entity));
+    assert(componentId < ComponentRegistry::GetComponentsCount());
+
+    auto &info = ComponentRegistry::GetInfo(componentId);
+    Record &record = mRecords[entity.index];
+    Archetype *source = record.archetype;
+
+    if (source->HasComponent(componentId)) {
+        void *component = source->GetComponent(record.row, componentId);
+        if (value) {
+            info.destruct(component);
+            info.move(component, value);
+        }
+        return component;
+    }
+
+    Archetype *&target = source->addEdges[componentId];
+    if (!target)
+        target = GetOrCreateArchetype(source->GetMask() | (static_cast<ComponentMask>(1) << componentId));
+
+    MoveEntity(entity, target);
+
+    void *component = target->GetComponent(record.row, componentId);
+    if (value)
+        info.move(component, value);
+    else
+        info.construct(component);
+
+    return component;
+}
+
+void EntityWorld::RemoveComponent(Entity entity, uint32 componentId) {
+    assert(IsAlive(entity));
+    assert(componentId < ComponentRegistry::GetComponentsCount());
+
+    Archetype *source = mRecords[entity.index].archetype;
+
+    if (!source->HasComponent(componentId))
+        return;
+
+    Archetype *&target = source->removeEdges[componentId];
+    if (!target)
+        target = GetOrCreateArchetype(source->GetMask() & ~(static_cast<ComponentMask>(1) << componentId));
+
+    MoveEntity(entity, target);
+}
+
+void *EntityWorld::GetComponent(Entity entity, uint32 componentId) const {
+    assert(IsAlive(entity));
+
+    const Record &record = mRecords[entity.index];
+    return record.archetype->GetComponent(record.row, componentId);
+}
+
+Archetype *EntityWorld::GetOrCreateArchetype(ComponentMask mask) {
+    auto query = mArchetypesLookUp.find(mask);
+    if (query != mArchetypesLookUp.end())
+        return query->second;
+
+    mArchetypes.emplace_back(new Archetype(mask));
+    Archetype *archetype = mArchetypes.back().get();
+    mArchetypesLookUp.emplace(mask, archetype);
+
+    BRK_GAUGE_SET("ecs.archetypes", mArchetypes.size());
+
+    return archetype;
+}
+
+Entity EntityWorld::AllocateEntity(Archetype *archetype) {
+    Entity entity;
+
+    if (mFreeList != Entity::NULL_INDEX) {
+        entity.index = mFreeList;
+        mFreeList = mRecords[entity.index].row;
+    } else {
+        entity.index = static_cast<uint32>(mRecords.size());
+        mRecords.emplace_back();
+    }
+
+    Record &record = mRecords[entity.index];
+    entity.generation = record.generation;
+    record.archetype = archetype;
+    record.row = archetype->AllocateRow(entity);
+    mEntitiesCount += 1;
+
+    return entity;
+}
+
+void EntityWorld::MoveEntity(Entity entity, Archetype *target) {
+    Record &record = mRecords[entity.index];
+    Archetype *source = record.archetype;
+
+    uint32 row = record.row;
+    uint32 targetRow = target->AllocateRow(entity);
+
+    source->MoveRow(row, *target, targetRow);
+    OnRowRemoved(source->RemoveRow(row, false), row);
+
+    record.archetype = target;
+    record.row = targetRow;
+}
+
+void EntityWorld::OnRowRemoved(Entity moved, uint32 row) {
+    if (moved.IsNotNull())
+        mRecords[moved.index].row = row;
+}
+
+void EntityQuery::Update(const EntityWorld &world) {
+    for (; mArchetypesChecked < world.GetArchetypesCount(); mArchetypesChecked++) {
+        Archetype &archetype = world.GetArchetype(mArchetypesChecked);
+        ComponentMask mask = archetype.GetMask();
+
+        if ((mask & mInclude) == mInclude && (mask & mExclude) == 0)
+            mArchetypes.push_back(&archetype);
+    }
+}
+
+uint32 EntityQuery::Count(const EntityWorld &world) {
+    Update(world);
+
+    uint32 count = 0;
+    for (auto archetype : mArchetypes)
+        count += archetype->GetEntitiesCount();
+
+    return count;
+}
+
+void EntityQuery::CollectChunks() {
+    mChunks.clear();
+
+    for (auto archetype : mArchetypes) {
+        for (uint32 chunk = 0; chunk < archetype->GetChunksCount(); chunk++)
+            mChunks.emplace_back(archetype, chunk);
+    }
+}
+
+BRK_NS_END
@@ -0,0 +1,288 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef BERSERK_ENTITYWORLD_HPP
+#define BERSERK_ENTITYWORLD_HPP
+
+#include <core/Config.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Typedefs.hpp>
+#include <scene/ecs/Archetype.hpp>
+#include <scene/ecs/Component.hpp>
+#include <scene/ecs/Entity.hpp>
+
+#include <cassert>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/**
+ * @addtogroup scene
+ * @{
+ */
+
+/**
+ * @class EntityWorld
+ * @brief Storage of entities and their components
+ *
+ * Entities with the same set of components share archetype, which stores
+ * components in 16 KiB chunks (SoA). Adding or removing component moves
+ * entity to other archetype; transitions are cached in the archetypes graph.
+ * Use EntityQuery to iterate entities with required components.
+ *
+ * Structural changes (create, destroy, add or remove component) invalidate
+ * pointers to components and must not run concurrently with iteration;
+ * record them into EntityCommandBuffer instead.
+ *
+ * @note Not thread-safe; concurrent read/write of components of different
+ *       types (or different entities) is allowed while structure is not changed.
+ */
+class EntityWorld final {
+public:
+    BRK_API EntityWorld();
+    BRK_API ~EntityWorld();
+
+    /** Create entity without components */
+    BRK_API Entity CreateEntity();
+
+    /** Create entity with components */
+    template<typename... Ts>
+    Entity CreateEntityWith(Ts... components) {
+        Archetype *archetype = GetOrCreateArchetype(ComponentRegistry::GetMaskOf<Ts...>());
+        Entity entity = AllocateEntity(archetype);
+        uint32 row = mRecords[entity.index].row;
+        int expand[] = {0, (new (archetype->GetComponent(row, ComponentRegistry::GetId<Ts>())) Ts(std::move(components)), 0)...};
+        (void) expand;
+        return entity;
+    }
+
+    /** Destroy entity and its components */
+    BRK_API void DestroyEntity(Entity entity);
+
+    /** @return True if entity is not destroyed */
+    BRK_API bool IsAlive(Entity entity) const {
+        return entity.index < mRecords.size() && mRecords[entity.index].generation == entity.generation && mRecords[entity.index].archetype;
+    }
+
+    /** Add component to entity (or assign if present); @return Component */
+    template<typename T>
+    T &AddComponent(Entity entity, T component = T()) {
+        T *result = static_cast<T *>(AddComponent(entity, ComponentRegistry::GetId<T>(), nullptr));
+        *result = std::move(component);
+        return *result;
+    }
+
+    /** Remove component from entity */
+    template<typename T>
+    void RemoveComponent(Entity entity) {
+        RemoveComponent(entity, ComponentRegistry::GetId<T>());
+    }
+
+    /** @return True if entity has component */
+    template<typename T>
+    bool HasComponent(Entity entity) const {
+        assert(IsAlive(entity));
+        return mRecords[entity.index].archetype->HasComponent(ComponentRegistry::GetId<T>());
+    }
+
+    /** @return Component of entity (null if not present) */
+    template<typename T>
+    T *GetComponent(Entity entity) const {
+        return static_cast<T *>(GetComponent(entity, ComponentRegistry::GetId<T>()));
+    }
+
+    /**
+     * @brief Add component by id
+     *
+     * @param entity Entity to add component
+     * @param componentId Id of the component
+     * @param value Component to move from (it is destroyed after move), or null to default construct
+     * @return Component
+     */
+    BRK_API void *AddComponent(Entity entity, uint32 componentId, void *value);
+
+    /** Remove component by id */
+    BRK_API void RemoveComponent(Entity entity, uint32 componentId);
+
+    /** @return Component by id (null if not present) */
+    BRK_API void *GetComponent(Entity entity, uint32 componentId) const;
+
+    /** @return Number of alive entities */
+    BRK_API uint32 GetEntitiesCount() const { return mEntitiesCount; }
+    /** @return Number of archetypes; archetypes are never removed and keep their index */
+    BRK_API uint32 GetArchetypesCount() const { return static_cast<uint32>(mArchetypes.size()); }
+    /** @return Archetype by index */
+    BRK_API Archetype &GetArchetype(uint32 index) const { return *mArchetypes[index]; }
+
+private:
+    struct Record {
+        Archetype *archetype = nullptr; /** Archetype of entity (null if destroyed) */
+        uint32 row = 0;                 /** Row in archetype (or next free index) */
+        uint32 generation = 0;          /** Generation of index */
+    };
+
+    BRK_API Archetype *GetOrCreateArchetype(ComponentMask mask);
+    BRK_API Entity AllocateEntity(Archetype *archetype);
+    void MoveEntity(Entity entity, Archetype *target);
+    void OnRowRemoved(Entity moved, uint32 row);
+
+private:
+    std::vector<std::unique_ptr<Archetype>> mArchetypes;
+    std::unordered_map<ComponentMask, Archetype *> mArchetypesLookUp;
+    std::vector<Record> mRecords;
+    uint32 mFreeList = Entity::NULL_INDEX;
+    uint32 mEntitiesCount = 0;
+};
+
+/**
+ * @class EntityChunkView
+ * @brief Components of entities in single archetype chunk
+ */
+struct EntityChunkView {
+    /** @return Array of component T (null if not present) */
+    template<typename T>
+    T *Get() const {
+        return static_cast<T *>(archetype->GetComponentArray(chunk, ComponentRegistry::GetId<T>()));
+    }
+
+    Archetype *archetype = nullptr;
+    Entity *entities = nullptr;
+    uint32 chunk = 0;
+    uint32 count = 0;
+};
+
+/**
+ * @class EntityQuery
+ * @brief Cached query of archetypes with required components
+ *
+ * Query keeps list of matching archetypes and checks only archetypes
+ * created since its last use. Components may be requested as const
+ * to express read-only access.
+ *
+ * @code
+ * auto query = EntityQuery::Create<Position, const Velocity>();
+ * query.ForEach<Position, const Velocity>(world, [](Entity, Position &p, const Velocity &v) { ... });
+ * @endcode
+ *
+ * @note Not thread-safe; use separate query object per system.
+ */
+class EntityQuery final {
+public:
+    EntityQuery() = default;
+    explicit EntityQuery(ComponentMask include, ComponentMask exclude = 0) : mInclude(include), mExclude(exclude) {}
+
+    /** @return Query of entities with all components Ts */
+    template<typename... Ts>
+    static EntityQuery Create() {
+        return EntityQuery(ComponentRegistry::GetMaskOf<Ts...>());
+    }
+
+    /** Exclude entities with component T */
+    template<typename T>
+    EntityQuery &Exclude() {
+        mExclude |= ComponentRegistry::GetMask<T>();
+        return *this;
+    }
+
+    /** Match archetypes created since last update */
+    BRK_API void Update(const EntityWorld &world);
+
+    /** Call func(const EntityChunkView &) for each non-empty chunk */
+    template<typename Func>
+    void ForEachChunk(EntityWorld &world, Func &&func) {
+        Update(world);
+
+        for (auto archetype : mArchetypes) {
+            for (uint32 chunk = 0; chunk < archetype->GetChunksCount(); chunk++)
+                func(MakeView(archetype, chunk));
+        }
+    }
+
+    /** Call func(Entity, Ts &...) for each entity */
+    template<typename... Ts, typename Func>
+    void ForEach(EntityWorld &world, Func &&func) {
+        ForEachChunk(world, [&](const EntityChunkView &view) {
+            Invoke(view, func, view.template Get<Ts>()...);
+        });
+    }
+
+    /** Call func(Entity, Ts &...) for each entity; chunks are processed in parallel on job system */
+    template<typename... Ts, typename Func>
+    void ForEachParallel(EntityWorld &world, JobSystem &jobSystem, Func &&func) {
+        Update(world);
+        CollectChunks();
+
+        jobSystem.ParallelFor(static_cast<uint32>(mChunks.size()), 1, [&](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; i++) {
+                auto view = MakeView(mChunks[i].first, mChunks[i].second);
+                Invoke(view, func, view.template Get<Ts>()...);
+            }
+        });
+    }
+
+    /** @return Number of entities matching query */
+    BRK_API uint32 Count(const EntityWorld &world);
+
+    /** @return Matching archetypes */
+    const std::vector<Archetype *> &GetArchetypes() const { return mArchetypes; }
+
+private:
+    static EntityChunkView MakeView(Archetype *archetype, uint32 chunk) {
+        EntityChunkView view;
+        view.archetype = archetype;
+        view.entities = archetype->GetEntities(chunk);
+        view.chunk = chunk;
+        view.count = archetype->GetChunkSize(chunk);
+        return view;
+    }
+
+    template<typename Func, typename... Ts>
+    static void Invoke(const EntityChunkView &view, Func &func, Ts *... arrays) {
+        for (uint32 i = 0; i < view.count; i++)
+            func(view.entities[i], arrays[i]...);
+    }
+
+    BRK_API void CollectChunks();
+
+private:
+    std::vector<Archetype *> mArchetypes;                  /** Matching archetypes */
+    std::vector<std::pair<Archetype *, uint32>> mChunks;   /** Chunks for parallel iteration */
+    ComponentMask mInclude = 0;
+    ComponentMask mExclude = 0;
+    uint32 mArchetypesChecked = 0;
+};
+
+/**
+ * @}
+ */
+
+BRK_NS_END
+
+#endif//BERSERK_ENTITYWORLD_HPP
@@ -0,0 +1,166 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/JobSystem.hpp>
+#include <core/io/ArgumentParser.hpp>
+#include <core/io/Logger.hpp>
+#include <core/io/LoggerListenerOutput.hpp>
+#include <platform/FileSystem.hpp>
+#include <platform/PakArchive.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+BRK_NS_USE;
+
+/** Recursively collects files of the directory (relative to search paths) */
+static void CollectFiles(FileSystem &fileSystem, const String &dir, std::vector<String> &files) {
+    for (auto &entry : fileSystem.ListDir(dir)) {
+        if (entry.name == "." || entry.name == "..")
+            continue;
+
+        String path = dir == "." ? entry.name : dir + "/" + entry.name;
+
+        if (entry.type == FileSystem::EntryType::Directory)
+            CollectFiles(fileSystem, path, files);
+        else if (entry.type == FileSystem::EntryType::File)
+            files.push_back(path);
+    }
+}
+
+static void PrintUsage() {
+    std::cout << "Usage: brk-pak [options]" << std::endl
+              << " --root=<path>         Root directory of the game content to pack (default: .)" << std::endl
+              << " --out=<path>          Output pak file" << std::endl
+              << " --align=<n>           Alignment of files in the pak (default: " << PakArchive::DEFAULT_ALIGNMENT << ")" << std::endl
+              << " --compress            Compress files with LZ4 (files which do not compress are stored)" << std::endl
+              << " --threads=<n>         Number of worker threads (default: hardware concurrency - 1)" << std::endl
+              << " --list=<path>         List files of the pak file and verify their content" << std::endl
+              << " --help                Show this message" << std::endl;
+}
+
+static int List(FileSystem &fileSystem, const String &path) {
+    auto pak = PakArchive::Open(fileSystem, path);
+
+    if (pak.IsNull())
+        return 1;
+
+    uint32 corrupted = 0;
+
+    for (uint32 i = 0; i < pak->GetEntriesCount(); i++) {
+        auto &entry = pak->GetEntries()[i];
+        bool valid = pak->Verify(entry);
+        corrupted += valid ? 0 : 1;
+
+        std::cout << pak->GetEntryName(entry) << " size=" << entry.rawSize << " stored=" << entry.size << " offset=" << entry.offset
+                  << (entry.codec == CompressionCodec::Lz4 ? " lz4" : "") << (valid ? "" : " CORRUPTED") << std::endl;
+    }
+
+    std::cout << pak->GetEntriesCount() << " files, " << corrupted << " corrupted" << std::endl;
+
+    return corrupted == 0 ? 0 : 1;
+}
+
+int main(int argc, const char *const *argv) {
+    ArgumentParser parser;
+    parser.AddArgument("--root", ".");
+    parser.AddArgument("--out");
+    parser.AddArgument("--align");
+    parser.AddArgument("--compress");
+    parser.AddArgument("--threads", "0");
+    parser.AddArgument("--list");
+    parser.Parse(argc, argv);
+
+    if (parser.Set("--help")) {
+        PrintUsage();
+        return 0;
+    }
+
+    LoggerListenerOutput listener;
+    listener.SetName("Pak");
+    listener.SetLevel(Logger::Level::Warning);
+    Logger::Instance().AddListener([=](const Logger::Entry &entry) { listener.OnEntry(entry); });
+
+    FileSystem fileSystem;
+    String root, out, align, list, threads;
+
+    if (parser.Set("--list", list)) {
+        int result = List(fileSystem, list);
+        Logger::Instance().Flush();
+        return result;
+    }
+
+    if (!parser.Set("--out", out)) {
+        PrintUsage();
+        return 1;
+    }
+
+    parser.Set("--root", root);
+    parser.Set("--threads", threads);
+
+    uint32 alignment = PakArchive::DEFAULT_ALIGNMENT;
+    if (parser.Set("--align", align))
+        alignment = static_cast<uint32>(std::strtoul(align.c_str(), nullptr, 10));
+
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        std::cerr << "Alignment must be power of two" << std::endl;
+        return 1;
+    }
+
+    // Stored names are relative to the root, same as runtime paths relative to game directory
+    fileSystem.AddSearchPath(root);
+
+    std::vector<String> files;
+    CollectFiles(fileSystem, ".", files);
+
+    auto codec = parser.Set("--compress") ? CompressionCodec::Lz4 : CompressionCodec::None;
+    JobSystem jobSystem(static_cast<uint32>(std::strtoul(threads.c_str(), nullptr, 10)));
+    PakBuilder builder(alignment);
+    uint64 totalSize = 0;
+
+    for (auto &file : files) {
+        auto data = fileSystem.MapFile(root + "/" + file);
+
+        if (data.IsNull()) {
+            std::cerr << "Skip empty or unreadable file " << file << std::endl;
+            continue;
+        }
+
+        totalSize += data->GetSize();
+        builder.AddFile(file, std::move(data), codec);
+    }
+
+    bool saved = builder.Save(fileSystem, out, &jobSystem);
+    Logger::Instance().Flush();
+
+    if (!saved)
+        return 1;
+
+    std::cout << "Packed " << builder.GetFilesCount() << " files (" << totalSize << " bytes) into " << out << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/JobSystem.hpp>
+#include <core/io/ArgumentParser.hpp>
+#include <core/io/Logger.hpp>
+#include <core/io/LoggerListenerOutput.hpp>
+#include <platform/FileSystem.hpp>
+#include <render/shader/ShaderCooker.hpp>
+#include <render/shader/ShaderManager.hpp>
+#include <render/shader/ShaderVariantPack.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+BRK_NS_USE;
+
+static const char *const SHADER_EXTENSION = ".shader.xml";
+
+static bool IsShaderFile(const String &name) {
+    String extension(SHADER_EXTENSION);
+    return name.size() > extension.size() && name.compare(name.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/** Recursively collects shader files of the directory (relative to search paths) */
+static void CollectFiles(FileSystem &fileSystem, const String &dir, std::vector<String> &files) {
+    for (auto &entry : fileSystem.ListDir(dir)) {
+        if (entry.name == "." || entry.name == "..")
+            continue;
+
+        String path = dir + "/" + entry.name;
+
+        if (entry.type == FileSystem::EntryType::Directory)
+            CollectFiles(fileSystem, path, files);
+        else if (entry.type == FileSystem::EntryType::File && IsShaderFile(entry.name))
+            files.push_back(path);
+    }
+}
+
+static void PrintUsage() {
+    std::cout << "Usage: brk-shadercook [options]" << std::endl
+              << " --root=<path>         Root directory of the game content (default: .)" << std::endl
+              << " --dir=<path>          Shaders directory relative to the root (default: shaders)" << std::endl
+              << " --out=<path>          Output pack file (default: <root>/<dir>/variants.pack)" << std::endl
+              << " --max-options=<n>     Max options to permute per shader (default: " << ShaderCooker::DEFAULT_MAX_OPTIONS << ")" << std::endl
+              << " --threads=<n>         Number of worker threads (default: hardware concurrency - 1)" << std::endl
+              << " --help                Show this message" << std::endl;
+}
+
+int main(int argc, const char *const *argv) {
+    ArgumentParser parser;
+    parser.AddArgument("--root", ".");
+    parser.AddArgument("--dir", "shaders");
+    parser.AddArgument("--out");
+    parser.AddArgument("--max-options");
+    parser.AddArgument("--threads", "0");
+    parser.Parse(argc, argv);
+
+    if (parser.Set("--help")) {
+        PrintUsage();
+        return 0;
+    }
+
+    LoggerListenerOutput listener;
+    listener.SetName("ShaderCook");
+    listener.SetLevel(Logger::Level::Warning);
+    Logger::Instance().AddListener([=](const Logger::Entry &entry) { listener.OnEntry(entry); });
+
+    String root, dir, out, maxOptions, threads;
+    parser.Set("--root", root);
+    parser.Set("--dir", dir);
+    parser.Set("--threads", threads);
+
+    if (!parser.Set("--out", out))
+        out = root + "/" + dir + "/variants.pack";
+
+    FileSystem fileSystem;
+    JobSystem jobSystem(static_cast<uint32>(std::strtoul(threads.c_str(), nullptr, 10)));
+    ShaderManager shaderManager;
+    ShaderCooker cooker(shaderManager, fileSystem, jobSystem);
+
+    if (parser.Set("--max-options", maxOptions))
+        cooker.SetMaxOptions(static_cast<uint32>(std::strtoul(maxOptions.c_str(), nullptr, 10)));
+
+    // Stored paths are relative to the root, same as runtime paths relative to game directory
+    fileSystem.AddSearchPath(root);
+
+    std::vector<String> files;
+    CollectFiles(fileSystem, dir, files);
+
+    if (files.empty()) {
+        std::cerr << "No " << SHADER_EXTENSION << " files found in " << root << "/" << dir << std::endl;
+        return 1;
+    }
+
+    for (auto &file : files) {
+        std::cout << "Cook " << file << std::endl;
+        cooker.AddFile(file, root + "/" + file);
+    }
+
+    ShaderVariantPack pack;
+    bool cooked = cooker.Cook(pack);
+    Logger::Instance().Flush();
+
+    if (!pack.Save(fileSystem, out))
+        return 1;
+
+    std::cout << "Cooked " << pack.GetVariantsCount() << " variants of " << pack.GetEntries().size() << " shaders into " << out << std::endl;
+
+    return cooked ? 0 : 1;
+}
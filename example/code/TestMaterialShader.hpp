@@ -169,11 +169,16 @@ public:
         beginInfo.clearColors[0] = Vec4f(0.198f, 0.092f, 0.121f, 1.0f).Pow(gamma);
 
         commandList->BeginRenderPass(renderPass, beginInfo);
-        commandList->BindGraphicsPipeline(pipeline);
-        commandList->BindResourceSet(material->GetPackedParams()->GetResourceSets()[0], 0);
-        commandList->BindVertexBuffers(vertexBuffers);
-        commandList->BindIndexBuffer(indexBuffer, RHIIndexType::Uint32);
-        commandList->DrawIndexed(6, 0, 1);
+
+        // Shader compiles asynchronously, draw nothing until it is ready
+        if (material->IsReady()) {
+            commandList->BindGraphicsPipeline(pipeline);
+            commandList->BindResourceSet(material->GetPackedParams()->GetResourceSets()[0], 0);
+            commandList->BindVertexBuffers(vertexBuffers);
+            commandList->BindIndexBuffer(indexBuffer, RHIIndexType::Uint32);
+            commandList->DrawIndexed(6, 0, 1);
+        }
+
         commandList->EndRenderPass();
         commandList->SwapBuffers(window);
         commandList->Submit();
@@ -127,12 +127,12 @@ public:
 
         Vec3f lightPos = MathUtils3d::Multiply(lightRotation, Vec3f(0, 0, 2));
 
-        static StringName pMVP("pMVP");
-        static StringName pModel("pModel");
-        static StringName pCameraPos("pCameraPos");
-        static StringName pLightColor("pLightColor");
-        static StringName pLightPos("pLightPos");
-        static StringName pTime("pTime");
+        static auto pMVP = material->GetParamHandle(StringName("pMVP"));
+        static auto pModel = material->GetParamHandle(StringName("pModel"));
+        static auto pCameraPos = material->GetParamHandle(StringName("pCameraPos"));
+        static auto pLightColor = material->GetParamHandle(StringName("pLightColor"));
+        static auto pLightPos = material->GetParamHandle(StringName("pLightPos"));
+        static auto pTime = material->GetParamHandle(StringName("pTime"));
 
         Vec3f lightColor(1, 1, 1);
 
@@ -158,23 +158,29 @@ public:
         beginInfo.stencilClear = 0;
         beginInfo.clearColors[0] = Vec4f(0.198f, 0.092f, 0.121f, 1.0f).Pow(gamma);
 
-        std::vector<Ref<RHIVertexBuffer>> vertexBuffers;
+        auto &renderQueue = engine->GetRenderEngine().GetRenderQueue();
         auto gpuMesh = mesh->GetMesh();
-        if (gpuMesh->HasVertexData()) vertexBuffers.push_back(gpuMesh->GetVertexData());
-        if (gpuMesh->HasAttributeData()) vertexBuffers.push_back(gpuMesh->GetAttributeData());
-        if (gpuMesh->HasSkinningData()) vertexBuffers.push_back(gpuMesh->GetSkinningData());
-
-        commandList->BeginRenderPass(renderPass, beginInfo);
-        commandList->BindGraphicsPipeline(pipeline);
-        commandList->BindResourceSet(material->GetPackedParams()->GetResourceSets()[0], 0);
-        commandList->BindVertexBuffers(vertexBuffers);
-
-        for (auto &subMesh : gpuMesh->GetSubMeshes()) {
-            commandList->BindIndexBuffer(subMesh->GetIndexBuffer(), subMesh->GetIndexType());
-            commandList->DrawIndexed(subMesh->GetIndicesCount(), subMesh->GetBaseVertex(), 1);
+
+        // Shader compiles asynchronously, draw nothing until it is ready
+        if (material->IsReady()) {
+            for (auto &subMesh : gpuMesh->GetSubMeshes()) {
+                RenderPacket packet;
+                packet.pipeline = pipeline;
+                packet.resourceSet = material->GetPackedParams()->GetResourceSets()[0];
+                packet.mesh = gpuMesh;
+                packet.subMesh = subMesh;
+                renderQueue.Submit(packet);
+            }
         }
 
-        commandList->EndRenderPass();
+        renderQueue.Prepare(*commandList);
+
+        {
+            BRK_GPU_PROFILE_SCOPE(*commandList, "MainPass");
+            commandList->BeginRenderPass(renderPass, beginInfo);
+            renderQueue.Emit(*commandList, 0);
+            commandList->EndRenderPass();
+        }
         commandList->SwapBuffers(window);
         commandList->Submit();
     }
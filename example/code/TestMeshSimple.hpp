@@ -164,13 +164,17 @@ public:
         if (mesh->HasSkinningData()) vertexBuffers.push_back(mesh->GetSkinningData());
 
         commandList->BeginRenderPass(renderPass, beginInfo);
-        commandList->BindGraphicsPipeline(pipeline);
-        commandList->BindResourceSet(material->GetPackedParams()->GetResourceSets()[0], 0);
-        commandList->BindVertexBuffers(vertexBuffers);
 
-        for (auto &subMesh : mesh->GetSubMeshes()) {
-            commandList->BindIndexBuffer(subMesh->GetIndexBuffer(), subMesh->GetIndexType());
-            commandList->DrawIndexed(subMesh->GetIndicesCount(), subMesh->GetBaseVertex(), 1);
+        // Shader compiles asynchronously, draw nothing until it is ready
+        if (material->IsReady()) {
+            commandList->BindGraphicsPipeline(pipeline);
+            commandList->BindResourceSet(material->GetPackedParams()->GetResourceSets()[0], 0);
+            commandList->BindVertexBuffers(vertexBuffers);
+
+            for (auto &subMesh : mesh->GetSubMeshes()) {
+                commandList->BindIndexBuffer(subMesh->GetIndexBuffer(), subMesh->GetIndexType());
+                commandList->DrawIndexed(subMesh->GetIndicesCount(), subMesh->GetBaseVertex(), 1);
+            }
         }
 
         commandList->EndRenderPass();
@@ -0,0 +1,309 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/JobSystem.hpp>
+#include <platform/AsyncIO.hpp>
+#include <platform/FileSystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <vector>
+
+BRK_NS_BEGIN
+
+struct AsyncTestFile {
+    AsyncTestFile(String filepath, Ref<Data> data) : filepath(std::move(filepath)), data(std::move(data)) {}
+
+    String filepath;
+    Ref<Data> data;
+};
+
+static std::vector<AsyncTestFile> WriteTestFiles(FileSystem &fs, const String &dir, uint32 count, uint32 maxSize) {
+    std::mt19937 engine(count);
+    std::uniform_int_distribution<uint32> size(1, maxSize);
+    std::vector<AsyncTestFile> files;
+
+    EXPECT_TRUE(fs.MakeDir(dir));
+
+    for (uint32 i = 0; i < count; i++) {
+        std::vector<uint8> bytes(size(engine));
+        for (auto &b : bytes)
+            b = static_cast<uint8>(engine());
+
+        auto data = Data::Make(bytes.data(), bytes.size());
+        auto filepath = dir + "/file" + std::to_string(i) + ".bin";
+        EXPECT_TRUE(fs.WriteFile(filepath, data));
+        files.emplace_back(filepath, data);
+    }
+
+    return files;
+}
+
+static bool IsSameBytes(const void *buffer, size_t size, const Ref<Data> &data, size_t offset = 0) {
+    return offset + size <= data->GetSize() && std::memcmp(buffer, reinterpret_cast<const uint8 *>(data->GetData()) + offset, size) == 0;
+}
+
+/** Blocks single IO thread in callback until released */
+class IOThreadBlocker {
+public:
+    AsyncIO::Request MakeRequest(const String &filepath) {
+        AsyncIO::Request request;
+        request.filepath = filepath;
+        request.dispatch = AsyncIO::Dispatch::IOThread;
+        request.callback = [this](const AsyncIO::Result &) {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mBlocked = true;
+            mCvar.notify_all();
+            mCvar.wait(lock, [this]() { return mReleased; });
+        };
+        return request;
+    }
+
+    void WaitBlocked() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCvar.wait(lock, [this]() { return mBlocked; });
+    }
+
+    void Release() {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mReleased = true;
+        mCvar.notify_all();
+    }
+
+private:
+    std::mutex mMutex;
+    std::condition_variable mCvar;
+    bool mBlocked = false;
+    bool mReleased = false;
+};
+
+static void TestReads(AsyncIO &io, const std::vector<AsyncTestFile> &files) {
+    std::mutex mutex;
+    std::vector<AsyncIO::Result> results(files.size());
+    std::vector<AsyncIO::Request> requests;
+    std::vector<AsyncIO::Handle> handles;
+
+    for (size_t i = 0; i < files.size(); i++) {
+        AsyncIO::Request request;
+        request.filepath = files[i].filepath;
+        request.dispatch = AsyncIO::Dispatch::JobSystem;
+        request.callback = [&, i](const AsyncIO::Result &result) {
+            std::lock_guard<std::mutex> guard(mutex);
+            results[i] = result;
+        };
+        requests.push_back(std::move(request));
+    }
+
+    io.SubmitBatch(requests, handles);
+    io.WaitIdle();
+
+    // Callbacks are dispatched to job system, wait for them
+    while (true) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (std::all_of(results.begin(), results.end(), [](const AsyncIO::Result &r) { return r.handle != AsyncIO::INVALID_HANDLE; }))
+            break;
+    }
+
+    for (size_t i = 0; i < files.size(); i++) {
+        EXPECT_EQ(results[i].handle, handles[i]);
+        EXPECT_TRUE(results[i].status == AsyncIO::Status::Completed);
+        EXPECT_TRUE(results[i].data.IsNotNull());
+        EXPECT_EQ(results[i].bytesRead, files[i].data->GetSize());
+        EXPECT_TRUE(IsSameBytes(results[i].data->GetData(), results[i].bytesRead, files[i].data));
+    }
+
+    // Range into caller buffer
+    auto &file = files.front();
+    std::vector<uint8> buffer(file.data->GetSize() / 2);
+    AsyncIO::Result rangeResult;
+
+    AsyncIO::Request request;
+    request.filepath = file.filepath;
+    request.offset = file.data->GetSize() - buffer.size();
+    request.size = buffer.size();
+    request.buffer = buffer.data();
+    request.dispatch = AsyncIO::Dispatch::IOThread;
+    request.callback = [&](const AsyncIO::Result &result) { rangeResult = result; };
+    io.Submit(std::move(request));
+    io.WaitIdle();
+
+    EXPECT_TRUE(rangeResult.status == AsyncIO::Status::Completed);
+    EXPECT_TRUE(rangeResult.data.IsNull());
+    EXPECT_EQ(rangeResult.buffer, buffer.data());
+    EXPECT_EQ(rangeResult.bytesRead, buffer.size());
+    EXPECT_TRUE(IsSameBytes(buffer.data(), buffer.size(), file.data, file.data->GetSize() - buffer.size()));
+
+    // Missing file
+    AsyncIO::Status missingStatus = AsyncIO::Status::Completed;
+    request = AsyncIO::Request();
+    request.filepath = file.filepath + ".missing";
+    request.dispatch = AsyncIO::Dispatch::IOThread;
+    request.callback = [&](const AsyncIO::Result &result) { missingStatus = result.status; };
+    io.Submit(std::move(request));
+    io.WaitIdle();
+
+    EXPECT_TRUE(missingStatus == AsyncIO::Status::Failed);
+}
+
+BRK_NS_END
+
+TEST(Berserk, AsyncIOReads) {
+    BRK_NS_USE;
+
+    TestTempDir temp("async-io");
+    FileSystem fs;
+    JobSystem jobSystem;
+    auto files = WriteTestFiles(fs, temp.GetPath(), 64, 256 * 1024);
+
+    AsyncIO pool(nullptr, &jobSystem, 2, AsyncIO::Backend::ThreadPool);
+    EXPECT_TRUE(pool.GetBackend() == AsyncIO::Backend::ThreadPool);
+    TestReads(pool, files);
+    EXPECT_GT(pool.GetPooledBytes(), 0u);
+
+    AsyncIO uring(nullptr, &jobSystem);
+    TestReads(uring, files);
+}
+
+TEST(Berserk, AsyncIOPriorityAndCancel) {
+    BRK_NS_USE;
+
+    TestTempDir temp("async-io-priority");
+    FileSystem fs;
+    auto files = WriteTestFiles(fs, temp.GetPath(), 4, 1024);
+
+    AsyncIO io(nullptr, nullptr, 1, AsyncIO::Backend::ThreadPool);
+    IOThreadBlocker blocker;
+    std::vector<AsyncIO::Priority> order;
+    std::vector<AsyncIO::Status> statuses(3, AsyncIO::Status::Failed);
+
+    io.Submit(blocker.MakeRequest(files[0].filepath));
+    blocker.WaitBlocked();
+
+    // While the only thread is blocked, requests are queued
+    AsyncIO::Priority priorities[] = {AsyncIO::Priority::Prefetch, AsyncIO::Priority::Normal, AsyncIO::Priority::Critical};
+    std::vector<AsyncIO::Handle> handles;
+
+    for (uint32 i = 0; i < 3; i++) {
+        AsyncIO::Request request;
+        request.filepath = files[i + 1].filepath;
+        request.priority = priorities[i];
+        request.dispatch = AsyncIO::Dispatch::IOThread;
+        request.callback = [&, i](const AsyncIO::Result &result) {
+            statuses[i] = result.status;
+            if (result.status == AsyncIO::Status::Completed)
+                order.push_back(priorities[i]);
+        };
+        handles.push_back(io.Submit(std::move(request)));
+    }
+
+    AsyncIO::Request cancelled;
+    cancelled.filepath = files[1].filepath;
+    cancelled.priority = AsyncIO::Priority::Critical;
+    cancelled.dispatch = AsyncIO::Dispatch::IOThread;
+    bool cancelledCalled = false;
+    cancelled.callback = [&](const AsyncIO::Result &result) { cancelledCalled = result.status == AsyncIO::Status::Cancelled; };
+    auto cancelledHandle = io.Submit(std::move(cancelled));
+
+    EXPECT_EQ(io.GetPendingCount(), 5u);
+    EXPECT_TRUE(io.Cancel(cancelledHandle));
+    EXPECT_FALSE(io.Cancel(cancelledHandle));
+    EXPECT_TRUE(cancelledCalled);
+
+    blocker.Release();
+    io.WaitIdle();
+
+    EXPECT_EQ(io.GetPendingCount(), 0u);
+    EXPECT_EQ(order, std::vector<AsyncIO::Priority>({AsyncIO::Priority::Critical, AsyncIO::Priority::Normal, AsyncIO::Priority::Prefetch}));
+    EXPECT_FALSE(io.Cancel(handles[0]));
+}
+
+BRK_BENCHMARK(AsyncIOBenchmark) {
+    BRK_NS_USE;
+
+    const uint32 count = 512;
+
+    TestTempDir temp("async-io-bench");
+    FileSystem fs;
+    JobSystem jobSystem;
+    auto files = WriteTestFiles(fs, temp.GetPath(), count, 256 * 1024);
+
+    size_t totalBytes = 0;
+    for (auto &file : files)
+        totalBytes += file.data->GetSize();
+
+    auto blockingMs = MeasureMs([&]() {
+        for (auto &file : files)
+            EXPECT_TRUE(fs.ReadFile(file.filepath).IsNotNull());
+    });
+
+    auto measure = [&](AsyncIO &io) {
+        std::atomic<uint32> completed{0};
+        std::vector<AsyncIO::Request> requests;
+        std::vector<AsyncIO::Handle> handles;
+
+        for (auto &file : files) {
+            AsyncIO::Request request;
+            request.filepath = file.filepath;
+            request.dispatch = AsyncIO::Dispatch::IOThread;
+            request.callback = [&](const AsyncIO::Result &result) { completed += result.status == AsyncIO::Status::Completed ? 1 : 0; };
+            requests.push_back(std::move(request));
+        }
+
+        auto ms = MeasureMs([&]() {
+            io.SubmitBatch(requests, handles);
+            io.WaitIdle();
+        });
+
+        EXPECT_EQ(completed.load(), count);
+        return ms;
+    };
+
+    AsyncIO pool(nullptr, &jobSystem, 4, AsyncIO::Backend::ThreadPool);
+    AsyncIO uring(nullptr, &jobSystem);
+
+    // Warm up buffer pools
+    measure(pool);
+    measure(uring);
+
+    auto mib = static_cast<double>(totalBytes) / (1024.0 * 1024.0);
+    auto poolMs = measure(pool);
+    auto uringMs = measure(uring);
+
+    std::cout << "AsyncIO " << count << " files " << mib << " MiB (page cache)" << std::endl
+              << " blocking ReadFile: " << blockingMs << " ms" << std::endl
+              << " thread pool (4 threads): " << poolMs << " ms" << std::endl
+              << " " << (uring.GetBackend() == AsyncIO::Backend::IoUring ? "io_uring" : "thread pool") << ": " << uringMs << " ms" << std::endl;
+}
+
+BRK_GTEST_MAIN
@@ -0,0 +1,246 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/JobSystem.hpp>
+#include <core/Memory.hpp>
+#include <core/compression/CompressedStream.hpp>
+#include <core/compression/Lz4.hpp>
+#include <platform/FileSystem.hpp>
+#include <platform/PakArchive.hpp>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/** Generates data similar to cooked assets: text, quantized vertices and noise */
+static Ref<Data> GenerateAssetData(size_t size, uint32 seed) {
+    static const char *const WORDS[] = {"mesh", "texture", "material", "shader", "<node>", "</node>", "position", "normal", " ", "\n", "=", "0.5", "1.0"};
+
+    std::mt19937 engine(seed);
+    auto data = Data::Make(size);
+    auto bytes = reinterpret_cast<uint8 *>(data->GetDataWrite());
+    size_t offset = 0;
+
+    while (offset < size) {
+        auto kind = engine() % 3;
+        size_t count = std::min<size_t>(size - offset, 256 + engine() % 4096);
+
+        for (size_t i = 0; i < count;) {
+            if (kind == 0) {
+                const char *word = WORDS[engine() % (sizeof(WORDS) / sizeof(WORDS[0]))];
+                for (; *word && i < count; word++, i++)
+                    bytes[offset + i] = static_cast<uint8>(*word);
+            } else if (kind == 1) {
+                // Smooth 16-bit values
+                auto value = static_cast<uint16>(1000 + (offset + i) % 512 + engine() % 4);
+                bytes[offset + i++] = static_cast<uint8>(value);
+                if (i < count)
+                    bytes[offset + i++] = static_cast<uint8>(value >> 8);
+            } else {
+                bytes[offset + i++] = static_cast<uint8>(engine() % 16 == 0 ? engine() : 0);
+            }
+        }
+
+        offset += count;
+    }
+
+    return data;
+}
+
+static bool IsSameContent(const Ref<Data> &a, const Ref<Data> &b) {
+    return a.IsNotNull() && b.IsNotNull() && a->GetSize() == b->GetSize() && Memory::Compare(a->GetData(), b->GetData(), a->GetSize()) == 0;
+}
+
+BRK_NS_END
+
+TEST(Berserk, Lz4RoundTrip) {
+    BRK_NS_USE;
+
+    std::mt19937 engine(42);
+    std::vector<Ref<Data>> inputs;
+
+    for (size_t size = 1; size < 40; size++)
+        inputs.push_back(GenerateAssetData(size, static_cast<uint32>(size)));
+
+    inputs.push_back(GenerateAssetData(100000, 1));
+    inputs.push_back(Data::Make(String(70000, 'a')));
+
+    auto noise = Data::Make(70000);
+    for (size_t i = 0; i < noise->GetSize(); i++)
+        reinterpret_cast<uint8 *>(noise->GetDataWrite())[i] = static_cast<uint8>(engine());
+    inputs.push_back(noise);
+
+    for (auto &input : inputs) {
+        std::vector<uint8> compressed(Lz4::GetMaxCompressedSize(input->GetSize()));
+        std::vector<uint8> decompressed(input->GetSize());
+
+        auto size = Lz4::Compress(input->GetData(), input->GetSize(), compressed.data(), compressed.size());
+        ASSERT_GT(size, 0u);
+        EXPECT_TRUE(Lz4::Decompress(compressed.data(), size, decompressed.data(), decompressed.size()));
+        EXPECT_EQ(Memory::Compare(decompressed.data(), input->GetData(), input->GetSize()), 0);
+
+        // Too small output buffer or wrong size are reported
+        EXPECT_EQ(Lz4::Compress(input->GetData(), input->GetSize(), compressed.data(), size - 1), 0u);
+        EXPECT_FALSE(Lz4::Decompress(compressed.data(), size, decompressed.data(), decompressed.size() - 1));
+
+        // Corrupted input never crashes
+        for (uint32 i = 0; i < 16; i++) {
+            auto corrupted = compressed;
+            corrupted[engine() % size] ^= static_cast<uint8>(1 + engine() % 255);
+            Lz4::Decompress(corrupted.data(), size, decompressed.data(), decompressed.size());
+        }
+    }
+
+    EXPECT_LT(Lz4::Compress(inputs[inputs.size() - 2]->GetData(), 70000, std::vector<uint8>(Lz4::GetMaxCompressedSize(70000)).data(), Lz4::GetMaxCompressedSize(70000)), 400u);
+}
+
+TEST(Berserk, CompressedStream) {
+    BRK_NS_USE;
+
+    JobSystem jobSystem;
+    auto data = GenerateAssetData(1000000, 7);
+    auto stream = CompressedStream::Compress(data, CompressionCodec::Lz4, 4096, &jobSystem);
+
+    EXPECT_TRUE(CompressedStream::IsCompressed(stream));
+    EXPECT_FALSE(CompressedStream::IsCompressed(data));
+    EXPECT_LT(stream->GetSize(), data->GetSize());
+    EXPECT_TRUE(IsSameContent(CompressedStream::Decompress(stream), data));
+    EXPECT_TRUE(IsSameContent(CompressedStream::Decompress(stream, &jobSystem), data));
+
+    // Stored codec
+    auto stored = CompressedStream::Compress(data, CompressionCodec::None);
+    EXPECT_GT(stored->GetSize(), data->GetSize());
+    EXPECT_TRUE(IsSameContent(CompressedStream::Decompress(stored), data));
+
+    // Streaming read with sizes not aligned to blocks
+    CompressedStreamReader reader(stream);
+    ASSERT_TRUE(reader.IsValid());
+    std::vector<uint8> buffer(data->GetSize());
+    size_t offset = 0;
+    size_t chunk = 1;
+    while (!reader.IsEnd()) {
+        auto read = reader.Read(buffer.data() + offset, std::min(chunk, buffer.size() - offset));
+        ASSERT_GT(read, 0u);
+        offset += read;
+        chunk = chunk * 3 + 1;
+    }
+    EXPECT_EQ(offset, data->GetSize());
+    EXPECT_EQ(Memory::Compare(buffer.data(), data->GetData(), data->GetSize()), 0);
+
+    // Truncated stream is rejected
+    EXPECT_TRUE(CompressedStream::Decompress(Data::MakeSubset(stream, 0, stream->GetSize() - 1)).IsNull());
+}
+
+TEST(Berserk, CompressedPakAndFiles) {
+    BRK_NS_USE;
+
+    // Declared first, so mappings of the pak are released before removal
+    TestTempDir temp("compression");
+    JobSystem jobSystem;
+    FileSystem fs;
+    fs.SetJobSystem(&jobSystem);
+
+    auto &dir = temp.GetPath();
+    auto text = GenerateAssetData(300000, 1);
+    auto noise = Data::Make(1000);
+    for (size_t i = 0; i < noise->GetSize(); i++)
+        reinterpret_cast<uint8 *>(noise->GetDataWrite())[i] = static_cast<uint8>(i * 7919 % 251);
+
+    PakBuilder builder;
+    builder.AddFile("text.bin", text, CompressionCodec::Lz4);
+    builder.AddFile("raw.bin", text);
+    builder.AddFile("noise.bin", noise, CompressionCodec::Lz4);
+
+    EXPECT_TRUE(builder.Save(fs, dir + "/compressed.brkpak", &jobSystem));
+    EXPECT_TRUE(fs.WriteFile(dir + "/text.z", CompressedStream::Compress(text)));
+
+    auto pak = PakArchive::Open(fs, dir + "/compressed.brkpak");
+    ASSERT_TRUE(pak.IsNotNull());
+    EXPECT_EQ(pak->FindEntry("text.bin")->codec, CompressionCodec::Lz4);
+    EXPECT_LT(pak->FindEntry("text.bin")->size, text->GetSize());
+    EXPECT_EQ(pak->FindEntry("raw.bin")->codec, CompressionCodec::None);
+
+    fs.AddSearchPath(dir);
+    EXPECT_TRUE(fs.MountPak("compressed.brkpak"));
+
+    EXPECT_TRUE(IsSameContent(fs.ReadFile(fs.GetFullFilePath("text.bin")), text));
+    EXPECT_TRUE(IsSameContent(fs.ReadFile(fs.GetFullFilePath("raw.bin")), text));
+    EXPECT_TRUE(IsSameContent(fs.ReadFile(fs.GetFullFilePath("noise.bin")), noise));
+    EXPECT_TRUE(IsSameContent(fs.ReadCompressedFile(fs.GetFullFilePath("text.z")), text));
+
+    auto reader = fs.OpenCompressedFile(fs.GetFullFilePath("text.z"));
+    ASSERT_TRUE(reader.IsNotNull());
+    EXPECT_EQ(reader->GetSize(), text->GetSize());
+}
+
+BRK_BENCHMARK(CompressionBenchmark) {
+    BRK_NS_USE;
+
+    const size_t size = 64 * 1024 * 1024;
+
+    TestTempDir temp("compression-bench");
+    JobSystem jobSystem;
+    FileSystem fs;
+    fs.SetJobSystem(&jobSystem);
+
+    auto &dir = temp.GetPath();
+    auto data = GenerateAssetData(size, 3);
+
+    Ref<Data> stream;
+    auto compressMs = MeasureMs([&]() { stream = CompressedStream::Compress(data, CompressionCodec::Lz4, CompressedStream::DEFAULT_BLOCK_SIZE, &jobSystem); });
+
+    EXPECT_TRUE(fs.WriteFile(dir + "/bench.raw", data));
+    EXPECT_TRUE(fs.WriteFile(dir + "/bench.z", stream));
+
+    Ref<Data> serial, parallel, raw, loaded;
+    auto serialMs = MeasureMs([&]() { serial = CompressedStream::Decompress(stream); });
+    auto parallelMs = MeasureMs([&]() { parallel = CompressedStream::Decompress(stream, &jobSystem); });
+    auto rawMs = MeasureMs([&]() { raw = fs.ReadFile(dir + "/bench.raw"); });
+    auto loadMs = MeasureMs([&]() { loaded = fs.ReadCompressedFile(dir + "/bench.z"); });
+
+    EXPECT_TRUE(IsSameContent(serial, data));
+    EXPECT_TRUE(IsSameContent(parallel, data));
+    EXPECT_TRUE(IsSameContent(raw, data));
+    EXPECT_TRUE(IsSameContent(loaded, data));
+
+    auto mbs = [&](double ms) { return static_cast<double>(size) / (1024.0 * 1024.0) / (ms / 1000.0); };
+    auto ratio = static_cast<double>(size) / static_cast<double>(stream->GetSize());
+
+    std::cout << "Compression of " << size / (1024 * 1024) << " MiB, ratio x" << ratio << std::endl
+              << " compress: " << mbs(compressMs) << " MiB/s" << std::endl
+              << " decompress serial: " << mbs(serialMs) << " MiB/s" << std::endl
+              << " decompress parallel (" << jobSystem.GetWorkersCount() << " workers): " << mbs(parallelMs) << " MiB/s" << std::endl
+              << " read raw file: " << mbs(rawMs) << " MiB/s" << std::endl
+              << " read compressed file: " << mbs(loadMs) << " MiB/s" << std::endl
+              << " disk bytes saved: " << (1.0 - 1.0 / ratio) * 100.0 << "%" << std::endl;
+}
+
+BRK_GTEST_MAIN
@@ -0,0 +1,129 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/profiler/Counters.hpp>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+TEST(Berserk, CountersShardedAdd) {
+    BRK_NS_USE;
+
+    CounterRegistry registry;
+    auto &counter = registry.GetCounter("test.adds");
+    EXPECT_EQ(&counter, &registry.GetCounter("test.adds"));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 10000; i++)
+                counter.Add(2);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    registry.NextFrame();
+    auto frame = registry.GetLastFrame();
+    ASSERT_NE(frame.Find("test.adds"), nullptr);
+    EXPECT_EQ(frame.Find("test.adds")->value, 80000);
+    EXPECT_EQ(frame.Find("test.missing"), nullptr);
+
+    // Counters are reset each frame
+    registry.NextFrame();
+    EXPECT_EQ(registry.GetLastFrame().Find("test.adds")->value, 0);
+    EXPECT_EQ(registry.GetLastFrame().index, 1u);
+}
+
+TEST(Berserk, CountersGaugeAndHistogram) {
+    BRK_NS_USE;
+
+    CounterRegistry registry;
+    auto &gauge = registry.GetGauge("test.resident");
+    auto &histogram = registry.GetHistogram("test.sizes");
+
+    gauge.Add(5);
+    gauge.Add(-2);
+
+    for (uint64 i = 0; i < 100; i++)
+        histogram.Record(i < 90 ? 10 : 1000);
+
+    registry.NextFrame();
+    auto frame = registry.GetLastFrame();
+    auto resident = frame.Find("test.resident");
+    auto sizes = frame.Find("test.sizes");
+
+    ASSERT_NE(resident, nullptr);
+    ASSERT_NE(sizes, nullptr);
+    EXPECT_EQ(resident->value, 3);
+    EXPECT_EQ(sizes->value, 100);
+    EXPECT_EQ(sizes->sum, 90u * 10u + 10u * 1000u);
+    EXPECT_EQ(sizes->max, 1000u);
+    EXPECT_EQ(sizes->GetPercentile(0.5f), 15u);
+    EXPECT_EQ(sizes->GetPercentile(0.95f), 1000u);
+
+    // Gauge keeps value, histogram is reset
+    registry.NextFrame();
+    frame = registry.GetLastFrame();
+    EXPECT_EQ(frame.Find("test.resident")->value, 3);
+    EXPECT_EQ(frame.Find("test.sizes")->value, 0);
+    EXPECT_EQ(Histogram::GetBucket(0), 0u);
+    EXPECT_EQ(Histogram::GetBucket(1), 1u);
+    EXPECT_EQ(Histogram::GetBucket(1024), 11u);
+}
+
+TEST(Berserk, CountersCapture) {
+    BRK_NS_USE;
+
+    CounterRegistry registry;
+    registry.SetCapture(true);
+
+    registry.GetCounter("rhi.draw_calls").Add(10);
+    registry.NextFrame();
+
+    // Registered in the middle of capture
+    registry.GetHistogram("rhi.upload").Record(100);
+    registry.GetCounter("rhi.draw_calls").Add(12);
+    registry.NextFrame();
+
+    EXPECT_EQ(registry.GetCapturedFramesCount(), 2u);
+
+    std::stringstream csv;
+    registry.WriteCsv(csv);
+    EXPECT_EQ(csv.str(), "frame,rhi.draw_calls,rhi.upload.count,rhi.upload.p50,rhi.upload.p95,rhi.upload.max\n"
+                         "0,10,0,0,0,0\n"
+                         "1,12,1,100,100,100\n");
+
+    std::stringstream json;
+    registry.WriteJson(json);
+    EXPECT_NE(json.str().find(R"({"frame":1,"counters":{"rhi.draw_calls":12,"rhi.upload":{"count":1,"sum":100,"p50":100,"p95":100,"max":100}}})"), std::string::npos);
+}
+
+BRK_GTEST_MAIN
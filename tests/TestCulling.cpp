@@ -0,0 +1,195 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/JobSystem.hpp>
+#include <core/math/Frustumf.hpp>
+#include <core/math/MathUtils3d.hpp>
+#include <render/culling/FrustumCuller.hpp>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+BRK_NS_BEGIN
+
+static Frustumf MakeFrustum() {
+    auto view = MathUtils3d::LookAt(Vec3f(0, 0, 0), Vec3f(0.3f, 0.1f, -1.0f), Vec3f(0, 1, 0));
+    auto proj = MathUtils3d::Perspective(MathUtils::DegToRad(60.0f), 16.0f / 9.0f, 0.1f, 400.0f);
+    return Frustumf(proj * view);
+}
+
+/** @return True if box touches any plane, so simd and scalar tests may disagree due to rounding */
+static bool IsOnBoundary(const Frustumf &frustum, const Aabbf &box) {
+    const float epsilon = 1e-2f;
+    auto c = box.GetCenter();
+    auto e = box.GetExtent();
+
+    for (auto &plane : frustum.GetPlanes()) {
+        float distance = plane[0] * c[0] + plane[1] * c[1] + plane[2] * c[2] + plane[3];
+        float radius = MathUtils::Abs(plane[0]) * e[0] + MathUtils::Abs(plane[1]) * e[1] + MathUtils::Abs(plane[2]) * e[2];
+
+        if (MathUtils::Abs(distance + radius) < epsilon)
+            return true;
+    }
+
+    return false;
+}
+
+static std::vector<Aabbf> GenerateBoxes(uint32 count, const Frustumf &frustum) {
+    std::mt19937 engine(count);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.1f, 4.0f);
+
+    std::vector<Aabbf> boxes;
+    boxes.reserve(count);
+
+    while (boxes.size() < count) {
+        Vec3f center(position(engine), position(engine), position(engine));
+        Vec3f extent(size(engine), size(engine), size(engine));
+        Aabbf box(center - extent, center + extent);
+
+        if (!IsOnBoundary(frustum, box))
+            boxes.push_back(box);
+    }
+
+    return boxes;
+}
+
+static void CullScalar(const Frustumf &frustum, const std::vector<Aabbf> &boxes, std::vector<uint32> &visible) {
+    visible.clear();
+    for (uint32 i = 0; i < boxes.size(); i++) {
+        if (frustum.Intersects(boxes[i]))
+            visible.push_back(i);
+    }
+}
+
+static void BenchmarkCulling(uint32 count) {
+    const uint32 runs = 10;
+
+    auto frustum = MakeFrustum();
+    auto boxes = GenerateBoxes(count, frustum);
+
+    std::vector<uint32> expected;
+    auto scalarMs = MeasureMs([&]() { CullScalar(frustum, boxes, expected); }, runs);
+
+    JobSystem jobSystem;
+    FrustumCuller culler(&jobSystem);
+    FrustumCuller cullerSingle;
+
+    for (auto &box : boxes) {
+        culler.Add(box);
+        cullerSingle.Add(box);
+    }
+
+    std::vector<uint32> visible;
+    std::vector<uint32> visibleSingle;
+
+    auto singleMs = MeasureMs([&]() { cullerSingle.Cull(frustum, visibleSingle); }, runs);
+    auto parallelMs = MeasureMs([&]() { culler.Cull(frustum, visible); }, runs);
+
+    EXPECT_EQ(expected, visibleSingle);
+    EXPECT_EQ(expected, visible);
+
+    std::cout << "Objects: " << count << " visible: " << visible.size() << std::endl
+              << " scalar AoS: " << scalarMs << " ms" << std::endl
+              << " simd SoA: " << singleMs << " ms" << std::endl
+              << " simd SoA parallel (" << jobSystem.GetWorkersCount() + 1 << " threads): " << parallelMs << " ms" << std::endl;
+}
+
+BRK_NS_END
+
+TEST(Berserk, FrustumPlanes) {
+    BRK_NS_USE;
+
+    auto frustum = MakeFrustum();
+    auto dir = Vec3f(0.3f, 0.1f, -1.0f).Normalized();
+
+    EXPECT_TRUE(frustum.Contains(dir * 10.0f));
+    EXPECT_FALSE(frustum.Contains(dir * -10.0f));
+    EXPECT_FALSE(frustum.Contains(dir * 0.01f));
+    EXPECT_FALSE(frustum.Contains(dir * 500.0f));
+}
+
+TEST(Berserk, FrustumCullerRemove) {
+    BRK_NS_USE;
+
+    auto frustum = MakeFrustum();
+    auto dir = Vec3f(0.3f, 0.1f, -1.0f).Normalized();
+
+    FrustumCuller culler;
+    auto a = culler.Add(Aabbf(dir * 10.0f, 1.0f));
+    auto b = culler.Add(Aabbf(dir * -10.0f, 1.0f));
+    auto c = culler.Add(Aabbf(dir * 20.0f, 1.0f));
+
+    std::vector<uint32> visible;
+    culler.Cull(frustum, visible);
+    EXPECT_EQ(visible, std::vector<uint32>({a, c}));
+
+    culler.Remove(a);
+    culler.Update(b, Aabbf(dir * 30.0f, 1.0f));
+    culler.Cull(frustum, visible);
+    EXPECT_EQ(visible, std::vector<uint32>({b, c}));
+}
+
+TEST(Berserk, FrustumCullerMatchesScalar) {
+    BRK_NS_USE;
+
+    auto frustum = MakeFrustum();
+    auto boxes = GenerateBoxes(20000, frustum);
+
+    std::vector<uint32> expected;
+    CullScalar(frustum, boxes, expected);
+    EXPECT_FALSE(expected.empty());
+
+    JobSystem jobSystem(2);
+    FrustumCuller culler(&jobSystem);
+    FrustumCuller cullerSingle;
+
+    for (auto &box : boxes) {
+        culler.Add(box);
+        cullerSingle.Add(box);
+    }
+
+    std::vector<uint32> visible;
+    cullerSingle.Cull(frustum, visible);
+    EXPECT_EQ(expected, visible);
+
+    culler.Cull(frustum, visible);
+    EXPECT_EQ(expected, visible);
+}
+
+BRK_BENCHMARK(FrustumCullerBenchmark100k) {
+    BRK_NS::BenchmarkCulling(100000);
+}
+
+BRK_BENCHMARK(FrustumCullerBenchmark1M) {
+    BRK_NS::BenchmarkCulling(1000000);
+}
+
+BRK_GTEST_MAIN
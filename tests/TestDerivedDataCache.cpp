@@ -0,0 +1,188 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/Sha256.hpp>
+#include <platform/FileSystem.hpp>
+#include <resource/DerivedDataCache.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+BRK_NS_BEGIN
+
+static Ref<Data> MakePayload(size_t size, uint8 seed) {
+    auto data = Data::Make(size);
+    auto *p = reinterpret_cast<uint8 *>(data->GetDataWrite());
+    for (size_t i = 0; i < size; i++)
+        p[i] = static_cast<uint8>(i * 31 + seed);
+    return data;
+}
+
+static bool IsSameContent(const Ref<Data> &a, const Ref<Data> &b) {
+    return a.IsNotNull() && b.IsNotNull() && a->GetSize() == b->GetSize() && std::memcmp(a->GetData(), b->GetData(), a->GetSize()) == 0;
+}
+
+static String MakeTestKey(const Ref<Data> &source, uint32 option) {
+    auto hash = DerivedDataCache::BeginKey("TestImporter", 1, source);
+    hash.Update(option);
+    return DerivedDataCache::MakeKey(hash);
+}
+
+BRK_NS_END
+
+TEST(Berserk, Sha256) {
+    BRK_NS_USE;
+
+    EXPECT_EQ(Sha256::ToHex(Sha256::Hash("", 0)), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(Sha256::ToHex(Sha256::Hash("abc", 3)), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+    String message = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    EXPECT_EQ(Sha256::ToHex(Sha256::Hash(message.data(), message.size())), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    // Incremental updates with uneven chunks
+    std::vector<char> million(1000000, 'a');
+    Sha256 hash;
+    size_t offset = 0;
+    for (size_t chunk = 1; offset < million.size(); chunk = chunk * 3 + 1) {
+        auto size = std::min(chunk, million.size() - offset);
+        hash.Update(million.data() + offset, size);
+        offset += size;
+    }
+    EXPECT_EQ(Sha256::ToHex(hash.Finish()), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST(Berserk, DerivedDataCacheBasic) {
+    BRK_NS_USE;
+
+    TestTempDir temp("ddc");
+    FileSystem fs;
+    auto dir = temp.GetPath();
+    auto source = MakePayload(1000, 1);
+    auto payload = MakePayload(5000, 2);
+
+    auto key = MakeTestKey(source, 1);
+    EXPECT_EQ(key.size(), 64u);
+    EXPECT_NE(key, MakeTestKey(source, 2));
+    EXPECT_NE(key, MakeTestKey(MakePayload(1000, 3), 1));
+    EXPECT_EQ(key, MakeTestKey(MakePayload(1000, 1), 1));
+
+    {
+        DerivedDataCache cache(fs, dir);
+        EXPECT_TRUE(cache.IsValid());
+        cache.Put(key, MakePayload(10, 0));
+
+        // Replace existing entry
+        EXPECT_TRUE(cache.Put(key, payload));
+        EXPECT_TRUE(IsSameContent(cache.Get(key), payload));
+        EXPECT_TRUE(cache.Get(MakeTestKey(source, 2)).IsNull());
+        EXPECT_EQ(cache.GetHitsCount(), 1u);
+        EXPECT_EQ(cache.GetMissesCount(), 1u);
+    }
+
+    // Other instance (process) sharing directory
+    DerivedDataCache cache(fs, dir);
+    EXPECT_GE(cache.GetSize(), payload->GetSize());
+    EXPECT_TRUE(IsSameContent(cache.Get(key), payload));
+
+    // Corrupted entry is removed
+    auto entryPath = dir + "/" + key.substr(0, 2) + "/" + key;
+    auto entry = fs.ReadFile(entryPath);
+    auto corrupted = Data::Make(entry->GetData(), entry->GetSize());
+    reinterpret_cast<uint8 *>(corrupted->GetDataWrite())[100] ^= 0xff;
+    EXPECT_TRUE(fs.WriteFile(entryPath, corrupted));
+
+    EXPECT_TRUE(cache.Get(key).IsNull());
+    EXPECT_FALSE(fs.IsFileExists(entryPath));
+}
+
+TEST(Berserk, DerivedDataCacheEviction) {
+    BRK_NS_USE;
+
+    const size_t entrySize = 10000;
+
+    TestTempDir temp("ddc-eviction");
+    FileSystem fs;
+    auto dir = temp.GetPath();
+    auto source = MakePayload(100, 0);
+
+    String keys[4];
+    for (uint32 i = 0; i < 4; i++)
+        keys[i] = MakeTestKey(source, i);
+
+    // Fits 3 entries
+    DerivedDataCache cache(fs, dir, 3 * entrySize + entrySize / 2);
+
+    for (uint32 i = 0; i < 3; i++) {
+        EXPECT_TRUE(cache.Put(keys[i], MakePayload(entrySize, static_cast<uint8>(i))));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    // First entry is used recently, so second and third are evicted
+    EXPECT_TRUE(cache.Get(keys[0]).IsNotNull());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(cache.Put(keys[3], MakePayload(entrySize, 3)));
+
+    EXPECT_LE(cache.GetSize(), 3 * entrySize);
+    EXPECT_TRUE(IsSameContent(cache.Get(keys[0]), MakePayload(entrySize, 0)));
+    EXPECT_TRUE(cache.Get(keys[1]).IsNull());
+    EXPECT_TRUE(cache.Get(keys[2]).IsNull());
+    EXPECT_TRUE(IsSameContent(cache.Get(keys[3]), MakePayload(entrySize, 3)));
+}
+
+BRK_BENCHMARK(DerivedDataCacheBenchmark) {
+    BRK_NS_USE;
+
+    TestTempDir temp("ddc-bench");
+    FileSystem fs;
+    DerivedDataCache cache(fs, temp.GetPath());
+
+    auto source = MakePayload(16 * 1024 * 1024, 7);
+    auto payload = MakePayload(32 * 1024 * 1024, 8);
+
+    String key;
+    auto keyMs = MeasureMs([&]() {
+        auto hash = DerivedDataCache::BeginKey("TestImporter", 1, source);
+        key = DerivedDataCache::MakeKey(hash);
+    });
+    auto putMs = MeasureMs([&]() { EXPECT_TRUE(cache.Put(key, payload)); });
+
+    Ref<Data> cached;
+    auto getMs = MeasureMs([&]() { cached = cache.Get(key); });
+    EXPECT_TRUE(IsSameContent(cached, payload));
+
+    std::cout << "DerivedDataCache" << std::endl
+              << " key of 16 MiB source: " << keyMs << " ms" << std::endl
+              << " put 32 MiB: " << putMs << " ms" << std::endl
+              << " get 32 MiB: " << getMs << " ms" << std::endl;
+}
+
+BRK_GTEST_MAIN
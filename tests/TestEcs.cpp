@@ -0,0 +1,361 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/JobSystem.hpp>
+#include <scene/ecs/EntityCommandBuffer.hpp>
+#include <scene/ecs/EntitySystem.hpp>
+#include <scene/ecs/EntityWorld.hpp>
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+BRK_NS_BEGIN
+
+struct Position {
+    Position() = default;
+    Position(float x, float y, float z) : x(x), y(y), z(z) {}
+
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+struct Velocity {
+    Velocity() = default;
+    Velocity(float x, float y, float z) : x(x), y(y), z(z) {}
+
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+struct Health {
+    Health() = default;
+    explicit Health(float value) : value(value) {}
+
+    float value = 100.0f;
+};
+
+struct Dead {};
+
+/** Counts alive instances to check component destruction */
+struct Tracked {
+    static int32 alive;
+
+    Tracked() { alive += 1; }
+    Tracked(Tracked &&other) noexcept : value(other.value) { alive += 1; }
+    Tracked &operator=(Tracked &&other) noexcept = default;
+    ~Tracked() { alive -= 1; }
+
+    std::shared_ptr<int> value;
+};
+
+int32 Tracked::alive = 0;
+
+template<uint32 N>
+struct LimitTag {};
+
+/** Registers N distinct tag component types */
+template<uint32 N>
+struct LimitTagRegistrar {
+    static void Register() {
+        LimitTagRegistrar<N - 1>::Register();
+        ComponentRegistry::GetId<LimitTag<N - 1>>();
+    }
+};
+
+template<>
+struct LimitTagRegistrar<0> {
+    static void Register() {}
+};
+
+BRK_NS_END
+
+TEST(Berserk, EcsEntities) {
+    BRK_NS_USE;
+
+    EntityWorld world;
+    Entity a = world.CreateEntity();
+    Entity b = world.CreateEntityWith(Position{1, 2, 3}, Velocity{1, 0, 0});
+
+    EXPECT_TRUE(world.IsAlive(a));
+    EXPECT_TRUE(world.HasComponent<Position>(b));
+    EXPECT_FALSE(world.HasComponent<Position>(a));
+    EXPECT_FLOAT_EQ(world.GetComponent<Position>(b)->y, 2.0f);
+
+    world.DestroyEntity(a);
+    EXPECT_FALSE(world.IsAlive(a));
+
+    // Index is reused with new generation
+    Entity c = world.CreateEntity();
+    EXPECT_EQ(c.index, a.index);
+    EXPECT_NE(c.generation, a.generation);
+    EXPECT_FALSE(world.IsAlive(a));
+    EXPECT_TRUE(world.IsAlive(c));
+
+    // Components survive archetype moves
+    world.AddComponent(b, Health{50.0f});
+    world.AddComponent<Dead>(b);
+    EXPECT_FLOAT_EQ(world.GetComponent<Position>(b)->z, 3.0f);
+    EXPECT_FLOAT_EQ(world.GetComponent<Health>(b)->value, 50.0f);
+
+    world.RemoveComponent<Velocity>(b);
+    EXPECT_EQ(world.GetComponent<Velocity>(b), nullptr);
+    EXPECT_FLOAT_EQ(world.GetComponent<Position>(b)->x, 1.0f);
+    EXPECT_FLOAT_EQ(world.GetComponent<Health>(b)->value, 50.0f);
+    EXPECT_EQ(world.GetEntitiesCount(), 2u);
+}
+
+TEST(Berserk, EcsComponentsLifetime) {
+    BRK_NS_USE;
+
+    {
+        EntityWorld world;
+        std::vector<Entity> entities;
+
+        for (int i = 0; i < 1000; i++) {
+            Entity entity = world.CreateEntityWith(Position{float(i), 0, 0});
+            world.AddComponent<Tracked>(entity).value = std::make_shared<int>(i);
+            entities.push_back(entity);
+        }
+        EXPECT_EQ(Tracked::alive, 1000);
+
+        // Removal moves last entities into holes
+        for (int i = 0; i < 1000; i += 2)
+            world.DestroyEntity(entities[i]);
+        for (int i = 1; i < 1000; i += 4)
+            world.RemoveComponent<Tracked>(entities[i]);
+        EXPECT_EQ(Tracked::alive, 250);
+
+        for (int i = 3; i < 1000; i += 4) {
+            EXPECT_EQ(*world.GetComponent<Tracked>(entities[i])->value, i);
+            EXPECT_FLOAT_EQ(world.GetComponent<Position>(entities[i])->x, float(i));
+        }
+    }
+
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(Berserk, EcsQuery) {
+    BRK_NS_USE;
+
+    EntityWorld world;
+    for (int i = 0; i < 100; i++)
+        world.CreateEntityWith(Position{}, Velocity{1, 2, 3});
+    for (int i = 0; i < 50; i++)
+        world.CreateEntityWith(Position{}, Velocity{1, 2, 3}, Dead{});
+    for (int i = 0; i < 10; i++)
+        world.CreateEntityWith(Position{});
+
+    auto query = EntityQuery::Create<Position, const Velocity>().Exclude<Dead>();
+    EXPECT_EQ(query.Count(world), 100u);
+
+    query.ForEach<Position, const Velocity>(world, [](Entity, Position &p, const Velocity &v) {
+        p.x += v.x;
+        p.y += v.y;
+        p.z += v.z;
+    });
+
+    float sum = 0.0f;
+    EntityQuery::Create<const Position>().ForEach<const Position>(world, [&](Entity, const Position &p) { sum += p.x + p.y + p.z; });
+    EXPECT_FLOAT_EQ(sum, 600.0f);
+
+    // Cached query picks archetypes created after first use
+    world.CreateEntityWith(Position{}, Velocity{}, Health{});
+    EXPECT_EQ(query.Count(world), 101u);
+
+    JobSystem jobSystem;
+    query.ForEachParallel<Position>(world, jobSystem, [](Entity, Position &p) { p.x = 10.0f; });
+
+    uint32 updated = 0;
+    query.ForEach<const Position>(world, [&](Entity, const Position &p) { updated += p.x == 10.0f ? 1 : 0; });
+    EXPECT_EQ(updated, 101u);
+}
+
+TEST(Berserk, EcsCommandBuffer) {
+    BRK_NS_USE;
+
+    EntityWorld world;
+    Entity a = world.CreateEntityWith(Position{});
+    Entity b = world.CreateEntityWith(Position{});
+
+    EntityCommandBuffer commands;
+    Entity c = commands.CreateEntity();
+    commands.AddComponent(c, Health{7.0f});
+    commands.AddComponent(a, Velocity{1, 1, 1});
+    commands.DestroyEntity(b);
+    commands.AddComponent(b, Health{});
+    commands.RemoveComponent<Position>(a);
+
+    commands.AddComponent<Tracked>(b);
+    EXPECT_TRUE(EntityCommandBuffer::IsDeferred(c));
+    EXPECT_EQ(commands.GetCommandsCount(), 7u);
+    EXPECT_EQ(world.GetEntitiesCount(), 2u);
+
+    commands.Playback(world);
+    EXPECT_TRUE(commands.IsEmpty());
+    EXPECT_EQ(Tracked::alive, 0);
+
+    EXPECT_FALSE(world.IsAlive(b));
+    EXPECT_TRUE(world.HasComponent<Velocity>(a));
+    EXPECT_FALSE(world.HasComponent<Position>(a));
+    EXPECT_EQ(world.GetEntitiesCount(), 2u);
+
+    uint32 found = 0;
+    EntityQuery::Create<Health>().ForEach<Health>(world, [&](Entity, Health &h) {
+        EXPECT_FLOAT_EQ(h.value, 7.0f);
+        found += 1;
+    });
+    EXPECT_EQ(found, 1u);
+
+    // Not played payload is destroyed
+    commands.AddComponent<Tracked>(a);
+    commands.Clear();
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(Berserk, EcsScheduler) {
+    BRK_NS_USE;
+
+    JobSystem jobSystem;
+    EntityWorld world;
+    for (int i = 0; i < 1000; i++)
+        world.CreateEntityWith(Position{}, Velocity{1, 0, 0}, Health{});
+
+    EntityScheduler scheduler(&jobSystem);
+
+    scheduler.AddSystem("Move", [](EntityWorld &w, EntityCommandBuffer &) {
+                 auto query = EntityQuery::Create<Position, const Velocity>();
+                 query.ForEach<Position, const Velocity>(w, [](Entity, Position &p, const Velocity &v) { p.x += v.x; });
+             })
+            .Read<Velocity>()
+            .Write<Position>();
+
+    scheduler.AddSystem("Damage", [](EntityWorld &w, EntityCommandBuffer &commands) {
+                 auto query = EntityQuery::Create<Health>();
+                 query.ForEach<Health>(w, [&](Entity e, Health &h) {
+                     h.value -= 60.0f;
+                     if (h.value <= 0.0f)
+                         commands.DestroyEntity(e);
+                 });
+             })
+            .Write<Health>();
+
+    scheduler.AddSystem("Report", [](EntityWorld &w, EntityCommandBuffer &) {
+                 auto query = EntityQuery::Create<const Position>();
+                 query.ForEach<const Position>(w, [](Entity, const Position &p) { EXPECT_GE(p.x, 1.0f); });
+             })
+            .Read<Position>();
+
+    scheduler.Run(world);
+    EXPECT_EQ(scheduler.GetStagesCount(), 2u);
+    EXPECT_EQ(world.GetEntitiesCount(), 1000u);
+
+    scheduler.Run(world);
+    EXPECT_EQ(world.GetEntitiesCount(), 0u);
+}
+
+TEST(Berserk, EcsComponentsLimit) {
+    BRK_NS_USE;
+
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+
+    // Registration past the limit fails in any build, since id does not fit into component mask
+    EXPECT_DEATH(LimitTagRegistrar<ComponentRegistry::MAX_COMPONENTS + 1>::Register(), "");
+    EXPECT_LE(ComponentRegistry::GetComponentsCount(), static_cast<uint32>(ComponentRegistry::MAX_COMPONENTS));
+}
+
+BRK_BENCHMARK(EcsBenchmark) {
+    BRK_NS_USE;
+
+    const uint32 count = 1000000;
+    const float dt = 0.016f;
+
+    JobSystem jobSystem;
+    EntityWorld world;
+    std::vector<Entity> entities(count);
+
+    auto createMs = MeasureMs([&]() {
+        for (uint32 i = 0; i < count; i++)
+            entities[i] = world.CreateEntityWith(Position{float(i), 0, 0}, Velocity{1, 2, 3}, Health{});
+    });
+
+    auto query = EntityQuery::Create<Position, const Velocity, Health>();
+    auto update = [dt](Entity, Position &p, const Velocity &v, Health &h) {
+        p.x += v.x * dt;
+        p.y += v.y * dt;
+        p.z += v.z * dt;
+        h.value -= dt;
+    };
+
+    auto serialMs = MeasureMs([&]() { query.ForEach<Position, const Velocity, Health>(world, update); });
+    auto parallelMs = MeasureMs([&]() { query.ForEachParallel<Position, const Velocity, Health>(world, jobSystem, update); });
+
+    // Baseline: objects allocated separately on heap
+    struct Object {
+        Position p;
+        Velocity v;
+        Health h;
+    };
+    std::vector<std::unique_ptr<Object>> objects;
+    objects.reserve(count);
+    for (uint32 i = 0; i < count; i++)
+        objects.emplace_back(new Object());
+
+    auto heapMs = MeasureMs([&]() {
+        for (auto &o : objects)
+            update(Entity(), o->p, o->v, o->h);
+    });
+
+    // Structural changes: tag and untag 10% of entities
+    EntityCommandBuffer commands;
+    auto structuralMs = MeasureMs([&]() {
+        for (uint32 i = 0; i < count; i += 10)
+            commands.AddComponent<Dead>(entities[i]);
+        commands.Playback(world);
+        for (uint32 i = 0; i < count; i += 10)
+            commands.RemoveComponent<Dead>(entities[i]);
+        commands.Playback(world);
+    });
+
+    float expected = 100.0f - dt;
+    expected -= dt;
+    uint32 valid = 0;
+    query.ForEach<Position, const Velocity, Health>(world, [&](Entity, Position &p, const Velocity &, Health &h) {
+        valid += (h.value == expected && p.y > 0.0f) ? 1 : 0;
+    });
+    EXPECT_EQ(valid, count);
+    EXPECT_EQ(world.GetEntitiesCount(), count);
+
+    std::cout << "ECS entities: " << count << " (chunk capacity " << world.GetArchetype(1).GetChunkCapacity() << ")" << std::endl
+              << " create: " << createMs << " ms" << std::endl
+              << " update serial: " << serialMs << " ms" << std::endl
+              << " update parallel (" << jobSystem.GetWorkersCount() << " workers): " << parallelMs << " ms" << std::endl
+              << " update heap objects: " << heapMs << " ms" << std::endl
+              << " add/remove tag 10%: " << structuralMs << " ms" << std::endl;
+}
+
+BRK_GTEST_MAIN
@@ -27,6 +27,7 @@
 
 #include <Testing.hpp>
 
+#include <core/Memory.hpp>
 #include <platform/FileSystem.hpp>
 
 #include <iostream>
@@ -128,4 +129,30 @@ TEST(Berserk, ReadFile) {
     }
 }
 
+TEST(Berserk, MakeDirWriteFile) {
+    BRK_NS_USE
+
+    FileSystem fs;
+    TestTempDir temp("fs");
+
+    auto dir = temp.GetPath() + "/nested/dir";
+    auto file = dir + "/file.bin";
+    auto data = Data::Make(String("some file content"));
+
+    EXPECT_TRUE(fs.MakeDir(dir));
+    EXPECT_TRUE(fs.MakeDir(dir));
+    EXPECT_TRUE(fs.IsDirExists(dir));
+    EXPECT_TRUE(fs.WriteFile(file, data));
+
+    auto read = fs.ReadFile(file);
+
+    EXPECT_TRUE(read.IsNotNull());
+    EXPECT_EQ(read->GetSize(), data->GetSize());
+    EXPECT_EQ(Memory::Compare(read->GetData(), data->GetData(), data->GetSize()), 0);
+
+    EXPECT_TRUE(fs.RemoveDir(temp.GetPath() + "/nested"));
+    EXPECT_FALSE(fs.IsDirExists(temp.GetPath() + "/nested"));
+    EXPECT_TRUE(fs.RemoveDir(temp.GetPath() + "/nested"));
+}
+
 BRK_GTEST_MAIN
\ No newline at end of file
@@ -0,0 +1,221 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/Crc32.hpp>
+#include <core/Hash64.hpp>
+#include <core/UUID.hpp>
+
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/** Bitwise crc, used as reference for table and hardware versions */
+static uint32 ReferenceCrc(uint32 reversedPoly, const uint8 *p, size_t size) {
+    uint32 crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= p[i];
+        for (uint32 bit = 0; bit < 8; bit++)
+            crc = (crc >> 1u) ^ (reversedPoly & (0u - (crc & 1u)));
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/** Byte at a time crc with single table, as crc was computed before */
+static uint32 BytewiseCrc(const uint8 *p, size_t size) {
+    static std::vector<uint32> table = []() {
+        std::vector<uint32> t(256);
+        for (uint32 i = 0; i < 256; i++) {
+            uint32 crc = i;
+            for (uint32 bit = 0; bit < 8; bit++)
+                crc = (crc >> 1u) ^ (0xEDB88320u & (0u - (crc & 1u)));
+            t[i] = crc;
+        }
+        return t;
+    }();
+
+    uint32 crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++)
+        crc = (crc >> 8u) ^ table[(crc ^ p[i]) & 0xFFu];
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static std::vector<uint8> RandomBytes(size_t size, uint32 seed) {
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<uint32> distribution(0, 255);
+    std::vector<uint8> bytes(size);
+    for (auto &b : bytes)
+        b = static_cast<uint8>(distribution(engine));
+    return bytes;
+}
+
+/** Prints throughput of hash function over buffer of given size */
+template<typename Func>
+static void BenchmarkHash(const char *name, const std::vector<uint8> &buffer, Func &&func) {
+    const size_t totalBytes = 64u * 1024u * 1024u;
+    auto iterations = totalBytes / buffer.size();
+    uint64 sink = 0;
+
+    auto ms = MeasureMs([&]() {
+        for (size_t i = 0; i < iterations; i++)
+            sink += func(buffer.data(), buffer.size());
+    });
+
+    auto gbs = static_cast<double>(iterations * buffer.size()) / (ms * 1e6);
+    std::cout << "  " << name << ": " << gbs << " GB/s (" << (sink & 1u) << ")" << std::endl;
+}
+
+BRK_NS_END
+
+TEST(Berserk, Crc32Check) {
+    BRK_NS_USE;
+
+    const char check[] = "123456789";
+    EXPECT_EQ(Crc32::Hash(check, 9), 0xCBF43926u);
+    EXPECT_EQ(Crc32C::Hash(check, 9), 0xE3069283u);
+    EXPECT_EQ(Crc32::Hash(check, 0), 0u);
+    EXPECT_EQ(Crc32C::Hash(check, 0), 0u);
+
+    // Vectors from RFC 3720 (iSCSI)
+    std::vector<uint8> data(32, 0x00);
+    EXPECT_EQ(Crc32C::Hash(data.data(), data.size()), 0x8A9136AAu);
+    std::fill(data.begin(), data.end(), 0xFF);
+    EXPECT_EQ(Crc32C::Hash(data.data(), data.size()), 0x62A8AB43u);
+    for (uint32 i = 0; i < 32; i++)
+        data[i] = static_cast<uint8>(i);
+    EXPECT_EQ(Crc32C::Hash(data.data(), data.size()), 0x46DD794Eu);
+}
+
+TEST(Berserk, Crc32Reference) {
+    BRK_NS_USE;
+
+    auto bytes = RandomBytes(1024 + 16, 1);
+
+    // Unaligned starts and all small sizes check head and tail loops
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t size = 0; size <= 1024; size += (size < 64 ? 1 : 61)) {
+            auto p = bytes.data() + offset;
+            EXPECT_EQ(Crc32::Hash(p, size), ReferenceCrc(0xEDB88320u, p, size));
+            EXPECT_EQ(Crc32C::Hash(p, size), ReferenceCrc(0x82F63B78u, p, size));
+        }
+    }
+
+    for (size_t split = 0; split <= 100; split++) {
+        auto whole = Crc32::Hash(bytes.data(), 100);
+        auto wholeC = Crc32C::Hash(bytes.data(), 100);
+        EXPECT_EQ(Crc32::Update(Crc32::Hash(bytes.data(), split), bytes.data() + split, 100 - split), whole);
+        EXPECT_EQ(Crc32C::Update(Crc32C::Hash(bytes.data(), split), bytes.data() + split, 100 - split), wholeC);
+
+        Crc32Builder builder;
+        builder.Hash(bytes.data(), split).Hash(bytes.data() + split, 100 - split);
+        EXPECT_EQ(builder.GetHash(), whole);
+    }
+}
+
+TEST(Berserk, Hash64Streaming) {
+    BRK_NS_USE;
+
+    auto bytes = RandomBytes(300, 2);
+
+    for (size_t size = 0; size <= bytes.size(); size++) {
+        auto expected = Hash64::Hash(bytes.data(), size, 7);
+
+        for (size_t split = 0; split <= size; split += (size < 100 ? 1 : 7)) {
+            Hash64Builder builder(7);
+            builder.Update(bytes.data(), split);
+            builder.Update(bytes.data() + split, size - split);
+            EXPECT_EQ(builder.GetHash(), expected);
+        }
+
+        Hash64Builder bytewise(7);
+        for (size_t i = 0; i < size; i++)
+            bytewise.Update(bytes[i]);
+        EXPECT_EQ(bytewise.GetHash(), expected);
+    }
+}
+
+TEST(Berserk, Hash64Properties) {
+    BRK_NS_USE;
+
+    const char text[] = "Berserk";
+    EXPECT_NE(Hash64::Hash(text, 7, 0), Hash64::Hash(text, 7, 1));
+    EXPECT_NE(Hash64::Hash(text, 7), Hash64::Hash(text, 6));
+    EXPECT_EQ(Hash64::Hash(String(text)), Hash64::Hash(text, 7));
+
+    auto a = Hash64::Hash("a", 1);
+    auto b = Hash64::Hash("b", 1);
+    EXPECT_NE(Hash64::Combine(Hash64::Combine(0, a), b), Hash64::Combine(Hash64::Combine(0, b), a));
+    EXPECT_NE(Hash64::Combine(a, a), 0u);
+    EXPECT_NE(Hash64::Mix(1), Hash64::Mix(2));
+
+    // Sequential keys must not collide in 64 bits and should spread over buckets
+    const uint32 count = 100000;
+    std::unordered_set<uint64> hashes;
+    std::vector<uint32> buckets(1024, 0);
+    for (uint32 i = 0; i < count; i++) {
+        auto key = "resource_" + std::to_string(i);
+        auto hash = Hash64::Hash(key.data(), key.size());
+        hashes.insert(hash);
+        buckets[hash & 1023u] += 1;
+    }
+
+    EXPECT_EQ(hashes.size(), count);
+    for (auto bucket : buckets)
+        EXPECT_LT(bucket, 2u * count / 1024u);
+
+    EXPECT_EQ(UUID(1, 2, 3, 4).Hash(), UUID(1, 2, 3, 4).Hash());
+    EXPECT_NE(UUID(1, 2, 3, 4).Hash(), UUID(4, 3, 2, 1).Hash());
+}
+
+BRK_BENCHMARK(HashBenchmark) {
+    BRK_NS_USE;
+
+    const size_t sizes[] = {16, 1024, 1024 * 1024};
+
+    std::cout << "Crc32C hardware: " << (Crc32C::IsHardwareAccelerated() ? "yes" : "no") << std::endl;
+
+    for (auto size : sizes) {
+        auto buffer = RandomBytes(size, 3);
+        std::cout << "Hash throughput " << size << " B:" << std::endl;
+
+        BenchmarkHash("crc32 bytewise", buffer, [](const uint8 *p, size_t s) { return BytewiseCrc(p, s); });
+        BenchmarkHash("crc32 slicing-by-8", buffer, [](const uint8 *p, size_t s) { return Crc32::Hash(p, s); });
+        BenchmarkHash("crc32c", buffer, [](const uint8 *p, size_t s) { return Crc32C::Hash(p, s); });
+        BenchmarkHash("hash64", buffer, [](const uint8 *p, size_t s) { return Hash64::Hash(p, s); });
+        BenchmarkHash("std::hash", buffer, [](const uint8 *p, size_t s) {
+            return std::hash<std::string>{}(std::string(reinterpret_cast<const char *>(p), s));
+        });
+    }
+}
+
+BRK_GTEST_MAIN
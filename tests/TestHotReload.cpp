@@ -0,0 +1,302 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/JobSystem.hpp>
+#include <platform/FileSystem.hpp>
+#include <platform/FileWatcher.hpp>
+#include <resource/ResourceDependencyGraph.hpp>
+#include <resource/ResourceManager.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+BRK_NS_BEGIN
+
+class TestResource final : public Resource {
+public:
+    explicit TestResource(String path, String content = String()) : mContent(std::move(content)) { SetPath(std::move(path)); }
+    ~TestResource() override = default;
+
+    bool ReloadFrom(Resource &imported) override {
+        mContent = static_cast<TestResource &>(imported).mContent;
+        reloads.fetch_add(1);
+        return true;
+    }
+
+    void OnDependencyReloaded(const Resource &) override {
+        dependencyReloads.fetch_add(1);
+    }
+
+    const StringName &GetResourceType() const override {
+        static StringName resourceType(BRK_TEXT("_brk_resource_test"));
+        return resourceType;
+    }
+
+    const String &GetContent() const { return mContent; }
+
+    std::atomic<uint32> reloads{0};
+    std::atomic<uint32> dependencyReloads{0};
+
+private:
+    String mContent;
+};
+
+/** Imports text files with `test` extension; files with `fail` text fail to import */
+class TestImporter final : public ResourceImporter {
+public:
+    explicit TestImporter(FileSystem &fs) : mFileSystem(fs) {}
+    ~TestImporter() override = default;
+
+    Ref<ResourceImportOptions> CreateDefaultOptions() const override {
+        return Ref<ResourceImportOptions>(new ResourceImportOptions);
+    }
+
+    const std::vector<String> &GetSupportedExtensions() const override {
+        return mExtensions;
+    }
+
+    void Import(const String &fullpath, const Ref<ResourceImportOptions> &, ResourceImportResult &result) override {
+        auto data = mFileSystem.ReadFile(fullpath);
+        auto content = data.IsNotNull() ? String(reinterpret_cast<const char *>(data->GetData()), data->GetSize()) : String();
+
+        if (content.empty() || content == "fail") {
+            result.failed = true;
+            result.error = "Invalid content";
+        } else {
+            result.resource = Ref<Resource>(new TestResource(String(), std::move(content)));
+        }
+
+        imports.fetch_add(1);
+    }
+
+    std::atomic<uint32> imports{0};
+
+private:
+    FileSystem &mFileSystem;
+    std::vector<String> mExtensions{"test"};
+};
+
+/** Collects batches of watcher */
+struct WatcherListener {
+    std::vector<std::vector<String>> batches;
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    void OnChanged(const std::vector<String> &files) {
+        std::lock_guard<std::mutex> guard(mutex);
+        batches.push_back(files);
+        cv.notify_all();
+    }
+
+    bool WaitBatches(size_t count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(5), [&]() { return batches.size() >= count; });
+    }
+};
+
+static Ref<Data> MakeText(const char *text) {
+    return Data::Make(text, std::strlen(text));
+}
+
+template<typename Predicate>
+static bool WaitUntil(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+BRK_NS_END
+
+TEST(Berserk, FileWatcherBasic) {
+    BRK_NS_USE;
+
+    TestTempDir temp("watch");
+    FileSystem fs;
+    auto dir = temp.GetPath();
+
+    WatcherListener listener;
+    FileWatcher watcher([&](const std::vector<String> &files) { listener.OnChanged(files); }, 50);
+
+    if (!watcher.IsValid())
+        GTEST_SKIP() << "File watching is not supported";
+
+    ASSERT_TRUE(watcher.AddDirectory(dir + "/"));
+    EXPECT_GE(watcher.GetDirectoriesCount(), 1u);
+
+    // Several writes in a row are reported once
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 5; i++)
+        ASSERT_TRUE(fs.WriteFile(dir + "/a.txt", MakeText("content")));
+
+    ASSERT_TRUE(listener.WaitBatches(1));
+    auto latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    {
+        std::lock_guard<std::mutex> guard(listener.mutex);
+        ASSERT_EQ(listener.batches.size(), 1u);
+        EXPECT_EQ(listener.batches[0], std::vector<String>({dir + "/a.txt"}));
+    }
+
+    // Created directories are watched too
+    ASSERT_TRUE(fs.MakeDir(dir + "/sub"));
+    ASSERT_TRUE(fs.WriteFile(dir + "/sub/b.txt", MakeText("content")));
+    ASSERT_TRUE(listener.WaitBatches(2));
+
+    {
+        std::lock_guard<std::mutex> guard(listener.mutex);
+        EXPECT_EQ(listener.batches[1], std::vector<String>({dir + "/sub/b.txt"}));
+    }
+
+    // Reported in test results (debounce 50 ms)
+    RecordProperty("change_latency_ms", static_cast<int>(latency));
+}
+
+TEST(Berserk, ResourceDependencyGraph) {
+    BRK_NS_USE;
+
+    Ref<ResourceImportOptions> options(new ResourceImportOptions);
+    Ref<Resource> texture(new TestResource("/assets/texture.png"));
+    Ref<Resource> mesh(new TestResource("/assets/mesh.obj"));
+    Ref<Resource> material(new TestResource(""));
+    Ref<Resource> instance(new TestResource(""));
+
+    ResourceDependencyGraph graph;
+    graph.AddImported(texture, options, {});
+    graph.AddImported(mesh, options, {"/assets/mesh.mtl", "/assets/texture.png"});
+    graph.AddResourceDependency(material, texture);
+    graph.AddResourceDependency(instance, material);
+    graph.AddResourceDependency(instance, texture);
+    graph.AddFileDependency(material, "/assets/material.xml");
+
+    EXPECT_EQ(graph.GetResourcesCount(), 4u);
+    EXPECT_EQ(graph.GetFilesCount(), 4u);
+
+    // Only imported resources are reimported
+    std::vector<ResourceDependencyGraph::Entry> affected;
+    graph.GetAffected({"/assets/texture.png", "/assets/mesh.mtl", "/assets/material.xml", "/other.png"}, affected);
+    ASSERT_EQ(affected.size(), 2u);
+    EXPECT_EQ(affected[0].resource, texture);
+    EXPECT_EQ(affected[1].resource, mesh);
+    EXPECT_EQ(affected[0].options, options);
+
+    // Dependants are listed once in breadth-first order
+    std::vector<ResourceDependencyGraph::Dependant> dependants;
+    graph.GetDependants(*texture, dependants);
+    ASSERT_EQ(dependants.size(), 2u);
+    EXPECT_EQ(dependants[0].resource, material);
+    EXPECT_EQ(dependants[0].dependency, texture);
+    EXPECT_EQ(dependants[1].resource, instance);
+    EXPECT_EQ(dependants[1].dependency, texture);
+
+    // Reimport replaces source files
+    graph.AddImported(mesh, options, {});
+    affected.clear();
+    graph.GetAffected({"/assets/mesh.mtl"}, affected);
+    EXPECT_TRUE(affected.empty());
+
+    // Resources referenced only by graph are released
+    dependants.clear();
+    EXPECT_EQ(graph.Prune(), 0u);
+    instance.Reset();
+    material.Reset();
+    mesh.Reset();
+    EXPECT_EQ(graph.Prune(), 3u);
+    EXPECT_EQ(graph.GetResourcesCount(), 1u);
+    EXPECT_TRUE(graph.Contains(*texture));
+
+    graph.GetDependants(*texture, dependants);
+    EXPECT_TRUE(dependants.empty());
+}
+
+TEST(Berserk, ResourceManagerReload) {
+    BRK_NS_USE;
+
+    TestTempDir temp("hot-reload");
+    FileSystem fs;
+    JobSystem jobSystem(2);
+
+    // No scheduler, so resources are replaced on job threads
+    auto importer = std::make_shared<TestImporter>(fs);
+    ResourceManager manager(&fs, nullptr, &jobSystem);
+    manager.RegisterImporter(importer);
+
+    auto path = temp.GetPath() + "/a.test";
+    ASSERT_TRUE(fs.WriteFile(path, MakeText("first")));
+
+    // Not tracked while hot reload is disabled
+    auto untracked = manager.Import(path, importer->CreateDefaultOptions());
+    ASSERT_TRUE(untracked.IsNotNull());
+    EXPECT_EQ(manager.Reload({path}), 0u);
+
+    manager.EnableHotReload();
+    EXPECT_TRUE(manager.IsHotReloadEnabled());
+
+    auto imported = manager.Import(path, importer->CreateDefaultOptions());
+    ASSERT_TRUE(imported.IsNotNull());
+    auto &resource = static_cast<TestResource &>(*imported);
+    EXPECT_EQ(resource.GetContent(), "first");
+
+    Ref<Resource> dependant(new TestResource(String()));
+    manager.AddDependency(dependant, imported);
+    auto &dependantResource = static_cast<TestResource &>(*dependant);
+
+    // Resource is replaced in place and dependant is notified
+    ASSERT_TRUE(fs.WriteFile(path, MakeText("second")));
+    EXPECT_EQ(manager.Reload({temp.GetPath() + "/other.test"}), 0u);
+    EXPECT_EQ(manager.Reload({path}), 1u);
+    ASSERT_TRUE(WaitUntil([&]() { return dependantResource.dependencyReloads.load() == 1; }));
+    EXPECT_EQ(resource.reloads.load(), 1u);
+    EXPECT_EQ(resource.GetContent(), "second");
+    EXPECT_EQ(static_cast<TestResource &>(*untracked).reloads.load(), 0u);
+
+    // Failed reimport keeps previous content
+    ASSERT_TRUE(fs.WriteFile(path, MakeText("fail")));
+    EXPECT_EQ(manager.Reload({path}), 1u);
+
+    // Waits for reimport in flight
+    manager.Shutdown();
+    EXPECT_EQ(importer->imports.load(), 4u);
+    EXPECT_EQ(resource.reloads.load(), 1u);
+    EXPECT_EQ(dependantResource.dependencyReloads.load(), 1u);
+    EXPECT_EQ(resource.GetContent(), "second");
+
+    EXPECT_FALSE(manager.IsHotReloadEnabled());
+    EXPECT_EQ(manager.Reload({path}), 0u);
+}
+
+BRK_GTEST_MAIN
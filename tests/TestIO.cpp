@@ -29,9 +29,16 @@
 
 #include <core/io/ArgumentParser.hpp>
 #include <core/io/Logger.hpp>
+#include <core/string/StringName.hpp>
 #include <platform/Output.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 TEST(Berserk, ArgParser) {
     BRK_NS_USE;
@@ -66,6 +73,161 @@ TEST(Berserk, Logger) {
     BRK_INFO("Info about " << 10);
     BRK_WARNING("Warning for " << BRK_NS::String("str") << " " << BRK_TEXT("message"));
     BRK_ERROR("Error about " << 10.1f << " and " << 1);
+    BRK_NS::Logger::Instance().Flush();
+}
+
+TEST(Berserk, LoggerDeferredFormat) {
+    BRK_NS_USE;
+
+    Logger logger;
+    std::vector<Logger::Entry> entries;
+    logger.AddListener([&](const Logger::Entry &entry) { entries.push_back(entry); });
+
+    std::stringstream expected;
+    expected << "int " << -42 << " uint " << 42u << " size " << static_cast<size_t>(7) << " float " << 10.1f
+             << " double " << 0.125 << " bool " << true << " char " << 'c' << " " << String("string") << " " << StringName("name");
+
+    BRK_LOG_MESSAGE(logger, Logger::Level::Warning,
+                    "int " << -42 << " uint " << 42u << " size " << static_cast<size_t>(7) << " float " << 10.1f
+                           << " double " << 0.125 << " bool " << true << " char " << 'c' << " " << String("string") << " " << StringName("name"));
+    logger.LogError("dynamic", "Function", "File.cpp", 12);
+    logger.Flush();
+
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].message, expected.str());
+    EXPECT_EQ(entries[0].level, Logger::Level::Warning);
+    EXPECT_EQ(entries[0].file, String(__FILE__));
+    EXPECT_EQ(entries[1].message, "dynamic");
+    EXPECT_EQ(entries[1].function, "Function");
+    EXPECT_EQ(entries[1].file, "File.cpp");
+    EXPECT_EQ(entries[1].line, 12u);
+    EXPECT_EQ(entries[1].level, Logger::Level::Error);
+}
+
+TEST(Berserk, LoggerLazyThread) {
+    BRK_NS_USE;
+
+    Logger logger;
+    std::vector<Logger::Entry> entries;
+    logger.AddListener([&](const Logger::Entry &entry) { entries.push_back(entry); });
+
+    EXPECT_FALSE(logger.IsRunning());
+
+    BRK_LOG_MESSAGE(logger, Logger::Level::Info, "first");
+    EXPECT_TRUE(logger.IsRunning());
+
+    logger.Shutdown();
+    EXPECT_FALSE(logger.IsRunning());
+    ASSERT_EQ(entries.size(), 1u);
+
+    // Stopped logger is started again by next message
+    BRK_LOG_MESSAGE(logger, Logger::Level::Info, "second");
+    logger.Flush();
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[1].message, "second");
+}
+
+TEST(Berserk, LoggerListenerLogs) {
+    BRK_NS_USE;
+
+    Logger logger;
+    std::vector<String> messages;
+    std::mutex mutex;
+
+    // Listener is called on logger thread without lock, so it can log itself
+    logger.AddListener([&](const Logger::Entry &entry) {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            messages.push_back(entry.message);
+        }
+        if (entry.message == "outer") {
+            BRK_LOG_MESSAGE(logger, Logger::Level::Info, "nested");
+        }
+    });
+
+    BRK_LOG_MESSAGE(logger, Logger::Level::Info, "outer");
+    logger.Flush();
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        EXPECT_EQ(messages, std::vector<String>({"outer", "nested"}));
+    }
+
+    // Records left for shutdown are dispatched by calling thread
+    BRK_LOG_MESSAGE(logger, Logger::Level::Info, "outer");
+    logger.Shutdown();
+
+    std::lock_guard<std::mutex> guard(mutex);
+    EXPECT_EQ(messages.size(), 4u);
+}
+
+TEST(Berserk, LoggerThreadBuffers) {
+    BRK_NS_USE;
+
+    const uint32 threadsCount = 32;
+
+    Logger logger;
+    Logger other;
+    std::atomic<uint32> received{0};
+    logger.AddListener([&](const Logger::Entry &) { received.fetch_add(1); });
+
+    // Buffers of exited threads are released after their messages are dispatched
+    for (uint32 t = 0; t < threadsCount; t++) {
+        std::thread thread([&, t]() { BRK_LOG_MESSAGE(logger, Logger::Level::Info, "Thread " << t); });
+        thread.join();
+    }
+
+    logger.Flush();
+    EXPECT_EQ(received.load(), threadsCount);
+    EXPECT_EQ(logger.GetBuffersCount(), 0u);
+
+    // Thread logging to several loggers keeps single buffer per logger
+    for (uint32 i = 0; i < 100; i++) {
+        BRK_LOG_MESSAGE(logger, Logger::Level::Info, "Logger " << i);
+        BRK_LOG_MESSAGE(other, Logger::Level::Info, "Other " << i);
+    }
+
+    logger.Flush();
+    EXPECT_EQ(received.load(), threadsCount + 100);
+    EXPECT_EQ(logger.GetBuffersCount(), 1u);
+    EXPECT_EQ(other.GetBuffersCount(), 1u);
+}
+
+BRK_BENCHMARK(LoggerBenchmark) {
+    BRK_NS_USE;
+
+    const uint32 threadsCount = 8;
+    const uint32 messagesPerThread = 100000;
+
+    Logger logger;
+    std::atomic<uint64> received{0};
+    logger.AddListener([&](const Logger::Entry &) { received.fetch_add(1); });
+
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32 t = 0; t < threadsCount; t++) {
+        threads.emplace_back([&, t]() {
+            for (uint32 i = 0; i < messagesPerThread; i++)
+                BRK_LOG_MESSAGE(logger, Logger::Level::Info, "Worker " << t << " message " << i << " value " << 0.5f * static_cast<float>(i));
+        });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    auto logged = std::chrono::steady_clock::now();
+    logger.Flush();
+    auto flushed = std::chrono::steady_clock::now();
+
+    auto total = static_cast<uint64>(threadsCount) * messagesPerThread;
+    EXPECT_EQ(received.load(), total);
+
+    auto loggedSec = std::chrono::duration<double>(logged - start).count();
+    auto flushedSec = std::chrono::duration<double>(flushed - start).count();
+
+    std::cout << "Logger " << threadsCount << " threads: " << static_cast<uint64>(static_cast<double>(total) / loggedSec) << " calls/sec"
+              << " (dispatched " << static_cast<uint64>(static_cast<double>(total) / flushedSec) << " msg/sec, stalls " << logger.GetStallsCount() << ")" << std::endl;
 }
 
 TEST(Berserk, Output) {
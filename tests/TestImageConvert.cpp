@@ -0,0 +1,351 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/JobSystem.hpp>
+#include <core/image/ImageConvert.hpp>
+#include <core/image/ImageUtil.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/** Exact value of half float, used as reference */
+static double ReferenceHalf(uint16 h) {
+    int exp = (h >> 10u) & 0x1f;
+    int mantissa = h & 0x3ff;
+    double sign = (h & 0x8000u) ? -1.0 : 1.0;
+
+    if (exp == 0x1f)
+        return mantissa ? NAN : sign * INFINITY;
+    if (exp == 0)
+        return sign * std::ldexp(mantissa, -24);
+    return sign * std::ldexp(mantissa + 1024, exp - 25);
+}
+
+static float ReferenceSrgbToLinear(uint8 c) {
+    double v = c / 255.0;
+    return static_cast<float>(v <= 0.04045 ? v / 12.92 : std::pow((v + 0.055) / 1.055, 2.4));
+}
+
+static int ReferenceLinearToSrgb(float l) {
+    double v = std::min(std::max(static_cast<double>(l), 0.0), 1.0);
+    double c = v <= 0.0031308 ? v * 12.92 : 1.055 * std::pow(v, 1.0 / 2.4) - 0.055;
+    return static_cast<int>(c * 255.0 + 0.5);
+}
+
+static Image RandomImage(uint32 width, uint32 height, Image::Format format, uint32 seed) {
+    Image image(width, height, format);
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<uint32> distribution(0, 255);
+    auto p = static_cast<uint8 *>(image.GetPixelData()->GetDataWrite());
+    for (uint32 i = 0; i < image.GetSizeBytes(); i++)
+        p[i] = static_cast<uint8>(distribution(engine));
+    return image;
+}
+
+static Image RandomFloatImage(uint32 width, uint32 height, Image::Format format, uint32 seed) {
+    Image image(width, height, format);
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> distribution(-0.25f, 1.25f);
+    auto p = static_cast<float *>(image.GetPixelData()->GetDataWrite());
+    for (uint32 i = 0; i < image.GetSizeBytes() / sizeof(float); i++)
+        p[i] = distribution(engine);
+    return image;
+}
+
+static bool SamePixels(const Image &a, const Image &b) {
+    return a.GetFormat() == b.GetFormat() && a.GetSizeBytes() == b.GetSizeBytes() &&
+           std::memcmp(a.GetPixelData()->GetData(), b.GetPixelData()->GetData(), a.GetSizeBytes()) == 0;
+}
+
+/** Prints throughput of conversion in MB/s of source pixels */
+static void BenchmarkConvert(const char *name, const Image &image, Image::Format format, JobSystem *jobSystem) {
+    const uint32 iterations = 8;
+    Image result;
+
+    auto ms = MeasureMs([&]() {
+        for (uint32 i = 0; i < iterations; i++)
+            result = ImageConvert::Convert(image, format, jobSystem);
+    });
+
+    auto mbs = static_cast<double>(image.GetSizeBytes()) * iterations / (ms * 1e3);
+    std::cout << "  " << name << (jobSystem ? " (parallel)" : " (serial)") << ": " << mbs << " MB/s" << std::endl;
+}
+
+BRK_NS_END
+
+TEST(Berserk, ImageConvertPixelSize) {
+    BRK_NS_USE;
+
+    EXPECT_EQ(ImageUtil::GetPixelSize(Image::Format::R16F), 2u);
+    EXPECT_EQ(ImageUtil::GetPixelSize(Image::Format::RG16F), 4u);
+    EXPECT_EQ(ImageUtil::GetPixelSize(Image::Format::RGB16F), 6u);
+    EXPECT_EQ(ImageUtil::GetPixelSize(Image::Format::RGBA16F), 8u);
+
+    Image image(3, 2, Image::Format::RGBA16F);
+    EXPECT_FALSE(image.Empty());
+    EXPECT_EQ(image.GetStride(), 24u);
+}
+
+TEST(Berserk, ImageConvertHalfToFloat) {
+    BRK_NS_USE;
+
+    std::vector<uint16> halfs(65536);
+    std::vector<float> floats(halfs.size());
+    std::vector<uint16> back(halfs.size());
+
+    for (uint32 i = 0; i < 65536; i++)
+        halfs[i] = static_cast<uint16>(i);
+
+    ImageConvert::HalfToFloat(halfs.data(), floats.data(), halfs.size());
+    ImageConvert::FloatToHalf(floats.data(), back.data(), floats.size());
+
+    for (uint32 i = 0; i < 65536; i++) {
+        auto expected = ReferenceHalf(halfs[i]);
+
+        if (std::isnan(expected)) {
+            EXPECT_TRUE(std::isnan(floats[i]));
+            EXPECT_EQ(back[i] & 0x7c00u, 0x7c00u);
+            EXPECT_NE(back[i] & 0x3ffu, 0u);
+        } else {
+            EXPECT_EQ(static_cast<double>(floats[i]), expected);
+            EXPECT_EQ(back[i], halfs[i]);
+        }
+    }
+}
+
+TEST(Berserk, ImageConvertFloatToHalfRounding) {
+    BRK_NS_USE;
+
+    std::vector<float> floats;
+    std::vector<uint16> expected;
+
+    // Midpoints between neighbour halfs round to even, values next to midpoints round to nearest
+    for (uint32 h = 0; h < 0x7bff; h++) {
+        auto a = static_cast<float>(ReferenceHalf(static_cast<uint16>(h)));
+        auto b = static_cast<float>(ReferenceHalf(static_cast<uint16>(h + 1)));
+        auto mid = (a + b) * 0.5f;
+
+        for (float sign : {1.0f, -1.0f}) {
+            auto signBit = static_cast<uint16>(sign < 0.0f ? 0x8000u : 0u);
+            floats.push_back(sign * mid);
+            expected.push_back(static_cast<uint16>(((h & 1u) ? h + 1 : h) | signBit));
+            floats.push_back(sign * std::nextafter(mid, 0.0f));
+            expected.push_back(static_cast<uint16>(h | signBit));
+            floats.push_back(sign * std::nextafter(mid, 1e6f));
+            expected.push_back(static_cast<uint16>((h + 1) | signBit));
+        }
+    }
+
+    const float edges[] = {65504.0f, 65519.99f, 65520.0f, 1e10f, INFINITY, -INFINITY, 1e-10f, 0.0f, -0.0f, 5.9604645e-8f, 2.9802322e-8f};
+    const uint16 edgesExpected[] = {0x7bff, 0x7bff, 0x7c00, 0x7c00, 0x7c00, 0xfc00, 0x0000, 0x0000, 0x8000, 0x0001, 0x0000};
+
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+        floats.push_back(edges[i]);
+        expected.push_back(edgesExpected[i]);
+    }
+
+    std::vector<uint16> halfs(floats.size());
+    ImageConvert::FloatToHalf(floats.data(), halfs.data(), floats.size());
+
+    uint32 mismatches = 0;
+    for (size_t i = 0; i < floats.size(); i++)
+        mismatches += halfs[i] != expected[i] ? 1 : 0;
+    EXPECT_EQ(mismatches, 0u);
+
+    // Tails shorter than vector width use scalar code
+    for (size_t offset = 0; offset < 9; offset++) {
+        std::vector<uint16> tail(floats.size() - offset);
+        ImageConvert::FloatToHalf(floats.data() + offset, tail.data(), tail.size());
+        EXPECT_EQ(std::memcmp(tail.data(), halfs.data() + offset, tail.size() * sizeof(uint16)), 0);
+    }
+}
+
+TEST(Berserk, ImageConvertSrgb) {
+    BRK_NS_USE;
+
+    std::vector<uint8> codes(256);
+    std::vector<float> linear(256);
+    std::vector<uint8> back(256);
+
+    for (uint32 i = 0; i < 256; i++)
+        codes[i] = static_cast<uint8>(i);
+
+    ImageConvert::SrgbToLinear(codes.data(), linear.data(), codes.size());
+    ImageConvert::LinearToSrgb(linear.data(), back.data(), linear.size());
+
+    for (uint32 i = 0; i < 256; i++) {
+        EXPECT_NEAR(linear[i], ReferenceSrgbToLinear(codes[i]), 1e-6f);
+        EXPECT_EQ(back[i], codes[i]);
+    }
+
+    std::vector<float> values;
+    for (uint32 i = 0; i <= 100000; i++)
+        values.push_back(static_cast<float>(i) / 100000.0f);
+    values.push_back(-1.0f);
+    values.push_back(2.0f);
+    values.push_back(NAN);
+
+    std::vector<uint8> encoded(values.size());
+    ImageConvert::LinearToSrgb(values.data(), encoded.data(), values.size());
+
+    for (size_t i = 0; i < values.size(); i++) {
+        auto expected = std::isnan(values[i]) ? 0 : ReferenceLinearToSrgb(values[i]);
+        EXPECT_LE(std::abs(static_cast<int>(encoded[i]) - expected), 1);
+    }
+}
+
+TEST(Berserk, ImageConvertExpandReduce) {
+    BRK_NS_USE;
+
+    for (uint32 count : {0u, 1u, 5u, 6u, 7u, 16u, 33u, 1001u}) {
+        std::vector<uint8> rgb(count * 3);
+        std::vector<uint8> rgba(count * 4 + 16, 0xcd);
+        std::vector<uint8> reduced(count * 3 + 16, 0xcd);
+
+        for (uint32 i = 0; i < rgb.size(); i++)
+            rgb[i] = static_cast<uint8>(i * 7 + count);
+
+        ImageConvert::Expand3To4(rgb.data(), rgba.data(), count, 0x80);
+        ImageConvert::Reduce4To3(rgba.data(), reduced.data(), count);
+
+        for (uint32 i = 0; i < count; i++) {
+            EXPECT_EQ(rgba[i * 4 + 0], rgb[i * 3 + 0]);
+            EXPECT_EQ(rgba[i * 4 + 1], rgb[i * 3 + 1]);
+            EXPECT_EQ(rgba[i * 4 + 2], rgb[i * 3 + 2]);
+            EXPECT_EQ(rgba[i * 4 + 3], 0x80);
+        }
+
+        // Nothing is written past the end
+        EXPECT_EQ(rgba[count * 4], 0xcd);
+        EXPECT_EQ(reduced[count * 3], 0xcd);
+        EXPECT_EQ(std::memcmp(reduced.data(), rgb.data(), rgb.size()), 0);
+    }
+}
+
+TEST(Berserk, ImageConvertFormats) {
+    BRK_NS_USE;
+
+    EXPECT_TRUE(ImageConvert::CanConvert(Image::Format::RGB8, Image::Format::RGBA16F));
+    EXPECT_FALSE(ImageConvert::CanConvert(Image::Format::RGB8, Image::Format::DEPTH32F));
+    EXPECT_TRUE(ImageConvert::GetUploadFormat(Image::Format::RGB8) == Image::Format::RGBA8);
+    EXPECT_TRUE(ImageConvert::GetUploadFormat(Image::Format::SRGB8) == Image::Format::SRGB8_ALPHA8);
+    EXPECT_TRUE(ImageConvert::GetUploadFormat(Image::Format::R8) == Image::Format::R8);
+
+    auto r8 = RandomImage(17, 5, Image::Format::R8, 1);
+    auto rgba32f = ImageConvert::Convert(r8, Image::Format::RGBA32F);
+    ASSERT_TRUE(rgba32f.GetFormat() == Image::Format::RGBA32F);
+    ASSERT_EQ(rgba32f.GetPixelSize(), 16u);
+
+    auto src = static_cast<const uint8 *>(r8.GetPixelData()->GetData());
+    auto dst = static_cast<const float *>(rgba32f.GetPixelData()->GetData());
+    for (uint32 i = 0; i < 17 * 5; i++) {
+        EXPECT_FLOAT_EQ(dst[i * 4 + 0], src[i] / 255.0f);
+        EXPECT_EQ(dst[i * 4 + 1], 0.0f);
+        EXPECT_EQ(dst[i * 4 + 2], 0.0f);
+        EXPECT_EQ(dst[i * 4 + 3], 1.0f);
+    }
+
+    // Values survive round trip through wider formats
+    auto rgba8 = RandomImage(300, 7, Image::Format::RGBA8, 2);
+    auto srgb = RandomImage(300, 7, Image::Format::SRGB8_ALPHA8, 3);
+    auto rgba16 = RandomImage(300, 7, Image::Format::RGBA16, 4);
+    EXPECT_TRUE(SamePixels(ImageConvert::Convert(ImageConvert::Convert(rgba8, Image::Format::RGBA16F), Image::Format::RGBA8), rgba8));
+    EXPECT_TRUE(SamePixels(ImageConvert::Convert(ImageConvert::Convert(srgb, Image::Format::RGBA32F), Image::Format::SRGB8_ALPHA8), srgb));
+    EXPECT_TRUE(SamePixels(ImageConvert::Convert(ImageConvert::Convert(rgba16, Image::Format::RGBA32F), Image::Format::RGBA16), rgba16));
+    EXPECT_TRUE(SamePixels(ImageConvert::Convert(ImageConvert::Convert(rgba8, Image::Format::RGB8), Image::Format::RGBA8),
+                           ImageConvert::Convert(ImageConvert::Convert(rgba8, Image::Format::RGB32F), Image::Format::RGBA8)));
+
+    // Out of range floats are clamped
+    auto floats = RandomFloatImage(64, 3, Image::Format::RGBA32F, 5);
+    auto unorm = ImageConvert::Convert(floats, Image::Format::RGBA8);
+    auto f = static_cast<const float *>(floats.GetPixelData()->GetData());
+    auto u = static_cast<const uint8 *>(unorm.GetPixelData()->GetData());
+    for (uint32 i = 0; i < 64 * 3 * 4; i++)
+        EXPECT_EQ(u[i], static_cast<uint8>(std::min(std::max(f[i], 0.0f), 1.0f) * 255.0f + 0.5f));
+
+    EXPECT_TRUE(ImageConvert::Convert(r8, Image::Format::DEPTH24_STENCIL8).Empty());
+}
+
+TEST(Berserk, ImageConvertSwizzle) {
+    BRK_NS_USE;
+
+    auto rgba = RandomImage(9, 4, Image::Format::RGBA8, 6);
+    auto bgra = ImageConvert::Swizzle(rgba, {2, 1, 0, 3});
+    auto back = ImageConvert::Swizzle(bgra, {2, 1, 0, 3});
+
+    auto s = static_cast<const uint8 *>(rgba.GetPixelData()->GetData());
+    auto d = static_cast<const uint8 *>(bgra.GetPixelData()->GetData());
+    for (uint32 i = 0; i < 9 * 4; i++) {
+        EXPECT_EQ(d[i * 4 + 0], s[i * 4 + 2]);
+        EXPECT_EQ(d[i * 4 + 1], s[i * 4 + 1]);
+        EXPECT_EQ(d[i * 4 + 2], s[i * 4 + 0]);
+        EXPECT_EQ(d[i * 4 + 3], s[i * 4 + 3]);
+    }
+    EXPECT_TRUE(SamePixels(back, rgba));
+
+    auto rgb32f = RandomFloatImage(5, 5, Image::Format::RGB32F, 7);
+    EXPECT_TRUE(SamePixels(ImageConvert::Swizzle(ImageConvert::Swizzle(rgb32f, {1, 2, 0, 0}), {2, 0, 1, 0}), rgb32f));
+    EXPECT_TRUE(ImageConvert::Swizzle(rgb32f, {0, 1, 3, 0}).Empty());
+}
+
+TEST(Berserk, ImageConvertParallel) {
+    BRK_NS_USE;
+
+    JobSystem jobSystem;
+    auto rgb = RandomImage(517, 389, Image::Format::RGB8, 8);
+    auto floats = RandomFloatImage(517, 389, Image::Format::RGBA32F, 9);
+
+    EXPECT_TRUE(SamePixels(ImageConvert::Convert(rgb, Image::Format::RGBA8, &jobSystem), ImageConvert::Convert(rgb, Image::Format::RGBA8)));
+    EXPECT_TRUE(SamePixels(ImageConvert::Convert(floats, Image::Format::RGBA16F, &jobSystem), ImageConvert::Convert(floats, Image::Format::RGBA16F)));
+    EXPECT_TRUE(SamePixels(ImageConvert::Swizzle(rgb, {2, 1, 0, 0}, &jobSystem), ImageConvert::Swizzle(rgb, {2, 1, 0, 0})));
+}
+
+BRK_BENCHMARK(ImageConvertBenchmark) {
+    BRK_NS_USE;
+
+    JobSystem jobSystem;
+    auto rgb = RandomImage(2048, 2048, Image::Format::RGB8, 10);
+    auto srgb = RandomImage(2048, 2048, Image::Format::SRGB8, 11);
+    auto floats = RandomFloatImage(2048, 2048, Image::Format::RGBA32F, 12);
+
+    std::cout << "Half hardware: " << (ImageConvert::IsHalfHardwareAccelerated() ? "yes" : "no") << std::endl;
+    std::cout << "Convert 2048x2048:" << std::endl;
+    for (auto js : {static_cast<JobSystem *>(nullptr), &jobSystem}) {
+        BenchmarkConvert("RGB8 -> RGBA8", rgb, Image::Format::RGBA8, js);
+        BenchmarkConvert("RGBA32F -> RGBA16F", floats, Image::Format::RGBA16F, js);
+        BenchmarkConvert("SRGB8 -> RGBA16F", srgb, Image::Format::RGBA16F, js);
+    }
+}
+
+BRK_GTEST_MAIN
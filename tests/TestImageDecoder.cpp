@@ -0,0 +1,225 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/JobSystem.hpp>
+#include <core/image/ImageDecoder.hpp>
+#include <platform/FileSystem.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/** Image with smooth gradients and some noise, so it compresses like a real texture */
+static Image MakeTestImage(uint32 width, uint32 height, uint32 seed) {
+    Image image(width, height, Image::Format::RGBA8);
+    std::mt19937 engine(seed);
+    auto p = static_cast<uint8 *>(image.GetPixelData()->GetDataWrite());
+
+    for (uint32 y = 0; y < height; y++) {
+        for (uint32 x = 0; x < width; x++) {
+            auto pixel = p + (static_cast<size_t>(y) * width + x) * 4;
+            pixel[0] = static_cast<uint8>((x * 255) / width + (engine() & 7u));
+            pixel[1] = static_cast<uint8>((y * 255) / height + (engine() & 7u));
+            pixel[2] = static_cast<uint8>(((x + y) * 127) / (width + height) + seed);
+            pixel[3] = 255;
+        }
+    }
+
+    return image;
+}
+
+static std::vector<String> WriteTestImages(const String &dir, uint32 count, uint32 size) {
+    std::vector<String> files;
+
+    for (uint32 i = 0; i < count; i++) {
+        auto jpg = (i % 2) == 1;
+        auto filepath = dir + "/image" + std::to_string(i) + (jpg ? ".jpg" : ".png");
+        EXPECT_TRUE(MakeTestImage(size, size, i).SaveRgba(filepath, jpg ? Image::FileFormat::Jpg : Image::FileFormat::Png, 90));
+        files.push_back(filepath);
+    }
+
+    return files;
+}
+
+static bool SamePixels(const Image &a, const Image &b) {
+    return !a.Empty() && a.GetFormat() == b.GetFormat() && a.GetSizeBytes() == b.GetSizeBytes() &&
+           std::memcmp(a.GetPixelData()->GetData(), b.GetPixelData()->GetData(), a.GetSizeBytes()) == 0;
+}
+
+BRK_NS_END
+
+TEST(Berserk, ImageDecoderMemory) {
+    BRK_NS_USE;
+
+    TestTempDir temp("image-decoder");
+    FileSystem fs;
+    auto files = WriteTestImages(temp.GetPath(), 2, 67);
+
+    for (auto &file : files) {
+        auto encoded = fs.ReadFile(file);
+        ASSERT_TRUE(encoded.IsNotNull());
+
+        for (uint32 channels = 1; channels <= 4; channels++) {
+            auto loaded = Image::LoadRgba(file, channels);
+            auto decoded = Image::DecodeRgba(encoded->GetData(), encoded->GetSize(), channels);
+
+            EXPECT_TRUE(SamePixels(loaded, decoded));
+            EXPECT_EQ(decoded.GetWidth(), 67u);
+            EXPECT_EQ(decoded.GetPixelSize(), channels);
+
+            // Pixels are owned by image data without copy and can be modified
+            EXPECT_NE(decoded.GetPixelData()->GetDataWrite(), nullptr);
+        }
+    }
+
+    const char garbage[] = "not an image";
+    EXPECT_TRUE(Image::DecodeRgba(garbage, sizeof(garbage)).Empty());
+}
+
+TEST(Berserk, ImageDecoderService) {
+    BRK_NS_USE;
+
+    TestTempDir temp("image-decoder-service");
+    FileSystem fs;
+    JobSystem jobSystem;
+    auto files = WriteTestImages(temp.GetPath(), 8, 129);
+
+    ImageDecoder decoder(jobSystem);
+    EXPECT_EQ(decoder.Submit(ImageDecoder::Request()), static_cast<ImageDecoder::Handle>(ImageDecoder::INVALID_HANDLE));
+
+    std::vector<ImageDecoder::Request> requests;
+    for (size_t i = 0; i < files.size(); i++) {
+        ImageDecoder::Request request;
+        request.filepath = files[i];
+        if (i % 3 == 0)
+            request.encoded = fs.ReadFile(files[i]);
+        requests.push_back(std::move(request));
+    }
+
+    std::vector<ImageDecoder::Handle> handles;
+    decoder.SubmitBatch(requests, handles);
+    ASSERT_EQ(handles.size(), files.size());
+
+    for (size_t i = 0; i < files.size(); i++) {
+        ImageDecoder::Result result;
+        EXPECT_TRUE(decoder.Wait(handles[i], result));
+        EXPECT_EQ(result.handle, handles[i]);
+        EXPECT_TRUE(SamePixels(result.image, Image::LoadRgba(files[i])));
+        EXPECT_FALSE(decoder.Wait(handles[i], result));
+    }
+
+    std::atomic<uint32> decoded{0};
+    for (auto &file : files) {
+        ImageDecoder::Request request;
+        request.filepath = file;
+        request.channels = 3;
+        request.callback = [&](ImageDecoder::Result &result) {
+            if (result.image.GetFormat() == Image::Format::RGB8)
+                decoded.fetch_add(1);
+        };
+        decoder.Submit(std::move(request));
+    }
+
+    decoder.WaitIdle();
+    EXPECT_EQ(decoded.load(), files.size());
+    EXPECT_EQ(decoder.GetPendingCount(), 0u);
+
+    ImageDecoder::Request missing;
+    missing.filepath = temp.GetPath() + "/missing.png";
+    ImageDecoder::Result result;
+    EXPECT_TRUE(decoder.Wait(decoder.Submit(std::move(missing)), result));
+    EXPECT_TRUE(result.image.Empty());
+}
+
+TEST(Berserk, ImageDecoderWaitInJob) {
+    BRK_NS_USE;
+
+    TestTempDir temp("image-decoder-job");
+    JobSystem jobSystem(1);
+    auto files = WriteTestImages(temp.GetPath(), 2, 33);
+
+    ImageDecoder decoder(jobSystem);
+    std::atomic<bool> done{false};
+    std::atomic<bool> decoded{false};
+
+    // Only worker is busy with this job, so waited request is decoded inline
+    jobSystem.Submit([&]() {
+        ImageDecoder::Request request;
+        request.filepath = files[0];
+        ImageDecoder::Result result;
+        decoder.Wait(decoder.Submit(std::move(request)), result);
+        decoded.store(!result.image.Empty());
+        done.store(true);
+    });
+
+    while (!done.load())
+        std::this_thread::yield();
+
+    EXPECT_TRUE(decoded.load());
+}
+
+BRK_BENCHMARK(ImageDecoderBenchmark) {
+    BRK_NS_USE;
+
+    TestTempDir temp("image-decoder-bench");
+    JobSystem jobSystem;
+    auto files = WriteTestImages(temp.GetPath(), 8, 1024);
+
+    auto serialMs = MeasureMs([&]() {
+        for (auto &file : files)
+            EXPECT_FALSE(Image::LoadRgba(file).Empty());
+    });
+
+    ImageDecoder decoder(jobSystem);
+    auto serviceMs = MeasureMs([&]() {
+        std::vector<ImageDecoder::Request> requests(files.size());
+        std::vector<ImageDecoder::Handle> handles;
+        for (size_t i = 0; i < files.size(); i++)
+            requests[i].filepath = files[i];
+
+        decoder.SubmitBatch(requests, handles);
+
+        for (auto handle : handles) {
+            ImageDecoder::Result result;
+            EXPECT_TRUE(decoder.Wait(handle, result));
+            EXPECT_FALSE(result.image.Empty());
+        }
+    });
+
+    std::cout << "Decode 8 images 1024x1024 (png and jpg), " << jobSystem.GetWorkersCount() << " workers:" << std::endl;
+    std::cout << "  serial: " << serialMs << " ms" << std::endl;
+    std::cout << "  decoder: " << serviceMs << " ms" << std::endl;
+}
+
+BRK_GTEST_MAIN
@@ -0,0 +1,242 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+
+#include <Testing.hpp>
+
+#include <render/material/Material.hpp>
+#include <render/material/MaterialInstance.hpp>
+#include <render/material/MaterialInstancePool.hpp>
+#include <render/shader/Shader.hpp>
+#include <render/shader/ShaderPass.hpp>
+#include <render/shader/ShaderTechnique.hpp>
+#include <resource/ResMaterial.hpp>
+
+#include <vector>
+
+BRK_NS_BEGIN
+
+static ShaderParam MakeParam(const char *name, RHIShaderDataType type, uint32 arraySize = 1) {
+    ShaderParam param;
+    param.name = StringName(name);
+    param.type = ShaderParamType::Data;
+    param.typeData = type;
+    param.arraySize = arraySize;
+    return param;
+}
+
+// Shader with params and single not compiled pass, so materials never touch rhi
+static Ref<Shader> MakeShader() {
+    std::vector<ShaderParam> params;
+    params.push_back(MakeParam("pRoughness", RHIShaderDataType::Float1));
+    params.push_back(MakeParam("pColor", RHIShaderDataType::Float3));
+    params.push_back(MakeParam("pWeights", RHIShaderDataType::Float1, 4));
+    params.push_back(MakeParam("pOffset", RHIShaderDataType::Float2));
+
+    Ref<Shader> shader(new Shader());
+    Ref<ShaderTechnique> technique(new ShaderTechnique());
+    Ref<ShaderPass> pass(new ShaderPass());
+
+    pass->SetName(StringName("forward"));
+    pass->SetTechnique(technique.Get());
+    technique->SetName(StringName("default"));
+    technique->SetPasses({pass});
+    technique->SetShader(shader.Get());
+    shader->SetName(StringName("test-material-instance"));
+    shader->SetTechniques({technique});
+    shader->SetParams(Ref<ShaderParams>(new ShaderParams(std::move(params))));
+
+    return shader;
+}
+
+static float GetFloat(const Ref<Material> &material, const StringName &name, uint32 arrayIndex = 0) {
+    const auto *data = material->GetParamData(material->GetParamHandle(name), arrayIndex);
+    return data ? *reinterpret_cast<const float *>(data) : -1.0f;
+}
+
+static Vec3f GetFloat3(const Ref<Material> &material, const StringName &name) {
+    const auto *data = material->GetParamData(material->GetParamHandle(name));
+    return data ? *reinterpret_cast<const Vec3f *>(data) : Vec3f();
+}
+
+BRK_NS_END
+
+TEST(Berserk, MaterialInstanceFallback) {
+    BRK_NS_USE;
+
+    StringName pRoughness("pRoughness");
+    StringName pColor("pColor");
+
+    Ref<Material> parent(new Material(MakeShader().As<const Shader>()));
+    parent->SetFloat1(pRoughness, 0.5f);
+    parent->SetFloat3(pColor, Vec3f(1, 2, 3));
+
+    Ref<MaterialInstancePool> pool(new MaterialInstancePool(parent));
+    auto instance = pool->CreateInstance();
+    instance->UpdatePack();
+
+    EXPECT_EQ(instance->GetMaterial(), parent);
+    EXPECT_EQ(instance->GetOverridesCount(), 0u);
+    EXPECT_EQ(pool->GetSharedCount(), 0u);
+    EXPECT_FALSE(instance->IsReady());
+}
+
+TEST(Berserk, MaterialInstanceOverride) {
+    BRK_NS_USE;
+
+    StringName pRoughness("pRoughness");
+    StringName pColor("pColor");
+    StringName pWeights("pWeights");
+
+    Ref<Material> parent(new Material(MakeShader().As<const Shader>()));
+    parent->SetFloat1(pRoughness, 0.5f);
+    parent->SetFloat3(pColor, Vec3f(1, 2, 3));
+    parent->SetFloat1(pWeights, 0.25f, 2);
+
+    Ref<MaterialInstancePool> pool(new MaterialInstancePool(parent));
+    auto instance = pool->CreateInstance();
+    instance->SetFloat1(instance->GetParamHandle(pRoughness), 0.9f);
+    instance->SetFloat1(instance->GetParamHandle(pWeights), 0.75f, 1);
+    instance->UpdatePack();
+
+    auto material = instance->GetMaterial();
+    ASSERT_TRUE(material.IsNotNull());
+    EXPECT_NE(material, parent);
+    EXPECT_EQ(instance->GetOverridesCount(), 2u);
+    EXPECT_EQ(pool->GetSharedCount(), 1u);
+
+    // Overridden params take instance values, others fall back to the parent
+    EXPECT_EQ(GetFloat(material, pRoughness), 0.9f);
+    EXPECT_EQ(GetFloat(material, pWeights, 1), 0.75f);
+    EXPECT_EQ(GetFloat(material, pWeights, 2), 0.25f);
+    EXPECT_EQ(GetFloat3(material, pColor), Vec3f(1, 2, 3));
+
+    // Parent is not modified by instance overrides
+    EXPECT_EQ(GetFloat(parent, pRoughness), 0.5f);
+    EXPECT_EQ(GetFloat(parent, pWeights, 1), 0.0f);
+
+    // Parent changes reach shared material, overrides stay on top
+    parent->SetFloat3(pColor, Vec3f(4, 5, 6));
+    parent->SetFloat1(pRoughness, 0.1f);
+    instance->UpdatePack();
+
+    EXPECT_EQ(GetFloat3(material, pColor), Vec3f(4, 5, 6));
+    EXPECT_EQ(GetFloat(material, pRoughness), 0.9f);
+
+    // Without overrides instance falls back to the parent and shared material is released
+    instance->ResetOverrides();
+    instance->UpdatePack();
+
+    EXPECT_EQ(instance->GetMaterial(), parent);
+    EXPECT_EQ(pool->GetSharedCount(), 0u);
+}
+
+TEST(Berserk, MaterialInstanceSharing) {
+    BRK_NS_USE;
+
+    StringName pRoughness("pRoughness");
+
+    Ref<Material> parent(new Material(MakeShader().As<const Shader>()));
+    Ref<MaterialInstancePool> pool(new MaterialInstancePool(parent));
+    auto handle = parent->GetParamHandle(pRoughness);
+
+    auto a = pool->CreateInstance();
+    auto b = pool->CreateInstance();
+    auto c = pool->CreateInstance();
+
+    a->SetFloat1(handle, 0.3f);
+    b->SetFloat1(handle, 0.3f);
+    c->SetFloat1(handle, 0.7f);
+    a->UpdatePack();
+    b->UpdatePack();
+    c->UpdatePack();
+
+    EXPECT_EQ(a->GetMaterial(), b->GetMaterial());
+    EXPECT_NE(a->GetMaterial(), c->GetMaterial());
+    EXPECT_EQ(pool->GetSharedCount(), 2u);
+    EXPECT_EQ(pool->GetInstancesCount(), 3u);
+
+    c.Reset();
+    EXPECT_EQ(pool->GetSharedCount(), 1u);
+    EXPECT_EQ(pool->GetInstancesCount(), 2u);
+}
+
+TEST(Berserk, MaterialInstancePerInstanceParams) {
+    BRK_NS_USE;
+
+    StringName pRoughness("pRoughness");
+    StringName pOffset("pOffset");
+
+    Ref<Material> parent(new Material(MakeShader().As<const Shader>()));
+    parent->SetFloat2(pOffset, Vec2f(1, 1));
+
+    auto offset = parent->GetParamHandle(pOffset);
+    Ref<MaterialInstancePool> pool(new MaterialInstancePool(parent, {offset}));
+
+    EXPECT_TRUE(pool->IsPerInstance(offset));
+    EXPECT_FALSE(pool->IsPerInstance(parent->GetParamHandle(pRoughness)));
+    EXPECT_EQ(pool->GetInstanceStride(), static_cast<uint32>(sizeof(Vec2f)));
+
+    auto a = pool->CreateInstance();
+    auto b = pool->CreateInstance();
+    a->SetFloat2(offset, Vec2f(2, 3));
+    a->UpdatePack();
+    b->UpdatePack();
+
+    // Per-instance params never create shared materials
+    EXPECT_EQ(a->GetMaterial(), parent);
+    EXPECT_EQ(pool->GetSharedCount(), 0u);
+    EXPECT_EQ(*reinterpret_cast<const Vec2f *>(a->GetInstanceData()), Vec2f(2, 3));
+    EXPECT_EQ(*reinterpret_cast<const Vec2f *>(b->GetInstanceData()), Vec2f(1, 1));
+}
+
+TEST(Berserk, MaterialInstanceResource) {
+    BRK_NS_USE;
+
+    StringName pRoughness("pRoughness");
+
+    Ref<ResMaterial> resource(new ResMaterial());
+    EXPECT_TRUE(resource->CreateInstance().IsNull());
+
+    resource->SetMaterial(Ref<Material>(new Material(MakeShader().As<const Shader>())));
+
+    auto a = resource->CreateInstance();
+    auto b = resource->CreateInstance();
+    ASSERT_TRUE(a.IsNotNull());
+    ASSERT_TRUE(b.IsNotNull());
+    EXPECT_EQ(a->GetPool(), b->GetPool());
+    EXPECT_EQ(a->GetParent(), resource->GetMaterial());
+
+    a->SetFloat1(a->GetParamHandle(pRoughness), 0.4f);
+    a->UpdatePack();
+    b->UpdatePack();
+
+    EXPECT_EQ(GetFloat(a->GetMaterial(), pRoughness), 0.4f);
+    EXPECT_EQ(GetFloat(b->GetMaterial(), pRoughness), 0.0f);
+}
+
+BRK_GTEST_MAIN
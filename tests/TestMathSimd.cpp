@@ -0,0 +1,341 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/math/MathUtils3d.hpp>
+#include <core/math/TQuat.hpp>
+#include <core/math/Transformf.hpp>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/** Generic (scalar) implementations, as used by templates for other types */
+struct Generic {
+    static Mat4x4f Multiply(const Mat4x4f &a, const Mat4x4f &b) {
+        Mat4x4f r;
+        for (uint32 i = 0; i < 4; i++) {
+            for (uint32 j = 0; j < 4; j++) {
+                float v = 0;
+                for (uint32 f = 0; f < 4; f++)
+                    v += a.values[i * 4 + f] * b.values[f * 4 + j];
+                r.values[i * 4 + j] = v;
+            }
+        }
+        return r;
+    }
+
+    static Vec4f Multiply(const Mat4x4f &m, const Vec4f &v) {
+        Vec4f r;
+        for (uint32 i = 0; i < 4; i++)
+            for (uint32 j = 0; j < 4; j++)
+                r.values[i] += m.values[i * 4 + j] * v.values[j];
+        return r;
+    }
+
+    static Mat4x4f Transpose(const Mat4x4f &m) {
+        Mat4x4f r;
+        for (uint32 i = 0; i < 4; i++)
+            for (uint32 j = 0; j < 4; j++)
+                r.values[j * 4 + i] = m.values[i * 4 + j];
+        return r;
+    }
+
+    static float Dot(const Vec3f &a, const Vec3f &b) {
+        float r = 0;
+        for (uint32 i = 0; i < 3; i++)
+            r += a.values[i] * b.values[i];
+        return r;
+    }
+
+    static Vec3f Cross(const Vec3f &a, const Vec3f &b) {
+        return Vec3f(a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]);
+    }
+
+    static Quatf Multiply(const Quatf &a, const Quatf &b) {
+        Vec3f v = b.vec;
+        Vec3f av = a.vec;
+        Vec3f t;
+        for (uint32 i = 0; i < 3; i++)
+            t.values[i] = v.values[i] * a.scalar + av.values[i] * b.scalar;
+        return Quatf(a.scalar * b.scalar - Dot(av, v), t + Cross(av, v));
+    }
+
+    static Vec3f TransformPoint(const Mat4x4f &m, const Vec3f &p) {
+        return Vec3f(Multiply(m, Vec4f(p, 1.0f)));
+    }
+};
+
+static const float TOLERANCE = 1e-4f;
+
+static float RandomFloat(std::mt19937 &engine) {
+    return std::uniform_real_distribution<float>(-2.0f, 2.0f)(engine);
+}
+
+static Mat4x4f RandomMatrix(std::mt19937 &engine) {
+    Mat4x4f m;
+    for (auto &v : m.values)
+        v = RandomFloat(engine);
+    return m;
+}
+
+static void ExpectNear(const float *a, const float *b, uint32 count, float tolerance = TOLERANCE) {
+    for (uint32 i = 0; i < count; i++)
+        EXPECT_NEAR(a[i], b[i], tolerance);
+}
+
+static void Report(const char *name, double genericMs, double simdMs) {
+    std::cout << " " << name << ": generic " << genericMs << " ms, simd " << simdMs << " ms, speedup x" << (simdMs > 0.0 ? genericMs / simdMs : 0.0) << std::endl;
+}
+
+BRK_NS_END
+
+TEST(Berserk, MathSimdMatrix) {
+    BRK_NS_USE;
+
+    std::mt19937 engine(1);
+
+    for (uint32 i = 0; i < 1000; i++) {
+        auto a = RandomMatrix(engine);
+        auto b = RandomMatrix(engine);
+        Vec4f v(RandomFloat(engine), RandomFloat(engine), RandomFloat(engine), RandomFloat(engine));
+
+        ExpectNear((a * b).values, Generic::Multiply(a, b).values, 16);
+        ExpectNear((a * v).values, Generic::Multiply(a, v).values, 4);
+        ExpectNear(a.Transpose().values, Generic::Transpose(a).values, 16, 0.0f);
+
+        Mat4x4f inverse;
+        ASSERT_TRUE(MathUtils3d::Inverse(a, inverse));
+        ExpectNear((a * inverse).values, MathUtils3d::IdentityMatrix().values, 16, 1e-2f);
+    }
+
+    Mat4x4f singular = MathUtils3d::Scale(Vec3f(1.0f, 0.0f, 1.0f));
+    Mat4x4f result = MathUtils3d::IdentityMatrix();
+    EXPECT_FALSE(MathUtils3d::Inverse(singular, result));
+    ExpectNear(result.values, MathUtils3d::IdentityMatrix().values, 16, 0.0f);
+
+    Transformf transform;
+    transform.RotateY(0.7f).Translate(Vec3f(1.0f, 2.0f, 3.0f)).ScaleX(2.0f);
+    Mat4x4f inverse;
+    ASSERT_TRUE(MathUtils3d::Inverse(transform.ToTransformMat(), inverse));
+    ExpectNear(inverse.values, transform.ToInverseTransformMat().values, 16);
+}
+
+TEST(Berserk, MathSimdVectorQuat) {
+    BRK_NS_USE;
+
+    std::mt19937 engine(2);
+
+    for (uint32 i = 0; i < 1000; i++) {
+        Vec3f a(RandomFloat(engine), RandomFloat(engine), RandomFloat(engine));
+        Vec3f b(RandomFloat(engine), RandomFloat(engine), RandomFloat(engine));
+        Vec4f c(a, RandomFloat(engine));
+        Vec4f d(b, RandomFloat(engine));
+
+        EXPECT_NEAR(Vec3f::Dot(a, b), Generic::Dot(a, b), TOLERANCE);
+        ExpectNear(Vec3f::Cross(a, b).values, Generic::Cross(a, b).values, 3);
+        EXPECT_NEAR(Vec4f::Dot(c, d), Generic::Dot(a, b) + c[3] * d[3], TOLERANCE);
+        ExpectNear((c + d).values, Vec4f(c[0] + d[0], c[1] + d[1], c[2] + d[2], c[3] + d[3]).values, 4);
+        ExpectNear((c - d).values, Vec4f(c[0] - d[0], c[1] - d[1], c[2] - d[2], c[3] - d[3]).values, 4);
+        ExpectNear((c * d).values, Vec4f(c[0] * d[0], c[1] * d[1], c[2] * d[2], c[3] * d[3]).values, 4);
+        ExpectNear((c * 2.0f).values, (c + c).values, 4);
+
+        Quatf p(a, RandomFloat(engine));
+        Quatf q(b, RandomFloat(engine));
+        auto pq = p * q;
+        auto expected = Generic::Multiply(p, q);
+        EXPECT_NEAR(pq.scalar, expected.scalar, TOLERANCE);
+        ExpectNear(pq.vec.values, expected.vec.values, 3);
+
+        // Rotation by quaternion product must match product of rotation matrices
+        Vec3f rotated = pq.Rotate(a);
+        Vec3f byMatrix = MathUtils3d::Multiply(p.AsMatrix() * q.AsMatrix(), a);
+        ExpectNear(rotated.values, byMatrix.values, 3, 1e-3f);
+    }
+
+    // Cross product must not write past the end of 12-byte vector
+    Vec3f packed[2] = {Vec3f(1, 0, 0), Vec3f(7, 8, 9)};
+    packed[0] = Vec3f::Cross(packed[0], Vec3f(0, 1, 0));
+    EXPECT_TRUE(packed[0] == Vec3f(0, 0, 1));
+    EXPECT_TRUE(packed[1] == Vec3f(7, 8, 9));
+}
+
+TEST(Berserk, MathSimdBatch) {
+    BRK_NS_USE;
+
+    const uint32 count = 1001;
+    std::mt19937 engine(3);
+
+    auto m = RandomMatrix(engine);
+    std::vector<Vec3f> points(count);
+    std::vector<Vec4f> vectors(count);
+    std::vector<Mat4x4f> matrices(count);
+
+    for (uint32 i = 0; i < count; i++) {
+        points[i] = Vec3f(RandomFloat(engine), RandomFloat(engine), RandomFloat(engine));
+        vectors[i] = Vec4f(points[i], RandomFloat(engine));
+        matrices[i] = RandomMatrix(engine);
+    }
+
+    std::vector<Vec3f> outPoints(count);
+    MathUtils3d::TransformPoints(m, points.data(), outPoints.data(), count);
+    for (uint32 i = 0; i < count; i++)
+        ExpectNear(outPoints[i].values, Generic::TransformPoint(m, points[i]).values, 3);
+
+    MathUtils3d::TransformDirections(m, points.data(), outPoints.data(), count);
+    for (uint32 i = 0; i < count; i++)
+        ExpectNear(outPoints[i].values, Vec3f(Generic::Multiply(m, Vec4f(points[i], 0.0f))).values, 3);
+
+    std::vector<Vec4f> outVectors(count);
+    MathUtils3d::TransformVectors(m, vectors.data(), outVectors.data(), count);
+    for (uint32 i = 0; i < count; i++)
+        ExpectNear(outVectors[i].values, Generic::Multiply(m, vectors[i]).values, 4);
+
+    std::vector<Mat4x4f> outMatrices(count);
+    MathUtils3d::Multiply(m, matrices.data(), outMatrices.data(), count);
+    for (uint32 i = 0; i < count; i++)
+        ExpectNear(outMatrices[i].values, Generic::Multiply(m, matrices[i]).values, 16);
+
+    // In-place transform
+    auto expected = outMatrices;
+    MathUtils3d::Multiply(matrices.data(), outMatrices.data(), outMatrices.data(), count);
+    for (uint32 i = 0; i < count; i++)
+        ExpectNear(outMatrices[i].values, Generic::Multiply(matrices[i], expected[i]).values, 16);
+
+    auto copy = points;
+    MathUtils3d::TransformPoints(m, copy.data(), copy.data(), count);
+    for (uint32 i = 0; i < count; i++)
+        ExpectNear(copy[i].values, Generic::TransformPoint(m, points[i]).values, 3);
+}
+
+BRK_BENCHMARK(MathSimdBenchmark) {
+    BRK_NS_USE;
+
+    const uint32 count = 100000;
+    const uint32 repeats = 10;
+    std::mt19937 engine(4);
+
+    std::vector<Mat4x4f> matrices(count);
+    std::vector<Mat4x4f> results(count);
+    std::vector<Vec3f> points(count);
+    std::vector<Vec3f> outPoints(count);
+    std::vector<Quatf> quats(count);
+    std::vector<Quatf> outQuats(count);
+
+    for (uint32 i = 0; i < count; i++) {
+        matrices[i] = RandomMatrix(engine);
+        points[i] = Vec3f(RandomFloat(engine), RandomFloat(engine), RandomFloat(engine));
+        quats[i] = Quatf(points[i], RandomFloat(engine));
+    }
+
+    auto m = RandomMatrix(engine);
+    float sink = 0.0f;
+
+    std::cout << "Math simd benchmark (" << count << " elements x " << repeats << ")" << std::endl;
+
+    auto genericMul = MeasureMs([&]() {
+        for (uint32 r = 0; r < repeats; r++)
+            for (uint32 i = 0; i < count; i++)
+                results[i] = Generic::Multiply(m, matrices[i]);
+    });
+    sink += results[count / 2].values[5];
+    auto simdMul = MeasureMs([&]() {
+        for (uint32 r = 0; r < repeats; r++)
+            for (uint32 i = 0; i < count; i++)
+                results[i] = m * matrices[i];
+    });
+    sink += results[count / 2].values[5];
+    auto batchMul = MeasureMs([&]() {
+        for (uint32 r = 0; r < repeats; r++)
+            MathUtils3d::Multiply(m, matrices.data(), results.data(), count);
+    });
+    sink += results[count / 2].values[5];
+    Report("mat4 * mat4", genericMul, simdMul);
+    Report("mat4 * mat4 batch", genericMul, batchMul);
+
+    auto genericTranspose = MeasureMs([&]() {
+        for (uint32 r = 0; r < repeats; r++)
+            for (uint32 i = 0; i < count; i++)
+                results[i] = Generic::Transpose(matrices[i]);
+    });
+    sink += results[count / 2].values[5];
+    auto simdTranspose = MeasureMs([&]() {
+        for (uint32 r = 0; r < repeats; r++)
+            for (uint32 i = 0; i < count; i++)
+                results[i] = matrices[i].Transpose();
+    });
+    sink += results[count / 2].values[5];
+    Report("mat4 transpose", genericTranspose, simdTranspose);
+
+    auto genericPoints = MeasureMs([&]() {
+        for (uint32 r = 0; r < repeats; r++)
+            for (uint32 i = 0; i < count; i++)
+                outPoints[i] = Generic::TransformPoint(m, points[i]);
+    });
+    sink += outPoints[count / 2].values[1];
+    auto batchPoints = MeasureMs([&]() {
+        for (uint32 r = 0; r < repeats; r++)
+            MathUtils3d::TransformPoints(m, points.data(), outPoints.data(), count);
+    });
+    sink += outPoints[count / 2].values[1];
+    Report("transform points batch", genericPoints, batchPoints);
+
+    auto genericCross = MeasureMs([&]() {
+        for (uint32 r = 0; r < repeats; r++)
+            for (uint32 i = 1; i < count; i++)
+                outPoints[i] = Generic::Cross(points[i - 1], points[i]);
+    });
+    sink += outPoints[count / 2].values[1];
+    auto simdCross = MeasureMs([&]() {
+        for (uint32 r = 0; r < repeats; r++)
+            for (uint32 i = 1; i < count; i++)
+                outPoints[i] = Vec3f::Cross(points[i - 1], points[i]);
+    });
+    sink += outPoints[count / 2].values[1];
+    Report("vec3 cross", genericCross, simdCross);
+
+    auto genericQuat = MeasureMs([&]() {
+        for (uint32 r = 0; r < repeats; r++)
+            for (uint32 i = 1; i < count; i++)
+                outQuats[i] = Generic::Multiply(quats[i - 1], quats[i]);
+    });
+    sink += outQuats[count / 2].scalar;
+    auto simdQuat = MeasureMs([&]() {
+        for (uint32 r = 0; r < repeats; r++)
+            for (uint32 i = 1; i < count; i++)
+                outQuats[i] = quats[i - 1] * quats[i];
+    });
+    sink += outQuats[count / 2].scalar;
+    Report("quat * quat", genericQuat, simdQuat);
+
+    std::cout << " (sink " << sink << ")" << std::endl;
+}
+
+BRK_GTEST_MAIN
@@ -0,0 +1,196 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/Memory.hpp>
+#include <platform/FileSystem.hpp>
+#include <platform/PakArchive.hpp>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+BRK_NS_BEGIN
+
+struct PakTestFile {
+    String name;
+    Ref<Data> data;
+};
+
+static std::vector<PakTestFile> GenerateFiles(uint32 count, uint32 maxSize) {
+    std::mt19937 engine(count);
+    std::uniform_int_distribution<uint32> size(1, maxSize);
+    std::vector<PakTestFile> files;
+
+    for (uint32 i = 0; i < count; i++) {
+        PakTestFile file;
+        file.name = "dir" + std::to_string(i % 16) + "/file" + std::to_string(i) + ".bin";
+        file.data = Data::Make(size(engine));
+
+        auto bytes = reinterpret_cast<uint8 *>(file.data->GetDataWrite());
+        for (size_t j = 0; j < file.data->GetSize(); j++)
+            bytes[j] = static_cast<uint8>(engine());
+
+        files.push_back(std::move(file));
+    }
+
+    return files;
+}
+
+static bool IsSameContent(const Ref<Data> &a, const Ref<Data> &b) {
+    return a.IsNotNull() && b.IsNotNull() && a->GetSize() == b->GetSize() && Memory::Compare(a->GetData(), b->GetData(), a->GetSize()) == 0;
+}
+
+BRK_NS_END
+
+TEST(Berserk, PakArchiveBasic) {
+    BRK_NS_USE;
+
+    // Declared first, so mappings of the pak are released before removal
+    TestTempDir temp("pak");
+    FileSystem fs;
+    auto path = temp.GetPath() + "/basic.brkpak";
+    auto files = GenerateFiles(100, 1000);
+
+    PakBuilder builder(64);
+    for (auto &file : files)
+        builder.AddFile("./" + file.name, file.data);
+    builder.AddFile(files[0].name, files[1].data);
+    files[0].data = files[1].data;
+
+    EXPECT_EQ(builder.GetFilesCount(), 100u);
+    EXPECT_TRUE(builder.Save(fs, path));
+
+    auto pak = PakArchive::Open(fs, path);
+    ASSERT_TRUE(pak.IsNotNull());
+    EXPECT_EQ(pak->GetEntriesCount(), 100u);
+
+    for (auto &file : files) {
+        auto entry = pak->FindEntry(file.name);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->offset % 64, 0u);
+        EXPECT_TRUE(pak->Verify(*entry));
+        EXPECT_TRUE(IsSameContent(pak->ReadFile(file.name), file.data));
+    }
+
+    EXPECT_FALSE(pak->Contains("dir0/missing.bin"));
+    EXPECT_TRUE(pak->Contains("dir1\\file1.bin"));
+
+    // Corrupted directory is rejected
+    auto mapped = fs.MapFile(path);
+    auto corrupted = Data::Make(mapped->GetData(), mapped->GetSize());
+    auto header = reinterpret_cast<PakArchive::Header *>(corrupted->GetDataWrite());
+    header->entriesCount += 1000;
+    EXPECT_TRUE(PakArchive::Open(corrupted, "corrupted").IsNull());
+}
+
+TEST(Berserk, PakArchiveMount) {
+    BRK_NS_USE;
+
+    TestTempDir temp("pak-mount");
+    FileSystem fs;
+    auto &dir = temp.GetPath();
+    auto files = GenerateFiles(10, 100);
+
+    PakBuilder builder;
+    for (auto &file : files)
+        builder.AddFile(file.name, file.data);
+
+    EXPECT_TRUE(fs.MakeDir(dir + "/loose/dir0"));
+    EXPECT_TRUE(builder.Save(fs, dir + "/mount.brkpak"));
+
+    // Loose file has priority over mounted pak
+    auto loose = Data::Make(String("loose file"));
+    EXPECT_TRUE(fs.WriteFile(dir + "/loose/" + files[0].name, loose));
+
+    fs.AddSearchPath(dir + "/loose");
+    fs.AddSearchPath(dir);
+    EXPECT_TRUE(fs.MountPak("mount.brkpak"));
+
+    EXPECT_TRUE(IsSameContent(fs.ReadFile(fs.GetFullFilePath(files[0].name)), loose));
+
+    for (size_t i = 1; i < files.size(); i++) {
+        auto fullPath = fs.GetFullFilePath(files[i].name);
+        EXPECT_TRUE(fs.IsFileExists(files[i].name));
+        EXPECT_TRUE(IsSameContent(fs.ReadFile(fullPath), files[i].data));
+
+        // Files share memory mapping of the pak
+        EXPECT_EQ(fs.ReadFile(fullPath)->GetData(), fs.ReadFile(fullPath)->GetData());
+    }
+
+    EXPECT_FALSE(fs.IsFileExists("dir0/missing.bin"));
+}
+
+BRK_BENCHMARK(PakArchiveBenchmark) {
+    BRK_NS_USE;
+
+    const uint32 count = 4000;
+
+    TestTempDir temp("pak-bench");
+    FileSystem fs;
+    auto dir = temp.GetPath() + "/bench";
+    auto files = GenerateFiles(count, 16 * 1024);
+
+    PakBuilder builder;
+    for (auto &file : files) {
+        auto filepath = dir + "/" + file.name;
+        EXPECT_TRUE(fs.MakeDir(filepath.substr(0, filepath.find_last_of('/'))));
+        EXPECT_TRUE(fs.WriteFile(filepath, file.data));
+        builder.AddFile(file.name, file.data);
+    }
+    EXPECT_TRUE(builder.Save(fs, dir + ".brkpak"));
+
+    // Startup: fresh file system resolves and reads every file by relative name
+    auto load = [&](bool pak) {
+        size_t loaded = 0;
+        auto ms = MeasureMs([&]() {
+            FileSystem fileSystem;
+            fileSystem.AddSearchPath(temp.GetPath() + "/missing");
+            if (pak)
+                fileSystem.MountPak(dir + ".brkpak");
+            else
+                fileSystem.AddSearchPath(dir);
+
+            for (auto &file : files) {
+                auto data = fileSystem.ReadFile(fileSystem.GetFullFilePath(file.name));
+                loaded += IsSameContent(data, file.data) ? 1 : 0;
+            }
+        });
+        EXPECT_EQ(loaded, files.size());
+        return ms;
+    };
+
+    auto looseMs = load(false);
+    auto pakMs = load(true);
+
+    std::cout << "Pak files: " << count << std::endl
+              << " loose files: " << looseMs << " ms" << std::endl
+              << " pak: " << pakMs << " ms" << std::endl;
+}
+
+BRK_GTEST_MAIN
@@ -0,0 +1,239 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/profiler/Profiler.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+BRK_NS_BEGIN
+
+static void SleepMs(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static void ProfiledLeaf() {
+    BRK_PROFILE_SCOPE("Leaf");
+    SleepMs(2);
+}
+
+static void ProfiledRoot() {
+    BRK_PROFILE_SCOPE("Root");
+    ProfiledLeaf();
+    ProfiledLeaf();
+}
+
+static const ProfileStat *FindStat(const ProfileFrame &frame, const char *name) {
+    for (const auto &stat : frame.stats) {
+        if (String(stat.name) == name)
+            return &stat;
+    }
+    return nullptr;
+}
+
+static const ProfileStat *FindGpuStat(const ProfileFrame &frame, const char *name) {
+    for (const auto &stat : frame.gpuStats) {
+        if (String(stat.name) == name)
+            return &stat;
+    }
+    return nullptr;
+}
+
+static ProfileEvent MakeGpuEvent(const char *name, uint64 beginMs, uint64 endMs, uint32 depth) {
+    ProfileEvent event;
+    event.name = name;
+    event.begin = beginMs * 1000000u;
+    event.end = endMs * 1000000u;
+    event.depth = depth;
+    return event;
+}
+
+BRK_NS_END
+
+TEST(Berserk, ProfilerFrameSummary) {
+    BRK_NS_USE;
+
+    auto &profiler = Profiler::Instance();
+    profiler.SetEnabled(true);
+
+    profiler.NextFrame();
+    ProfiledRoot();
+    profiler.NextFrame();
+
+    auto frame = profiler.GetLastFrame();
+    auto root = FindStat(frame, "Root");
+    auto leaf = FindStat(frame, "Leaf");
+
+    ASSERT_NE(root, nullptr);
+    ASSERT_NE(leaf, nullptr);
+    EXPECT_EQ(root->calls, 1u);
+    EXPECT_EQ(leaf->calls, 2u);
+    EXPECT_GE(leaf->totalMs, 4.0);
+    EXPECT_LE(root->selfMs, root->totalMs - leaf->totalMs + 0.001);
+    EXPECT_GE(frame.durationMs, root->totalMs);
+
+    // Disabled profiler records nothing
+    profiler.SetEnabled(false);
+    ProfiledRoot();
+    profiler.NextFrame();
+    EXPECT_TRUE(profiler.GetLastFrame().stats.empty());
+    profiler.SetEnabled(true);
+}
+
+TEST(Berserk, ProfilerThreadsAndTrace) {
+    BRK_NS_USE;
+
+    auto &profiler = Profiler::Instance();
+    profiler.SetEnabled(true);
+
+    std::thread worker([]() {
+        BRK_PROFILE_THREAD("Worker \"1\"");
+        for (int i = 0; i < 10; i++)
+            ProfiledLeaf();
+    });
+    worker.join();
+
+    EXPECT_GE(profiler.GetThreadsCount(), 2u);
+
+    std::stringstream trace;
+    profiler.WriteChromeTrace(trace);
+
+    auto json = trace.str();
+    EXPECT_NE(json.find("\"traceEvents\""), String::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\""), String::npos);
+    EXPECT_NE(json.find("Worker \\\"1\\\""), String::npos);
+}
+
+TEST(Berserk, ProfilerRingBufferOverflow) {
+    BRK_NS_USE;
+
+    auto &profiler = Profiler::Instance();
+    profiler.SetEnabled(true);
+
+    std::thread worker([&]() {
+        for (uint32 i = 0; i < Profiler::BUFFER_CAPACITY + 100; i++) {
+            BRK_PROFILE_SCOPE("Tiny");
+        }
+    });
+    worker.join();
+
+    auto events = profiler.GetEvents(profiler.GetThreadsCount() - 1);
+    EXPECT_EQ(events.size(), static_cast<size_t>(Profiler::BUFFER_CAPACITY));
+
+    for (size_t i = 1; i < events.size(); i++)
+        EXPECT_LE(events[i - 1].end, events[i].begin);
+}
+
+TEST(Berserk, ProfilerReadWhileWriting) {
+    BRK_NS_USE;
+
+    auto &profiler = Profiler::Instance();
+    profiler.SetEnabled(true);
+
+    std::atomic<bool> started{false};
+    std::atomic<bool> finished{false};
+
+    std::thread worker([&]() {
+        for (uint32 i = 0; i < Profiler::BUFFER_CAPACITY * 4; i++) {
+            BRK_PROFILE_SCOPE("Writer");
+            started.store(true);
+        }
+        finished.store(true);
+    });
+
+    while (!started.load())
+        std::this_thread::yield();
+
+    // Reader copies buffer while writer wraps around it, copied events must never be torn
+    auto threadId = profiler.GetThreadsCount() - 1;
+    bool done = false;
+
+    while (!done) {
+        done = finished.load();
+
+        auto events = profiler.GetEvents(threadId);
+        EXPECT_LE(events.size(), static_cast<size_t>(Profiler::BUFFER_CAPACITY));
+
+        for (size_t i = 0; i < events.size(); i++) {
+            ASSERT_NE(events[i].name, nullptr);
+            ASSERT_EQ(String(events[i].name), "Writer");
+            ASSERT_LE(events[i].begin, events[i].end);
+            if (i > 0) {
+                ASSERT_LE(events[i - 1].end, events[i].begin);
+            }
+        }
+    }
+
+    worker.join();
+}
+
+TEST(Berserk, ProfilerGpuEvents) {
+    BRK_NS_USE;
+
+    auto &profiler = Profiler::Instance();
+    profiler.SetEnabled(true);
+
+    // Synthetic resolved queries of one frame, submitted in order of scopes begin
+    std::vector<ProfileEvent> events;
+    events.push_back(MakeGpuEvent("GpuFrame", 100, 110, 0));
+    events.push_back(MakeGpuEvent("GpuShadows", 101, 104, 1));
+    events.push_back(MakeGpuEvent("GpuOpaque", 104, 109, 1));
+
+    profiler.NextFrame();
+    profiler.SubmitGpuEvents(events);
+    profiler.NextFrame();
+
+    auto frame = profiler.GetLastFrame();
+    auto gpuFrame = FindGpuStat(frame, "GpuFrame");
+    auto shadows = FindGpuStat(frame, "GpuShadows");
+    auto opaque = FindGpuStat(frame, "GpuOpaque");
+
+    ASSERT_NE(gpuFrame, nullptr);
+    ASSERT_NE(shadows, nullptr);
+    ASSERT_NE(opaque, nullptr);
+    EXPECT_EQ(FindStat(frame, "GpuFrame"), nullptr);
+    EXPECT_EQ(gpuFrame->calls, 1u);
+    EXPECT_DOUBLE_EQ(gpuFrame->totalMs, 10.0);
+    EXPECT_DOUBLE_EQ(gpuFrame->selfMs, 2.0);
+    EXPECT_DOUBLE_EQ(shadows->selfMs, 3.0);
+    EXPECT_DOUBLE_EQ(opaque->maxMs, 5.0);
+    EXPECT_STREQ(frame.gpuStats.front().name, "GpuFrame");
+
+    // Events are reported only in the frame they were submitted in
+    profiler.NextFrame();
+    EXPECT_TRUE(profiler.GetLastFrame().gpuStats.empty());
+
+    std::stringstream trace;
+    profiler.WriteChromeTrace(trace);
+    EXPECT_NE(trace.str().find(R"("args":{"name":"GPU"})"), String::npos);
+}
+
+BRK_GTEST_MAIN
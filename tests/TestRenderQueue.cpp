@@ -0,0 +1,151 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/JobSystem.hpp>
+#include <render/RenderQueue.hpp>
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+BRK_NS_BEGIN
+
+struct TestItem {
+    uint32 layer;
+    uint32 material;
+    float depth;
+};
+
+static std::vector<TestItem> GenerateItems(uint32 count) {
+    std::mt19937 engine(count);
+    std::uniform_int_distribution<uint32> layer(0, RenderQueue::MAX_LAYERS - 1);
+    std::uniform_int_distribution<uint32> material(0, 31);
+    // Integer depths keep distinct values distinct after key quantization
+    std::uniform_int_distribution<uint32> depth(1, 2000);
+
+    std::vector<TestItem> items(count);
+    for (auto &item : items) {
+        item.layer = layer(engine);
+        item.material = material(engine);
+        item.depth = static_cast<float>(depth(engine));
+    }
+
+    return items;
+}
+
+static void SortItems(const std::vector<TestItem> &items, RenderQueue::SortMode mode, JobSystem *jobSystem, std::vector<uint32> &sorted) {
+    auto count = static_cast<uint32>(items.size());
+    std::vector<uint64> keys(count);
+
+    sorted.resize(count);
+    for (uint32 i = 0; i < count; i++) {
+        keys[i] = RenderQueue::EncodeKey(0, items[i].layer, 0, items[i].material, 0, items[i].depth, mode);
+        sorted[i] = i;
+    }
+
+    RenderQueue::SortKeys(keys, sorted, count, jobSystem);
+
+    for (uint32 i = 1; i < count; i++)
+        EXPECT_LE(keys[i - 1], keys[i]);
+}
+
+static void CheckFrontToBack(const std::vector<TestItem> &items, const std::vector<uint32> &sorted) {
+    for (size_t i = 1; i < sorted.size(); i++) {
+        auto &a = items[sorted[i - 1]];
+        auto &b = items[sorted[i]];
+        EXPECT_LE(std::make_tuple(a.layer, a.material, a.depth), std::make_tuple(b.layer, b.material, b.depth));
+    }
+}
+
+BRK_NS_END
+
+TEST(Berserk, RenderQueueSortKeysOrder) {
+    BRK_NS_USE;
+
+    auto items = GenerateItems(1000);
+    std::vector<uint32> sorted;
+
+    SortItems(items, RenderQueue::SortMode::FrontToBack, nullptr, sorted);
+    CheckFrontToBack(items, sorted);
+
+    // Translucent pass: layer, then strictly back to front
+    SortItems(items, RenderQueue::SortMode::BackToFront, nullptr, sorted);
+    for (size_t i = 1; i < sorted.size(); i++) {
+        auto &a = items[sorted[i - 1]];
+        auto &b = items[sorted[i]];
+        EXPECT_LE(a.layer, b.layer);
+        if (a.layer == b.layer) {
+            EXPECT_GE(a.depth, b.depth);
+        }
+    }
+}
+
+TEST(Berserk, RenderQueueSortKeysFields) {
+    BRK_NS_USE;
+
+    auto opaque = RenderQueue::EncodeKey(0, 15, 4095, 4095, 4095, 1000.0f, RenderQueue::SortMode::FrontToBack);
+    auto translucent = RenderQueue::EncodeKey(1, 0, 0, 0, 0, 0.0f, RenderQueue::SortMode::BackToFront);
+    auto layer = RenderQueue::EncodeKey(0, 1, 0, 0, 0, 0.0f, RenderQueue::SortMode::FrontToBack);
+    auto material = RenderQueue::EncodeKey(0, 0, 0, 1, 0, 0.0f, RenderQueue::SortMode::FrontToBack);
+    auto depth = RenderQueue::EncodeKey(0, 0, 0, 0, 0, 1000.0f, RenderQueue::SortMode::FrontToBack);
+
+    EXPECT_LT(opaque, translucent);
+    EXPECT_LT(material, layer);
+    EXPECT_LT(depth, material);
+}
+
+TEST(Berserk, RenderQueueSortKeysStable) {
+    BRK_NS_USE;
+
+    std::vector<uint64> keys = {3, 1, 2, 1, 3, 1};
+    std::vector<uint32> values = {0, 1, 2, 3, 4, 5};
+
+    RenderQueue::SortKeys(keys, values, static_cast<uint32>(keys.size()), nullptr);
+
+    EXPECT_EQ(keys, (std::vector<uint64>{1, 1, 1, 2, 3, 3}));
+    EXPECT_EQ(values, (std::vector<uint32>{1, 3, 5, 2, 0, 4}));
+}
+
+TEST(Berserk, RenderQueueSortKeysParallel) {
+    BRK_NS_USE;
+
+    JobSystem jobSystem(4);
+    auto items = GenerateItems(50000);
+    std::vector<uint32> serial;
+    std::vector<uint32> parallel;
+
+    SortItems(items, RenderQueue::SortMode::FrontToBack, nullptr, serial);
+    SortItems(items, RenderQueue::SortMode::FrontToBack, &jobSystem, parallel);
+
+    EXPECT_EQ(serial, parallel);
+    CheckFrontToBack(items, parallel);
+}
+
+BRK_GTEST_MAIN
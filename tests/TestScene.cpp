@@ -0,0 +1,242 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/JobSystem.hpp>
+#include <core/math/MathUtils3d.hpp>
+#include <scene/SceneHierarchy.hpp>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+BRK_NS_BEGIN
+
+static Mat4x4f LocalMatrix(const Vec3f &position, const Quatf &rotation, const Vec3f &scale) {
+    return MathUtils3d::Translate(position) * MathUtils3d::Scale(scale) * rotation.AsMatrix();
+}
+
+static void ExpectMatrixNear(const Mat4x4f &a, const Mat4x4f &b, float tolerance = 1e-4f) {
+    for (uint32 i = 0; i < 16; i++)
+        EXPECT_NEAR(a.values[i], b.values[i], tolerance);
+}
+
+/** Builds random hierarchy with nodes count and returns ids of nodes */
+static std::vector<uint32> BuildHierarchy(SceneHierarchy &hierarchy, uint32 count, uint32 seed) {
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> angle(-3.0f, 3.0f);
+
+    std::vector<uint32> nodes;
+    nodes.reserve(count);
+
+    for (uint32 i = 0; i < count; i++) {
+        // Parent is picked among earlier nodes, so tree is wide and has about a dozen of levels
+        uint32 parent = i < 16 ? static_cast<uint32>(SceneHierarchy::NULL_NODE) : nodes[std::uniform_int_distribution<uint32>(i / 10, i - 1)(engine) / 2];
+        uint32 node = hierarchy.CreateNode(parent);
+        hierarchy.SetLocalPosition(node, Vec3f(offset(engine), offset(engine), offset(engine)));
+        hierarchy.SetLocalRotation(node, Quatf(Vec3f(offset(engine), 1.0f, offset(engine)), angle(engine)));
+        hierarchy.SetLocalBounds(node, Aabbf(Vec3f(-0.5f, -0.5f, -0.5f), Vec3f(0.5f, 0.5f, 0.5f)));
+        nodes.push_back(node);
+    }
+
+    return nodes;
+}
+
+BRK_NS_END
+
+TEST(Berserk, SceneHierarchyBasic) {
+    BRK_NS_USE;
+
+    SceneHierarchy hierarchy;
+    auto root = hierarchy.CreateNode();
+    auto child = hierarchy.CreateNode(root);
+    auto leaf = hierarchy.CreateNode(child);
+    auto other = hierarchy.CreateNode();
+
+    Quatf rotation(Vec3f(0, 1, 0), 0.5f);
+    hierarchy.SetLocalPosition(root, Vec3f(1, 2, 3));
+    hierarchy.SetLocalRotation(root, rotation);
+    hierarchy.SetLocalScale(child, Vec3f(2, 2, 2));
+    hierarchy.SetLocalPosition(leaf, Vec3f(0, 0, -1));
+    hierarchy.SetLocalBounds(leaf, Aabbf(Vec3f(-1, -1, -1), Vec3f(1, 1, 1)));
+    hierarchy.Update();
+
+    EXPECT_EQ(hierarchy.GetNodesCount(), 4u);
+    EXPECT_EQ(hierarchy.GetLevelsCount(), 3u);
+    EXPECT_EQ(hierarchy.GetUpdatedCount(), 4u);
+    EXPECT_EQ(hierarchy.GetDepth(leaf), 2u);
+
+    auto rootWorld = LocalMatrix(Vec3f(1, 2, 3), rotation, Vec3f(1, 1, 1));
+    auto childWorld = rootWorld * LocalMatrix(Vec3f(), Quatf(), Vec3f(2, 2, 2));
+    auto leafWorld = childWorld * LocalMatrix(Vec3f(0, 0, -1), Quatf(), Vec3f(1, 1, 1));
+    ExpectMatrixNear(hierarchy.GetWorldMatrix(root), rootWorld);
+    ExpectMatrixNear(hierarchy.GetWorldMatrix(child), childWorld);
+    ExpectMatrixNear(hierarchy.GetWorldMatrix(leaf), leafWorld);
+
+    // Parents always precede children in the world matrices array
+    EXPECT_LT(hierarchy.GetNodeIndex(root), hierarchy.GetNodeIndex(child));
+    EXPECT_LT(hierarchy.GetNodeIndex(child), hierarchy.GetNodeIndex(leaf));
+    EXPECT_EQ(hierarchy.GetNodeAt(hierarchy.GetNodeIndex(leaf)), leaf);
+
+    // World bounds are local bounds transformed by world matrix
+    EXPECT_TRUE(hierarchy.HasBounds(leaf));
+    EXPECT_FALSE(hierarchy.HasBounds(root));
+    auto center = MathUtils3d::Multiply(leafWorld, Vec3f());
+    auto worldAabb = hierarchy.GetWorldAabb(leaf);
+    for (uint32 i = 0; i < 3; i++)
+        EXPECT_NEAR(worldAabb.GetCenter()[i], center[i], 1e-4f);
+    EXPECT_TRUE(worldAabb.Contains(MathUtils3d::Multiply(leafWorld, Vec3f(1, 1, 1))));
+
+    // Nothing changed
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetUpdatedCount(), 0u);
+    EXPECT_FALSE(hierarchy.IsWorldChanged(root));
+
+    // Change of parent propagates to the sub-tree only
+    hierarchy.SetLocalPosition(child, Vec3f(5, 0, 0));
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetUpdatedCount(), 2u);
+    EXPECT_FALSE(hierarchy.IsWorldChanged(root));
+    EXPECT_TRUE(hierarchy.IsWorldChanged(leaf));
+    EXPECT_FALSE(hierarchy.IsWorldChanged(other));
+
+    // Re-parent and reject cycles
+    EXPECT_FALSE(hierarchy.SetParent(root, leaf));
+    EXPECT_TRUE(hierarchy.SetParent(leaf, other));
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetDepth(leaf), 1u);
+    EXPECT_EQ(hierarchy.GetLevelsCount(), 2u);
+    ExpectMatrixNear(hierarchy.GetWorldMatrix(leaf), LocalMatrix(Vec3f(0, 0, -1), Quatf(), Vec3f(1, 1, 1)));
+
+    // Gathered matrices are column-major
+    float gathered[32];
+    uint32 gatherNodes[2] = {child, leaf};
+    hierarchy.GatherWorldMatrices(gatherNodes, 2, gathered);
+    ExpectMatrixNear(Mat4x4f(gathered + 16, 16), hierarchy.GetWorldMatrix(leaf).Transpose(), 0.0f);
+
+    // Destroy sub-tree, ids are reused
+    hierarchy.DestroyNode(root);
+    EXPECT_EQ(hierarchy.GetNodesCount(), 2u);
+    auto reused = hierarchy.CreateNode(leaf);
+    EXPECT_TRUE(reused == root || reused == child);
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetDepth(reused), 2u);
+    ExpectMatrixNear(hierarchy.GetWorldMatrix(reused), hierarchy.GetWorldMatrix(leaf));
+}
+
+TEST(Berserk, SceneHierarchyParallelMatchesSerial) {
+    BRK_NS_USE;
+
+    const uint32 count = 20000;
+
+    JobSystem jobSystem(2);
+    SceneHierarchy serial;
+    SceneHierarchy parallel(&jobSystem);
+
+    auto serialNodes = BuildHierarchy(serial, count, 1);
+    auto parallelNodes = BuildHierarchy(parallel, count, 1);
+
+    serial.Update();
+    parallel.Update();
+    EXPECT_EQ(parallel.GetUpdatedCount(), count);
+
+    // Partial update of moved sub-trees
+    std::mt19937 engine(2);
+    std::uniform_int_distribution<uint32> pick(0, count - 1);
+    for (uint32 i = 0; i < count / 100; i++) {
+        auto id = pick(engine);
+        serial.SetLocalPosition(serialNodes[id], Vec3f(1, 1, 1));
+        parallel.SetLocalPosition(parallelNodes[id], Vec3f(1, 1, 1));
+    }
+
+    serial.Update();
+    parallel.Update();
+    EXPECT_EQ(serial.GetUpdatedCount(), parallel.GetUpdatedCount());
+    EXPECT_LT(parallel.GetUpdatedCount(), count);
+
+    for (uint32 i = 0; i < count; i++) {
+        ExpectMatrixNear(serial.GetWorldMatrix(serialNodes[i]), parallel.GetWorldMatrix(parallelNodes[i]), 0.0f);
+        EXPECT_TRUE(serial.GetWorldAabb(serialNodes[i]).GetMin() == parallel.GetWorldAabb(parallelNodes[i]).GetMin());
+    }
+}
+
+BRK_BENCHMARK(SceneHierarchyBenchmark) {
+    BRK_NS_USE;
+
+    const uint32 count = 200000;
+
+    JobSystem jobSystem;
+    SceneHierarchy serial;
+    SceneHierarchy parallel(&jobSystem);
+
+    auto serialNodes = BuildHierarchy(serial, count, 1);
+    auto parallelNodes = BuildHierarchy(parallel, count, 1);
+
+    auto serialFull = MeasureMs([&]() { serial.Update(); });
+    auto parallelFull = MeasureMs([&]() { parallel.Update(); });
+
+    EXPECT_EQ(serial.GetUpdatedCount(), count);
+    EXPECT_EQ(parallel.GetUpdatedCount(), count);
+
+    // Move 1% of nodes each frame
+    std::mt19937 engine(2);
+    std::uniform_int_distribution<uint32> pick(0, count - 1);
+    std::vector<uint32> moved;
+    for (uint32 i = 0; i < count / 100; i++)
+        moved.push_back(pick(engine));
+
+    for (auto i : moved) {
+        serial.SetLocalPosition(serialNodes[i], Vec3f(1, 1, 1));
+        parallel.SetLocalPosition(parallelNodes[i], Vec3f(1, 1, 1));
+    }
+
+    auto serialPartial = MeasureMs([&]() { serial.Update(); });
+    auto parallelPartial = MeasureMs([&]() { parallel.Update(); });
+    auto partialCount = parallel.GetUpdatedCount();
+    EXPECT_EQ(serial.GetUpdatedCount(), partialCount);
+
+    // First resets changed flags, second has nothing to do
+    auto idle = MeasureMs([&]() { parallel.Update(); parallel.Update(); });
+
+    for (uint32 i = 0; i < count; i += 97) {
+        ExpectMatrixNear(serial.GetWorldMatrix(serialNodes[i]), parallel.GetWorldMatrix(parallelNodes[i]), 0.0f);
+        EXPECT_TRUE(serial.GetWorldAabb(serialNodes[i]).GetMin() == parallel.GetWorldAabb(parallelNodes[i]).GetMin());
+    }
+
+    std::vector<float> upload(count * 16);
+    auto gatherMs = MeasureMs([&]() { parallel.GatherWorldMatrices(parallelNodes.data(), count, upload.data()); });
+
+    std::cout << "Scene hierarchy nodes: " << count << " levels: " << parallel.GetLevelsCount() << " workers: " << jobSystem.GetWorkersCount() << std::endl
+              << " full update: serial " << serialFull << " ms, parallel " << parallelFull << " ms" << std::endl
+              << " partial update (" << partialCount << " nodes): serial " << serialPartial << " ms, parallel " << parallelPartial << " ms" << std::endl
+              << " idle update x2: " << idle << " ms" << std::endl
+              << " gather for upload: " << gatherMs << " ms" << std::endl;
+}
+
+BRK_GTEST_MAIN
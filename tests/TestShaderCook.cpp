@@ -0,0 +1,135 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/JobSystem.hpp>
+#include <platform/FileSystem.hpp>
+#include <render/shader/ShaderCooker.hpp>
+#include <render/shader/ShaderManager.hpp>
+#include <render/shader/ShaderVariantPack.hpp>
+
+static const char *const TEST_SHADER = R"(<?xml version="1.0" encoding="utf-8" ?>
+<shader name="test" archetype="brk_shader_base" description="Test shader">
+    <options>
+        <option name="D_FIRST"/>
+        <option name="D_SECOND"/>
+    </options>
+    <params>
+        <param name="pMVP" type="mat4"/>
+        <param name="pColor" type="float3" default="1 1 1"/>
+    </params>
+    <techniques>
+        <technique name="default" language="GLSL410GL">
+            <passes>
+                <pass name="main">
+                    <vertex>
+                        void vertex(inout Params params) {
+                            params.projPos = pMVP * vec4(getPos(), 1.0f);
+                        }
+                    </vertex>
+                    <fragment>
+                        void fragment(inout Params params) {
+                            params.color = pColor;
+                        }
+                    </fragment>
+                </pass>
+            </passes>
+        </technique>
+    </techniques>
+</shader>
+)";
+
+TEST(Berserk, ShaderCook) {
+    BRK_NS_USE
+
+    FileSystem fs;
+    JobSystem jobSystem;
+    ShaderManager shaderManager;
+    TestTempDir temp("shader-cook");
+
+    auto dir = temp.GetPath();
+    auto shaderPath = dir + "/test.shader.xml";
+    auto packPath = dir + "/test-variants.pack";
+
+    ASSERT_TRUE(fs.WriteFile(shaderPath, Data::Make(String(TEST_SHADER))));
+
+    ShaderVariantPack pack;
+    ShaderCooker cooker(shaderManager, fs, jobSystem);
+    cooker.AddFile("test.shader.xml", shaderPath);
+    EXPECT_TRUE(cooker.Cook(pack));
+    ASSERT_TRUE(pack.Save(fs, packPath));
+
+    // Two declared options and one archetype option
+    ASSERT_EQ(pack.GetEntries().size(), 1u);
+    EXPECT_EQ(pack.GetVariantsCount(), 8u);
+
+    ShaderVariantPack loaded;
+    ASSERT_TRUE(loaded.Load(fs, packPath));
+    ASSERT_EQ(loaded.GetEntries().size(), 1u);
+
+    auto &expected = pack.GetEntries()[0];
+    auto &entry = loaded.GetEntries()[0];
+    EXPECT_EQ(entry.path, "test.shader.xml");
+    EXPECT_EQ(entry.sourceHash, expected.sourceHash);
+    ASSERT_EQ(entry.variants.size(), expected.variants.size());
+
+    for (size_t i = 0; i < entry.variants.size(); i++) {
+        auto &variant = entry.variants[i];
+        EXPECT_EQ(variant.options, expected.variants[i].options);
+        ASSERT_EQ(variant.passes.size(), 1u);
+        ASSERT_EQ(variant.passes[0].stages.size(), 2u);
+        EXPECT_EQ(variant.passes[0].name, StringName("main"));
+        EXPECT_EQ(variant.passes[0].stages[1].sourceCode, expected.variants[i].passes[0].stages[1].sourceCode);
+
+        // Options are passed to the processed sources as defines
+        for (auto &option : variant.options)
+            EXPECT_NE(variant.passes[0].stages[0].sourceCode.find(option.GetStr()), String::npos);
+    }
+
+    // Limit permutations
+    ShaderVariantPack limited;
+    cooker.SetMaxOptions(1);
+    EXPECT_TRUE(cooker.Cook(limited));
+    EXPECT_EQ(limited.GetVariantsCount(), 2u);
+}
+
+TEST(Berserk, ShaderVariantPackCorrupted) {
+    BRK_NS_USE
+
+    FileSystem fs;
+    TestTempDir temp("shader-pack");
+    auto packPath = temp.GetPath() + "/test-corrupted.pack";
+
+    ASSERT_TRUE(fs.WriteFile(packPath, Data::Make(String("BRKV not a pack"))));
+
+    ShaderVariantPack pack;
+    EXPECT_FALSE(pack.Load(fs, packPath));
+    EXPECT_TRUE(pack.GetEntries().empty());
+}
+
+BRK_GTEST_MAIN
@@ -0,0 +1,239 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/JobSystem.hpp>
+#include <core/math/MathUtils3d.hpp>
+#include <core/spatial/AabbTree.hpp>
+#include <core/spatial/LooseOctree.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+BRK_NS_BEGIN
+
+static const float WORLD_SIZE = 1000.0f;
+
+struct SpatialScene {
+    std::vector<Aabbf> boxes;
+    std::vector<Aabbf> queries;
+    std::vector<Rayf> rays;
+    Frustumf frustum;
+};
+
+static Aabbf RandomBox(std::mt19937 &engine, float maxSize) {
+    std::uniform_real_distribution<float> position(-WORLD_SIZE * 0.5f, WORLD_SIZE * 0.5f);
+    std::uniform_real_distribution<float> size(0.1f, maxSize);
+
+    Vec3f center(position(engine), position(engine), position(engine));
+    Vec3f extent(size(engine), size(engine), size(engine));
+    return Aabbf(center - extent, center + extent);
+}
+
+static SpatialScene GenerateScene(uint32 objects, uint32 queries) {
+    std::mt19937 engine(objects);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+
+    SpatialScene scene;
+
+    for (uint32 i = 0; i < objects; i++)
+        scene.boxes.push_back(RandomBox(engine, 2.0f));
+
+    for (uint32 i = 0; i < queries; i++) {
+        scene.queries.push_back(RandomBox(engine, 20.0f));
+        scene.rays.emplace_back(scene.queries.back().GetCenter(), Vec3f(direction(engine), direction(engine), direction(engine)).Normalized());
+    }
+
+    auto view = MathUtils3d::LookAt(Vec3f(0, 0, 0), Vec3f(0.3f, 0.1f, -1.0f), Vec3f(0, 1, 0));
+    auto proj = MathUtils3d::Perspective(MathUtils::DegToRad(60.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+    scene.frustum = Frustumf(proj * view);
+
+    return scene;
+}
+
+/** Runs the same workload over spatial index and checks results against linear scan */
+template<typename Index>
+static void RunIndex(const char *name, Index &index, SpatialScene scene, JobSystem &jobSystem, bool report) {
+    const float maxDistance = 200.0f;
+    auto count = static_cast<uint32>(scene.boxes.size());
+    std::vector<uint32> proxies(count);
+
+    auto buildMs = MeasureMs([&]() {
+        for (uint32 i = 0; i < count; i++)
+            proxies[i] = index.CreateProxy(scene.boxes[i], i);
+    });
+
+    // Each frame move 10% of objects slightly
+    std::mt19937 engine(count);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    uint32 reinserted = 0;
+
+    auto updateMs = MeasureMs([&]() {
+        for (uint32 i = 0; i < count; i += 10) {
+            Vec3f delta(offset(engine), offset(engine), offset(engine));
+            scene.boxes[i] = Aabbf(scene.boxes[i].GetMin() + delta, scene.boxes[i].GetMax() + delta);
+            reinserted += index.MoveProxy(proxies[i], scene.boxes[i]) ? 1 : 0;
+        }
+    });
+
+    uint64 overlaps = 0;
+    uint64 expectedOverlaps = 0;
+    auto queryMs = MeasureMs([&]() {
+        for (auto &query : scene.queries)
+            index.QueryAabb(query, [&](uint32) { overlaps += 1; return true; });
+    });
+    auto scanMs = MeasureMs([&]() {
+        for (auto &query : scene.queries)
+            for (auto &box : scene.boxes)
+                expectedOverlaps += box.Intersects(query) ? 1 : 0;
+    });
+
+    uint32 visible = 0;
+    uint32 expectedVisible = 0;
+    auto frustumMs = MeasureMs([&]() { index.QueryFrustum(scene.frustum, [&](uint32) { visible += 1; return true; }); });
+    for (auto &box : scene.boxes)
+        expectedVisible += scene.frustum.Intersects(box) ? 1 : 0;
+
+    std::vector<RayHit> hits;
+    auto raysMs = MeasureMs([&]() { index.RayCastBatch(scene.rays, maxDistance, hits, &jobSystem); });
+
+    for (size_t r = 0; r < scene.rays.size(); r++) {
+        float closest = maxDistance;
+        bool hit = false;
+        float distance;
+        for (auto &box : scene.boxes) {
+            if (scene.rays[r].Intersects(box, closest, distance)) {
+                closest = distance;
+                hit = true;
+            }
+        }
+        EXPECT_EQ(hit, hits[r].IsHit());
+        if (hit && hits[r].IsHit()) {
+            EXPECT_FLOAT_EQ(closest, hits[r].distance);
+        }
+    }
+
+    EXPECT_EQ(overlaps, expectedOverlaps);
+    EXPECT_EQ(visible, expectedVisible);
+
+    if (!report)
+        return;
+
+    std::cout << name << " objects: " << count << std::endl
+              << " build: " << buildMs << " ms" << std::endl
+              << " update 10% (" << reinserted << " reinserted): " << updateMs << " ms" << std::endl
+              << " " << scene.queries.size() << " aabb queries: " << queryMs << " ms (linear scan " << scanMs << " ms)" << std::endl
+              << " frustum query (" << visible << " visible): " << frustumMs << " ms" << std::endl
+              << " " << scene.rays.size() << " rays batch: " << raysMs << " ms" << std::endl;
+}
+
+BRK_NS_END
+
+TEST(Berserk, AabbTreeBasic) {
+    BRK_NS_USE;
+
+    AabbTree tree(0.1f);
+    auto a = tree.CreateProxy(Aabbf(Vec3f(0, 0, 0), Vec3f(1, 1, 1)), 10);
+    auto b = tree.CreateProxy(Aabbf(Vec3f(5, 5, 5), Vec3f(6, 6, 6)), 20);
+    auto c = tree.CreateProxy(Aabbf(Vec3f(-5, 0, 0), Vec3f(-4, 1, 1)), 30);
+    tree.Validate();
+
+    std::vector<uint32> found;
+    tree.QueryAabb(Aabbf(Vec3f(0.5f, 0.5f, 0.5f), Vec3f(5.5f, 5.5f, 5.5f)), [&](uint32 proxy) { found.push_back(tree.GetUserData(proxy)); return true; });
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, std::vector<uint32>({10, 20}));
+
+    auto hit = tree.RayCastClosest(Rayf(Vec3f(-10, 0.5f, 0.5f), Vec3f(1, 0, 0)), 100.0f);
+    EXPECT_EQ(hit.proxy, c);
+    EXPECT_FLOAT_EQ(hit.distance, 5.0f);
+
+    EXPECT_TRUE(tree.MoveProxy(c, Aabbf(Vec3f(10, 10, 10), Vec3f(11, 11, 11))));
+    EXPECT_FALSE(tree.MoveProxy(a, Aabbf(Vec3f(0.05f, 0, 0), Vec3f(1.05f, 1, 1))));
+    tree.DestroyProxy(b);
+    tree.Validate();
+    EXPECT_EQ(tree.GetProxiesCount(), 2u);
+
+    hit = tree.RayCastClosest(Rayf(Vec3f(-10, 0.5f, 0.5f), Vec3f(1, 0, 0)), 100.0f);
+    EXPECT_EQ(hit.proxy, a);
+}
+
+TEST(Berserk, LooseOctreeBasic) {
+    BRK_NS_USE;
+
+    LooseOctree octree(Aabbf(Vec3f(-10, -10, -10), Vec3f(10, 10, 10)), 6);
+    auto a = octree.CreateProxy(Aabbf(Vec3f(0, 0, 0), Vec3f(1, 1, 1)), 10);
+    auto b = octree.CreateProxy(Aabbf(Vec3f(5, 5, 5), Vec3f(6, 6, 6)), 20);
+    auto c = octree.CreateProxy(Aabbf(Vec3f(50, 0, 0), Vec3f(51, 1, 1)), 30);
+
+    std::vector<uint32> found;
+    octree.QueryAabb(Aabbf(Vec3f(0.5f, 0.5f, 0.5f), Vec3f(60, 5.5f, 5.5f)), [&](uint32 proxy) { found.push_back(octree.GetUserData(proxy)); return true; });
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, std::vector<uint32>({10, 20, 30}));
+
+    EXPECT_TRUE(octree.MoveProxy(c, Aabbf(Vec3f(-6, -6, -6), Vec3f(-5, -5, -5))));
+    octree.DestroyProxy(a);
+    EXPECT_EQ(octree.GetProxiesCount(), 2u);
+
+    auto hit = octree.RayCastClosest(Rayf(Vec3f(-10, -5.5f, -5.5f), Vec3f(1, 0, 0)), 100.0f);
+    EXPECT_EQ(hit.proxy, c);
+    EXPECT_FLOAT_EQ(hit.distance, 4.0f);
+    (void) b;
+}
+
+TEST(Berserk, SpatialMatchesLinearScan) {
+    BRK_NS_USE;
+
+    JobSystem jobSystem(2);
+    auto scene = GenerateScene(5000, 100);
+
+    AabbTree tree(0.5f);
+    RunIndex("AabbTree", tree, scene, jobSystem, false);
+    tree.Validate();
+
+    LooseOctree octree(Aabbf(Vec3f(0, 0, 0), WORLD_SIZE * 0.5f), 8);
+    RunIndex("LooseOctree", octree, scene, jobSystem, false);
+}
+
+BRK_BENCHMARK(SpatialBenchmark) {
+    BRK_NS_USE;
+
+    JobSystem jobSystem;
+    auto scene = GenerateScene(100000, 1000);
+
+    AabbTree tree(0.5f);
+    RunIndex("AabbTree", tree, scene, jobSystem, true);
+    std::cout << " height: " << tree.GetHeight() << " area ratio: " << tree.GetAreaRatio() << std::endl;
+
+    LooseOctree octree(Aabbf(Vec3f(0, 0, 0), WORLD_SIZE * 0.5f), 8);
+    RunIndex("LooseOctree", octree, scene, jobSystem, true);
+    std::cout << " nodes: " << octree.GetNodesCount() << std::endl;
+}
+
+BRK_GTEST_MAIN
@@ -0,0 +1,302 @@
+/**********************************************************************************/
+/* This file is part of Berserk Engine project                                    */
+/* https://github.com/EgorOrachyov/Berserk                                        */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2018 - 2021 Egor Orachyov                                        */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <Testing.hpp>
+
+#include <core/string/Unicode.hpp>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+BRK_NS_BEGIN
+
+/** Straightforward validator used as reference */
+static bool ReferenceValidateUtf8(const String8u &in) {
+    size_t i = 0;
+
+    while (i < in.size()) {
+        auto c = static_cast<uint32>(static_cast<uint8>(in[i]));
+        size_t len = c < 0x80 ? 1 : (c >> 5u) == 0x6u ? 2 : (c >> 4u) == 0xeu ? 3 : (c >> 3u) == 0x1eu ? 4 : 0;
+
+        if (len == 0 || in.size() - i < len)
+            return false;
+
+        uint32 point = len == 1 ? c : c & (0x7fu >> len);
+        for (size_t k = 1; k < len; k++) {
+            auto b = static_cast<uint32>(static_cast<uint8>(in[i + k]));
+            if ((b & 0xc0u) != 0x80u)
+                return false;
+            point = (point << 6u) | (b & 0x3fu);
+        }
+
+        static const uint32 minPoint[5] = {0, 0, 0x80, 0x800, 0x10000};
+        if (point < minPoint[len] || point > 0x10ffff || (point >= 0xd800 && point <= 0xdfff))
+            return false;
+
+        i += len;
+    }
+
+    return true;
+}
+
+/** Conversion one point at a time, as it was done before */
+static void ConvertPerPoint(const String8u &in, String16u &out) {
+    const auto *buffer = in.c_str();
+    auto len = static_cast<uint32>(in.length());
+
+    while (len > 0) {
+        uint32 parsed = len;
+        uint32 encodedLen;
+        Unicode::Char32u point;
+        Unicode::Char16u encoded[2];
+
+        Unicode::Utf8toUtf32(buffer, parsed, point);
+        Unicode::Utf32ToUtf16(point, encoded, encodedLen);
+        out.append(encoded, encoded + encodedLen);
+        len -= parsed;
+        buffer += parsed;
+    }
+}
+
+/** Case mapping one point at a time */
+static void ToLowerPerPoint(const String8u &in, String8u &out) {
+    const auto *buffer = in.c_str();
+    auto len = static_cast<uint32>(in.length());
+
+    while (len > 0) {
+        uint32 parsed = len;
+        uint32 encodedLen;
+        Unicode::Char32u point;
+        Unicode::Char8u encoded[4];
+
+        Unicode::Utf8toUtf32(buffer, parsed, point);
+        Unicode::Utf32toUtf8(Unicode::ToLower(point), encoded, encodedLen);
+        out.append(encoded, encoded + encodedLen);
+        len -= parsed;
+        buffer += parsed;
+    }
+}
+
+/** Random text where each point is taken from one of the given samples */
+static String8u GenerateText(const std::vector<String8u> &samples, size_t size, uint32 seed) {
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<size_t> distribution(0, samples.size() - 1);
+    String8u text;
+
+    while (text.size() < size)
+        text += samples[distribution(engine)];
+
+    return text;
+}
+
+BRK_NS_END
+
+TEST(Berserk, UnicodeValidateUtf8) {
+    BRK_NS_USE;
+
+    const char *invalid[] = {
+            "\x80",              // lone continuation
+            "\xc0\xaf",          // overlong 2 bytes
+            "\xe0\x80\xaf",      // overlong 3 bytes
+            "\xf0\x80\x80\xaf",  // overlong 4 bytes
+            "\xed\xa0\x80",      // surrogate
+            "\xf4\x90\x80\x80",  // above U+10FFFF
+            "\xf5\x80\x80\x80",  // invalid lead
+            "\xff",              // invalid byte
+            "\xe2\x82",          // truncated
+            "\xc3\xa9\xa9",      // too long
+            "\xe2\x28\xa1",      // ascii in the middle
+            "\xf0\x9f\x98",      // truncated 4 bytes
+    };
+
+    const char *valid[] = {
+            "\xc3\xa9",         // U+00E9
+            "\xe2\x82\xac",     // U+20AC
+            "\xed\x9f\xbf",     // U+D7FF
+            "\xee\x80\x80",     // U+E000
+            "\xf0\x9f\x98\x80", // U+1F600
+            "\xf4\x8f\xbf\xbf", // U+10FFFF
+    };
+
+    // Place sequence at every offset to cross blocks boundaries
+    for (size_t offset = 0; offset < 40; offset++) {
+        for (auto sequence : invalid) {
+            String8u text = String8u(offset, 'a') + sequence + String8u(offset % 7, 'b');
+            EXPECT_FALSE(Unicode::ValidateUtf8(text.data(), text.size())) << offset << " " << sequence;
+
+            String16u converted;
+            EXPECT_FALSE(Unicode::ConvertUtf8ToUtf16(text, converted));
+            EXPECT_TRUE(converted.empty());
+        }
+        for (auto sequence : valid) {
+            String8u text = String8u(offset, 'a') + sequence + String8u(offset % 7, 'b');
+            EXPECT_TRUE(Unicode::ValidateUtf8(text.data(), text.size())) << offset << " " << sequence;
+        }
+    }
+
+    // Random mutations of valid text
+    auto text = GenerateText({"a", "Z", "\xc3\xa9", "\xd0\x96", "\xe4\xb8\xad", "\xf0\x9f\x98\x80"}, 200, 1);
+    std::mt19937 engine(2);
+    std::uniform_int_distribution<uint32> byte(0, 255);
+    std::uniform_int_distribution<size_t> position(0, text.size() - 1);
+
+    for (uint32 i = 0; i < 20000; i++) {
+        auto mutated = text;
+        mutated[position(engine)] = static_cast<char>(byte(engine));
+        if (i % 2)
+            mutated[position(engine)] = static_cast<char>(byte(engine));
+        mutated.resize(position(engine) + 1);
+        EXPECT_EQ(Unicode::ValidateUtf8(mutated.data(), mutated.size()), ReferenceValidateUtf8(mutated));
+    }
+
+    std::cout << "Unicode simd: " << (Unicode::IsSimdAccelerated() ? "yes" : "no") << std::endl;
+}
+
+TEST(Berserk, UnicodeConvert) {
+    BRK_NS_USE;
+
+    auto text = GenerateText({"abc", "Hello, World! ", "\xc3\xa9", "\xd0\x96\xd0\xb8", "\xe4\xb8\xad\xe6\x96\x87", "\xf0\x9f\x98\x80"}, 5000, 3);
+
+    String16u expected;
+    ConvertPerPoint(text, expected);
+
+    String16u converted;
+    EXPECT_TRUE(Unicode::ConvertUtf8ToUtf16(text, converted));
+    EXPECT_TRUE(converted == expected);
+    EXPECT_TRUE(Unicode::ValidateUtf16(converted.data(), converted.size()));
+
+    String8u back;
+    EXPECT_TRUE(Unicode::ConvertUtf16ToUtf8(converted, back));
+    EXPECT_EQ(back, text);
+
+    // Unpaired surrogates are rejected at any position
+    for (size_t offset = 0; offset < 20; offset++) {
+        String16u high = String16u(offset, u'a') + u'\xd83d' + u"bc";
+        String16u low = String16u(offset, u'a') + u'\xde00';
+        String8u result = "prefix";
+
+        EXPECT_FALSE(Unicode::ValidateUtf16(high.data(), high.size()));
+        EXPECT_FALSE(Unicode::ValidateUtf16(low.data(), low.size()));
+        EXPECT_FALSE(Unicode::ConvertUtf16ToUtf8(high, result));
+        EXPECT_FALSE(Unicode::ConvertUtf16ToUtf8(low, result));
+        EXPECT_EQ(result, "prefix");
+    }
+
+    Unicode::Char32u point;
+    uint32 len = 2;
+    EXPECT_TRUE(Unicode::Utf16ToUtf32(u"\U0001F600", len, point));
+    EXPECT_EQ(point, 0x1F600u);
+    EXPECT_EQ(len, 2u);
+}
+
+TEST(Berserk, UnicodeCase) {
+    BRK_NS_USE;
+
+    EXPECT_EQ(Unicode::ToLower(U'A'), U'a');
+    EXPECT_EQ(Unicode::ToUpper(U'z'), U'Z');
+    EXPECT_EQ(Unicode::ToLower(U'Ä'), U'ä');
+    EXPECT_EQ(Unicode::ToLower(U'Ж'), U'ж');
+    EXPECT_EQ(Unicode::ToUpper(U'α'), U'Α');
+    EXPECT_EQ(Unicode::ToLower(U'Ⓐ'), U'ⓐ');
+    EXPECT_EQ(Unicode::ToUpper(U'ａ'), U'Ａ');
+    EXPECT_EQ(Unicode::ToLower(U'1'), U'1');
+    EXPECT_EQ(Unicode::ToLower(U'中'), U'中');
+    EXPECT_EQ(Unicode::ToLower(U'\U0001F600'), U'\U0001F600');
+
+    Unicode::Char32u points[] = {U'A', U'b', U'Ж', U'\U0001F600'};
+    Unicode::ToUpper(points, points, 4);
+    EXPECT_EQ(points[1], U'B');
+    EXPECT_EQ(points[2], U'Ж');
+
+    String8u lower;
+    EXPECT_TRUE(Unicode::ToLower("THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG, \xd0\x9c\xd0\x98\xd0\xa0 \xce\x91\xce\x92\xce\x93!", lower));
+    EXPECT_EQ(lower, "the quick brown fox jumps over the lazy dog, \xd0\xbc\xd0\xb8\xd1\x80 \xce\xb1\xce\xb2\xce\xb3!");
+
+    String8u upper;
+    EXPECT_TRUE(Unicode::ToUpper(lower, upper));
+    EXPECT_EQ(upper, "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG, \xd0\x9c\xd0\x98\xd0\xa0 \xce\x91\xce\x92\xce\x93!");
+
+    EXPECT_FALSE(Unicode::ToLower("ABC\xc0\xaf", lower));
+
+    auto text = GenerateText({"Abc", "[Z]@`{", "\xc3\x89", "\xd0\x96", "\xe4\xb8\xad", "\xf0\x9f\x98\x80"}, 2000, 4);
+    String8u expected;
+    String8u mapped;
+    ToLowerPerPoint(text, expected);
+    EXPECT_TRUE(Unicode::ToLower(text, mapped));
+    EXPECT_EQ(mapped, expected);
+}
+
+BRK_BENCHMARK(UnicodeBenchmark) {
+    BRK_NS_USE;
+
+    const size_t size = 4 * 1024 * 1024;
+    const uint32 iterations = 8;
+
+    struct Corpus {
+        const char *name;
+        String8u text;
+    };
+
+    std::vector<Corpus> corpora = {
+            {"ascii", GenerateText({"The ", "quick ", "brown ", "fox ", "jumps ", "over ", "lazy ", "dog. ", "Path/To/File.txt "}, size, 5)},
+            {"latin", GenerateText({"Stra\xc3\x9f" "e ", "caf\xc3\xa9 ", "na\xc3\xafve ", "Gr\xc3\xbc\xc3\x9f" "e ", "the ", "and "}, size, 6)},
+            {"cyrillic", GenerateText({"\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 ", "\xd0\xbc\xd0\xb8\xd1\x80 ", "\xd0\x96\xd0\xb8\xd0\xb7\xd0\xbd\xd1\x8c ", ", "}, size, 7)},
+            {"cjk", GenerateText({"\xe4\xb8\xad\xe6\x96\x87", "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e", "\xed\x95\x9c\xea\xb5\xad\xec\x96\xb4", "\xe3\x80\x82"}, size, 8)},
+            {"mixed", GenerateText({"Hello ", "\xd0\x9c\xd0\xb8\xd1\x80 ", "\xe4\xb8\x96\xe7\x95\x8c ", "\xf0\x9f\x98\x80 ", "caf\xc3\xa9 ", "file_01.png "}, size, 9)},
+    };
+
+    for (auto &corpus : corpora) {
+        auto &text = corpus.text;
+        auto mb = static_cast<double>(text.size() * iterations) / (1024.0 * 1024.0);
+
+        String16u utf16;
+        String8u utf8;
+        String8u lower;
+        bool valid = true;
+
+        auto perPointMs = MeasureMs([&]() { for (uint32 i = 0; i < iterations; i++) { utf16.clear(); ConvertPerPoint(text, utf16); } });
+        auto validateMs = MeasureMs([&]() { for (uint32 i = 0; i < iterations; i++) valid &= Unicode::ValidateUtf8(text.data(), text.size()); });
+        auto toUtf16Ms = MeasureMs([&]() { for (uint32 i = 0; i < iterations; i++) { utf16.clear(); Unicode::ConvertUtf8ToUtf16(text, utf16); } });
+        auto toUtf8Ms = MeasureMs([&]() { for (uint32 i = 0; i < iterations; i++) { utf8.clear(); Unicode::ConvertUtf16ToUtf8(utf16, utf8); } });
+        auto lowerPerPointMs = MeasureMs([&]() { for (uint32 i = 0; i < iterations; i++) { lower.clear(); ToLowerPerPoint(text, lower); } });
+        auto lowerMs = MeasureMs([&]() { for (uint32 i = 0; i < iterations; i++) { lower.clear(); Unicode::ToLower(text, lower); } });
+
+        EXPECT_TRUE(valid);
+        EXPECT_EQ(utf8, text);
+
+        std::cout << corpus.name << " (MB/s):" << std::endl
+                  << " validate utf-8: " << mb / validateMs * 1000.0 << std::endl
+                  << " utf-8 -> utf-16 per point: " << mb / perPointMs * 1000.0 << std::endl
+                  << " utf-8 -> utf-16: " << mb / toUtf16Ms * 1000.0 << std::endl
+                  << " utf-16 -> utf-8: " << mb / toUtf8Ms * 1000.0 << std::endl
+                  << " to lower per point: " << mb / lowerPerPointMs * 1000.0 << std::endl
+                  << " to lower: " << mb / lowerMs * 1000.0 << std::endl;
+    }
+}
+
+BRK_GTEST_MAIN
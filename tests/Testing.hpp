@@ -30,6 +30,11 @@
 
 #include <gtest/gtest.h>
 
+#include <platform/FileSystem.hpp>
+
+#include <chrono>
+#include <random>
+
 // Put in the end of the unit test file
 #define BRK_GTEST_MAIN                                   \
     int main(int argc, char *argv[]) {                   \
@@ -38,4 +43,37 @@
         return RUN_ALL_TESTS();                          \
     }
 
+// Benchmarks are disabled by default, run with --gtest_also_run_disabled_tests
+#define BRK_BENCHMARK(name) TEST(Berserk, DISABLED_##name)
+
+/** @return Average time in milliseconds of the function run */
+template<typename Func>
+inline double MeasureMs(Func &&func, unsigned int runs = 1) {
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < runs; i++)
+        func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+}
+
+/** Unique temporary directory of the test, removed with all its content on destruction */
+class TestTempDir {
+public:
+    explicit TestTempDir(const char *name) {
+        std::random_device device;
+        mPath = mFileSystem.GetTempDir() + "/berserk-" + name + "-" + std::to_string(device());
+        EXPECT_TRUE(mFileSystem.MakeDir(mPath));
+    }
+
+    ~TestTempDir() {
+        EXPECT_TRUE(mFileSystem.RemoveDir(mPath));
+    }
+
+    const BRK_NS::String &GetPath() const { return mPath; }
+
+private:
+    BRK_NS::FileSystem mFileSystem;
+    BRK_NS::String mPath;
+};
+
 #endif//BERSERK_TESTING_HPP